@@ -67,6 +67,10 @@
 
 struct CCNxStackConfig_ {
     PARCJSON *stackjson;
+
+    // The hash of stackjson, valid while hashValid is set.  ccnxStackConfig_Add() clears it.
+    PARCHashCode hash;
+    bool hashValid;
 };
 
 static void
@@ -113,6 +117,11 @@ ccnxStackConfig_Copy(const CCNxStackConfig *original)
 
     result->stackjson = parcJSON_Copy(original->stackjson);
 
+    if (__atomic_load_n(&original->hashValid, __ATOMIC_ACQUIRE)) {
+        result->hash = original->hash;
+        result->hashValid = true;
+    }
+
     return result;
 }
 
@@ -182,7 +191,16 @@ PARCHashCode
 ccnxStackConfig_HashCode(const CCNxStackConfig *config)
 {
     ccnxStackConfig_OptionalAssertValid(config);
-    return parcJSON_HashCode(config->stackjson);
+
+    // The hash is computed once and remembered, so a caller holding the same configuration
+    // (e.g. rtaTransport_Open() on an existing stack) does no JSON work.  Two threads may both
+    // compute it, but they store the same value.
+    CCNxStackConfig *cache = (CCNxStackConfig *) config;
+    if (!__atomic_load_n(&config->hashValid, __ATOMIC_ACQUIRE)) {
+        __atomic_store_n(&cache->hash, parcJSON_HashCode(config->stackjson), __ATOMIC_RELAXED);
+        __atomic_store_n(&cache->hashValid, true, __ATOMIC_RELEASE);
+    }
+    return __atomic_load_n(&config->hash, __ATOMIC_RELAXED);
 }
 
 CCNxStackConfig *
@@ -191,6 +209,7 @@ ccnxStackConfig_Add(CCNxStackConfig *config, const char *componentKey, PARCJSONV
     ccnxStackConfig_OptionalAssertValid(config);
 
     parcJSON_AddValue(config->stackjson, componentKey, jsonObject);
+    config->hashValid = false;
     return config;
 }
 
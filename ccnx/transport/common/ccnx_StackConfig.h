@@ -347,6 +347,10 @@ PARCJSONValue *ccnxStackConfig_Get(const CCNxStackConfig *config, const char *co
  * then calling the `HashCode` function
  * on each of the two objects must produce distinct integer results.
  *
+ * The hash is computed on the first call and remembered until the next ccnxStackConfig_Add(),
+ * so later calls do no JSON work.  Changes made directly to the PARCJSON returned by
+ * ccnxStackConfig_GetJson() are not seen by the remembered hash.
+ *
  * @param [in] instance A pointer to the `CCNxStackConfig` instance.
  *
  * @return The hashcode for the given instance.
@@ -96,6 +96,7 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, ccnxStackConfig_Display);
     LONGBOW_RUN_TEST_CASE(Global, ccnxStackConfig_Equals);
     LONGBOW_RUN_TEST_CASE(Global, ccnxStackConfig_HashCode);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxStackConfig_HashCode_AfterAdd);
     LONGBOW_RUN_TEST_CASE(Global, ccnxStackConfig_GetJson);
     LONGBOW_RUN_TEST_CASE(Global, ccnxStackConfig_IsValid);
     LONGBOW_RUN_TEST_CASE(Global, ccnxStackConfig_ToJSON);
@@ -197,6 +198,29 @@ LONGBOW_TEST_CASE(Global, ccnxStackConfig_HashCode)
     ccnxStackConfig_Release(&instance);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxStackConfig_HashCode_AfterAdd)
+{
+    CCNxStackConfig *instance = ccnxStackConfig_Create();
+    PARCHashCode empty = ccnxStackConfig_HashCode(instance);
+    assertTrue(instance->hashValid, "Expected the hash to be remembered");
+
+    PARCJSONValue *value = parcJSONValue_CreateFromNULL();
+    ccnxStackConfig_Add(instance, "key", value);
+    parcJSONValue_Release(&value);
+    assertFalse(instance->hashValid, "Expected ccnxStackConfig_Add to forget the hash");
+
+    PARCHashCode actual = ccnxStackConfig_HashCode(instance);
+    assertTrue(actual == parcJSON_HashCode(ccnxStackConfig_GetJson(instance)),
+               "Expected the hash of the new JSON, got %" PRIu64, (uint64_t) actual);
+    assertTrue(actual != empty, "Expected the hash to change after an add");
+
+    CCNxStackConfig *copy = ccnxStackConfig_Copy(instance);
+    assertTrue(copy->hashValid && ccnxStackConfig_HashCode(copy) == actual, "Expected the copy to keep the hash");
+
+    ccnxStackConfig_Release(&copy);
+    ccnxStackConfig_Release(&instance);
+}
+
 LONGBOW_TEST_CASE(Global, ccnxStackConfig_GetJson)
 {
     CCNxStackConfig *instance = ccnxStackConfig_Create();
@@ -93,6 +93,10 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, Transport_PassCommand);
     LONGBOW_RUN_TEST_CASE(Global, Transport_Recv);
     LONGBOW_RUN_TEST_CASE(Global, Transport_Send);
+
+    LONGBOW_RUN_TEST_CASE(Global, transportContext_Create_Destroy);
+    LONGBOW_RUN_TEST_CASE(Global, transportContext_Create_Options);
+    LONGBOW_RUN_TEST_CASE(Global, transportContext_Independent);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -151,6 +155,45 @@ LONGBOW_TEST_CASE(Global, Transport_Send)
     testUnimplemented("");
 }
 
+LONGBOW_TEST_CASE(Global, transportContext_Create_Destroy)
+{
+    TransportContext *transport = transportContext_Create(TRANSPORT_RTA, NULL);
+    assertNotNull(transport, "Got null transport");
+    assertTrue(transport->references == 1, "Wrong references, expected 1 got %u", transport->references);
+
+    transportContext_Destroy(&transport);
+    assertNull(transport, "transportContext_Destroy did not null the pointer");
+}
+
+LONGBOW_TEST_CASE(Global, transportContext_Create_Options)
+{
+    TransportInstanceOptions options = TransportInstanceOptions_Default;
+    options.cpu = 0;
+
+    TransportContext *transport = transportContext_Create(TRANSPORT_RTA, &options);
+    assertNotNull(transport, "Got null transport");
+    transportContext_Destroy(&transport);
+}
+
+LONGBOW_TEST_CASE(Global, transportContext_Independent)
+{
+    TransportContext *defaultTransport = Transport_Create(TRANSPORT_RTA);
+    TransportContext *a = transportContext_Create(TRANSPORT_RTA, NULL);
+    TransportContext *b = transportContext_Create(TRANSPORT_RTA, NULL);
+
+    assertTrue(a != defaultTransport && b != defaultTransport && a != b, "Instances are not distinct");
+    assertTrue(a->transport_data != b->transport_data, "Instances share a transport");
+    assertTrue(the_context == defaultTransport, "An instance replaced the default transport");
+
+    // destroying an instance leaves the default transport alone
+    transportContext_Destroy(&a);
+    assertTrue(the_context == defaultTransport, "Destroying an instance changed the default transport");
+
+    transportContext_Destroy(&b);
+    Transport_Destroy(&defaultTransport);
+    assertNull(the_context, "Default transport not cleared");
+}
+
 LONGBOW_TEST_FIXTURE(Static)
 {
 }
@@ -76,28 +76,46 @@ struct transport_context {
     unsigned references;
 };
 
-// the one global transport, for now
+// The default transport used by the Transport_ functions.  Instances from
+// transportContext_Create() are independent of it.
 static TransportContext *the_context = NULL;
 
+/*
+ * Returns NULL if the type is not supported
+ */
+static TransportContext *
+_transportContext_Create(TransportTypes type, const TransportInstanceOptions *options)
+{
+    TransportContext *context = NULL;
+    switch (type) {
+        case TRANSPORT_RTA:
+            context = parcMemory_Allocate(sizeof(TransportContext));
+            assertNotNull(context, "TransportContext could not be allocated, parcMemory_Allocate(%zu) returned NULL", sizeof(TransportContext));
+
+            context->references = 0;
+            context->ops = rta_ops;
+            if (options == NULL) {
+                context->transport_data = context->ops.Create();
+            } else {
+                context->transport_data = context->ops.CreateWithOptions(options);
+            }
+            context->transport_type = type;
+            break;
+
+        default:
+            break;
+    }
+    return context;
+}
+
 TransportContext *
 Transport_Create(TransportTypes type)
 {
     if (the_context == NULL) {
-        switch (type) {
-            case TRANSPORT_RTA:
-                the_context = parcMemory_Allocate(sizeof(TransportContext));
-                assertNotNull(the_context, "TransportContext could not be allocated, parcMemory_Allocate(%zu) returned NULL", sizeof(TransportContext));
-
-                the_context->references = 0;
-                the_context->ops = rta_ops;
-                the_context->transport_data = the_context->ops.Create();
-                the_context->transport_type = type;
-                break;
-
-            default:
-                fprintf(stderr, "%s unknown transport type %d\n", __func__, type);
-                abort();
-                break;
+        the_context = _transportContext_Create(type, NULL);
+        if (the_context == NULL) {
+            fprintf(stderr, "%s unknown transport type %d\n", __func__, type);
+            abort();
         }
     }
 
@@ -115,33 +133,32 @@ int
 Transport_Open(CCNxTransportConfig *transportConfig)
 {
     assertNotNull(the_context, "The TransportContext is NULL.");
-    assertNotNull(transportConfig, "The parameter transportConfig must be a non-null CCNxTransportConfig pointer");
-    return the_context->ops.Open(the_context->transport_data, transportConfig);
+    return transportContext_Open(the_context, transportConfig);
 }
 
 int
 Transport_Send(int desc, CCNxMetaMessage *msg_in)
 {
     assertNotNull(the_context, "the_context is null");
-    return the_context->ops.Send(the_context->transport_data, desc, msg_in, CCNxStackTimeout_Never);
+    return transportContext_Send(the_context, desc, msg_in);
 }
 
 TransportIOStatus
 Transport_Recv(int desc, CCNxMetaMessage **msg_out)
 {
-    return the_context->ops.Recv(the_context->transport_data, desc, msg_out, CCNxStackTimeout_Never);
+    return transportContext_Recv(the_context, desc, msg_out);
 }
 
 int
 Transport_Close(int desc)
 {
-    return the_context->ops.Close(the_context->transport_data, desc);
+    return transportContext_Close(the_context, desc);
 }
 
 int
 Transport_PassCommand(void *stackCommand)
 {
-    return the_context->ops.PassCommand(the_context->transport_data, stackCommand);
+    return transportContext_PassCommand(the_context, stackCommand);
 }
 
 void
@@ -152,15 +169,76 @@ Transport_Destroy(TransportContext **ctxPtr)
 
     TransportContext *ctx = *ctxPtr;
 
-    assertTrue(the_context == ctx, "Passed ctx is not the same");
     assertTrue(ctx->references > 0, "Invalid reference count");
 
     ctx->references--;
     if (ctx->references == 0) {
+        if (ctx == the_context) {
+            the_context = NULL;
+        }
         ctx->ops.Destroy(&ctx->transport_data);
         memset(ctx, 0, sizeof(TransportContext));
         parcMemory_Deallocate((void **) &ctx);
-        ctx = NULL;
-        the_context = NULL;
     }
+    *ctxPtr = NULL;
+}
+
+// ======================================================================
+// Transport instances
+
+TransportContext *
+transportContext_Create(TransportTypes type, const TransportInstanceOptions *options)
+{
+    const TransportInstanceOptions defaults = TransportInstanceOptions_Default;
+    if (options == NULL) {
+        options = &defaults;
+    }
+
+    TransportContext *context = _transportContext_Create(type, options);
+    if (context != NULL) {
+        context->references = 1;
+    }
+    return context;
+}
+
+int
+transportContext_Open(TransportContext *transport, CCNxTransportConfig *transportConfig)
+{
+    assertNotNull(transport, "Parameter transport must be non-null");
+    assertNotNull(transportConfig, "The parameter transportConfig must be a non-null CCNxTransportConfig pointer");
+    return transport->ops.Open(transport->transport_data, transportConfig);
+}
+
+int
+transportContext_Send(TransportContext *transport, int desc, CCNxMetaMessage *msg_in)
+{
+    assertNotNull(transport, "Parameter transport must be non-null");
+    return transport->ops.Send(transport->transport_data, desc, msg_in, CCNxStackTimeout_Never);
+}
+
+TransportIOStatus
+transportContext_Recv(TransportContext *transport, int desc, CCNxMetaMessage **msg_out)
+{
+    assertNotNull(transport, "Parameter transport must be non-null");
+    return transport->ops.Recv(transport->transport_data, desc, msg_out, CCNxStackTimeout_Never);
+}
+
+int
+transportContext_Close(TransportContext *transport, int desc)
+{
+    assertNotNull(transport, "Parameter transport must be non-null");
+    return transport->ops.Close(transport->transport_data, desc);
+}
+
+int
+transportContext_PassCommand(TransportContext *transport, void *stackCommand)
+{
+    assertNotNull(transport, "Parameter transport must be non-null");
+    return transport->ops.PassCommand(transport->transport_data, stackCommand);
+}
+
+void
+transportContext_Destroy(TransportContext **transportPtr)
+{
+    Transport_Destroy(transportPtr);
 }
@@ -61,11 +61,16 @@
  *
  * An API will call transport_Create(type), to create
  * a transport of the given type.  Only type TRANSPORT_RTA
- * is supported at this time.  Only one transport may exist,
- * so multiple calls to transport_Create() will return
+ * is supported at this time.  transport_Create() returns the
+ * default transport, so multiple calls to transport_Create() will return
  * a reference counted pointer to the same transport.
  * When an API is done, it should call transport_Destroy().
  *
+ * A process that wants more than one transport, e.g. one per
+ * core or per tenant, calls transportContext_Create() for each.
+ * Every instance has its own framework thread, protocol stacks and
+ * connections, and is used through the transportContext_ functions.
+ *
  * An API opens connections with the forwarder via
  * transport_Open(PARCJSON *).  The JSON dictionary defines
  * the properties of the protocol stack associated with the
@@ -163,11 +168,39 @@ typedef enum {
 typedef enum TransportIOStatus {
     TransportIOStatus_Success = 0,
     TransportIOStatus_Error = 1,
-    TransportIOStatus_Timeout = 2
+    TransportIOStatus_Timeout = 2,
+    TransportIOStatus_WouldBlock = 3    // a non-blocking send found the connection not writable
 } TransportIOStatus;
 
 typedef uint64_t CCNxStackTimeout;
 
+struct rta_thread_config;
+
+/**
+ * @typedef TransportInstanceOptions
+ * @abstract Options of a transport created with transportContext_Create()
+ * @constant cpu The CPU to pin the transport's framework thread to, or -1 to keep the CPUs of threadConfig
+ * @constant commandQueueSize The number of commands waiting for the framework, or 0 for the default (1024)
+ * @constant commandTimeoutUsec How long open and close wait for room in a full command queue, or 0 for the default (1 second)
+ * @constant maxConnections The number of connections open at once before an open fails with EMFILE,
+ *           or 0 for the default (262144)
+ * @constant threadConfig The CPUs, scheduling policy, priority and NUMA node of the framework thread
+ *           (see rta_ThreadConfig.h), or NULL for the RTA_FRAMEWORK_* environment variables.  It is copied.
+ */
+typedef struct transport_instance_options {
+    int cpu;
+    size_t commandQueueSize;
+    uint64_t commandTimeoutUsec;
+    size_t maxConnections;
+    const struct rta_thread_config *threadConfig;
+} TransportInstanceOptions;
+
+/**
+ * @def TransportInstanceOptions_Default
+ * The options used when transportContext_Create() is given NULL
+ */
+#define TransportInstanceOptions_Default { .cpu = -1, .commandQueueSize = 0, .commandTimeoutUsec = 0, .maxConnections = 0, .threadConfig = NULL }
+
 /**
  * @def CCNxStackTimeout_Never
  * The receive function is a blocking read that never times out.
@@ -297,7 +330,139 @@ int Transport_PassCommand(void *stackCommand);
 /**
  * Destroy a TransportContext instance.  Shuts done all descriptors and any pending data is lost.
  *
+ * Works on the default transport from Transport_Create() and on instances from
+ * transportContext_Create().
+ *
  * @param [in] ctxP A pointer to a pointer to the TransportContext instance to release.
  */
 void Transport_Destroy(TransportContext **ctxP);
+
+/**
+ * Create an independent transport instance
+ *
+ * Unlike Transport_Create(), every call creates a new transport with its own framework
+ * thread, protocol stacks and connections.  Descriptors belong to the instance that
+ * opened them and must only be used with that instance.  The default transport is not
+ * affected, and instances of different types may exist at the same time.
+ *
+ * @param [in] type The transport type
+ * @param [in] options The instance options, or NULL for TransportInstanceOptions_Default
+ *
+ * @return non-null A transport to destroy with transportContext_Destroy()
+ * @return null The type is not supported
+ *
+ * Example:
+ * @code
+ * {
+ *     TransportInstanceOptions options = TransportInstanceOptions_Default;
+ *     options.cpu = 3;
+ *     TransportContext *transport = transportContext_Create(TRANSPORT_RTA, &options);
+ *     int desc = transportContext_Open(transport, config);
+ *     ...
+ *     transportContext_Close(transport, desc);
+ *     transportContext_Destroy(&transport);
+ * }
+ * @endcode
+ */
+TransportContext *transportContext_Create(TransportTypes type, const TransportInstanceOptions *options);
+
+/**
+ * Open a descriptor on a transport instance
+ *
+ * Same as Transport_Open() on the given instance.
+ *
+ * @param [in] transport A transport from transportContext_Create() or Transport_Create()
+ * @param [in] transportConfig the transport configuration object
+ *
+ * @return the newly opened descriptor
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+int transportContext_Open(TransportContext *transport, CCNxTransportConfig *transportConfig);
+
+/**
+ * Send a `CCNxMetaMessage` on a descriptor of a transport instance
+ *
+ * Same as Transport_Send() on the given instance.
+ *
+ * @param [in] transport The transport that opened `desc`
+ * @param [in] desc The descriptor
+ * @param [in] msg_in A CCNxMetaMessage instance to send.
+ *
+ * @return 0 if the message was succesfully sent.
+ * @return -1 and sets errno, otherwise.
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+int transportContext_Send(TransportContext *transport, int desc, CCNxMetaMessage *msg_in);
+
+/**
+ * Receive a `CCNxMetaMessage` from a descriptor of a transport instance
+ *
+ * Same as Transport_Recv() on the given instance.
+ *
+ * @param [in] transport The transport that opened `desc`
+ * @param [in] desc The descriptor
+ * @param [out] msg_out The received message, which the caller must release
+ *
+ * @return TransportIOStatus_Success A message was received
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+TransportIOStatus transportContext_Recv(TransportContext *transport, int desc, CCNxMetaMessage **msg_out);
+
+/**
+ * Closes a descriptor of a transport instance
+ *
+ * Same as Transport_Close() on the given instance.
+ *
+ * @param [in] transport The transport that opened `desc`
+ * @param [in] desc the descriptor to close
+ *
+ * @return 0 on success (the descriptor exists and was open)
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+int transportContext_Close(TransportContext *transport, int desc);
+
+/**
+ * Pass a transport-specific command to the framework of a transport instance
+ *
+ * Same as Transport_PassCommand() on the given instance.
+ *
+ * @param [in] transport A transport instance
+ * @param [in] stackCommand The command
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+int transportContext_PassCommand(TransportContext *transport, void *stackCommand);
+
+/**
+ * Destroy a transport instance
+ *
+ * Same as Transport_Destroy().
+ *
+ * @param [in,out] transportPtr A pointer to the transport, set to NULL
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void transportContext_Destroy(TransportContext **transportPtr);
 #endif // CCNX_TRANSPORT_H
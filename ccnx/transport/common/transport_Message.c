@@ -61,6 +61,7 @@
 #include <strings.h>
 #include <unistd.h>
 #include <sys/time.h>
+#include <time.h>
 
 #include <LongBow/runtime.h>
 #include <parc/algol/parc_Memory.h>
@@ -76,21 +77,27 @@ struct transport_message {
     TransportMessage_Free *freefunc;
     void *info;
 
-    struct timeval creationTime;
+    // Monotonic nanoseconds, see _transportMessage_Now()
+    uint64_t creationTime;
+
+    // When the message last crossed a component boundary (queue put or get)
+    uint64_t boundaryTime;
 };
 
 static size_t _transport_messages_created = 0;
 static size_t _transport_messages_destroyed = 0;
 
-static void
-_transportMessage_GetTimeOfDay(struct timeval *outputTime)
+/*
+ * CLOCK_MONOTONIC is read from the vDSO on Linux, so this does not enter the kernel.
+ * CLOCK_MONOTONIC_COARSE would be cheaper still, but its resolution is a scheduler
+ * tick, which is longer than most component stages.
+ */
+static uint64_t
+_transportMessage_Now(void)
 {
-#ifdef DEBUG
-    // if in debug mode, time messages
-    gettimeofday(outputTime, NULL);
-#else
-    *outputTime = (struct timeval) { 0, 0 };
-#endif
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
 }
 
 TransportMessage *
@@ -106,7 +113,8 @@ transportMessage_CreateFromDictionary(CCNxTlvDictionary *dictionary)
     if (tm != NULL) {
         tm->dictionary = ccnxTlvDictionary_Acquire(dictionary);
 
-        _transportMessage_GetTimeOfDay(&tm->creationTime);
+        tm->creationTime = _transportMessage_Now();
+        tm->boundaryTime = tm->creationTime;
 
         _transport_messages_created++;
 
@@ -216,10 +224,26 @@ transportMessage_GetInfo(const TransportMessage *tm)
 struct timeval
 transportMessage_GetDelay(const TransportMessage *tm)
 {
-    struct timeval now;
-    _transportMessage_GetTimeOfDay(&now);
-    timersub(&now, &tm->creationTime, &now);
-    return now;
+    uint64_t delay = _transportMessage_Now() - tm->creationTime;
+    struct timeval result = { .tv_sec = delay / 1000000000ULL, .tv_usec = (delay % 1000000000ULL) / 1000 };
+    return result;
+}
+
+uint64_t
+transportMessage_MarkBoundary(TransportMessage *tm)
+{
+    assertNotNull(tm, "Parameter tm must be non-null");
+    uint64_t now = _transportMessage_Now();
+    uint64_t elapsed = now - tm->boundaryTime;
+    tm->boundaryTime = now;
+    return elapsed;
+}
+
+uint64_t
+transportMessage_GetBoundaryTime(const TransportMessage *tm)
+{
+    assertNotNull(tm, "Parameter tm must be non-null");
+    return tm->boundaryTime;
 }
 
 bool
@@ -64,6 +64,8 @@
 #ifndef Libccnx_transport_Message_h
 #define Libccnx_transport_Message_h
 
+#include <stdint.h>
+
 #include <ccnx/common/codec/ccnxCodec_NetworkBuffer.h>
 
 #include <ccnx/common/internal/ccnx_TlvDictionary.h>
@@ -198,10 +200,9 @@ bool transportMessage_IsInterest(const TransportMessage *tm);
 bool transportMessage_IsContentObject(const TransportMessage *tm);
 
 /**
- * If in DEBUG mode, returns how long the message has been in the system
+ * Returns how long the message has been in the system
  *
- * If not in DEBUG mode, will always be {.tv_sec = 0, .tv_usec = 0}.  The time is based
- * on gettimeofday().
+ * The time is based on the monotonic clock, from when the message was created.
  *
  * @param [<#in out in,out#>] <#name#> <#description#>
  *
@@ -213,4 +214,45 @@ bool transportMessage_IsContentObject(const TransportMessage *tm);
  * @endcode
  */
 struct timeval transportMessage_GetDelay(const TransportMessage *tm);
+
+/**
+ * Marks that the message crossed a component boundary
+ *
+ * The RTA framework calls this when a message is put on or taken off an inter-component
+ * queue.  The time between a put and the next get is queue wait, and the time between a
+ * get and the next put is processing in the component.  The first interval starts when
+ * the message is created.
+ *
+ * @param [in] tm The transport message
+ *
+ * @return The nanoseconds since the previous boundary (or creation)
+ *
+ * Example:
+ * @code
+ * {
+ *     uint64_t queueWait = transportMessage_MarkBoundary(tm);
+ * }
+ * @endcode
+ */
+uint64_t transportMessage_MarkBoundary(TransportMessage *tm);
+
+/**
+ * The time of the last boundary (or creation), in nanoseconds on CLOCK_MONOTONIC
+ *
+ * Lets the framework stamp a trace record with the time transportMessage_MarkBoundary()
+ * just read, instead of reading the clock again.
+ *
+ * @param [in] tm The transport message
+ *
+ * @return The time of the last boundary
+ *
+ * Example:
+ * @code
+ * {
+ *     transportMessage_MarkBoundary(tm);
+ *     uint64_t now = transportMessage_GetBoundaryTime(tm);
+ * }
+ * @endcode
+ */
+uint64_t transportMessage_GetBoundaryTime(const TransportMessage *tm);
 #endif // Libccnx_transport_Message_h
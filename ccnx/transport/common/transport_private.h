@@ -67,8 +67,11 @@
 #include <ccnx/transport/common/transport_MetaMessage.h>
 #include <ccnx/transport/common/ccnx_TransportConfig.h>
 
+struct transport_instance_options;
+
 struct transport_operations {
     void* (*Create)(void);
+    void* (*CreateWithOptions)(const struct transport_instance_options *options);
     int (*Open)(void *ctx, CCNxTransportConfig *transportConfig);
     int (*Send)(void *ctx, int desc, CCNxMetaMessage *msg, const struct timeval *timeout);
     TransportIOStatus (*Recv)(void *ctx, int desc, CCNxMetaMessage **msg, const struct timeval *timeout);
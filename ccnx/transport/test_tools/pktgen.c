@@ -55,24 +55,60 @@
 /**
  * Generate packets
  *
+ * A requester and responder pair that measures raw packet rates over the loopback,
+ * independent of the RTA stack.  The requester sends fixed-size packets carrying a
+ * sequence number and a timestamp, the responder echoes each one back, and the requester
+ * reports the send and receive rates, losses, and round trip times.
+ *
+ * Stream mode sends as fast as the socket accepts, in batches of sendmmsg(), and collects
+ * the replies as they arrive.  Stop-and-wait mode has one packet outstanding at a time.
+ * On platforms without sendmmsg()/recvmmsg() the batches are sent one packet at a time.
+ *
  * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
  * @copyright (c) 2013-2014, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include <config.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <poll.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
 
 #include <LongBow/runtime.h>
 
+#define PKTGEN_MAGIC 0x50475031       // "PGP1"
+#define PKTGEN_MAX_BATCH 256
+#define PKTGEN_DEFAULT_BATCH 32
+#define PKTGEN_DEFAULT_SIZE 1024
+#define PKTGEN_MAX_SIZE 65000
+
+// a requester gives up on outstanding replies after this long without one
+#define PKTGEN_IDLE_MSEC 1000
+
 typedef enum {
     MODE_SEND,
     MODE_REPLY
 } PktGenMode;
 
 typedef enum {
-    ENCAP_ETHER,
+    ENCAP_UNIX,
     ENCAP_UDP
 } PktGenEncap;
 
@@ -81,134 +117,646 @@ typedef enum {
     PKTGEN_STOPWAIT
 } PktGenFlow;
 
+/*
+ * The start of every packet.  The rest of the packet is padding.
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t reserved;
+    uint64_t sequence;
+    uint64_t timestamp;         // requester's monotonic clock, nanoseconds
+} PktGenHeader;
+
 typedef struct {
     PktGenMode mode;
     PktGenEncap encap;
     PktGenFlow flow;
 
-    char *ifname;
-    char *etherOrIp;
-    char *etherType;
-    unsigned count;
+    char *address;              // UDP address or unix socket path
+    uint16_t port;              // UDP port
+    unsigned count;             // packets to send, or to reply to (0 is forever)
+    size_t size;                // bytes per packet
+    unsigned batch;             // packets per sendmmsg/recvmmsg
+
+    int fd;
+    struct sockaddr_storage peer;
+    socklen_t peerLength;
+    char localPath[sizeof(((struct sockaddr_un *) 0)->sun_path)];
 
     struct timeval startTime;
     struct timeval stopTime;
-    unsigned packetCount;
+    unsigned packetCount;       // packets sent (requester) or replied (responder)
+
+    uint64_t received;
+    uint64_t receivedBytes;
+    uint64_t sentBytes;
+    uint64_t outOfOrder;
+    uint64_t nextExpected;
+    uint64_t rttCount;
+    uint64_t rttSum;
+    uint64_t rttMin;
+    uint64_t rttMax;
 } PktGen;
 
+/*
+ * A set of reusable buffers and message headers for one sendmmsg() or recvmmsg()
+ */
+typedef struct {
+    unsigned length;
+    uint8_t *buffers;
+    struct iovec iov[PKTGEN_MAX_BATCH];
+    struct sockaddr_storage addresses[PKTGEN_MAX_BATCH];
+    struct mmsghdr messages[PKTGEN_MAX_BATCH];
+} PktGenBatch;
+
 // ======================================================================
+// Portability for platforms without sendmmsg/recvmmsg
+
+#if !defined(__linux__)
+struct mmsghdr {
+    struct msghdr msg_hdr;
+    unsigned int msg_len;
+};
+
+static int
+sendmmsg(int fd, struct mmsghdr *messages, unsigned int length, int flags)
+{
+    unsigned int i;
+    for (i = 0; i < length; i++) {
+        ssize_t sent = sendmsg(fd, &messages[i].msg_hdr, flags);
+        if (sent < 0) {
+            return (i > 0) ? (int) i : -1;
+        }
+        messages[i].msg_len = (unsigned int) sent;
+    }
+    return (int) i;
+}
+
+static int
+recvmmsg(int fd, struct mmsghdr *messages, unsigned int length, int flags, struct timespec *timeout)
+{
+    unsigned int i;
+    for (i = 0; i < length; i++) {
+        // only the first read may block
+        ssize_t received = recvmsg(fd, &messages[i].msg_hdr, (i == 0) ? flags : (flags | MSG_DONTWAIT));
+        if (received < 0) {
+            return (i > 0) ? (int) i : -1;
+        }
+        messages[i].msg_len = (unsigned int) received;
+    }
+    return (int) i;
+}
+#endif
+
+#ifndef MSG_WAITFORONE
+#define MSG_WAITFORONE 0
+#endif
+
+// ======================================================================
+
+static uint64_t
+nowNanos(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;
+}
 
 static void
 usage(void)
 {
     printf("usage: \n");
     printf("  This program functions as a requester and a responder.  They operate in a pair.\n");
-    printf("  The test can run over raw Ethernet encapsulation or over UDP\n");
-    printf("  The <count> parameter can be an integer or use a 'kmg' suffix for 1000, 1E+6, or 1E+9\n");
+    printf("  The test runs over UDP or over AF_UNIX datagram sockets on the local host.\n");
+    printf("  The <n> parameters can be an integer or use a 'kmg' suffix for 1000, 1E+6, or 1E+9\n");
     printf("\n");
-    printf("  pktgen send  ether <ifname> <dstmac> [ethertype] count <n> (stream | stopwait)\n");
-    printf("  pktgen reply ether <ifname> [count <n>]\n");
+    printf("  pktgen send  udp <dstip> <dstport> [count <n>] [size <n>] [batch <n>] (stream | stopwait)\n");
+    printf("  pktgen reply udp <port> [count <n>] [batch <n>]\n");
     printf("\n");
-    printf("  This mode sends either a stream or stop-and-wait request to an Ethernet peer\n");
-    printf("  pktgen send  udp <ifname> <dstip> <dstport> count <n> (stream | stopwait)\n");
-    printf("  pktgen reply udp <ifname> [count <n>]\n");
+    printf("  pktgen send  unix <path> [count <n>] [size <n>] [batch <n>] (stream | stopwait)\n");
+    printf("  pktgen reply unix <path> [count <n>] [batch <n>]\n");
     printf("\n");
-    printf("  Examples:\n");
-    printf("    This uses the standard Ethertype of 0x0801.  The replier will stay running forever.\n");
-    printf("       pktgen send  ether em1 bc:30:5b:f2:2f:60 count 1M stream\n");
-    printf("       pktgen reply ether em1\n");
+    printf("  Defaults are count 1000, size %u bytes, and batch %u.  A replier without a count\n", PKTGEN_DEFAULT_SIZE, PKTGEN_DEFAULT_BATCH);
+    printf("  stays running forever.  Each packet is at least %zu bytes.\n", sizeof(PktGenHeader));
     printf("\n");
-    printf("    This uses a custom ethertype.  The replier will stay running forever.\n");
-    printf("       pktgen send  ether em1 bc:30:5b:f2:2f:60 0x9000 count 1M stream\n");
-    printf("       pktgen reply ether em1\n");
+    printf("  Examples:\n");
+    printf("    A stream of 1 million 1500 byte packets over UDP.\n");
+    printf("       pktgen reply udp 9695\n");
+    printf("       pktgen send  udp 127.0.0.1 9695 count 1M size 1500 stream\n");
     printf("\n");
-    printf("    An example with UDP\n");
-    printf("       pktgen send  udp em1 10.1.0.2 9695 count 1M stopwait\n");
-    printf("       pktgen reply udp em1\n");
+    printf("    Stop-and-wait over a unix socket.\n");
+    printf("       pktgen reply unix /tmp/pktgen\n");
+    printf("       pktgen send  unix /tmp/pktgen count 100k stopwait\n");
     printf("\n");
 }
 
-static PktGen
-parseCommandLine(int argc, char *argv[argc])
+/*
+ * Parse an integer with an optional k, m, or g suffix (1000, 1E+6, 1E+9)
+ */
+static bool
+parseCount(const char *string, uint64_t *output)
 {
-    PktGen pktgen;
-    memset(&pktgen, 0, sizeof(PktGen));
+    char *end;
+    errno = 0;
+    uint64_t value = strtoull(string, &end, 0);
+    if (errno != 0 || end == string) {
+        return false;
+    }
 
-    usage();
+    switch (*end) {
+        case '\0':
+            break;
+        case 'k':
+        case 'K':
+            value *= 1000ULL;
+            end++;
+            break;
+        case 'm':
+        case 'M':
+            value *= 1000000ULL;
+            end++;
+            break;
+        case 'g':
+        case 'G':
+            value *= 1000000000ULL;
+            end++;
+            break;
+        default:
+            return false;
+    }
 
-    return pktgen;
+    if (*end != '\0') {
+        return false;
+    }
+    *output = value;
+    return true;
 }
 
-// ======================================================================
-
-static void
-generateEther(PktGen *pktgen)
+static bool
+parseOptions(PktGen *pktgen, int argc, char *argv[argc], int next)
 {
-    printf("Generating %u ethernet interest messages\n", pktgen->count);
+    bool flowGiven = false;
+    while (next < argc) {
+        uint64_t value;
+        if (strcasecmp(argv[next], "stream") == 0) {
+            pktgen->flow = PKTGEN_STREAM;
+            flowGiven = true;
+            next++;
+        } else if (strcasecmp(argv[next], "stopwait") == 0) {
+            pktgen->flow = PKTGEN_STOPWAIT;
+            flowGiven = true;
+            next++;
+        } else if (next + 1 < argc && parseCount(argv[next + 1], &value)) {
+            if (strcasecmp(argv[next], "count") == 0 && value <= UINT32_MAX) {
+                pktgen->count = (unsigned) value;
+            } else if (strcasecmp(argv[next], "size") == 0 && value >= sizeof(PktGenHeader) && value <= PKTGEN_MAX_SIZE) {
+                pktgen->size = (size_t) value;
+            } else if (strcasecmp(argv[next], "batch") == 0 && value >= 1 && value <= PKTGEN_MAX_BATCH) {
+                pktgen->batch = (unsigned) value;
+            } else {
+                fprintf(stderr, "Invalid option %s %s\n", argv[next], argv[next + 1]);
+                return false;
+            }
+            next += 2;
+        } else {
+            fprintf(stderr, "Invalid option %s\n", argv[next]);
+            return false;
+        }
+    }
+
+    if (pktgen->mode == MODE_SEND && !flowGiven) {
+        fprintf(stderr, "The sender needs either stream or stopwait\n");
+        return false;
+    }
+    return true;
 }
 
-static void
-replyEther(PktGen *pktgen)
+static bool
+parseCommandLine(PktGen *pktgen, int argc, char *argv[argc])
 {
-    printf("replying up to %u ethernet content objects messages\n", pktgen->count);
+    memset(pktgen, 0, sizeof(PktGen));
+    pktgen->fd = -1;
+    pktgen->size = PKTGEN_DEFAULT_SIZE;
+    pktgen->batch = PKTGEN_DEFAULT_BATCH;
+    pktgen->rttMin = UINT64_MAX;
+
+    if (argc < 4) {
+        return false;
+    }
+
+    if (strcasecmp(argv[1], "send") == 0) {
+        pktgen->mode = MODE_SEND;
+        pktgen->count = 1000;
+    } else if (strcasecmp(argv[1], "reply") == 0) {
+        pktgen->mode = MODE_REPLY;
+    } else {
+        return false;
+    }
+
+    int next;
+    if (strcasecmp(argv[2], "udp") == 0) {
+        pktgen->encap = ENCAP_UDP;
+        if (pktgen->mode == MODE_SEND) {
+            if (argc < 5) {
+                return false;
+            }
+            pktgen->address = argv[3];
+            pktgen->port = (uint16_t) strtoul(argv[4], NULL, 10);
+            next = 5;
+        } else {
+            pktgen->port = (uint16_t) strtoul(argv[3], NULL, 10);
+            next = 4;
+        }
+    } else if (strcasecmp(argv[2], "unix") == 0) {
+        pktgen->encap = ENCAP_UNIX;
+        pktgen->address = argv[3];
+        next = 4;
+    } else {
+        return false;
+    }
+
+    return parseOptions(pktgen, argc, argv, next);
 }
 
 // ======================================================================
 
 static void
-generateUdp(PktGen *pktgen)
+batchInit(PktGenBatch *batch, unsigned length, size_t size)
 {
-    printf("Generating %u UDP interest messages\n", pktgen->count);
+    memset(batch, 0, sizeof(PktGenBatch));
+    batch->length = length;
+    batch->buffers = calloc(length, size);
+    assertNotNull(batch->buffers, "calloc(%u, %zu) failed", length, size);
+
+    for (unsigned i = 0; i < length; i++) {
+        batch->iov[i].iov_base = batch->buffers + i * size;
+        batch->iov[i].iov_len = size;
+        batch->messages[i].msg_hdr.msg_iov = &batch->iov[i];
+        batch->messages[i].msg_hdr.msg_iovlen = 1;
+    }
 }
 
 static void
-replyUdp(PktGen *pktgen)
+batchFini(PktGenBatch *batch)
 {
-    printf("replying up to %u UDP content objects messages\n", pktgen->count);
+    free(batch->buffers);
+    batch->buffers = NULL;
 }
 
+/*
+ * Point every message at the given destination, or at its own source address buffer
+ * if destination is NULL (for receiving)
+ */
+static void
+batchSetAddresses(PktGenBatch *batch, const struct sockaddr_storage *destination, socklen_t length)
+{
+    for (unsigned i = 0; i < batch->length; i++) {
+        if (destination != NULL) {
+            batch->messages[i].msg_hdr.msg_name = (void *) destination;
+            batch->messages[i].msg_hdr.msg_namelen = length;
+        } else {
+            batch->messages[i].msg_hdr.msg_name = &batch->addresses[i];
+            batch->messages[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+        }
+    }
+}
 
 // ======================================================================
 
 static void
-displayStatistics(PktGen *pktgen)
+openUdp(PktGen *pktgen)
 {
-    printf("stats.... coming soon\n");
+    pktgen->fd = socket(AF_INET, SOCK_DGRAM, 0);
+    assertTrue(pktgen->fd >= 0, "socket: (%d) %s", errno, strerror(errno));
+
+    struct sockaddr_in *sin = (struct sockaddr_in *) &pktgen->peer;
+    if (pktgen->mode == MODE_SEND) {
+        sin->sin_family = AF_INET;
+        sin->sin_port = htons(pktgen->port);
+        int success = inet_pton(AF_INET, pktgen->address, &sin->sin_addr);
+        assertTrue(success == 1, "Invalid IPv4 address '%s'", pktgen->address);
+        pktgen->peerLength = sizeof(struct sockaddr_in);
+    } else {
+        struct sockaddr_in local;
+        memset(&local, 0, sizeof(local));
+        local.sin_family = AF_INET;
+        local.sin_port = htons(pktgen->port);
+        local.sin_addr.s_addr = htonl(INADDR_ANY);
+        int failure = bind(pktgen->fd, (struct sockaddr *) &local, sizeof(local));
+        assertFalse(failure, "bind port %u: (%d) %s", pktgen->port, errno, strerror(errno));
+    }
 }
 
-// ======================================================================
+static void
+openUnix(PktGen *pktgen)
+{
+    pktgen->fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+    assertTrue(pktgen->fd >= 0, "socket: (%d) %s", errno, strerror(errno));
+
+    struct sockaddr_un local;
+    memset(&local, 0, sizeof(local));
+    local.sun_family = AF_UNIX;
+
+    if (pktgen->mode == MODE_SEND) {
+        struct sockaddr_un *sun = (struct sockaddr_un *) &pktgen->peer;
+        sun->sun_family = AF_UNIX;
+        strncpy(sun->sun_path, pktgen->address, sizeof(sun->sun_path) - 1);
+        pktgen->peerLength = sizeof(struct sockaddr_un);
+
+        // a datagram socket needs its own name for the replies
+        snprintf(pktgen->localPath, sizeof(pktgen->localPath), "%s.%d", pktgen->address, (int) getpid());
+    } else {
+        snprintf(pktgen->localPath, sizeof(pktgen->localPath), "%s", pktgen->address);
+    }
+
+    unlink(pktgen->localPath);
+    memcpy(local.sun_path, pktgen->localPath, sizeof(local.sun_path));
+    int failure = bind(pktgen->fd, (struct sockaddr *) &local, sizeof(local));
+    assertFalse(failure, "bind %s: (%d) %s", pktgen->localPath, errno, strerror(errno));
+}
 
 static void
-runSender(PktGen *pktgen)
+openSocket(PktGen *pktgen)
 {
     switch (pktgen->encap) {
-        case ENCAP_ETHER:
-            generateEther(pktgen);
+        case ENCAP_UNIX:
+            openUnix(pktgen);
             break;
 
         case ENCAP_UDP:
-            generateUdp(pktgen);
+            openUdp(pktgen);
             break;
 
         default:
-            trapIllegalValue(pktgen.encap, "Unknown encapsulation: %d", pktgen->encap);
+            trapIllegalValue(pktgen->encap, "Unknown encapsulation: %d", pktgen->encap);
     }
+
+    // deep socket buffers so a stream is limited by the stack, not by drops
+    int bufferSize = 4 * 1024 * 1024;
+    setsockopt(pktgen->fd, SOL_SOCKET, SO_SNDBUF, &bufferSize, sizeof(bufferSize));
+    setsockopt(pktgen->fd, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
 }
 
 static void
-runReplier(PktGen *pktgen)
+closeSocket(PktGen *pktgen)
 {
-    switch (pktgen->encap) {
-        case ENCAP_ETHER:
-            replyEther(pktgen);
-            break;
+    close(pktgen->fd);
+    pktgen->fd = -1;
+    if (pktgen->localPath[0] != '\0') {
+        unlink(pktgen->localPath);
+    }
+}
 
-        case ENCAP_UDP:
-            replyUdp(pktgen);
-            break;
+// ======================================================================
 
-        default:
-            trapIllegalValue(pktgen.encap, "Unknown encapsulation: %d", pktgen->encap);
+/*
+ * Account for the replies in the first count messages of the batch
+ */
+static void
+receiveReplies(PktGen *pktgen, PktGenBatch *batch, int count)
+{
+    uint64_t now = nowNanos();
+    for (int i = 0; i < count; i++) {
+        if (batch->messages[i].msg_len < sizeof(PktGenHeader)) {
+            continue;
+        }
+
+        const PktGenHeader *header = (const PktGenHeader *) batch->iov[i].iov_base;
+        if (header->magic != PKTGEN_MAGIC) {
+            continue;
+        }
+
+        pktgen->received++;
+        pktgen->receivedBytes += batch->messages[i].msg_len;
+
+        if (header->sequence != pktgen->nextExpected) {
+            pktgen->outOfOrder++;
+        }
+        pktgen->nextExpected = header->sequence + 1;
+
+        uint64_t rtt = now - header->timestamp;
+        pktgen->rttCount++;
+        pktgen->rttSum += rtt;
+        if (rtt < pktgen->rttMin) {
+            pktgen->rttMin = rtt;
+        }
+        if (rtt > pktgen->rttMax) {
+            pktgen->rttMax = rtt;
+        }
+    }
+}
+
+/*
+ * Read whatever replies are waiting, waiting up to timeoutMsec for the first.
+ * Returns the number of packets read.
+ */
+static int
+pollReplies(PktGen *pktgen, PktGenBatch *batch, int timeoutMsec)
+{
+    struct pollfd pfd = { .fd = pktgen->fd, .events = POLLIN };
+    if (poll(&pfd, 1, timeoutMsec) <= 0) {
+        return 0;
+    }
+
+    batchSetAddresses(batch, NULL, 0);
+    int count = recvmmsg(pktgen->fd, batch->messages, batch->length, MSG_DONTWAIT, NULL);
+    if (count > 0) {
+        receiveReplies(pktgen, batch, count);
+        return count;
+    }
+    return 0;
+}
+
+static void
+stampPacket(void *buffer, uint64_t sequence)
+{
+    PktGenHeader *header = (PktGenHeader *) buffer;
+    header->magic = PKTGEN_MAGIC;
+    header->sequence = sequence;
+    header->timestamp = nowNanos();
+}
+
+static void
+generateStream(PktGen *pktgen, PktGenBatch *sendBatch, PktGenBatch *receiveBatch)
+{
+    // A blocking send could wait on a responder that is itself blocked sending
+    // replies to our full receive queue, so never block and drain replies instead.
+    int flags = fcntl(pktgen->fd, F_GETFL, 0);
+    fcntl(pktgen->fd, F_SETFL, flags | O_NONBLOCK);
+
+    while (pktgen->packetCount < pktgen->count) {
+        unsigned length = pktgen->count - pktgen->packetCount;
+        if (length > sendBatch->length) {
+            length = sendBatch->length;
+        }
+
+        for (unsigned i = 0; i < length; i++) {
+            stampPacket(sendBatch->iov[i].iov_base, pktgen->packetCount + i);
+        }
+
+        int sent = sendmmsg(pktgen->fd, sendBatch->messages, length, 0);
+        if (sent < 0) {
+            if (errno == ENOBUFS || errno == EAGAIN || errno == EINTR) {
+                // the socket is full, drain replies and try again
+                pollReplies(pktgen, receiveBatch, 1);
+                continue;
+            }
+            trapUnexpectedState("sendmmsg: (%d) %s", errno, strerror(errno));
+        }
+
+        pktgen->packetCount += (unsigned) sent;
+        pktgen->sentBytes += (uint64_t) sent * pktgen->size;
+
+        // collect replies without blocking
+        while (pollReplies(pktgen, receiveBatch, 0) > 0) {
+        }
+    }
+
+    // wait for the stragglers
+    while (pktgen->received < pktgen->packetCount && pollReplies(pktgen, receiveBatch, PKTGEN_IDLE_MSEC) > 0) {
+    }
+}
+
+static void
+generateStopWait(PktGen *pktgen, PktGenBatch *sendBatch, PktGenBatch *receiveBatch)
+{
+    while (pktgen->packetCount < pktgen->count) {
+        stampPacket(sendBatch->iov[0].iov_base, pktgen->packetCount);
+        int sent = sendmmsg(pktgen->fd, sendBatch->messages, 1, 0);
+        if (sent < 0) {
+            if (errno == ENOBUFS || errno == EAGAIN || errno == EINTR) {
+                continue;
+            }
+            trapUnexpectedState("sendmmsg: (%d) %s", errno, strerror(errno));
+        }
+
+        pktgen->packetCount++;
+        pktgen->sentBytes += pktgen->size;
+
+        // a lost packet or reply costs one idle timeout
+        uint64_t before = pktgen->received;
+        while (pktgen->received == before && pollReplies(pktgen, receiveBatch, PKTGEN_IDLE_MSEC) > 0) {
+        }
+    }
+}
+
+static void
+generatePackets(PktGen *pktgen)
+{
+    printf("Generating %u %s packets of %zu bytes (%s)\n", pktgen->count,
+           pktgen->encap == ENCAP_UDP ? "UDP" : "unix",
+           pktgen->size,
+           pktgen->flow == PKTGEN_STREAM ? "stream" : "stop-and-wait");
+
+    openSocket(pktgen);
+
+    PktGenBatch sendBatch;
+    PktGenBatch receiveBatch;
+    batchInit(&sendBatch, pktgen->flow == PKTGEN_STREAM ? pktgen->batch : 1, pktgen->size);
+    batchInit(&receiveBatch, pktgen->batch, pktgen->size);
+    batchSetAddresses(&sendBatch, &pktgen->peer, pktgen->peerLength);
+
+    gettimeofday(&pktgen->startTime, NULL);
+    if (pktgen->flow == PKTGEN_STREAM) {
+        generateStream(pktgen, &sendBatch, &receiveBatch);
+    } else {
+        generateStopWait(pktgen, &sendBatch, &receiveBatch);
+    }
+    gettimeofday(&pktgen->stopTime, NULL);
+
+    batchFini(&sendBatch);
+    batchFini(&receiveBatch);
+    closeSocket(pktgen);
+}
+
+/*
+ * Echo packets back to their sources
+ */
+static void
+replyPackets(PktGen *pktgen)
+{
+    if (pktgen->count > 0) {
+        printf("replying to up to %u %s packets\n", pktgen->count, pktgen->encap == ENCAP_UDP ? "UDP" : "unix");
+    } else {
+        printf("replying to %s packets until interrupted\n", pktgen->encap == ENCAP_UDP ? "UDP" : "unix");
+    }
+
+    openSocket(pktgen);
+
+    PktGenBatch batch;
+    batchInit(&batch, pktgen->batch, PKTGEN_MAX_SIZE);
+
+    while (pktgen->count == 0 || pktgen->packetCount < pktgen->count) {
+        batchSetAddresses(&batch, NULL, 0);
+        for (unsigned i = 0; i < batch.length; i++) {
+            batch.iov[i].iov_len = PKTGEN_MAX_SIZE;
+        }
+
+        int count = recvmmsg(pktgen->fd, batch.messages, batch.length, MSG_WAITFORONE, NULL);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            trapUnexpectedState("recvmmsg: (%d) %s", errno, strerror(errno));
+        }
+
+        if (pktgen->received == 0) {
+            // time from the first packet
+            gettimeofday(&pktgen->startTime, NULL);
+        }
+
+        for (int i = 0; i < count; i++) {
+            pktgen->received++;
+            pktgen->receivedBytes += batch.messages[i].msg_len;
+
+            // echo the same bytes back to the source address recvmmsg filled in
+            batch.iov[i].iov_len = batch.messages[i].msg_len;
+        }
+
+        int sent = sendmmsg(pktgen->fd, batch.messages, (unsigned) count, 0);
+        if (sent > 0) {
+            pktgen->packetCount += (unsigned) sent;
+            for (int i = 0; i < sent; i++) {
+                pktgen->sentBytes += batch.messages[i].msg_len;
+            }
+        }
+        gettimeofday(&pktgen->stopTime, NULL);
+    }
+
+    batchFini(&batch);
+    closeSocket(pktgen);
+}
+
+// ======================================================================
+
+static void
+displayStatistics(PktGen *pktgen)
+{
+    struct timeval delta;
+    timersub(&pktgen->stopTime, &pktgen->startTime, &delta);
+    double seconds = delta.tv_sec + delta.tv_usec * 1E-6;
+
+    printf("\n");
+    printf("elapsed        %.6f seconds\n", seconds);
+
+    if (pktgen->mode == MODE_SEND) {
+        uint64_t lost = (pktgen->packetCount > pktgen->received) ? pktgen->packetCount - pktgen->received : 0;
+        printf("sent           %u packets %" PRIu64 " bytes\n", pktgen->packetCount, pktgen->sentBytes);
+        printf("received       %" PRIu64 " packets %" PRIu64 " bytes\n", pktgen->received, pktgen->receivedBytes);
+        printf("lost           %" PRIu64 " (%.3f%%)\n", lost, pktgen->packetCount > 0 ? 100.0 * lost / pktgen->packetCount : 0.0);
+        printf("out of order   %" PRIu64 "\n", pktgen->outOfOrder);
+        if (pktgen->rttCount > 0) {
+            printf("rtt usec       min %.3f avg %.3f max %.3f\n",
+                   pktgen->rttMin * 1E-3, (double) pktgen->rttSum / pktgen->rttCount * 1E-3, pktgen->rttMax * 1E-3);
+        }
+    } else {
+        printf("received       %" PRIu64 " packets %" PRIu64 " bytes\n", pktgen->received, pktgen->receivedBytes);
+        printf("replied        %u packets %" PRIu64 " bytes\n", pktgen->packetCount, pktgen->sentBytes);
+    }
+
+    if (seconds > 0) {
+        printf("send rate      %.0f pkt/sec %.3f Mbps\n", pktgen->packetCount / seconds, pktgen->sentBytes * 8E-6 / seconds);
+        printf("receive rate   %.0f pkt/sec %.3f Mbps\n", pktgen->received / seconds, pktgen->receivedBytes * 8E-6 / seconds);
     }
 }
 
@@ -217,15 +765,19 @@ runReplier(PktGen *pktgen)
 int
 main(int argc, char *argv[argc])
 {
-    PktGen pktgen = parseCommandLine(argc, argv);
+    PktGen pktgen;
+    if (!parseCommandLine(&pktgen, argc, argv)) {
+        usage();
+        exit(EXIT_FAILURE);
+    }
 
     switch (pktgen.mode) {
         case MODE_SEND:
-            runSender(&pktgen);
+            generatePackets(&pktgen);
             break;
 
         case MODE_REPLY:
-            runReplier(&pktgen);
+            replyPackets(&pktgen);
             break;
 
         default:
@@ -233,4 +785,5 @@ main(int argc, char *argv[argc])
     }
 
     displayStatistics(&pktgen);
+    return 0;
 }
@@ -0,0 +1,782 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * End-to-end throughput and latency benchmark of the RTA transport.
+ *
+ * rta_bench opens N requester connections and one responder connection in this process
+ * and runs one of two workloads between them:
+ *
+ *   fetch     Each requester fetches objects of --segments chunks through the Vegas flow
+ *             controller (API -> Vegas -> TLV -> forwarder connector).
+ *   pingpong  Each requester keeps one Interest outstanding and sends the next when the
+ *             Content Object arrives (API -> TLV -> forwarder connector).
+ *
+ * The responder (API -> TLV -> forwarder connector) answers every Interest with a signed
+ * Content Object of --payload bytes whose first 8 bytes are its send time.
+ *
+ * The forwarder is either an in-process bent_pipe on a unix socket, optionally with the
+ * loss, buffer, delay and rate of bentpipe_Params(), or a Metis forwarder on localhost,
+ * for which the responder registers a route to lci:/bench.  The bent_pipe sends every
+ * packet to every other connection, so its cost grows with the square of the connections
+ * and it accepts at most 9 requesters.
+ *
+ * The result is one JSON object on stdout:
+ *
+ *     {"benchmark":"fetch", ... "messages":..., "messagesPerSecond":..., "goodputBytesPerSecond":...,
+ *      "cpuNanosPerMessage":..., "latency":{"count":...,"p50":...,"p99":...,"p999":...}}
+ *
+ * Latency is in nanoseconds.  For pingpong it is the Interest to Content Object round trip.
+ * For fetch it is the time from the responder sending a Content Object to the requester
+ * receiving it, because Vegas, not the application, sends the Interests.  CPU per message
+ * is the user plus system time of the whole process (all transport, forwarder and
+ * responder threads) divided by the messages received by the requesters.
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+#include <config.h>
+
+#include <errno.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <sys/resource.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_JSON.h>
+#include <parc/algol/parc_Memory.h>
+#include <parc/security/parc_Pkcs12KeyStore.h>
+#include <parc/security/parc_Security.h>
+
+#include <ccnx/api/control/cpi_ControlMessage.h>
+#include <ccnx/api/notify/notify_Status.h>
+#include <ccnx/common/ccnx_ContentObject.h>
+#include <ccnx/common/ccnx_Interest.h>
+
+#include <ccnx/transport/common/transport.h>
+#include <ccnx/transport/common/transport_MetaMessage.h>
+#include <ccnx/transport/transport_rta/config/config_All.h>
+#include <ccnx/transport/transport_rta/core/rta_LatencyHistogram.h>
+
+#include <ccnx/transport/test_tools/bent_pipe.h>
+#include <ccnx/transport/test_tools/traffic_tools.h>
+
+// a requester waits this long for a pingpong reply before sending the Interest again
+#define BENCH_RETRY_NANOS 1000000000ULL
+
+// the bent_pipe accepts MAX_CONN (10) connections, one of which is the responder
+#define BENCH_BENTPIPE_MAX_REQUESTERS 9
+
+static const char benchPrefix[] = "lci:/bench";
+static const char keystorePassword[] = "rta_bench";
+
+typedef enum {
+    BenchMode_Fetch,
+    BenchMode_PingPong
+} BenchMode;
+
+typedef enum {
+    BenchForwarder_BentPipe,
+    BenchForwarder_Metis
+} BenchForwarder;
+
+typedef struct bench_options {
+    BenchMode mode;
+    BenchForwarder forwarder;
+
+    unsigned connections;
+    unsigned count;             // fetches or round trips per requester
+    unsigned segments;          // chunks per fetch
+    size_t payloadSize;
+    unsigned timeoutSeconds;
+
+    const char *pipePath;
+    bool externalPipe;          // connect to an existing bent pipe instead of starting one
+    uint16_t metisPort;
+    const char *keystorePath;
+
+    bool useParams;
+    double lossRate;
+    unsigned bufferBytes;
+    double meanDelay;
+    double bytesPerSecond;
+} BenchOptions;
+
+typedef struct bench_requester {
+    int fd;
+    unsigned index;
+
+    unsigned completed;         // fetches or round trips finished
+    unsigned segmentsReceived;  // in the current fetch
+    uint64_t sentNanos;         // when the current Interest was sent
+    CCNxName *current;          // name of the current fetch or Interest
+} BenchRequester;
+
+typedef struct bench_responder {
+    int fd;
+    const BenchOptions *options;
+    bool running;
+    pthread_t thread;
+    uint64_t responses;
+} BenchResponder;
+
+typedef struct bench_results {
+    uint64_t messages;
+    uint64_t payloadBytes;
+    uint64_t retries;
+    uint64_t elapsedNanos;
+    uint64_t cpuNanos;
+    bool timedOut;
+    RtaLatencyHistogram *latency;
+} BenchResults;
+
+static uint64_t
+benchNanos(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;
+}
+
+static uint64_t
+benchCpuNanos(void)
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return ((uint64_t) usage.ru_utime.tv_sec + (uint64_t) usage.ru_stime.tv_sec) * 1000000000ULL
+           + ((uint64_t) usage.ru_utime.tv_usec + (uint64_t) usage.ru_stime.tv_usec) * 1000ULL;
+}
+
+// =====================================================================
+// Transport configuration
+
+static CCNxTransportConfig *
+benchCreateConfig(const BenchOptions *options, bool withVegas)
+{
+    CCNxStackConfig *stackConfig = ccnxStackConfig_Create();
+    CCNxConnectionConfig *connConfig = apiConnector_ConnectionConfig(tlvCodec_ConnectionConfig(ccnxConnectionConfig_Create()));
+
+    const char *forwarderName;
+    if (options->forwarder == BenchForwarder_Metis) {
+        metisForwarder_ProtocolStackConfig(stackConfig);
+        metisForwarder_ConnectionConfig(connConfig, options->metisPort);
+        forwarderName = metisForwarder_GetName();
+    } else {
+        localForwarder_ProtocolStackConfig(stackConfig);
+        localForwarder_ConnectionConfig(connConfig, options->pipePath);
+        forwarderName = localForwarder_GetName();
+    }
+
+    if (withVegas) {
+        vegasFlowController_ProtocolStackConfig(stackConfig);
+        vegasFlowController_ConnectionConfig(connConfig);
+        protocolStack_ComponentsConfigArgs(stackConfig, apiConnector_GetName(), vegasFlowController_GetName(),
+                                           tlvCodec_GetName(), forwarderName, NULL);
+    } else {
+        protocolStack_ComponentsConfigArgs(stackConfig, apiConnector_GetName(), tlvCodec_GetName(), forwarderName, NULL);
+    }
+
+    apiConnector_ProtocolStackConfig(tlvCodec_ProtocolStackConfig(stackConfig));
+    publicKeySigner_ConnectionConfig(connConfig, options->keystorePath, keystorePassword);
+
+    CCNxTransportConfig *config = ccnxTransportConfig_Create(stackConfig, connConfig);
+    ccnxStackConfig_Release(&stackConfig);
+    return config;
+}
+
+/*
+ * Open a connection and wait for its CONNECTION_OPEN notification
+ */
+static int
+benchOpen(CCNxTransportConfig *config)
+{
+    int fd = Transport_Open(config);
+    if (fd < 0) {
+        return fd;
+    }
+
+    CCNxMetaMessage *message;
+    if (Transport_Recv(fd, &message) == TransportIOStatus_Success) {
+        ccnxMetaMessage_Release(&message);
+    }
+    return fd;
+}
+
+/*
+ * Block until the descriptor is readable or the timeout (milliseconds) expires
+ */
+static bool
+benchWaitReadable(int fd, int timeoutMillis)
+{
+    struct pollfd pfd = { .fd = fd, .events = POLLIN };
+    return poll(&pfd, 1, timeoutMillis) > 0;
+}
+
+// =====================================================================
+// Responder
+
+static void
+benchResponder_Reply(BenchResponder *responder, const CCNxInterest *interest)
+{
+    const BenchOptions *options = responder->options;
+    CCNxName *name = ccnxInterest_GetName(interest);
+
+    size_t length = options->payloadSize < sizeof(uint64_t) ? sizeof(uint64_t) : options->payloadSize;
+    PARCBuffer *payload = parcBuffer_Allocate(length);
+    uint64_t now = benchNanos();
+    parcBuffer_PutArray(payload, sizeof(now), (const uint8_t *) &now);
+    parcBuffer_SetPosition(payload, length);
+    parcBuffer_Flip(payload);
+
+    CCNxContentObject *object = ccnxContentObject_CreateWithNameAndPayload(name, payload);
+    parcBuffer_Release(&payload);
+
+    uint64_t chunk;
+    if (trafficTools_GetObjectSegmentFromName(name, &chunk)) {
+        ccnxContentObject_SetFinalChunkNumber(object, options->segments - 1);
+    }
+
+    CCNxMetaMessage *message = ccnxMetaMessage_CreateFromContentObject(object);
+    Transport_Send(responder->fd, message);
+    ccnxMetaMessage_Release(&message);
+    ccnxContentObject_Release(&object);
+
+    responder->responses++;
+}
+
+static void *
+benchResponder_Run(void *arg)
+{
+    BenchResponder *responder = (BenchResponder *) arg;
+
+    while (__atomic_load_n(&responder->running, __ATOMIC_ACQUIRE)) {
+        if (!benchWaitReadable(responder->fd, 100)) {
+            continue;
+        }
+
+        CCNxMetaMessage *message;
+        if (Transport_Recv(responder->fd, &message) != TransportIOStatus_Success) {
+            break;
+        }
+
+        if (ccnxMetaMessage_IsInterest(message)) {
+            benchResponder_Reply(responder, ccnxMetaMessage_GetInterest(message));
+        }
+        ccnxMetaMessage_Release(&message);
+    }
+    return NULL;
+}
+
+static void
+benchResponder_RegisterPrefix(BenchResponder *responder)
+{
+    CCNxName *prefix = ccnxName_CreateFromURI(benchPrefix);
+    CCNxControl *control = ccnxControl_CreateAddRouteToSelfRequest(prefix);
+    CCNxMetaMessage *message = ccnxMetaMessage_CreateFromControl(control);
+    Transport_Send(responder->fd, message);
+    ccnxMetaMessage_Release(&message);
+    ccnxControl_Release(&control);
+    ccnxName_Release(&prefix);
+}
+
+// =====================================================================
+// Requesters
+
+static void
+benchRequester_Send(BenchRequester *requester, const BenchOptions *options)
+{
+    if (requester->current == NULL) {
+        char uri[1024];
+        snprintf(uri, sizeof(uri), "%s/%u/%u", benchPrefix, requester->index, requester->completed);
+        requester->current = ccnxName_CreateFromURI(uri);
+    }
+
+    CCNxInterest *interest = ccnxInterest_CreateSimple(requester->current);
+    CCNxMetaMessage *message = ccnxMetaMessage_CreateFromInterest(interest);
+    requester->sentNanos = benchNanos();
+    Transport_Send(requester->fd, message);
+    ccnxMetaMessage_Release(&message);
+    ccnxInterest_Release(&interest);
+
+    requester->segmentsReceived = 0;
+}
+
+static void
+benchRequester_Next(BenchRequester *requester, const BenchOptions *options)
+{
+    ccnxName_Release(&requester->current);
+    requester->completed++;
+    if (requester->completed < options->count) {
+        benchRequester_Send(requester, options);
+    }
+}
+
+/*
+ * True if the Content Object answers the requester's current Interest (pingpong)
+ * or is a chunk of its current fetch.
+ */
+static bool
+benchRequester_IsCurrent(const BenchRequester *requester, const CCNxName *name, BenchMode mode)
+{
+    if (requester->current == NULL) {
+        return false;
+    }
+    if (mode == BenchMode_PingPong) {
+        return ccnxName_Equals(name, requester->current);
+    }
+
+    CCNxName *basename = ccnxName_Copy(name);
+    if (trafficTools_GetObjectSegmentFromName(basename, NULL)) {
+        ccnxName_Trim(basename, 1);
+    }
+    bool result = ccnxName_Equals(basename, requester->current);
+    ccnxName_Release(&basename);
+    return result;
+}
+
+static void
+benchRequester_Receive(BenchRequester *requester, const BenchOptions *options, BenchResults *results)
+{
+    CCNxMetaMessage *message;
+    if (Transport_Recv(requester->fd, &message) != TransportIOStatus_Success) {
+        return;
+    }
+
+    // Interests from the other requesters and their Content Objects also arrive over a
+    // bent pipe, and Vegas status notifications arrive in fetch mode.  Skip them all.
+    if (ccnxMetaMessage_IsContentObject(message)) {
+        CCNxContentObject *object = ccnxMetaMessage_GetContentObject(message);
+        if (benchRequester_IsCurrent(requester, ccnxContentObject_GetName(object), options->mode)) {
+            uint64_t now = benchNanos();
+            PARCBuffer *payload = ccnxContentObject_GetPayload(object);
+
+            results->messages++;
+            results->payloadBytes += parcBuffer_Remaining(payload);
+
+            if (options->mode == BenchMode_PingPong) {
+                rtaLatencyHistogram_Record(results->latency, now - requester->sentNanos);
+                benchRequester_Next(requester, options);
+            } else {
+                uint64_t sent;
+                if (parcBuffer_Remaining(payload) >= sizeof(sent)) {
+                    memcpy(&sent, parcBuffer_Overlay(payload, 0), sizeof(sent));
+                    rtaLatencyHistogram_Record(results->latency, now - sent);
+                }
+                requester->segmentsReceived++;
+                if (requester->segmentsReceived == options->segments) {
+                    benchRequester_Next(requester, options);
+                }
+            }
+        }
+    }
+
+    ccnxMetaMessage_Release(&message);
+}
+
+static void
+benchRun(BenchRequester *requesters, const BenchOptions *options, BenchResults *results)
+{
+    struct pollfd *pfds = parcMemory_AllocateAndClear(options->connections * sizeof(struct pollfd));
+    assertNotNull(pfds, "parcMemory_AllocateAndClear(%zu) returned NULL", options->connections * sizeof(struct pollfd));
+
+    uint64_t startCpu = benchCpuNanos();
+    uint64_t start = benchNanos();
+    uint64_t deadline = start + (uint64_t) options->timeoutSeconds * 1000000000ULL;
+
+    for (unsigned i = 0; i < options->connections; i++) {
+        pfds[i].fd = requesters[i].fd;
+        pfds[i].events = POLLIN;
+        benchRequester_Send(&requesters[i], options);
+    }
+
+    unsigned finished = 0;
+    while (finished < options->connections) {
+        uint64_t now = benchNanos();
+        if (now > deadline) {
+            results->timedOut = true;
+            break;
+        }
+
+        if (poll(pfds, options->connections, 10) < 0 && errno != EINTR) {
+            perror("poll");
+            break;
+        }
+
+        finished = 0;
+        for (unsigned i = 0; i < options->connections; i++) {
+            BenchRequester *requester = &requesters[i];
+            if (pfds[i].revents & POLLIN) {
+                benchRequester_Receive(requester, options, results);
+            }
+
+            if (requester->completed >= options->count) {
+                finished++;
+            } else if (options->mode == BenchMode_PingPong && now - requester->sentNanos > BENCH_RETRY_NANOS) {
+                // there are no retransmissions without Vegas, so a lost packet would stall the requester
+                results->retries++;
+                benchRequester_Send(requester, options);
+            }
+        }
+    }
+
+    results->elapsedNanos = benchNanos() - start;
+    results->cpuNanos = benchCpuNanos() - startCpu;
+
+    parcMemory_Deallocate((void **) &pfds);
+}
+
+// =====================================================================
+// Report
+
+static void
+benchReport(const BenchOptions *options, const BenchResults *results)
+{
+    PARCJSON *json = parcJSON_Create();
+
+    parcJSON_AddString(json, "benchmark", options->mode == BenchMode_Fetch ? "fetch" : "pingpong");
+    parcJSON_AddString(json, "forwarder", options->forwarder == BenchForwarder_Metis ? "metis" : "bentpipe");
+    parcJSON_AddInteger(json, "connections", options->connections);
+    parcJSON_AddInteger(json, "count", options->count);
+    if (options->mode == BenchMode_Fetch) {
+        parcJSON_AddInteger(json, "segments", options->segments);
+    }
+    parcJSON_AddInteger(json, "payloadSize", (int64_t) options->payloadSize);
+
+    if (options->useParams) {
+        PARCJSON *params = parcJSON_Create();
+        parcJSON_AddInteger(params, "lossPpm", (int64_t) (options->lossRate * 1E6));
+        parcJSON_AddInteger(params, "bufferBytes", options->bufferBytes);
+        parcJSON_AddInteger(params, "meanDelayUsec", (int64_t) (options->meanDelay * 1E6));
+        parcJSON_AddInteger(params, "bytesPerSecond", (int64_t) options->bytesPerSecond);
+        parcJSON_AddObject(json, "bentpipe", params);
+        parcJSON_Release(&params);
+    }
+
+    double seconds = (double) results->elapsedNanos * 1E-9;
+    parcJSON_AddBoolean(json, "timedOut", results->timedOut);
+    parcJSON_AddInteger(json, "elapsedNanos", (int64_t) results->elapsedNanos);
+    parcJSON_AddInteger(json, "messages", (int64_t) results->messages);
+    parcJSON_AddInteger(json, "retries", (int64_t) results->retries);
+    parcJSON_AddInteger(json, "messagesPerSecond", seconds > 0 ? (int64_t) (results->messages / seconds) : 0);
+    parcJSON_AddInteger(json, "goodputBytesPerSecond", seconds > 0 ? (int64_t) (results->payloadBytes / seconds) : 0);
+    parcJSON_AddInteger(json, "cpuNanosPerMessage", results->messages > 0 ? (int64_t) (results->cpuNanos / results->messages) : 0);
+
+    PARCJSON *latency = rtaLatencyHistogram_ToJSON(results->latency);
+    parcJSON_AddObject(json, "latency", latency);
+    parcJSON_Release(&latency);
+
+    char *string = parcJSON_ToString(json);
+    printf("%s\n", string);
+    parcMemory_Deallocate((void **) &string);
+    parcJSON_Release(&json);
+}
+
+// =====================================================================
+// Command line
+
+static void
+usage(const char *program)
+{
+    printf("usage: %s [options]\n", program);
+    printf("  -m, --mode fetch|pingpong   workload (default fetch)\n");
+    printf("  -c, --connections n         requester connections (default 1)\n");
+    printf("  -n, --count n               fetches or round trips per connection (default 100)\n");
+    printf("  -s, --segments n            chunks per fetch (default 100)\n");
+    printf("  -p, --payload bytes         Content Object payload size (default 1024)\n");
+    printf("  -t, --timeout seconds       give up after this long (default 60)\n");
+    printf("  -f, --forwarder bentpipe|metis  (default bentpipe)\n");
+    printf("  -P, --path path             bent pipe socket (default /tmp/rta_bench)\n");
+    printf("  -x, --external              use an already running bent pipe at --path\n");
+    printf("      --port n                Metis port (default %u)\n", metisForwarder_GetDefaultPort());
+    printf("  -k, --keystore path         keystore file to create (default /tmp/rta_bench_keystore)\n");
+    printf("      --loss rate             bent pipe loss rate, 0.0 to 1.0\n");
+    printf("      --buffer bytes          bent pipe per-connection buffer\n");
+    printf("      --delay seconds         bent pipe mean delay\n");
+    printf("      --rate bytes            bent pipe bytes per second\n");
+    printf("  -h, --help\n");
+}
+
+static bool
+parseCommandLine(int argc, char *argv[], BenchOptions *options)
+{
+    enum { OPT_PORT = 256, OPT_LOSS, OPT_BUFFER, OPT_DELAY, OPT_RATE };
+
+    static const struct option longOptions[] = {
+        { "mode",        required_argument, NULL, 'm'        },
+        { "connections", required_argument, NULL, 'c'        },
+        { "count",       required_argument, NULL, 'n'        },
+        { "segments",    required_argument, NULL, 's'        },
+        { "payload",     required_argument, NULL, 'p'        },
+        { "timeout",     required_argument, NULL, 't'        },
+        { "forwarder",   required_argument, NULL, 'f'        },
+        { "path",        required_argument, NULL, 'P'        },
+        { "external",    no_argument,       NULL, 'x'        },
+        { "port",        required_argument, NULL, OPT_PORT   },
+        { "keystore",    required_argument, NULL, 'k'        },
+        { "loss",        required_argument, NULL, OPT_LOSS   },
+        { "buffer",      required_argument, NULL, OPT_BUFFER },
+        { "delay",       required_argument, NULL, OPT_DELAY  },
+        { "rate",        required_argument, NULL, OPT_RATE   },
+        { "help",        no_argument,       NULL, 'h'        },
+        { NULL,          0,                 NULL, 0          }
+    };
+
+    memset(options, 0, sizeof(BenchOptions));
+    options->mode = BenchMode_Fetch;
+    options->forwarder = BenchForwarder_BentPipe;
+    options->connections = 1;
+    options->count = 100;
+    options->segments = 100;
+    options->payloadSize = 1024;
+    options->timeoutSeconds = 60;
+    options->pipePath = "/tmp/rta_bench";
+    options->metisPort = metisForwarder_GetDefaultPort();
+    options->keystorePath = "/tmp/rta_bench_keystore";
+    options->bufferBytes = 65536;
+
+    int c;
+    while ((c = getopt_long(argc, argv, "m:c:n:s:p:t:f:P:xk:h", longOptions, NULL)) != -1) {
+        switch (c) {
+            case 'm':
+                if (strcmp(optarg, "fetch") == 0) {
+                    options->mode = BenchMode_Fetch;
+                } else if (strcmp(optarg, "pingpong") == 0) {
+                    options->mode = BenchMode_PingPong;
+                } else {
+                    fprintf(stderr, "unknown mode '%s'\n", optarg);
+                    return false;
+                }
+                break;
+
+            case 'c':
+                options->connections = (unsigned) strtoul(optarg, NULL, 10);
+                break;
+
+            case 'n':
+                options->count = (unsigned) strtoul(optarg, NULL, 10);
+                break;
+
+            case 's':
+                options->segments = (unsigned) strtoul(optarg, NULL, 10);
+                break;
+
+            case 'p':
+                options->payloadSize = strtoul(optarg, NULL, 10);
+                break;
+
+            case 't':
+                options->timeoutSeconds = (unsigned) strtoul(optarg, NULL, 10);
+                break;
+
+            case 'f':
+                if (strcmp(optarg, "bentpipe") == 0) {
+                    options->forwarder = BenchForwarder_BentPipe;
+                } else if (strcmp(optarg, "metis") == 0) {
+                    options->forwarder = BenchForwarder_Metis;
+                } else {
+                    fprintf(stderr, "unknown forwarder '%s'\n", optarg);
+                    return false;
+                }
+                break;
+
+            case 'P':
+                options->pipePath = optarg;
+                break;
+
+            case 'x':
+                options->externalPipe = true;
+                break;
+
+            case OPT_PORT:
+                options->metisPort = (uint16_t) strtoul(optarg, NULL, 10);
+                break;
+
+            case 'k':
+                options->keystorePath = optarg;
+                break;
+
+            case OPT_LOSS:
+                options->useParams = true;
+                options->lossRate = strtod(optarg, NULL);
+                break;
+
+            case OPT_BUFFER:
+                options->useParams = true;
+                options->bufferBytes = (unsigned) strtoul(optarg, NULL, 10);
+                break;
+
+            case OPT_DELAY:
+                options->useParams = true;
+                options->meanDelay = strtod(optarg, NULL);
+                break;
+
+            case OPT_RATE:
+                options->useParams = true;
+                options->bytesPerSecond = strtod(optarg, NULL);
+                break;
+
+            case 'h':
+            default:
+                return false;
+        }
+    }
+
+    if (options->connections == 0 || options->count == 0 || options->segments == 0) {
+        fprintf(stderr, "connections, count and segments must be positive\n");
+        return false;
+    }
+
+    if (options->forwarder == BenchForwarder_BentPipe && options->connections > BENCH_BENTPIPE_MAX_REQUESTERS) {
+        fprintf(stderr, "the bent pipe supports at most %u connections\n", BENCH_BENTPIPE_MAX_REQUESTERS);
+        return false;
+    }
+
+    return true;
+}
+
+// =====================================================================
+
+int
+main(int argc, char *argv[])
+{
+    BenchOptions options;
+    if (!parseCommandLine(argc, argv, &options)) {
+        usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    parcSecurity_Init();
+
+    unlink(options.keystorePath);
+    bool success = parcPkcs12KeyStore_CreateFile(options.keystorePath, keystorePassword, "rta_bench", 1024, 30);
+    assertTrue(success, "parcPkcs12KeyStore_CreateFile(%s) failed", options.keystorePath);
+
+    BentPipeState *bentpipe = NULL;
+    if (options.forwarder == BenchForwarder_BentPipe && !options.externalPipe) {
+        unlink(options.pipePath);
+        bentpipe = bentpipe_Create(options.pipePath);
+        bentpipe_SetChattyOutput(bentpipe, false);
+        if (options.useParams) {
+            bentpipe_Params(bentpipe, options.lossRate, options.bufferBytes, options.meanDelay, options.bytesPerSecond);
+        }
+        bentpipe_Start(bentpipe);
+    }
+
+    TransportContext *transport = Transport_Create(TRANSPORT_RTA);
+    assertNotNull(transport, "Transport_Create returned null");
+
+    // the responder never uses Vegas, the requesters use it for fetches
+    CCNxTransportConfig *responderConfig = benchCreateConfig(&options, false);
+    CCNxTransportConfig *requesterConfig = benchCreateConfig(&options, options.mode == BenchMode_Fetch);
+
+    BenchResponder responder = { .options = &options, .running = true };
+    responder.fd = benchOpen(responderConfig);
+    assertTrue(responder.fd >= 0, "Could not open the responder connection");
+    if (options.forwarder == BenchForwarder_Metis) {
+        benchResponder_RegisterPrefix(&responder);
+    }
+    pthread_create(&responder.thread, NULL, benchResponder_Run, &responder);
+
+    BenchRequester *requesters = parcMemory_AllocateAndClear(options.connections * sizeof(BenchRequester));
+    assertNotNull(requesters, "parcMemory_AllocateAndClear(%zu) returned NULL", options.connections * sizeof(BenchRequester));
+    for (unsigned i = 0; i < options.connections; i++) {
+        requesters[i].index = i;
+        requesters[i].fd = benchOpen(requesterConfig);
+        assertTrue(requesters[i].fd >= 0, "Could not open requester connection %u", i);
+    }
+
+    BenchResults results;
+    memset(&results, 0, sizeof(results));
+    results.latency = rtaLatencyHistogram_Create();
+
+    benchRun(requesters, &options, &results);
+    benchReport(&options, &results);
+
+    __atomic_store_n(&responder.running, false, __ATOMIC_RELEASE);
+    pthread_join(responder.thread, NULL);
+
+    for (unsigned i = 0; i < options.connections; i++) {
+        if (requesters[i].current != NULL) {
+            ccnxName_Release(&requesters[i].current);
+        }
+        Transport_Close(requesters[i].fd);
+    }
+    Transport_Close(responder.fd);
+
+    rtaLatencyHistogram_Destroy(&results.latency);
+    parcMemory_Deallocate((void **) &requesters);
+    ccnxTransportConfig_Destroy(&responderConfig);
+    ccnxTransportConfig_Destroy(&requesterConfig);
+    Transport_Destroy(&transport);
+
+    if (bentpipe != NULL) {
+        bentpipe_Stop(bentpipe);
+        bentpipe_Destroy(&bentpipe);
+    }
+
+    unlink(options.keystorePath);
+    parcSecurity_Fini();
+
+    return results.timedOut ? EXIT_FAILURE : EXIT_SUCCESS;
+}
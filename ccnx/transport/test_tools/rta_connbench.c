@@ -0,0 +1,537 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * Connection-scale benchmark of the RTA transport.
+ *
+ * rta_connbench opens --connections connections on one protocol stack, then closes them,
+ * and reports how long each takes and how much memory an open connection holds.  It
+ * calls rtaTransport directly, without the Transport_* wrappers, so it can use
+ * rtaTransport_OpenMany():
+ *
+ *   open      Each connection is one rtaTransport_Open().  --batch opens are issued
+ *             before waiting for them.
+ *   openmany  Each --batch connections are one rtaTransport_OpenMany().
+ *
+ * The stack is API -> TESTING_LOWER, or API -> TLV -> TESTING_LOWER with --codec, so no
+ * forwarder is involved.  A connection is open when the API connector has counted its
+ * STATS_OPENS, which rtaTransport_GetConnectionStats() reads without a round trip to the
+ * Transport thread.  The connections are polled in the order they were opened, the same
+ * order the Transport opens them, so a latency can be late by the time it takes to poll
+ * the connections before it.
+ *
+ * Closes cannot be observed per connection, because rtaTransport_Close() forgets the
+ * connection before the Transport removes it.  closeCall is the time of each
+ * rtaTransport_Close(), and closeNanos ends when rtaTransport_GetStatistics() answers,
+ * which the Transport does after it has processed every close.
+ *
+ * Memory per connection is the growth of the resident set (from /proc/self/statm) and of
+ * parcMemory_Outstanding() while all the connections are open, divided by the number of
+ * connections.  leakedAllocations is what parcMemory_Outstanding() did not give back
+ * after the closes.
+ *
+ * Each connection uses two descriptors, so the soft RLIMIT_NOFILE is raised to the hard
+ * limit and --connections is reduced to what fits.
+ *
+ * The result is one JSON object on stdout:
+ *
+ *     {"benchmark":"openmany","connections":...,"opensPerSecond":...,"closesPerSecond":...,
+ *      "rssBytesPerConnection":...,"allocationsPerConnection":...,
+ *      "openLatency":{"count":...,"p50":...,"p99":...,"p999":...}, ...}
+ *
+ * Latencies are in nanoseconds.
+ *
+ * Example:
+ *
+ *     rta_connbench -m openmany -c 100000 -b 1000
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+#include <config.h>
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <sys/resource.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_JSON.h>
+#include <parc/algol/parc_Memory.h>
+#include <parc/security/parc_Pkcs12KeyStore.h>
+#include <parc/security/parc_Security.h>
+
+#include <ccnx/transport/transport_rta/rta_Transport.h>
+#include <ccnx/transport/transport_rta/config/config_All.h>
+#include <ccnx/transport/transport_rta/core/rta_LatencyHistogram.h>
+
+// descriptors kept for stdio, the command notifier, libevent and the keystore
+#define CONNBENCH_RESERVED_FDS 64
+
+static const char keystorePassword[] = "rta_connbench";
+
+typedef enum {
+    ConnBenchMode_Open,
+    ConnBenchMode_OpenMany
+} ConnBenchMode;
+
+typedef struct connbench_options {
+    ConnBenchMode mode;
+    unsigned connections;
+    unsigned batch;
+    unsigned timeoutSeconds;
+    bool codec;
+    const char *keystorePath;
+} ConnBenchOptions;
+
+typedef struct connbench_results {
+    unsigned opened;
+    bool timedOut;
+
+    uint64_t openNanos;
+    uint64_t closeNanos;
+
+    int64_t rssBytes;
+    int64_t allocations;
+    int64_t leakedAllocations;
+
+    RtaLatencyHistogram *openCall;      // each rtaTransport_Open or rtaTransport_OpenMany
+    RtaLatencyHistogram *openLatency;   // each connection, from its open call until it is open
+    RtaLatencyHistogram *closeCall;     // each rtaTransport_Close
+} ConnBenchResults;
+
+static uint64_t
+connbenchNanos(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;
+}
+
+/*
+ * The resident set size in bytes, or 0 if /proc is not available
+ */
+static int64_t
+connbenchResidentBytes(void)
+{
+    int64_t result = 0;
+    FILE *file = fopen("/proc/self/statm", "r");
+    if (file != NULL) {
+        unsigned long size;
+        unsigned long resident;
+        if (fscanf(file, "%lu %lu", &size, &resident) == 2) {
+            result = (int64_t) resident * sysconf(_SC_PAGESIZE);
+        }
+        fclose(file);
+    }
+    return result;
+}
+
+/*
+ * Raise the soft descriptor limit as far as allowed and return the number of
+ * connections that fit in it
+ */
+static unsigned
+connbenchMaxConnections(void)
+{
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0) {
+        return 0;
+    }
+
+    if (limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        if (setrlimit(RLIMIT_NOFILE, &limit) != 0) {
+            getrlimit(RLIMIT_NOFILE, &limit);
+        }
+    }
+
+    if (limit.rlim_cur == RLIM_INFINITY || limit.rlim_cur > UINT32_MAX) {
+        return UINT32_MAX / 2;
+    }
+    if (limit.rlim_cur <= CONNBENCH_RESERVED_FDS) {
+        return 0;
+    }
+    return (unsigned) ((limit.rlim_cur - CONNBENCH_RESERVED_FDS) / 2);
+}
+
+static CCNxTransportConfig *
+connbenchCreateConfig(const ConnBenchOptions *options)
+{
+    CCNxStackConfig *stackConfig = testingLower_ProtocolStackConfig(apiConnector_ProtocolStackConfig(ccnxStackConfig_Create()));
+    CCNxConnectionConfig *connConfig = testingLower_ConnectionConfig(apiConnector_ConnectionConfig(ccnxConnectionConfig_Create()));
+
+    if (options->codec) {
+        tlvCodec_ProtocolStackConfig(stackConfig);
+        tlvCodec_ConnectionConfig(connConfig);
+        publicKeySigner_ConnectionConfig(connConfig, options->keystorePath, keystorePassword);
+        protocolStack_ComponentsConfigArgs(stackConfig, apiConnector_GetName(), tlvCodec_GetName(), testingLower_GetName(), NULL);
+    } else {
+        protocolStack_ComponentsConfigArgs(stackConfig, apiConnector_GetName(), testingLower_GetName(), NULL);
+    }
+
+    CCNxTransportConfig *config = ccnxTransportConfig_Create(stackConfig, connConfig);
+    ccnxStackConfig_Release(&stackConfig);
+    return config;
+}
+
+static bool
+connbenchIsOpen(RTATransport *transport, int queueId)
+{
+    RtaConnectionStats stats;
+    return rtaTransport_GetConnectionStats(transport, queueId, &stats) && stats.counters[API_CONNECTOR][STATS_OPENS] > 0;
+}
+
+/*
+ * Wait for the connections [first, last) to open, recording the latency of each
+ *
+ * @return false The deadline passed first
+ */
+static bool
+connbenchWaitOpen(RTATransport *transport, const int queueIds[], const uint64_t issuedNanos[], unsigned first, unsigned last,
+                  uint64_t deadline, ConnBenchResults *results)
+{
+    for (unsigned i = first; i < last; i++) {
+        while (!connbenchIsOpen(transport, queueIds[i])) {
+            if (connbenchNanos() > deadline) {
+                return false;
+            }
+        }
+        rtaLatencyHistogram_Record(results->openLatency, connbenchNanos() - issuedNanos[i]);
+    }
+    return true;
+}
+
+static void
+connbenchOpen(RTATransport *transport, CCNxTransportConfig *config, const ConnBenchOptions *options,
+              int queueIds[], uint64_t issuedNanos[], ConnBenchResults *results)
+{
+    uint64_t start = connbenchNanos();
+    uint64_t deadline = start + options->timeoutSeconds * 1000000000ULL;
+
+    while (results->opened < options->connections && !results->timedOut) {
+        unsigned first = results->opened;
+        unsigned want = options->connections - first;
+        if (want > options->batch) {
+            want = options->batch;
+        }
+
+        unsigned last = first;
+        if (options->mode == ConnBenchMode_OpenMany) {
+            uint64_t t0 = connbenchNanos();
+            int count = rtaTransport_OpenMany(transport, config, (int) want, &queueIds[first]);
+            uint64_t t1 = connbenchNanos();
+            rtaLatencyHistogram_Record(results->openCall, t1 - t0);
+            for (int i = 0; i < count; i++) {
+                issuedNanos[last++] = t0;
+            }
+        } else {
+            for (unsigned i = 0; i < want; i++) {
+                uint64_t t0 = connbenchNanos();
+                queueIds[last] = rtaTransport_Open(transport, config);
+                rtaLatencyHistogram_Record(results->openCall, connbenchNanos() - t0);
+                issuedNanos[last++] = t0;
+            }
+        }
+
+        results->timedOut = !connbenchWaitOpen(transport, queueIds, issuedNanos, first, last, deadline, results);
+        results->opened = last;
+
+        if (last - first < want) {
+            fprintf(stderr, "out of descriptors after %u connections\n", last);
+            break;
+        }
+    }
+
+    results->openNanos = connbenchNanos() - start;
+}
+
+static void
+connbenchClose(RTATransport *transport, const int queueIds[], ConnBenchResults *results)
+{
+    uint64_t start = connbenchNanos();
+
+    for (unsigned i = 0; i < results->opened; i++) {
+        uint64_t t0 = connbenchNanos();
+        rtaTransport_Close(transport, queueIds[i]);
+        rtaLatencyHistogram_Record(results->closeCall, connbenchNanos() - t0);
+    }
+
+    // answered after the Transport has processed every close ahead of it
+    PARCJSON *stats = rtaTransport_GetStatistics(transport, NULL);
+    parcJSON_Release(&stats);
+
+    results->closeNanos = connbenchNanos() - start;
+}
+
+// =====================================================================
+// Report
+
+static void
+connbenchAddHistogram(PARCJSON *json, const char *name, const RtaLatencyHistogram *histogram)
+{
+    PARCJSON *value = rtaLatencyHistogram_ToJSON(histogram);
+    parcJSON_AddObject(json, name, value);
+    parcJSON_Release(&value);
+}
+
+static void
+connbenchReport(const ConnBenchOptions *options, const ConnBenchResults *results)
+{
+    PARCJSON *json = parcJSON_Create();
+
+    parcJSON_AddString(json, "benchmark", options->mode == ConnBenchMode_OpenMany ? "openmany" : "open");
+    parcJSON_AddString(json, "stack", options->codec ? "api,tlv,testing" : "api,testing");
+    parcJSON_AddInteger(json, "connections", results->opened);
+    parcJSON_AddInteger(json, "batch", options->batch);
+    parcJSON_AddBoolean(json, "timedOut", results->timedOut);
+
+    double openSeconds = (double) results->openNanos * 1E-9;
+    double closeSeconds = (double) results->closeNanos * 1E-9;
+    parcJSON_AddInteger(json, "openNanos", (int64_t) results->openNanos);
+    parcJSON_AddInteger(json, "opensPerSecond", openSeconds > 0 ? (int64_t) (results->opened / openSeconds) : 0);
+    parcJSON_AddInteger(json, "closeNanos", (int64_t) results->closeNanos);
+    parcJSON_AddInteger(json, "closesPerSecond", closeSeconds > 0 ? (int64_t) (results->opened / closeSeconds) : 0);
+
+    parcJSON_AddInteger(json, "rssBytesPerConnection", results->opened > 0 ? results->rssBytes / results->opened : 0);
+    parcJSON_AddInteger(json, "allocationsPerConnection", results->opened > 0 ? results->allocations / results->opened : 0);
+    parcJSON_AddInteger(json, "leakedAllocations", results->leakedAllocations);
+
+    connbenchAddHistogram(json, "openCall", results->openCall);
+    connbenchAddHistogram(json, "openLatency", results->openLatency);
+    connbenchAddHistogram(json, "closeCall", results->closeCall);
+
+    char *string = parcJSON_ToString(json);
+    printf("%s\n", string);
+    parcMemory_Deallocate((void **) &string);
+    parcJSON_Release(&json);
+}
+
+// =====================================================================
+// Command line
+
+static void
+usage(const char *program)
+{
+    printf("usage: %s [options]\n", program);
+    printf("  -m, --mode open|openmany    how connections are opened (default openmany)\n");
+    printf("  -c, --connections n         connections to open (default 10000)\n");
+    printf("  -b, --batch n               connections opened before waiting for them (default 1000)\n");
+    printf("  -t, --timeout seconds       give up opening after this long (default 60)\n");
+    printf("      --codec                 put the TLV codec in the stack\n");
+    printf("  -k, --keystore path         keystore file to create for --codec (default /tmp/rta_connbench_keystore)\n");
+    printf("  -h, --help\n");
+}
+
+static bool
+parseCommandLine(int argc, char *argv[], ConnBenchOptions *options)
+{
+    enum { OPT_CODEC = 256 };
+
+    static const struct option longOptions[] = {
+        { "mode",        required_argument, NULL, 'm'       },
+        { "connections", required_argument, NULL, 'c'       },
+        { "batch",       required_argument, NULL, 'b'       },
+        { "timeout",     required_argument, NULL, 't'       },
+        { "codec",       no_argument,       NULL, OPT_CODEC },
+        { "keystore",    required_argument, NULL, 'k'       },
+        { "help",        no_argument,       NULL, 'h'       },
+        { NULL,          0,                 NULL, 0         }
+    };
+
+    memset(options, 0, sizeof(ConnBenchOptions));
+    options->mode = ConnBenchMode_OpenMany;
+    options->connections = 10000;
+    options->batch = 1000;
+    options->timeoutSeconds = 60;
+    options->keystorePath = "/tmp/rta_connbench_keystore";
+
+    int c;
+    while ((c = getopt_long(argc, argv, "m:c:b:t:k:h", longOptions, NULL)) != -1) {
+        switch (c) {
+            case 'm':
+                if (strcmp(optarg, "open") == 0) {
+                    options->mode = ConnBenchMode_Open;
+                } else if (strcmp(optarg, "openmany") == 0) {
+                    options->mode = ConnBenchMode_OpenMany;
+                } else {
+                    fprintf(stderr, "unknown mode '%s'\n", optarg);
+                    return false;
+                }
+                break;
+
+            case 'c':
+                options->connections = (unsigned) strtoul(optarg, NULL, 10);
+                break;
+
+            case 'b':
+                options->batch = (unsigned) strtoul(optarg, NULL, 10);
+                break;
+
+            case 't':
+                options->timeoutSeconds = (unsigned) strtoul(optarg, NULL, 10);
+                break;
+
+            case OPT_CODEC:
+                options->codec = true;
+                break;
+
+            case 'k':
+                options->keystorePath = optarg;
+                break;
+
+            case 'h':
+            default:
+                return false;
+        }
+    }
+
+    if (options->connections == 0 || options->batch == 0) {
+        fprintf(stderr, "connections and batch must be positive\n");
+        return false;
+    }
+
+    return true;
+}
+
+// =====================================================================
+
+int
+main(int argc, char *argv[])
+{
+    ConnBenchOptions options;
+    if (!parseCommandLine(argc, argv, &options)) {
+        usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    // one more for the warm up connection
+    unsigned maxConnections = connbenchMaxConnections();
+    if (maxConnections < 2) {
+        fprintf(stderr, "the descriptor limit does not allow any connections\n");
+        exit(EXIT_FAILURE);
+    }
+    if (options.connections > maxConnections - 1) {
+        fprintf(stderr, "the descriptor limit allows %u connections\n", maxConnections - 1);
+        options.connections = maxConnections - 1;
+    }
+
+    parcSecurity_Init();
+
+    if (options.codec) {
+        unlink(options.keystorePath);
+        bool success = parcPkcs12KeyStore_CreateFile(options.keystorePath, keystorePassword, "rta_connbench", 1024, 30);
+        assertTrue(success, "parcPkcs12KeyStore_CreateFile(%s) failed", options.keystorePath);
+    }
+
+    RTATransport *transport = rtaTransport_Create();
+    assertNotNull(transport, "rtaTransport_Create returned null");
+
+    CCNxTransportConfig *config = connbenchCreateConfig(&options);
+
+    int *queueIds = parcMemory_AllocateAndClear(options.connections * sizeof(int));
+    assertNotNull(queueIds, "parcMemory_AllocateAndClear(%zu) returned NULL", options.connections * sizeof(int));
+    uint64_t *issuedNanos = parcMemory_AllocateAndClear(options.connections * sizeof(uint64_t));
+    assertNotNull(issuedNanos, "parcMemory_AllocateAndClear(%zu) returned NULL", options.connections * sizeof(uint64_t));
+
+    ConnBenchResults results;
+    memset(&results, 0, sizeof(results));
+    results.openCall = rtaLatencyHistogram_Create();
+    results.openLatency = rtaLatencyHistogram_Create();
+    results.closeCall = rtaLatencyHistogram_Create();
+
+    // the first open creates the protocol stack, keep it out of the measurement
+    int warmup = rtaTransport_Open(transport, config);
+    while (!connbenchIsOpen(transport, warmup)) {
+        usleep(100);
+    }
+
+    int64_t rssBefore = connbenchResidentBytes();
+    int64_t allocationsBefore = parcMemory_Outstanding();
+
+    connbenchOpen(transport, config, &options, queueIds, issuedNanos, &results);
+
+    results.rssBytes = connbenchResidentBytes() - rssBefore;
+    results.allocations = parcMemory_Outstanding() - allocationsBefore;
+
+    connbenchClose(transport, queueIds, &results);
+
+    results.leakedAllocations = parcMemory_Outstanding() - allocationsBefore;
+
+    connbenchReport(&options, &results);
+
+    rtaTransport_Close(transport, warmup);
+
+    rtaLatencyHistogram_Destroy(&results.openCall);
+    rtaLatencyHistogram_Destroy(&results.openLatency);
+    rtaLatencyHistogram_Destroy(&results.closeCall);
+    parcMemory_Deallocate((void **) &issuedNanos);
+    parcMemory_Deallocate((void **) &queueIds);
+    ccnxTransportConfig_Destroy(&config);
+    rtaTransport_Destroy(&transport);
+
+    if (options.codec) {
+        unlink(options.keystorePath);
+    }
+    parcSecurity_Fini();
+
+    return results.timedOut ? EXIT_FAILURE : EXIT_SUCCESS;
+}
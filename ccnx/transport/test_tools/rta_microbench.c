@@ -0,0 +1,964 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * Per-component microbenchmark of the RTA transport.
+ *
+ * rta_microbench drives one component at a time through its RtaComponentOperations in a
+ * non-threaded framework (rtaFramework_NonThreadedStep), with the TESTING_UPPER and
+ * TESTING_LOWER components, whose operations are testing_null_ops, as the upper and lower
+ * sinks, and reports the cost of moving one message through it:
+ *
+ *   queue_hop        TESTING_UPPER -> TESTING_LOWER, the cost of one rtaComponent_PutMessage
+ *                    and rtaComponent_GetMessage with no component in between
+ *   codec_down       TLV codec encoding an Interest
+ *   codec_up         TLV codec decoding v1_interest_nameA
+ *   vegas_fetch      Vegas fetching --segments chunks; the sink at TESTING_LOWER answers each
+ *                    chunk Interest, a message is one Content Object delivered to TESTING_UPPER
+ *   api_down         API connector reading CCNxMetaMessage pointers from the API socket
+ *   api_up           API connector writing CCNxMetaMessage pointers to the API socket
+ *   metis_up         Metis connector framing and reading v1_interest_nameA from its socket
+ *   metis_down       Metis connector writing a wire format Interest to its socket
+ *
+ * The API connector benchmarks use the socketpair of a mock connection.  The Metis
+ * connector makes its own TCP connection, so a listener on 127.0.0.1 stands in for Metis.
+ *
+ * Messages are created before and destroyed after each measured batch.  ns/msg is wall
+ * clock time of the batch, including the event dispatch of rtaFramework_NonThreadedStep.
+ * allocs/msg counts calls to parcMemory_Allocate, AllocateAndClear, MemAlign, Reallocate
+ * and StringDuplicate during the batch, so allocations made directly with malloc (e.g.
+ * inside libevent or OpenSSL) are not included.
+ *
+ * Example:
+ *
+ *     rta_microbench -n 100000 -b 64 codec_down codec_up
+ *
+ * With no benchmark names, all of them run.
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+#include <config.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_StdlibMemory.h>
+#include <parc/concurrent/parc_Notifier.h>
+#include <ccnx/transport/transport_rta/commands/rta_CommandQueue.h>
+#include <parc/security/parc_Pkcs12KeyStore.h>
+#include <parc/security/parc_Security.h>
+
+#include <ccnx/common/ccnx_ContentObject.h>
+#include <ccnx/common/ccnx_Interest.h>
+#include <ccnx/common/ccnx_NameSegmentNumber.h>
+#include <ccnx/common/ccnx_WireFormatMessage.h>
+#include <ccnx/common/codec/schema_v1/testdata/v1_interest_nameA.h>
+
+#include <ccnx/transport/common/transport_Message.h>
+#include <ccnx/transport/common/transport_MetaMessage.h>
+#include <ccnx/transport/transport_rta/commands/rta_Command.h>
+#include <ccnx/transport/transport_rta/config/config_All.h>
+#include <ccnx/transport/transport_rta/core/rta_Component.h>
+#include <ccnx/transport/transport_rta/core/rta_Framework.h>
+#include <ccnx/transport/transport_rta/core/rta_Framework_NonThreaded.h>
+#include <ccnx/transport/transport_rta/core/rta_Framework_private.h>
+#include <ccnx/transport/transport_rta/core/rta_ProtocolStack.h>
+
+#include <ccnx/transport/test_tools/traffic_tools.h>
+
+// a batch that makes no progress in this many steps (about 1 msec each when idle) is stuck
+#define MICRO_MAX_IDLE_STEPS 5000
+
+static const char vegasPrefix[] = "lci:/microbench/vegas";
+static const char keystorePassword[] = "rta_microbench";
+
+typedef struct micro_options {
+    unsigned count;             // messages per benchmark
+    unsigned batch;             // messages in flight per measured batch
+    unsigned segments;          // chunks fetched by vegas_fetch
+    const char *keystorePath;
+} MicroOptions;
+
+typedef struct micro_result {
+    uint64_t messages;
+    uint64_t nanos;
+    uint64_t allocations;
+
+    uint64_t startNanos;
+    uint64_t startAllocations;
+} MicroResult;
+
+typedef struct micro_stack {
+    RtaCommandQueue *commandQueue;
+    PARCNotifier *commandNotifier;
+    RtaFramework *framework;
+
+    int stackId;
+    RtaProtocolStack *stack;
+
+    int connectionFds[2];
+    RtaConnection *connection;
+} MicroStack;
+
+typedef TransportMessage *(MicroFactory)(MicroStack *micro);
+
+// =====================================================================
+// Counting parcMemory interface
+
+static uint64_t microAllocations = 0;
+
+static void *
+_microMemory_Allocate(size_t size)
+{
+    microAllocations++;
+    return parcStdlibMemory_Allocate(size);
+}
+
+static void *
+_microMemory_AllocateAndClear(size_t size)
+{
+    microAllocations++;
+    return parcStdlibMemory_AllocateAndClear(size);
+}
+
+static int
+_microMemory_MemAlign(void **pointer, size_t alignment, size_t size)
+{
+    microAllocations++;
+    return parcStdlibMemory_MemAlign(pointer, alignment, size);
+}
+
+static void *
+_microMemory_Reallocate(void *pointer, size_t newSize)
+{
+    microAllocations++;
+    return parcStdlibMemory_Reallocate(pointer, newSize);
+}
+
+static char *
+_microMemory_StringDuplicate(const char *string, size_t length)
+{
+    microAllocations++;
+    return parcStdlibMemory_StringDuplicate(string, length);
+}
+
+static PARCMemoryInterface microCountingMemory = {
+    .Allocate         = (uintptr_t) _microMemory_Allocate,
+    .AllocateAndClear = (uintptr_t) _microMemory_AllocateAndClear,
+    .MemAlign         = (uintptr_t) _microMemory_MemAlign,
+    .Deallocate       = (uintptr_t) parcStdlibMemory_Deallocate,
+    .Reallocate       = (uintptr_t) _microMemory_Reallocate,
+    .StringDuplicate  = (uintptr_t) _microMemory_StringDuplicate,
+    .Outstanding      = (uintptr_t) parcStdlibMemory_Outstanding
+};
+
+// =====================================================================
+
+static uint64_t
+microNanos(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;
+}
+
+static void
+microResult_Start(MicroResult *result)
+{
+    result->startAllocations = microAllocations;
+    result->startNanos = microNanos();
+}
+
+static void
+microResult_Stop(MicroResult *result, uint64_t messages)
+{
+    result->nanos += microNanos() - result->startNanos;
+    result->allocations += microAllocations - result->startAllocations;
+    result->messages += messages;
+}
+
+static void
+microStep(MicroStack *micro, unsigned *idleSteps)
+{
+    (*idleSteps)++;
+    assertTrue(*idleSteps < MICRO_MAX_IDLE_STEPS, "No progress after %u steps", *idleSteps);
+    rtaFramework_NonThreadedStep(micro->framework);
+}
+
+static void
+microSetNonBlocking(int fd)
+{
+    int flags = fcntl(fd, F_GETFL, 0);
+    int failure = fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    assertFalse(failure, "fcntl(O_NONBLOCK) failed: (%d) %s", errno, strerror(errno));
+}
+
+// =====================================================================
+// Non-threaded framework with one stack and one connection, set up through the same
+// command ring buffer rtaTransport uses
+
+static void
+microStack_Execute(MicroStack *micro, RtaCommand *command)
+{
+    bool success = rtaCommand_Write(command, micro->commandQueue, CCNxStackTimeout_Immediate);
+    assertTrue(success, "Command ring buffer is full");
+    rtaCommand_Release(&command);
+
+    parcNotifier_Notify(micro->commandNotifier);
+    rtaFramework_NonThreadedStepCount(micro->framework, 2);
+}
+
+static MicroStack *
+microStack_Create(CCNxTransportConfig *config)
+{
+    MicroStack *micro = parcMemory_AllocateAndClear(sizeof(MicroStack));
+    assertNotNull(micro, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(MicroStack));
+
+    micro->commandQueue = rtaCommandQueue_Create(128);
+    micro->commandNotifier = parcNotifier_Create();
+    micro->framework = rtaFramework_Create(micro->commandQueue, micro->commandNotifier);
+    micro->stackId = 1;
+
+    RtaCommandCreateProtocolStack *createStack =
+        rtaCommandCreateProtocolStack_Create(micro->stackId, ccnxTransportConfig_GetStackConfig(config));
+    microStack_Execute(micro, rtaCommand_CreateCreateProtocolStack(createStack));
+    rtaCommandCreateProtocolStack_Release(&createStack);
+
+    FrameworkProtocolHolder *holder;
+    TAILQ_FOREACH(holder, &micro->framework->protocols_head, list)
+    {
+        if (holder->stack_id == micro->stackId) {
+            micro->stack = holder->stack;
+        }
+    }
+    assertNotNull(micro->stack, "Framework did not create stack %d", micro->stackId);
+
+    int failure = socketpair(AF_UNIX, SOCK_STREAM, 0, micro->connectionFds);
+    assertFalse(failure, "Error creating socket pair: (%d) %s", errno, strerror(errno));
+    microSetNonBlocking(micro->connectionFds[0]);
+
+    RtaCommandOpenConnection *openConnection =
+        rtaCommandOpenConnection_Create(micro->stackId, micro->connectionFds[0], micro->connectionFds[1],
+                                        ccnxConnectionConfig_GetJson(ccnxTransportConfig_GetConnectionConfig(config)));
+    microStack_Execute(micro, rtaCommand_CreateOpenConnection(openConnection));
+    rtaCommandOpenConnection_Release(&openConnection);
+
+    micro->connection = rtaConnectionTable_GetByApiFd(micro->framework->connectionTable, micro->connectionFds[0]);
+    assertNotNull(micro->connection, "Framework did not open a connection on fd %d", micro->connectionFds[0]);
+
+    // discard notifications the stack sent up while opening
+    CCNxMetaMessage *message;
+    while (read(micro->connectionFds[0], &message, sizeof(message)) == sizeof(message)) {
+        ccnxMetaMessage_Release(&message);
+    }
+
+    return micro;
+}
+
+static void
+microStack_Destroy(MicroStack **microPtr)
+{
+    MicroStack *micro = *microPtr;
+
+    rtaFramework_Teardown(micro->framework);
+    rtaFramework_Destroy(&micro->framework);
+
+    rtaCommandQueue_Release(&micro->commandQueue);
+    parcNotifier_Release(&micro->commandNotifier);
+
+    close(micro->connectionFds[0]);
+    close(micro->connectionFds[1]);
+
+    parcMemory_Deallocate((void **) &micro);
+    *microPtr = NULL;
+}
+
+static PARCEventQueue *
+microStack_Queue(MicroStack *micro, int component, RtaDirection direction)
+{
+    return rtaProtocolStack_GetPutQueue(micro->stack, component, direction);
+}
+
+// =====================================================================
+// Configurations.  Every stack has the API connector on top because it owns the connection's
+// socket, and TESTING_UPPER below it as the sink we put to and get from.  TESTING_UPPER and
+// TESTING_LOWER are the sinks: rtaProtocolStack configures both with testing_null_ops, so
+// they never read their queues and the benchmark drains them itself.  The Metis benchmarks
+// have no lower sink, the connector's socket is the bottom of the stack.
+
+static CCNxTransportConfig *
+microCreateConfig(const MicroOptions *options, const char *middle, const char *lower, uint16_t metisPort)
+{
+    CCNxStackConfig *stackConfig = testingUpper_ProtocolStackConfig(apiConnector_ProtocolStackConfig(ccnxStackConfig_Create()));
+    CCNxConnectionConfig *connConfig =
+        testingUpper_ConnectionConfig(apiConnector_ConnectionConfig(tlvCodec_ConnectionConfig(ccnxConnectionConfig_Create())));
+
+    if (middle != NULL && strcmp(middle, tlvCodec_GetName()) == 0) {
+        tlvCodec_ProtocolStackConfig(stackConfig);
+    } else if (middle != NULL && strcmp(middle, vegasFlowController_GetName()) == 0) {
+        vegasFlowController_ProtocolStackConfig(stackConfig);
+        vegasFlowController_ConnectionConfig(connConfig);
+    }
+
+    if (strcmp(lower, metisForwarder_GetName()) == 0) {
+        metisForwarder_ProtocolStackConfig(stackConfig);
+        metisForwarder_ConnectionConfig(connConfig, metisPort);
+    } else {
+        testingLower_ProtocolStackConfig(stackConfig);
+        testingLower_ConnectionConfig(connConfig);
+    }
+
+    if (middle != NULL) {
+        protocolStack_ComponentsConfigArgs(stackConfig, apiConnector_GetName(), testingUpper_GetName(), middle, lower, NULL);
+    } else {
+        protocolStack_ComponentsConfigArgs(stackConfig, apiConnector_GetName(), testingUpper_GetName(), lower, NULL);
+    }
+
+    publicKeySigner_ConnectionConfig(connConfig, options->keystorePath, keystorePassword);
+
+    CCNxTransportConfig *config = ccnxTransportConfig_Create(stackConfig, connConfig);
+    ccnxStackConfig_Release(&stackConfig);
+    return config;
+}
+
+// =====================================================================
+// Message factories
+
+static TransportMessage *
+microCreateInterest(MicroStack *micro)
+{
+    return trafficTools_CreateTransportMessageWithInterest(micro->connection);
+}
+
+static TransportMessage *
+microCreateWireFormatInterest(MicroStack *micro)
+{
+    PARCBuffer *wireFormat = parcBuffer_Wrap(v1_interest_nameA, sizeof(v1_interest_nameA), 0, sizeof(v1_interest_nameA));
+    CCNxTlvDictionary *dictionary = ccnxWireFormatMessage_FromInterestPacketType(CCNxTlvDictionary_SchemaVersion_V1, wireFormat);
+    parcBuffer_Release(&wireFormat);
+
+    TransportMessage *tm = transportMessage_CreateFromDictionary(dictionary);
+    transportMessage_SetInfo(tm, rtaConnection_Copy(micro->connection), rtaConnection_FreeFunc);
+    ccnxTlvDictionary_Release(&dictionary);
+    return tm;
+}
+
+static TransportMessage *
+microCreateContentObject(MicroStack *micro, const CCNxName *name, uint64_t finalChunk)
+{
+    PARCBuffer *payload = parcBuffer_WrapCString("rta_microbench");
+    CCNxContentObject *contentObject = ccnxContentObject_CreateWithNameAndPayload(name, payload);
+    parcBuffer_Release(&payload);
+
+    if (finalChunk != UINT64_MAX) {
+        ccnxContentObject_SetFinalChunkNumber(contentObject, finalChunk);
+    }
+
+    TransportMessage *tm = transportMessage_CreateFromDictionary(contentObject);
+    transportMessage_SetInfo(tm, rtaConnection_Copy(micro->connection), rtaConnection_FreeFunc);
+    ccnxContentObject_Release(&contentObject);
+    return tm;
+}
+
+// =====================================================================
+// Benchmarks
+
+/*
+ * Put a batch of messages in one queue and take them out of another.  Control messages
+ * that come out (e.g. a connector's notifications) are discarded and not counted.
+ */
+static void
+microPump(MicroStack *micro, PARCEventQueue *in, PARCEventQueue *out, MicroFactory *factory,
+          const MicroOptions *options, MicroResult *result)
+{
+    TransportMessage **batch = parcMemory_AllocateAndClear(options->batch * sizeof(TransportMessage *));
+
+    unsigned remaining = options->count;
+    while (remaining > 0) {
+        unsigned length = remaining < options->batch ? remaining : options->batch;
+        for (unsigned i = 0; i < length; i++) {
+            batch[i] = factory(micro);
+        }
+
+        microResult_Start(result);
+        for (unsigned i = 0; i < length; i++) {
+            rtaComponent_PutMessage(in, batch[i]);
+        }
+
+        unsigned received = 0;
+        unsigned idleSteps = 0;
+        while (received < length) {
+            TransportMessage *tm = rtaComponent_GetMessage(out);
+            if (tm == NULL) {
+                microStep(micro, &idleSteps);
+            } else if (transportMessage_IsControl(tm)) {
+                transportMessage_Destroy(&tm);
+            } else {
+                batch[received++] = tm;
+                idleSteps = 0;
+            }
+        }
+        microResult_Stop(result, length);
+
+        for (unsigned i = 0; i < length; i++) {
+            transportMessage_Destroy(&batch[i]);
+        }
+        remaining -= length;
+    }
+
+    parcMemory_Deallocate((void **) &batch);
+}
+
+static void
+microBench_QueueHop(const MicroOptions *options, MicroResult *result)
+{
+    CCNxTransportConfig *config = microCreateConfig(options, NULL, testingLower_GetName(), 0);
+    MicroStack *micro = microStack_Create(config);
+
+    microPump(micro, microStack_Queue(micro, TESTING_UPPER, RTA_DOWN), microStack_Queue(micro, TESTING_LOWER, RTA_UP),
+              microCreateInterest, options, result);
+
+    microStack_Destroy(&micro);
+    ccnxTransportConfig_Destroy(&config);
+}
+
+static void
+microBench_CodecDown(const MicroOptions *options, MicroResult *result)
+{
+    CCNxTransportConfig *config = microCreateConfig(options, tlvCodec_GetName(), testingLower_GetName(), 0);
+    MicroStack *micro = microStack_Create(config);
+
+    microPump(micro, microStack_Queue(micro, TESTING_UPPER, RTA_DOWN), microStack_Queue(micro, TESTING_LOWER, RTA_UP),
+              microCreateInterest, options, result);
+
+    microStack_Destroy(&micro);
+    ccnxTransportConfig_Destroy(&config);
+}
+
+static void
+microBench_CodecUp(const MicroOptions *options, MicroResult *result)
+{
+    CCNxTransportConfig *config = microCreateConfig(options, tlvCodec_GetName(), testingLower_GetName(), 0);
+    MicroStack *micro = microStack_Create(config);
+
+    microPump(micro, microStack_Queue(micro, TESTING_LOWER, RTA_UP), microStack_Queue(micro, TESTING_UPPER, RTA_DOWN),
+              microCreateWireFormatInterest, options, result);
+
+    microStack_Destroy(&micro);
+    ccnxTransportConfig_Destroy(&config);
+}
+
+/*
+ * Fetch options->segments chunks through Vegas, answering each chunk Interest at TESTING_LOWER.
+ * Creating the answers is not measured.
+ */
+static void
+microBench_VegasFetch(const MicroOptions *options, MicroResult *result)
+{
+    CCNxTransportConfig *config = microCreateConfig(options, vegasFlowController_GetName(), testingLower_GetName(), 0);
+    MicroStack *micro = microStack_Create(config);
+
+    PARCEventQueue *upper = microStack_Queue(micro, TESTING_UPPER, RTA_DOWN);
+    PARCEventQueue *lower = microStack_Queue(micro, TESTING_LOWER, RTA_UP);
+    uint64_t finalChunk = options->segments - 1;
+
+    CCNxName *basename = ccnxName_CreateFromCString(vegasPrefix);
+    CCNxInterest *interest = ccnxInterest_CreateSimple(basename);
+    TransportMessage *start = transportMessage_CreateFromDictionary(interest);
+    transportMessage_SetInfo(start, rtaConnection_Copy(micro->connection), rtaConnection_FreeFunc);
+    ccnxInterest_Release(&interest);
+
+    microResult_Start(result);
+    rtaComponent_PutMessage(upper, start);
+
+    unsigned received = 0;
+    unsigned idleSteps = 0;
+    while (received < options->segments) {
+        bool progress = false;
+
+        TransportMessage *tm;
+        while ((tm = rtaComponent_GetMessage(lower)) != NULL) {
+            progress = true;
+            if (!transportMessage_IsInterest(tm)) {
+                transportMessage_Destroy(&tm);
+                continue;
+            }
+            CCNxName *name = ccnxInterest_GetName(transportMessage_GetDictionary(tm));
+
+            microResult_Stop(result, 0);
+            TransportMessage *response = microCreateContentObject(micro, name, finalChunk);
+            transportMessage_Destroy(&tm);
+            microResult_Start(result);
+
+            rtaComponent_PutMessage(lower, response);
+        }
+
+        while ((tm = rtaComponent_GetMessage(upper)) != NULL) {
+            progress = true;
+            if (transportMessage_IsContentObject(tm)) {
+                received++;
+            }
+            transportMessage_Destroy(&tm);
+        }
+
+        if (progress) {
+            idleSteps = 0;
+        }
+        if (received < options->segments) {
+            microStep(micro, &idleSteps);
+        }
+    }
+    microResult_Stop(result, received);
+
+    ccnxName_Release(&basename);
+    microStack_Destroy(&micro);
+    ccnxTransportConfig_Destroy(&config);
+}
+
+static void
+microBench_ApiDown(const MicroOptions *options, MicroResult *result)
+{
+    CCNxTransportConfig *config = microCreateConfig(options, NULL, testingLower_GetName(), 0);
+    MicroStack *micro = microStack_Create(config);
+    PARCEventQueue *lower = microStack_Queue(micro, TESTING_LOWER, RTA_UP);
+
+    CCNxTlvDictionary *interest = trafficTools_CreateDictionaryInterest();
+    CCNxMetaMessage **batch = parcMemory_AllocateAndClear(options->batch * sizeof(CCNxMetaMessage *));
+
+    unsigned remaining = options->count;
+    while (remaining > 0) {
+        unsigned length = remaining < options->batch ? remaining : options->batch;
+        for (unsigned i = 0; i < length; i++) {
+            batch[i] = ccnxMetaMessage_Acquire(interest);
+        }
+
+        microResult_Start(result);
+
+        // the API connector releases the reference it reads, like rtaTransport_Send
+        ssize_t nwritten = write(micro->connectionFds[0], batch, length * sizeof(CCNxMetaMessage *));
+        assertTrue(nwritten == (ssize_t) (length * sizeof(CCNxMetaMessage *)),
+                   "Short write to the API socket: (%d) %s", errno, strerror(errno));
+
+        unsigned received = 0;
+        unsigned idleSteps = 0;
+        while (received < length) {
+            TransportMessage *tm = rtaComponent_GetMessage(lower);
+            if (tm == NULL) {
+                microStep(micro, &idleSteps);
+            } else {
+                received++;
+                idleSteps = 0;
+                transportMessage_Destroy(&tm);
+            }
+        }
+        microResult_Stop(result, length);
+        remaining -= length;
+    }
+
+    parcMemory_Deallocate((void **) &batch);
+    ccnxTlvDictionary_Release(&interest);
+    microStack_Destroy(&micro);
+    ccnxTransportConfig_Destroy(&config);
+}
+
+static void
+microBench_ApiUp(const MicroOptions *options, MicroResult *result)
+{
+    CCNxTransportConfig *config = microCreateConfig(options, NULL, testingLower_GetName(), 0);
+    MicroStack *micro = microStack_Create(config);
+    PARCEventQueue *lower = microStack_Queue(micro, TESTING_LOWER, RTA_UP);
+
+    CCNxName *name = ccnxName_CreateFromCString(vegasPrefix);
+    TransportMessage **batch = parcMemory_AllocateAndClear(options->batch * sizeof(TransportMessage *));
+    CCNxMetaMessage **messages = parcMemory_AllocateAndClear(options->batch * sizeof(CCNxMetaMessage *));
+
+    unsigned remaining = options->count;
+    while (remaining > 0) {
+        unsigned length = remaining < options->batch ? remaining : options->batch;
+        for (unsigned i = 0; i < length; i++) {
+            batch[i] = microCreateContentObject(micro, name, UINT64_MAX);
+        }
+
+        microResult_Start(result);
+        for (unsigned i = 0; i < length; i++) {
+            rtaComponent_PutMessage(lower, batch[i]);
+        }
+
+        unsigned received = 0;
+        unsigned idleSteps = 0;
+        while (received < length) {
+            ssize_t nread = read(micro->connectionFds[0], &messages[received], (length - received) * sizeof(CCNxMetaMessage *));
+            if (nread > 0) {
+                assertTrue(nread % sizeof(CCNxMetaMessage *) == 0, "Partial pointer read from the API socket");
+                received += (unsigned) (nread / sizeof(CCNxMetaMessage *));
+                idleSteps = 0;
+            } else {
+                microStep(micro, &idleSteps);
+            }
+        }
+        microResult_Stop(result, length);
+
+        for (unsigned i = 0; i < length; i++) {
+            ccnxMetaMessage_Release(&messages[i]);
+        }
+        remaining -= length;
+    }
+
+    parcMemory_Deallocate((void **) &messages);
+    parcMemory_Deallocate((void **) &batch);
+    ccnxName_Release(&name);
+    microStack_Destroy(&micro);
+    ccnxTransportConfig_Destroy(&config);
+}
+
+/*
+ * Listen on 127.0.0.1 and open a Metis connection to it.  Returns the accepted socket.
+ */
+static int
+microMetisConnect(const MicroOptions *options, MicroStack **microOutput, CCNxTransportConfig **configOutput)
+{
+    int listener = socket(PF_INET, SOCK_STREAM, 0);
+    assertFalse(listener < 0, "socket failed: (%d) %s", errno, strerror(errno));
+
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = PF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addressLength = sizeof(address);
+
+    int failure = bind(listener, (struct sockaddr *) &address, addressLength);
+    assertFalse(failure, "bind failed: (%d) %s", errno, strerror(errno));
+    failure = listen(listener, 1);
+    assertFalse(failure, "listen failed: (%d) %s", errno, strerror(errno));
+    getsockname(listener, (struct sockaddr *) &address, &addressLength);
+
+    *configOutput = microCreateConfig(options, NULL, metisForwarder_GetName(), ntohs(address.sin_port));
+    *microOutput = microStack_Create(*configOutput);
+
+    int fd = accept(listener, NULL, NULL);
+    assertFalse(fd < 0, "accept failed: (%d) %s", errno, strerror(errno));
+    close(listener);
+
+    microSetNonBlocking(fd);
+
+    // let the connector see its connect complete
+    rtaFramework_NonThreadedStepCount((*microOutput)->framework, 5);
+    return fd;
+}
+
+static void
+microBench_MetisUp(const MicroOptions *options, MicroResult *result)
+{
+    MicroStack *micro;
+    CCNxTransportConfig *config;
+    int fd = microMetisConnect(options, &micro, &config);
+    PARCEventQueue *upper = microStack_Queue(micro, TESTING_UPPER, RTA_DOWN);
+
+    size_t packetLength = sizeof(v1_interest_nameA);
+    uint8_t *packets = parcMemory_Allocate(options->batch * packetLength);
+    for (unsigned i = 0; i < options->batch; i++) {
+        memcpy(packets + i * packetLength, v1_interest_nameA, packetLength);
+    }
+
+    unsigned remaining = options->count;
+    while (remaining > 0) {
+        unsigned length = remaining < options->batch ? remaining : options->batch;
+
+        microResult_Start(result);
+        ssize_t nwritten = write(fd, packets, length * packetLength);
+        assertTrue(nwritten == (ssize_t) (length * packetLength), "Short write to the Metis socket: (%d) %s", errno, strerror(errno));
+
+        unsigned received = 0;
+        unsigned idleSteps = 0;
+        while (received < length) {
+            TransportMessage *tm = rtaComponent_GetMessage(upper);
+            if (tm == NULL) {
+                microStep(micro, &idleSteps);
+            } else {
+                if (!transportMessage_IsControl(tm)) {
+                    received++;
+                    idleSteps = 0;
+                }
+                transportMessage_Destroy(&tm);
+            }
+        }
+        microResult_Stop(result, length);
+        remaining -= length;
+    }
+
+    parcMemory_Deallocate((void **) &packets);
+    close(fd);
+    microStack_Destroy(&micro);
+    ccnxTransportConfig_Destroy(&config);
+}
+
+static void
+microBench_MetisDown(const MicroOptions *options, MicroResult *result)
+{
+    MicroStack *micro;
+    CCNxTransportConfig *config;
+    int fd = microMetisConnect(options, &micro, &config);
+    PARCEventQueue *upper = microStack_Queue(micro, TESTING_UPPER, RTA_DOWN);
+
+    TransportMessage **batch = parcMemory_AllocateAndClear(options->batch * sizeof(TransportMessage *));
+    uint8_t packets[64 * 1024];
+
+    unsigned remaining = options->count;
+    while (remaining > 0) {
+        unsigned length = remaining < options->batch ? remaining : options->batch;
+        for (unsigned i = 0; i < length; i++) {
+            batch[i] = microCreateWireFormatInterest(micro);
+        }
+
+        microResult_Start(result);
+        for (unsigned i = 0; i < length; i++) {
+            rtaComponent_PutMessage(upper, batch[i]);
+        }
+
+        size_t expected = length * sizeof(v1_interest_nameA);
+        size_t bytesRead = 0;
+        unsigned idleSteps = 0;
+        while (bytesRead < expected) {
+            ssize_t nread = read(fd, packets, sizeof(packets));
+            if (nread > 0) {
+                bytesRead += (size_t) nread;
+                idleSteps = 0;
+            } else {
+                microStep(micro, &idleSteps);
+            }
+        }
+        microResult_Stop(result, length);
+        remaining -= length;
+    }
+
+    parcMemory_Deallocate((void **) &batch);
+    close(fd);
+    microStack_Destroy(&micro);
+    ccnxTransportConfig_Destroy(&config);
+}
+
+// =====================================================================
+
+typedef struct micro_benchmark {
+    const char *name;
+    void (*run)(const MicroOptions *options, MicroResult *result);
+} MicroBenchmark;
+
+static const MicroBenchmark microBenchmarks[] = {
+    { .name = "queue_hop",   .run = microBench_QueueHop   },
+    { .name = "codec_down",  .run = microBench_CodecDown  },
+    { .name = "codec_up",    .run = microBench_CodecUp    },
+    { .name = "vegas_fetch", .run = microBench_VegasFetch },
+    { .name = "api_down",    .run = microBench_ApiDown    },
+    { .name = "api_up",      .run = microBench_ApiUp      },
+    { .name = "metis_up",    .run = microBench_MetisUp    },
+    { .name = "metis_down",  .run = microBench_MetisDown  },
+    { .name = NULL,          .run = NULL                  }
+};
+
+static void
+microRun(const MicroBenchmark *benchmark, const MicroOptions *options)
+{
+    MicroResult result;
+    memset(&result, 0, sizeof(result));
+
+    benchmark->run(options, &result);
+
+    double messages = result.messages > 0 ? (double) result.messages : 1.0;
+    printf("%-12s %10" PRIu64 " %12.1f %12.2f\n",
+           benchmark->name, result.messages, result.nanos / messages, result.allocations / messages);
+    fflush(stdout);
+}
+
+static void
+usage(const char *program)
+{
+    printf("usage: %s [-n count] [-b batch] [-s segments] [-k keystore] [benchmark ...]\n", program);
+    printf("\n");
+    printf("   -n, --count     Messages per benchmark (default 100000)\n");
+    printf("   -b, --batch     Messages in flight per measured batch (default 64)\n");
+    printf("   -s, --segments  Chunks fetched by vegas_fetch (default 10000)\n");
+    printf("   -k, --keystore  Temporary keystore (default /tmp/rta_microbench.p12)\n");
+    printf("\n");
+    printf("Benchmarks:");
+    for (int i = 0; microBenchmarks[i].name != NULL; i++) {
+        printf(" %s", microBenchmarks[i].name);
+    }
+    printf("\n");
+}
+
+static bool
+parseCommandLine(int argc, char *argv[], MicroOptions *options)
+{
+    static struct option longopts[] = {
+        { "count",    required_argument, NULL, 'n' },
+        { "batch",    required_argument, NULL, 'b' },
+        { "segments", required_argument, NULL, 's' },
+        { "keystore", required_argument, NULL, 'k' },
+        { "help",     no_argument,       NULL, 'h' },
+        { NULL,       0,                 NULL, 0   }
+    };
+
+    options->count = 100000;
+    options->batch = 64;
+    options->segments = 10000;
+    options->keystorePath = "/tmp/rta_microbench.p12";
+
+    int c;
+    while ((c = getopt_long(argc, argv, "n:b:s:k:h", longopts, NULL)) != -1) {
+        switch (c) {
+            case 'n':
+                options->count = (unsigned) strtoul(optarg, NULL, 10);
+                break;
+
+            case 'b':
+                options->batch = (unsigned) strtoul(optarg, NULL, 10);
+                break;
+
+            case 's':
+                options->segments = (unsigned) strtoul(optarg, NULL, 10);
+                break;
+
+            case 'k':
+                options->keystorePath = optarg;
+                break;
+
+            case 'h':
+            default:
+                return false;
+        }
+    }
+
+    if (options->count == 0 || options->batch == 0 || options->segments == 0) {
+        fprintf(stderr, "count, batch and segments must be positive\n");
+        return false;
+    }
+
+    // the API connector's socket buffers hold a little over 1000 pointers
+    if (options->batch > 512) {
+        fprintf(stderr, "batch must be at most 512\n");
+        return false;
+    }
+
+    return true;
+}
+
+static const MicroBenchmark *
+microFind(const char *name)
+{
+    for (int i = 0; microBenchmarks[i].name != NULL; i++) {
+        if (strcmp(microBenchmarks[i].name, name) == 0) {
+            return &microBenchmarks[i];
+        }
+    }
+    return NULL;
+}
+
+int
+main(int argc, char *argv[])
+{
+    MicroOptions options;
+    if (!parseCommandLine(argc, argv, &options)) {
+        usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    for (int i = optind; i < argc; i++) {
+        if (microFind(argv[i]) == NULL) {
+            fprintf(stderr, "unknown benchmark '%s'\n", argv[i]);
+            usage(argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // must be in place before the first parcMemory allocation
+    parcMemory_SetInterface(&microCountingMemory);
+    parcSecurity_Init();
+
+    unlink(options.keystorePath);
+    bool success = parcPkcs12KeyStore_CreateFile(options.keystorePath, keystorePassword, "rta_microbench", 1024, 30);
+    assertTrue(success, "parcPkcs12KeyStore_CreateFile(%s) failed", options.keystorePath);
+
+    printf("%-12s %10s %12s %12s\n", "benchmark", "messages", "ns/msg", "allocs/msg");
+
+    if (optind == argc) {
+        for (int i = 0; microBenchmarks[i].name != NULL; i++) {
+            microRun(&microBenchmarks[i], &options);
+        }
+    } else {
+        for (int i = optind; i < argc; i++) {
+            microRun(microFind(argv[i]), &options);
+        }
+    }
+
+    unlink(options.keystorePath);
+    parcSecurity_Fini();
+    return EXIT_SUCCESS;
+}
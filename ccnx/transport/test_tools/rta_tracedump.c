@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * Print a flight recorder dump as text.
+ *
+ * A dump is written by rtaFramework_DumpTrace(), or by the Transport thread on SIGUSR2
+ * when the environment variable RTA_TRACE_FILE names the output file.  Usage:
+ *
+ *     rta_tracedump file
+ *
+ * Each line is the time in microseconds relative to the first record, the connection id,
+ * the component, the event, and the event value.  Drop events print the drop reason.
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ccnx/transport/transport_rta/core/components.h>
+#include <ccnx/transport/transport_rta/core/rta_ComponentStats.h>
+#include <ccnx/transport/transport_rta/core/rta_TraceRing.h>
+
+static const char *
+componentName(uint16_t component)
+{
+    if (component < LAST_COMPONENT && RtaComponentNames[component] != NULL) {
+        return RtaComponentNames[component];
+    }
+    return "unknown";
+}
+
+static void
+printRecord(const RtaTraceRecord *record, uint64_t start)
+{
+    double relative = (double) (record->timestamp - start) / 1000.0;
+
+    printf("%14.3f %6" PRIu32 " %-12s %-20s ",
+           relative, record->connectionId, componentName(record->component),
+           rtaTraceEvent_ToString((RtaTraceEvent) record->event));
+
+    switch (record->event) {
+        case RtaTraceEvent_Drop:
+            if (record->value < STATS_LAST) {
+                printf("%s\n", rtaComponentStatType_ToString((RtaComponentStatType) record->value));
+            } else {
+                printf("%" PRIu64 "\n", record->value);
+            }
+            break;
+
+        case RtaTraceEvent_Put:
+        case RtaTraceEvent_Get:
+            printf("0x%" PRIx64 "\n", record->value);
+            break;
+
+        default:
+            printf("%" PRIu64 "\n", record->value);
+            break;
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s file\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    FILE *file = fopen(argv[1], "r");
+    if (file == NULL) {
+        perror(argv[1]);
+        exit(EXIT_FAILURE);
+    }
+
+    RtaTraceFileHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1) {
+        fprintf(stderr, "%s: short header\n", argv[1]);
+        exit(EXIT_FAILURE);
+    }
+
+    if (memcmp(header.magic, RTA_TRACE_FILE_MAGIC, sizeof(header.magic)) != 0) {
+        fprintf(stderr, "%s: not a trace file\n", argv[1]);
+        exit(EXIT_FAILURE);
+    }
+
+    if (header.version != RTA_TRACE_FILE_VERSION || header.recordSize != sizeof(RtaTraceRecord)) {
+        fprintf(stderr, "%s: unsupported version %u record size %u\n", argv[1], header.version, header.recordSize);
+        exit(EXIT_FAILURE);
+    }
+
+    uint64_t count = (header.written < header.capacity) ? header.written : header.capacity;
+    printf("# %" PRIu64 " records of %" PRIu64 " written\n", count, header.written);
+    printf("# %12s %6s %-12s %-20s %s\n", "usec", "conn", "component", "event", "value");
+
+    RtaTraceRecord record;
+    uint64_t start = 0;
+    for (uint64_t i = 0; i < count; i++) {
+        if (fread(&record, sizeof(record), 1, file) != 1) {
+            fprintf(stderr, "%s: truncated after %" PRIu64 " records\n", argv[1], i);
+            break;
+        }
+        if (i == 0) {
+            start = record.timestamp;
+        }
+        printRecord(&record, start);
+    }
+
+    fclose(file);
+    return 0;
+}
@@ -0,0 +1,660 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * Parameter sweep of Vegas over a simulated link, in virtual time.
+ *
+ * rta_vegassim runs --connections concurrent Vegas fetches of --segments chunks each over
+ * the FWD_SIMULATED link of one protocol stack, for every combination of the comma
+ * separated --delay, --rate, --loss, --buffer and --connections values.  The stack is
+ *
+ *     API -> TESTING_UPPER -> FC_VEGAS -> TLV codec -> FWD_SIMULATED
+ *
+ * TESTING_UPPER is where the fetches start and where the Content Objects are counted, so
+ * the API socket is not involved.  The framework is non-threaded and in virtual time
+ * (rtaFramework_NonThreadedEnableVirtualTime), so each point takes as long as the host
+ * needs to process its packets, not as long as the transfer, and the same command line
+ * always gives the same result.
+ *
+ * The output is one JSON object per line, one line per point:
+ *
+ *     {"delayUsec":...,"bytesPerSecond":...,"lossPpm":...,"bufferBytes":...,"connections":...,
+ *      "completed":...,"completionUsec":...,"meanCompletionUsec":...,"goodputBps":...,
+ *      "jainFairness":...,"meanCwnd":...,"queueDrops":...,"lost":...,"wallNanos":...}
+ *
+ * completionUsec is the virtual time until the last fetch finished, goodputBps is the
+ * payload bits of all finished fetches over that time, and jainFairness is Jain's index of
+ * the per-connection goodput.  meanCwnd is the congestion window averaged over the ticks
+ * and connections that were still fetching.  queueDrops and lost add up both directions
+ * of the link.
+ *
+ * Example:
+ *
+ *     rta_vegassim -d 5000,20000,80000 -r 1250000 -l 0,1000,10000 -c 1,4 -s 2000
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+#include <config.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <sys/socket.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/concurrent/parc_Notifier.h>
+#include <ccnx/transport/transport_rta/commands/rta_CommandQueue.h>
+#include <parc/security/parc_Pkcs12KeyStore.h>
+#include <parc/security/parc_Security.h>
+
+#include <ccnx/common/ccnx_Interest.h>
+
+#include <ccnx/transport/common/transport_Message.h>
+#include <ccnx/transport/common/transport_MetaMessage.h>
+#include <ccnx/transport/transport_rta/commands/rta_Command.h>
+#include <ccnx/transport/transport_rta/components/component_Flowcontrol.h>
+#include <ccnx/transport/transport_rta/config/config_All.h>
+#include <ccnx/transport/transport_rta/connectors/connector_Forwarder.h>
+#include <ccnx/transport/transport_rta/core/rta_Component.h>
+#include <ccnx/transport/transport_rta/core/rta_Framework.h>
+#include <ccnx/transport/transport_rta/core/rta_Framework_NonThreaded.h>
+#include <ccnx/transport/transport_rta/core/rta_Framework_private.h>
+#include <ccnx/transport/transport_rta/core/rta_ProtocolStack.h>
+
+#define VEGASSIM_MAX_VALUES 64
+
+static const char keystorePassword[] = "rta_vegassim";
+
+typedef struct vegassim_list {
+    uint64_t values[VEGASSIM_MAX_VALUES];
+    unsigned count;
+} VegasSimList;
+
+typedef struct vegassim_options {
+    VegasSimList delayUsec;
+    VegasSimList bytesPerSecond;
+    VegasSimList lossPpm;
+    VegasSimList bufferBytes;
+    VegasSimList connections;
+
+    unsigned segments;          // chunks fetched by each connection
+    unsigned payloadSize;
+    uint32_t seed;
+    uint64_t maxUsec;           // virtual time after which a point gives up
+    const char *keystorePath;
+} VegasSimOptions;
+
+typedef struct vegassim_point {
+    SimulatedForwarderParams params;
+    unsigned connections;
+} VegasSimPoint;
+
+typedef struct vegassim_fetch {
+    RtaConnection *connection;
+    int fds[2];
+    unsigned received;
+    bool completed;
+    ticks completedAt;
+} VegasSimFetch;
+
+typedef struct vegassim_sim {
+    RtaCommandQueue *commandQueue;
+    PARCNotifier *commandNotifier;
+    RtaFramework *framework;
+
+    int stackId;
+    RtaProtocolStack *stack;
+
+    unsigned fetchCount;
+    VegasSimFetch *fetches;
+} VegasSim;
+
+static uint64_t
+vegasSimNanos(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;
+}
+
+static void
+vegasSimSetNonBlocking(int fd)
+{
+    int flags = fcntl(fd, F_GETFL, 0);
+    int failure = fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    assertFalse(failure, "fcntl(O_NONBLOCK) failed: (%d) %s", errno, strerror(errno));
+}
+
+// =====================================================================
+// Non-threaded framework in virtual time, set up through the same command ring buffer
+// rtaTransport uses
+
+static void
+vegasSim_Execute(VegasSim *sim, RtaCommand *command)
+{
+    bool success = rtaCommand_Write(command, sim->commandQueue, CCNxStackTimeout_Immediate);
+    assertTrue(success, "Command ring buffer is full");
+    rtaCommand_Release(&command);
+
+    parcNotifier_Notify(sim->commandNotifier);
+    rtaFramework_NonThreadedAdvance(sim->framework, 0);
+}
+
+static CCNxTransportConfig *
+vegasSimCreateConfig(const VegasSimOptions *options, const SimulatedForwarderParams *params)
+{
+    CCNxStackConfig *stackConfig = ccnxStackConfig_Create();
+    apiConnector_ProtocolStackConfig(stackConfig);
+    testingUpper_ProtocolStackConfig(stackConfig);
+    vegasFlowController_ProtocolStackConfig(stackConfig);
+    tlvCodec_ProtocolStackConfig(stackConfig);
+    simulatedForwarder_ProtocolStackConfig(stackConfig, params);
+    protocolStack_ComponentsConfigArgs(stackConfig,
+                                       apiConnector_GetName(),
+                                       testingUpper_GetName(),
+                                       vegasFlowController_GetName(),
+                                       tlvCodec_GetName(),
+                                       simulatedForwarder_GetName(),
+                                       NULL);
+
+    CCNxConnectionConfig *connConfig = ccnxConnectionConfig_Create();
+    apiConnector_ConnectionConfig(connConfig);
+    testingUpper_ConnectionConfig(connConfig);
+    vegasFlowController_ConnectionConfig(connConfig);
+    tlvCodec_ConnectionConfig(connConfig);
+    simulatedForwarder_ConnectionConfig(connConfig);
+    publicKeySigner_ConnectionConfig(connConfig, options->keystorePath, keystorePassword);
+
+    CCNxTransportConfig *config = ccnxTransportConfig_Create(stackConfig, connConfig);
+    ccnxStackConfig_Release(&stackConfig);
+    return config;
+}
+
+static VegasSim *
+vegasSim_Create(const VegasSimOptions *options, const VegasSimPoint *point)
+{
+    VegasSim *sim = parcMemory_AllocateAndClear(sizeof(VegasSim));
+    assertNotNull(sim, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(VegasSim));
+
+    sim->commandQueue = rtaCommandQueue_Create(128);
+    sim->commandNotifier = parcNotifier_Create();
+    sim->framework = rtaFramework_Create(sim->commandQueue, sim->commandNotifier);
+    rtaFramework_NonThreadedEnableVirtualTime(sim->framework);
+    sim->stackId = 1;
+
+    CCNxTransportConfig *config = vegasSimCreateConfig(options, &point->params);
+
+    RtaCommandCreateProtocolStack *createStack =
+        rtaCommandCreateProtocolStack_Create(sim->stackId, ccnxTransportConfig_GetStackConfig(config));
+    vegasSim_Execute(sim, rtaCommand_CreateCreateProtocolStack(createStack));
+    rtaCommandCreateProtocolStack_Release(&createStack);
+
+    FrameworkProtocolHolder *holder;
+    TAILQ_FOREACH(holder, &sim->framework->protocols_head, list)
+    {
+        if (holder->stack_id == sim->stackId) {
+            sim->stack = holder->stack;
+        }
+    }
+    assertNotNull(sim->stack, "Framework did not create stack %d", sim->stackId);
+
+    sim->fetchCount = point->connections;
+    sim->fetches = parcMemory_AllocateAndClear(sim->fetchCount * sizeof(VegasSimFetch));
+    assertNotNull(sim->fetches, "parcMemory_AllocateAndClear(%zu) returned NULL", sim->fetchCount * sizeof(VegasSimFetch));
+
+    for (unsigned i = 0; i < sim->fetchCount; i++) {
+        VegasSimFetch *fetch = &sim->fetches[i];
+
+        int failure = socketpair(AF_UNIX, SOCK_STREAM, 0, fetch->fds);
+        assertFalse(failure, "Error creating socket pair: (%d) %s", errno, strerror(errno));
+        vegasSimSetNonBlocking(fetch->fds[0]);
+
+        RtaCommandOpenConnection *openConnection =
+            rtaCommandOpenConnection_Create(sim->stackId, fetch->fds[0], fetch->fds[1],
+                                            ccnxConnectionConfig_GetJson(ccnxTransportConfig_GetConnectionConfig(config)));
+        vegasSim_Execute(sim, rtaCommand_CreateOpenConnection(openConnection));
+        rtaCommandOpenConnection_Release(&openConnection);
+
+        fetch->connection = rtaConnectionTable_GetByApiFd(sim->framework->connectionTable, fetch->fds[0]);
+        assertNotNull(fetch->connection, "Framework did not open a connection on fd %d", fetch->fds[0]);
+    }
+
+    ccnxTransportConfig_Destroy(&config);
+    return sim;
+}
+
+static void
+vegasSim_Destroy(VegasSim **simPtr)
+{
+    VegasSim *sim = *simPtr;
+
+    rtaFramework_Teardown(sim->framework);
+    rtaFramework_Destroy(&sim->framework);
+
+    rtaCommandQueue_Release(&sim->commandQueue);
+    parcNotifier_Release(&sim->commandNotifier);
+
+    for (unsigned i = 0; i < sim->fetchCount; i++) {
+        close(sim->fetches[i].fds[0]);
+        close(sim->fetches[i].fds[1]);
+    }
+    parcMemory_Deallocate((void **) &sim->fetches);
+
+    parcMemory_Deallocate((void **) &sim);
+    *simPtr = NULL;
+}
+
+static VegasSimFetch *
+vegasSim_FindFetch(VegasSim *sim, RtaConnection *connection)
+{
+    for (unsigned i = 0; i < sim->fetchCount; i++) {
+        if (sim->fetches[i].connection == connection) {
+            return &sim->fetches[i];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Throws away the notifications the API connector wrote to the API sockets
+ */
+static void
+vegasSim_DrainApi(VegasSim *sim)
+{
+    for (unsigned i = 0; i < sim->fetchCount; i++) {
+        CCNxMetaMessage *message;
+        while (read(sim->fetches[i].fds[0], &message, sizeof(message)) == sizeof(message)) {
+            ccnxMetaMessage_Release(&message);
+        }
+    }
+}
+
+static void
+vegasSim_Start(VegasSim *sim)
+{
+    PARCEventQueue *upper = rtaProtocolStack_GetPutQueue(sim->stack, TESTING_UPPER, RTA_DOWN);
+
+    for (unsigned i = 0; i < sim->fetchCount; i++) {
+        char uri[64];
+        snprintf(uri, sizeof(uri), "lci:/vegassim/%u", i);
+
+        CCNxName *basename = ccnxName_CreateFromCString(uri);
+        CCNxInterest *interest = ccnxInterest_CreateSimple(basename);
+        TransportMessage *start = transportMessage_CreateFromDictionary(interest);
+        transportMessage_SetInfo(start, rtaConnection_Copy(sim->fetches[i].connection), rtaConnection_FreeFunc);
+        ccnxInterest_Release(&interest);
+        ccnxName_Release(&basename);
+
+        rtaComponent_PutMessage(upper, start);
+    }
+}
+
+/*
+ * Counts the Content Objects that reached TESTING_UPPER.  Returns the number of fetches
+ * that finished.
+ */
+static unsigned
+vegasSim_Collect(VegasSim *sim, unsigned segments)
+{
+    PARCEventQueue *upper = rtaProtocolStack_GetPutQueue(sim->stack, TESTING_UPPER, RTA_DOWN);
+    ticks now = rtaFramework_GetTicks(sim->framework);
+    unsigned finished = 0;
+
+    TransportMessage *tm;
+    while ((tm = rtaComponent_GetMessage(upper)) != NULL) {
+        if (transportMessage_IsContentObject(tm)) {
+            VegasSimFetch *fetch = vegasSim_FindFetch(sim, rtaConnection_GetFromTransport(tm));
+            if (fetch != NULL && !fetch->completed) {
+                fetch->received++;
+                if (fetch->received == segments) {
+                    fetch->completed = true;
+                    fetch->completedAt = now;
+                    finished++;
+                }
+            }
+        }
+        transportMessage_Destroy(&tm);
+    }
+    return finished;
+}
+
+// =====================================================================
+
+static void
+vegasSimRun(const VegasSimOptions *options, const VegasSimPoint *point)
+{
+    uint64_t wallStart = vegasSimNanos();
+
+    VegasSim *sim = vegasSim_Create(options, point);
+    vegasSim_DrainApi(sim);
+
+    ticks start = rtaFramework_GetTicks(sim->framework);
+    ticks maxTicks = options->maxUsec / rtaFramework_TicksToUsec(1);
+
+    vegasSim_Start(sim);
+
+    unsigned completed = 0;
+    uint64_t cwndSum = 0;
+    uint64_t cwndSamples = 0;
+    ticks elapsed = 0;
+    while (completed < sim->fetchCount && elapsed < maxTicks) {
+        rtaFramework_NonThreadedAdvance(sim->framework, 1);
+        elapsed = rtaFramework_GetTicks(sim->framework) - start;
+        completed += vegasSim_Collect(sim, options->segments);
+
+        for (unsigned i = 0; i < sim->fetchCount; i++) {
+            FlowControlWindowStats window;
+            if (!sim->fetches[i].completed &&
+                component_Flowcontrol_GetWindowStats(sim->fetches[i].connection, FC_VEGAS, &window) &&
+                window.sessions > 0) {
+                cwndSum += window.cwnd;
+                cwndSamples++;
+            }
+        }
+        vegasSim_DrainApi(sim);
+    }
+
+    double fetchBits = 8.0 * options->segments * point->params.payloadSize;
+    double sum = 0;
+    double sumSquares = 0;
+    uint64_t completionUsec = 0;
+    uint64_t completionSum = 0;
+    for (unsigned i = 0; i < sim->fetchCount; i++) {
+        VegasSimFetch *fetch = &sim->fetches[i];
+        if (fetch->completed) {
+            uint64_t usec = rtaFramework_TicksToUsec(fetch->completedAt - start);
+            double goodput = usec > 0 ? fetchBits * 1E6 / usec : 0;
+            sum += goodput;
+            sumSquares += goodput * goodput;
+            completionSum += usec;
+            if (usec > completionUsec) {
+                completionUsec = usec;
+            }
+        }
+    }
+
+    SimulatedForwarderStats link;
+    connector_Fwd_Simulated_GetStats(sim->stack, &link);
+
+    printf("{\"delayUsec\":%" PRIu64 ",\"bytesPerSecond\":%" PRIu64 ",\"lossPpm\":%u,\"bufferBytes\":%" PRIu64
+           ",\"connections\":%u,\"completed\":%u,\"completionUsec\":%" PRIu64 ",\"meanCompletionUsec\":%" PRIu64
+           ",\"goodputBps\":%.0f,\"jainFairness\":%.4f,\"meanCwnd\":%.2f,\"queueDrops\":%" PRIu64 ",\"lost\":%" PRIu64
+           ",\"wallNanos\":%" PRIu64 "}\n",
+           point->params.delayUsec,
+           point->params.bytesPerSecond,
+           point->params.lossPpm,
+           point->params.bufferBytes,
+           point->connections,
+           completed,
+           completionUsec,
+           completed > 0 ? completionSum / completed : 0,
+           completionUsec > 0 ? fetchBits * completed * 1E6 / completionUsec : 0.0,
+           sumSquares > 0 ? (sum * sum) / (completed * sumSquares) : 0.0,
+           cwndSamples > 0 ? (double) cwndSum / cwndSamples : 0.0,
+           link.down.queueDrops + link.up.queueDrops,
+           link.down.lost + link.up.lost,
+           vegasSimNanos() - wallStart);
+    fflush(stdout);
+
+    vegasSim_Destroy(&sim);
+}
+
+static void
+usage(const char *program)
+{
+    printf("usage: %s [-d delays] [-r rates] [-l losses] [-b buffers] [-c connections] [-s segments]\n", program);
+    printf("          [-p payload] [-S seed] [-t seconds] [-k keystore]\n");
+    printf("\n");
+    printf("   -d, --delay        One-way delays in usec (default 10000)\n");
+    printf("   -r, --rate         Link rates in bytes per second (default 1250000)\n");
+    printf("   -l, --loss         Loss rates in packets per million (default 0)\n");
+    printf("   -b, --buffer       Link buffers in bytes (default 65536)\n");
+    printf("   -c, --connections  Concurrent fetches sharing the link (default 1)\n");
+    printf("   -s, --segments     Chunks fetched by each connection (default 1000)\n");
+    printf("   -p, --payload      Payload bytes of each chunk (default 1024)\n");
+    printf("   -S, --seed         Seed of the loss decisions (default 1)\n");
+    printf("   -t, --time         Virtual seconds after which a point gives up (default 600)\n");
+    printf("   -k, --keystore     Temporary keystore (default /tmp/rta_vegassim.p12)\n");
+    printf("\n");
+    printf("Options -d, -r, -l, -b and -c take comma separated lists, every combination is run.\n");
+}
+
+static bool
+parseList(const char *string, VegasSimList *list)
+{
+    list->count = 0;
+    const char *p = string;
+    while (*p != '\0') {
+        if (list->count == VEGASSIM_MAX_VALUES) {
+            fprintf(stderr, "At most %d values per list\n", VEGASSIM_MAX_VALUES);
+            return false;
+        }
+
+        char *end;
+        errno = 0;
+        unsigned long long value = strtoull(p, &end, 10);
+        if (end == p || errno != 0 || (*end != ',' && *end != '\0')) {
+            fprintf(stderr, "Invalid list '%s'\n", string);
+            return false;
+        }
+        list->values[list->count++] = value;
+        p = (*end == ',') ? end + 1 : end;
+    }
+    return list->count > 0;
+}
+
+static bool
+parseCommandLine(int argc, char *argv[], VegasSimOptions *options)
+{
+    static struct option longopts[] = {
+        { "delay",       required_argument, NULL, 'd' },
+        { "rate",        required_argument, NULL, 'r' },
+        { "loss",        required_argument, NULL, 'l' },
+        { "buffer",      required_argument, NULL, 'b' },
+        { "connections", required_argument, NULL, 'c' },
+        { "segments",    required_argument, NULL, 's' },
+        { "payload",     required_argument, NULL, 'p' },
+        { "seed",        required_argument, NULL, 'S' },
+        { "time",        required_argument, NULL, 't' },
+        { "keystore",    required_argument, NULL, 'k' },
+        { "help",        no_argument,       NULL, 'h' },
+        { NULL,          0,                 NULL, 0   }
+    };
+
+    memset(options, 0, sizeof(VegasSimOptions));
+    parseList("10000", &options->delayUsec);
+    parseList("1250000", &options->bytesPerSecond);
+    parseList("0", &options->lossPpm);
+    parseList("65536", &options->bufferBytes);
+    parseList("1", &options->connections);
+    options->segments = 1000;
+    options->payloadSize = 1024;
+    options->seed = 1;
+    options->maxUsec = 600000000ULL;
+    options->keystorePath = "/tmp/rta_vegassim.p12";
+
+    int c;
+    while ((c = getopt_long(argc, argv, "d:r:l:b:c:s:p:S:t:k:h", longopts, NULL)) != -1) {
+        switch (c) {
+            case 'd':
+                if (!parseList(optarg, &options->delayUsec)) {
+                    return false;
+                }
+                break;
+
+            case 'r':
+                if (!parseList(optarg, &options->bytesPerSecond)) {
+                    return false;
+                }
+                break;
+
+            case 'l':
+                if (!parseList(optarg, &options->lossPpm)) {
+                    return false;
+                }
+                break;
+
+            case 'b':
+                if (!parseList(optarg, &options->bufferBytes)) {
+                    return false;
+                }
+                break;
+
+            case 'c':
+                if (!parseList(optarg, &options->connections)) {
+                    return false;
+                }
+                break;
+
+            case 's':
+                options->segments = (unsigned) strtoul(optarg, NULL, 10);
+                break;
+
+            case 'p':
+                options->payloadSize = (unsigned) strtoul(optarg, NULL, 10);
+                break;
+
+            case 'S':
+                options->seed = (uint32_t) strtoul(optarg, NULL, 10);
+                break;
+
+            case 't':
+                options->maxUsec = strtoull(optarg, NULL, 10) * 1000000ULL;
+                break;
+
+            case 'k':
+                options->keystorePath = optarg;
+                break;
+
+            case 'h':
+            default:
+                return false;
+        }
+    }
+
+    if (options->segments == 0 || options->maxUsec == 0) {
+        fprintf(stderr, "segments and time must be positive\n");
+        return false;
+    }
+
+    for (unsigned i = 0; i < options->lossPpm.count; i++) {
+        if (options->lossPpm.values[i] > 1000000) {
+            fprintf(stderr, "loss must be at most 1000000 ppm\n");
+            return false;
+        }
+    }
+
+    for (unsigned i = 0; i < options->connections.count; i++) {
+        if (options->connections.values[i] == 0 || options->connections.values[i] > 1024) {
+            fprintf(stderr, "connections must be between 1 and 1024\n");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int
+main(int argc, char *argv[])
+{
+    VegasSimOptions options;
+    if (!parseCommandLine(argc, argv, &options)) {
+        usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    parcSecurity_Init();
+
+    unlink(options.keystorePath);
+    bool success = parcPkcs12KeyStore_CreateFile(options.keystorePath, keystorePassword, "rta_vegassim", 1024, 30);
+    assertTrue(success, "parcPkcs12KeyStore_CreateFile(%s) failed", options.keystorePath);
+
+    for (unsigned d = 0; d < options.delayUsec.count; d++) {
+        for (unsigned r = 0; r < options.bytesPerSecond.count; r++) {
+            for (unsigned l = 0; l < options.lossPpm.count; l++) {
+                for (unsigned b = 0; b < options.bufferBytes.count; b++) {
+                    for (unsigned c = 0; c < options.connections.count; c++) {
+                        VegasSimPoint point;
+                        simulatedForwarder_DefaultParams(&point.params);
+                        point.params.delayUsec = options.delayUsec.values[d];
+                        point.params.bytesPerSecond = options.bytesPerSecond.values[r];
+                        point.params.lossPpm = (uint32_t) options.lossPpm.values[l];
+                        point.params.bufferBytes = options.bufferBytes.values[b];
+                        point.params.payloadSize = options.payloadSize;
+                        point.params.finalChunk = options.segments - 1;
+                        point.params.seed = options.seed;
+                        point.connections = (unsigned) options.connections.values[c];
+
+                        vegasSimRun(&options, &point);
+                    }
+                }
+            }
+        }
+    }
+
+    unlink(options.keystorePath);
+    parcSecurity_Fini();
+    return EXIT_SUCCESS;
+}
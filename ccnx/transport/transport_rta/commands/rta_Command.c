@@ -64,6 +64,9 @@
 #include <LongBow/runtime.h>
 
 #include <stdio.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/time.h>
 
 #include <parc/algol/parc_Memory.h>
 #include <parc/algol/parc_Object.h>
@@ -82,6 +85,8 @@ typedef enum {
     RtaCommandType_DestroyProtocolStack,
     RtaCommandType_ShutdownFramework,
     RtaCommandType_TransmitStatistics,
+    RtaCommandType_SnapshotStatistics,
+    RtaCommandType_OpenManyConnections,
     RtaCommandType_Last
 } _RtaCommandType;
 
@@ -94,11 +99,19 @@ struct rta_command {
         RtaCommandCreateProtocolStack *createStack;
         RtaCommandDestroyProtocolStack *destroyStack;
         RtaCommandTransmitStatistics *transmitStats;
+        RtaCommandSnapshotStatistics *snapshotStats;
+        RtaCommandOpenManyConnections *openMany;
 
         // shutdown framework has no value it will be NULL
         // Statistics has no value
         void *noValue;
     } value;
+
+    // Set by the Framework after it executes the command, see rtaCommand_SetComplete()
+    pthread_mutex_t lock;
+    pthread_cond_t complete_cv;
+    bool complete;
+    int error;
 };
 
 static struct commandtype_to_string {
@@ -112,6 +125,8 @@ static struct commandtype_to_string {
     { .type = RtaCommandType_DestroyProtocolStack, .string = "DestroyProtocolStack" },
     { .type = RtaCommandType_ShutdownFramework,    .string = "ShutdownFramework"    },
     { .type = RtaCommandType_TransmitStatistics,   .string = "TransmitStatistics"   },
+    { .type = RtaCommandType_SnapshotStatistics,   .string = "SnapshotStatistics"   },
+    { .type = RtaCommandType_OpenManyConnections,  .string = "OpenManyConnections"  },
     { .type = RtaCommandType_Last,                 .string = NULL                   },
 };
 
@@ -122,6 +137,9 @@ static void
 _rtaCommand_Destroy(RtaCommand **commandPtr)
 {
     RtaCommand *command = *commandPtr;
+    pthread_cond_destroy(&command->complete_cv);
+    pthread_mutex_destroy(&command->lock);
+
     switch (command->type) {
         case RtaCommandType_ShutdownFramework:
             // no inner-release needed
@@ -147,6 +165,14 @@ _rtaCommand_Destroy(RtaCommand **commandPtr)
             rtaCommandTransmitStatistics_Release(&command->value.transmitStats);
             break;
 
+        case RtaCommandType_SnapshotStatistics:
+            rtaCommandSnapshotStatistics_Release(&command->value.snapshotStats);
+            break;
+
+        case RtaCommandType_OpenManyConnections:
+            rtaCommandOpenManyConnections_Release(&command->value.openMany);
+            break;
+
         default:
             trapIllegalValue(command->type, "Illegal command type %d", command->type);
             break;
@@ -194,6 +220,14 @@ _rtaCommand_AssertValid(const RtaCommand *command)
             assertNotNull(command->value.transmitStats, "RtaCommand transmitStats member must be non-null");
             break;
 
+        case RtaCommandType_SnapshotStatistics:
+            assertNotNull(command->value.snapshotStats, "RtaCommand snapshotStats member must be non-null");
+            break;
+
+        case RtaCommandType_OpenManyConnections:
+            assertNotNull(command->value.openMany, "RtaCommand openMany member must be non-null");
+            break;
+
         default:
             trapIllegalValue(command->type, "Illegal command type %d", command->type);
             break;
@@ -211,6 +245,10 @@ _rtaCommand_Allocate(_RtaCommandType type)
 {
     RtaCommand *command = parcObject_CreateInstance(RtaCommand);
     command->type = type;
+    pthread_mutex_init(&command->lock, NULL);
+    pthread_cond_init(&command->complete_cv, NULL);
+    command->complete = false;
+    command->error = 0;
     return command;
 }
 
@@ -238,35 +276,74 @@ rtaCommand_Display(const RtaCommand *command, int indentation)
 }
 
 /*
- * Gets a reference to itself and puts it in the ring buffer
+ * Gets a reference to itself and puts it on the queue
  */
 bool
-rtaCommand_Write(const RtaCommand *command, PARCRingBuffer1x1 *commandRingBuffer)
+rtaCommand_Write(const RtaCommand *command, RtaCommandQueue *commandQueue, const uint64_t *microSeconds)
 {
     _rtaCommand_OptionalAssertValid(command);
 
     RtaCommand *reference = rtaCommand_Acquire(command);
 
-    bool addedToRingBuffer = parcRingBuffer1x1_Put(commandRingBuffer, reference);
+    bool addedToQueue = rtaCommandQueue_Put(commandQueue, reference, microSeconds);
 
-    if (!addedToRingBuffer) {
-        // it was not stored in the ring, so we need to be responsible and release it
+    if (!addedToQueue) {
+        // it was not stored in the queue, so we need to be responsible and release it
         rtaCommand_Release(&reference);
     }
 
-    return addedToRingBuffer;
+    return addedToQueue;
 }
 
 RtaCommand *
-rtaCommand_Read(PARCRingBuffer1x1 *commandRingBuffer)
+rtaCommand_Read(RtaCommandQueue *commandQueue)
+{
+    return rtaCommandQueue_Get(commandQueue);
+}
+
+void
+rtaCommand_SetComplete(RtaCommand *command, int error)
 {
-    RtaCommand *referenceFromRing = NULL;
+    _rtaCommand_OptionalAssertValid(command);
+
+    pthread_mutex_lock(&command->lock);
+    assertFalse(command->complete, "Command %s was already completed", _rtaCommand_TypeToString(command));
+    command->error = error;
+    command->complete = true;
+    pthread_cond_broadcast(&command->complete_cv);
+    pthread_mutex_unlock(&command->lock);
+}
+
+bool
+rtaCommand_WaitComplete(RtaCommand *command, const uint64_t *microSeconds, int *error)
+{
+    _rtaCommand_OptionalAssertValid(command);
 
-    bool fetchedReference = parcRingBuffer1x1_Get(commandRingBuffer, (void **) &referenceFromRing);
-    if (fetchedReference) {
-        return referenceFromRing;
+    struct timespec deadline;
+    if (microSeconds != NULL) {
+        struct timeval now;
+        gettimeofday(&now, NULL);
+        uint64_t usec = (uint64_t) now.tv_usec + *microSeconds;
+        deadline.tv_sec = now.tv_sec + (time_t) (usec / 1000000);
+        deadline.tv_nsec = (long) (usec % 1000000) * 1000;
     }
-    return NULL;
+
+    pthread_mutex_lock(&command->lock);
+    while (!command->complete) {
+        if (microSeconds == NULL) {
+            pthread_cond_wait(&command->complete_cv, &command->lock);
+        } else if (pthread_cond_timedwait(&command->complete_cv, &command->lock, &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+
+    bool complete = command->complete;
+    if (complete && error != NULL) {
+        *error = command->error;
+    }
+    pthread_mutex_unlock(&command->lock);
+
+    return complete;
 }
 
 // ======================
@@ -404,3 +481,50 @@ rtaCommand_GetTransmitStatistics(const RtaCommand *command)
     assertTrue(rtaCommand_IsTransmitStatistics(command), "Command is not TransmitStatistics");
     return command->value.transmitStats;
 }
+
+bool
+rtaCommand_IsSnapshotStatistics(const RtaCommand *command)
+{
+    _rtaCommand_OptionalAssertValid(command);
+    return (command->type == RtaCommandType_SnapshotStatistics);
+}
+
+RtaCommand *
+rtaCommand_CreateSnapshotStatistics(const RtaCommandSnapshotStatistics *snapshotStats)
+{
+    RtaCommand *command = _rtaCommand_Allocate(RtaCommandType_SnapshotStatistics);
+    command->value.snapshotStats = rtaCommandSnapshotStatistics_Acquire(snapshotStats);
+    return command;
+}
+
+RtaCommandSnapshotStatistics *
+rtaCommand_GetSnapshotStatistics(const RtaCommand *command)
+{
+    assertTrue(rtaCommand_IsSnapshotStatistics(command), "Command is not SnapshotStatistics");
+    return command->value.snapshotStats;
+}
+
+// ======================
+// OPEN MANY CONNECTIONS
+
+bool
+rtaCommand_IsOpenManyConnections(const RtaCommand *command)
+{
+    _rtaCommand_OptionalAssertValid(command);
+    return (command->type == RtaCommandType_OpenManyConnections);
+}
+
+RtaCommand *
+rtaCommand_CreateOpenManyConnections(const RtaCommandOpenManyConnections *openMany)
+{
+    RtaCommand *command = _rtaCommand_Allocate(RtaCommandType_OpenManyConnections);
+    command->value.openMany = rtaCommandOpenManyConnections_Acquire(openMany);
+    return command;
+}
+
+const RtaCommandOpenManyConnections *
+rtaCommand_GetOpenManyConnections(const RtaCommand *command)
+{
+    assertTrue(rtaCommand_IsOpenManyConnections(command), "Command is not OpenManyConnections");
+    return command->value.openMany;
+}
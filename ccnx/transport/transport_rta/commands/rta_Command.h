@@ -57,7 +57,10 @@
  * @brief Wraps individual commands and is written to/from a Ring Buffer
  *
  * The RtaCommand is the common wrapper for all the specific command types.  It also supports functions to
- * write it to a PARCRingBuffer and read from a one.
+ * write it to an RtaCommandQueue and read from one.
+ *
+ * The Framework marks each command complete after executing it, with an errno value for the
+ * result, so the thread that sent it can wait in rtaCommand_WaitComplete().
  *
  * The ShutdownFramework command is a little different than all the other commands.  There are no parameters
  * to this command, so there is no separate type for it.  You can create an RtaCommand of this flavor and
@@ -77,34 +80,37 @@ typedef struct rta_command RtaCommand;
 #include <ccnx/transport/transport_rta/commands/rta_CommandDestroyProtocolStack.h>
 #include <ccnx/transport/transport_rta/commands/rta_CommandOpenConnection.h>
 #include <ccnx/transport/transport_rta/commands/rta_CommandTransmitStatistics.h>
+#include <ccnx/transport/transport_rta/commands/rta_CommandSnapshotStatistics.h>
+#include <ccnx/transport/transport_rta/commands/rta_CommandOpenManyConnections.h>
 
-#include <parc/concurrent/parc_RingBuffer_1x1.h>
+#include <ccnx/transport/transport_rta/commands/rta_CommandQueue.h>
 
 
 /**
- * Writes a command to a Ring Buffer
+ * Writes a command to a command queue
  *
- * Creates a reference to the command and puts the reference on the ring buffer.
+ * Creates a reference to the command and puts the reference on the queue.
  * The caller still owns their own reference to the command.
  *
  * This command does not involve a PARCNotifier.  If using a notifier in conjunction
- * with the ring buffer, the caller is reponsible for posting the notification after
+ * with the queue, the caller is reponsible for posting the notification after
  * all ther writes are done.
  *
- * The function will not block.  If the ring buffer is full, it will return false.
+ * If the queue is full, waits up to `microSeconds` for room.
  *
- * @param [in] command The command to put (by reference) on the ring buffer.
- * @param [in] commandRingBuffer The ring buffer to use
+ * @param [in] command The command to put (by reference) on the queue.
+ * @param [in] commandQueue The queue to use
+ * @param [in] microSeconds The longest wait for room, NULL to wait as long as it takes, or 0 to not wait
  *
- * @return true A reference was put on the ring buffer
- * @return false Failed to put reference, likely because the ring buffer was full.
+ * @return true A reference was put on the queue
+ * @return false The queue was full until the timeout, errno is EWOULDBLOCK
  *
  * Example:
  * @code
  * {
  *    RtaCommand *command = rtaCommand_CreateShutdownFramework();
  *
- *    bool success = rtaCommand_Write(command, ring);
+ *    bool success = rtaCommand_Write(command, queue, CCNxStackTimeout_Immediate);
  *    if (!success) {
  *       // return error to user that we're backlogged
  *    }
@@ -113,14 +119,14 @@ typedef struct rta_command RtaCommand;
  * }
  * @endcode
  */
-bool rtaCommand_Write(const RtaCommand *command, PARCRingBuffer1x1 *commandRingBuffer);
+bool rtaCommand_Write(const RtaCommand *command, RtaCommandQueue *commandQueue, const uint64_t *microSeconds);
 
 /**
- * Reads a command from a ring buffer
+ * Reads a command from a command queue
  *
- * If the buffer is empty, will return NULL.
+ * If the queue is empty, will return NULL.  Only the Framework's thread may read.
  *
- * @param [in] commandRingBuffer The buffer to read
+ * @param [in] commandQueue The queue to read
  *
  * @return non-null A valid command object
  * @return null Could not read a whole command object
@@ -128,25 +134,64 @@ bool rtaCommand_Write(const RtaCommand *command, PARCRingBuffer1x1 *commandRingB
  * Example:
  * @code
  * {
- *    PARCRingBuffer1x1 *ring = parcRingBuffer1x1_Create(4, NULL);
+ *    RtaCommandQueue *queue = rtaCommandQueue_Create(4);
  *    RtaCommand *command = rtaCommand_CreateShutdownFramework();
  *
- *    bool success = rtaCommand_Write(command, ring);
- *    assertTrue(success, "Failed to put command in to ring buffer");
+ *    bool success = rtaCommand_Write(command, queue, CCNxStackTimeout_Immediate);
+ *    assertTrue(success, "Failed to put command in to the queue");
  *
  *    // We should now have two references
  *    assertTrue(parcObject_GetReferenceCount(command) == 2, "Wrong refernce count, got %zu expected %zu", parcObject_GetReferenceCount(command), 2);
  *
- *    RtaCommand *test = rtaCommand_Read(ring);
+ *    RtaCommand *test = rtaCommand_Read(queue);
  *    assertTrue(test == command, "Wrong pointers, got %p expected %p", (void *) test, (void *) command);
  *
  *    rtaCommand_Release(&command);
  *    rtaCommand_Release(&test);
- *    parcRingBuffer1x1_Release(&ring);
+ *    rtaCommandQueue_Release(&queue);
+ * }
+ * @endcode
+ */
+RtaCommand *rtaCommand_Read(RtaCommandQueue *commandQueue);
+
+/**
+ * Marks a command as executed.  Called by the Framework.
+ *
+ * Wakes every thread in rtaCommand_WaitComplete() for this command.  A command is
+ * completed at most once.
+ *
+ * @param [in] command The command the Framework executed
+ * @param [in] error 0 if the command succeeded, otherwise an errno value
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaCommand_SetComplete(RtaCommand *command, int error);
+
+/**
+ * Waits for the Framework to execute a command
+ *
+ * @param [in] command A command written with rtaCommand_Write()
+ * @param [in] microSeconds The longest wait, or NULL to wait as long as it takes
+ * @param [out] error If not NULL and the command completed, its result: 0 or an errno value
+ *
+ * @return true The command completed
+ * @return false The timeout expired first
+ *
+ * Example:
+ * @code
+ * {
+ *     if (rtaCommand_Write(command, queue, CCNxStackTimeout_Never)) {
+ *         parcNotifier_Notify(notifier);
+ *         int error;
+ *         rtaCommand_WaitComplete(command, CCNxStackTimeout_Never, &error);
+ *     }
  * }
  * @endcode
  */
-RtaCommand *rtaCommand_Read(PARCRingBuffer1x1 *commandRingBuffer);
+bool rtaCommand_WaitComplete(RtaCommand *command, const uint64_t *microSeconds, int *error);
 
 /**
  * Increase the number of references to a `RtaCommand`.
@@ -657,4 +702,157 @@ RtaCommand *rtaCommand_CreateTransmitStatistics(const RtaCommandTransmitStatisti
  * @endcode
  */
 const RtaCommandTransmitStatistics *rtaCommand_GetTransmitStatistics(const RtaCommand *command);
+
+// SNAPSHOT STATS
+
+/**
+ * Tests if the RtaCommand is of type SnapshotStatistics
+ *
+ * Tests if the RtaCommand is of type SnapshotStatistics.  This will also assert the
+ * RtaCommand invariants, so the RtaCommand object must be a properly constructed object.
+ *
+ * @param [in] command An allocated RtaCommand ojbect
+ *
+ * @return true The object is of type SnapshotStatistics
+ * @return false The object is of some other type
+ *
+ * Example:
+ * @code
+ * {
+ *    RtaCommandSnapshotStatistics *snapshotStats = rtaCommandSnapshotStatistics_Create();
+ *    RtaCommand *command = rtaCommand_CreateSnapshotStatistics(snapshotStats);
+ *    assertTrue(rtaCommand_IsSnapshotStatistics(command), "Command is not SnapshotStatistics");
+ *    rtaCommand_Release(&command);
+ *    rtaCommandSnapshotStatistics_Release(&snapshotStats);
+ * }
+ * @endcode
+ */
+bool rtaCommand_IsSnapshotStatistics(const RtaCommand *command);
+
+/**
+ * Allocates and creates an RtaCommand object from a RtaCommandSnapshotStatistics
+ *
+ * Allocates and creates an RtaCommand object from a RtaCommandSnapshotStatistics
+ * by acquiring a reference to it and storing it in the RtaCommand.  The caller
+ * keeps its reference to `snapshotStats` to wait for the answer.
+ *
+ * @param [in] snapshotStats The specific command to make acquire a reference from.
+ *
+ * @return non-null A properly allocated and configured RtaCommand.
+ * @return null An error.
+ *
+ * Example:
+ * @code
+ * {
+ *    RtaCommandSnapshotStatistics *snapshotStats = rtaCommandSnapshotStatistics_Create();
+ *    RtaCommand *command = rtaCommand_CreateSnapshotStatistics(snapshotStats);
+ *
+ *    // release order does not matter
+ *    rtaCommand_Release(&command);
+ *    rtaCommandSnapshotStatistics_Release(&snapshotStats);
+ * }
+ * @endcode
+ */
+RtaCommand *rtaCommand_CreateSnapshotStatistics(const RtaCommandSnapshotStatistics *snapshotStats);
+
+/**
+ * Returns the internal RtaCommandSnapshotStatistics object
+ *
+ * Returns the internal RtaCommandSnapshotStatistics object, the user should not release it.
+ * It is not const because the Transport answers the request through it.
+ * The the RtaCommand is not of type SnapshotStatistics, it will assert in its validation.
+ *
+ * @param [in] command The RtaCommand to query for the object.
+ *
+ * @return The RtaCommandSnapshotStatistics object that constructed the RtaCommand.
+ *
+ * Example:
+ * @code
+ *    RtaCommandSnapshotStatistics *snapshotStats = rtaCommandSnapshotStatistics_Create();
+ *    RtaCommand *command = rtaCommand_CreateSnapshotStatistics(snapshotStats);
+ *
+ *    RtaCommandSnapshotStatistics *testValue = rtaCommand_GetSnapshotStatistics(command);
+ *    assertTrue(testValue == snapshotStats, "Wrong pointer returned");
+ *
+ *    rtaCommand_Release(&command);
+ *    rtaCommandSnapshotStatistics_Release(&snapshotStats);
+ * @endcode
+ */
+RtaCommandSnapshotStatistics *rtaCommand_GetSnapshotStatistics(const RtaCommand *command);
+
+// OPEN MANY CONNECTIONS
+
+/**
+ * Tests if the RtaCommand is of type OpenManyConnections
+ *
+ * Tests if the RtaCommand is of type OpenManyConnections.  This will also assert the
+ * RtaCommand invariants, so the RtaCommand object must be a properly constructed object.
+ *
+ * @param [in] command An allocated RtaCommand ojbect
+ *
+ * @return true The object is of type OpenManyConnections
+ * @return false The object is of some other type
+ *
+ * Example:
+ * @code
+ * {
+ *    RtaCommandOpenManyConnections *openMany = rtaCommandOpenManyConnections_Create(10);
+ *    RtaCommand *command = rtaCommand_CreateOpenManyConnections(openMany);
+ *    assertTrue(rtaCommand_IsOpenManyConnections(command), "Command is not OpenManyConnections");
+ *    rtaCommand_Release(&command);
+ *    rtaCommandOpenManyConnections_Release(&openMany);
+ * }
+ * @endcode
+ */
+bool rtaCommand_IsOpenManyConnections(const RtaCommand *command);
+
+/**
+ * Allocates and creates an RtaCommand object from a RtaCommandOpenManyConnections
+ *
+ * Allocates and creates an RtaCommand object from a RtaCommandOpenManyConnections
+ * by acquiring a reference to it and storing it in the RtaCommand.  The caller
+ * may release its reference to `openMany` at any time.
+ *
+ * @param [in] openMany The specific command to make acquire a reference from.
+ *
+ * @return non-null A properly allocated and configured RtaCommand.
+ * @return null An error.
+ *
+ * Example:
+ * @code
+ * {
+ *    RtaCommandOpenManyConnections *openMany = rtaCommandOpenManyConnections_Create(10);
+ *    RtaCommand *command = rtaCommand_CreateOpenManyConnections(openMany);
+ *
+ *    // release order does not matter
+ *    rtaCommand_Release(&command);
+ *    rtaCommandOpenManyConnections_Release(&openMany);
+ * }
+ * @endcode
+ */
+RtaCommand *rtaCommand_CreateOpenManyConnections(const RtaCommandOpenManyConnections *openMany);
+
+/**
+ * Returns the internal RtaCommandOpenManyConnections object
+ *
+ * Returns the internal RtaCommandOpenManyConnections object, the user should not release it.
+ * The the RtaCommand is not of type OpenManyConnections, it will assert in its validation.
+ *
+ * @param [in] command The RtaCommand to query for the object.
+ *
+ * @return The RtaCommandOpenManyConnections object that constructed the RtaCommand.
+ *
+ * Example:
+ * @code
+ *    RtaCommandOpenManyConnections *openMany = rtaCommandOpenManyConnections_Create(10);
+ *    RtaCommand *command = rtaCommand_CreateOpenManyConnections(openMany);
+ *
+ *    const RtaCommandOpenManyConnections *testValue = rtaCommand_GetOpenManyConnections(command);
+ *    assertTrue(testValue == openMany, "Wrong pointer returned");
+ *
+ *    rtaCommand_Release(&command);
+ *    rtaCommandOpenManyConnections_Release(&openMany);
+ * @endcode
+ */
+const RtaCommandOpenManyConnections *rtaCommand_GetOpenManyConnections(const RtaCommand *command);
 #endif // Libccnx_rta_Commands_h
@@ -73,6 +73,9 @@
 struct rta_command_createprotocolstack {
     int stackId;
     CCNxStackConfig *config;
+
+    // NULL unless created by rtaCommandCreateProtocolStack_CreateFromDescriptor()
+    RtaStackDescriptor *descriptor;
 };
 
 static void
@@ -83,6 +86,10 @@ _rtaCommandCreateProtocolStack_Destroy(RtaCommandCreateProtocolStack **openConne
     if (openConnection->config) {
         ccnxStackConfig_Release(&openConnection->config);
     }
+
+    if (openConnection->descriptor) {
+        rtaStackDescriptor_Release(&openConnection->descriptor);
+    }
 }
 
 parcObject_ExtendPARCObject(RtaCommandCreateProtocolStack, _rtaCommandCreateProtocolStack_Destroy,
@@ -98,6 +105,19 @@ rtaCommandCreateProtocolStack_Create(int stackId, CCNxStackConfig *config)
     RtaCommandCreateProtocolStack *createStack = parcObject_CreateInstance(RtaCommandCreateProtocolStack);
     createStack->stackId = stackId;
     createStack->config = ccnxStackConfig_Copy(config);
+    createStack->descriptor = NULL;
+    return createStack;
+}
+
+RtaCommandCreateProtocolStack *
+rtaCommandCreateProtocolStack_CreateFromDescriptor(int stackId, const RtaStackDescriptor *descriptor)
+{
+    assertNotNull(descriptor, "Parameter descriptor must be non-null");
+
+    RtaCommandCreateProtocolStack *createStack = parcObject_CreateInstance(RtaCommandCreateProtocolStack);
+    createStack->stackId = stackId;
+    createStack->config = ccnxStackConfig_Acquire(rtaStackDescriptor_GetStackConfig(descriptor));
+    createStack->descriptor = rtaStackDescriptor_Acquire(descriptor);
     return createStack;
 }
 
@@ -152,3 +172,10 @@ rtaCommandCreateProtocolStack_GetConfig(const RtaCommandCreateProtocolStack *cre
     assertNotNull(createStack, "Parameter createStack must be non-null");
     return ccnxStackConfig_GetJson(createStack->config);
 }
+
+RtaStackDescriptor *
+rtaCommandCreateProtocolStack_GetDescriptor(const RtaCommandCreateProtocolStack *createStack)
+{
+    assertNotNull(createStack, "Parameter createStack must be non-null");
+    return createStack->descriptor;
+}
@@ -70,6 +70,7 @@ typedef struct rta_command_createprotocolstack RtaCommandCreateProtocolStack;
 
 
 #include <ccnx/transport/common/ccnx_StackConfig.h>
+#include <ccnx/transport/transport_rta/core/rta_StackDescriptor.h>
 
 /**
  * Creates a CreateProtocolStack command object
@@ -114,6 +115,33 @@ typedef struct rta_command_createprotocolstack RtaCommandCreateProtocolStack;
  */
 RtaCommandCreateProtocolStack *rtaCommandCreateProtocolStack_Create(int stackId, CCNxStackConfig *config);
 
+/**
+ * Creates a CreateProtocolStack command object from a compiled configuration
+ *
+ * Like rtaCommandCreateProtocolStack_Create(), but the command shares the descriptor and
+ * its configuration instead of copying the configuration, and the framework configures
+ * the stack from the descriptor's component list.
+ *
+ * @param [in] stackId The new (unique) ID for the stack to create
+ * @param [in] descriptor The compiled stack configuration
+ *
+ * @return non-null An allocated object
+ * @return null An error
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaStackDescriptor *descriptor = rtaStackDescriptor_Create(config);
+ *     RtaCommandCreateProtocolStack *createStack = rtaCommandCreateProtocolStack_CreateFromDescriptor(stackId, descriptor);
+ *     rtaStackDescriptor_Release(&descriptor);
+ *
+ *     RtaCommand *command = rtaCommand_CreateCreateProtocolStack(createStack);
+ *     rtaCommandCreateProtocolStack_Release(&createStack);
+ * }
+ * @endcode
+ */
+RtaCommandCreateProtocolStack *rtaCommandCreateProtocolStack_CreateFromDescriptor(int stackId, const RtaStackDescriptor *descriptor);
+
 /**
  * Increase the number of references to a `RtaCommandCreateProtocolStack`.
  *
@@ -245,6 +273,21 @@ CCNxStackConfig *rtaCommandCreateProtocolStack_GetStackConfig(const RtaCommandCr
  */
 PARCJSON *rtaCommandCreateProtocolStack_GetConfig(const RtaCommandCreateProtocolStack *createStack);
 
+/**
+ * Returns the compiled configuration of the create stack command
+ *
+ * @param [in] createStack An allocated RtaCommandCreateProtocolStack
+ *
+ * @return non-null The value passed to rtaCommandCreateProtocolStack_CreateFromDescriptor()
+ * @return null The command was made by rtaCommandCreateProtocolStack_Create()
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+RtaStackDescriptor *rtaCommandCreateProtocolStack_GetDescriptor(const RtaCommandCreateProtocolStack *createStack);
+
 /**
  * Derive an explanation for why a RtaCommandCreateProtocolStack instance is invalid.
  *
@@ -69,12 +69,18 @@
 #include <parc/algol/parc_Object.h>
 
 #include <ccnx/transport/transport_rta/commands/rta_CommandOpenConnection.h>
+#include <ccnx/transport/transport_rta/core/rta_ConnectionCounters.h>
+#include <ccnx/transport/transport_rta/core/rta_InlineQueue.h>
+#include <ccnx/transport/transport_rta/core/rta_SendQueue.h>
 
 struct rta_command_openconnection {
     int stackId;
     int apiNotifierFd;
     int transportNotifierFd;
     PARCJSON *config;
+    RtaConnectionCounters *counters;
+    RtaInlineQueue *inlineQueue;
+    RtaSendQueue *sendQueue;
 };
 
 // ======= Private API
@@ -86,6 +92,15 @@ _rtaCommandOpenConnection_Destroy(RtaCommandOpenConnection **openConnectionPtr)
     if (openConnection->config != NULL) {
         parcJSON_Release(&openConnection->config);
     }
+    if (openConnection->counters != NULL) {
+        rtaConnectionCounters_Release(&openConnection->counters);
+    }
+    if (openConnection->inlineQueue != NULL) {
+        rtaInlineQueue_Release(&openConnection->inlineQueue);
+    }
+    if (openConnection->sendQueue != NULL) {
+        rtaSendQueue_Release(&openConnection->sendQueue);
+    }
 }
 
 parcObject_ExtendPARCObject(RtaCommandOpenConnection, _rtaCommandOpenConnection_Destroy,
@@ -105,6 +120,9 @@ rtaCommandOpenConnection_Create(int stackId, int apiNotifierFd, int transportNot
     openConnection->apiNotifierFd = apiNotifierFd;
     openConnection->transportNotifierFd = transportNotifierFd;
     openConnection->config = parcJSON_Copy(config);
+    openConnection->counters = NULL;
+    openConnection->inlineQueue = NULL;
+    openConnection->sendQueue = NULL;
     return openConnection;
 }
 
@@ -135,3 +153,60 @@ rtaCommandOpenConnection_GetConfig(const RtaCommandOpenConnection *openConnectio
     assertNotNull(openConnection, "Parameter openConnection must be non-null");
     return openConnection->config;
 }
+
+void
+rtaCommandOpenConnection_SetCounters(RtaCommandOpenConnection *openConnection, RtaConnectionCounters *counters)
+{
+    assertNotNull(openConnection, "Parameter openConnection must be non-null");
+    if (openConnection->counters != NULL) {
+        rtaConnectionCounters_Release(&openConnection->counters);
+    }
+    if (counters != NULL) {
+        openConnection->counters = rtaConnectionCounters_Acquire(counters);
+    }
+}
+
+RtaConnectionCounters *
+rtaCommandOpenConnection_GetCounters(const RtaCommandOpenConnection *openConnection)
+{
+    assertNotNull(openConnection, "Parameter openConnection must be non-null");
+    return openConnection->counters;
+}
+
+void
+rtaCommandOpenConnection_SetInlineQueue(RtaCommandOpenConnection *openConnection, RtaInlineQueue *inlineQueue)
+{
+    assertNotNull(openConnection, "Parameter openConnection must be non-null");
+    if (openConnection->inlineQueue != NULL) {
+        rtaInlineQueue_Release(&openConnection->inlineQueue);
+    }
+    if (inlineQueue != NULL) {
+        openConnection->inlineQueue = rtaInlineQueue_Acquire(inlineQueue);
+    }
+}
+
+RtaInlineQueue *
+rtaCommandOpenConnection_GetInlineQueue(const RtaCommandOpenConnection *openConnection)
+{
+    assertNotNull(openConnection, "Parameter openConnection must be non-null");
+    return openConnection->inlineQueue;
+}
+
+void
+rtaCommandOpenConnection_SetSendQueue(RtaCommandOpenConnection *openConnection, RtaSendQueue *sendQueue)
+{
+    assertNotNull(openConnection, "Parameter openConnection must be non-null");
+    if (openConnection->sendQueue != NULL) {
+        rtaSendQueue_Release(&openConnection->sendQueue);
+    }
+    if (sendQueue != NULL) {
+        openConnection->sendQueue = rtaSendQueue_Acquire(sendQueue);
+    }
+}
+
+RtaSendQueue *
+rtaCommandOpenConnection_GetSendQueue(const RtaCommandOpenConnection *openConnection)
+{
+    assertNotNull(openConnection, "Parameter openConnection must be non-null");
+    return openConnection->sendQueue;
+}
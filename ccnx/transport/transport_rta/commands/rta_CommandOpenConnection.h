@@ -66,6 +66,10 @@
 #define Libccnx_rta_CommandOpenConnection_h
 
 
+struct rta_connection_counters;
+struct rta_inline_queue;
+struct rta_send_queue;
+
 struct rta_command_openconnection;
 typedef struct rta_command_openconnection RtaCommandOpenConnection;
 
@@ -257,4 +261,117 @@ int rtaCommandOpenConnection_GetTransportNotifierFd(const RtaCommandOpenConnecti
  * @endcode
  */
 PARCJSON *rtaCommandOpenConnection_GetConfig(const RtaCommandOpenConnection *openConnection);
+
+/**
+ * Attaches the shared counter block the new connection should count into
+ *
+ * The transport creates the counter block when the API opens a connection, so the
+ * application can read the connection's counters (see rtaTransport_GetConnectionStats())
+ * without going through the framework.  The command acquires its own reference.
+ * Passing NULL clears the counters, and the connection allocates its own.
+ *
+ * @param [in] openConnection An allocated RtaCommandOpenConnection
+ * @param [in] counters The counter block, may be NULL
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaConnectionCounters *counters = rtaConnectionCounters_Create();
+ *     RtaCommandOpenConnection *openCommand = rtaCommandOpenConnection_Create(stackId, pair[API_SIDE], pair[TRANSPORT_SIDE], config);
+ *     rtaCommandOpenConnection_SetCounters(openCommand, counters);
+ *     rtaConnectionCounters_Release(&counters);
+ * }
+ * @endcode
+ */
+void rtaCommandOpenConnection_SetCounters(RtaCommandOpenConnection *openConnection, struct rta_connection_counters *counters);
+
+/**
+ * Returns the shared counter block, if any
+ *
+ * @param [in] openConnection An allocated RtaCommandOpenConnection
+ *
+ * @return non-null The value passed to rtaCommandOpenConnection_SetCounters()
+ * @return null No counters were attached
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+struct rta_connection_counters *rtaCommandOpenConnection_GetCounters(const RtaCommandOpenConnection *openConnection);
+
+/**
+ * Attaches the queue an inline transport reads the connection's messages from
+ *
+ * A transport created with rtaTransport_CreateInline() does not create a socket pair.
+ * The API connector puts the messages going up to the application on this queue
+ * instead of writing them to the transport descriptor, which is -1.  The command
+ * acquires its own reference.  Passing NULL clears the queue.
+ *
+ * @param [in] openConnection An allocated RtaCommandOpenConnection
+ * @param [in] inlineQueue The queue, may be NULL
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaInlineQueue *queue = rtaInlineQueue_Create(NULL, NULL);
+ *     RtaCommandOpenConnection *openCommand = rtaCommandOpenConnection_Create(stackId, queueId, -1, config);
+ *     rtaCommandOpenConnection_SetInlineQueue(openCommand, queue);
+ *     rtaInlineQueue_Release(&queue);
+ * }
+ * @endcode
+ */
+void rtaCommandOpenConnection_SetInlineQueue(RtaCommandOpenConnection *openConnection, struct rta_inline_queue *inlineQueue);
+
+/**
+ * Returns the inline queue, if any
+ *
+ * @param [in] openConnection An allocated RtaCommandOpenConnection
+ *
+ * @return non-null The value passed to rtaCommandOpenConnection_SetInlineQueue()
+ * @return null The connection uses its socket pair
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+struct rta_inline_queue *rtaCommandOpenConnection_GetInlineQueue(const RtaCommandOpenConnection *openConnection);
+
+/**
+ * Attaches the queue application threads put the connection's outbound messages on
+ *
+ * With a send queue, rtaTransport_Send() does not write message pointers to the socket pair.
+ * It puts them on this queue and only writes a wake-up to the socket (see rtaSendQueue_Notify()).
+ * The command acquires its own reference.  Passing NULL clears the queue.
+ *
+ * @param [in] openConnection An allocated RtaCommandOpenConnection
+ * @param [in] sendQueue The queue, may be NULL
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaSendQueue *queue = rtaSendQueue_Create(RTA_SEND_QUEUE_DEFAULT_CAPACITY);
+ *     RtaCommandOpenConnection *openCommand = rtaCommandOpenConnection_Create(stackId, pair[0], pair[1], config);
+ *     rtaCommandOpenConnection_SetSendQueue(openCommand, queue);
+ *     rtaSendQueue_Release(&queue);
+ * }
+ * @endcode
+ */
+void rtaCommandOpenConnection_SetSendQueue(RtaCommandOpenConnection *openConnection, struct rta_send_queue *sendQueue);
+
+/**
+ * Returns the send queue, if any
+ *
+ * @param [in] openConnection An allocated RtaCommandOpenConnection
+ *
+ * @return non-null The value passed to rtaCommandOpenConnection_SetSendQueue()
+ * @return null Messages arrive as pointers on the socket pair
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+struct rta_send_queue *rtaCommandOpenConnection_GetSendQueue(const RtaCommandOpenConnection *openConnection);
 #endif // Libccnx_rta_CommandOpenConnection_h
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file rta_CommandOpenManyConnections.h
+ * @brief Represents a command to open a batch of connections
+ *
+ * Carries any number of RtaCommandOpenConnection objects so a caller opening thousands of
+ * connections pays for one trip through the command ring buffer instead of one per
+ * connection.  The Transport executes them in order, exactly as if each had been sent
+ * as its own OpenConnection command.
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef Libccnx_rta_CommandOpenManyConnections_h
+#define Libccnx_rta_CommandOpenManyConnections_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <ccnx/transport/transport_rta/commands/rta_CommandOpenConnection.h>
+
+struct rta_command_openmanyconnections;
+typedef struct rta_command_openmanyconnections RtaCommandOpenManyConnections;
+
+/**
+ * Creates an empty OpenManyConnections command object
+ *
+ * @param [in] capacity The most connections the command will hold
+ *
+ * @return non-null An allocated object
+ * @return null An error
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaCommandOpenManyConnections *openMany = rtaCommandOpenManyConnections_Create(2);
+ *     for (int i = 0; i < 2; i++) {
+ *         RtaCommandOpenConnection *openConnection = rtaCommandOpenConnection_Create(stackId, pairs[i].up, pairs[i].down, config);
+ *         rtaCommandOpenManyConnections_Add(openMany, openConnection);
+ *         rtaCommandOpenConnection_Release(&openConnection);
+ *     }
+ *
+ *     RtaCommand *command = rtaCommand_CreateOpenManyConnections(openMany);
+ *     _rtaTransport_SendCommandToFramework(transport, command);
+ *     rtaCommand_Release(&command);
+ *     rtaCommandOpenManyConnections_Release(&openMany);
+ * }
+ * @endcode
+ */
+RtaCommandOpenManyConnections *rtaCommandOpenManyConnections_Create(size_t capacity);
+
+/**
+ * Increase the number of references to a `RtaCommandOpenManyConnections`.
+ *
+ * Note that new `RtaCommandOpenManyConnections` is not created,
+ * only that the given `RtaCommandOpenManyConnections` reference count is incremented.
+ * Discard the reference by invoking `rtaCommandOpenManyConnections_Release`.
+ *
+ * @param [in] openMany The RtaCommandOpenManyConnections to reference.
+ *
+ * @return non-null A reference to `openMany`.
+ * @return null An error
+ *
+ * Example:
+ * @code
+ * {
+ *    RtaCommandOpenManyConnections *openMany = rtaCommandOpenManyConnections_Create(10);
+ *    RtaCommandOpenManyConnections *second = rtaCommandOpenManyConnections_Acquire(openMany);
+ *
+ *    // release order does not matter
+ *    rtaCommandOpenManyConnections_Release(&openMany);
+ *    rtaCommandOpenManyConnections_Release(&second);
+ * }
+ * @endcode
+ */
+RtaCommandOpenManyConnections *rtaCommandOpenManyConnections_Acquire(const RtaCommandOpenManyConnections *openMany);
+
+/**
+ * Release a previously acquired reference to the specified instance,
+ * decrementing the reference count for the instance.
+ *
+ * The pointer to the instance is set to NULL as a side-effect of this function.
+ *
+ * If the invocation causes the last reference to the instance to be released,
+ * the instance releases the RtaCommandOpenConnection objects it holds.
+ *
+ * @param [in,out] openManyPtr A pointer to the object to release, will return NULL'd.
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaCommandOpenManyConnections *openMany = rtaCommandOpenManyConnections_Create(10);
+ *     rtaCommandOpenManyConnections_Release(&openMany);
+ * }
+ * @endcode
+ */
+void rtaCommandOpenManyConnections_Release(RtaCommandOpenManyConnections **openManyPtr);
+
+/**
+ * Appends a connection to the batch
+ *
+ * Acquires a reference to `openConnection`, so the caller keeps its own.
+ *
+ * @param [in] openMany An allocated RtaCommandOpenManyConnections
+ * @param [in] openConnection The connection to open
+ *
+ * @return true The connection was added
+ * @return false The command already holds `capacity` connections
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaCommandOpenConnection *openConnection = rtaCommandOpenConnection_Create(stackId, pair[0], pair[1], config);
+ *     bool success = rtaCommandOpenManyConnections_Add(openMany, openConnection);
+ *     rtaCommandOpenConnection_Release(&openConnection);
+ * }
+ * @endcode
+ */
+bool rtaCommandOpenManyConnections_Add(RtaCommandOpenManyConnections *openMany, const RtaCommandOpenConnection *openConnection);
+
+/**
+ * Returns the number of connections in the batch
+ *
+ * @param [in] openMany An allocated RtaCommandOpenManyConnections
+ *
+ * @return number The number of successful calls to rtaCommandOpenManyConnections_Add()
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaCommandOpenManyConnections *openMany = rtaCommandOpenManyConnections_Create(10);
+ *     assertTrue(rtaCommandOpenManyConnections_Count(openMany) == 0, "New batch should be empty");
+ *     rtaCommandOpenManyConnections_Release(&openMany);
+ * }
+ * @endcode
+ */
+size_t rtaCommandOpenManyConnections_Count(const RtaCommandOpenManyConnections *openMany);
+
+/**
+ * Returns one connection of the batch
+ *
+ * The caller should not release the returned object.
+ *
+ * @param [in] openMany An allocated RtaCommandOpenManyConnections
+ * @param [in] index Less than rtaCommandOpenManyConnections_Count()
+ *
+ * @return non-null The index'th RtaCommandOpenConnection added
+ *
+ * Example:
+ * @code
+ * {
+ *     for (size_t i = 0; i < rtaCommandOpenManyConnections_Count(openMany); i++) {
+ *         const RtaCommandOpenConnection *openConnection = rtaCommandOpenManyConnections_Get(openMany, i);
+ *         printf("api fd %d\n", rtaCommandOpenConnection_GetApiNotifierFd(openConnection));
+ *     }
+ * }
+ * @endcode
+ */
+const RtaCommandOpenConnection *rtaCommandOpenManyConnections_Get(const RtaCommandOpenManyConnections *openMany, size_t index);
+#endif // Libccnx_rta_CommandOpenManyConnections_h
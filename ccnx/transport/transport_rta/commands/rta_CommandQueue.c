@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ *
+ * The commands go on an RtaMpscRing, this adds the reference count and the release of
+ * the commands left on it.
+ */
+
+#include <config.h>
+
+#include <LongBow/runtime.h>
+
+#include <string.h>
+
+#include <parc/algol/parc_Memory.h>
+
+#include <ccnx/transport/transport_rta/core/rta_MpscRing.h>
+#include <ccnx/transport/transport_rta/commands/rta_CommandQueue.h>
+
+struct rta_command_queue {
+    RtaMpscRing ring;
+    unsigned refcount;
+} __attribute__ ((aligned(RTA_CACHE_LINE_SIZE)));
+
+// ======= Public API
+
+RtaCommandQueue *
+rtaCommandQueue_Create(size_t capacity)
+{
+    assertTrue(capacity > 0, "Parameter capacity must be positive");
+
+    void *memory = NULL;
+    int failure = parcMemory_MemAlign(&memory, RTA_CACHE_LINE_SIZE, sizeof(RtaCommandQueue));
+    assertFalse(failure, "parcMemory_MemAlign(%d, %zu) failed", RTA_CACHE_LINE_SIZE, sizeof(RtaCommandQueue));
+
+    RtaCommandQueue *queue = memory;
+    memset(queue, 0, sizeof(RtaCommandQueue));
+
+    rtaMpscRing_Init(&queue->ring, capacity);
+    queue->refcount = 1;
+
+    return queue;
+}
+
+RtaCommandQueue *
+rtaCommandQueue_Acquire(const RtaCommandQueue *queue)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+    RtaCommandQueue *result = (RtaCommandQueue *) queue;
+    __atomic_add_fetch(&result->refcount, 1, __ATOMIC_RELAXED);
+    return result;
+}
+
+void
+rtaCommandQueue_Release(RtaCommandQueue **queuePtr)
+{
+    assertNotNull(queuePtr, "Parameter queuePtr must be non-null");
+    RtaCommandQueue *queue = *queuePtr;
+    assertNotNull(queue, "Parameter queuePtr must dereference to non-null");
+
+    if (__atomic_sub_fetch(&queue->refcount, 1, __ATOMIC_ACQ_REL) == 0) {
+        RtaCommand *command;
+        while ((command = rtaCommandQueue_Get(queue)) != NULL) {
+            rtaCommand_Release(&command);
+        }
+
+        rtaMpscRing_Fini(&queue->ring);
+        parcMemory_Deallocate((void **) &queue);
+    }
+    *queuePtr = NULL;
+}
+
+size_t
+rtaCommandQueue_Capacity(const RtaCommandQueue *queue)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+    return rtaMpscRing_Capacity(&queue->ring);
+}
+
+size_t
+rtaCommandQueue_Count(const RtaCommandQueue *queue)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+    return rtaMpscRing_Count(&queue->ring);
+}
+
+bool
+rtaCommandQueue_Put(RtaCommandQueue *queue, RtaCommand *command, const uint64_t *microSeconds)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+    assertNotNull(command, "Parameter command must be non-null");
+    return rtaMpscRing_Put(&queue->ring, command, microSeconds);
+}
+
+RtaCommand *
+rtaCommandQueue_Get(RtaCommandQueue *queue)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+    return rtaMpscRing_Get(&queue->ring);
+}
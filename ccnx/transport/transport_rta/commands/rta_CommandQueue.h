@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file rta_CommandQueue.h
+ * @brief The bounded multi-producer, single-consumer queue of commands to the Framework
+ *
+ * Any number of API threads put commands on the queue at the same time, without a lock.
+ * Only the Framework's thread takes them off.  Each slot of the array carries a sequence
+ * number, so a producer claims a slot with one compare-and-swap and publishes it with
+ * one store, and the consumer never writes a producer's cache line until it frees a slot.
+ *
+ * A producer that finds the queue full can wait for room with a timeout, see
+ * rtaCommandQueue_Put().  The consumer only takes a lock when a producer is waiting.
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef Libccnx_rta_CommandQueue_h
+#define Libccnx_rta_CommandQueue_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+struct rta_command_queue;
+typedef struct rta_command_queue RtaCommandQueue;
+
+#include <ccnx/transport/transport_rta/commands/rta_Command.h>
+
+/**
+ * @def RTA_COMMAND_QUEUE_DEFAULT_CAPACITY
+ * The capacity of a transport's command queue unless its TransportInstanceOptions give one
+ */
+#define RTA_COMMAND_QUEUE_DEFAULT_CAPACITY 1024
+
+/**
+ * Create an empty queue
+ *
+ * @param [in] capacity The number of commands the queue holds, rounded up to a power of 2
+ *
+ * @return non-null A queue to release with rtaCommandQueue_Release()
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaCommandQueue *queue = rtaCommandQueue_Create(RTA_COMMAND_QUEUE_DEFAULT_CAPACITY);
+ *     RtaFramework *framework = rtaFramework_Create(queue, notifier);
+ *     ...
+ *     rtaCommandQueue_Release(&queue);
+ * }
+ * @endcode
+ */
+RtaCommandQueue *rtaCommandQueue_Create(size_t capacity);
+
+/**
+ * Increase the number of references to the queue
+ *
+ * @param [in] queue The queue
+ *
+ * @return non-null A reference to `queue`
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+RtaCommandQueue *rtaCommandQueue_Acquire(const RtaCommandQueue *queue);
+
+/**
+ * Release a reference to the queue
+ *
+ * On the last release, the commands still on the queue are released.
+ *
+ * @param [in,out] queuePtr The reference to release, will be NULL'd
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaCommandQueue_Release(RtaCommandQueue **queuePtr);
+
+/**
+ * The number of commands the queue holds
+ *
+ * @param [in] queue The queue
+ *
+ * @return number A power of 2
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+size_t rtaCommandQueue_Capacity(const RtaCommandQueue *queue);
+
+/**
+ * The number of commands on the queue
+ *
+ * While other threads put or get, the count is already stale when it returns.
+ *
+ * @param [in] queue The queue
+ *
+ * @return number Between 0 and the capacity
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+size_t rtaCommandQueue_Count(const RtaCommandQueue *queue);
+
+/**
+ * Put a command on the queue, waiting for room if it is full.  Safe from any thread.
+ *
+ * On success the queue owns the caller's reference to `command`.  On failure the caller
+ * still owns it.
+ *
+ * @param [in] queue The queue
+ * @param [in] command The command, whose reference is handed to the queue
+ * @param [in] microSeconds NULL to wait for room as long as it takes, otherwise the longest
+ *             wait, with 0 meaning do not wait (see CCNxStackTimeout_Never and CCNxStackTimeout_Immediate)
+ *
+ * @return true The command is on the queue
+ * @return false The queue stayed full until the timeout, errno is EWOULDBLOCK
+ *
+ * Example:
+ * @code
+ * {
+ *     uint64_t timeout = 1000000;
+ *     RtaCommand *reference = rtaCommand_Acquire(command);
+ *     if (!rtaCommandQueue_Put(queue, reference, &timeout)) {
+ *         rtaCommand_Release(&reference);
+ *     }
+ * }
+ * @endcode
+ */
+bool rtaCommandQueue_Put(RtaCommandQueue *queue, RtaCommand *command, const uint64_t *microSeconds);
+
+/**
+ * Take the oldest command off the queue without waiting.  Only one thread may call this.
+ *
+ * Commands put by one thread come off in the order it put them.
+ *
+ * @param [in] queue The queue
+ *
+ * @return non-null The command, whose reference now belongs to the caller
+ * @return null The queue is empty
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaCommand *command;
+ *     while ((command = rtaCommandQueue_Get(queue)) != NULL) {
+ *         ...
+ *         rtaCommand_Release(&command);
+ *     }
+ * }
+ * @endcode
+ */
+RtaCommand *rtaCommandQueue_Get(RtaCommandQueue *queue);
+#endif // Libccnx_rta_CommandQueue_h
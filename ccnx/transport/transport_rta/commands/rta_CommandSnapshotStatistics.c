@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ *
+ * Implements the RtaCommandSnapshotStatistics object which asks the RTA Framework for the current statistics
+ * and carries the answer back to the caller.
+ */
+
+#include <config.h>
+
+#include <LongBow/runtime.h>
+
+#include <stdio.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/time.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Object.h>
+
+#include <ccnx/transport/transport_rta/commands/rta_CommandSnapshotStatistics.h>
+
+struct rta_command_snapshotstatistics {
+    pthread_mutex_t lock;
+    pthread_cond_t complete_cv;
+
+    // NULL until the Transport thread answers
+    PARCJSON *snapshot;
+};
+
+// ======= Private API
+
+static void
+_rtaCommandSnapshotStatistics_Destroy(RtaCommandSnapshotStatistics **snapshotStatsPtr)
+{
+    RtaCommandSnapshotStatistics *snapshotStats = *snapshotStatsPtr;
+    if (snapshotStats->snapshot != NULL) {
+        parcJSON_Release(&snapshotStats->snapshot);
+    }
+    pthread_cond_destroy(&snapshotStats->complete_cv);
+    pthread_mutex_destroy(&snapshotStats->lock);
+}
+
+parcObject_ExtendPARCObject(RtaCommandSnapshotStatistics, _rtaCommandSnapshotStatistics_Destroy,
+                            NULL, NULL, NULL, NULL, NULL, NULL);
+
+parcObject_ImplementAcquire(rtaCommandSnapshotStatistics, RtaCommandSnapshotStatistics);
+
+parcObject_ImplementRelease(rtaCommandSnapshotStatistics, RtaCommandSnapshotStatistics);
+
+/*
+ * The absolute (CLOCK_REALTIME) deadline for pthread_cond_timedwait
+ */
+static struct timespec
+_rtaCommandSnapshotStatistics_Deadline(uint64_t microSeconds)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+
+    uint64_t usec = (uint64_t) now.tv_usec + microSeconds;
+    struct timespec deadline = {
+        .tv_sec  = now.tv_sec + (time_t) (usec / 1000000),
+        .tv_nsec = (long) (usec % 1000000) * 1000
+    };
+    return deadline;
+}
+
+// ======= Public API
+
+RtaCommandSnapshotStatistics *
+rtaCommandSnapshotStatistics_Create(void)
+{
+    RtaCommandSnapshotStatistics *snapshotStats = parcObject_CreateInstance(RtaCommandSnapshotStatistics);
+    assertNotNull(snapshotStats, "parcObject_CreateInstance returned NULL");
+
+    pthread_mutex_init(&snapshotStats->lock, NULL);
+    pthread_cond_init(&snapshotStats->complete_cv, NULL);
+    snapshotStats->snapshot = NULL;
+
+    return snapshotStats;
+}
+
+void
+rtaCommandSnapshotStatistics_SetSnapshot(RtaCommandSnapshotStatistics *snapshotStats, PARCJSON *snapshot)
+{
+    assertNotNull(snapshotStats, "Parameter snapshotStats must be non-null");
+    assertNotNull(snapshot, "Parameter snapshot must be non-null");
+
+    pthread_mutex_lock(&snapshotStats->lock);
+    assertNull(snapshotStats->snapshot, "The snapshot was already set");
+    snapshotStats->snapshot = parcJSON_Acquire(snapshot);
+    pthread_cond_broadcast(&snapshotStats->complete_cv);
+    pthread_mutex_unlock(&snapshotStats->lock);
+}
+
+bool
+rtaCommandSnapshotStatistics_IsComplete(RtaCommandSnapshotStatistics *snapshotStats)
+{
+    assertNotNull(snapshotStats, "Parameter snapshotStats must be non-null");
+
+    pthread_mutex_lock(&snapshotStats->lock);
+    bool complete = (snapshotStats->snapshot != NULL);
+    pthread_mutex_unlock(&snapshotStats->lock);
+    return complete;
+}
+
+PARCJSON *
+rtaCommandSnapshotStatistics_WaitSnapshot(RtaCommandSnapshotStatistics *snapshotStats, const uint64_t *microSeconds)
+{
+    assertNotNull(snapshotStats, "Parameter snapshotStats must be non-null");
+
+    struct timespec deadline;
+    if (microSeconds != NULL) {
+        deadline = _rtaCommandSnapshotStatistics_Deadline(*microSeconds);
+    }
+
+    pthread_mutex_lock(&snapshotStats->lock);
+    while (snapshotStats->snapshot == NULL) {
+        if (microSeconds == NULL) {
+            pthread_cond_wait(&snapshotStats->complete_cv, &snapshotStats->lock);
+        } else if (pthread_cond_timedwait(&snapshotStats->complete_cv, &snapshotStats->lock, &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+
+    PARCJSON *result = NULL;
+    if (snapshotStats->snapshot != NULL) {
+        result = parcJSON_Acquire(snapshotStats->snapshot);
+    }
+    pthread_mutex_unlock(&snapshotStats->lock);
+
+    return result;
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file rta_CommandSnapshotStatistics.h
+ * @brief Represents a request for an in-memory statistics snapshot
+ *
+ * Used to construct an RtaCommand object that is passed to rtaTransport_PassCommand() or _rtaTransport_SendCommandToFramework()
+ * to send a command from the API's thread of execution to the Transport's thread of execution.
+ *
+ * Unlike RtaCommandTransmitStatistics, which appends to a file on a timer, this command carries
+ * its answer back.  The Transport thread builds the snapshot and calls rtaCommandSnapshotStatistics_SetSnapshot(),
+ * while the API thread blocks in rtaCommandSnapshotStatistics_WaitSnapshot().  Both sides hold a reference.
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef Libccnx_rta_CommandSnapshotStatistics_h
+#define Libccnx_rta_CommandSnapshotStatistics_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <parc/algol/parc_JSON.h>
+
+struct rta_command_snapshotstatistics;
+typedef struct rta_command_snapshotstatistics RtaCommandSnapshotStatistics;
+
+/**
+ * Creates a request with no snapshot yet
+ *
+ * @return non-null An allocated RtaCommandSnapshotStatistics
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaCommandSnapshotStatistics *snapshotStats = rtaCommandSnapshotStatistics_Create();
+ *     RtaCommand *command = rtaCommand_CreateSnapshotStatistics(snapshotStats);
+ *     rtaTransport_PassCommand(transport, command);
+ *     rtaCommand_Release(&command);
+ *
+ *     PARCJSON *snapshot = rtaCommandSnapshotStatistics_WaitSnapshot(snapshotStats, NULL);
+ *     rtaCommandSnapshotStatistics_Release(&snapshotStats);
+ *     parcJSON_Release(&snapshot);
+ * }
+ * @endcode
+ */
+RtaCommandSnapshotStatistics *rtaCommandSnapshotStatistics_Create(void);
+
+/**
+ * Increase the number of references to a `RtaCommandSnapshotStatistics`.
+ *
+ * Note that new `RtaCommandSnapshotStatistics` is not created,
+ * only that the given `RtaCommandSnapshotStatistics` reference count is incremented.
+ * Discard the reference by invoking `rtaCommandSnapshotStatistics_Release`.
+ *
+ * @param [in] snapshotStats The RtaCommandSnapshotStatistics to reference.
+ *
+ * @return non-null A reference to `snapshotStats`.
+ * @return null An error
+ *
+ * Example:
+ * @code
+ * {
+ *
+ * }
+ * @endcode
+ */
+RtaCommandSnapshotStatistics *rtaCommandSnapshotStatistics_Acquire(const RtaCommandSnapshotStatistics *snapshotStats);
+
+/**
+ * Release a previously acquired reference to the specified instance,
+ * decrementing the reference count for the instance.
+ *
+ * The pointer to the instance is set to NULL as a side-effect of this function.
+ *
+ * If the invocation causes the last reference to the instance to be released,
+ * the instance is deallocated and the instance's implementation will perform
+ * additional cleanup and release other privately held references.
+ *
+ * @param [in,out] snapshotStatsPtr A pointer to the object to release, will return NULL'd.
+ *
+ * Example:
+ * @code
+ * {
+ * }
+ * @endcode
+ */
+void rtaCommandSnapshotStatistics_Release(RtaCommandSnapshotStatistics **snapshotStatsPtr);
+
+/**
+ * Stores the snapshot and wakes the waiting caller
+ *
+ * Called once, from the Transport thread.  Takes its own reference to `snapshot`.
+ *
+ * @param [in] snapshotStats An allocated RtaCommandSnapshotStatistics
+ * @param [in] snapshot The statistics
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaCommandSnapshotStatistics_SetSnapshot(RtaCommandSnapshotStatistics *snapshotStats, PARCJSON *snapshot);
+
+/**
+ * Tests if the Transport has answered the request
+ *
+ * @param [in] snapshotStats An allocated RtaCommandSnapshotStatistics
+ *
+ * @return true rtaCommandSnapshotStatistics_SetSnapshot() has been called
+ * @return false Still waiting on the Transport
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+bool rtaCommandSnapshotStatistics_IsComplete(RtaCommandSnapshotStatistics *snapshotStats);
+
+/**
+ * Blocks until the Transport answers the request, or the timeout passes
+ *
+ * Must not be called from the Transport thread, as it would wait on itself.
+ *
+ * @param [in] snapshotStats An allocated RtaCommandSnapshotStatistics
+ * @param [in] microSeconds If NULL, wait forever, otherwise the longest time to wait
+ *
+ * @return non-null A reference to the snapshot, the caller must release it
+ * @return null The timeout passed first
+ *
+ * Example:
+ * @code
+ * {
+ *     uint64_t timeout = 1000000;
+ *     PARCJSON *snapshot = rtaCommandSnapshotStatistics_WaitSnapshot(snapshotStats, &timeout);
+ *     if (snapshot != NULL) {
+ *         parcJSON_Release(&snapshot);
+ *     }
+ * }
+ * @endcode
+ */
+PARCJSON *rtaCommandSnapshotStatistics_WaitSnapshot(RtaCommandSnapshotStatistics *snapshotStats, const uint64_t *microSeconds);
+#endif // Libccnx_rta_CommandSnapshotStatistics_h
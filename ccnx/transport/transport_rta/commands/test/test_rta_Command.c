@@ -58,7 +58,9 @@
 #include "../rta_Command.c"
 
 #include <inttypes.h>
+#include <unistd.h>
 #include <LongBow/unit-test.h>
+#include <ccnx/transport/common/transport.h>
 #include <parc/algol/parc_SafeMemory.h>
 
 LONGBOW_TEST_RUNNER(rta_Command)
@@ -92,12 +94,16 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, rtaCommand_CreateDestroyProtocolStack);
     LONGBOW_RUN_TEST_CASE(Global, rtaCommand_CreateOpenConnection);
     LONGBOW_RUN_TEST_CASE(Global, rtaCommand_CreateTransmitStatistics);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommand_CreateSnapshotStatistics);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommand_CreateOpenManyConnections);
 
     LONGBOW_RUN_TEST_CASE(Global, rtaCommand_GetCloseConnection);
     LONGBOW_RUN_TEST_CASE(Global, rtaCommand_GetCreateProtocolStack);
     LONGBOW_RUN_TEST_CASE(Global, rtaCommand_GetDestroyProtocolStack);
     LONGBOW_RUN_TEST_CASE(Global, rtaCommand_GetOpenConnection);
     LONGBOW_RUN_TEST_CASE(Global, rtaCommand_GetTransmitStatistics);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommand_GetSnapshotStatistics);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommand_GetOpenManyConnections);
 
     LONGBOW_RUN_TEST_CASE(Global, rtaCommand_IsCloseConnection_True);
     LONGBOW_RUN_TEST_CASE(Global, rtaCommand_IsCreateProtocolStack_True);
@@ -105,6 +111,8 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, rtaCommand_IsOpenConnection_True);
     LONGBOW_RUN_TEST_CASE(Global, rtaCommand_IsShutdownFramework_True);
     LONGBOW_RUN_TEST_CASE(Global, rtaCommand_IsTransmitStatistics_True);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommand_IsSnapshotStatistics_True);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommand_IsOpenManyConnections_True);
 
     LONGBOW_RUN_TEST_CASE(Global, rtaCommand_IsCloseConnection_False);
     LONGBOW_RUN_TEST_CASE(Global, rtaCommand_IsCreateProtocolStack_False);
@@ -112,12 +120,16 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, rtaCommand_IsOpenConnection_False);
     LONGBOW_RUN_TEST_CASE(Global, rtaCommand_IsShutdownFramework_False);
     LONGBOW_RUN_TEST_CASE(Global, rtaCommand_IsTransmitStatistics_False);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommand_IsSnapshotStatistics_False);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommand_IsOpenManyConnections_False);
 
     LONGBOW_RUN_TEST_CASE(Global, rtaCommand_Read_Single);
     LONGBOW_RUN_TEST_CASE(Global, rtaCommand_Write_Single);
 
     LONGBOW_RUN_TEST_CASE(Global, rtaCommand_Read_Underflow);
     LONGBOW_RUN_TEST_CASE(Global, rtaCommand_Write_Overflow);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommand_SetComplete);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommand_WaitComplete);
 
     // miscellaneous functions
     LONGBOW_RUN_TEST_CASE(Global, rtaCommand_Display);
@@ -232,6 +244,26 @@ LONGBOW_TEST_CASE(Global, rtaCommand_CreateTransmitStatistics)
     rtaCommandTransmitStatistics_Release(&transmitStats);
 }
 
+LONGBOW_TEST_CASE(Global, rtaCommand_CreateSnapshotStatistics)
+{
+    RtaCommandSnapshotStatistics *snapshotStats = rtaCommandSnapshotStatistics_Create();
+    RtaCommand *command = rtaCommand_CreateSnapshotStatistics(snapshotStats);
+    assertNotNull(command, "Got null command from create");
+    assertTrue(command->type == RtaCommandType_SnapshotStatistics, "Command is not SnapshotStatistics");
+    rtaCommand_Release(&command);
+    rtaCommandSnapshotStatistics_Release(&snapshotStats);
+}
+
+LONGBOW_TEST_CASE(Global, rtaCommand_CreateOpenManyConnections)
+{
+    RtaCommandOpenManyConnections *openMany = rtaCommandOpenManyConnections_Create(4);
+    RtaCommand *command = rtaCommand_CreateOpenManyConnections(openMany);
+    assertNotNull(command, "Got null command from create");
+    assertTrue(command->type == RtaCommandType_OpenManyConnections, "Command is not OpenManyConnections");
+    rtaCommand_Release(&command);
+    rtaCommandOpenManyConnections_Release(&openMany);
+}
+
 // =======================
 // GET operations
 
@@ -298,6 +330,30 @@ LONGBOW_TEST_CASE(Global, rtaCommand_GetTransmitStatistics)
     rtaCommandTransmitStatistics_Release(&transmitStats);
 }
 
+LONGBOW_TEST_CASE(Global, rtaCommand_GetSnapshotStatistics)
+{
+    RtaCommandSnapshotStatistics *snapshotStats = rtaCommandSnapshotStatistics_Create();
+    RtaCommand *command = rtaCommand_CreateSnapshotStatistics(snapshotStats);
+
+    RtaCommandSnapshotStatistics *test = rtaCommand_GetSnapshotStatistics(command);
+    assertTrue(test == snapshotStats, "Wrong pointers, got %p expected %p", (void *) test, (void *) snapshotStats);
+
+    rtaCommand_Release(&command);
+    rtaCommandSnapshotStatistics_Release(&snapshotStats);
+}
+
+LONGBOW_TEST_CASE(Global, rtaCommand_GetOpenManyConnections)
+{
+    RtaCommandOpenManyConnections *openMany = rtaCommandOpenManyConnections_Create(4);
+    RtaCommand *command = rtaCommand_CreateOpenManyConnections(openMany);
+
+    const RtaCommandOpenManyConnections *test = rtaCommand_GetOpenManyConnections(command);
+    assertTrue(test == openMany, "Wrong pointers, got %p expected %p", (void *) test, (void *) openMany);
+
+    rtaCommand_Release(&command);
+    rtaCommandOpenManyConnections_Release(&openMany);
+}
+
 // =======================
 // IsX operations
 
@@ -356,6 +412,24 @@ LONGBOW_TEST_CASE(Global, rtaCommand_IsTransmitStatistics_True)
     rtaCommandTransmitStatistics_Release(&transmitStats);
 }
 
+LONGBOW_TEST_CASE(Global, rtaCommand_IsSnapshotStatistics_True)
+{
+    RtaCommandSnapshotStatistics *snapshotStats = rtaCommandSnapshotStatistics_Create();
+    RtaCommand *command = rtaCommand_CreateSnapshotStatistics(snapshotStats);
+    assertTrue(rtaCommand_IsSnapshotStatistics(command), "Command is not SnapshotStatistics");
+    rtaCommand_Release(&command);
+    rtaCommandSnapshotStatistics_Release(&snapshotStats);
+}
+
+LONGBOW_TEST_CASE(Global, rtaCommand_IsOpenManyConnections_True)
+{
+    RtaCommandOpenManyConnections *openMany = rtaCommandOpenManyConnections_Create(4);
+    RtaCommand *command = rtaCommand_CreateOpenManyConnections(openMany);
+    assertTrue(rtaCommand_IsOpenManyConnections(command), "Command is not OpenManyConnections");
+    rtaCommand_Release(&command);
+    rtaCommandOpenManyConnections_Release(&openMany);
+}
+
 
 LONGBOW_TEST_CASE(Global, rtaCommand_IsCloseConnection_False)
 {
@@ -401,98 +475,155 @@ LONGBOW_TEST_CASE(Global, rtaCommand_IsTransmitStatistics_False)
     rtaCommand_Release(&command);
 }
 
+LONGBOW_TEST_CASE(Global, rtaCommand_IsSnapshotStatistics_False)
+{
+    RtaCommand *command = rtaCommand_CreateShutdownFramework();
+    assertFalse(rtaCommand_IsSnapshotStatistics(command), "Command is not SnapshotStatistics, should be false");
+    rtaCommand_Release(&command);
+}
+
+LONGBOW_TEST_CASE(Global, rtaCommand_IsOpenManyConnections_False)
+{
+    RtaCommand *command = rtaCommand_CreateShutdownFramework();
+    assertFalse(rtaCommand_IsOpenManyConnections(command), "Command is not OpenManyConnections, should be false");
+    rtaCommand_Release(&command);
+}
+
 // ===========================
 // IO operations
 
 /*
- * Read a single command from a ring buffer
+ * Read a single command from a command queue
  */
 LONGBOW_TEST_CASE(Global, rtaCommand_Read_Single)
 {
-    PARCRingBuffer1x1 *ring = parcRingBuffer1x1_Create(4, NULL);
+    RtaCommandQueue *queue = rtaCommandQueue_Create(4);
     RtaCommand *command = rtaCommand_CreateShutdownFramework();
 
-    bool success = parcRingBuffer1x1_Put(ring, command);
-    assertTrue(success, "Failed to put command in to ring buffer");
+    bool success = rtaCommandQueue_Put(queue, rtaCommand_Acquire(command), CCNxStackTimeout_Immediate);
+    assertTrue(success, "Failed to put command in to the queue");
 
-    RtaCommand *test = rtaCommand_Read(ring);
+    RtaCommand *test = rtaCommand_Read(queue);
     assertTrue(test == command, "Wrong pointers, got %p expected %p", (void *) test, (void *) command);
 
+    rtaCommand_Release(&test);
     rtaCommand_Release(&command);
-    parcRingBuffer1x1_Release(&ring);
+    rtaCommandQueue_Release(&queue);
 }
 
 /*
- * Write a single command to a ring buffer and make sure it works
+ * Write a single command to a command queue and make sure it works
  */
 LONGBOW_TEST_CASE(Global, rtaCommand_Write_Single)
 {
-    PARCRingBuffer1x1 *ring = parcRingBuffer1x1_Create(4, NULL);
+    RtaCommandQueue *queue = rtaCommandQueue_Create(4);
     RtaCommand *command = rtaCommand_CreateShutdownFramework();
 
-    bool success = rtaCommand_Write(command, ring);
-    assertTrue(success, "Failed to put command in to ring buffer");
+    bool success = rtaCommand_Write(command, queue, CCNxStackTimeout_Immediate);
+    assertTrue(success, "Failed to put command in to the queue");
 
     // We should now have two references
     assertTrue(parcObject_GetReferenceCount(command) == 2, "Wrong refernce count, got %" PRIu64 " expected %u", parcObject_GetReferenceCount(command), 2);
 
-    RtaCommand *test = rtaCommand_Read(ring);
+    RtaCommand *test = rtaCommand_Read(queue);
     assertTrue(test == command, "Wrong pointers, got %p expected %p", (void *) test, (void *) command);
 
     rtaCommand_Release(&command);
     rtaCommand_Release(&test);
-    parcRingBuffer1x1_Release(&ring);
+    rtaCommandQueue_Release(&queue);
 }
 
 /*
- * Read from an empty ring buffer
+ * Read from an empty command queue
  */
 LONGBOW_TEST_CASE(Global, rtaCommand_Read_Underflow)
 {
-    PARCRingBuffer1x1 *ring = parcRingBuffer1x1_Create(4, NULL);
+    RtaCommandQueue *queue = rtaCommandQueue_Create(4);
 
-    RtaCommand *test = rtaCommand_Read(ring);
-    assertNull(test, "Should have gotten NULL read from an empty ring buffer");
+    RtaCommand *test = rtaCommand_Read(queue);
+    assertNull(test, "Should have gotten NULL read from an empty queue");
 
-    parcRingBuffer1x1_Release(&ring);
+    rtaCommandQueue_Release(&queue);
 }
 
 /*
- * Write beyond the capacity of the ring buffer
+ * Write beyond the capacity of the command queue
  */
 LONGBOW_TEST_CASE(Global, rtaCommand_Write_Overflow)
 {
-    // The ring will store up to (ringSize-1) elements, so we can only
-    // have 3 items in a ring of size 4
-    unsigned ringSize = 4;
-    RtaCommand *commandArray[ringSize];
+    // The queue stores exactly its capacity
+    unsigned queueSize = 4;
+    RtaCommand *commandArray[queueSize + 1];
 
-    PARCRingBuffer1x1 *ring = parcRingBuffer1x1_Create(ringSize, NULL);
+    RtaCommandQueue *queue = rtaCommandQueue_Create(queueSize);
 
-    for (int i = 0; i < ringSize; i++) {
+    for (int i = 0; i < queueSize + 1; i++) {
         commandArray[i] = rtaCommand_CreateShutdownFramework();
     }
 
-    for (int i = 0; i < ringSize - 1; i++) {
-        bool success = rtaCommand_Write(commandArray[i], ring);
-        assertTrue(success, "Failed to put command in to ring buffer");
+    for (int i = 0; i < queueSize; i++) {
+        bool success = rtaCommand_Write(commandArray[i], queue, CCNxStackTimeout_Immediate);
+        assertTrue(success, "Failed to put command in to the queue");
     }
 
-    // now put the one that will not fit
-    bool shouldFail = rtaCommand_Write(commandArray[ringSize - 1], ring);
+    // now put the one that will not fit, waiting a little for room that never comes
+    bool shouldFail = rtaCommand_Write(commandArray[queueSize], queue, CCNxStackTimeout_MicroSeconds(1000));
     assertFalse(shouldFail, "Writing overflow item should have failed");
+    assertTrue(errno == EWOULDBLOCK, "Expected EWOULDBLOCK, got %d", errno);
+    assertTrue(parcObject_GetReferenceCount(commandArray[queueSize]) == 1, "Failed write kept a reference");
 
     // now make sure we read off all the right items
-    for (int i = 0; i < ringSize - 1; i++) {
-        RtaCommand *test = rtaCommand_Read(ring);
+    for (int i = 0; i < queueSize; i++) {
+        RtaCommand *test = rtaCommand_Read(queue);
         assertTrue(test == commandArray[i], "Wrong pointers, got %p expected %p", (void *) test, (void *) commandArray[i]);
         rtaCommand_Release(&test);
     }
 
-    for (int i = 0; i < ringSize; i++) {
+    for (int i = 0; i < queueSize + 1; i++) {
         rtaCommand_Release(&commandArray[i]);
     }
-    parcRingBuffer1x1_Release(&ring);
+    rtaCommandQueue_Release(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, rtaCommand_SetComplete)
+{
+    RtaCommand *command = rtaCommand_CreateShutdownFramework();
+
+    int error = -1;
+    bool complete = rtaCommand_WaitComplete(command, CCNxStackTimeout_Immediate, &error);
+    assertFalse(complete, "New command should not be complete");
+    assertTrue(error == -1, "Incomplete wait should not set the error");
+
+    rtaCommand_SetComplete(command, EBADF);
+    complete = rtaCommand_WaitComplete(command, CCNxStackTimeout_Never, &error);
+    assertTrue(complete, "Command should be complete");
+    assertTrue(error == EBADF, "Wrong error, expected %d got %d", EBADF, error);
+
+    rtaCommand_Release(&command);
+}
+
+static void *
+_completeLater(void *arg)
+{
+    usleep(10000);
+    rtaCommand_SetComplete(arg, 0);
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Global, rtaCommand_WaitComplete)
+{
+    RtaCommand *command = rtaCommand_CreateShutdownFramework();
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, _completeLater, command);
+
+    int error = -1;
+    bool complete = rtaCommand_WaitComplete(command, CCNxStackTimeout_MicroSeconds(5000000), &error);
+    assertTrue(complete, "Command should have completed on the other thread");
+    assertTrue(error == 0, "Wrong error, expected 0 got %d", error);
+
+    pthread_join(thread, NULL);
+    rtaCommand_Release(&command);
 }
 
 LONGBOW_TEST_CASE(Global, rtaCommand_Display)
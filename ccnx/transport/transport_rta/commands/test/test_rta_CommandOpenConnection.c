@@ -124,9 +124,11 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, rtaCommandOpenConnection_Create);
     LONGBOW_RUN_TEST_CASE(Global, rtaCommandOpenConnection_GetApiNotifierFd);
     LONGBOW_RUN_TEST_CASE(Global, rtaCommandOpenConnection_GetConfig);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommandOpenConnection_GetCounters_Default);
     LONGBOW_RUN_TEST_CASE(Global, rtaCommandOpenConnection_GetStackId);
     LONGBOW_RUN_TEST_CASE(Global, rtaCommandOpenConnection_GetTransportNotifierFd);
     LONGBOW_RUN_TEST_CASE(Global, rtaCommandOpenConnection_Release);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommandOpenConnection_SetCounters);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -193,6 +195,16 @@ LONGBOW_TEST_CASE(Global, rtaCommandOpenConnection_GetConfig)
     _destroyTestData(&data);
 }
 
+LONGBOW_TEST_CASE(Global, rtaCommandOpenConnection_GetCounters_Default)
+{
+    TestData *data = _createTestData();
+
+    RtaConnectionCounters *test = rtaCommandOpenConnection_GetCounters(data->openConnection);
+    assertNull(test, "Expected no counters by default, got %p", (void *) test);
+
+    _destroyTestData(&data);
+}
+
 LONGBOW_TEST_CASE(Global, rtaCommandOpenConnection_GetStackId)
 {
     TestData *data = _createTestData();
@@ -228,6 +240,22 @@ LONGBOW_TEST_CASE(Global, rtaCommandOpenConnection_Release)
     _destroyTestData(&data);
 }
 
+LONGBOW_TEST_CASE(Global, rtaCommandOpenConnection_SetCounters)
+{
+    TestData *data = _createTestData();
+    RtaConnectionCounters *counters = rtaConnectionCounters_Create();
+
+    rtaCommandOpenConnection_SetCounters(data->openConnection, counters);
+    assertTrue(rtaCommandOpenConnection_GetCounters(data->openConnection) == counters, "Wrong counters");
+
+    // the command holds its own reference
+    rtaConnectionCounters_Release(&counters);
+    uint64_t *row = rtaConnectionCounters_GetRow(rtaCommandOpenConnection_GetCounters(data->openConnection), API_CONNECTOR);
+    assertTrue(rtaConnectionCounters_Load(&row[STATS_OPENS]) == 0, "Expected zeroed counters");
+
+    _destroyTestData(&data);
+}
+
 int
 main(int argc, char *argv[])
 {
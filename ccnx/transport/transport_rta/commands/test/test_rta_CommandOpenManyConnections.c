@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../rta_CommandOpenManyConnections.c"
+
+#include <LongBow/unit-test.h>
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_JSON.h>
+
+typedef struct test_data {
+    PARCJSON *config;
+    RtaCommandOpenConnection *first;
+    RtaCommandOpenConnection *second;
+} TestData;
+
+LONGBOW_TEST_RUNNER(rta_CommandOpenManyConnections)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(rta_CommandOpenManyConnections)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(rta_CommandOpenManyConnections)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommandOpenManyConnections_Acquire);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommandOpenManyConnections_Add);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommandOpenManyConnections_Add_Full);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommandOpenManyConnections_Create);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommandOpenManyConnections_Get);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommandOpenManyConnections_Release);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    TestData *data = parcMemory_AllocateAndClear(sizeof(TestData));
+    assertNotNull(data, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(TestData));
+    data->config = parcJSON_Create();
+    data->first = rtaCommandOpenConnection_Create(7, 8, 9, data->config);
+    data->second = rtaCommandOpenConnection_Create(7, 10, 11, data->config);
+    longBowTestCase_SetClipBoardData(testCase, data);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    rtaCommandOpenConnection_Release(&data->first);
+    rtaCommandOpenConnection_Release(&data->second);
+    parcJSON_Release(&data->config);
+    parcMemory_Deallocate((void **) &data);
+
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, rtaCommandOpenManyConnections_Acquire)
+{
+    RtaCommandOpenManyConnections *openMany = rtaCommandOpenManyConnections_Create(2);
+    size_t firstRefCount = parcObject_GetReferenceCount(openMany);
+
+    RtaCommandOpenManyConnections *second = rtaCommandOpenManyConnections_Acquire(openMany);
+    size_t secondRefCount = parcObject_GetReferenceCount(second);
+
+    assertTrue(secondRefCount == firstRefCount + 1, "Wrong refcount after acquire, got %zu expected %zu", secondRefCount, firstRefCount + 1);
+
+    rtaCommandOpenManyConnections_Release(&openMany);
+    rtaCommandOpenManyConnections_Release(&second);
+}
+
+LONGBOW_TEST_CASE(Global, rtaCommandOpenManyConnections_Add)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    RtaCommandOpenManyConnections *openMany = rtaCommandOpenManyConnections_Create(2);
+
+    size_t refCount = parcObject_GetReferenceCount(data->first);
+    bool success = rtaCommandOpenManyConnections_Add(openMany, data->first);
+    assertTrue(success, "Add to an empty batch failed");
+    assertTrue(rtaCommandOpenManyConnections_Count(openMany) == 1, "Wrong count, got %zu expected 1", rtaCommandOpenManyConnections_Count(openMany));
+    assertTrue(parcObject_GetReferenceCount(data->first) == refCount + 1, "Add did not acquire a reference");
+
+    rtaCommandOpenManyConnections_Release(&openMany);
+    assertTrue(parcObject_GetReferenceCount(data->first) == refCount, "Release did not release the connections");
+}
+
+LONGBOW_TEST_CASE(Global, rtaCommandOpenManyConnections_Add_Full)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    RtaCommandOpenManyConnections *openMany = rtaCommandOpenManyConnections_Create(1);
+
+    rtaCommandOpenManyConnections_Add(openMany, data->first);
+    bool success = rtaCommandOpenManyConnections_Add(openMany, data->second);
+    assertFalse(success, "Add past capacity should fail");
+    assertTrue(rtaCommandOpenManyConnections_Count(openMany) == 1, "Wrong count, got %zu expected 1", rtaCommandOpenManyConnections_Count(openMany));
+
+    rtaCommandOpenManyConnections_Release(&openMany);
+}
+
+LONGBOW_TEST_CASE(Global, rtaCommandOpenManyConnections_Create)
+{
+    RtaCommandOpenManyConnections *openMany = rtaCommandOpenManyConnections_Create(2);
+    assertNotNull(openMany, "Got null from create");
+    assertTrue(openMany->capacity == 2, "Wrong capacity, got %zu expected 2", openMany->capacity);
+    assertTrue(rtaCommandOpenManyConnections_Count(openMany) == 0, "New batch should be empty");
+    rtaCommandOpenManyConnections_Release(&openMany);
+}
+
+LONGBOW_TEST_CASE(Global, rtaCommandOpenManyConnections_Get)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    RtaCommandOpenManyConnections *openMany = rtaCommandOpenManyConnections_Create(2);
+
+    rtaCommandOpenManyConnections_Add(openMany, data->first);
+    rtaCommandOpenManyConnections_Add(openMany, data->second);
+
+    assertTrue(rtaCommandOpenManyConnections_Get(openMany, 0) == data->first, "Wrong connection at index 0");
+    assertTrue(rtaCommandOpenManyConnections_Get(openMany, 1) == data->second, "Wrong connection at index 1");
+
+    rtaCommandOpenManyConnections_Release(&openMany);
+}
+
+LONGBOW_TEST_CASE(Global, rtaCommandOpenManyConnections_Release)
+{
+    RtaCommandOpenManyConnections *openMany = rtaCommandOpenManyConnections_Create(2);
+
+    RtaCommandOpenManyConnections *second = rtaCommandOpenManyConnections_Acquire(openMany);
+    size_t secondRefCount = parcObject_GetReferenceCount(second);
+
+    rtaCommandOpenManyConnections_Release(&openMany);
+    size_t thirdRefCount = parcObject_GetReferenceCount(second);
+
+    assertTrue(thirdRefCount == secondRefCount - 1, "Wrong refcount after release, got %zu expected %zu", thirdRefCount, secondRefCount - 1);
+
+    rtaCommandOpenManyConnections_Release(&second);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(rta_CommandOpenManyConnections);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include "../rta_CommandQueue.c"
+
+#include <unistd.h>
+#include <LongBow/unit-test.h>
+#include <parc/algol/parc_SafeMemory.h>
+
+#include <ccnx/transport/common/transport.h>
+
+// each producer tags its commands with producer * _perProducer + sequence
+#define _producers 4
+#define _perProducer 2000
+
+static RtaCommand *
+_createTagged(int tag)
+{
+    RtaCommandCloseConnection *closeConnection = rtaCommandCloseConnection_Create(tag);
+    RtaCommand *command = rtaCommand_CreateCloseConnection(closeConnection);
+    rtaCommandCloseConnection_Release(&closeConnection);
+    return command;
+}
+
+static int
+_getTag(const RtaCommand *command)
+{
+    return rtaCommandCloseConnection_GetApiNotifierFd(rtaCommand_GetCloseConnection(command));
+}
+
+typedef struct producer_args {
+    RtaCommandQueue *queue;
+    int producer;
+} _ProducerArgs;
+
+static void *
+_producer(void *argVoid)
+{
+    _ProducerArgs *args = argVoid;
+    for (int i = 0; i < _perProducer; i++) {
+        bool success = rtaCommandQueue_Put(args->queue, _createTagged(args->producer * _perProducer + i), CCNxStackTimeout_Never);
+        assertTrue(success, "A put without a timeout failed");
+    }
+    return NULL;
+}
+
+LONGBOW_TEST_RUNNER(rta_CommandQueue)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+LONGBOW_TEST_RUNNER_SETUP(rta_CommandQueue)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_RUNNER_TEARDOWN(rta_CommandQueue)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommandQueue_Create_Release);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommandQueue_Capacity);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommandQueue_Put_Get);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommandQueue_Put_Full);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommandQueue_Put_WaitsForRoom);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommandQueue_Release_NotEmpty);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommandQueue_ManyProducers);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, rtaCommandQueue_Create_Release)
+{
+    RtaCommandQueue *queue = rtaCommandQueue_Create(8);
+    assertNotNull(queue, "Got null queue");
+    assertTrue(rtaCommandQueue_Count(queue) == 0, "New queue not empty");
+    assertNull(rtaCommandQueue_Get(queue), "Get on an empty queue should return NULL");
+
+    RtaCommandQueue *reference = rtaCommandQueue_Acquire(queue);
+    assertTrue(reference == queue, "Acquire returned a different pointer");
+    rtaCommandQueue_Release(&reference);
+
+    rtaCommandQueue_Release(&queue);
+    assertNull(queue, "Release did not null the pointer");
+}
+
+LONGBOW_TEST_CASE(Global, rtaCommandQueue_Capacity)
+{
+    size_t capacities[][2] = { { 1, 2 }, { 4, 4 }, { 5, 8 }, { 128, 128 }, { 1000, 1024 } };
+
+    for (size_t i = 0; i < sizeof(capacities) / sizeof(capacities[0]); i++) {
+        RtaCommandQueue *queue = rtaCommandQueue_Create(capacities[i][0]);
+        assertTrue(rtaCommandQueue_Capacity(queue) == capacities[i][1], "Capacity %zu should be %zu, got %zu",
+                   capacities[i][0], capacities[i][1], rtaCommandQueue_Capacity(queue));
+        rtaCommandQueue_Release(&queue);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, rtaCommandQueue_Put_Get)
+{
+    RtaCommandQueue *queue = rtaCommandQueue_Create(4);
+
+    // go around the array a few times
+    for (int lap = 0; lap < 3; lap++) {
+        for (int i = 0; i < 3; i++) {
+            bool success = rtaCommandQueue_Put(queue, _createTagged(i), CCNxStackTimeout_Immediate);
+            assertTrue(success, "Put failed on lap %d", lap);
+        }
+        assertTrue(rtaCommandQueue_Count(queue) == 3, "Expected 3 commands, got %zu", rtaCommandQueue_Count(queue));
+
+        for (int i = 0; i < 3; i++) {
+            RtaCommand *command = rtaCommandQueue_Get(queue);
+            assertNotNull(command, "Get returned NULL on lap %d", lap);
+            assertTrue(_getTag(command) == i, "Out of order, expected %d got %d", i, _getTag(command));
+            rtaCommand_Release(&command);
+        }
+        assertNull(rtaCommandQueue_Get(queue), "Queue should be empty");
+    }
+
+    rtaCommandQueue_Release(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, rtaCommandQueue_Put_Full)
+{
+    RtaCommandQueue *queue = rtaCommandQueue_Create(2);
+    rtaCommandQueue_Put(queue, _createTagged(0), CCNxStackTimeout_Immediate);
+    rtaCommandQueue_Put(queue, _createTagged(1), CCNxStackTimeout_Immediate);
+
+    RtaCommand *command = _createTagged(2);
+    bool success = rtaCommandQueue_Put(queue, command, CCNxStackTimeout_Immediate);
+    assertFalse(success, "Put on a full queue should fail");
+    assertTrue(errno == EWOULDBLOCK, "Expected EWOULDBLOCK, got %d", errno);
+
+    success = rtaCommandQueue_Put(queue, command, CCNxStackTimeout_MicroSeconds(1000));
+    assertFalse(success, "Put on a full queue should time out");
+    assertTrue(errno == EWOULDBLOCK, "Expected EWOULDBLOCK, got %d", errno);
+
+    rtaCommand_Release(&command);
+    rtaCommandQueue_Release(&queue);
+}
+
+static void *
+_getLater(void *queue)
+{
+    usleep(10000);
+    RtaCommand *command = rtaCommandQueue_Get(queue);
+    rtaCommand_Release(&command);
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Global, rtaCommandQueue_Put_WaitsForRoom)
+{
+    RtaCommandQueue *queue = rtaCommandQueue_Create(2);
+    rtaCommandQueue_Put(queue, _createTagged(0), CCNxStackTimeout_Immediate);
+    rtaCommandQueue_Put(queue, _createTagged(1), CCNxStackTimeout_Immediate);
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, _getLater, queue);
+
+    bool success = rtaCommandQueue_Put(queue, _createTagged(2), CCNxStackTimeout_MicroSeconds(5000000));
+    assertTrue(success, "Put should have found the room the consumer made");
+    pthread_join(thread, NULL);
+
+    RtaCommand *command = rtaCommandQueue_Get(queue);
+    assertTrue(_getTag(command) == 1, "Expected command 1, got %d", _getTag(command));
+    rtaCommand_Release(&command);
+    command = rtaCommandQueue_Get(queue);
+    assertTrue(_getTag(command) == 2, "Expected command 2, got %d", _getTag(command));
+    rtaCommand_Release(&command);
+
+    rtaCommandQueue_Release(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, rtaCommandQueue_Release_NotEmpty)
+{
+    // The teardown checks that the commands are released with the queue
+    RtaCommandQueue *queue = rtaCommandQueue_Create(4);
+    rtaCommandQueue_Put(queue, _createTagged(0), CCNxStackTimeout_Immediate);
+    rtaCommandQueue_Put(queue, _createTagged(1), CCNxStackTimeout_Immediate);
+    rtaCommandQueue_Release(&queue);
+}
+
+/*
+ * Producers on several threads fill a small queue while we drain it.  Every command
+ * arrives once, and each producer's commands arrive in the order it put them.
+ */
+LONGBOW_TEST_CASE(Global, rtaCommandQueue_ManyProducers)
+{
+    RtaCommandQueue *queue = rtaCommandQueue_Create(16);
+
+    pthread_t threads[_producers];
+    _ProducerArgs args[_producers];
+    for (int i = 0; i < _producers; i++) {
+        args[i].queue = queue;
+        args[i].producer = i;
+        pthread_create(&threads[i], NULL, _producer, &args[i]);
+    }
+
+    int next[_producers] = { 0 };
+    int received = 0;
+    while (received < _producers * _perProducer) {
+        RtaCommand *command = rtaCommandQueue_Get(queue);
+        if (command == NULL) {
+            sched_yield();
+            continue;
+        }
+
+        int tag = _getTag(command);
+        int producer = tag / _perProducer;
+        assertTrue(tag % _perProducer == next[producer], "Producer %d out of order, expected %d got %d",
+                   producer, next[producer], tag % _perProducer);
+        next[producer]++;
+        received++;
+        rtaCommand_Release(&command);
+    }
+
+    for (int i = 0; i < _producers; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    assertNull(rtaCommandQueue_Get(queue), "Queue should be empty");
+
+    rtaCommandQueue_Release(&queue);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(rta_CommandQueue);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../rta_CommandSnapshotStatistics.c"
+
+#include <LongBow/unit-test.h>
+#include <parc/algol/parc_SafeMemory.h>
+
+#include <unistd.h>
+
+// =============================================================
+LONGBOW_TEST_RUNNER(rta_CommandSnapshotStatistics)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(rta_CommandSnapshotStatistics)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(rta_CommandSnapshotStatistics)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommandSnapshotStatistics_Acquire);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommandSnapshotStatistics_Create);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommandSnapshotStatistics_Release);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommandSnapshotStatistics_SetSnapshot);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommandSnapshotStatistics_WaitSnapshot_Timeout);
+    LONGBOW_RUN_TEST_CASE(Global, rtaCommandSnapshotStatistics_WaitSnapshot_OtherThread);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, rtaCommandSnapshotStatistics_Acquire)
+{
+    RtaCommandSnapshotStatistics *snapshotStats = rtaCommandSnapshotStatistics_Create();
+    size_t firstRefCount = parcObject_GetReferenceCount(snapshotStats);
+
+    RtaCommandSnapshotStatistics *second = rtaCommandSnapshotStatistics_Acquire(snapshotStats);
+    size_t secondRefCount = parcObject_GetReferenceCount(second);
+
+    assertTrue(secondRefCount == firstRefCount + 1, "Wrong refcount after acquire, got %zu expected %zu", secondRefCount, firstRefCount + 1);
+
+    rtaCommandSnapshotStatistics_Release(&second);
+    rtaCommandSnapshotStatistics_Release(&snapshotStats);
+}
+
+LONGBOW_TEST_CASE(Global, rtaCommandSnapshotStatistics_Create)
+{
+    RtaCommandSnapshotStatistics *snapshotStats = rtaCommandSnapshotStatistics_Create();
+    assertNotNull(snapshotStats, "Got null from create");
+    assertNull(snapshotStats->snapshot, "A new request should have no snapshot");
+    assertFalse(rtaCommandSnapshotStatistics_IsComplete(snapshotStats), "A new request should not be complete");
+    rtaCommandSnapshotStatistics_Release(&snapshotStats);
+}
+
+LONGBOW_TEST_CASE(Global, rtaCommandSnapshotStatistics_Release)
+{
+    RtaCommandSnapshotStatistics *snapshotStats = rtaCommandSnapshotStatistics_Create();
+
+    RtaCommandSnapshotStatistics *second = rtaCommandSnapshotStatistics_Acquire(snapshotStats);
+    size_t secondRefCount = parcObject_GetReferenceCount(second);
+
+    rtaCommandSnapshotStatistics_Release(&second);
+    size_t thirdRefCount = parcObject_GetReferenceCount(snapshotStats);
+
+    assertTrue(thirdRefCount == secondRefCount - 1, "Wrong refcount after release, got %zu expected %zu", thirdRefCount, secondRefCount - 1);
+
+    rtaCommandSnapshotStatistics_Release(&snapshotStats);
+}
+
+LONGBOW_TEST_CASE(Global, rtaCommandSnapshotStatistics_SetSnapshot)
+{
+    RtaCommandSnapshotStatistics *snapshotStats = rtaCommandSnapshotStatistics_Create();
+
+    PARCJSON *snapshot = parcJSON_Create();
+    parcJSON_AddInteger(snapshot, "stackId", 1);
+    rtaCommandSnapshotStatistics_SetSnapshot(snapshotStats, snapshot);
+    assertTrue(rtaCommandSnapshotStatistics_IsComplete(snapshotStats), "Request should be complete after SetSnapshot");
+
+    uint64_t timeout = 0;
+    PARCJSON *test = rtaCommandSnapshotStatistics_WaitSnapshot(snapshotStats, &timeout);
+    assertTrue(test == snapshot, "Wrong snapshot, got %p expected %p", (void *) test, (void *) snapshot);
+
+    parcJSON_Release(&test);
+    parcJSON_Release(&snapshot);
+    rtaCommandSnapshotStatistics_Release(&snapshotStats);
+}
+
+LONGBOW_TEST_CASE(Global, rtaCommandSnapshotStatistics_WaitSnapshot_Timeout)
+{
+    RtaCommandSnapshotStatistics *snapshotStats = rtaCommandSnapshotStatistics_Create();
+
+    uint64_t timeout = 10000;
+    PARCJSON *test = rtaCommandSnapshotStatistics_WaitSnapshot(snapshotStats, &timeout);
+    assertNull(test, "Expected NULL when nobody answers");
+
+    rtaCommandSnapshotStatistics_Release(&snapshotStats);
+}
+
+static void *
+_answerLater(void *arg)
+{
+    RtaCommandSnapshotStatistics *snapshotStats = arg;
+    usleep(10000);
+
+    PARCJSON *snapshot = parcJSON_Create();
+    rtaCommandSnapshotStatistics_SetSnapshot(snapshotStats, snapshot);
+    parcJSON_Release(&snapshot);
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Global, rtaCommandSnapshotStatistics_WaitSnapshot_OtherThread)
+{
+    RtaCommandSnapshotStatistics *snapshotStats = rtaCommandSnapshotStatistics_Create();
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, _answerLater, snapshotStats);
+
+    PARCJSON *test = rtaCommandSnapshotStatistics_WaitSnapshot(snapshotStats, NULL);
+    assertNotNull(test, "Expected the snapshot from the other thread");
+
+    pthread_join(thread, NULL);
+    parcJSON_Release(&test);
+    rtaCommandSnapshotStatistics_Release(&snapshotStats);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(rta_CommandSnapshotStatistics);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
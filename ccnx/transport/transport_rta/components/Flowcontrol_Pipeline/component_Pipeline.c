@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+// Source code layout:
+// - component_Pipeline.c: the component wrapper and strategy selection
+// - pipeline_Cubic.c:     CUBIC congestion window
+// - pipeline_Bbr.c:       BBR-style congestion window
+//
+// Sessions, windows, in-order delivery and RTO come from Flowcontrol_Vegas.
+
+/**
+ * Component behavior
+ * ===================
+ * FC_PIPELINE behaves exactly like FC_VEGAS (see component_Vegas.c) on the wire and
+ * towards the API.  The only difference is how the congestion window is sized.  When a
+ * connection opens, the component reads the "algorithm" key of its connection
+ * configuration and gives every session on that connection the matching
+ * VegasCongestionControl:
+ *
+ *   { "FC_PIPELINE" : { "algorithm" : "cubic" | "bbr" | "vegas" } }
+ *
+ * "vegas" selects the built-in delay-based algorithm, so the same stack can compare all three.
+ */
+#include <config.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_EventQueue.h>
+
+#include <ccnx/transport/transport_rta/core/rta_Framework.h>
+#include <ccnx/transport/transport_rta/core/rta_ProtocolStack.h>
+#include <ccnx/transport/transport_rta/core/rta_Connection.h>
+#include <ccnx/transport/transport_rta/core/rta_Component.h>
+#include <ccnx/transport/transport_rta/components/component_Flowcontrol.h>
+#include <ccnx/transport/transport_rta/config/config_FlowControl_Pipeline.h>
+
+#include <ccnx/transport/transport_rta/components/Flowcontrol_Vegas/vegas_private.h>
+#include "pipeline_private.h"
+
+static int  component_Fc_Pipeline_Init(RtaProtocolStack *stack);
+static int  component_Fc_Pipeline_Opener(RtaConnection *conn);
+static void component_Fc_Pipeline_Upcall_Read(PARCEventQueue *, PARCEventType event, void *stack);
+static void component_Fc_Pipeline_Downcall_Read(PARCEventQueue *, PARCEventType event, void *stack);
+static int  component_Fc_Pipeline_Closer(RtaConnection *conn);
+static int  component_Fc_Pipeline_Release(RtaProtocolStack *stack);
+static void component_Fc_Pipeline_StateChange(RtaConnection *conn);
+
+RtaComponentOperations flow_pipeline_ops = {
+    .init          = component_Fc_Pipeline_Init,
+    .open          = component_Fc_Pipeline_Opener,
+    .upcallRead    = component_Fc_Pipeline_Upcall_Read,
+    .upcallEvent   = NULL,
+    .downcallRead  = component_Fc_Pipeline_Downcall_Read,
+    .downcallEvent = NULL,
+    .close         = component_Fc_Pipeline_Closer,
+    .release       = component_Fc_Pipeline_Release,
+    .stateChange   = component_Fc_Pipeline_StateChange
+};
+
+static const VegasCongestionControl *_pipelineAlgorithms[] = {
+    &pipelineCubic_CongestionControl,
+    &pipelineBbr_CongestionControl,
+    NULL
+};
+
+const VegasCongestionControl *
+pipeline_LookupCongestionControl(const char *name)
+{
+    assertNotNull(name, "Parameter name must be non-null");
+
+    if (strcmp(name, pipelineFlowController_AlgorithmVegas) == 0) {
+        return NULL;
+    }
+
+    for (int i = 0; _pipelineAlgorithms[i] != NULL; i++) {
+        if (strcmp(name, _pipelineAlgorithms[i]->name) == 0) {
+            return _pipelineAlgorithms[i];
+        }
+    }
+
+    // the opener only passes names pipelineFlowController_IsAlgorithm() accepts
+    return NULL;
+}
+
+static int
+component_Fc_Pipeline_Init(RtaProtocolStack *stack)
+{
+    // we don't do any stack-wide initialization
+    return 0;
+}
+
+static int
+component_Fc_Pipeline_Opener(RtaConnection *conn)
+{
+    const char *algorithm = pipelineFlowController_GetAlgorithmFromConfig(rtaConnection_GetParameters(conn));
+
+    // A hand-written configuration may misspell the name.  Trapping here would take down
+    // the Framework thread and every other connection, so fall back to Vegas.
+    if (!pipelineFlowController_IsAlgorithm(algorithm)) {
+        RtaLogger *logger = rtaFramework_GetLogger(rtaConnection_GetFramework(conn));
+        if (rtaLogger_IsLoggable(logger, RtaLoggerFacility_Flowcontrol, PARCLogLevel_Warning)) {
+            rtaLogger_Log(logger, RtaLoggerFacility_Flowcontrol, PARCLogLevel_Warning, __func__,
+                          "connection %u unknown %s algorithm '%s', using '%s'",
+                          rtaConnection_GetConnectionId(conn), pipelineFlowController_GetName(), algorithm,
+                          pipelineFlowController_AlgorithmVegas);
+        }
+        algorithm = pipelineFlowController_AlgorithmVegas;
+    }
+
+    return vegasComponent_Open(conn, FC_PIPELINE, pipeline_LookupCongestionControl(algorithm));
+}
+
+static void
+component_Fc_Pipeline_Upcall_Read(PARCEventQueue *in, PARCEventType event, void *stack)
+{
+    vegasComponent_UpcallRead(in, FC_PIPELINE);
+}
+
+static void
+component_Fc_Pipeline_Downcall_Read(PARCEventQueue *in, PARCEventType event, void *stack)
+{
+    vegasComponent_DowncallRead(in, (RtaProtocolStack *) stack, FC_PIPELINE);
+}
+
+static int
+component_Fc_Pipeline_Closer(RtaConnection *conn)
+{
+    return vegasComponent_Close(conn, FC_PIPELINE);
+}
+
+static int
+component_Fc_Pipeline_Release(RtaProtocolStack *stack)
+{
+    // no stack-wide memory
+    return 0;
+}
+
+static void
+component_Fc_Pipeline_StateChange(RtaConnection *conn)
+{
+    vegasComponent_StateChange(conn, FC_PIPELINE);
+}
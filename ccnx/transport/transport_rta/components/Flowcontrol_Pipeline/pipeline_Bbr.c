@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * BBR-style congestion window for the FC_PIPELINE flow controller.
+ *
+ * The window is `gain * btlBw * rtProp`, where btlBw is the windowed maximum of the
+ * delivery rate measured each round and rtProp is the windowed minimum RTT.  Only the
+ * window is modeled; the session sends as the window opens.
+ *
+ * Rates are in Interests per tick and times are in framework ticks.
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <stdio.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+
+#include <ccnx/transport/transport_rta/core/rta_Framework_Services.h>
+#include <ccnx/transport/transport_rta/components/Flowcontrol_Pipeline/pipeline_private.h>
+
+#define BBR_MIN_CWND 4.0
+
+// 2/ln(2), the smallest gain that doubles delivery each round
+#define BBR_HIGH_GAIN 2.885
+
+// Rounds kept in the btlBw max filter
+#define BBR_BW_WINDOW 10
+
+// Rounds without 25% growth before STARTUP ends
+#define BBR_FULL_BW_ROUNDS 3
+#define BBR_FULL_BW_GROWTH 1.25
+
+// rtProp expires after 10 seconds and PROBE_RTT lasts 200 msec
+#define BBR_RTPROP_EXPIRY_USEC 10000000
+#define BBR_PROBE_RTT_USEC     200000
+
+typedef enum {
+    BbrMode_Startup,
+    BbrMode_Drain,
+    BbrMode_ProbeBw,
+    BbrMode_ProbeRtt
+} BbrMode;
+
+static const double _bbrProbeBwGains[] = { 1.25, 0.75, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+#define BBR_CYCLE_LENGTH (sizeof(_bbrProbeBwGains) / sizeof(_bbrProbeBwGains[0]))
+
+typedef struct pipeline_bbr {
+    BbrMode mode;
+    double cwnd;
+    double gain;
+
+    // Delivery rate samples, one per round, in Interests per tick
+    double bwSamples[BBR_BW_WINDOW];
+    unsigned roundCount;
+    double btlBw;
+
+    ticks rtProp;
+    ticks rtPropStamp;
+
+    // Objects delivered since the start of the current round
+    uint64_t delivered;
+    ticks roundStart;
+
+    double fullBw;
+    unsigned fullBwRounds;
+
+    unsigned cycleIndex;
+    ticks probeRttDone;
+    double priorCwnd;
+
+    ticks rtPropExpiry;
+    ticks probeRttDuration;
+} PipelineBbr;
+
+static double
+_pipelineBbr_Bdp(const PipelineBbr *bbr)
+{
+    return bbr->btlBw * (double) bbr->rtProp;
+}
+
+static bool
+_pipelineBbr_HasModel(const PipelineBbr *bbr)
+{
+    return bbr->btlBw > 0.0 && bbr->rtProp > 0;
+}
+
+static void
+_pipelineBbr_SetCwnd(PipelineBbr *bbr)
+{
+    if (bbr->mode == BbrMode_ProbeRtt) {
+        bbr->cwnd = BBR_MIN_CWND;
+        return;
+    }
+
+    if (_pipelineBbr_HasModel(bbr)) {
+        double target = bbr->gain * _pipelineBbr_Bdp(bbr);
+        bbr->cwnd = target < BBR_MIN_CWND ? BBR_MIN_CWND : target;
+    }
+}
+
+static void *
+_pipelineBbr_Create(ticks now, uint32_t initialCwnd)
+{
+    PipelineBbr *bbr = parcMemory_AllocateAndClear(sizeof(PipelineBbr));
+    assertNotNull(bbr, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(PipelineBbr));
+
+    bbr->mode = BbrMode_Startup;
+    bbr->gain = BBR_HIGH_GAIN;
+    bbr->cwnd = initialCwnd < BBR_MIN_CWND ? BBR_MIN_CWND : initialCwnd;
+    bbr->roundStart = now;
+    bbr->rtPropExpiry = rtaFramework_UsecToTicks(BBR_RTPROP_EXPIRY_USEC);
+    bbr->probeRttDuration = rtaFramework_UsecToTicks(BBR_PROBE_RTT_USEC);
+    return bbr;
+}
+
+static void
+_pipelineBbr_Destroy(void **statePtr)
+{
+    assertNotNull(statePtr, "Parameter statePtr must be non-null");
+    parcMemory_Deallocate(statePtr);
+}
+
+static void
+_pipelineBbr_OnAck(void *state, const VegasCongestionSample *sample)
+{
+    PipelineBbr *bbr = state;
+
+    bbr->delivered++;
+
+    if (sample->firstRequest && (bbr->rtProp == 0 || sample->rtt <= bbr->rtProp)) {
+        bbr->rtProp = sample->rtt;
+        bbr->rtPropStamp = sample->now;
+    }
+
+    if (bbr->mode != BbrMode_ProbeRtt && !_pipelineBbr_HasModel(bbr)) {
+        // No estimate yet, grow like slow start
+        bbr->cwnd += 1.0;
+    }
+}
+
+static void
+_pipelineBbr_UpdateBtlBw(PipelineBbr *bbr, ticks now)
+{
+    ticks interval = now - bbr->roundStart;
+    if (interval == 0) {
+        return;
+    }
+
+    bbr->bwSamples[bbr->roundCount % BBR_BW_WINDOW] = (double) bbr->delivered / (double) interval;
+    bbr->roundCount++;
+    bbr->delivered = 0;
+    bbr->roundStart = now;
+
+    bbr->btlBw = 0.0;
+    for (int i = 0; i < BBR_BW_WINDOW; i++) {
+        if (bbr->bwSamples[i] > bbr->btlBw) {
+            bbr->btlBw = bbr->bwSamples[i];
+        }
+    }
+}
+
+static void
+_pipelineBbr_CheckFullBandwidth(PipelineBbr *bbr)
+{
+    if (bbr->btlBw >= bbr->fullBw * BBR_FULL_BW_GROWTH) {
+        bbr->fullBw = bbr->btlBw;
+        bbr->fullBwRounds = 0;
+    } else {
+        bbr->fullBwRounds++;
+    }
+}
+
+static void
+_pipelineBbr_OnRoundTrip(void *state, ticks now, ticks srtt)
+{
+    PipelineBbr *bbr = state;
+
+    _pipelineBbr_UpdateBtlBw(bbr, now);
+
+    switch (bbr->mode) {
+        case BbrMode_Startup:
+            _pipelineBbr_CheckFullBandwidth(bbr);
+            if (bbr->fullBwRounds >= BBR_FULL_BW_ROUNDS) {
+                bbr->mode = BbrMode_Drain;
+                bbr->gain = 1.0 / BBR_HIGH_GAIN;
+            }
+            break;
+
+        case BbrMode_Drain:
+            // Drain lasts one round, which empties the queue built in STARTUP
+            bbr->mode = BbrMode_ProbeBw;
+            bbr->cycleIndex = 0;
+            bbr->gain = _bbrProbeBwGains[0];
+            break;
+
+        case BbrMode_ProbeBw:
+            bbr->cycleIndex = (bbr->cycleIndex + 1) % BBR_CYCLE_LENGTH;
+            bbr->gain = _bbrProbeBwGains[bbr->cycleIndex];
+            break;
+
+        case BbrMode_ProbeRtt:
+            if (now >= bbr->probeRttDone) {
+                bbr->rtPropStamp = now;
+                bbr->mode = bbr->fullBwRounds >= BBR_FULL_BW_ROUNDS ? BbrMode_ProbeBw : BbrMode_Startup;
+                bbr->gain = bbr->mode == BbrMode_ProbeBw ? _bbrProbeBwGains[bbr->cycleIndex] : BBR_HIGH_GAIN;
+                bbr->cwnd = bbr->priorCwnd;
+            }
+            break;
+
+        default:
+            trapIllegalValue(bbr->mode, "Unknown BBR mode %d", bbr->mode);
+    }
+
+    if (bbr->mode != BbrMode_ProbeRtt && bbr->rtProp > 0 && now - bbr->rtPropStamp > bbr->rtPropExpiry) {
+        // The min RTT is stale: drain the pipe to measure it again.  The next
+        // first-request sample sets the new minimum.
+        bbr->mode = BbrMode_ProbeRtt;
+        bbr->priorCwnd = bbr->cwnd;
+        bbr->probeRttDone = now + bbr->probeRttDuration;
+        bbr->rtProp = 0;
+    }
+
+    _pipelineBbr_SetCwnd(bbr);
+}
+
+static void
+_pipelineBbr_OnLoss(void *state, ticks now)
+{
+    // BBR does not treat loss as a congestion signal
+}
+
+static void
+_pipelineBbr_OnTimeout(void *state, ticks now)
+{
+    PipelineBbr *bbr = state;
+    bbr->cwnd = BBR_MIN_CWND;
+}
+
+static uint32_t
+_pipelineBbr_GetCwnd(const void *state)
+{
+    const PipelineBbr *bbr = state;
+    return (uint32_t) bbr->cwnd;
+}
+
+const VegasCongestionControl pipelineBbr_CongestionControl = {
+    .name        = "bbr",
+    .create      = _pipelineBbr_Create,
+    .destroy     = _pipelineBbr_Destroy,
+    .onAck       = _pipelineBbr_OnAck,
+    .onLoss      = _pipelineBbr_OnLoss,
+    .onTimeout   = _pipelineBbr_OnTimeout,
+    .onRoundTrip = _pipelineBbr_OnRoundTrip,
+    .getCwnd     = _pipelineBbr_GetCwnd
+};
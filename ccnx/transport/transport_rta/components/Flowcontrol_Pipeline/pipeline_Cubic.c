@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * CUBIC congestion window (RFC 8312) for the FC_PIPELINE flow controller.
+ *
+ * The window is in Interests and time is in framework ticks (1 msec).  The cubic function
+ * is evaluated in seconds, as in the RFC.
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <math.h>
+#include <stdio.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+
+#include <ccnx/transport/transport_rta/core/rta_Framework_Services.h>
+#include <ccnx/transport/transport_rta/components/Flowcontrol_Pipeline/pipeline_private.h>
+
+#define CUBIC_BETA 0.7
+#define CUBIC_C    0.4
+#define CUBIC_MIN_CWND 2.0
+
+typedef struct pipeline_cubic {
+    double cwnd;
+    double ssthresh;
+
+    // The window just before the last reduction
+    double wMax;
+
+    // Time of the last reduction, 0 means no congestion epoch started
+    ticks epochStart;
+
+    // Seconds until the cubic function reaches wMax
+    double k;
+
+    // The TCP-friendly (Reno) window estimate
+    double wEst;
+
+    // Smallest RTT seen, in ticks, used for the TCP-friendly region
+    ticks minRtt;
+} PipelineCubic;
+
+static double
+_seconds(ticks t)
+{
+    return (double) rtaFramework_TicksToUsec(t) / 1000000.0;
+}
+
+static void *
+_pipelineCubic_Create(ticks now, uint32_t initialCwnd)
+{
+    PipelineCubic *cubic = parcMemory_AllocateAndClear(sizeof(PipelineCubic));
+    assertNotNull(cubic, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(PipelineCubic));
+
+    cubic->cwnd = initialCwnd < CUBIC_MIN_CWND ? CUBIC_MIN_CWND : initialCwnd;
+    cubic->ssthresh = HUGE_VAL;
+    return cubic;
+}
+
+static void
+_pipelineCubic_Destroy(void **statePtr)
+{
+    assertNotNull(statePtr, "Parameter statePtr must be non-null");
+    parcMemory_Deallocate(statePtr);
+}
+
+static void
+_pipelineCubic_OnAck(void *state, const VegasCongestionSample *sample)
+{
+    PipelineCubic *cubic = state;
+
+    if (sample->firstRequest && (cubic->minRtt == 0 || sample->rtt < cubic->minRtt)) {
+        cubic->minRtt = sample->rtt;
+    }
+
+    if (cubic->cwnd < cubic->ssthresh) {
+        cubic->cwnd += 1.0;
+        return;
+    }
+
+    if (cubic->epochStart == 0) {
+        // First congestion avoidance after slow start: the current window is the plateau
+        cubic->epochStart = sample->now;
+        if (cubic->wMax < cubic->cwnd) {
+            cubic->k = 0.0;
+            cubic->wMax = cubic->cwnd;
+        } else {
+            cubic->k = cbrt(cubic->wMax * (1.0 - CUBIC_BETA) / CUBIC_C);
+        }
+        cubic->wEst = cubic->cwnd;
+    }
+
+    // Aim for the window the cubic function will have one RTT from now
+    double t = _seconds(sample->now - cubic->epochStart) + _seconds(cubic->minRtt);
+    double target = CUBIC_C * (t - cubic->k) * (t - cubic->k) * (t - cubic->k) + cubic->wMax;
+
+    // TCP-friendly region (RFC 8312 section 4.2), per-ack form
+    cubic->wEst += (3.0 * (1.0 - CUBIC_BETA) / (1.0 + CUBIC_BETA)) / cubic->cwnd;
+    if (cubic->wEst > target) {
+        target = cubic->wEst;
+    }
+
+    if (target > cubic->cwnd) {
+        cubic->cwnd += (target - cubic->cwnd) / cubic->cwnd;
+    } else {
+        // Plateau, grow very slowly (1 per 100 RTTs)
+        cubic->cwnd += 0.01 / cubic->cwnd;
+    }
+}
+
+static void
+_pipelineCubic_OnLoss(void *state, ticks now)
+{
+    PipelineCubic *cubic = state;
+
+    // Fast convergence: release bandwidth faster if the plateau is falling
+    if (cubic->cwnd < cubic->wMax) {
+        cubic->wMax = cubic->cwnd * (1.0 + CUBIC_BETA) / 2.0;
+    } else {
+        cubic->wMax = cubic->cwnd;
+    }
+
+    cubic->cwnd *= CUBIC_BETA;
+    if (cubic->cwnd < CUBIC_MIN_CWND) {
+        cubic->cwnd = CUBIC_MIN_CWND;
+    }
+    cubic->ssthresh = cubic->cwnd;
+    cubic->epochStart = 0;
+}
+
+static void
+_pipelineCubic_OnTimeout(void *state, ticks now)
+{
+    PipelineCubic *cubic = state;
+    _pipelineCubic_OnLoss(cubic, now);
+    cubic->cwnd = CUBIC_MIN_CWND;
+}
+
+static void
+_pipelineCubic_OnRoundTrip(void *state, ticks now, ticks srtt)
+{
+    // CUBIC is driven entirely by acks and losses
+}
+
+static uint32_t
+_pipelineCubic_GetCwnd(const void *state)
+{
+    const PipelineCubic *cubic = state;
+    return (uint32_t) cubic->cwnd;
+}
+
+const VegasCongestionControl pipelineCubic_CongestionControl = {
+    .name        = "cubic",
+    .create      = _pipelineCubic_Create,
+    .destroy     = _pipelineCubic_Destroy,
+    .onAck       = _pipelineCubic_OnAck,
+    .onLoss      = _pipelineCubic_OnLoss,
+    .onTimeout   = _pipelineCubic_OnTimeout,
+    .onRoundTrip = _pipelineCubic_OnRoundTrip,
+    .getCwnd     = _pipelineCubic_GetCwnd
+};
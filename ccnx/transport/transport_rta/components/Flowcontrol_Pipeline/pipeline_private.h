@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file pipeline_private.h
+ * @brief The congestion control strategies available to the FC_PIPELINE component
+ *
+ * FC_PIPELINE runs the same session machinery as FC_VEGAS (see vegas_Session.c), but
+ * hands window decisions to one of these strategies.  The strategy is selected per
+ * connection with pipelineFlowController_ConnectionConfig().
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef Libccnx_pipeline_private_h
+#define Libccnx_pipeline_private_h
+
+#include <ccnx/transport/transport_rta/components/Flowcontrol_Vegas/vegas_CongestionControl.h>
+
+/**
+ * A loss-based window that grows as a cubic function of the time since the last loss.
+ *
+ * Follows RFC 8312: multiplicative decrease of 0.7, C = 0.4, fast convergence, and a
+ * TCP-friendly region.  Below ssthresh the window grows by one Interest per Content Object.
+ */
+extern const VegasCongestionControl pipelineCubic_CongestionControl;
+
+/**
+ * A model-based window sized from the estimated bottleneck bandwidth and minimum RTT.
+ *
+ * The window is a gain times the bandwidth-delay product.  The gain cycles through
+ * STARTUP, DRAIN, PROBE_BW and PROBE_RTT phases as in BBR.  Because Interests are paced
+ * by the window and not by a pacing timer, only the window side of BBR is modeled.
+ */
+extern const VegasCongestionControl pipelineBbr_CongestionControl;
+
+/**
+ * Looks up a strategy by its configuration name
+ *
+ * @param [in] name An algorithm name, e.g. pipelineFlowController_AlgorithmCubic
+ *
+ * @return NULL The name is "vegas", which is the session's built-in algorithm, or not a
+ *              strategy (see pipelineFlowController_IsAlgorithm())
+ * @return non-null The strategy
+ *
+ * Example:
+ * @code
+ * {
+ *     const VegasCongestionControl *cc = pipeline_LookupCongestionControl("bbr");
+ * }
+ * @endcode
+ */
+const VegasCongestionControl *pipeline_LookupCongestionControl(const char *name);
+#endif // Libccnx_pipeline_private_h
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include "../pipeline_Bbr.c"
+
+#include <LongBow/unit-test.h>
+#include <parc/algol/parc_SafeMemory.h>
+
+LONGBOW_TEST_RUNNER(pipeline_Bbr)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+LONGBOW_TEST_RUNNER_SETUP(pipeline_Bbr)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_RUNNER_TEARDOWN(pipeline_Bbr)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, pipelineBbr_Create_Destroy);
+    LONGBOW_RUN_TEST_CASE(Global, pipelineBbr_OnAck_NoModel);
+    LONGBOW_RUN_TEST_CASE(Global, pipelineBbr_OnAck_MinRtt);
+    LONGBOW_RUN_TEST_CASE(Global, pipelineBbr_OnLoss);
+    LONGBOW_RUN_TEST_CASE(Global, pipelineBbr_OnTimeout);
+    LONGBOW_RUN_TEST_CASE(Global, pipelineBbr_ConvergesToBdp);
+    LONGBOW_RUN_TEST_CASE(Global, pipelineBbr_ProbeRtt);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static void
+_ack(const VegasCongestionControl *cc, void *state, ticks now, ticks rtt)
+{
+    VegasCongestionSample sample = { .now = now, .rtt = rtt, .bytes = 1000, .inFlight = cc->getCwnd(state), .firstRequest = true };
+    cc->onAck(state, &sample);
+}
+
+/**
+ * Runs `rounds` round trips over a path with a bottleneck of 1 object per tick
+ * and a base RTT of `baseRtt`.  A window above the BDP adds queueing delay.
+ */
+static ticks
+_runPath(const VegasCongestionControl *cc, void *state, ticks now, ticks baseRtt, int rounds)
+{
+    for (int round = 0; round < rounds; round++) {
+        uint32_t cwnd = cc->getCwnd(state);
+        ticks rtt = baseRtt + (cwnd > baseRtt ? cwnd - baseRtt : 0);
+        for (uint32_t i = 0; i < cwnd; i++) {
+            _ack(cc, state, now, rtt);
+        }
+        now += rtt;
+        cc->onRoundTrip(state, now, rtt);
+    }
+    return now;
+}
+
+LONGBOW_TEST_CASE(Global, pipelineBbr_Create_Destroy)
+{
+    const VegasCongestionControl *cc = &pipelineBbr_CongestionControl;
+    void *state = cc->create(1, 2);
+    PipelineBbr *bbr = state;
+
+    assertTrue(cc->getCwnd(state) == 4, "Initial cwnd should be at least the minimum, got %u expected 4", cc->getCwnd(state));
+    assertTrue(bbr->mode == BbrMode_Startup, "Should begin in STARTUP, got %d", bbr->mode);
+    cc->destroy(&state);
+    assertNull(state, "destroy did not null the pointer");
+}
+
+LONGBOW_TEST_CASE(Global, pipelineBbr_OnAck_NoModel)
+{
+    const VegasCongestionControl *cc = &pipelineBbr_CongestionControl;
+    void *state = cc->create(1, 4);
+
+    for (int i = 0; i < 6; i++) {
+        _ack(cc, state, 10, 5);
+    }
+
+    assertTrue(cc->getCwnd(state) == 10, "Without a model each ack should add one, got %u expected 10", cc->getCwnd(state));
+    cc->destroy(&state);
+}
+
+LONGBOW_TEST_CASE(Global, pipelineBbr_OnAck_MinRtt)
+{
+    const VegasCongestionControl *cc = &pipelineBbr_CongestionControl;
+    void *state = cc->create(1, 4);
+    PipelineBbr *bbr = state;
+
+    _ack(cc, state, 10, 20);
+    _ack(cc, state, 11, 8);
+    _ack(cc, state, 12, 30);
+
+    VegasCongestionSample ambiguous = { .now = 13, .rtt = 2, .bytes = 0, .inFlight = 4, .firstRequest = false };
+    cc->onAck(state, &ambiguous);
+
+    assertTrue(bbr->rtProp == 8, "Wrong rtProp, got %" PRIu64 " expected 8", bbr->rtProp);
+    assertTrue(bbr->rtPropStamp == 11, "Wrong rtPropStamp, got %" PRIu64 " expected 11", bbr->rtPropStamp);
+    cc->destroy(&state);
+}
+
+LONGBOW_TEST_CASE(Global, pipelineBbr_OnLoss)
+{
+    const VegasCongestionControl *cc = &pipelineBbr_CongestionControl;
+    void *state = cc->create(1, 40);
+
+    cc->onLoss(state, 10);
+    assertTrue(cc->getCwnd(state) == 40, "Loss should not change the window, got %u expected 40", cc->getCwnd(state));
+    cc->destroy(&state);
+}
+
+LONGBOW_TEST_CASE(Global, pipelineBbr_OnTimeout)
+{
+    const VegasCongestionControl *cc = &pipelineBbr_CongestionControl;
+    void *state = cc->create(1, 40);
+
+    cc->onTimeout(state, 10);
+    assertTrue(cc->getCwnd(state) == 4, "Timeout should set the minimum window, got %u expected 4", cc->getCwnd(state));
+    cc->destroy(&state);
+}
+
+/**
+ * With a BDP of 50 objects, the window should leave STARTUP and settle within the PROBE_BW gains of the BDP
+ */
+LONGBOW_TEST_CASE(Global, pipelineBbr_ConvergesToBdp)
+{
+    const VegasCongestionControl *cc = &pipelineBbr_CongestionControl;
+    void *state = cc->create(1, 2);
+    PipelineBbr *bbr = state;
+
+    _runPath(cc, state, 1, 50, 60);
+
+    assertTrue(bbr->mode == BbrMode_ProbeBw, "Should be in PROBE_BW, got %d", bbr->mode);
+    assertTrue(cc->getCwnd(state) >= 37 && cc->getCwnd(state) <= 63, "Window should be near the BDP of 50, got %u", cc->getCwnd(state));
+    cc->destroy(&state);
+}
+
+LONGBOW_TEST_CASE(Global, pipelineBbr_ProbeRtt)
+{
+    const VegasCongestionControl *cc = &pipelineBbr_CongestionControl;
+    void *state = cc->create(1, 2);
+    PipelineBbr *bbr = state;
+
+    ticks now = _runPath(cc, state, 1, 50, 30);
+
+    // Make the min RTT stale
+    bbr->rtPropStamp = 0;
+    now += bbr->rtPropExpiry + 1;
+    cc->onRoundTrip(state, now, 50);
+
+    assertTrue(bbr->mode == BbrMode_ProbeRtt, "Should be in PROBE_RTT, got %d", bbr->mode);
+    assertTrue(cc->getCwnd(state) == 4, "PROBE_RTT window should be 4, got %u", cc->getCwnd(state));
+
+    now += bbr->probeRttDuration;
+    _ack(cc, state, now, 50);
+    cc->onRoundTrip(state, now, 50);
+    assertTrue(bbr->mode == BbrMode_ProbeBw, "Should return to PROBE_BW, got %d", bbr->mode);
+    cc->destroy(&state);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(pipeline_Bbr);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include "../pipeline_Cubic.c"
+
+#include <LongBow/unit-test.h>
+#include <parc/algol/parc_SafeMemory.h>
+
+LONGBOW_TEST_RUNNER(pipeline_Cubic)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+LONGBOW_TEST_RUNNER_SETUP(pipeline_Cubic)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_RUNNER_TEARDOWN(pipeline_Cubic)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, pipelineCubic_Create_Destroy);
+    LONGBOW_RUN_TEST_CASE(Global, pipelineCubic_OnAck_SlowStart);
+    LONGBOW_RUN_TEST_CASE(Global, pipelineCubic_OnLoss);
+    LONGBOW_RUN_TEST_CASE(Global, pipelineCubic_OnLoss_FastConvergence);
+    LONGBOW_RUN_TEST_CASE(Global, pipelineCubic_OnTimeout);
+    LONGBOW_RUN_TEST_CASE(Global, pipelineCubic_RecoversToWMax);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static void
+_ack(const VegasCongestionControl *cc, void *state, ticks now, ticks rtt)
+{
+    VegasCongestionSample sample = { .now = now, .rtt = rtt, .bytes = 1000, .inFlight = cc->getCwnd(state), .firstRequest = true };
+    cc->onAck(state, &sample);
+}
+
+LONGBOW_TEST_CASE(Global, pipelineCubic_Create_Destroy)
+{
+    const VegasCongestionControl *cc = &pipelineCubic_CongestionControl;
+    void *state = cc->create(1, 10);
+    assertTrue(cc->getCwnd(state) == 10, "Wrong initial cwnd, got %u expected 10", cc->getCwnd(state));
+    cc->destroy(&state);
+    assertNull(state, "destroy did not null the pointer");
+}
+
+LONGBOW_TEST_CASE(Global, pipelineCubic_OnAck_SlowStart)
+{
+    const VegasCongestionControl *cc = &pipelineCubic_CongestionControl;
+    void *state = cc->create(1, 2);
+
+    for (int i = 0; i < 8; i++) {
+        _ack(cc, state, 10, 5);
+    }
+
+    assertTrue(cc->getCwnd(state) == 10, "Slow start should add one per ack, got %u expected 10", cc->getCwnd(state));
+    cc->destroy(&state);
+}
+
+LONGBOW_TEST_CASE(Global, pipelineCubic_OnLoss)
+{
+    const VegasCongestionControl *cc = &pipelineCubic_CongestionControl;
+    void *state = cc->create(1, 100);
+    PipelineCubic *cubic = state;
+
+    cc->onLoss(state, 10);
+    assertTrue(cc->getCwnd(state) == 70, "Loss should multiply by beta, got %u expected 70", cc->getCwnd(state));
+    assertTrue(cubic->wMax == 100.0, "wMax should be the window before the loss, got %f", cubic->wMax);
+    assertTrue(cubic->ssthresh == 70.0, "ssthresh should be the reduced window, got %f", cubic->ssthresh);
+    cc->destroy(&state);
+}
+
+LONGBOW_TEST_CASE(Global, pipelineCubic_OnLoss_FastConvergence)
+{
+    const VegasCongestionControl *cc = &pipelineCubic_CongestionControl;
+    void *state = cc->create(1, 100);
+    PipelineCubic *cubic = state;
+
+    cc->onLoss(state, 10);
+    cc->onLoss(state, 20);
+
+    // second loss is below the previous plateau, so wMax = 70 * (1 + 0.7) / 2
+    assertTrue(cubic->wMax > 59.4 && cubic->wMax < 59.6, "Fast convergence wrong, got wMax %f expected 59.5", cubic->wMax);
+    cc->destroy(&state);
+}
+
+LONGBOW_TEST_CASE(Global, pipelineCubic_OnTimeout)
+{
+    const VegasCongestionControl *cc = &pipelineCubic_CongestionControl;
+    void *state = cc->create(1, 100);
+
+    cc->onTimeout(state, 10);
+    assertTrue(cc->getCwnd(state) == 2, "Timeout should collapse the window, got %u expected 2", cc->getCwnd(state));
+    cc->destroy(&state);
+}
+
+/**
+ * After a loss, the cubic function should bring the window back to wMax after about K seconds
+ */
+LONGBOW_TEST_CASE(Global, pipelineCubic_RecoversToWMax)
+{
+    const VegasCongestionControl *cc = &pipelineCubic_CongestionControl;
+    void *state = cc->create(1, 100);
+    PipelineCubic *cubic = state;
+
+    cc->onLoss(state, 1);
+
+    // K = cbrt(100 * 0.3 / 0.4) = 4.2 seconds, run for 5 seconds at a 50 msec RTT
+    ticks now = 1;
+    for (int round = 0; round < 100; round++) {
+        uint32_t cwnd = cc->getCwnd(state);
+        for (uint32_t i = 0; i < cwnd; i++) {
+            _ack(cc, state, now, 50);
+        }
+        now += 50;
+    }
+
+    assertTrue(cubic->k > 4.1 && cubic->k < 4.3, "Wrong K, got %f expected 4.2", cubic->k);
+    assertTrue(cc->getCwnd(state) >= 100, "Window did not recover to wMax, got %u", cc->getCwnd(state));
+    cc->destroy(&state);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(pipeline_Cubic);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
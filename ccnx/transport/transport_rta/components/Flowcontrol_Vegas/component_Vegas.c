@@ -196,6 +196,7 @@
 #include <ccnx/transport/transport_rta/core/rta_Connection.h>
 #include <ccnx/transport/transport_rta/core/rta_Component.h>
 #include <ccnx/transport/transport_rta/components/component_Flowcontrol.h>
+#include <ccnx/transport/transport_rta/config/config_FlowControl_Vegas.h>
 #include <ccnx/transport/test_tools/traffic_tools.h>
 
 #include <ccnx/api/control/controlPlaneInterface.h>
@@ -229,6 +230,16 @@ struct vegas_connection_state {
     RtaConnection           *parent_connection;
     RtaFramework            *parent_framework;
 
+    // The component this state belongs to (FC_VEGAS or FC_PIPELINE)
+    RtaComponents component;
+
+    // NULL for the built-in Vegas algorithm
+    const VegasCongestionControl *congestionControl;
+
+    // Spread each session's Interests over its SRTT
+    bool pacing;
+    FlowControlPacingStats pacingStats;
+
     TAILQ_HEAD(, fc_session_holder)  sessions_head;
 };
 
@@ -259,14 +270,14 @@ RtaComponentOperations flow_vegas_ops = {
 
 // ======
 // Session related functions
-static int vegas_HandleInterest(RtaConnection *conn, TransportMessage *tm);
+static int vegas_HandleInterest(RtaConnection *conn, RtaComponents component, TransportMessage *tm);
 static FcSessionHolder *vegas_LookupSession(VegasConnectionState *fc, TransportMessage *tm);
 static FcSessionHolder *vegas_LookupSessionByName(VegasConnectionState *fc, CCNxName *name);
 
 static FcSessionHolder *vegas_CreateSessionHolder(VegasConnectionState *fc, RtaConnection *conn,
                                                   CCNxName *basename, uint64_t name_hash);
 
-static bool vegas_HandleControl(RtaConnection *conn, CCNxTlvDictionary *controlDictionary, PARCEventQueue *outputQueue);
+static bool vegas_HandleControl(RtaConnection *conn, RtaComponents component, CCNxTlvDictionary *controlDictionary, PARCEventQueue *outputQueue);
 
 // ================================================
 
@@ -279,17 +290,26 @@ component_Fc_Vegas_Init(RtaProtocolStack *stack)
 
 static int
 component_Fc_Vegas_Opener(RtaConnection *conn)
+{
+    return vegasComponent_Open(conn, FC_VEGAS, NULL);
+}
+
+int
+vegasComponent_Open(RtaConnection *conn, RtaComponents component, const VegasCongestionControl *congestionControl)
 {
     struct vegas_connection_state *fcConnState = parcMemory_AllocateAndClear(sizeof(struct vegas_connection_state));
     assertNotNull(fcConnState, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(struct vegas_connection_state));
 
     fcConnState->parent_connection = rtaConnection_Copy(conn);
     fcConnState->parent_framework = rtaProtocolStack_GetFramework(rtaConnection_GetStack(conn));
+    fcConnState->component = component;
+    fcConnState->congestionControl = congestionControl;
+    fcConnState->pacing = vegasFlowController_GetPacingFromConfig(rtaConnection_GetParameters(conn), RtaComponentNames[component]);
 
     TAILQ_INIT(&fcConnState->sessions_head);
 
-    rtaConnection_SetPrivateData(conn, FC_VEGAS, fcConnState);
-    rtaComponentStats_Increment(rtaConnection_GetStats(conn, FC_VEGAS), STATS_OPENS);
+    rtaConnection_SetPrivateData(conn, component, fcConnState);
+    rtaComponentStats_Increment(rtaConnection_GetStats(conn, component), STATS_OPENS);
 
     return 0;
 }
@@ -302,6 +322,12 @@ component_Fc_Vegas_Opener(RtaConnection *conn)
  */
 static void
 component_Fc_Vegas_Upcall_Read(PARCEventQueue *in, PARCEventType event, void *stack_ptr)
+{
+    vegasComponent_UpcallRead(in, FC_VEGAS);
+}
+
+void
+vegasComponent_UpcallRead(PARCEventQueue *in, RtaComponents component)
 {
     TransportMessage *tm;
 
@@ -309,12 +335,12 @@ component_Fc_Vegas_Upcall_Read(PARCEventQueue *in, PARCEventType event, void *st
         struct timeval delay = transportMessage_GetDelay(tm);
 
         RtaConnection *conn = rtaConnection_GetFromTransport(tm);
-        RtaComponentStats *stats = rtaConnection_GetStats(conn, FC_VEGAS);
+        RtaComponentStats *stats = rtaConnection_GetStats(conn, component);
 
         rtaComponentStats_Increment(stats, STATS_UPCALL_IN);
 
         if (transportMessage_IsControl(tm)) {
-            PARCEventQueue *out = rtaComponent_GetOutputQueue(conn, FC_VEGAS, RTA_UP);
+            PARCEventQueue *out = rtaComponent_GetOutputQueue(conn, component, RTA_UP);
 
             if (rtaComponent_PutMessage(out, tm)) {
                 rtaComponentStats_Increment(stats, STATS_UPCALL_OUT);
@@ -323,7 +349,7 @@ component_Fc_Vegas_Upcall_Read(PARCEventQueue *in, PARCEventType event, void *st
             }
         } else if (transportMessage_IsContentObject(tm)) {
             // this takes ownership of the transport message
-            VegasConnectionState *fc = rtaConnection_GetPrivateData(conn, FC_VEGAS);
+            VegasConnectionState *fc = rtaConnection_GetPrivateData(conn, component);
             FcSessionHolder *holder = vegas_LookupSession(fc, tm);
 
             // it's quite possible that we get content objects for sessions that
@@ -332,11 +358,12 @@ component_Fc_Vegas_Upcall_Read(PARCEventQueue *in, PARCEventType event, void *st
                 // we need a return value that indicates if it took the memory (case 988)
                 vegasSession_ReceiveContentObject(holder->session, tm);
             } else {
-                // or increment a drop counter because it did not match a session (case 988)
+                rtaComponentStats_Increment(stats, STATS_DROP_NO_SESSION);
+                rtaConnection_Trace(conn, component, RtaTraceEvent_Drop, STATS_DROP_NO_SESSION);
                 transportMessage_Destroy(&tm);
             }
         } else {
-            PARCEventQueue *out = rtaComponent_GetOutputQueue(conn, FC_VEGAS, RTA_UP);
+            PARCEventQueue *out = rtaComponent_GetOutputQueue(conn, component, RTA_UP);
             if (rtaComponent_PutMessage(out, tm)) {
                 rtaComponentStats_Increment(stats, STATS_UPCALL_OUT);
             } else {
@@ -357,20 +384,25 @@ component_Fc_Vegas_Upcall_Read(PARCEventQueue *in, PARCEventType event, void *st
 static void
 component_Fc_Vegas_Downcall_Read(PARCEventQueue *in, PARCEventType event, void *conn)
 {
-    RtaProtocolStack *stack = (RtaProtocolStack *) conn;
-    PARCEventQueue *out = rtaProtocolStack_GetPutQueue(stack, FC_VEGAS, RTA_DOWN);
+    vegasComponent_DowncallRead(in, (RtaProtocolStack *) conn, FC_VEGAS);
+}
+
+void
+vegasComponent_DowncallRead(PARCEventQueue *in, RtaProtocolStack *stack, RtaComponents component)
+{
+    PARCEventQueue *out = rtaProtocolStack_GetPutQueue(stack, component, RTA_DOWN);
     TransportMessage *tm;
 
 //    printf("%s reading from queue %p\n", __func__, in);
 
     while ((tm = rtaComponent_GetMessage(in)) != NULL) {
         RtaConnection  *conn = rtaConnection_GetFromTransport(tm);
-        RtaComponentStats *stats = rtaConnection_GetStats(conn, FC_VEGAS);
+        RtaComponentStats *stats = rtaConnection_GetStats(conn, component);
         rtaComponentStats_Increment(stats, STATS_DOWNCALL_IN);
 
         if (transportMessage_IsControl(tm)) {
             CCNxTlvDictionary *controlDictionary = transportMessage_GetDictionary(tm);
-            if (ccnxControlFacade_IsCPI(controlDictionary) && vegas_HandleControl(conn, controlDictionary, in)) {
+            if (ccnxControlFacade_IsCPI(controlDictionary) && vegas_HandleControl(conn, component, controlDictionary, in)) {
                 transportMessage_Destroy(&tm);
             } else {
                 // we did not consume the message, so forward it down
@@ -379,7 +411,7 @@ component_Fc_Vegas_Downcall_Read(PARCEventQueue *in, PARCEventType event, void *
                 }
             }
         } else if (transportMessage_IsInterest(tm)) {
-            vegas_HandleInterest(conn, tm);
+            vegas_HandleInterest(conn, component, tm);
 
             // The flow controller consumes Interests going down the stack and will
             // start issuing its own interests instead.
@@ -403,6 +435,12 @@ component_Fc_Vegas_Downcall_Read(PARCEventQueue *in, PARCEventType event, void *
 
 static int
 component_Fc_Vegas_Closer(RtaConnection *conn)
+{
+    return vegasComponent_Close(conn, FC_VEGAS);
+}
+
+int
+vegasComponent_Close(RtaConnection *conn, RtaComponents component)
 {
     VegasConnectionState *fcConnState;
 
@@ -411,9 +449,10 @@ component_Fc_Vegas_Closer(RtaConnection *conn)
         return -1;
     }
 
-    fcConnState = rtaConnection_GetPrivateData(conn, FC_VEGAS);
+    fcConnState = rtaConnection_GetPrivateData(conn, component);
 
-    assertNotNull(fcConnState, "could not retrieve private data for FC_VEGAS on connid %u\n",
+    assertNotNull(fcConnState, "could not retrieve private data for %s on connid %u\n",
+                  RtaComponentNames[component],
                   rtaConnection_GetConnectionId(conn));
     if (fcConnState == NULL) {
         return -1;
@@ -421,7 +460,7 @@ component_Fc_Vegas_Closer(RtaConnection *conn)
 
     rtaConnection_Destroy(&fcConnState->parent_connection);
 
-    rtaComponentStats_Increment(rtaConnection_GetStats(conn, FC_VEGAS), STATS_CLOSES);
+    rtaComponentStats_Increment(rtaConnection_GetStats(conn, component), STATS_CLOSES);
 
     // close down all the sessions
     while (!TAILQ_EMPTY(&fcConnState->sessions_head)) {
@@ -447,11 +486,18 @@ component_Fc_Vegas_Release(RtaProtocolStack *stack)
 
 static void
 component_Fc_Vegas_StateChange(RtaConnection *conn)
+{
+    vegasComponent_StateChange(conn, FC_VEGAS);
+}
+
+void
+vegasComponent_StateChange(RtaConnection *conn, RtaComponents component)
 {
     assertNotNull(conn, "Got null connection\n");
 
-    VegasConnectionState *fcConnState = rtaConnection_GetPrivateData(conn, FC_VEGAS);
-    assertNotNull(fcConnState, "could not retrieve private data for FC_VEGAS on connid %u\n",
+    VegasConnectionState *fcConnState = rtaConnection_GetPrivateData(conn, component);
+    assertNotNull(fcConnState, "could not retrieve private data for %s on connid %u\n",
+                  RtaComponentNames[component],
                   rtaConnection_GetConnectionId(conn));
 
     // should replace this with a hash table
@@ -538,11 +584,11 @@ vegas_LookupSession(VegasConnectionState *fc, TransportMessage *tm)
  * Precondition: it's an interest
  */
 static int
-vegas_HandleInterest(RtaConnection *conn, TransportMessage *tm)
+vegas_HandleInterest(RtaConnection *conn, RtaComponents component, TransportMessage *tm)
 {
     assertTrue(transportMessage_IsInterest(tm), "Transport message is not an interest");
 
-    VegasConnectionState *fc = rtaConnection_GetPrivateData(conn, FC_VEGAS);
+    VegasConnectionState *fc = rtaConnection_GetPrivateData(conn, component);
     CCNxTlvDictionary *interestDictionary = transportMessage_GetDictionary(tm);
 
     // we do not modify or destroy this name
@@ -583,7 +629,7 @@ vegas_HandleInterest(RtaConnection *conn, TransportMessage *tm)
         vegasSession_Start(holder->session);
 
         rtaConnection_SendStatus(conn,
-                                 FC_VEGAS,
+                                 component,
                                  RTA_UP,
                                  notifyStatusCode_FLOW_CONTROL_STARTED,
                                  original_name,
@@ -643,7 +689,7 @@ vegas_EndSession(VegasConnectionState *fc, VegasSession *session)
     assertNotNull(holder, "invalid state, got null holder");
 
     rtaConnection_SendStatus(fc->parent_connection,
-                             FC_VEGAS,
+                             fc->component,
                              RTA_UP,
                              notifyStatusCode_FLOW_CONTROL_FINISHED,
                              holder->basename,
@@ -654,14 +700,14 @@ vegas_EndSession(VegasConnectionState *fc, VegasSession *session)
 }
 
 static void
-vegas_SendControlPlaneResponse(RtaConnection *conn, CCNxTlvDictionary *controlDictionary, PARCEventQueue *outputQueue)
+vegas_SendControlPlaneResponse(RtaConnection *conn, RtaComponents component, CCNxTlvDictionary *controlDictionary, PARCEventQueue *outputQueue)
 {
     TransportMessage *tm = transportMessage_CreateFromDictionary(controlDictionary);
 
     transportMessage_SetInfo(tm, rtaConnection_Copy(conn), rtaConnection_FreeFunc);
 
     if (rtaComponent_PutMessage(outputQueue, tm)) {
-        RtaComponentStats *stats = rtaConnection_GetStats(conn, FC_VEGAS);
+        RtaComponentStats *stats = rtaConnection_GetStats(conn, component);
         rtaComponentStats_Increment(stats, STATS_UPCALL_OUT);
     }
 }
@@ -676,14 +722,14 @@ vegas_SendControlPlaneResponse(RtaConnection *conn, CCNxTlvDictionary *controlDi
  * @return true if we consumed the message, false if it should go down the stack
  */
 static bool
-vegas_HandleControl(RtaConnection *conn, CCNxTlvDictionary *controlDictionary, PARCEventQueue *outputQueue)
+vegas_HandleControl(RtaConnection *conn, RtaComponents component, CCNxTlvDictionary *controlDictionary, PARCEventQueue *outputQueue)
 {
     bool success = false;
 
     if (ccnxControlFacade_IsCPI(controlDictionary)) {
         PARCJSON *json = ccnxControlFacade_GetJson(controlDictionary);
         if (cpi_getCPIOperation2(json) == CPI_CANCEL_FLOW) {
-            VegasConnectionState *fc = rtaConnection_GetPrivateData(conn, FC_VEGAS);
+            VegasConnectionState *fc = rtaConnection_GetPrivateData(conn, component);
             CCNxName *name = cpiCancelFlow_GetFlowName(json);
 
             PARCJSON *reply = NULL;
@@ -710,7 +756,7 @@ vegas_HandleControl(RtaConnection *conn, CCNxTlvDictionary *controlDictionary, P
                 reply = cpiAcks_CreateNack(json);
             }
             CCNxTlvDictionary *response = ccnxControlFacade_CreateCPI(reply);
-            vegas_SendControlPlaneResponse(conn, response, outputQueue);
+            vegas_SendControlPlaneResponse(conn, component, response, outputQueue);
             ccnxTlvDictionary_Release(&response);
 
             parcJSON_Release(&reply);
@@ -722,3 +768,67 @@ vegas_HandleControl(RtaConnection *conn, CCNxTlvDictionary *controlDictionary, P
     }
     return success;
 }
+
+RtaComponents
+vegas_GetComponent(const VegasConnectionState *fc)
+{
+    assertNotNull(fc, "Parameter fc must be non-null");
+    return fc->component;
+}
+
+const VegasCongestionControl *
+vegas_GetCongestionControl(const VegasConnectionState *fc)
+{
+    assertNotNull(fc, "Parameter fc must be non-null");
+    return fc->congestionControl;
+}
+
+bool
+vegas_GetPacing(const VegasConnectionState *fc)
+{
+    assertNotNull(fc, "Parameter fc must be non-null");
+    return fc->pacing;
+}
+
+FlowControlPacingStats *
+vegas_GetPacingStats(VegasConnectionState *fc)
+{
+    assertNotNull(fc, "Parameter fc must be non-null");
+    return &fc->pacingStats;
+}
+
+bool
+component_Flowcontrol_GetPacingStats(RtaConnection *conn, RtaComponents component, FlowControlPacingStats *output)
+{
+    assertNotNull(conn, "Parameter conn must be non-null");
+    assertNotNull(output, "Parameter output must be non-null");
+
+    VegasConnectionState *fcConnState = rtaConnection_GetPrivateData(conn, component);
+    if (fcConnState == NULL) {
+        return false;
+    }
+
+    *output = fcConnState->pacingStats;
+    return true;
+}
+
+bool
+component_Flowcontrol_GetWindowStats(RtaConnection *conn, RtaComponents component, FlowControlWindowStats *output)
+{
+    assertNotNull(conn, "Parameter conn must be non-null");
+    assertNotNull(output, "Parameter output must be non-null");
+
+    VegasConnectionState *fcConnState = rtaConnection_GetPrivateData(conn, component);
+    if (fcConnState == NULL) {
+        return false;
+    }
+
+    memset(output, 0, sizeof(FlowControlWindowStats));
+
+    FcSessionHolder *holder;
+    TAILQ_FOREACH(holder, &fcConnState->sessions_head, list)
+    {
+        vegasSession_AccumulateWindowStats(holder->session, output);
+    }
+    return true;
+}
@@ -603,7 +603,7 @@ LONGBOW_TEST_CASE(Component, interest_down_slow_retransmit)
     data->mock->framework->clock_ticks += 1001;
 
     // RTO timeout will be 1 second
-    vegasSession_TimerCallback(-1, PARCEventType_Timeout, holder->session);
+    vegasSession_TimerCallback(holder->session->tick_timer, holder->session);
     trafficTools_ReadAndVerifySegment(out, ccnxInterest_GetName(interest), 0, NULL);
 
     transportMessage_Destroy(&truth_tm);
@@ -648,7 +648,7 @@ LONGBOW_TEST_CASE(Component, interest_down_fast_retransmit)
 
     data->mock->framework->clock_ticks += 20;
     printf("*** bump time %" PRIu64 "\n", data->mock->framework->clock_ticks);
-    vegasSession_TimerCallback(-1, PARCEventType_Timeout, holder->session);
+    vegasSession_TimerCallback(holder->session->tick_timer, holder->session);
 
     // --------------------------------------
     // send an out-of-order content object, should see a fast retransmit
@@ -672,7 +672,7 @@ LONGBOW_TEST_CASE(Component, interest_down_fast_retransmit)
     data->mock->framework->clock_ticks += 40;
     printf("*** bump time %" PRIu64 "\n", data->mock->framework->clock_ticks);
     rtaFramework_NonThreadedStepCount(data->mock->framework, 5);
-    vegasSession_TimerCallback(-1, PARCEventType_Timeout, holder->session);
+    vegasSession_TimerCallback(holder->session->tick_timer, holder->session);
 
     trafficTools_ReadAndVerifySegment(out, basename, 0, NULL);
 
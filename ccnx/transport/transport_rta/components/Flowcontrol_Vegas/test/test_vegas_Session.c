@@ -193,6 +193,8 @@ LONGBOW_TEST_FIXTURE(Local)
     LONGBOW_RUN_TEST_CASE(Local, vegasSession_GetFinalBlockIdFromContentObject_None);
     LONGBOW_RUN_TEST_CASE(Local, vegasSession_GetFinalBlockIdFromContentObject_TestCases);
     LONGBOW_RUN_TEST_CASE(Local, vegasSession_GetSegnumFromObject);
+    LONGBOW_RUN_TEST_CASE(Local, vegasSession_PacingActive);
+    LONGBOW_RUN_TEST_CASE(Local, vegasSession_PacingRefill);
 
     LONGBOW_RUN_TEST_CASE(Local, vegasSession_ReceiveContentObject_InOrder_LastBlockSetsFinalId);
     LONGBOW_RUN_TEST_CASE(Local, vegasSession_ReceiveContentObject_InOrder_FirstAndLastBlocksSetsFinalId);
@@ -432,7 +434,8 @@ static void
 _bumpTime(TestData *data, unsigned ticks, CCNxName *name)
 {
     data->mock->framework->clock_ticks += ticks;
-    vegasSession_TimerCallback(-1, PARCEventType_Timeout, _grabSession(data, name));
+    VegasSession *session = _grabSession(data, name);
+    vegasSession_TimerCallback(session->tick_timer, session);
 }
 
 static uint64_t
@@ -579,6 +582,52 @@ _runTestVector(TestData *data, TestVector vectors[])
     ccnxName_Release(&sessionName);
 }
 
+LONGBOW_TEST_CASE(Local, vegasSession_PacingActive)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    VegasSession *session = parcMemory_AllocateAndClear(sizeof(VegasSession));
+
+    session->SRTT = 100;
+    assertFalse(vegasSession_PacingActive(session), "Pacing should be off without a pacing timer");
+
+    // the timer is never scheduled, so its callback does not run on this bare session
+    session->pacing_timer = rtaFramework_CreateTimer(data->mock->framework, vegasSession_PacingTimerCallback, (void *) session);
+    assertTrue(vegasSession_PacingActive(session), "Pacing should be on with a timer and an SRTT");
+
+    session->SRTT = 0;
+    assertFalse(vegasSession_PacingActive(session), "Pacing should be off without an SRTT");
+
+    rtaTimer_Destroy(&session->pacing_timer);
+    parcMemory_Deallocate((void **) &session);
+}
+
+/*
+ * At cwnd 50 and SRTT 100 the rate is 1/2 Interest per tick and the bucket holds the minimum burst
+ */
+LONGBOW_TEST_CASE(Local, vegasSession_PacingRefill)
+{
+    VegasSession *session = parcMemory_AllocateAndClear(sizeof(VegasSession));
+    session->SRTT = 100;
+    session->current_cwnd = 50;
+
+    assertTrue(vegasSession_PacingBurst(session) == FC_PACING_MIN_BURST * FC_PACING_ONE,
+               "Wrong burst, got %" PRIu64, vegasSession_PacingBurst(session));
+
+    vegasSession_PacingRefill(session, 2);
+    assertTrue(session->pacing_tokens == FC_PACING_ONE, "Wrong tokens after 2 ticks, got %" PRIu64, session->pacing_tokens);
+
+    vegasSession_PacingRefill(session, 1000);
+    assertTrue(session->pacing_tokens == FC_PACING_MIN_BURST * FC_PACING_ONE,
+               "Tokens should be capped at the burst, got %" PRIu64, session->pacing_tokens);
+
+    // 1000 Interests per RTT is 10 per tick, so the burst must cover one tick
+    session->current_cwnd = 1000;
+    assertTrue(vegasSession_PacingBurst(session) == 11 * FC_PACING_ONE,
+               "Wrong burst, got %" PRIu64, vegasSession_PacingBurst(session));
+
+    parcMemory_Deallocate((void **) &session);
+}
+
 /*
  * First chunk sets final block ID, last chunk does not.  Should keep reading until
  * the real last chunk set to itself.
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file vegas_CongestionControl.h
+ * @brief The congestion control strategy used by a flow control session
+ *
+ * A VegasSession owns the window of outstanding Interests, in-order delivery, RTT and RTO
+ * estimation, and fast and slow re-expression.  The decision of how large the congestion
+ * window should be is delegated to a VegasCongestionControl strategy.  The session calls the
+ * strategy at four points and then reads back the window with `getCwnd`:
+ *
+ *   - `onAck` for each Content Object that fills a window entry
+ *   - `onLoss` when an Interest is re-expressed or an old duplicate arrives
+ *   - `onTimeout` when the RTO timer expires
+ *   - `onRoundTrip` once per round trip from the session timer
+ *
+ * A session without a strategy runs the original delay-based Vegas algorithm built in to
+ * vegas_Session.c.  The FC_PIPELINE component supplies the strategy from its connection
+ * configuration.
+ *
+ * All times are in framework ticks and all windows are in Interests (objects).
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef Libccnx_vegas_CongestionControl_h
+#define Libccnx_vegas_CongestionControl_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <ccnx/transport/transport_rta/core/rta_Framework_Services.h>
+
+/**
+ * What the session knows about a Content Object when it arrives
+ */
+typedef struct vegas_congestion_sample {
+    // The current time
+    ticks now;
+
+    // The time from the first request of the segment until now, always at least 1
+    ticks rtt;
+
+    // The wire format bytes of the Content Object, 0 if the codec did not keep them
+    size_t bytes;
+
+    // The number of Interests outstanding when the object arrived
+    uint32_t inFlight;
+
+    // False if the Interest was re-expressed, so the RTT is ambiguous (Karn)
+    bool firstRequest;
+} VegasCongestionSample;
+
+typedef struct vegas_congestion_control {
+    // The name used in the connection configuration, e.g. "cubic"
+    const char *name;
+
+    // Allocate the per-session state with the given initial window
+    void *(*create)(ticks now, uint32_t initialCwnd);
+
+    void (*destroy)(void **statePtr);
+
+    void (*onAck)(void *state, const VegasCongestionSample *sample);
+
+    // Called at most once per re-expressed Interest
+    void (*onLoss)(void *state, ticks now);
+
+    void (*onTimeout)(void *state, ticks now);
+
+    // `srtt` is the smoothed RTT of the session, 0 if there is no estimate yet
+    void (*onRoundTrip)(void *state, ticks now, ticks srtt);
+
+    // The congestion window in Interests.  The session clamps it to its own limits.
+    uint32_t (*getCwnd)(const void *state);
+} VegasCongestionControl;
+#endif // Libccnx_vegas_CongestionControl_h
@@ -164,7 +164,6 @@
 #include <parc/algol/parc_Memory.h>
 #include <parc/algol/parc_SafeMemory.h>
 
-#include <parc/algol/parc_EventTimer.h>
 
 #include <ccnx/common/ccnx_NameSegmentNumber.h>
 #include <ccnx/common/ccnx_WireFormatMessage.h>
@@ -203,6 +202,13 @@
 #define FC_INIT_RTO_MSEC    1000
 
 #define FC_MSS 8704
+
+// Pacing tokens are fixed point, one Interest is FC_PACING_ONE tokens
+#define FC_PACING_ONE       (1ULL << 16)
+
+// The pacing bucket always holds at least this many Interests so a
+// slow rate does not pay a timer delay per Interest
+#define FC_PACING_MIN_BURST 2
 #define min(a, b) ((a < b) ? a : b)
 #define max(a, b) ((a > b) ? a : b)
 
@@ -229,6 +235,14 @@ struct vegas_session {
     RtaFramework      *parent_framework;
     VegasConnectionState *parent_fc;
 
+    // FC_VEGAS or FC_PIPELINE, used for queues, stats, and status
+    RtaComponents component;
+
+    // If not NULL, the window size comes from this strategy instead of
+    // the built-in Vegas algorithm
+    const VegasCongestionControl *congestionControl;
+    void *congestionState;
+
     // next sampling time
     ticks next_rtt_sample;
 
@@ -268,7 +282,12 @@ struct vegas_session {
 
     struct fc_window_entry window[FC_MAX_CWND];
 
-    PARCEventTimer *tick_event;
+    RtaTimer *tick_timer;
+
+    // Interest pacing (token bucket at cwnd/SRTT), NULL timer if pacing is off
+    RtaTimer *pacing_timer;
+    uint64_t pacing_tokens;
+    ticks pacing_last_refill;
 
     // we will generate Interests with the same version as was received to start the session.
     // Will also use the same lifetime settings as the original Interest.
@@ -314,6 +333,7 @@ static void vegasSession_ReleaseWindowEntry(struct fc_window_entry *entry);
 static void vegasSession_RunAlgorithmOnReceive(VegasSession *session, struct fc_window_entry *entry);
 
 static void vegasSession_SetTimer(VegasSession *session, ticks tick_delay);
+static void vegasSession_PacingTimerCallback(RtaTimer *timer, void *user_data);
 static void vegasSession_SlowReexpress(VegasSession *session);
 
 // =======================================================================
@@ -365,9 +385,47 @@ vegasSession_GetSegnumFromObject(CCNxTlvDictionary *contentObjectDictionary, uin
     return -1;
 }
 
+/**
+ * The number of Interests in the window, which may be more than the cwnd if the cwnd was reduced
+ */
+static uint32_t
+vegasSession_WindowSize(const VegasSession *session)
+{
+    int wsize = session->window_tail - session->window_head;
+    if (wsize < 0) {
+        wsize += FC_MAX_CWND;
+    }
+    return (uint32_t) wsize;
+}
+
+/**
+ * Copy the congestion window from the strategy, within the limits of our window
+ */
+static void
+vegasSession_ApplyCongestionWindow(VegasSession *session)
+{
+    uint32_t cwnd = session->congestionControl->getCwnd(session->congestionState);
+
+    if (cwnd < 2) {
+        cwnd = 2;
+    } else if (cwnd > FC_MAX_CWND) {
+        cwnd = FC_MAX_CWND;
+    }
+
+    session->current_cwnd = cwnd;
+}
+
 static void
 vegasSession_ReduceCongestionWindow(VegasSession *session)
 {
+    if (session->congestionControl != NULL) {
+        ticks now = rtaFramework_GetTicks(session->parent_framework);
+        session->congestionControl->onLoss(session->congestionState, now);
+        vegasSession_ApplyCongestionWindow(session);
+        session->last_cwnd_adjust = now;
+        return;
+    }
+
     if (session->current_cwnd <= session->slow_start_threshold) {
         // 3/4 it
         session->current_cwnd = session->current_cwnd / 2 + session->current_cwnd / 4;
@@ -391,13 +449,17 @@ vegasSession_RunAlgorithmOnReceive(VegasSession *session, struct fc_window_entry
 
     now = rtaFramework_GetTicks(session->parent_framework);
 
+    rtaConnection_Trace(session->parent_connection, session->component, RtaTraceEvent_ContentReceived, entry->segnum);
+
     // perform statistics updates.
 
     // If the codec did not include the raw message, we cannot increment the bytes counter
     PARCBuffer *wireFormat = ccnxWireFormatMessage_GetWireFormatBuffer(transportMessage_GetDictionary(entry->transport_msg));
+    size_t bytes = 0;
 
     if (wireFormat) {
-        session->sample_bytes_recevied += parcBuffer_Remaining(wireFormat);
+        bytes = parcBuffer_Remaining(wireFormat);
+        session->sample_bytes_recevied += bytes;
     }
 
 
@@ -456,6 +518,18 @@ vegasSession_RunAlgorithmOnReceive(VegasSession *session, struct fc_window_entry
         }
     }
 
+    if (session->congestionControl != NULL) {
+        VegasCongestionSample sample = {
+            .now          = now,
+            .rtt          = (ticks) fc_rtt,
+            .bytes        = bytes,
+            .inFlight     = vegasSession_WindowSize(session),
+            .firstRequest = entry->first_request
+        };
+        session->congestionControl->onAck(session->congestionState, &sample);
+        vegasSession_ApplyCongestionWindow(session);
+    }
+
     // we received a packet :)  yay.
     // we get to extend the RTO expiry
     session->next_rto = now + session->RTO;
@@ -480,8 +554,8 @@ vegasSession_ForwardObjectsInOrder(VegasSession *session)
                    entry->segnum);
 
         if (entry->transport_msg != NULL) {
-            PARCEventQueue *out = rtaComponent_GetOutputQueue(session->parent_connection, FC_VEGAS, RTA_UP);
-            RtaComponentStats *stats = rtaConnection_GetStats(session->parent_connection, FC_VEGAS);
+            PARCEventQueue *out = rtaComponent_GetOutputQueue(session->parent_connection, session->component, RTA_UP);
+            RtaComponentStats *stats = rtaConnection_GetStats(session->parent_connection, session->component);
 
             if (rtaLogger_IsLoggable(rtaFramework_GetLogger(session->parent_framework), RtaLoggerFacility_Flowcontrol, PARCLogLevel_Debug)) {
                 rtaLogger_Log(rtaFramework_GetLogger(session->parent_framework), RtaLoggerFacility_Flowcontrol, PARCLogLevel_Debug, __func__,
@@ -655,7 +729,11 @@ vegasSession_CongestionAvoidance(VegasSession *session)
 
     vegasSession_CongestionAvoidanceDebug(session, now);
 
-    if (session->do_fc_this_rtt) {
+    if (session->congestionControl != NULL) {
+        // the strategy keeps its own notion of rounds
+        session->congestionControl->onRoundTrip(session->congestionState, now, session->SRTT);
+        vegasSession_ApplyCongestionWindow(session);
+    } else if (session->do_fc_this_rtt) {
         if (session->cnt_RTT <= 2) {
             vegasSession_LossBasedAvoidance(session);
         } else {
@@ -718,6 +796,7 @@ vegasSession_SlowReexpress(VegasSession *session)
                       "Session %p conn %p RTO re-expression for segnum %" PRIu64 "",
                       (void *) session, (void *) session->parent_connection, entry->segnum);
     }
+    rtaConnection_Trace(session->parent_connection, session->component, RtaTraceEvent_Retransmit, entry->segnum);
 
     entry->first_request = false;
     vegasSession_ExpressInterestForEntry(session, entry);
@@ -767,6 +846,7 @@ vegasSession_FastReexpress(VegasSession *session, struct fc_window_entry *ack_en
                               (void *) session, (void *) session->parent_connection, session->window[index].segnum);
             }
 
+            rtaConnection_Trace(session->parent_connection, session->component, RtaTraceEvent_Retransmit, session->window[index].segnum);
             session->window[index].first_request = false;
             session->cnt_fast_reexpress++;
             vegasSession_ExpressInterestForEntry(session, &session->window[index]);
@@ -823,7 +903,7 @@ vegasSession_ExpressInterestForEntry(VegasSession *session, struct fc_window_ent
         tm_out = transportMessage_CreateFromDictionary(interestDictionary);
         transportMessage_SetInfo(tm_out, rtaConnection_Copy(session->parent_connection), rtaConnection_FreeFunc);
 
-        q_out = rtaComponent_GetOutputQueue(session->parent_connection, FC_VEGAS, RTA_DOWN);
+        q_out = rtaComponent_GetOutputQueue(session->parent_connection, session->component, RTA_DOWN);
 
         if (rtaLogger_IsLoggable(rtaFramework_GetLogger(session->parent_framework), RtaLoggerFacility_Flowcontrol, PARCLogLevel_Debug)) {
             char *string = ccnxName_ToString(chunk_name);
@@ -842,10 +922,12 @@ vegasSession_ExpressInterestForEntry(VegasSession *session, struct fc_window_ent
 
         // If we fail to send the interest, should return failure to let caller know what's going on (case 923)
         if (rtaComponent_PutMessage(q_out, tm_out)) {
-            rtaComponentStats_Increment(rtaConnection_GetStats(session->parent_connection, FC_VEGAS),
+            rtaComponentStats_Increment(rtaConnection_GetStats(session->parent_connection, session->component),
                                         STATS_DOWNCALL_OUT);
+            rtaConnection_Trace(session->parent_connection, session->component, RtaTraceEvent_InterestSent, entry->segnum);
         }
     } else {
+        rtaConnection_Trace(session->parent_connection, session->component, RtaTraceEvent_InterestSuppressed, entry->segnum);
         if (rtaLogger_IsLoggable(rtaFramework_GetLogger(session->parent_framework), RtaLoggerFacility_Flowcontrol, PARCLogLevel_Info)) {
             CCNxName *segment_name = ccnxName_Copy(session->basename);
             ccnxName_Append(segment_name, ccnxNameSegmentNumber_Create(CCNxNameLabelType_CHUNK, entry->segnum));
@@ -865,6 +947,64 @@ vegasSession_ExpressInterestForEntry(VegasSession *session, struct fc_window_ent
     return 0;
 }
 
+/*
+ * The pacing rate is cwnd/SRTT Interests per tick.  Without an SRTT (start up or
+ * after an RTO) there is no rate to pace at, so the window is sent as before.
+ */
+static bool
+vegasSession_PacingActive(const VegasSession *session)
+{
+    return session->pacing_timer != NULL && session->SRTT > 0;
+}
+
+static uint64_t
+vegasSession_PacingBurst(const VegasSession *session)
+{
+    // Allow at least one tick's worth of Interests, otherwise a rate above one
+    // Interest per tick could never be reached
+    uint64_t perTick = session->current_cwnd / session->SRTT + 1;
+    return max(perTick, FC_PACING_MIN_BURST) * FC_PACING_ONE;
+}
+
+static void
+vegasSession_PacingRefill(VegasSession *session, ticks now)
+{
+    ticks elapsed = now - session->pacing_last_refill;
+    session->pacing_last_refill = now;
+
+    // Anything longer than an SRTT fills the bucket, so bound it to avoid overflow
+    if (elapsed > session->SRTT) {
+        elapsed = session->SRTT;
+    }
+
+    uint64_t burst = vegasSession_PacingBurst(session);
+    session->pacing_tokens += elapsed * session->current_cwnd * FC_PACING_ONE / session->SRTT;
+    if (session->pacing_tokens > burst) {
+        session->pacing_tokens = burst;
+    }
+}
+
+/*
+ * Called when the window is open but the bucket is empty.  Schedules the pacing timer
+ * for when the next Interest's worth of tokens will be available.
+ */
+static void
+vegasSession_PacingDefer(VegasSession *session)
+{
+    uint64_t needed = FC_PACING_ONE - session->pacing_tokens;
+    uint64_t perTickTokens = session->current_cwnd * FC_PACING_ONE / session->SRTT;
+    ticks delay = (perTickTokens == 0) ? session->SRTT : (needed + perTickTokens - 1) / perTickTokens;
+    if (delay == 0) {
+        delay = 1;
+    }
+
+    vegas_GetPacingStats(session->parent_fc)->delayedSends++;
+
+    if (!rtaTimer_IsPending(session->pacing_timer)) {
+        rtaTimer_Schedule(session->pacing_timer, delay);
+    }
+}
+
 /*
  * Express interests out to the max allowed by the cwnd.  This function will operate
  * even if the down queue is blocked.  Those interests will be treated as lost, which will cause
@@ -876,13 +1016,23 @@ vegasSession_ExpressInterests(VegasSession *session)
     ticks now = rtaFramework_GetTicks(session->parent_framework);
 
     // how many interests are currently outstanding?
-    int wsize = session->window_tail - session->window_head;
-    if (wsize < 0) {
-        wsize += FC_MAX_CWND;
+    uint32_t wsize = vegasSession_WindowSize(session);
+
+    bool pacing = vegasSession_PacingActive(session);
+    if (pacing) {
+        vegasSession_PacingRefill(session, now);
     }
 
     // if we know the FBID, don't ask for anything beyond that
     while (wsize < session->current_cwnd && (wsize + session->starting_segnum <= session->final_segnum)) {
+        if (pacing) {
+            if (session->pacing_tokens < FC_PACING_ONE) {
+                vegasSession_PacingDefer(session);
+                break;
+            }
+            session->pacing_tokens -= FC_PACING_ONE;
+        }
+
         // expreess them
         struct fc_window_entry *entry = &session->window[session->window_tail];
 
@@ -913,18 +1063,31 @@ vegasSession_ExpressInterests(VegasSession *session)
     }
 }
 
+static void
+vegasSession_PacingTimerCallback(RtaTimer *timer, void *user_data)
+{
+    VegasSession *session = (VegasSession *) user_data;
+    FlowControlPacingStats *stats = vegas_GetPacingStats(session->parent_fc);
+
+    stats->timerFires++;
+
+    uint32_t before = vegasSession_WindowSize(session);
+    vegasSession_ExpressInterests(session);
+    uint32_t after = vegasSession_WindowSize(session);
+
+    stats->pacedSends += after - before;
+}
+
 /*
  * This is dispatched from the event loop, so its a loosely accurate time
  */
 static void
-vegasSession_TimerCallback(int fd, PARCEventType what, void *user_data)
+vegasSession_TimerCallback(RtaTimer *timer, void *user_data)
 {
     VegasSession *session = (VegasSession *) user_data;
     int64_t delta;
     ticks now;
 
-    assertTrue(what & PARCEventType_Timeout, "%s got unknown signal %d", __func__, what);
-
     now = rtaFramework_GetTicks(session->parent_framework);
     delta = ((int64_t) now - (int64_t) session->next_rtt_sample);
 
@@ -956,6 +1119,12 @@ vegasSession_TimerCallback(int fd, PARCEventType what, void *user_data)
         session->RTTVAR = 0;
         session->RTO = session->RTO * 2;
         session->next_rto = now + session->RTO;
+
+        if (session->congestionControl != NULL) {
+            session->congestionControl->onTimeout(session->congestionState, now);
+            vegasSession_ApplyCongestionWindow(session);
+            session->last_cwnd_adjust = now;
+        }
     }
 }
 
@@ -979,22 +1148,15 @@ vegasSession_ReleaseWindowEntry(struct fc_window_entry *entry)
 static void
 vegasSession_SetTimer(VegasSession *session, ticks tick_delay)
 {
-    struct timeval timeout;
-    uint64_t usec = rtaFramework_TicksToUsec(tick_delay);
-    const unsigned usec_per_sec = 1000000;
-
-    timeout.tv_sec = usec / usec_per_sec;
-    timeout.tv_usec = (int) (usec - timeout.tv_sec * usec_per_sec);
-
     // this replaces any prior events
-    parcEventTimer_Start(session->tick_event, &timeout);
+    rtaTimer_Schedule(session->tick_timer, tick_delay);
 
     if (rtaLogger_IsLoggable(rtaFramework_GetLogger(session->parent_framework), RtaLoggerFacility_Flowcontrol, PARCLogLevel_Debug)) {
         rtaLogger_Log(rtaFramework_GetLogger(session->parent_framework), RtaLoggerFacility_Flowcontrol, PARCLogLevel_Debug, __func__,
                       "session %p tick_delay %" PRIu64 " timeout %.6f",
                       (void *) session,
                       tick_delay,
-                      timeout.tv_sec + 1E-6 * timeout.tv_usec);
+                      1E-6 * rtaFramework_TicksToUsec(tick_delay));
     }
 }
 
@@ -1045,8 +1207,16 @@ vegasSession_Create(VegasConnectionState *fc, RtaConnection *conn, CCNxName *bas
         session->keyIdRestriction = parcBuffer_Acquire(keyIdRestriction);
     }
     session->parent_fc = fc;
+    session->component = vegas_GetComponent(fc);
+    session->congestionControl = vegas_GetCongestionControl(fc);
 
-    session->tick_event = parcEventTimer_Create(rtaFramework_GetEventScheduler(session->parent_framework), 0, vegasSession_TimerCallback, (void *) session);
+    session->tick_timer = rtaFramework_CreateTimer(session->parent_framework, vegasSession_TimerCallback, (void *) session);
+
+    if (vegas_GetPacing(fc)) {
+        session->pacing_timer = rtaFramework_CreateTimer(session->parent_framework, vegasSession_PacingTimerCallback, (void *) session);
+        session->pacing_tokens = FC_PACING_MIN_BURST * FC_PACING_ONE;
+        session->pacing_last_refill = rtaFramework_GetTicks(session->parent_framework);
+    }
 
     session->starting_segnum = 0;
     session->current_cwnd = FC_INIT_CWND;
@@ -1063,6 +1233,11 @@ vegasSession_Create(VegasConnectionState *fc, RtaConnection *conn, CCNxName *bas
     session->cnt_old_segments = 0;
     session->cnt_fast_reexpress = 0;
 
+    if (session->congestionControl != NULL) {
+        session->congestionState = session->congestionControl->create(rtaFramework_GetTicks(session->parent_framework),
+                                                                      session->current_cwnd);
+    }
+
     _vegasSession_UnsetFinalSegnum(session);
 
     if (rtaLogger_IsLoggable(rtaFramework_GetLogger(session->parent_framework), RtaLoggerFacility_Flowcontrol, PARCLogLevel_Notice)) {
@@ -1125,7 +1300,14 @@ vegasSession_Destroy(VegasSession **sessionPtr)
 
     vegasSession_Close(session);
 
-    parcEventTimer_Destroy(&(session->tick_event));
+    if (session->congestionState != NULL) {
+        session->congestionControl->destroy(&session->congestionState);
+    }
+
+    rtaTimer_Destroy(&(session->tick_timer));
+    if (session->pacing_timer != NULL) {
+        rtaTimer_Destroy(&(session->pacing_timer));
+    }
     parcMemory_Deallocate((void **) &session);
     sessionPtr = NULL;
 }
@@ -1317,7 +1499,10 @@ vegasSession_SendMoreInterests(VegasSession *session, struct fc_window_entry *en
                           session->final_segnum);
         }
 
-        parcEventTimer_Stop(session->tick_event);
+        rtaTimer_Cancel(session->tick_timer);
+        if (session->pacing_timer != NULL) {
+            rtaTimer_Cancel(session->pacing_timer);
+        }
         vegas_EndSession(session->parent_fc, session);
     }
     // else session->starting_segnum == session->final_segnum, we're not done yet.
@@ -1459,6 +1644,26 @@ vegasSession_GetConnectionId(VegasSession *session)
     return rtaConnection_GetConnectionId(session->parent_connection);
 }
 
+void
+vegasSession_AccumulateWindowStats(const VegasSession *session, FlowControlWindowStats *total)
+{
+    assertNotNull(session, "Parameter session must be non-null");
+    assertNotNull(total, "Parameter total must be non-null");
+
+    total->sessions++;
+    total->cwnd += session->current_cwnd;
+
+    uint64_t srttUsec = rtaFramework_TicksToUsec(session->SRTT);
+    if (srttUsec > total->maxSrttUsec) {
+        total->maxSrttUsec = srttUsec;
+    }
+
+    uint64_t rtoUsec = rtaFramework_TicksToUsec(session->RTO);
+    if (rtoUsec > total->maxRtoUsec) {
+        total->maxRtoUsec = rtoUsec;
+    }
+}
+
 void
 vegasSession_StateChanged(VegasSession *session)
 {
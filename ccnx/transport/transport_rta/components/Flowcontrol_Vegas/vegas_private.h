@@ -67,6 +67,15 @@
 #include <ccnx/common/ccnx_Name.h>
 #include <ccnx/common/internal/ccnx_ContentObjectInterface.h>
 
+#include <parc/algol/parc_EventQueue.h>
+
+#include <ccnx/transport/transport_rta/core/components.h>
+#include <ccnx/transport/transport_rta/core/rta_ProtocolStack.h>
+#include <ccnx/transport/transport_rta/core/rta_Connection.h>
+
+#include <ccnx/transport/transport_rta/components/component_Flowcontrol.h>
+#include "vegas_CongestionControl.h"
+
 typedef uint64_t segnum_t;
 
 struct vegas_session;
@@ -242,6 +251,21 @@ void vegasSession_StateChanged(VegasSession *session);
  */
 unsigned vegasSession_GetConnectionId(VegasSession *session);
 
+/**
+ * Adds the session's congestion window and timers to a connection total
+ *
+ * Increments `sessions`, adds the cwnd, and raises the SRTT and RTO maximums.
+ *
+ * @param [in] session The session
+ * @param [in,out] total The running total for the connection
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void vegasSession_AccumulateWindowStats(const VegasSession *session, FlowControlWindowStats *total);
+
 
 /**
  * <#One Line Description#>
@@ -260,4 +284,139 @@ unsigned vegasSession_GetConnectionId(VegasSession *session);
  * @see <#references#>
  */
 void vegas_EndSession(VegasConnectionState *fc, VegasSession *session);
+
+/**
+ * The component that owns the per-connection state
+ *
+ * Sessions use this for their output queues, statistics, and status messages, so the
+ * same session code serves both FC_VEGAS and FC_PIPELINE.
+ *
+ * @param [in] fc The per-connection flow control state
+ *
+ * @return The component id, e.g. FC_VEGAS
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+RtaComponents vegas_GetComponent(const VegasConnectionState *fc);
+
+/**
+ * The congestion control strategy for new sessions on the connection
+ *
+ * @param [in] fc The per-connection flow control state
+ *
+ * @return NULL Sessions run the built-in Vegas algorithm
+ * @return non-null The strategy to use
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+const VegasCongestionControl *vegas_GetCongestionControl(const VegasConnectionState *fc);
+
+/**
+ * True if sessions on this connection pace their Interests
+ *
+ * @param [in] fc The connection state of the flow controller
+ *
+ * @return true Pacing is enabled in the connection configuration
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+bool vegas_GetPacing(const VegasConnectionState *fc);
+
+/**
+ * The pacing counters shared by all sessions on the connection
+ *
+ * @param [in] fc The connection state of the flow controller
+ *
+ * @return non-null The counters, owned by the connection state
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+FlowControlPacingStats *vegas_GetPacingStats(VegasConnectionState *fc);
+
+/**
+ * Creates the per-connection flow control state for `component`
+ *
+ * The shared component code behind FC_VEGAS and FC_PIPELINE.  The private data of the
+ * connection for `component` is set to the new state.
+ *
+ * @param [in] conn The connection being opened
+ * @param [in] component The component id that owns the state
+ * @param [in] congestionControl The strategy for sessions on this connection, or NULL for Vegas
+ *
+ * @return 0 Success
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+int vegasComponent_Open(RtaConnection *conn, RtaComponents component, const VegasCongestionControl *congestionControl);
+
+/**
+ * Reads messages coming up the stack for `component`
+ *
+ * @param [in] in The input queue
+ * @param [in] component The component id reading the queue
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void vegasComponent_UpcallRead(PARCEventQueue *in, RtaComponents component);
+
+/**
+ * Reads messages coming down the stack for `component`
+ *
+ * @param [in] in The input queue
+ * @param [in] stack The protocol stack
+ * @param [in] component The component id reading the queue
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void vegasComponent_DowncallRead(PARCEventQueue *in, RtaProtocolStack *stack, RtaComponents component);
+
+/**
+ * Destroys all sessions and the per-connection state for `component`
+ *
+ * @param [in] conn The connection being closed
+ * @param [in] component The component id that owns the state
+ *
+ * @return 0 Success
+ * @return -1 There was no state for the connection
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+int vegasComponent_Close(RtaConnection *conn, RtaComponents component);
+
+/**
+ * Tells each session of the connection that the connection state changed
+ *
+ * @param [in] conn The connection
+ * @param [in] component The component id that owns the state
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void vegasComponent_StateChange(RtaConnection *conn, RtaComponents component);
 #endif // Libccnx_vegas_private_h
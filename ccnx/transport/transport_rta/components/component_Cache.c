@@ -0,0 +1,511 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+/**
+ * Component behavior
+ * ===================
+ * The CACHE component is a content store shared by every connection on a protocol stack.
+ *
+ * Up Stack Behavior
+ * ------------------------
+ * Every Content Object going up the stack is added to the store (acquiring a reference to its
+ * dictionary) and then passed up unchanged.  An object with the same name and ContentObjectHash
+ * as an existing entry refreshes that entry.  Other messages are passed up unmodified.
+ *
+ * Down Stack Behavior
+ * ------------------------
+ * An Interest going down the stack is looked up in the store.  On a hit, a new TransportMessage
+ * wrapping the cached dictionary is sent back up the stack on the Interest's connection and the
+ * Interest is consumed.  On a miss the Interest continues down.  Other messages are passed down
+ * unmodified.
+ *
+ * Implementation Notes
+ * =========================
+ * Entries live in a chained hash table indexed by the name hash and on a TAILQ in LRU order
+ * (head is most recently used).  The size of an entry is the length of its wire format.  When
+ * an insert would exceed maxBytes, entries are evicted from the tail of the LRU.
+ *
+ * An object without a wire format has no ContentObjectHash, so it can only satisfy Interests
+ * without a ContentObjectHash restriction.  Expired objects are never returned and are removed
+ * when found.
+ */
+
+#include <config.h>
+#include <stdio.h>
+#include <sys/queue.h>
+#include <sys/time.h>
+
+#define __STDC_FORMAT_MACROS
+#include <inttypes.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/security/parc_CryptoHash.h>
+
+#include <ccnx/common/ccnx_Interest.h>
+#include <ccnx/common/ccnx_ContentObject.h>
+#include <ccnx/common/ccnx_WireFormatMessage.h>
+#include <ccnx/common/internal/ccnx_ValidationFacadeV1.h>
+
+#include <ccnx/transport/common/transport_Message.h>
+
+#include <ccnx/transport/transport_rta/core/rta_Framework_Services.h>
+#include <ccnx/transport/transport_rta/core/rta_ProtocolStack.h>
+#include <ccnx/transport/transport_rta/core/rta_Connection.h>
+#include <ccnx/transport/transport_rta/core/rta_Component.h>
+
+#include <ccnx/transport/transport_rta/config/config_Cache.h>
+#include <ccnx/transport/transport_rta/components/component_Cache.h>
+
+#ifndef DEBUG_OUTPUT
+#define DEBUG_OUTPUT 0
+#endif
+
+#define CACHE_MIN_BUCKETS 64
+#define CACHE_MAX_BUCKETS 65536
+
+// used to size the hash table from maxBytes
+#define CACHE_TYPICAL_OBJECT_BYTES 1024
+
+static int  component_Cache_Init(RtaProtocolStack *stack);
+static void component_Cache_Upcall_Read(PARCEventQueue *, PARCEventType event, void *stack);
+static void component_Cache_Downcall_Read(PARCEventQueue *, PARCEventType event, void *stack);
+static int  component_Cache_Release(RtaProtocolStack *stack);
+
+RtaComponentOperations cache_ops = {
+    .init          = component_Cache_Init,
+    .open          = NULL,
+    .upcallRead    = component_Cache_Upcall_Read,
+    .upcallEvent   = NULL,
+    .downcallRead  = component_Cache_Downcall_Read,
+    .downcallEvent = NULL,
+    .close         = NULL,
+    .release       = component_Cache_Release,
+    .stateChange   = NULL
+};
+
+typedef struct cache_entry {
+    CCNxTlvDictionary *contentObject;
+
+    // not reference counted, they belong to contentObject
+    CCNxName *name;
+    PARCBuffer *keyId;
+
+    // may be NULL if the object has no wire format
+    PARCBuffer *objectHash;
+
+    PARCHashCode nameHash;
+    size_t bytes;
+
+    // milliseconds since the epoch, 0 means no expiry
+    uint64_t expiryTime;
+
+    TAILQ_ENTRY(cache_entry) lruList;
+    LIST_ENTRY(cache_entry) bucketList;
+} CacheEntry;
+
+LIST_HEAD(cache_bucket, cache_entry);
+
+typedef struct cache_state {
+    size_t bucketCount;
+    struct cache_bucket *buckets;
+    TAILQ_HEAD(cache_entry_list, cache_entry) lru;
+
+    ComponentCacheStats stats;
+} CacheState;
+
+// ==================
+
+static uint64_t
+_cache_NowMilliseconds(void)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return (uint64_t) now.tv_sec * 1000 + now.tv_usec / 1000;
+}
+
+static size_t
+_cache_BucketCount(size_t maxBytes)
+{
+    size_t count = CACHE_MIN_BUCKETS;
+    while (count < CACHE_MAX_BUCKETS && count * CACHE_TYPICAL_OBJECT_BYTES < maxBytes) {
+        count <<= 1;
+    }
+    return count;
+}
+
+static struct cache_bucket *
+_cache_GetBucket(CacheState *cache, PARCHashCode nameHash)
+{
+    return &cache->buckets[nameHash & (cache->bucketCount - 1)];
+}
+
+static void
+_cache_RemoveEntry(CacheState *cache, CacheEntry *entry)
+{
+    LIST_REMOVE(entry, bucketList);
+    TAILQ_REMOVE(&cache->lru, entry, lruList);
+
+    cache->stats.bytesUsed -= entry->bytes;
+    cache->stats.objectCount--;
+
+    if (entry->objectHash) {
+        parcBuffer_Release(&entry->objectHash);
+    }
+    ccnxTlvDictionary_Release(&entry->contentObject);
+    parcMemory_Deallocate((void **) &entry);
+}
+
+static void
+_cache_EvictToFit(CacheState *cache, size_t bytes)
+{
+    while (!TAILQ_EMPTY(&cache->lru) && cache->stats.bytesUsed + bytes > cache->stats.maxBytes) {
+        CacheEntry *victim = TAILQ_LAST(&cache->lru, cache_entry_list);
+        _cache_RemoveEntry(cache, victim);
+        cache->stats.evictions++;
+    }
+}
+
+/**
+ * True if the cached entry satisfies the Interest's name and restrictions
+ */
+static bool
+_cache_EntryMatches(const CacheEntry *entry, PARCHashCode nameHash, const CCNxName *name,
+                    const PARCBuffer *keyIdRestriction, const PARCBuffer *hashRestriction)
+{
+    if (entry->nameHash != nameHash || !ccnxName_Equals(entry->name, name)) {
+        return false;
+    }
+
+    if (keyIdRestriction != NULL) {
+        if (entry->keyId == NULL || !parcBuffer_Equals(entry->keyId, keyIdRestriction)) {
+            return false;
+        }
+    }
+
+    if (hashRestriction != NULL) {
+        if (entry->objectHash == NULL || !parcBuffer_Equals(entry->objectHash, hashRestriction)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Finds an unexpired entry that satisfies the interest and moves it to the head of the LRU.
+ * Expired entries found along the way are removed.
+ */
+static CacheEntry *
+_cache_Lookup(CacheState *cache, CCNxTlvDictionary *interestDictionary)
+{
+    CCNxName *name = ccnxInterest_GetName(interestDictionary);
+    PARCBuffer *keyIdRestriction = ccnxInterest_GetKeyIdRestriction(interestDictionary);
+    PARCBuffer *hashRestriction = ccnxInterest_GetContentObjectHashRestriction(interestDictionary);
+    PARCHashCode nameHash = ccnxName_HashCode(name);
+
+    uint64_t now = _cache_NowMilliseconds();
+
+    struct cache_bucket *bucket = _cache_GetBucket(cache, nameHash);
+    CacheEntry *entry = LIST_FIRST(bucket);
+    while (entry != NULL) {
+        CacheEntry *next = LIST_NEXT(entry, bucketList);
+        if (entry->expiryTime != 0 && entry->expiryTime <= now) {
+            _cache_RemoveEntry(cache, entry);
+        } else if (_cache_EntryMatches(entry, nameHash, name, keyIdRestriction, hashRestriction)) {
+            TAILQ_REMOVE(&cache->lru, entry, lruList);
+            TAILQ_INSERT_HEAD(&cache->lru, entry, lruList);
+            return entry;
+        }
+        entry = next;
+    }
+    return NULL;
+}
+
+static PARCBuffer *
+_cache_CreateObjectHash(CCNxTlvDictionary *contentObjectDictionary)
+{
+    PARCBuffer *result = NULL;
+    if (ccnxWireFormatMessage_GetWireFormatBuffer(contentObjectDictionary) != NULL) {
+        PARCCryptoHash *hash = ccnxWireFormatMessage_CreateContentObjectHash(contentObjectDictionary);
+        if (hash != NULL) {
+            result = parcBuffer_Acquire(parcCryptoHash_GetDigest(hash));
+            parcCryptoHash_Release(&hash);
+        }
+    }
+    return result;
+}
+
+static size_t
+_cache_ObjectBytes(CCNxTlvDictionary *contentObjectDictionary)
+{
+    size_t bytes = sizeof(CacheEntry);
+    PARCBuffer *wireFormat = ccnxWireFormatMessage_GetWireFormatBuffer(contentObjectDictionary);
+    if (wireFormat != NULL) {
+        bytes += parcBuffer_Limit(wireFormat);
+    } else {
+        PARCBuffer *payload = ccnxContentObject_GetPayload(contentObjectDictionary);
+        if (payload != NULL) {
+            bytes += parcBuffer_Limit(payload);
+        }
+    }
+    return bytes;
+}
+
+static void
+_cache_Insert(CacheState *cache, CCNxTlvDictionary *contentObjectDictionary)
+{
+    CCNxName *name = ccnxContentObject_GetName(contentObjectDictionary);
+    if (name == NULL) {
+        // nameless objects can only match by hash, which we do not index
+        return;
+    }
+
+    size_t bytes = _cache_ObjectBytes(contentObjectDictionary);
+    if (bytes > cache->stats.maxBytes) {
+        return;
+    }
+
+    uint64_t expiryTime = 0;
+    if (ccnxContentObject_HasExpiryTime(contentObjectDictionary)) {
+        expiryTime = ccnxContentObject_GetExpiryTime(contentObjectDictionary);
+        if (expiryTime <= _cache_NowMilliseconds()) {
+            return;
+        }
+    }
+
+    PARCHashCode nameHash = ccnxName_HashCode(name);
+    PARCBuffer *objectHash = _cache_CreateObjectHash(contentObjectDictionary);
+
+    // an object with the same name and hash replaces the old entry
+    struct cache_bucket *bucket = _cache_GetBucket(cache, nameHash);
+    CacheEntry *entry = LIST_FIRST(bucket);
+    while (entry != NULL) {
+        CacheEntry *next = LIST_NEXT(entry, bucketList);
+        if (entry->nameHash == nameHash && ccnxName_Equals(entry->name, name)) {
+            bool sameHash = (entry->objectHash == NULL && objectHash == NULL) ||
+                            (entry->objectHash != NULL && objectHash != NULL && parcBuffer_Equals(entry->objectHash, objectHash));
+            if (sameHash) {
+                _cache_RemoveEntry(cache, entry);
+            }
+        }
+        entry = next;
+    }
+
+    _cache_EvictToFit(cache, bytes);
+
+    entry = parcMemory_AllocateAndClear(sizeof(CacheEntry));
+    assertNotNull(entry, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(CacheEntry));
+
+    entry->contentObject = ccnxTlvDictionary_Acquire(contentObjectDictionary);
+    entry->name = name;
+    entry->keyId = ccnxValidationFacadeV1_GetKeyId(contentObjectDictionary);
+    entry->objectHash = objectHash;
+    entry->nameHash = nameHash;
+    entry->bytes = bytes;
+    entry->expiryTime = expiryTime;
+
+    LIST_INSERT_HEAD(bucket, entry, bucketList);
+    TAILQ_INSERT_HEAD(&cache->lru, entry, lruList);
+
+    cache->stats.bytesUsed += bytes;
+    cache->stats.objectCount++;
+    cache->stats.inserts++;
+}
+
+// ==================
+
+static int
+component_Cache_Init(RtaProtocolStack *stack)
+{
+    CacheState *cache = parcMemory_AllocateAndClear(sizeof(CacheState));
+    assertNotNull(cache, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(CacheState));
+
+    cache->stats.maxBytes = contentStore_GetMaxBytesFromConfig(rtaProtocolStack_GetParameters(stack));
+    cache->bucketCount = _cache_BucketCount(cache->stats.maxBytes);
+    cache->buckets = parcMemory_AllocateAndClear(cache->bucketCount * sizeof(struct cache_bucket));
+    assertNotNull(cache->buckets, "parcMemory_AllocateAndClear(%zu) returned NULL", cache->bucketCount * sizeof(struct cache_bucket));
+
+    for (size_t i = 0; i < cache->bucketCount; i++) {
+        LIST_INIT(&cache->buckets[i]);
+    }
+    TAILQ_INIT(&cache->lru);
+
+    rtaProtocolStack_SetPrivateData(stack, CACHE, cache);
+
+    if (DEBUG_OUTPUT) {
+        printf("%9" PRIu64 " %s stack %d maxBytes %zu buckets %zu\n",
+               rtaFramework_GetTicks(rtaProtocolStack_GetFramework(stack)),
+               __func__,
+               rtaProtocolStack_GetStackId(stack),
+               cache->stats.maxBytes,
+               cache->bucketCount);
+    }
+
+    return 0;
+}
+
+/* Read from below and send to above */
+static void
+component_Cache_Upcall_Read(PARCEventQueue *in, PARCEventType event, void *ptr)
+{
+    RtaProtocolStack *stack = (RtaProtocolStack *) ptr;
+    CacheState *cache = rtaProtocolStack_GetPrivateData(stack, CACHE);
+    PARCEventQueue *out = rtaProtocolStack_GetPutQueue(stack, CACHE, RTA_UP);
+    TransportMessage *tm;
+
+    while ((tm = rtaComponent_GetMessage(in)) != NULL) {
+        RtaConnection *conn = rtaConnection_GetFromTransport(tm);
+        RtaComponentStats *stats = rtaConnection_GetStats(conn, CACHE);
+        rtaComponentStats_Increment(stats, STATS_UPCALL_IN);
+
+        if (transportMessage_IsContentObject(tm)) {
+            _cache_Insert(cache, transportMessage_GetDictionary(tm));
+        }
+
+        if (rtaComponent_PutMessage(out, tm)) {
+            rtaComponentStats_Increment(stats, STATS_UPCALL_OUT);
+        }
+    }
+}
+
+/**
+ * Answer the interest from the content store on its own connection.
+ * The cached dictionary is shared, not copied.
+ */
+static void
+_cache_SendHitUpStack(RtaConnection *conn, CacheEntry *entry, PARCEventQueue *upQueue, RtaComponentStats *stats)
+{
+    TransportMessage *response = transportMessage_CreateFromDictionary(entry->contentObject);
+    transportMessage_SetInfo(response, rtaConnection_Copy(conn), rtaConnection_FreeFunc);
+
+    if (rtaComponent_PutMessage(upQueue, response)) {
+        rtaComponentStats_Increment(stats, STATS_UPCALL_OUT);
+    }
+}
+
+/* Read from above and send to below */
+static void
+component_Cache_Downcall_Read(PARCEventQueue *in, PARCEventType event, void *ptr)
+{
+    RtaProtocolStack *stack = (RtaProtocolStack *) ptr;
+    CacheState *cache = rtaProtocolStack_GetPrivateData(stack, CACHE);
+    PARCEventQueue *out = rtaProtocolStack_GetPutQueue(stack, CACHE, RTA_DOWN);
+    PARCEventQueue *reply = rtaProtocolStack_GetPutQueue(stack, CACHE, RTA_UP);
+    TransportMessage *tm;
+
+    while ((tm = rtaComponent_GetMessage(in)) != NULL) {
+        RtaConnection *conn = rtaConnection_GetFromTransport(tm);
+        RtaComponentStats *stats = rtaConnection_GetStats(conn, CACHE);
+        rtaComponentStats_Increment(stats, STATS_DOWNCALL_IN);
+
+        if (transportMessage_IsInterest(tm)) {
+            CacheEntry *entry = _cache_Lookup(cache, transportMessage_GetDictionary(tm));
+            if (entry != NULL) {
+                cache->stats.hits++;
+                _cache_SendHitUpStack(conn, entry, reply, stats);
+                transportMessage_Destroy(&tm);
+                continue;
+            }
+            cache->stats.misses++;
+        }
+
+        if (rtaComponent_PutMessage(out, tm)) {
+            rtaComponentStats_Increment(stats, STATS_DOWNCALL_OUT);
+        }
+    }
+}
+
+static int
+component_Cache_Release(RtaProtocolStack *stack)
+{
+    CacheState *cache = rtaProtocolStack_GetPrivateData(stack, CACHE);
+    assertNotNull(cache, "%s got null private data\n", __func__);
+
+    if (DEBUG_OUTPUT) {
+        printf("%s stack %d hits %" PRIu64 " misses %" PRIu64 " evictions %" PRIu64 "\n",
+               __func__,
+               rtaProtocolStack_GetStackId(stack),
+               cache->stats.hits,
+               cache->stats.misses,
+               cache->stats.evictions);
+    }
+
+    while (!TAILQ_EMPTY(&cache->lru)) {
+        _cache_RemoveEntry(cache, TAILQ_FIRST(&cache->lru));
+    }
+
+    parcMemory_Deallocate((void **) &cache->buckets);
+    parcMemory_Deallocate((void **) &cache);
+    rtaProtocolStack_SetPrivateData(stack, CACHE, NULL);
+    return 0;
+}
+
+bool
+component_Cache_GetStats(RtaProtocolStack *stack, ComponentCacheStats *output)
+{
+    assertNotNull(output, "Parameter output must be non-null");
+    CacheState *cache = rtaProtocolStack_GetPrivateData(stack, CACHE);
+    if (cache != NULL) {
+        *output = cache->stats;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file component_Cache.h
+ * @brief A consumer-side content store shared by all connections of a protocol stack.
+ *
+ * The CACHE component keeps recently received Content Objects in a byte-bounded LRU
+ * keyed by name and ContentObjectHash.  An Interest coming down the stack that matches a
+ * cached object (name, plus KeyId and ContentObjectHash restrictions if present) is answered
+ * directly back up the stack and never reaches the forwarder.
+ *
+ * The component should sit above the codec, so Interests are not yet encoded and
+ * Content Objects are already decoded:
+ *
+ * { SYSTEM : COMPONENTS : [API_CONNECTOR, FC_VEGAS, CACHE, CODEC_TLV, FWD_METIS] }
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef Libccnx_component_Cache_h
+#define Libccnx_component_Cache_h
+
+#include <ccnx/transport/transport_rta/core/rta_ProtocolStack.h>
+#include <ccnx/transport/transport_rta/core/rta_Connection.h>
+#include <ccnx/transport/transport_rta/core/rta_Component.h>
+
+/**
+ * The stack-wide content store counters
+ */
+typedef struct component_cache_stats {
+    uint64_t hits;          /**< Interests answered from the content store */
+    uint64_t misses;        /**< Interests passed down the stack */
+    uint64_t evictions;     /**< Objects removed to stay under maxBytes */
+    uint64_t inserts;       /**< Objects added to the content store */
+    size_t objectCount;     /**< Objects currently held */
+    size_t bytesUsed;       /**< Bytes currently held */
+    size_t maxBytes;        /**< The configured upper bound */
+} ComponentCacheStats;
+
+extern RtaComponentOperations cache_ops;
+
+/**
+ * Copies the content store counters of a protocol stack
+ *
+ * @param [in] stack A protocol stack with a CACHE component
+ * @param [out] output Filled in with the current counters
+ *
+ * @return true The stack has a CACHE component and output was filled in
+ * @return false The stack does not have a CACHE component
+ *
+ * Example:
+ * @code
+ * {
+ *     ComponentCacheStats stats;
+ *     if (component_Cache_GetStats(stack, &stats)) {
+ *         printf("hits %" PRIu64 " misses %" PRIu64 "\n", stats.hits, stats.misses);
+ *     }
+ * }
+ * @endcode
+ */
+bool component_Cache_GetStats(RtaProtocolStack *stack, ComponentCacheStats *output);
+#endif // Libccnx_component_Cache_h
@@ -161,8 +161,13 @@ upcallDictionary(TransportMessage *tm, PARCEventQueue *out, RtaComponentStats *s
             rtaComponentStats_Increment(stats, STATS_UPCALL_OUT);
         }
     } else {
-        printf("Decoding error!");
-        parcBuffer_Display(wireFormat, 3);
+        rtaComponentStats_Increment(stats, STATS_DROP_DECODE_ERROR);
+        rtaConnection_Trace(rtaConnection_GetFromTransport(tm), CODEC_TLV, RtaTraceEvent_Drop, STATS_DROP_DECODE_ERROR);
+        if (DEBUG_OUTPUT) {
+            printf("Decoding error!");
+            parcBuffer_Display(wireFormat, 3);
+        }
+        transportMessage_Destroy(&tm);
     }
 }
 
@@ -179,6 +184,12 @@ component_Codec_Tlv_Upcall_Read(PARCEventQueue *in, PARCEventType event, void *p
         RtaComponentStats *stats = rtaConnection_GetStats(conn, CODEC_TLV);
         rtaComponentStats_Increment(stats, STATS_UPCALL_IN);
 
+        // upcallDictionary() may destroy the message, so take the delay first
+        struct timeval delay = { 0, 0 };
+        if (DEBUG_OUTPUT) {
+            delay = transportMessage_GetDelay(tm);
+        }
+
         if (transportMessage_IsControl(tm)) {
             if (rtaComponent_PutMessage(out, tm)) {
                 rtaComponentStats_Increment(stats, STATS_UPCALL_OUT);
@@ -188,7 +199,6 @@ component_Codec_Tlv_Upcall_Read(PARCEventQueue *in, PARCEventType event, void *p
         }
 
         if (DEBUG_OUTPUT) {
-            struct timeval delay = transportMessage_GetDelay(tm);
             printf("%9" PRIu64 " %s total upcall reads in %" PRIu64 " out %" PRIu64 " last delay %.6f\n",
                    rtaFramework_GetTicks(rtaProtocolStack_GetFramework(rtaConnection_GetStack(conn))),
                    __func__,
@@ -63,7 +63,79 @@
 #ifndef Libccnx_component_flow_h
 #define Libccnx_component_flow_h
 
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <ccnx/transport/transport_rta/core/rta_Connection.h>
+
 // Function structs for component variations
 extern RtaComponentOperations flow_vegas_ops;
+extern RtaComponentOperations flow_pipeline_ops;
 extern RtaComponentOperations flow_null_ops;
+
+/**
+ * Interest pacing counters for one connection, summed over all its sessions
+ */
+typedef struct flowcontrol_pacing_stats {
+    uint64_t delayedSends;  /**< Times the window was open but a send waited for pacing */
+    uint64_t pacedSends;    /**< Interests sent from the pacing timer */
+    uint64_t timerFires;    /**< Pacing timer callbacks */
+} FlowControlPacingStats;
+
+/**
+ * Reads the Interest pacing counters of a flow controller on a connection
+ *
+ * The counters stay at zero unless pacing is enabled in the connection configuration,
+ * see vegasFlowController_PacedConnectionConfig().
+ *
+ * @param [in] conn The connection
+ * @param [in] component FC_VEGAS or FC_PIPELINE
+ * @param [out] output Filled in with the counters
+ *
+ * @return true The flow controller is open on the connection and output is valid
+ * @return false The flow controller has no state on the connection
+ *
+ * Example:
+ * @code
+ * {
+ *     FlowControlPacingStats stats;
+ *     if (component_Flowcontrol_GetPacingStats(conn, FC_VEGAS, &stats)) {
+ *         printf("delayed %" PRIu64 "\n", stats.delayedSends);
+ *     }
+ * }
+ * @endcode
+ */
+bool component_Flowcontrol_GetPacingStats(RtaConnection *conn, RtaComponents component, FlowControlPacingStats *output);
+
+/**
+ * Congestion window state of one connection, over all its sessions
+ */
+typedef struct flowcontrol_window_stats {
+    uint32_t sessions;      /**< Open sessions on the connection */
+    uint64_t cwnd;          /**< Sum of the session congestion windows, in segments */
+    uint64_t maxSrttUsec;   /**< Largest session smoothed RTT */
+    uint64_t maxRtoUsec;    /**< Largest session retransmission timeout */
+} FlowControlWindowStats;
+
+/**
+ * Reads the congestion window state of a flow controller on a connection
+ *
+ * @param [in] conn The connection
+ * @param [in] component FC_VEGAS or FC_PIPELINE
+ * @param [out] output Filled in with the window state
+ *
+ * @return true The flow controller is open on the connection and output is valid
+ * @return false The flow controller has no state on the connection
+ *
+ * Example:
+ * @code
+ * {
+ *     FlowControlWindowStats stats;
+ *     if (component_Flowcontrol_GetWindowStats(conn, FC_VEGAS, &stats)) {
+ *         printf("cwnd %" PRIu64 " srtt %" PRIu64 " usec\n", stats.cwnd, stats.maxSrttUsec);
+ *     }
+ * }
+ * @endcode
+ */
+bool component_Flowcontrol_GetWindowStats(RtaConnection *conn, RtaComponents component, FlowControlWindowStats *output);
 #endif // Libccnx_component_flow_h
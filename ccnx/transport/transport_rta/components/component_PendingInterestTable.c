@@ -0,0 +1,615 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+/**
+ * Component behavior
+ * ===================
+ * The PIT component is a pending interest table shared by every connection on a protocol stack.
+ *
+ * Down Stack Behavior
+ * ------------------------
+ * An Interest is matched against the table by name, KeyId restriction and ContentObjectHash
+ * restriction.  If there is no unexpired entry, one is created and the Interest goes down the
+ * stack.  If there is an entry and the connection is not yet waiting on it, the connection
+ * is added to the entry and the Interest is consumed.  If the connection is already waiting,
+ * the Interest is a retransmission: it goes down the stack and extends the entry lifetime.
+ *
+ * Other messages go down the stack unmodified.
+ *
+ * Up Stack Behavior
+ * ------------------------
+ * A Content Object satisfies every entry it matches.  Each waiting connection, other than the
+ * connection the Content Object arrived on, gets a new TransportMessage that acquires the same
+ * dictionary.  The original message then continues up the stack.  Satisfied entries are removed.
+ *
+ * Other messages go up the stack unmodified.
+ *
+ * Implementation Notes
+ * =========================
+ * Entries live in a chained hash table indexed by the name hash.  Each entry holds a reference
+ * to each waiting RtaConnection, which is released when the entry is removed or the connection
+ * closes.  If the connection that forwarded the Interest closes, its entry is removed; the other
+ * waiters will retransmit and create a new entry.
+ *
+ * Expired entries are removed when found by a lookup and by a periodic sweep.
+ */
+
+#include <config.h>
+#include <stdio.h>
+#include <sys/queue.h>
+
+#define __STDC_FORMAT_MACROS
+#include <inttypes.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_ArrayList.h>
+#include <parc/security/parc_CryptoHash.h>
+
+#include <ccnx/common/ccnx_Interest.h>
+#include <ccnx/common/ccnx_ContentObject.h>
+#include <ccnx/common/ccnx_WireFormatMessage.h>
+#include <ccnx/common/internal/ccnx_ValidationFacadeV1.h>
+
+#include <ccnx/transport/common/transport_Message.h>
+
+#include <ccnx/transport/transport_rta/core/rta_Framework_Services.h>
+#include <ccnx/transport/transport_rta/core/rta_ProtocolStack.h>
+#include <ccnx/transport/transport_rta/core/rta_Connection.h>
+#include <ccnx/transport/transport_rta/core/rta_Component.h>
+
+#include <ccnx/transport/transport_rta/components/component_PendingInterestTable.h>
+
+#ifndef DEBUG_OUTPUT
+#define DEBUG_OUTPUT 0
+#endif
+
+#define PIT_BUCKETS 1024
+
+// How often to sweep the table for expired entries
+#define PIT_EXPIRY_INTERVAL_MSEC 1000
+
+// Largest lifetime we can express in rtaFramework_UsecToTicks()
+#define PIT_MAX_LIFETIME_MSEC (UINT32_MAX / 1000)
+
+static int  component_Pit_Init(RtaProtocolStack *stack);
+static void component_Pit_Upcall_Read(PARCEventQueue *, PARCEventType event, void *stack);
+static void component_Pit_Downcall_Read(PARCEventQueue *, PARCEventType event, void *stack);
+static int  component_Pit_Closer(RtaConnection *conn);
+static int  component_Pit_Release(RtaProtocolStack *stack);
+
+RtaComponentOperations pit_ops = {
+    .init          = component_Pit_Init,
+    .open          = NULL,
+    .upcallRead    = component_Pit_Upcall_Read,
+    .upcallEvent   = NULL,
+    .downcallRead  = component_Pit_Downcall_Read,
+    .downcallEvent = NULL,
+    .close         = component_Pit_Closer,
+    .release       = component_Pit_Release,
+    .stateChange   = NULL
+};
+
+typedef struct pit_waiter {
+    // a reference from rtaConnection_Copy()
+    RtaConnection *conn;
+    LIST_ENTRY(pit_waiter) list;
+} PitWaiter;
+
+typedef struct pit_entry {
+    CCNxName *name;
+    PARCBuffer *keyIdRestriction;
+    PARCBuffer *hashRestriction;
+    PARCHashCode nameHash;
+
+    ticks expiry;
+
+    // the connection whose Interest is in flight (also in waiters)
+    RtaConnection *forwarder;
+
+    LIST_HEAD(, pit_waiter) waiters;
+    LIST_ENTRY(pit_entry) bucketList;
+} PitEntry;
+
+LIST_HEAD(pit_bucket, pit_entry);
+
+typedef struct pit_state {
+    RtaFramework *framework;
+    RtaTimer *expiryTimer;
+    struct pit_bucket buckets[PIT_BUCKETS];
+
+    ComponentPitStats stats;
+} PitState;
+
+// ==================
+
+static bool
+_pit_BufferEquals(const PARCBuffer *a, const PARCBuffer *b)
+{
+    if (a == NULL || b == NULL) {
+        return a == b;
+    }
+    return parcBuffer_Equals(a, b);
+}
+
+static struct pit_bucket *
+_pit_GetBucket(PitState *pit, PARCHashCode nameHash)
+{
+    return &pit->buckets[nameHash % PIT_BUCKETS];
+}
+
+static void
+_pit_DestroyEntry(PitState *pit, PitEntry **entryPtr)
+{
+    PitEntry *entry = *entryPtr;
+
+    LIST_REMOVE(entry, bucketList);
+
+    PitWaiter *waiter;
+    while ((waiter = LIST_FIRST(&entry->waiters)) != NULL) {
+        LIST_REMOVE(waiter, list);
+        rtaConnection_Destroy(&waiter->conn);
+        parcMemory_Deallocate((void **) &waiter);
+    }
+
+    ccnxName_Release(&entry->name);
+    if (entry->keyIdRestriction) {
+        parcBuffer_Release(&entry->keyIdRestriction);
+    }
+    if (entry->hashRestriction) {
+        parcBuffer_Release(&entry->hashRestriction);
+    }
+
+    pit->stats.entryCount--;
+    parcMemory_Deallocate((void **) entryPtr);
+}
+
+static bool
+_pit_IsExpired(const PitEntry *entry, ticks now)
+{
+    return TICK_CMP(now, entry->expiry) >= 0;
+}
+
+static PitWaiter *
+_pit_FindWaiter(PitEntry *entry, RtaConnection *conn)
+{
+    PitWaiter *waiter;
+    LIST_FOREACH(waiter, &entry->waiters, list)
+    {
+        if (waiter->conn == conn) {
+            return waiter;
+        }
+    }
+    return NULL;
+}
+
+static void
+_pit_AddWaiter(PitEntry *entry, RtaConnection *conn)
+{
+    PitWaiter *waiter = parcMemory_AllocateAndClear(sizeof(PitWaiter));
+    assertNotNull(waiter, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(PitWaiter));
+    waiter->conn = rtaConnection_Copy(conn);
+    LIST_INSERT_HEAD(&entry->waiters, waiter, list);
+}
+
+static ticks
+_pit_LifetimeToTicks(uint32_t lifetimeMsec)
+{
+    if (lifetimeMsec > PIT_MAX_LIFETIME_MSEC) {
+        lifetimeMsec = PIT_MAX_LIFETIME_MSEC;
+    }
+    return rtaFramework_UsecToTicks(lifetimeMsec * 1000);
+}
+
+/**
+ * Finds the entry with exactly the same name and restrictions.  An expired entry is removed
+ * and not returned.
+ */
+static PitEntry *
+_pit_FindEntry(PitState *pit, const CCNxName *name, PARCHashCode nameHash,
+               const PARCBuffer *keyIdRestriction, const PARCBuffer *hashRestriction, ticks now)
+{
+    struct pit_bucket *bucket = _pit_GetBucket(pit, nameHash);
+    PitEntry *entry;
+    LIST_FOREACH(entry, bucket, bucketList)
+    {
+        if (entry->nameHash == nameHash &&
+            _pit_BufferEquals(entry->keyIdRestriction, keyIdRestriction) &&
+            _pit_BufferEquals(entry->hashRestriction, hashRestriction) &&
+            ccnxName_Equals(entry->name, name)) {
+            if (_pit_IsExpired(entry, now)) {
+                _pit_DestroyEntry(pit, &entry);
+                pit->stats.expired++;
+                return NULL;
+            }
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static PitEntry *
+_pit_CreateEntry(PitState *pit, CCNxName *name, PARCHashCode nameHash,
+                 PARCBuffer *keyIdRestriction, PARCBuffer *hashRestriction)
+{
+    PitEntry *entry = parcMemory_AllocateAndClear(sizeof(PitEntry));
+    assertNotNull(entry, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(PitEntry));
+
+    entry->name = ccnxName_Acquire(name);
+    entry->keyIdRestriction = keyIdRestriction ? parcBuffer_Acquire(keyIdRestriction) : NULL;
+    entry->hashRestriction = hashRestriction ? parcBuffer_Acquire(hashRestriction) : NULL;
+    entry->nameHash = nameHash;
+    LIST_INIT(&entry->waiters);
+
+    LIST_INSERT_HEAD(_pit_GetBucket(pit, nameHash), entry, bucketList);
+    pit->stats.entryCount++;
+    return entry;
+}
+
+/**
+ * Records the interest in the table.
+ *
+ * @return true The interest should go down the stack
+ * @return false The interest was aggregated and should be consumed
+ */
+static bool
+_pit_ReceiveInterest(PitState *pit, RtaConnection *conn, CCNxTlvDictionary *interestDictionary)
+{
+    CCNxName *name = ccnxInterest_GetName(interestDictionary);
+    PARCBuffer *keyIdRestriction = ccnxInterest_GetKeyIdRestriction(interestDictionary);
+    PARCBuffer *hashRestriction = ccnxInterest_GetContentObjectHashRestriction(interestDictionary);
+    PARCHashCode nameHash = ccnxName_HashCode(name);
+
+    ticks now = rtaFramework_GetTicks(pit->framework);
+    ticks expiry = now + _pit_LifetimeToTicks(ccnxInterest_GetLifetime(interestDictionary));
+
+    PitEntry *entry = _pit_FindEntry(pit, name, nameHash, keyIdRestriction, hashRestriction, now);
+    if (entry == NULL) {
+        entry = _pit_CreateEntry(pit, name, nameHash, keyIdRestriction, hashRestriction);
+        _pit_AddWaiter(entry, conn);
+    } else if (_pit_FindWaiter(entry, conn) == NULL) {
+        _pit_AddWaiter(entry, conn);
+        pit->stats.aggregated++;
+        return false;
+    }
+
+    // a new entry or a retransmission, both go down the stack
+    entry->forwarder = conn;
+    if (TICK_CMP(expiry, entry->expiry) > 0) {
+        entry->expiry = expiry;
+    }
+    pit->stats.forwarded++;
+    return true;
+}
+
+static PARCBuffer *
+_pit_CreateObjectHash(CCNxTlvDictionary *contentObjectDictionary)
+{
+    PARCBuffer *result = NULL;
+    if (ccnxWireFormatMessage_GetWireFormatBuffer(contentObjectDictionary) != NULL) {
+        PARCCryptoHash *hash = ccnxWireFormatMessage_CreateContentObjectHash(contentObjectDictionary);
+        if (hash != NULL) {
+            result = parcBuffer_Acquire(parcCryptoHash_GetDigest(hash));
+            parcCryptoHash_Release(&hash);
+        }
+    }
+    return result;
+}
+
+static bool
+_pit_WasDelivered(PARCArrayList *delivered, RtaConnection *conn)
+{
+    for (size_t i = 0; i < parcArrayList_Size(delivered); i++) {
+        if (parcArrayList_Get(delivered, i) == conn) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Send the shared content object dictionary up the stack to every waiter of the entry
+ * that has not already received it.
+ */
+static void
+_pit_FanOut(PitState *pit, PitEntry *entry, CCNxTlvDictionary *contentObjectDictionary,
+            PARCArrayList *delivered, PARCEventQueue *out)
+{
+    PitWaiter *waiter;
+    LIST_FOREACH(waiter, &entry->waiters, list)
+    {
+        if (!_pit_WasDelivered(delivered, waiter->conn)) {
+            parcArrayList_Add(delivered, waiter->conn);
+
+            TransportMessage *copy = transportMessage_CreateFromDictionary(contentObjectDictionary);
+            transportMessage_SetInfo(copy, rtaConnection_Copy(waiter->conn), rtaConnection_FreeFunc);
+
+            if (rtaComponent_PutMessage(out, copy)) {
+                rtaComponentStats_Increment(rtaConnection_GetStats(waiter->conn, PIT), STATS_UPCALL_OUT);
+            }
+            pit->stats.fanout++;
+        }
+    }
+}
+
+/**
+ * Satisfies every entry the content object matches.  The connection the object arrived on
+ * is marked delivered up front, as it gets the original message.
+ */
+static void
+_pit_ReceiveContentObject(PitState *pit, RtaConnection *conn, CCNxTlvDictionary *contentObjectDictionary, PARCEventQueue *out)
+{
+    CCNxName *name = ccnxContentObject_GetName(contentObjectDictionary);
+    if (name == NULL) {
+        return;
+    }
+
+    PARCHashCode nameHash = ccnxName_HashCode(name);
+    PARCBuffer *keyId = ccnxValidationFacadeV1_GetKeyId(contentObjectDictionary);
+    PARCBuffer *objectHash = NULL;
+    bool objectHashComputed = false;
+
+    PARCArrayList *delivered = parcArrayList_Create(NULL);
+    parcArrayList_Add(delivered, conn);
+
+    struct pit_bucket *bucket = _pit_GetBucket(pit, nameHash);
+    PitEntry *entry = LIST_FIRST(bucket);
+    while (entry != NULL) {
+        PitEntry *next = LIST_NEXT(entry, bucketList);
+
+        bool matches = entry->nameHash == nameHash && ccnxName_Equals(entry->name, name);
+        if (matches && entry->keyIdRestriction != NULL) {
+            matches = _pit_BufferEquals(entry->keyIdRestriction, keyId);
+        }
+        if (matches && entry->hashRestriction != NULL) {
+            if (!objectHashComputed) {
+                objectHash = _pit_CreateObjectHash(contentObjectDictionary);
+                objectHashComputed = true;
+            }
+            matches = _pit_BufferEquals(entry->hashRestriction, objectHash);
+        }
+
+        if (matches) {
+            _pit_FanOut(pit, entry, contentObjectDictionary, delivered, out);
+            _pit_DestroyEntry(pit, &entry);
+            pit->stats.satisfied++;
+        }
+
+        entry = next;
+    }
+
+    parcArrayList_Destroy(&delivered);
+    if (objectHash) {
+        parcBuffer_Release(&objectHash);
+    }
+}
+
+static void
+_pit_ExpireEntries(PitState *pit)
+{
+    ticks now = rtaFramework_GetTicks(pit->framework);
+
+    for (int i = 0; i < PIT_BUCKETS; i++) {
+        PitEntry *entry = LIST_FIRST(&pit->buckets[i]);
+        while (entry != NULL) {
+            PitEntry *next = LIST_NEXT(entry, bucketList);
+            if (_pit_IsExpired(entry, now)) {
+                _pit_DestroyEntry(pit, &entry);
+                pit->stats.expired++;
+            }
+            entry = next;
+        }
+    }
+}
+
+static void
+_pit_ExpiryCallback(RtaTimer *timer, void *pitVoid)
+{
+    _pit_ExpireEntries((PitState *) pitVoid);
+    rtaTimer_Schedule(timer, rtaFramework_UsecToTicks(PIT_EXPIRY_INTERVAL_MSEC * 1000));
+}
+
+// ==================
+
+static int
+component_Pit_Init(RtaProtocolStack *stack)
+{
+    PitState *pit = parcMemory_AllocateAndClear(sizeof(PitState));
+    assertNotNull(pit, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(PitState));
+
+    pit->framework = rtaProtocolStack_GetFramework(stack);
+    for (int i = 0; i < PIT_BUCKETS; i++) {
+        LIST_INIT(&pit->buckets[i]);
+    }
+
+    pit->expiryTimer = rtaFramework_CreateTimer(pit->framework, _pit_ExpiryCallback, (void *) pit);
+    rtaTimer_Schedule(pit->expiryTimer, rtaFramework_UsecToTicks(PIT_EXPIRY_INTERVAL_MSEC * 1000));
+
+    rtaProtocolStack_SetPrivateData(stack, PIT, pit);
+    return 0;
+}
+
+/* Read from above and send to below */
+static void
+component_Pit_Downcall_Read(PARCEventQueue *in, PARCEventType event, void *ptr)
+{
+    RtaProtocolStack *stack = (RtaProtocolStack *) ptr;
+    PitState *pit = rtaProtocolStack_GetPrivateData(stack, PIT);
+    PARCEventQueue *out = rtaProtocolStack_GetPutQueue(stack, PIT, RTA_DOWN);
+    TransportMessage *tm;
+
+    while ((tm = rtaComponent_GetMessage(in)) != NULL) {
+        RtaConnection *conn = rtaConnection_GetFromTransport(tm);
+        RtaComponentStats *stats = rtaConnection_GetStats(conn, PIT);
+        rtaComponentStats_Increment(stats, STATS_DOWNCALL_IN);
+
+        if (transportMessage_IsInterest(tm)) {
+            if (!_pit_ReceiveInterest(pit, conn, transportMessage_GetDictionary(tm))) {
+                if (DEBUG_OUTPUT) {
+                    printf("%9" PRIu64 " %s connection %u interest aggregated\n",
+                           rtaFramework_GetTicks(pit->framework),
+                           __func__,
+                           rtaConnection_GetConnectionId(conn));
+                }
+                transportMessage_Destroy(&tm);
+                continue;
+            }
+        }
+
+        if (rtaComponent_PutMessage(out, tm)) {
+            rtaComponentStats_Increment(stats, STATS_DOWNCALL_OUT);
+        }
+    }
+}
+
+/* Read from below and send to above */
+static void
+component_Pit_Upcall_Read(PARCEventQueue *in, PARCEventType event, void *ptr)
+{
+    RtaProtocolStack *stack = (RtaProtocolStack *) ptr;
+    PitState *pit = rtaProtocolStack_GetPrivateData(stack, PIT);
+    PARCEventQueue *out = rtaProtocolStack_GetPutQueue(stack, PIT, RTA_UP);
+    TransportMessage *tm;
+
+    while ((tm = rtaComponent_GetMessage(in)) != NULL) {
+        RtaConnection *conn = rtaConnection_GetFromTransport(tm);
+        RtaComponentStats *stats = rtaConnection_GetStats(conn, PIT);
+        rtaComponentStats_Increment(stats, STATS_UPCALL_IN);
+
+        if (transportMessage_IsContentObject(tm)) {
+            _pit_ReceiveContentObject(pit, conn, transportMessage_GetDictionary(tm), out);
+        }
+
+        if (rtaComponent_PutMessage(out, tm)) {
+            rtaComponentStats_Increment(stats, STATS_UPCALL_OUT);
+        }
+    }
+}
+
+/**
+ * Remove the connection from every entry.  If it was the connection that forwarded the
+ * Interest, nothing will come back for the entry, so remove the entry.
+ */
+static int
+component_Pit_Closer(RtaConnection *conn)
+{
+    PitState *pit = rtaProtocolStack_GetPrivateData(rtaConnection_GetStack(conn), PIT);
+    assertNotNull(pit, "%s got null private data\n", __func__);
+
+    for (int i = 0; i < PIT_BUCKETS; i++) {
+        PitEntry *entry = LIST_FIRST(&pit->buckets[i]);
+        while (entry != NULL) {
+            PitEntry *next = LIST_NEXT(entry, bucketList);
+            if (entry->forwarder == conn) {
+                _pit_DestroyEntry(pit, &entry);
+            } else {
+                PitWaiter *waiter = _pit_FindWaiter(entry, conn);
+                if (waiter != NULL) {
+                    LIST_REMOVE(waiter, list);
+                    rtaConnection_Destroy(&waiter->conn);
+                    parcMemory_Deallocate((void **) &waiter);
+                }
+            }
+            entry = next;
+        }
+    }
+    return 0;
+}
+
+static int
+component_Pit_Release(RtaProtocolStack *stack)
+{
+    PitState *pit = rtaProtocolStack_GetPrivateData(stack, PIT);
+    assertNotNull(pit, "%s got null private data\n", __func__);
+
+    if (DEBUG_OUTPUT) {
+        printf("%s stack %d forwarded %" PRIu64 " aggregated %" PRIu64 " expired %" PRIu64 "\n",
+               __func__,
+               rtaProtocolStack_GetStackId(stack),
+               pit->stats.forwarded,
+               pit->stats.aggregated,
+               pit->stats.expired);
+    }
+
+    rtaTimer_Destroy(&pit->expiryTimer);
+
+    for (int i = 0; i < PIT_BUCKETS; i++) {
+        PitEntry *entry;
+        while ((entry = LIST_FIRST(&pit->buckets[i])) != NULL) {
+            _pit_DestroyEntry(pit, &entry);
+        }
+    }
+
+    parcMemory_Deallocate((void **) &pit);
+    rtaProtocolStack_SetPrivateData(stack, PIT, NULL);
+    return 0;
+}
+
+bool
+component_PendingInterestTable_GetStats(RtaProtocolStack *stack, ComponentPitStats *output)
+{
+    assertNotNull(output, "Parameter output must be non-null");
+    PitState *pit = rtaProtocolStack_GetPrivateData(stack, PIT);
+    if (pit != NULL) {
+        *output = pit->stats;
+        return true;
+    }
+    return false;
+}
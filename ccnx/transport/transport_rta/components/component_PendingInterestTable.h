@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file component_PendingInterestTable.h
+ * @brief Aggregates identical in-flight Interests across the connections of a protocol stack.
+ *
+ * All connections opened with the same `CCNxStackConfig` share one protocol stack.  The PIT
+ * component collapses identical outstanding Interests (same name, KeyId restriction and
+ * ContentObjectHash restriction) from different connections, forwards only the first one, and
+ * fans the returned Content Object out to every waiting connection.  The fan out shares
+ * the Content Object dictionary; it is not copied.
+ *
+ * An entry expires at the Interest lifetime of the most recently forwarded Interest.
+ * A retransmission from a connection that is already waiting is forwarded again and
+ * refreshes the lifetime.
+ *
+ * { SYSTEM : COMPONENTS : [API_CONNECTOR, FC_VEGAS, PIT, CACHE, CODEC_TLV, FWD_METIS] }
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef Libccnx_component_PendingInterestTable_h
+#define Libccnx_component_PendingInterestTable_h
+
+#include <ccnx/transport/transport_rta/core/rta_ProtocolStack.h>
+#include <ccnx/transport/transport_rta/core/rta_Connection.h>
+#include <ccnx/transport/transport_rta/core/rta_Component.h>
+
+/**
+ * The stack-wide pending interest table counters
+ */
+typedef struct component_pit_stats {
+    uint64_t forwarded;     /**< Interests sent down the stack */
+    uint64_t aggregated;    /**< Interests absorbed by an existing entry */
+    uint64_t satisfied;     /**< Entries satisfied by a Content Object */
+    uint64_t fanout;        /**< Extra Content Object deliveries to aggregated connections */
+    uint64_t expired;       /**< Entries removed at their Interest lifetime */
+    size_t entryCount;      /**< Entries currently in the table */
+} ComponentPitStats;
+
+extern RtaComponentOperations pit_ops;
+
+/**
+ * Copies the pending interest table counters of a protocol stack
+ *
+ * @param [in] stack A protocol stack with a PIT component
+ * @param [out] output Filled in with the current counters
+ *
+ * @return true The stack has a PIT component and output was filled in
+ * @return false The stack does not have a PIT component
+ *
+ * Example:
+ * @code
+ * {
+ *     ComponentPitStats stats;
+ *     if (component_PendingInterestTable_GetStats(stack, &stats)) {
+ *         printf("aggregated %" PRIu64 "\n", stats.aggregated);
+ *     }
+ * }
+ * @endcode
+ */
+bool component_PendingInterestTable_GetStats(RtaProtocolStack *stack, ComponentPitStats *output);
+#endif // Libccnx_component_PendingInterestTable_h
@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../component_Cache.c"
+#include <LongBow/unit-test.h>
+#include <parc/algol/parc_SafeMemory.h>
+
+#include <ccnx/transport/transport_rta/config/config_All.h>
+#include <ccnx/transport/test_tools/traffic_tools.h>
+
+#include "testrig_MockFramework.c"
+
+typedef struct test_data {
+    MockFramework *mock;
+} TestData;
+
+static CCNxTransportConfig *
+_createParams(size_t maxBytes)
+{
+    CCNxStackConfig *stackConfig = ccnxStackConfig_Create();
+
+    apiConnector_ProtocolStackConfig(stackConfig);
+    testingUpper_ProtocolStackConfig(stackConfig);
+    contentStore_ProtocolStackConfig(stackConfig, maxBytes);
+    testingLower_ProtocolStackConfig(stackConfig);
+    protocolStack_ComponentsConfigArgs(stackConfig, apiConnector_GetName(), testingUpper_GetName(), contentStore_GetName(), testingLower_GetName(), NULL);
+
+    CCNxConnectionConfig *connConfig = apiConnector_ConnectionConfig(ccnxConnectionConfig_Create());
+    testingUpper_ConnectionConfig(connConfig);
+    contentStore_ConnectionConfig(connConfig);
+    testingLower_ConnectionConfig(connConfig);
+
+    CCNxTransportConfig *result = ccnxTransportConfig_Create(stackConfig, connConfig);
+    ccnxStackConfig_Release(&stackConfig);
+    return result;
+}
+
+static TestData *
+_commonSetup(size_t maxBytes)
+{
+    TestData *data = parcMemory_AllocateAndClear(sizeof(TestData));
+    assertNotNull(data, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(TestData));
+
+    CCNxTransportConfig *config = _createParams(maxBytes);
+    data->mock = mockFramework_Create(config);
+    ccnxTransportConfig_Destroy(&config);
+    return data;
+}
+
+static void
+_commonTeardown(TestData *data)
+{
+    mockFramework_Destroy(&data->mock);
+    parcMemory_Deallocate((void **) &data);
+}
+
+static TransportMessage *
+_createContentObject(TestData *data, const char *uri, size_t payloadLength)
+{
+    CCNxName *name = ccnxName_CreateFromCString(uri);
+    PARCBuffer *payload = parcBuffer_Allocate(payloadLength);
+    CCNxContentObject *contentObject = ccnxContentObject_CreateWithNameAndPayload(name, payload);
+
+    TransportMessage *tm = transportMessage_CreateFromDictionary(contentObject);
+    transportMessage_SetInfo(tm, data->mock->connection, NULL);
+
+    ccnxContentObject_Release(&contentObject);
+    parcBuffer_Release(&payload);
+    ccnxName_Release(&name);
+    return tm;
+}
+
+static TransportMessage *
+_createInterest(TestData *data, const char *uri)
+{
+    CCNxName *name = ccnxName_CreateFromCString(uri);
+    CCNxInterest *interest = ccnxInterest_CreateSimple(name);
+
+    TransportMessage *tm = transportMessage_CreateFromDictionary(interest);
+    transportMessage_SetInfo(tm, data->mock->connection, NULL);
+
+    ccnxInterest_Release(&interest);
+    ccnxName_Release(&name);
+    return tm;
+}
+
+/**
+ * Puts a message in from the top and steps the framework.  Returns what comes out
+ * the bottom in *below and what comes back out the top in *above.
+ */
+static void
+_sendDown(TestData *data, TransportMessage *tm, TransportMessage **below, TransportMessage **above)
+{
+    PARCEventQueue *in = rtaProtocolStack_GetPutQueue(data->mock->stack, TESTING_UPPER, RTA_DOWN);
+    PARCEventQueue *lower = rtaProtocolStack_GetPutQueue(data->mock->stack, TESTING_LOWER, RTA_UP);
+    PARCEventQueue *upper = rtaProtocolStack_GetPutQueue(data->mock->stack, TESTING_UPPER, RTA_DOWN);
+
+    rtaComponent_PutMessage(in, tm);
+    rtaFramework_NonThreadedStepCount(data->mock->framework, 10);
+    *below = rtaComponent_GetMessage(lower);
+    *above = rtaComponent_GetMessage(upper);
+}
+
+static TransportMessage *
+_sendUp(TestData *data, TransportMessage *tm)
+{
+    PARCEventQueue *out = rtaProtocolStack_GetPutQueue(data->mock->stack, TESTING_UPPER, RTA_DOWN);
+    PARCEventQueue *in = rtaProtocolStack_GetPutQueue(data->mock->stack, TESTING_LOWER, RTA_UP);
+
+    rtaComponent_PutMessage(in, tm);
+    rtaFramework_NonThreadedStepCount(data->mock->framework, 10);
+    return rtaComponent_GetMessage(out);
+}
+
+static ComponentCacheStats
+_getStats(TestData *data)
+{
+    ComponentCacheStats stats;
+    bool success = component_Cache_GetStats(data->mock->stack, &stats);
+    assertTrue(success, "Stack does not have a CACHE component");
+    return stats;
+}
+
+LONGBOW_TEST_RUNNER(component_Cache)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Small);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(component_Cache)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(component_Cache)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// ==================================================================================
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, component_Cache_Downcall_Read_Miss);
+    LONGBOW_RUN_TEST_CASE(Global, component_Cache_Downcall_Read_Hit);
+    LONGBOW_RUN_TEST_CASE(Global, component_Cache_Downcall_Read_Control);
+    LONGBOW_RUN_TEST_CASE(Global, component_Cache_Upcall_Read_Replace);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    longBowTestCase_SetClipBoardData(testCase, _commonSetup(contentStore_GetDefaultMaxBytes()));
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    _commonTeardown(longBowTestCase_GetClipBoardData(testCase));
+
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, component_Cache_Downcall_Read_Miss)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    TransportMessage *below;
+    TransportMessage *above;
+
+    _sendDown(data, _createInterest(data, "lci:/cache/miss"), &below, &above);
+
+    assertNotNull(below, "Interest should have gone down the stack on a miss");
+    assertNull(above, "Nothing should come back up on a miss");
+    assertTrue(_getStats(data).misses == 1, "Expected 1 miss, got %" PRIu64, _getStats(data).misses);
+
+    transportMessage_Destroy(&below);
+}
+
+LONGBOW_TEST_CASE(Global, component_Cache_Downcall_Read_Hit)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    TransportMessage *tm = _createContentObject(data, "lci:/cache/hit", 100);
+    CCNxTlvDictionary *truth = transportMessage_GetDictionary(tm);
+    TransportMessage *test_tm = _sendUp(data, tm);
+    assertTrue(test_tm == tm, "Content object should pass up the stack");
+    transportMessage_Destroy(&test_tm);
+
+    TransportMessage *below;
+    TransportMessage *above;
+    _sendDown(data, _createInterest(data, "lci:/cache/hit"), &below, &above);
+
+    assertNull(below, "Interest should not go down the stack on a hit");
+    assertNotNull(above, "Cached content object should come back up the stack");
+    assertTrue(transportMessage_GetDictionary(above) == truth, "Cached dictionary should be shared, not copied");
+
+    ComponentCacheStats stats = _getStats(data);
+    assertTrue(stats.hits == 1, "Expected 1 hit, got %" PRIu64, stats.hits);
+    assertTrue(stats.objectCount == 1, "Expected 1 object, got %zu", stats.objectCount);
+
+    transportMessage_Destroy(&above);
+}
+
+LONGBOW_TEST_CASE(Global, component_Cache_Downcall_Read_Control)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    TransportMessage *below;
+    TransportMessage *above;
+
+    TransportMessage *tm = trafficTools_CreateTransportMessageWithDictionaryControl(data->mock->connection, CCNxTlvDictionary_SchemaVersion_V1);
+    _sendDown(data, tm, &below, &above);
+
+    assertTrue(below == tm, "Control message should pass down the stack");
+    assertTrue(_getStats(data).misses == 0, "Control messages are not lookups");
+
+    transportMessage_Destroy(&below);
+}
+
+LONGBOW_TEST_CASE(Global, component_Cache_Upcall_Read_Replace)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    TransportMessage *test_tm = _sendUp(data, _createContentObject(data, "lci:/cache/replace", 100));
+    transportMessage_Destroy(&test_tm);
+    test_tm = _sendUp(data, _createContentObject(data, "lci:/cache/replace", 100));
+    transportMessage_Destroy(&test_tm);
+
+    ComponentCacheStats stats = _getStats(data);
+    assertTrue(stats.objectCount == 1, "Same name and hash should replace, got %zu objects", stats.objectCount);
+    assertTrue(stats.inserts == 2, "Expected 2 inserts, got %" PRIu64, stats.inserts);
+}
+
+// ==================================================================================
+
+LONGBOW_TEST_FIXTURE(Small)
+{
+    LONGBOW_RUN_TEST_CASE(Small, component_Cache_Evict);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Small)
+{
+    // room for one 1000 byte object, but not two
+    longBowTestCase_SetClipBoardData(testCase, _commonSetup(1500 + 2 * sizeof(CacheEntry)));
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Small)
+{
+    _commonTeardown(longBowTestCase_GetClipBoardData(testCase));
+
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Small, component_Cache_Evict)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    TransportMessage *test_tm = _sendUp(data, _createContentObject(data, "lci:/cache/first", 1000));
+    transportMessage_Destroy(&test_tm);
+    test_tm = _sendUp(data, _createContentObject(data, "lci:/cache/second", 1000));
+    transportMessage_Destroy(&test_tm);
+
+    ComponentCacheStats stats = _getStats(data);
+    assertTrue(stats.evictions == 1, "Expected 1 eviction, got %" PRIu64, stats.evictions);
+    assertTrue(stats.objectCount == 1, "Expected 1 object, got %zu", stats.objectCount);
+    assertTrue(stats.bytesUsed <= stats.maxBytes, "Used %zu bytes over limit %zu", stats.bytesUsed, stats.maxBytes);
+
+    // the first one was evicted, so this is a miss
+    TransportMessage *below;
+    TransportMessage *above;
+    _sendDown(data, _createInterest(data, "lci:/cache/first"), &below, &above);
+    assertNotNull(below, "Evicted object should not be a hit");
+    transportMessage_Destroy(&below);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(component_Cache);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
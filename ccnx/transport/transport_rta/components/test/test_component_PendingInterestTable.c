@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../component_PendingInterestTable.c"
+#include <LongBow/unit-test.h>
+#include <parc/algol/parc_SafeMemory.h>
+
+#include <ccnx/common/internal/ccnx_InterestDefault.h>
+#include <ccnx/transport/transport_rta/config/config_All.h>
+
+#include "testrig_MockFramework.c"
+
+typedef struct test_data {
+    MockFramework *mock;
+
+    // a second connection on the same protocol stack
+    int connection_fds[2];
+    RtaConnection *connection;
+} TestData;
+
+static CCNxTransportConfig *
+_createParams(void)
+{
+    CCNxStackConfig *stackConfig = ccnxStackConfig_Create();
+
+    apiConnector_ProtocolStackConfig(stackConfig);
+    testingUpper_ProtocolStackConfig(stackConfig);
+    pendingInterestTable_ProtocolStackConfig(stackConfig);
+    testingLower_ProtocolStackConfig(stackConfig);
+    protocolStack_ComponentsConfigArgs(stackConfig, apiConnector_GetName(), testingUpper_GetName(), pendingInterestTable_GetName(), testingLower_GetName(), NULL);
+
+    CCNxConnectionConfig *connConfig = apiConnector_ConnectionConfig(ccnxConnectionConfig_Create());
+    testingUpper_ConnectionConfig(connConfig);
+    pendingInterestTable_ConnectionConfig(connConfig);
+    testingLower_ConnectionConfig(connConfig);
+
+    CCNxTransportConfig *result = ccnxTransportConfig_Create(stackConfig, connConfig);
+    ccnxStackConfig_Release(&stackConfig);
+    return result;
+}
+
+static TestData *
+_commonSetup(void)
+{
+    TestData *data = parcMemory_AllocateAndClear(sizeof(TestData));
+    assertNotNull(data, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(TestData));
+
+    CCNxTransportConfig *config = _createParams();
+    data->mock = mockFramework_Create(config);
+
+    int error = socketpair(AF_UNIX, SOCK_STREAM, 0, data->connection_fds);
+    assertFalse(error, "Error creating socket pair: (%d) %s", errno, strerror(errno));
+
+    RtaCommandOpenConnection *openConnection = rtaCommandOpenConnection_Create(data->mock->stackId, data->connection_fds[0], data->connection_fds[1],
+                                                                               ccnxConnectionConfig_GetJson(ccnxTransportConfig_GetConnectionConfig(config)));
+    _rtaFramework_ExecuteOpenConnection(data->mock->framework, openConnection);
+    rtaCommandOpenConnection_Release(&openConnection);
+
+    data->connection = rtaConnectionTable_GetByApiFd(data->mock->framework->connectionTable, data->connection_fds[0]);
+    rtaFramework_NonThreadedStep(data->mock->framework);
+
+    ccnxTransportConfig_Destroy(&config);
+    return data;
+}
+
+static void
+_commonTeardown(TestData *data)
+{
+    mockFramework_Destroy(&data->mock);
+    parcMemory_Deallocate((void **) &data);
+}
+
+static TransportMessage *
+_createInterest(RtaConnection *conn, const char *uri)
+{
+    CCNxName *name = ccnxName_CreateFromCString(uri);
+    CCNxInterest *interest = ccnxInterest_CreateSimple(name);
+
+    TransportMessage *tm = transportMessage_CreateFromDictionary(interest);
+    transportMessage_SetInfo(tm, conn, NULL);
+
+    ccnxInterest_Release(&interest);
+    ccnxName_Release(&name);
+    return tm;
+}
+
+static TransportMessage *
+_createContentObject(RtaConnection *conn, const char *uri)
+{
+    CCNxName *name = ccnxName_CreateFromCString(uri);
+    PARCBuffer *payload = parcBuffer_Allocate(10);
+    CCNxContentObject *contentObject = ccnxContentObject_CreateWithNameAndPayload(name, payload);
+
+    TransportMessage *tm = transportMessage_CreateFromDictionary(contentObject);
+    transportMessage_SetInfo(tm, conn, NULL);
+
+    ccnxContentObject_Release(&contentObject);
+    parcBuffer_Release(&payload);
+    ccnxName_Release(&name);
+    return tm;
+}
+
+static TransportMessage *
+_sendDown(TestData *data, TransportMessage *tm)
+{
+    PARCEventQueue *in = rtaProtocolStack_GetPutQueue(data->mock->stack, TESTING_UPPER, RTA_DOWN);
+    PARCEventQueue *out = rtaProtocolStack_GetPutQueue(data->mock->stack, TESTING_LOWER, RTA_UP);
+
+    rtaComponent_PutMessage(in, tm);
+    rtaFramework_NonThreadedStepCount(data->mock->framework, 10);
+    return rtaComponent_GetMessage(out);
+}
+
+static void
+_sendUp(TestData *data, TransportMessage *tm)
+{
+    PARCEventQueue *in = rtaProtocolStack_GetPutQueue(data->mock->stack, TESTING_LOWER, RTA_UP);
+    rtaComponent_PutMessage(in, tm);
+    rtaFramework_NonThreadedStepCount(data->mock->framework, 10);
+}
+
+static TransportMessage *
+_receiveUp(TestData *data)
+{
+    PARCEventQueue *out = rtaProtocolStack_GetPutQueue(data->mock->stack, TESTING_UPPER, RTA_DOWN);
+    return rtaComponent_GetMessage(out);
+}
+
+static ComponentPitStats
+_getStats(TestData *data)
+{
+    ComponentPitStats stats;
+    bool success = component_PendingInterestTable_GetStats(data->mock->stack, &stats);
+    assertTrue(success, "Stack does not have a PIT component");
+    return stats;
+}
+
+LONGBOW_TEST_RUNNER(component_PendingInterestTable)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(component_PendingInterestTable)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(component_PendingInterestTable)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// ==================================================================================
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, component_Pit_Aggregate);
+    LONGBOW_RUN_TEST_CASE(Global, component_Pit_Retransmission);
+    LONGBOW_RUN_TEST_CASE(Global, component_Pit_FanOut);
+    LONGBOW_RUN_TEST_CASE(Global, component_Pit_Expire);
+    LONGBOW_RUN_TEST_CASE(Global, component_Pit_Closer);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    longBowTestCase_SetClipBoardData(testCase, _commonSetup());
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    _commonTeardown(longBowTestCase_GetClipBoardData(testCase));
+
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, component_Pit_Aggregate)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    TransportMessage *first = _sendDown(data, _createInterest(data->mock->connection, "lci:/pit/aggregate"));
+    assertNotNull(first, "First interest should go down the stack");
+    transportMessage_Destroy(&first);
+
+    TransportMessage *second = _sendDown(data, _createInterest(data->connection, "lci:/pit/aggregate"));
+    assertNull(second, "Second interest from another connection should be aggregated");
+
+    ComponentPitStats stats = _getStats(data);
+    assertTrue(stats.aggregated == 1, "Expected 1 aggregated, got %" PRIu64, stats.aggregated);
+    assertTrue(stats.forwarded == 1, "Expected 1 forwarded, got %" PRIu64, stats.forwarded);
+    assertTrue(stats.entryCount == 1, "Expected 1 entry, got %zu", stats.entryCount);
+}
+
+LONGBOW_TEST_CASE(Global, component_Pit_Retransmission)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    TransportMessage *first = _sendDown(data, _createInterest(data->mock->connection, "lci:/pit/retransmit"));
+    assertNotNull(first, "First interest should go down the stack");
+    transportMessage_Destroy(&first);
+
+    TransportMessage *second = _sendDown(data, _createInterest(data->mock->connection, "lci:/pit/retransmit"));
+    assertNotNull(second, "Retransmission from the same connection should go down the stack");
+    transportMessage_Destroy(&second);
+
+    ComponentPitStats stats = _getStats(data);
+    assertTrue(stats.aggregated == 0, "Expected 0 aggregated, got %" PRIu64, stats.aggregated);
+    assertTrue(stats.forwarded == 2, "Expected 2 forwarded, got %" PRIu64, stats.forwarded);
+}
+
+LONGBOW_TEST_CASE(Global, component_Pit_FanOut)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    TransportMessage *first = _sendDown(data, _createInterest(data->mock->connection, "lci:/pit/fanout"));
+    transportMessage_Destroy(&first);
+    TransportMessage *second = _sendDown(data, _createInterest(data->connection, "lci:/pit/fanout"));
+    assertNull(second, "Second interest should be aggregated");
+
+    TransportMessage *content = _createContentObject(data->mock->connection, "lci:/pit/fanout");
+    CCNxTlvDictionary *truth = transportMessage_GetDictionary(content);
+    _sendUp(data, content);
+
+    // one message for each connection, in either order
+    TransportMessage *a = _receiveUp(data);
+    TransportMessage *b = _receiveUp(data);
+    assertNotNull(a, "Expected a content object up the stack");
+    assertNotNull(b, "Expected a second content object up the stack");
+    assertTrue(transportMessage_GetDictionary(a) == truth && transportMessage_GetDictionary(b) == truth,
+               "Fan out should share the dictionary, not copy it");
+    assertTrue(rtaConnection_GetFromTransport(a) != rtaConnection_GetFromTransport(b),
+               "Each connection should get the content object once");
+
+    ComponentPitStats stats = _getStats(data);
+    assertTrue(stats.fanout == 1, "Expected 1 fanout, got %" PRIu64, stats.fanout);
+    assertTrue(stats.satisfied == 1, "Expected 1 satisfied, got %" PRIu64, stats.satisfied);
+    assertTrue(stats.entryCount == 0, "Expected 0 entries, got %zu", stats.entryCount);
+
+    transportMessage_Destroy(&a);
+    transportMessage_Destroy(&b);
+}
+
+LONGBOW_TEST_CASE(Global, component_Pit_Expire)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    TransportMessage *first = _sendDown(data, _createInterest(data->mock->connection, "lci:/pit/expire"));
+    transportMessage_Destroy(&first);
+
+    PitState *pit = rtaProtocolStack_GetPrivateData(data->mock->stack, PIT);
+    pit->framework->clock_ticks += _pit_LifetimeToTicks(ccnxInterestDefault_LifetimeMilliseconds) + 1;
+
+    // the entry has expired, so the second interest is not aggregated
+    TransportMessage *second = _sendDown(data, _createInterest(data->connection, "lci:/pit/expire"));
+    assertNotNull(second, "Interest matching an expired entry should go down the stack");
+    transportMessage_Destroy(&second);
+
+    ComponentPitStats stats = _getStats(data);
+    assertTrue(stats.expired == 1, "Expected 1 expired, got %" PRIu64, stats.expired);
+}
+
+LONGBOW_TEST_CASE(Global, component_Pit_Closer)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    TransportMessage *first = _sendDown(data, _createInterest(data->mock->connection, "lci:/pit/close"));
+    transportMessage_Destroy(&first);
+    TransportMessage *second = _sendDown(data, _createInterest(data->connection, "lci:/pit/close"));
+    assertNull(second, "Second interest should be aggregated");
+
+    // the forwarding connection goes away, so the entry goes away
+    component_Pit_Closer(data->mock->connection);
+
+    ComponentPitStats stats = _getStats(data);
+    assertTrue(stats.entryCount == 0, "Expected 0 entries, got %zu", stats.entryCount);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(component_PendingInterestTable);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -69,7 +69,7 @@
 #endif
 
 typedef struct mock_framework {
-    PARCRingBuffer1x1*commandRingBuffer;
+    RtaCommandQueue *commandQueue;
     PARCNotifier     *commandNotifier;
     RtaFramework     *framework;
 
@@ -91,9 +91,9 @@ mockFramework_Create(CCNxTransportConfig *config)
     mock->transport_config = ccnxTransportConfig_Copy(config);
     assertNotNull(mock->transport_config, "%s got null params from createParams\n", __func__);
 
-    mock->commandRingBuffer = parcRingBuffer1x1_Create(128, NULL);
+    mock->commandQueue = rtaCommandQueue_Create(128);
     mock->commandNotifier = parcNotifier_Create();
-    mock->framework = rtaFramework_Create(mock->commandRingBuffer, mock->commandNotifier);
+    mock->framework = rtaFramework_Create(mock->commandQueue, mock->commandNotifier);
 
     // Create the protocol stack
 
@@ -130,7 +130,7 @@ mockFramework_Destroy(MockFramework **mockPtr)
 
     rtaFramework_Teardown(mock->framework);
 
-    parcRingBuffer1x1_Release(&mock->commandRingBuffer);
+    rtaCommandQueue_Release(&mock->commandQueue);
     parcNotifier_Release(&mock->commandNotifier);
 
     rtaFramework_Destroy(&mock->framework);
@@ -70,15 +70,21 @@
 
 #include <ccnx/transport/transport_rta/config/config_ApiConnector.h>
 
+#include <ccnx/transport/transport_rta/config/config_Cache.h>
+
 #include <ccnx/transport/transport_rta/config/config_Codec_Tlv.h>
 #include <ccnx/transport/transport_rta/config/config_CryptoCache.h>
 
+#include <ccnx/transport/transport_rta/config/config_FlowControl_Pipeline.h>
 #include <ccnx/transport/transport_rta/config/config_FlowControl_Vegas.h>
 #include <ccnx/transport/transport_rta/config/config_Forwarder_Local.h>
 #include <ccnx/transport/transport_rta/config/config_Forwarder_Metis.h>
+#include <ccnx/transport/transport_rta/config/config_Forwarder_Simulated.h>
 
 #include <ccnx/transport/transport_rta/config/config_InMemoryVerifier.h>
 
+#include <ccnx/transport/transport_rta/config/config_PendingInterestTable.h>
+
 #include <ccnx/transport/transport_rta/config/config_ProtocolStack.h>
 #include <ccnx/transport/transport_rta/config/config_PublicKeySigner.h>
 
@@ -59,9 +59,28 @@
 #include <config.h>
 #include <stdio.h>
 
+#include <LongBow/runtime.h>
+
 #include "config_ApiConnector.h"
 
 #include <ccnx/transport/transport_rta/core/components.h>
+#include <ccnx/transport/transport_rta/core/rta_SendQueue.h>
+
+static const char param_SEND_QUEUE_DEPTH[] = "sendQueueDepth";      // integer, messages
+static const char param_RECEIVE_BUFFER[] = "receiveBuffer";         // integer, bytes
+static const char param_SEND_BUFFER[] = "sendBuffer";               // integer, bytes
+static const char param_WRITE_WATERMARK[] = "writeWatermark";       // integer, bytes
+
+#define MAX_QUEUE_DEPTH   65536
+#define MAX_BUFFER_BYTES  (16 * 1024 * 1024)
+
+// We only put an 8-byte pointer on the socket pair, so these were sized in pointers
+static const ApiConnectorQueueConfig default_queue_config = {
+    .sendQueueDepth      = RTA_SEND_QUEUE_DEFAULT_CAPACITY,
+    .receiveBufferBytes  = sizeof(void *) * 128,
+    .sendBufferBytes     = 1000 * 8,
+    .writeWatermarkBytes = 400
+};
 
 /**
  * Generates:
@@ -88,6 +107,78 @@ apiConnector_ConnectionConfig(CCNxConnectionConfig *connectionConfig)
     return result;
 }
 
+/**
+ * Generates:
+ *
+ * { "API_CONNECTOR" : { "sendQueueDepth" : n, "receiveBuffer" : n, "sendBuffer" : n, "writeWatermark" : n } }
+ */
+CCNxConnectionConfig *
+apiConnector_QueueConnectionConfig(CCNxConnectionConfig *connectionConfig, const ApiConnectorQueueConfig *queueConfig)
+{
+    assertNotNull(queueConfig, "Parameter queueConfig must be non-null");
+
+    PARCJSON *json = parcJSON_Create();
+    parcJSON_AddInteger(json, param_SEND_QUEUE_DEPTH, (int64_t) queueConfig->sendQueueDepth);
+    parcJSON_AddInteger(json, param_RECEIVE_BUFFER, (int64_t) queueConfig->receiveBufferBytes);
+    parcJSON_AddInteger(json, param_SEND_BUFFER, (int64_t) queueConfig->sendBufferBytes);
+    parcJSON_AddInteger(json, param_WRITE_WATERMARK, (int64_t) queueConfig->writeWatermarkBytes);
+
+    PARCJSONValue *value = parcJSONValue_CreateFromJSON(json);
+    parcJSON_Release(&json);
+    CCNxConnectionConfig *result = ccnxConnectionConfig_Add(connectionConfig, apiConnector_GetName(), value);
+    parcJSONValue_Release(&value);
+
+    return result;
+}
+
+const ApiConnectorQueueConfig *
+apiConnector_GetDefaultQueueConfig(void)
+{
+    return &default_queue_config;
+}
+
+/*
+ * Reads one size if the connection sets it.  Returns false if it is outside [min, max].
+ */
+static bool
+_apiConnector_GetSize(PARCJSON *componentJson, const char *key, size_t min, size_t max, size_t *output)
+{
+    PARCJSONValue *value = parcJSON_GetValueByName(componentJson, key);
+    if (value == NULL) {
+        return true;
+    }
+
+    assertTrue(parcJSONValue_IsNumber(value), "JSON key %s must be type NUMBER", key);
+    int64_t size = parcJSONValue_GetInteger(value);
+    if (size < (int64_t) min || size > (int64_t) max) {
+        return false;
+    }
+    *output = (size_t) size;
+    return true;
+}
+
+bool
+apiConnector_GetQueueConfigFromConfig(PARCJSON *json, ApiConnectorQueueConfig *output)
+{
+    assertNotNull(output, "Parameter output must be non-null");
+
+    *output = default_queue_config;
+
+    PARCJSONValue *value = (json == NULL) ? NULL : parcJSON_GetValueByName(json, apiConnector_GetName());
+    if (value == NULL || !parcJSONValue_IsJSON(value)) {
+        return true;
+    }
+
+    PARCJSON *componentJson = parcJSONValue_GetJSON(value);
+    bool valid = _apiConnector_GetSize(componentJson, param_SEND_QUEUE_DEPTH, 2, MAX_QUEUE_DEPTH, &output->sendQueueDepth) &&
+                 _apiConnector_GetSize(componentJson, param_RECEIVE_BUFFER, 256, MAX_BUFFER_BYTES, &output->receiveBufferBytes) &&
+                 _apiConnector_GetSize(componentJson, param_SEND_BUFFER, 1024, MAX_BUFFER_BYTES, &output->sendBufferBytes) &&
+                 _apiConnector_GetSize(componentJson, param_WRITE_WATERMARK, sizeof(void *), MAX_BUFFER_BYTES, &output->writeWatermarkBytes);
+
+    // A watermark above the socket buffer would never be crossed on the way down
+    return valid && output->writeWatermarkBytes <= output->sendBufferBytes;
+}
+
 const char *
 apiConnector_GetName(void)
 {
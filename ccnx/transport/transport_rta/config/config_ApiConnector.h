@@ -82,8 +82,32 @@
 #ifndef Libccnx_config_ApiConnector_h
 #define Libccnx_config_ApiConnector_h
 
+#include <stdbool.h>
+#include <stddef.h>
+
 #include <ccnx/transport/common/ccnx_TransportConfig.h>
 
+/**
+ * @typedef ApiConnectorQueueConfig
+ * @abstract The queue sizes between the application and one connection's stack
+ * @discussion
+ * A bulk transfer wants deep queues so the stack is never starved, an interactive
+ * application wants shallow ones so a message does not wait behind a backlog.
+ *
+ * @constant sendQueueDepth Messages rtaTransport_Send() can queue before it waits (2 to 65536, rounded up to a power of 2)
+ * @constant receiveBufferBytes SO_RCVBUF of both ends of the socket pair (256 bytes to 16 MB),
+ *           or the capacity in pointers of the queue of an inline transport
+ * @constant sendBufferBytes SO_SNDBUF of the Transport's end of the socket pair (1024 bytes to 16 MB)
+ * @constant writeWatermarkBytes When the API connector's write queue falls below this many bytes,
+ *           the connection is unblocked in the UP direction (one pointer to `sendBufferBytes`)
+ */
+typedef struct api_connector_queue_config {
+    size_t sendQueueDepth;
+    size_t receiveBufferBytes;
+    size_t sendBufferBytes;
+    size_t writeWatermarkBytes;
+} ApiConnectorQueueConfig;
+
 /**
  * Generates the configuration settings included in the Protocol Stack configuration
  *
@@ -117,6 +141,67 @@ CCNxStackConfig *apiConnector_ProtocolStackConfig(CCNxStackConfig *stackConfig);
  */
 CCNxConnectionConfig *apiConnector_ConnectionConfig(CCNxConnectionConfig *config);
 
+/**
+ * Generates a connection configuration with the given queue sizes
+ *
+ * Use it instead of apiConnector_ConnectionConfig(), not with it.
+ *
+ * { "API_CONNECTOR" : { "sendQueueDepth" : 128, "receiveBuffer" : 1024, "sendBuffer" : 8000, "writeWatermark" : 400 } }
+ *
+ * @param [in] config A pointer to a valid CCNxConnectionConfig instance.
+ * @param [in] queueConfig The sizes, see apiConnector_GetDefaultQueueConfig()
+ *
+ * @return non-null The modified `CCNxConnectionConfig`
+ *
+ * Example:
+ * @code
+ * {
+ *     ApiConnectorQueueConfig queueConfig = *apiConnector_GetDefaultQueueConfig();
+ *     queueConfig.sendQueueDepth = 4096;
+ *     queueConfig.receiveBufferBytes = 1024 * 1024;
+ *     apiConnector_QueueConnectionConfig(connConfig, &queueConfig);
+ * }
+ * @endcode
+ */
+CCNxConnectionConfig *apiConnector_QueueConnectionConfig(CCNxConnectionConfig *config, const ApiConnectorQueueConfig *queueConfig);
+
+/**
+ * The queue sizes of a connection that does not configure them
+ *
+ * @return non-null 128 messages, a receive buffer of 128 pointers, an 8000 byte send buffer and a 400 byte watermark
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+const ApiConnectorQueueConfig *apiConnector_GetDefaultQueueConfig(void);
+
+/**
+ * Reads the queue sizes of a connection
+ *
+ * Sizes the connection does not set keep their defaults.  A size outside its range makes
+ * the whole configuration invalid, rather than being clamped to something the application
+ * did not ask for.
+ *
+ * @param [in] connectionJson The connection parameters, e.g. from ccnxConnectionConfig_GetJson()
+ * @param [out] output Filled in with the sizes
+ *
+ * @return true Every size is valid
+ * @return false A size is out of range, `output` is not usable
+ *
+ * Example:
+ * @code
+ * {
+ *     ApiConnectorQueueConfig queueConfig;
+ *     if (!apiConnector_GetQueueConfigFromConfig(rtaConnection_GetParameters(conn), &queueConfig)) {
+ *         // reject the connection
+ *     }
+ * }
+ * @endcode
+ */
+bool apiConnector_GetQueueConfigFromConfig(PARCJSON *connectionJson, ApiConnectorQueueConfig *output);
+
 /**
  * Returns the text string for this component
  *
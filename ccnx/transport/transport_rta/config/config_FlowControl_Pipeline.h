@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file config_FlowControl_Pipeline.h
+ * @brief Generates stack and connection configuration information
+ *
+ * Each component in the protocol stack must have a configuration element.
+ * This module generates the configuration elements for the FC_PIPELINE flow controller.
+ *
+ * The pipeline flow controller uses the same sessions, window, and re-expression as Vegas,
+ * but takes its congestion control algorithm from the connection configuration, so each
+ * connection on a stack may use a different algorithm.  The algorithms are:
+ *
+ *   - "cubic": a loss-based CUBIC window (the default)
+ *   - "bbr": a rate and RTT based estimator that sizes the window to the measured
+ *     bandwidth-delay product
+ *   - "vegas": the delay-based Vegas algorithm of FC_VEGAS
+ *
+ * @code
+ * {
+ *      // Configure a stack with {APIConnector,Pipeline,TLVCodec,MetisConnector}
+ *
+ *      stackConfig = ccnxStackConfig_Create();
+ *      connConfig = ccnxConnectionConfig_Create();
+ *
+ *      apiConnector_ProtocolStackConfig(stackConfig);
+ *      apiConnector_ConnectionConfig(connConfig);
+ *      pipelineFlowController_ProtocolStackConfig(stackConfig);
+ *      pipelineFlowController_ConnectionConfig(connConfig, pipelineFlowController_AlgorithmBbr);
+ *      tlvCodec_ProtocolStackConfig(stackConfig);
+ *      tlvCodec_ConnectionConfig(connConfig);
+ *      metisForwarder_ProtocolStackConfig(stackConfig);
+ *      metisForwarder_ConnectionConfig(connConfig, metisForwarder_GetDefaultPort());
+ *
+ *      CCNxTransportConfig *config = ccnxTransportConfig_Create(stackConfig, connConfig);
+ * }
+ * @endcode
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+#ifndef Libccnx_config_FlowControl_Pipeline_h
+#define Libccnx_config_FlowControl_Pipeline_h
+
+#include <stdbool.h>
+
+#include <ccnx/transport/common/ccnx_TransportConfig.h>
+
+extern const char pipelineFlowController_AlgorithmCubic[];
+extern const char pipelineFlowController_AlgorithmBbr[];
+extern const char pipelineFlowController_AlgorithmVegas[];
+
+/**
+ * Generates the configuration settings included in the Protocol Stack configuration
+ *
+ * Adds configuration elements to the Protocol Stack configuration
+ *
+ * { "FC_PIPELINE" : { } }
+ *
+ * @param [in] stackConfig The protocl stack configuration to update
+ *
+ * @return non-null The updated protocol stack configuration
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+CCNxStackConfig *pipelineFlowController_ProtocolStackConfig(CCNxStackConfig *stackConfig);
+
+/**
+ * Generates the configuration settings included in the Connection configuration
+ *
+ * Adds configuration elements to the `CCNxConnectionConfig`
+ *
+ * { "FC_PIPELINE" : { "algorithm" : algorithm } }
+ *
+ * The algorithm is checked here, on the caller's thread, so a misspelled name traps before
+ * the configuration reaches the Transport.
+ *
+ * @param [in] config The CCNxConnectionConfig instance
+ * @param [in] algorithm One of pipelineFlowController_AlgorithmCubic, _AlgorithmBbr, or _AlgorithmVegas
+ *
+ * @return non-null The modified `CCNxConnectionConfig`
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+CCNxConnectionConfig *pipelineFlowController_ConnectionConfig(CCNxConnectionConfig *config, const char *algorithm);
+
+/**
+ * Returns the text string for this component
+ *
+ * Used as the text key to a JSON block.  You do not need to free it.
+ *
+ * @return non-null A text string unique to this component
+ *
+ */
+const char *pipelineFlowController_GetName(void);
+
+/**
+ * Determines if `name` is one of the pipeline congestion control algorithms
+ *
+ * @param [in] name An algorithm name
+ *
+ * @return true The name is pipelineFlowController_AlgorithmCubic, _AlgorithmBbr, or _AlgorithmVegas
+ * @return false Unknown name
+ *
+ * Example:
+ * @code
+ * {
+ *     bool valid = pipelineFlowController_IsAlgorithm("bbr");
+ * }
+ * @endcode
+ */
+bool pipelineFlowController_IsAlgorithm(const char *name);
+
+/**
+ * Returns the congestion control algorithm from the connection configuration
+ *
+ * If the configuration does not name an algorithm, returns pipelineFlowController_AlgorithmCubic.
+ * The returned string points in to the JSON and is valid as long as the JSON.
+ *
+ * @param [in] json The connection configuration, e.g. from rtaConnection_GetParameters()
+ *
+ * @return non-null The algorithm name
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+const char *pipelineFlowController_GetAlgorithmFromConfig(PARCJSON *json);
+#endif // Libccnx_config_FlowControl_Pipeline_h
@@ -55,10 +55,15 @@
 
 #include <config.h>
 #include <stdio.h>
+
+#include <LongBow/runtime.h>
+
 #include "config_FlowControl_Vegas.h"
 
 #include <ccnx/transport/transport_rta/core/components.h>
 
+static const char param_PACING[] = "pacing";        // boolean
+
 /**
  * Generates:
  *
@@ -82,6 +87,41 @@ vegasFlowController_ConnectionConfig(CCNxConnectionConfig *connectionConfig)
     return result;
 }
 
+/**
+ * Generates:
+ *
+ * { "FC_VEGAS" : { "pacing" : true } }
+ */
+CCNxConnectionConfig *
+vegasFlowController_PacedConnectionConfig(CCNxConnectionConfig *connectionConfig)
+{
+    PARCJSON *json = parcJSON_Create();
+    parcJSON_AddBoolean(json, param_PACING, true);
+    PARCJSONValue *value = parcJSONValue_CreateFromJSON(json);
+    parcJSON_Release(&json);
+    CCNxConnectionConfig *result = ccnxConnectionConfig_Add(connectionConfig, vegasFlowController_GetName(), value);
+    parcJSONValue_Release(&value);
+    return result;
+}
+
+bool
+vegasFlowController_GetPacingFromConfig(PARCJSON *json, const char *componentName)
+{
+    bool pacing = false;
+
+    PARCJSONValue *value = parcJSON_GetValueByName(json, componentName);
+    if (value != NULL && parcJSONValue_IsJSON(value)) {
+        PARCJSON *componentJson = parcJSONValue_GetJSON(value);
+        value = parcJSON_GetValueByName(componentJson, param_PACING);
+        if (value != NULL) {
+            assertTrue(parcJSONValue_IsBoolean(value), "JSON key %s must be type BOOLEAN", param_PACING);
+            pacing = parcJSONValue_GetBoolean(value);
+        }
+    }
+
+    return pacing;
+}
+
 const char *
 vegasFlowController_GetName(void)
 {
@@ -85,6 +85,7 @@
 #ifndef Libccnx_config_FlowControl_Vegas_h
 #define Libccnx_config_FlowControl_Vegas_h
 
+#include <stdbool.h>
 #include <ccnx/transport/common/ccnx_TransportConfig.h>
 
 /**
@@ -121,6 +122,48 @@ CCNxStackConfig *vegasFlowController_ProtocolStackConfig(CCNxStackConfig *stackC
  */
 CCNxConnectionConfig *vegasFlowController_ConnectionConfig(CCNxConnectionConfig *config);
 
+/**
+ * Generates a connection configuration with Interest pacing enabled
+ *
+ * Without pacing, a session sends every Interest the congestion window allows back-to-back.
+ * With pacing, a session spreads them over the smoothed RTT at a rate of cwnd/SRTT.
+ *
+ * { "FC_VEGAS" : { "pacing" : true } }
+ *
+ * @param [in] config The CCNxConnectionConfig instance
+ *
+ * @return non-null The modified `CCNxConnectionConfig`
+ *
+ * Example:
+ * @code
+ * {
+ *     vegasFlowController_PacedConnectionConfig(connConfig);
+ * }
+ * @endcode
+ */
+CCNxConnectionConfig *vegasFlowController_PacedConnectionConfig(CCNxConnectionConfig *config);
+
+/**
+ * Determines if Interest pacing is enabled for a flow controller
+ *
+ * Both FC_VEGAS and FC_PIPELINE accept the "pacing" key in their connection
+ * configuration, so the caller gives the component name to look under.
+ *
+ * @param [in] connectionJson The connection parameters, e.g. from rtaConnection_GetParameters()
+ * @param [in] componentName The component's JSON key, e.g. vegasFlowController_GetName()
+ *
+ * @return true The component has "pacing" : true
+ * @return false Pacing is not configured or is false
+ *
+ * Example:
+ * @code
+ * {
+ *     bool pacing = vegasFlowController_GetPacingFromConfig(rtaConnection_GetParameters(conn), vegasFlowController_GetName());
+ * }
+ * @endcode
+ */
+bool vegasFlowController_GetPacingFromConfig(PARCJSON *connectionJson, const char *componentName);
+
 /**
  * Returns the text string for this component
  *
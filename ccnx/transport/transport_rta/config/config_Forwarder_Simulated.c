@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2014, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+#include <config.h>
+#include <LongBow/runtime.h>
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "config_Forwarder_Simulated.h"
+#include <ccnx/transport/transport_rta/core/components.h>
+
+static const char param_DELAY_USEC[] = "delayUsec";
+static const char param_BYTES_PER_SECOND[] = "bytesPerSecond";
+static const char param_BUFFER_BYTES[] = "bufferBytes";
+static const char param_LOSS_PPM[] = "lossPpm";
+static const char param_REORDER_PPM[] = "reorderPpm";
+static const char param_REORDER_USEC[] = "reorderUsec";
+static const char param_PAYLOAD_SIZE[] = "payloadSize";
+static const char param_FINAL_CHUNK[] = "finalChunk";
+static const char param_SEED[] = "seed";
+
+void
+simulatedForwarder_DefaultParams(SimulatedForwarderParams *params)
+{
+    assertNotNull(params, "Parameter params must be non-null");
+
+    params->delayUsec = 10000;
+    params->bytesPerSecond = 1250000;
+    params->bufferBytes = 65536;
+    params->lossPpm = 0;
+    params->reorderPpm = 0;
+    params->reorderUsec = 0;
+    params->payloadSize = 1024;
+    params->finalChunk = UINT64_MAX;
+    params->seed = 1;
+}
+
+/**
+ * Generates:
+ *
+ * { "FWD_SIMULATED" : { "delayUsec" : delay, ... } }
+ */
+CCNxStackConfig *
+simulatedForwarder_ProtocolStackConfig(CCNxStackConfig *stackConfig, const SimulatedForwarderParams *params)
+{
+    assertNotNull(params, "Parameter params must be non-null");
+
+    PARCJSON *json = parcJSON_Create();
+    parcJSON_AddInteger(json, param_DELAY_USEC, (int64_t) params->delayUsec);
+    parcJSON_AddInteger(json, param_BYTES_PER_SECOND, (int64_t) params->bytesPerSecond);
+    parcJSON_AddInteger(json, param_BUFFER_BYTES, (int64_t) params->bufferBytes);
+    parcJSON_AddInteger(json, param_LOSS_PPM, params->lossPpm);
+    parcJSON_AddInteger(json, param_REORDER_PPM, params->reorderPpm);
+    parcJSON_AddInteger(json, param_REORDER_USEC, (int64_t) params->reorderUsec);
+    parcJSON_AddInteger(json, param_PAYLOAD_SIZE, (int64_t) params->payloadSize);
+    if (params->finalChunk != UINT64_MAX) {
+        parcJSON_AddInteger(json, param_FINAL_CHUNK, (int64_t) params->finalChunk);
+    }
+    parcJSON_AddInteger(json, param_SEED, params->seed);
+
+    PARCJSONValue *value = parcJSONValue_CreateFromJSON(json);
+    parcJSON_Release(&json);
+    CCNxStackConfig *result = ccnxStackConfig_Add(stackConfig, simulatedForwarder_GetName(), value);
+    parcJSONValue_Release(&value);
+
+    return result;
+}
+
+/**
+ * Generates:
+ *
+ * { "FWD_SIMULATED" : { } }
+ */
+CCNxConnectionConfig *
+simulatedForwarder_ConnectionConfig(CCNxConnectionConfig *connConfig)
+{
+    PARCJSONValue *value = parcJSONValue_CreateFromNULL();
+    CCNxConnectionConfig *result = ccnxConnectionConfig_Add(connConfig, simulatedForwarder_GetName(), value);
+    parcJSONValue_Release(&value);
+    return result;
+}
+
+const char *
+simulatedForwarder_GetName(void)
+{
+    return RtaComponentNames[FWD_SIMULATED];
+}
+
+/*
+ * Overwrites *output with the value of `key`, if present
+ */
+static void
+_simulatedForwarder_GetInteger(PARCJSON *json, const char *key, uint64_t *output)
+{
+    PARCJSONValue *value = parcJSON_GetValueByName(json, key);
+    if (value != NULL) {
+        int64_t configured = parcJSONValue_GetInteger(value);
+        assertTrue(configured >= 0, "Invalid %s %" PRId64, key, configured);
+        *output = (uint64_t) configured;
+    }
+}
+
+void
+simulatedForwarder_GetParamsFromConfig(PARCJSON *stackJson, SimulatedForwarderParams *params)
+{
+    simulatedForwarder_DefaultParams(params);
+
+    PARCJSONValue *value = parcJSON_GetValueByName(stackJson, simulatedForwarder_GetName());
+    if (value != NULL && parcJSONValue_IsJSON(value)) {
+        PARCJSON *json = parcJSONValue_GetJSON(value);
+
+        uint64_t lossPpm = params->lossPpm;
+        uint64_t reorderPpm = params->reorderPpm;
+        uint64_t seed = params->seed;
+
+        _simulatedForwarder_GetInteger(json, param_DELAY_USEC, &params->delayUsec);
+        _simulatedForwarder_GetInteger(json, param_BYTES_PER_SECOND, &params->bytesPerSecond);
+        _simulatedForwarder_GetInteger(json, param_BUFFER_BYTES, &params->bufferBytes);
+        _simulatedForwarder_GetInteger(json, param_LOSS_PPM, &lossPpm);
+        _simulatedForwarder_GetInteger(json, param_REORDER_PPM, &reorderPpm);
+        _simulatedForwarder_GetInteger(json, param_REORDER_USEC, &params->reorderUsec);
+        _simulatedForwarder_GetInteger(json, param_PAYLOAD_SIZE, &params->payloadSize);
+        _simulatedForwarder_GetInteger(json, param_FINAL_CHUNK, &params->finalChunk);
+        _simulatedForwarder_GetInteger(json, param_SEED, &seed);
+
+        assertTrue(lossPpm <= 1000000, "Invalid %s %" PRIu64, param_LOSS_PPM, lossPpm);
+        assertTrue(reorderPpm <= 1000000, "Invalid %s %" PRIu64, param_REORDER_PPM, reorderPpm);
+
+        params->lossPpm = (uint32_t) lossPpm;
+        params->reorderPpm = (uint32_t) reorderPpm;
+        params->seed = (uint32_t) seed;
+    }
+}
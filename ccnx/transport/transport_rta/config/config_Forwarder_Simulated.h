@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2013-2014, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file config_Forwarder_Simulated.h
+ * @brief Generates stack and connection configuration information
+ *
+ * Each component in the protocol stack must have a configuration element.
+ * This module generates the configuration elements for the simulated forwarder.
+ *
+ * The simulated forwarder stands in for FWD_METIS at the bottom of a stack.  Its
+ * parameters describe one link shared by every connection of the stack, and the
+ * producer at the far end of it, so they are part of the protocol stack configuration.
+ *
+ * @code
+ * {
+ *      // Configure a stack with {APIConnector,Vegas,TLVCodec,SimulatedForwarder}
+ *
+ *      stackConfig = ccnxStackConfig_Create();
+ *      connConfig = ccnxConnectionConfig_Create();
+ *
+ *      SimulatedForwarderParams params;
+ *      simulatedForwarder_DefaultParams(&params);
+ *      params.delayUsec = 20000;
+ *      params.lossPpm = 1000;
+ *
+ *      apiConnector_ProtocolStackConfig(stackConfig);
+ *      apiConnector_ConnectionConfig(connConfig);
+ *      vegasFlowController_ProtocolStackConfig(stackConfig);
+ *      vegasFlowController_ConnectionConfig(connConfig);
+ *      tlvCodec_ProtocolStackConfig(stackConfig);
+ *      tlvCodec_ConnectionConfig(connConfig);
+ *      simulatedForwarder_ProtocolStackConfig(stackConfig, &params);
+ *      simulatedForwarder_ConnectionConfig(connConfig);
+ *
+ *      CCNxTransportConfig *config = ccnxTransportConfig_Create(stackConfig, connConfig);
+ * }
+ * @endcode
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+#ifndef Libccnx_config_Forwarder_Simulated_h
+#define Libccnx_config_Forwarder_Simulated_h
+
+#include <stdint.h>
+#include <ccnx/transport/common/ccnx_TransportConfig.h>
+
+/**
+ * The link and producer modelled by FWD_SIMULATED
+ *
+ * Both directions of the link have the same delay, rate and buffer.  Loss and reordering
+ * are in parts per million so that a run only uses integer arithmetic.
+ */
+typedef struct simulated_forwarder_params {
+    uint64_t delayUsec;         /**< One-way propagation delay */
+    uint64_t bytesPerSecond;    /**< Rate of each direction, 0 for no limit */
+    uint64_t bufferBytes;       /**< Bytes waiting to be sent in each direction before tail drop, 0 for no limit */
+    uint32_t lossPpm;           /**< Packets lost per million */
+    uint32_t reorderPpm;        /**< Packets per million held back by reorderUsec */
+    uint64_t reorderUsec;       /**< Extra delay of a reordered packet */
+    uint64_t payloadSize;       /**< Payload bytes of each Content Object the producer sends */
+    uint64_t finalChunk;        /**< FinalChunkNumber of the Content Objects, UINT64_MAX for none */
+    uint32_t seed;              /**< Seed of the loss and reorder decisions */
+} SimulatedForwarderParams;
+
+/**
+ * Fills in the default parameters
+ *
+ * A 10 Mbps link with 10 msec of one-way delay, a 64 KB buffer, no loss or reordering,
+ * and a producer of 1024 byte Content Objects with no final chunk.
+ *
+ * @param [out] params The parameters to fill in
+ *
+ * Example:
+ * @code
+ * {
+ *     SimulatedForwarderParams params;
+ *     simulatedForwarder_DefaultParams(&params);
+ * }
+ * @endcode
+ */
+void simulatedForwarder_DefaultParams(SimulatedForwarderParams *params);
+
+/**
+ * Generates the configuration settings included in the Protocol Stack configuration
+ *
+ * Adds configuration elements to the Protocol Stack configuration
+ *
+ * { "FWD_SIMULATED" : { "delayUsec" : delay, "bytesPerSecond" : rate, "bufferBytes" : bytes,
+ *                       "lossPpm" : ppm, "reorderPpm" : ppm, "reorderUsec" : delay,
+ *                       "payloadSize" : bytes, "finalChunk" : chunk, "seed" : seed } }
+ *
+ * "finalChunk" is left out if params->finalChunk is UINT64_MAX.
+ *
+ * @param [in] stackConfig The protocl stack configuration to update
+ * @param [in] params The link and producer
+ *
+ * @return non-null The updated protocol stack configuration
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+CCNxStackConfig *simulatedForwarder_ProtocolStackConfig(CCNxStackConfig *stackConfig, const SimulatedForwarderParams *params);
+
+/**
+ * Generates the configuration settings included in the Connection configuration
+ *
+ * Adds configuration elements to the `CCNxConnectionConfig`
+ *
+ * { "FWD_SIMULATED" : { } }
+ *
+ * @param [in] connConfig A pointer to a valid CCNxConnectionConfig instance.
+ *
+ * @return non-null The modified `CCNxConnectionConfig`
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+CCNxConnectionConfig *simulatedForwarder_ConnectionConfig(CCNxConnectionConfig *connConfig);
+
+/**
+ * Returns the text string for this component
+ *
+ * Used as the text key to a JSON block.  You do not need to free it.
+ *
+ * @return non-null A text string unique to this component
+ *
+ */
+const char *simulatedForwarder_GetName(void);
+
+/**
+ * Reads the parameters from a protocol stack configuration
+ *
+ * Parameters missing from the configuration have their default value.
+ *
+ * @param [in] stackJson The protocol stack configuration, e.g. rtaProtocolStack_GetParameters()
+ * @param [out] params Filled in with the parameters
+ *
+ * Example:
+ * @code
+ * {
+ *     SimulatedForwarderParams params;
+ *     simulatedForwarder_GetParamsFromConfig(rtaProtocolStack_GetParameters(stack), &params);
+ * }
+ * @endcode
+ */
+void simulatedForwarder_GetParamsFromConfig(PARCJSON *stackJson, SimulatedForwarderParams *params);
+#endif // Libccnx_config_Forwarder_Simulated_h
@@ -95,6 +95,9 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, apiConnector_GetName);
     LONGBOW_RUN_TEST_CASE(Global, apiConnector_ProtocolStackConfig_JsonKey);
     LONGBOW_RUN_TEST_CASE(Global, apiConnector_ProtocolStackConfig_ReturnValue);
+    LONGBOW_RUN_TEST_CASE(Global, apiConnector_GetQueueConfigFromConfig_Default);
+    LONGBOW_RUN_TEST_CASE(Global, apiConnector_QueueConnectionConfig);
+    LONGBOW_RUN_TEST_CASE(Global, apiConnector_GetQueueConfigFromConfig_OutOfRange);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -153,6 +156,62 @@ LONGBOW_TEST_CASE(Global, apiConnector_ProtocolStackConfig_ReturnValue)
                (void *) test, (void *) data->stackConfig);
 }
 
+LONGBOW_TEST_CASE(Global, apiConnector_GetQueueConfigFromConfig_Default)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    apiConnector_ConnectionConfig(data->connConfig);
+
+    ApiConnectorQueueConfig queueConfig;
+    bool valid = apiConnector_GetQueueConfigFromConfig(ccnxConnectionConfig_GetJson(data->connConfig), &queueConfig);
+    assertTrue(valid, "A connection without queue sizes should be valid");
+    assertTrue(memcmp(&queueConfig, apiConnector_GetDefaultQueueConfig(), sizeof(queueConfig)) == 0, "Expected the default queue sizes");
+
+    const ApiConnectorQueueConfig *defaults = apiConnector_GetDefaultQueueConfig();
+    assertTrue(defaults->sendQueueDepth == RTA_SEND_QUEUE_DEFAULT_CAPACITY, "Wrong default depth %zu", defaults->sendQueueDepth);
+    assertTrue(defaults->receiveBufferBytes == sizeof(void *) * 128, "Wrong default receive buffer %zu", defaults->receiveBufferBytes);
+    assertTrue(defaults->sendBufferBytes == 8000, "Wrong default send buffer %zu", defaults->sendBufferBytes);
+    assertTrue(defaults->writeWatermarkBytes == 400, "Wrong default watermark %zu", defaults->writeWatermarkBytes);
+}
+
+LONGBOW_TEST_CASE(Global, apiConnector_QueueConnectionConfig)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    ApiConnectorQueueConfig truth = { .sendQueueDepth = 4096, .receiveBufferBytes = 65536, .sendBufferBytes = 32768, .writeWatermarkBytes = 1024 };
+
+    CCNxConnectionConfig *test = apiConnector_QueueConnectionConfig(data->connConfig, &truth);
+    assertTrue(test == data->connConfig, "Did not return pointer to argument for chaining");
+    testRtaConfiguration_ConnectionJsonKey(data->connConfig, apiConnector_GetName());
+
+    ApiConnectorQueueConfig queueConfig;
+    bool valid = apiConnector_GetQueueConfigFromConfig(ccnxConnectionConfig_GetJson(data->connConfig), &queueConfig);
+    assertTrue(valid, "Queue sizes in range should be valid");
+    assertTrue(memcmp(&queueConfig, &truth, sizeof(queueConfig)) == 0,
+               "Wrong sizes, got depth %zu receive %zu send %zu watermark %zu",
+               queueConfig.sendQueueDepth, queueConfig.receiveBufferBytes, queueConfig.sendBufferBytes, queueConfig.writeWatermarkBytes);
+}
+
+LONGBOW_TEST_CASE(Global, apiConnector_GetQueueConfigFromConfig_OutOfRange)
+{
+    ApiConnectorQueueConfig invalid[] = {
+        { .sendQueueDepth = 1,      .receiveBufferBytes = 1024,  .sendBufferBytes = 8000,        .writeWatermarkBytes = 400  },
+        { .sendQueueDepth = 131072, .receiveBufferBytes = 1024,  .sendBufferBytes = 8000,        .writeWatermarkBytes = 400  },
+        { .sendQueueDepth = 128,    .receiveBufferBytes = 16,    .sendBufferBytes = 8000,        .writeWatermarkBytes = 400  },
+        { .sendQueueDepth = 128,    .receiveBufferBytes = 1024,  .sendBufferBytes = 64 * 1048576, .writeWatermarkBytes = 400  },
+        { .sendQueueDepth = 128,    .receiveBufferBytes = 1024,  .sendBufferBytes = 8000,        .writeWatermarkBytes = 0    },
+        { .sendQueueDepth = 128,    .receiveBufferBytes = 1024,  .sendBufferBytes = 8000,        .writeWatermarkBytes = 9000 },
+    };
+
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        CCNxConnectionConfig *connConfig = apiConnector_QueueConnectionConfig(ccnxConnectionConfig_Create(), &invalid[i]);
+
+        ApiConnectorQueueConfig queueConfig;
+        bool valid = apiConnector_GetQueueConfigFromConfig(ccnxConnectionConfig_GetJson(connConfig), &queueConfig);
+        assertFalse(valid, "Queue sizes %zu should have been rejected", i);
+
+        ccnxConnectionConfig_Destroy(&connConfig);
+    }
+}
+
 LONGBOW_TEST_FIXTURE(Local)
 {
 }
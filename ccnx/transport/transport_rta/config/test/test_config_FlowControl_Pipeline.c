@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * Rta component configuration class unit test
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../config_FlowControl_Pipeline.c"
+#include <parc/algol/parc_SafeMemory.h>
+#include <LongBow/unit-test.h>
+
+#include "testrig_RtaConfigCommon.c"
+
+LONGBOW_TEST_RUNNER(config_FlowControl_Pipeline)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(config_FlowControl_Pipeline)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(config_FlowControl_Pipeline)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, pipelineFlowController_ConnectionConfig_JsonKey);
+    LONGBOW_RUN_TEST_CASE(Global, pipelineFlowController_ConnectionConfig_ReturnValue);
+    LONGBOW_RUN_TEST_CASE(Global, pipelineFlowController_ConnectionConfig_UnknownAlgorithm);
+    LONGBOW_RUN_TEST_CASE(Global, pipelineFlowController_GetAlgorithmFromConfig);
+    LONGBOW_RUN_TEST_CASE(Global, pipelineFlowController_GetAlgorithmFromConfig_Default);
+    LONGBOW_RUN_TEST_CASE(Global, pipelineFlowController_GetName);
+    LONGBOW_RUN_TEST_CASE(Global, pipelineFlowController_IsAlgorithm);
+    LONGBOW_RUN_TEST_CASE(Global, pipelineFlowController_ProtocolStackConfig_JsonKey);
+    LONGBOW_RUN_TEST_CASE(Global, pipelineFlowController_ProtocolStackConfig_ReturnValue);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    longBowTestCase_SetClipBoardData(testCase, testRtaConfiguration_CommonSetup());
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    testRtaConfiguration_CommonTeardown(longBowTestCase_GetClipBoardData(testCase));
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, pipelineFlowController_ConnectionConfig_ReturnValue)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxConnectionConfig *test = pipelineFlowController_ConnectionConfig(data->connConfig, pipelineFlowController_AlgorithmCubic);
+
+    assertTrue(test == data->connConfig,
+               "Did not return pointer to argument for chaining, got %p expected %p",
+               (void *) test, (void *) data->connConfig);
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Global, pipelineFlowController_ConnectionConfig_UnknownAlgorithm, .event = &LongBowTrapIllegalValue)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    pipelineFlowController_ConnectionConfig(data->connConfig, "cubik");
+}
+
+LONGBOW_TEST_CASE(Global, pipelineFlowController_ConnectionConfig_JsonKey)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    testRtaConfiguration_ConnectionJsonKey(pipelineFlowController_ConnectionConfig(data->connConfig, pipelineFlowController_AlgorithmCubic),
+                                           pipelineFlowController_GetName());
+}
+
+LONGBOW_TEST_CASE(Global, pipelineFlowController_GetAlgorithmFromConfig)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    pipelineFlowController_ConnectionConfig(data->connConfig, pipelineFlowController_AlgorithmBbr);
+    const char *test = pipelineFlowController_GetAlgorithmFromConfig(ccnxConnectionConfig_GetJson(data->connConfig));
+    assertTrue(strcmp(test, pipelineFlowController_AlgorithmBbr) == 0, "Got wrong algorithm, got '%s' expected '%s'",
+               test, pipelineFlowController_AlgorithmBbr);
+}
+
+LONGBOW_TEST_CASE(Global, pipelineFlowController_GetAlgorithmFromConfig_Default)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    const char *test = pipelineFlowController_GetAlgorithmFromConfig(ccnxConnectionConfig_GetJson(data->connConfig));
+    assertTrue(strcmp(test, pipelineFlowController_AlgorithmCubic) == 0, "Got wrong default algorithm, got '%s' expected '%s'",
+               test, pipelineFlowController_AlgorithmCubic);
+}
+
+LONGBOW_TEST_CASE(Global, pipelineFlowController_GetName)
+{
+    testRtaConfiguration_ComponentName(pipelineFlowController_GetName, RtaComponentNames[FC_PIPELINE]);
+}
+
+LONGBOW_TEST_CASE(Global, pipelineFlowController_IsAlgorithm)
+{
+    assertTrue(pipelineFlowController_IsAlgorithm(pipelineFlowController_AlgorithmCubic), "cubic should be an algorithm");
+    assertTrue(pipelineFlowController_IsAlgorithm(pipelineFlowController_AlgorithmBbr), "bbr should be an algorithm");
+    assertTrue(pipelineFlowController_IsAlgorithm(pipelineFlowController_AlgorithmVegas), "vegas should be an algorithm");
+    assertFalse(pipelineFlowController_IsAlgorithm("cubik"), "cubik should not be an algorithm");
+    assertFalse(pipelineFlowController_IsAlgorithm(""), "The empty string should not be an algorithm");
+}
+
+LONGBOW_TEST_CASE(Global, pipelineFlowController_ProtocolStackConfig_JsonKey)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    testRtaConfiguration_ProtocolStackJsonKey(pipelineFlowController_ProtocolStackConfig(data->stackConfig),
+                                              pipelineFlowController_GetName());
+}
+
+LONGBOW_TEST_CASE(Global, pipelineFlowController_ProtocolStackConfig_ReturnValue)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxStackConfig *test = pipelineFlowController_ProtocolStackConfig(data->stackConfig);
+
+    assertTrue(test == data->stackConfig,
+               "Did not return pointer to argument for chaining, got %p expected %p",
+               (void *) test, (void *) data->stackConfig);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(config_FlowControl_Pipeline);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -93,6 +93,9 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, FlowControl_Vegas_ConnectionConfig_JsonKey);
     LONGBOW_RUN_TEST_CASE(Global, FlowControl_Vegas_ConnectionConfig_ReturnValue);
     LONGBOW_RUN_TEST_CASE(Global, FlowControl_Vegas_GetName);
+    LONGBOW_RUN_TEST_CASE(Global, FlowControl_Vegas_GetPacingFromConfig);
+    LONGBOW_RUN_TEST_CASE(Global, FlowControl_Vegas_GetPacingFromConfig_Default);
+    LONGBOW_RUN_TEST_CASE(Global, FlowControl_Vegas_PacedConnectionConfig_JsonKey);
     LONGBOW_RUN_TEST_CASE(Global, FlowControl_Vegas_ProtocolStackConfig_JsonKey);
     LONGBOW_RUN_TEST_CASE(Global, FlowControl_Vegas_ProtocolStackConfig_ReturnValue);
 }
@@ -136,6 +139,29 @@ LONGBOW_TEST_CASE(Global, FlowControl_Vegas_GetName)
     testRtaConfiguration_ComponentName(vegasFlowController_GetName, RtaComponentNames[FC_VEGAS]);
 }
 
+LONGBOW_TEST_CASE(Global, FlowControl_Vegas_GetPacingFromConfig)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    vegasFlowController_PacedConnectionConfig(data->connConfig);
+    bool pacing = vegasFlowController_GetPacingFromConfig(ccnxConnectionConfig_GetJson(data->connConfig), vegasFlowController_GetName());
+    assertTrue(pacing, "Pacing should be enabled");
+}
+
+LONGBOW_TEST_CASE(Global, FlowControl_Vegas_GetPacingFromConfig_Default)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    vegasFlowController_ConnectionConfig(data->connConfig);
+    bool pacing = vegasFlowController_GetPacingFromConfig(ccnxConnectionConfig_GetJson(data->connConfig), vegasFlowController_GetName());
+    assertFalse(pacing, "Pacing should be disabled by default");
+}
+
+LONGBOW_TEST_CASE(Global, FlowControl_Vegas_PacedConnectionConfig_JsonKey)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    testRtaConfiguration_ConnectionJsonKey(vegasFlowController_PacedConnectionConfig(data->connConfig),
+                                           vegasFlowController_GetName());
+}
+
 LONGBOW_TEST_CASE(Global, FlowControl_Vegas_ProtocolStackConfig_JsonKey)
 {
     TestData *data = longBowTestCase_GetClipBoardData(testCase);
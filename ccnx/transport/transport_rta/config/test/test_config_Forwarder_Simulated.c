@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * Rta component configuration class unit test
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../config_Forwarder_Simulated.c"
+#include <parc/algol/parc_SafeMemory.h>
+#include <LongBow/unit-test.h>
+
+#include "testrig_RtaConfigCommon.c"
+
+static bool
+_paramsEqual(const SimulatedForwarderParams *a, const SimulatedForwarderParams *b)
+{
+    return a->delayUsec == b->delayUsec &&
+           a->bytesPerSecond == b->bytesPerSecond &&
+           a->bufferBytes == b->bufferBytes &&
+           a->lossPpm == b->lossPpm &&
+           a->reorderPpm == b->reorderPpm &&
+           a->reorderUsec == b->reorderUsec &&
+           a->payloadSize == b->payloadSize &&
+           a->finalChunk == b->finalChunk &&
+           a->seed == b->seed;
+}
+
+LONGBOW_TEST_RUNNER(config_Forwarder_Simulated)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(config_Forwarder_Simulated)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(config_Forwarder_Simulated)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, Forwarder_Simulated_ConnectionConfig_JsonKey);
+    LONGBOW_RUN_TEST_CASE(Global, Forwarder_Simulated_ConnectionConfig_ReturnValue);
+    LONGBOW_RUN_TEST_CASE(Global, Forwarder_Simulated_GetName);
+    LONGBOW_RUN_TEST_CASE(Global, Forwarder_Simulated_ProtocolStackConfig_JsonKey);
+    LONGBOW_RUN_TEST_CASE(Global, Forwarder_Simulated_ProtocolStackConfig_ReturnValue);
+
+    LONGBOW_RUN_TEST_CASE(Global, Forwarder_Simulated_GetParams);
+    LONGBOW_RUN_TEST_CASE(Global, Forwarder_Simulated_GetParams_Defaults);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    longBowTestCase_SetClipBoardData(testCase, testRtaConfiguration_CommonSetup());
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    testRtaConfiguration_CommonTeardown(longBowTestCase_GetClipBoardData(testCase));
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, Forwarder_Simulated_ConnectionConfig_ReturnValue)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxConnectionConfig *test = simulatedForwarder_ConnectionConfig(data->connConfig);
+
+    assertTrue(test == data->connConfig,
+               "Did not return pointer to argument for chaining, got %p expected %p",
+               (void *) test, (void *) data->connConfig);
+}
+
+LONGBOW_TEST_CASE(Global, Forwarder_Simulated_ConnectionConfig_JsonKey)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    testRtaConfiguration_ConnectionJsonKey(simulatedForwarder_ConnectionConfig(data->connConfig),
+                                           simulatedForwarder_GetName());
+}
+
+LONGBOW_TEST_CASE(Global, Forwarder_Simulated_GetName)
+{
+    testRtaConfiguration_ComponentName(simulatedForwarder_GetName, RtaComponentNames[FWD_SIMULATED]);
+}
+
+LONGBOW_TEST_CASE(Global, Forwarder_Simulated_ProtocolStackConfig_JsonKey)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    SimulatedForwarderParams params;
+    simulatedForwarder_DefaultParams(&params);
+    testRtaConfiguration_ProtocolStackJsonKey(simulatedForwarder_ProtocolStackConfig(data->stackConfig, &params),
+                                              simulatedForwarder_GetName());
+}
+
+LONGBOW_TEST_CASE(Global, Forwarder_Simulated_ProtocolStackConfig_ReturnValue)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    SimulatedForwarderParams params;
+    simulatedForwarder_DefaultParams(&params);
+    CCNxStackConfig *test = simulatedForwarder_ProtocolStackConfig(data->stackConfig, &params);
+
+    assertTrue(test == data->stackConfig,
+               "Did not return pointer to argument for chaining, got %p expected %p",
+               (void *) test, (void *) data->stackConfig);
+}
+
+LONGBOW_TEST_CASE(Global, Forwarder_Simulated_GetParams)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    SimulatedForwarderParams truth = {
+        .delayUsec      = 25000,
+        .bytesPerSecond = 125000,
+        .bufferBytes    = 8192,
+        .lossPpm        = 5000,
+        .reorderPpm     = 100,
+        .reorderUsec    = 3000,
+        .payloadSize    = 512,
+        .finalChunk     = 99,
+        .seed           = 12345
+    };
+    simulatedForwarder_ProtocolStackConfig(data->stackConfig, &truth);
+
+    SimulatedForwarderParams test;
+    simulatedForwarder_GetParamsFromConfig(ccnxStackConfig_GetJson(data->stackConfig), &test);
+
+    assertTrue(_paramsEqual(&truth, &test), "Parameters did not survive the configuration");
+}
+
+LONGBOW_TEST_CASE(Global, Forwarder_Simulated_GetParams_Defaults)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    SimulatedForwarderParams truth;
+    simulatedForwarder_DefaultParams(&truth);
+
+    SimulatedForwarderParams test;
+    simulatedForwarder_GetParamsFromConfig(ccnxStackConfig_GetJson(data->stackConfig), &test);
+
+    assertTrue(_paramsEqual(&truth, &test), "A stack without FWD_SIMULATED should get the defaults");
+    assertTrue(test.finalChunk == UINT64_MAX, "Default should have no final chunk, got %" PRIu64, test.finalChunk);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(config_Forwarder_Simulated);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -190,7 +190,9 @@ connector_Api_Upcall_Read(PARCEventQueue *eventBuffer, PARCEventType type, void
                 // memory is freed at bottom of function
             }
         } else {
-            // closed connection, just destroy the message
+            // blocked connection, just destroy the message
+            rtaComponentStats_Increment(stats, STATS_DROP_BLOCKED_UP);
+            rtaConnection_Trace(conn, API_CONNECTOR, RtaTraceEvent_Drop, STATS_DROP_BLOCKED_UP);
             if (DEBUG_OUTPUT) {
                 printf("%9" PRIu64 " %s conn %p destroying transport message %p due to closed connection\n",
                        rtaFramework_GetTicks(rtaProtocolStack_GetFramework(rtaConnection_GetStack(conn))),
@@ -63,9 +63,105 @@
 #ifndef Libccnx_connector_fwd_h
 #define Libccnx_connector_fwd_h
 
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <ccnx/transport/transport_rta/core/rta_Connection.h>
+
 // Function structs for component variations
 extern RtaComponentOperations fwd_flan_ops;
 extern RtaComponentOperations fwd_local_ops;
 extern RtaComponentOperations fwd_tlvrtr_ops;
 extern RtaComponentOperations fwd_metis_ops;
+extern RtaComponentOperations fwd_simulated_ops;
+
+/**
+ * Per-connection counters of the Metis forwarder connector
+ */
+typedef struct metis_connector_stats {
+    unsigned countUpcallReads;
+    unsigned countUpcallWriteDataOk;
+    unsigned countUpcallWriteDataError;
+    unsigned countUpcallWriteDataBlocked;
+    unsigned countUpcallWriteDataQueueFull;
+
+    unsigned countUpcallWriteControlOk;
+    unsigned countUpcallWriteControlError;
+
+    unsigned countDowncallReads;
+    unsigned countDowncallWrites;
+    unsigned countDowncallControl;
+} MetisConnectorStats;
+
+/**
+ * Copies the Metis connector counters of a connection
+ *
+ * @param [in] conn The connection
+ * @param [out] output Filled in with the counters
+ *
+ * @return true The connection has FWD_METIS state and output is valid
+ * @return false The connector has no state on the connection
+ *
+ * Example:
+ * @code
+ * {
+ *     MetisConnectorStats stats;
+ *     if (connector_Fwd_Metis_GetStats(conn, &stats)) {
+ *         printf("upcall reads %u\n", stats.countUpcallReads);
+ *     }
+ * }
+ * @endcode
+ */
+bool connector_Fwd_Metis_GetStats(RtaConnection *conn, MetisConnectorStats *output);
+
+/**
+ * Counters of one direction of the FWD_SIMULATED link
+ *
+ * Every packet offered to the link is counted in `packets` and `bytes`, then ends up in
+ * exactly one of `queueDrops`, `lost`, `delivered`, or is still in flight.  `reordered`
+ * counts the delivered or in-flight packets that were given the extra reordering delay.
+ */
+typedef struct simulated_link_stats {
+    uint64_t packets;
+    uint64_t bytes;
+    uint64_t queueDrops;
+    uint64_t lost;
+    uint64_t reordered;
+    uint64_t delivered;
+    uint64_t deliveredBytes;
+} SimulatedLinkStats;
+
+/**
+ * Counters of the FWD_SIMULATED link of a protocol stack
+ *
+ * `down` carries Interests from the stack to the simulated producer, `up` carries the
+ * Content Objects back.
+ */
+typedef struct simulated_forwarder_stats {
+    SimulatedLinkStats down;
+    SimulatedLinkStats up;
+} SimulatedForwarderStats;
+
+/**
+ * Copies the link counters of the FWD_SIMULATED connector of a stack
+ *
+ * Must be called from the Transport thread, or with a non-threaded framework.
+ *
+ * @param [in] stack The protocol stack
+ * @param [out] output Filled in with the counters
+ *
+ * @return true The stack has a FWD_SIMULATED connector and output is valid
+ * @return false The stack does not use FWD_SIMULATED
+ *
+ * Example:
+ * @code
+ * {
+ *     SimulatedForwarderStats stats;
+ *     if (connector_Fwd_Simulated_GetStats(stack, &stats)) {
+ *         printf("link drops %" PRIu64 "\n", stats.down.queueDrops + stats.up.queueDrops);
+ *     }
+ * }
+ * @endcode
+ */
+bool connector_Fwd_Simulated_GetStats(RtaProtocolStack *stack, SimulatedForwarderStats *output);
 #endif
@@ -109,6 +109,7 @@ static int  connector_Fwd_Local_Init(RtaProtocolStack *stack);
 static int  connector_Fwd_Local_Opener(RtaConnection *conn);
 static void connector_Fwd_Local_Upcall_Read(PARCEventQueue *, PARCEventType, void *conn);
 static void connector_Fwd_Local_Upcall_Event(PARCEventQueue *, PARCEventQueueEventType, void *stack);
+static void connector_Fwd_Local_Upcall_Write(PARCEventQueue *, PARCEventType, void *conn);
 static void connector_Fwd_Local_Downcall_Read(PARCEventQueue *, PARCEventType, void *conn);
 static int  connector_Fwd_Local_Closer(RtaConnection *conn);
 static int  connector_Fwd_Local_Release(RtaProtocolStack *stack);
@@ -130,6 +131,9 @@ struct fwd_local_state {
     int fd;
     PARCEventQueue *bev_local;
     int connected;
+
+    // The events last given to rtaFramework_WatchDescriptor()
+    PARCEventType watchedEvents;
 };
 
 typedef struct {
@@ -142,6 +146,20 @@ typedef struct {
 // ================================
 // NULL
 
+/*
+ * bev_local waits for Write while it connects and while it has output the socket did not
+ * take yet, and always for Read.  An inline transport polls the socket level triggered,
+ * so it must only poll for Write in those cases.
+ */
+static void
+connector_Fwd_Local_Watch(RtaConnection *conn, struct fwd_local_state *fwd_state, PARCEventType events)
+{
+    if (events != fwd_state->watchedEvents) {
+        fwd_state->watchedEvents = events;
+        rtaFramework_WatchDescriptor(rtaProtocolStack_GetFramework(rtaConnection_GetStack(conn)), fwd_state->fd, events);
+    }
+}
+
 static int
 connector_Fwd_Local_Init(RtaProtocolStack *stack)
 {
@@ -181,8 +199,8 @@ connector_Fwd_Local_Opener(RtaConnection *conn)
         return -1;
     }
 
-    struct fwd_local_state *fwd_state = parcMemory_Allocate(sizeof(struct fwd_local_state));
-    assertNotNull(fwd_state, "parcMemory_Allocate(%zu) returned NULL", sizeof(struct fwd_local_state));
+    struct fwd_local_state *fwd_state = parcMemory_AllocateAndClear(sizeof(struct fwd_local_state));
+    assertNotNull(fwd_state, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(struct fwd_local_state));
 
     rtaConnection_SetPrivateData(conn, FWD_LOCAL, fwd_state);
 
@@ -221,7 +239,7 @@ connector_Fwd_Local_Opener(RtaConnection *conn)
 
     parcEventQueue_SetCallbacks(fwd_state->bev_local,
                                 connector_Fwd_Local_Upcall_Read,
-                                NULL,
+                                connector_Fwd_Local_Upcall_Write,
                                 connector_Fwd_Local_Upcall_Event,
                                 conn);
 
@@ -245,6 +263,8 @@ connector_Fwd_Local_Opener(RtaConnection *conn)
         return -1;
     }
 
+    connector_Fwd_Local_Watch(conn, fwd_state, PARCEventType_Read | PARCEventType_Write);
+
     // Socket will be ready for use once we get PARCEventQueueEventType_Connected
     if (DEBUG_OUTPUT) {
         printf("%9" PRIu64 " %s open conn %p\n",
@@ -349,6 +369,19 @@ connector_Fwd_Local_Upcall_Read(PARCEventQueue *bev, PARCEventType type, void *p
     parcEventBuffer_Destroy(&in);
 }
 
+/*
+ * bev_local wrote all of its output to the forwarder.
+ * Passed the RtaConnection in the pointer
+ */
+static void
+connector_Fwd_Local_Upcall_Write(PARCEventQueue *queue, PARCEventType event, void *ptr)
+{
+    RtaConnection *conn = (RtaConnection *) ptr;
+    struct fwd_local_state *fwd_state = rtaConnection_GetPrivateData(conn, FWD_LOCAL);
+
+    connector_Fwd_Local_Watch(conn, fwd_state, PARCEventType_Read);
+}
+
 /*
  * Event on connection to forwarder.
  * Passed the RtaConnection in the pointer
@@ -372,6 +405,14 @@ connector_Fwd_Local_Upcall_Event(PARCEventQueue *queue, PARCEventQueueEventType
         }
 
         fwd_state->connected = 1;
+
+        // Output written before the connect completed is still waiting for Write
+        PARCEventBuffer *out = parcEventBuffer_GetQueueBufferOutput(fwd_state->bev_local);
+        if (parcEventBuffer_GetLength(out) == 0) {
+            connector_Fwd_Local_Watch(conn, fwd_state, PARCEventType_Read);
+        }
+        parcEventBuffer_Destroy(&out);
+
         rtaConnection_SendStatus(conn, FWD_LOCAL, RTA_UP, notifyStatusCode_CONNECTION_OPEN, NULL, NULL);
     } else if (events & PARCEventQueueEventType_Error) {
         struct timeval tv;
@@ -496,6 +537,9 @@ connector_Fwd_Local_WriteIovec(struct fwd_local_state *fwdConnState, RtaConnecti
             trapUnrecoverableState("%s error writing iovec to bev_local", __func__);
         }
     }
+
+    // bev_local writes to the socket from the event scheduler, until then it waits for Write
+    connector_Fwd_Local_Watch(conn, fwdConnState, PARCEventType_Read | PARCEventType_Write);
 }
 
 /* send raw packet from codec to forwarder */
@@ -558,6 +602,8 @@ connector_Fwd_Local_Closer(RtaConnection *conn)
 
     stats = rtaConnection_GetStats(conn, FWD_LOCAL);
 
+    rtaFramework_UnwatchDescriptor(rtaProtocolStack_GetFramework(rtaConnection_GetStack(conn)), fwd_state->fd);
+
     // this will close too
     parcEventQueue_Destroy(&(fwd_state->bev_local));
     memset(fwd_state, 0, sizeof(struct fwd_local_state));
@@ -108,7 +108,6 @@
 #include <parc/algol/parc_Memory.h>
 #include <parc/algol/parc_Deque.h>
 #include <parc/algol/parc_EventBuffer.h>
-#include <parc/algol/parc_EventTimer.h>
 #include <parc/algol/parc_Network.h>
 
 #include <ccnx/transport/common/transport_Message.h>
@@ -157,7 +156,7 @@ static int  connector_Fwd_Metis_Init(RtaProtocolStack *stack);
 static int  connector_Fwd_Metis_Opener(RtaConnection *conn);
 
 static void _eventCallback(int fd, PARCEventType what, void *connectionVoid);
-static void connector_Fwd_Metis_Dequeue(int fd, PARCEventType which_event, void *metisStateVoid);
+static void connector_Fwd_Metis_Dequeue(RtaTimer *timer, void *metisStateVoid);
 
 static void connector_Fwd_Metis_Downcall_Read(PARCEventQueue *, PARCEventType, void *conn);
 static int  connector_Fwd_Metis_Closer(RtaConnection *conn);
@@ -184,21 +183,6 @@ typedef enum {
     PacketType_Unknown
 } _PacketType;
 
-typedef struct metis_connector_stats {
-    unsigned countUpcallReads;
-    unsigned countUpcallWriteDataOk;
-    unsigned countUpcallWriteDataError;
-    unsigned countUpcallWriteDataBlocked;
-    unsigned countUpcallWriteDataQueueFull;
-
-    unsigned countUpcallWriteControlOk;
-    unsigned countUpcallWriteControlError;
-
-    unsigned countDowncallReads;
-    unsigned countDowncallWrites;
-    unsigned countDowncallControl;
-} _MetisConnectorStats;
-
 /**
  * This structure holds the read-ahead data for the next message being read based
  * on its fixed header
@@ -235,6 +219,10 @@ typedef struct fwd_metis_state {
     PARCEvent *readEvent;
     PARCEvent *writeEvent;
 
+    // The events last given to rtaFramework_WatchDescriptor(), see _watchSocket()
+    RtaFramework *framework;
+    PARCEventType watchedEvents;
+
     bool isConnected;
 
     // This is our read-ahead of the next message fixed header
@@ -244,12 +232,12 @@ typedef struct fwd_metis_state {
     // we make sure its scheduled so long as there's messages in the queue, even if there's
     // nothing else being read
     PARCDeque *transportMessageQueue;
-    PARCEventTimer *transportMessageQueueEvent;
+    RtaTimer *transportMessageQueueEvent;
 
     // This buffer is the queue of stuff we need to send to the network
     PARCEventBuffer *metisOutputQueue;
 
-    _MetisConnectorStats stats;
+    MetisConnectorStats stats;
 } FwdMetisState;
 
 /**
@@ -334,7 +322,7 @@ _initializeNextMessage(NextMessage *next)
 }
 
 static FwdMetisState *
-connector_Fwd_Metis_CreateConnectionState(PARCEventScheduler *scheduler)
+connector_Fwd_Metis_CreateConnectionState(RtaTimerWheel *timerWheel)
 {
     FwdMetisState *fwd_state = parcMemory_Allocate(sizeof(FwdMetisState));
     assertNotNull(fwd_state, "parcMemory_Allocate(%zu) returned NULL", sizeof(FwdMetisState));
@@ -346,7 +334,7 @@ connector_Fwd_Metis_CreateConnectionState(PARCEventScheduler *scheduler)
     fwd_state->readEvent = NULL;
     fwd_state->writeEvent = NULL;
     fwd_state->transportMessageQueue = parcDeque_Create();
-    fwd_state->transportMessageQueueEvent = parcEventTimer_Create(scheduler, 0, connector_Fwd_Metis_Dequeue, fwd_state);
+    fwd_state->transportMessageQueueEvent = rtaTimer_Create(timerWheel, connector_Fwd_Metis_Dequeue, fwd_state);
     fwd_state->isConnected = false;
     fwd_state->metisOutputQueue = parcEventBuffer_Create();
 
@@ -437,6 +425,37 @@ _setupSocket(FwdMetisState *fwd_state)
     return true;
 }
 
+/**
+ * Tells the framework which of readEvent and writeEvent are pending, when that changes.
+ * An inline transport polls the socket level triggered, so it must not keep polling for
+ * an event we stopped, e.g. Read while blocked up or Write with nothing to send.
+ */
+static void
+_watchSocket(FwdMetisState *fwd_state)
+{
+    if (fwd_state->framework == NULL) {
+        // not opened yet
+        return;
+    }
+
+    PARCEventType events = 0;
+    if (parcEvent_Poll(fwd_state->readEvent, PARCEventType_Read)) {
+        events |= PARCEventType_Read;
+    }
+    if (parcEvent_Poll(fwd_state->writeEvent, PARCEventType_Write)) {
+        events |= PARCEventType_Write;
+    }
+
+    if (events != fwd_state->watchedEvents) {
+        fwd_state->watchedEvents = events;
+        if (events == 0) {
+            rtaFramework_UnwatchDescriptor(fwd_state->framework, fwd_state->fd);
+        } else {
+            rtaFramework_WatchDescriptor(fwd_state->framework, fwd_state->fd, events);
+        }
+    }
+}
+
 /**
  * @function connector_Fwd_Metis_SetupConnectionBuffer
  * @abstract Creates the connection buffer and adds it to libevent
@@ -500,6 +519,7 @@ _connectionSucceeded(FwdMetisState *fwd_state, RtaConnection *conn)
 
     // enable read events
     parcEvent_Start(fwd_state->readEvent);
+    _watchSocket(fwd_state);
 
     rtaConnection_SendStatus(conn, FWD_METIS, RTA_UP, notifyStatusCode_CONNECTION_OPEN, NULL, NULL);
 }
@@ -594,7 +614,7 @@ connector_Fwd_Metis_BeginConnect(FwdMetisState *fwd_state, RtaConnection *conn)
  * with each call from the dispatch loop.  THis is to avoid bursting a bunch of packets up the stack.
  */
 static void
-connector_Fwd_Metis_Dequeue(int fd, PARCEventType which_event, void *metisStateVoid)
+connector_Fwd_Metis_Dequeue(RtaTimer *timer, void *metisStateVoid)
 {
     FwdMetisState *fwd_state = (FwdMetisState *) metisStateVoid;
 
@@ -631,8 +651,7 @@ connector_Fwd_Metis_Dequeue(int fd, PARCEventType which_event, void *metisStateV
                    (void *) fwd_state->transportMessageQueueEvent);
         }
 
-        struct timeval immediateTimeout = { 0, 0 };
-        parcEventTimer_Start(fwd_state->transportMessageQueueEvent, &immediateTimeout);
+        rtaTimer_Schedule(fwd_state->transportMessageQueueEvent, 0);
     }
 }
 
@@ -651,8 +670,8 @@ connector_Fwd_Metis_Opener(RtaConnection *conn)
 
     uint16_t port = metisForwarder_GetPortFromConfig(rtaConnection_GetParameters(conn));
 
-    PARCEventScheduler *scheduler = rtaFramework_GetEventScheduler(rtaConnection_GetFramework(conn));
-    FwdMetisState *fwd_state = connector_Fwd_Metis_CreateConnectionState(scheduler);
+    RtaTimerWheel *timerWheel = rtaFramework_GetTimerWheel(rtaConnection_GetFramework(conn));
+    FwdMetisState *fwd_state = connector_Fwd_Metis_CreateConnectionState(timerWheel);
 
     if (_openSocket(fwd_state, port)) {
         if (_setupSocket(fwd_state)) {
@@ -660,6 +679,8 @@ connector_Fwd_Metis_Opener(RtaConnection *conn)
                 if (connector_Fwd_Metis_BeginConnect(fwd_state, conn)) {
                     // stash it away in the per-connection cubby hole
                     rtaConnection_SetPrivateData(conn, FWD_METIS, fwd_state);
+                    fwd_state->framework = rtaConnection_GetFramework(conn);
+                    _watchSocket(fwd_state);
                     success = true;
                 }
             }
@@ -752,8 +773,7 @@ _queueNonControl(PacketData *data)
                    (void *) data->fwd_state->transportMessageQueueEvent);
         }
 
-        struct timeval immediateTimeout = { 0, 0 };
-        parcEventTimer_Start(data->fwd_state->transportMessageQueueEvent, &immediateTimeout);
+        rtaTimer_Schedule(data->fwd_state->transportMessageQueueEvent, 0);
     }
 
     // we are now done with our references
@@ -785,6 +805,8 @@ _receiveNonControl(PacketData *data)
 {
     if (rtaConnection_BlockedUp(data->conn)) {
         data->fwd_state->stats.countUpcallWriteDataBlocked++;
+        rtaComponentStats_Increment(data->stats, STATS_DROP_BLOCKED_UP);
+        rtaConnection_Trace(data->conn, FWD_METIS, RtaTraceEvent_Drop, STATS_DROP_BLOCKED_UP);
         if (DEBUG_OUTPUT) {
             printf("%9" PRIu64 " %s connection %u blocked up, drop wireFormat %p\n",
                    rtaFramework_GetTicks(rtaProtocolStack_GetFramework(rtaConnection_GetStack(data->conn))),
@@ -798,6 +820,8 @@ _receiveNonControl(PacketData *data)
             data->fwd_state->stats.countUpcallWriteDataOk++;
         } else {
             data->fwd_state->stats.countUpcallWriteDataQueueFull++;
+            rtaComponentStats_Increment(data->stats, STATS_DROP_QUEUE_FULL);
+            rtaConnection_Trace(data->conn, FWD_METIS, RtaTraceEvent_Drop, STATS_DROP_QUEUE_FULL);
             if (DEBUG_OUTPUT) {
                 printf("%9" PRIu64 " %s connection %u input buffer full, drop wireFormat %p\n",
                        rtaFramework_GetTicks(rtaProtocolStack_GetFramework(rtaConnection_GetStack(data->conn))),
@@ -895,6 +919,7 @@ _disconnectedEventHandler(FwdMetisState *fwd_state, RtaConnection *conn, PARCEve
             // make the event non-pending
             parcEvent_Stop(fwd_state->readEvent);
             parcEvent_Stop(fwd_state->writeEvent);
+            _watchSocket(fwd_state);
 
             rtaConnection_SetBlockedDown(conn);
 
@@ -1242,11 +1267,13 @@ _readFromMetis(FwdMetisState *fwd_state, RtaConnection *conn)
         fwd_state->isConnected = false;
         parcEvent_Stop(fwd_state->readEvent);
         parcEvent_Stop(fwd_state->writeEvent);
+        _watchSocket(fwd_state);
         rtaConnection_SendStatus(conn, FWD_METIS, RTA_UP, notifyStatusCode_CONNECTION_CLOSED, NULL, "Socket operation returned closed by remote");
     } else if (readCode == ReadReturnCode_Error) {
         fwd_state->isConnected = false;
         parcEvent_Stop(fwd_state->readEvent);
         parcEvent_Stop(fwd_state->writeEvent);
+        _watchSocket(fwd_state);
         rtaConnection_SendStatus(conn, FWD_METIS, RTA_UP, notifyStatusCode_CONNECTION_CLOSED, NULL, "Socket operation returned error");
     }
 
@@ -1366,6 +1393,7 @@ _dequeueMessagesToMetis(FwdMetisState *fwdConnState)
                 printf("%9c %s disabled write event\n", ' ', __func__);
             }
         }
+        _watchSocket(fwdConnState);
     }
 }
 
@@ -1645,7 +1673,7 @@ _fwdMetisState_Release(FwdMetisState **fwdStatePtr)
         parcEvent_Destroy(&(fwd_state->writeEvent));
     }
 
-    parcEventTimer_Destroy(&(fwd_state->transportMessageQueueEvent));
+    rtaTimer_Destroy(&(fwd_state->transportMessageQueueEvent));
 
     if (fwd_state->metisOutputQueue) {
         parcEventBuffer_Destroy(&(fwd_state->metisOutputQueue));
@@ -1697,6 +1725,7 @@ connector_Fwd_Metis_Closer(RtaConnection *conn)
                fwd_state->stats.countDowncallReads, fwd_state->stats.countDowncallWrites, fwd_state->stats.countDowncallControl);
     }
 
+    rtaFramework_UnwatchDescriptor(rtaConnection_GetFramework(conn), fwd_state->fd);
     _fwdMetisState_Release(&fwd_state);
 
     return 0;
@@ -1745,6 +1774,7 @@ connector_Fwd_Metis_StateChange(RtaConnection *conn)
             }
 
             parcEvent_Stop(fwd_state->readEvent);
+            _watchSocket(fwd_state);
         }
     } else {
         if ((!isReadPending) && fwd_state->isConnected) {
@@ -1755,9 +1785,25 @@ connector_Fwd_Metis_StateChange(RtaConnection *conn)
                        rtaConnection_GetConnectionId(conn));
             }
             parcEvent_Start(fwd_state->readEvent);
+            _watchSocket(fwd_state);
         }
     }
 
     // We do not need to do anything with DOWN direction, becasue we're the component sending
     // those block down messages.
 }
+
+bool
+connector_Fwd_Metis_GetStats(RtaConnection *conn, MetisConnectorStats *output)
+{
+    assertNotNull(conn, "Parameter conn must be non-null");
+    assertNotNull(output, "Parameter output must be non-null");
+
+    FwdMetisState *fwd_state = rtaConnection_GetPrivateData(conn, FWD_METIS);
+    if (fwd_state == NULL) {
+        return false;
+    }
+
+    *output = fwd_state->stats;
+    return true;
+}
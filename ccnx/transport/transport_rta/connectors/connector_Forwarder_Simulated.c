@@ -0,0 +1,567 @@
+/*
+ * Copyright (c) 2014-2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * In-process link and producer, standing in for FWD_METIS in simulations.
+ *
+ * FWD_SIMULATED sits below the TLV codec.  Each stack has one link, shared by all of its
+ * connections, with a "down" direction towards a producer and an "up" direction back.
+ * Each direction serializes packets at the configured rate behind a tail-drop buffer,
+ * then delays them by the propagation delay.  A packet may be lost after it is
+ * serialized, or held back by an extra delay so it arrives after packets sent later.
+ *
+ * The producer answers every Interest that reaches it with a Content Object of the same
+ * name, the configured payload size and, optionally, a FinalChunkNumber.  It encodes the
+ * Content Object to wire format, so the codec decodes it on the way up as it would one
+ * from Metis.  Control messages are acknowledged immediately, like FWD_LOCAL does.
+ *
+ * All timing uses the framework timer wheel and rtaFramework_GetTicks(), and loss and
+ * reordering come from nrand48() seeded by the configuration.  In a framework using
+ * rtaFramework_NonThreadedEnableVirtualTime() a run is therefore reproducible and runs as
+ * fast as the host can process the packets.  Times are kept in microseconds and a packet
+ * is delivered in the first tick at or after its arrival time.
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/queue.h>
+
+#define __STDC_FORMAT_MACROS
+#include <inttypes.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+
+#include <ccnx/transport/transport_rta/core/rta_Framework_Services.h>
+#include <ccnx/transport/transport_rta/core/rta_ProtocolStack.h>
+#include <ccnx/transport/transport_rta/core/rta_Connection.h>
+#include <ccnx/transport/transport_rta/core/rta_Component.h>
+#include <ccnx/transport/transport_rta/connectors/connector_Forwarder.h>
+
+#include <ccnx/transport/transport_rta/config/config_Forwarder_Simulated.h>
+#include <ccnx/api/control/controlPlaneInterface.h>
+#include <ccnx/api/control/cpi_ControlFacade.h>
+
+#include <ccnx/common/ccnx_ContentObject.h>
+#include <ccnx/common/ccnx_Interest.h>
+#include <ccnx/common/ccnx_WireFormatMessage.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_PacketEncoder.h>
+
+#ifndef DEBUG_OUTPUT
+#define DEBUG_OUTPUT 0
+#endif
+
+static int  connector_Fwd_Simulated_Init(RtaProtocolStack *stack);
+static int  connector_Fwd_Simulated_Opener(RtaConnection *conn);
+static void connector_Fwd_Simulated_Downcall_Read(PARCEventQueue *, PARCEventType, void *stack);
+static int  connector_Fwd_Simulated_Closer(RtaConnection *conn);
+static int  connector_Fwd_Simulated_Release(RtaProtocolStack *stack);
+static void connector_Fwd_Simulated_StateChange(RtaConnection *conn);
+
+RtaComponentOperations fwd_simulated_ops = {
+    .init          = connector_Fwd_Simulated_Init,
+    .open          = connector_Fwd_Simulated_Opener,
+    .upcallRead    = NULL,
+    .upcallEvent   = NULL,
+    .downcallRead  = connector_Fwd_Simulated_Downcall_Read,
+    .downcallEvent = NULL,
+    .close         = connector_Fwd_Simulated_Closer,
+    .release       = connector_Fwd_Simulated_Release,
+    .stateChange   = connector_Fwd_Simulated_StateChange
+};
+
+struct sim_link;
+
+typedef struct sim_packet {
+    TransportMessage *tm;
+    size_t bytes;
+    uint64_t arrivalUsec;
+
+    TAILQ_ENTRY(sim_packet) list;
+} SimPacket;
+
+typedef struct sim_direction {
+    struct sim_link *link;
+    bool towardsProducer;
+
+    // ordered by arrivalUsec, packets with the same arrival stay in send order
+    TAILQ_HEAD(sim_packet_list, sim_packet) inFlight;
+
+    // when the last packet accepted finishes serializing
+    uint64_t busyUntilUsec;
+
+    // fires in the tick the head of inFlight arrives
+    RtaTimer *timer;
+
+    SimulatedLinkStats stats;
+} SimDirection;
+
+typedef struct sim_link {
+    RtaProtocolStack *stack;
+    RtaFramework *framework;
+    SimulatedForwarderParams params;
+
+    // for nrand48, so loss and reordering only depend on params.seed
+    unsigned short randomState[3];
+
+    // shared by all the Content Objects the producer creates
+    PARCBuffer *payload;
+
+    SimDirection down;
+    SimDirection up;
+} SimLink;
+
+// ================================
+// Link model
+
+static uint64_t
+_simLink_NowUsec(const SimLink *link)
+{
+    return rtaFramework_TicksToUsec(rtaFramework_GetTicks(link->framework));
+}
+
+static bool
+_simLink_Chance(SimLink *link, uint32_t ppm)
+{
+    if (ppm == 0) {
+        return false;
+    }
+    return (uint32_t) (nrand48(link->randomState) % 1000000) < ppm;
+}
+
+/*
+ * Schedule the direction's timer for the tick in which its first packet arrives
+ */
+static void
+_simDirection_Schedule(SimDirection *direction)
+{
+    SimPacket *head = TAILQ_FIRST(&direction->inFlight);
+    if (head == NULL) {
+        rtaTimer_Cancel(direction->timer);
+        return;
+    }
+
+    uint64_t usecPerTick = rtaFramework_TicksToUsec(1);
+    uint64_t arrivalTick = (head->arrivalUsec + usecPerTick - 1) / usecPerTick;
+    uint64_t now = rtaFramework_GetTicks(direction->link->framework);
+    rtaTimer_Schedule(direction->timer, arrivalTick > now ? arrivalTick - now : 0);
+}
+
+/*
+ * Puts a message on the link.  Takes ownership of the TransportMessage.
+ */
+static void
+_simDirection_Send(SimDirection *direction, TransportMessage *tm, size_t bytes)
+{
+    SimLink *link = direction->link;
+    const SimulatedForwarderParams *params = &link->params;
+    uint64_t now = _simLink_NowUsec(link);
+
+    direction->stats.packets++;
+    direction->stats.bytes += bytes;
+
+    uint64_t start = direction->busyUntilUsec > now ? direction->busyUntilUsec : now;
+
+    if (params->bufferBytes > 0 && params->bytesPerSecond > 0) {
+        uint64_t backlog = (start - now) * params->bytesPerSecond / 1000000;
+        if (backlog + bytes > params->bufferBytes) {
+            direction->stats.queueDrops++;
+            transportMessage_Destroy(&tm);
+            return;
+        }
+    }
+
+    if (params->bytesPerSecond > 0) {
+        direction->busyUntilUsec = start + bytes * 1000000 / params->bytesPerSecond;
+    } else {
+        direction->busyUntilUsec = start;
+    }
+
+    if (_simLink_Chance(link, params->lossPpm)) {
+        direction->stats.lost++;
+        transportMessage_Destroy(&tm);
+        return;
+    }
+
+    SimPacket *packet = parcMemory_AllocateAndClear(sizeof(SimPacket));
+    assertNotNull(packet, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(SimPacket));
+    packet->tm = tm;
+    packet->bytes = bytes;
+    packet->arrivalUsec = direction->busyUntilUsec + params->delayUsec;
+
+    if (_simLink_Chance(link, params->reorderPpm)) {
+        packet->arrivalUsec += params->reorderUsec;
+        direction->stats.reordered++;
+    }
+
+    SimPacket *before = TAILQ_LAST(&direction->inFlight, sim_packet_list);
+    while (before != NULL && before->arrivalUsec > packet->arrivalUsec) {
+        before = TAILQ_PREV(before, sim_packet_list, list);
+    }
+    if (before == NULL) {
+        TAILQ_INSERT_HEAD(&direction->inFlight, packet, list);
+    } else {
+        TAILQ_INSERT_AFTER(&direction->inFlight, before, packet, list);
+    }
+
+    if (TAILQ_FIRST(&direction->inFlight) == packet) {
+        _simDirection_Schedule(direction);
+    }
+}
+
+static size_t
+_simLink_WireFormatLength(CCNxTlvDictionary *dictionary)
+{
+    CCNxCodecNetworkBufferIoVec *vec = ccnxWireFormatMessage_GetIoVec(dictionary);
+    assertNotNull(vec, "FWD_SIMULATED got a message without wire format, is CODEC_TLV above it?");
+
+    int iovcnt = ccnxCodecNetworkBufferIoVec_GetCount(vec);
+    const struct iovec *array = ccnxCodecNetworkBufferIoVec_GetArray(vec);
+
+    size_t length = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        length += array[i].iov_len;
+    }
+    return length;
+}
+
+/*
+ * The producer's answer to an Interest, as a wire format message from the forwarder
+ */
+static TransportMessage *
+_simLink_CreateResponse(SimLink *link, RtaConnection *conn, const CCNxName *name, size_t *bytes)
+{
+    CCNxContentObject *contentObject = ccnxContentObject_CreateWithNameAndPayload(name, link->payload);
+    if (link->params.finalChunk != UINT64_MAX) {
+        ccnxContentObject_SetFinalChunkNumber(contentObject, link->params.finalChunk);
+    }
+
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecSchemaV1PacketEncoder_DictionaryEncode(contentObject, NULL);
+    assertNotNull(vec, "Could not encode the producer's Content Object");
+    ccnxContentObject_Release(&contentObject);
+
+    int iovcnt = ccnxCodecNetworkBufferIoVec_GetCount(vec);
+    const struct iovec *array = ccnxCodecNetworkBufferIoVec_GetArray(vec);
+
+    size_t length = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        length += array[i].iov_len;
+    }
+
+    PARCBuffer *wireFormat = parcBuffer_Allocate(length);
+    for (int i = 0; i < iovcnt; i++) {
+        parcBuffer_PutArray(wireFormat, array[i].iov_len, array[i].iov_base);
+    }
+    parcBuffer_Flip(wireFormat);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+
+    CCNxWireFormatMessage *wireFormatMessage = ccnxWireFormatMessage_Create(wireFormat);
+    parcBuffer_Release(&wireFormat);
+
+    TransportMessage *tm = transportMessage_CreateFromDictionary(ccnxWireFormatMessage_GetDictionary(wireFormatMessage));
+    transportMessage_SetInfo(tm, rtaConnection_Copy(conn), rtaConnection_FreeFunc);
+    ccnxWireFormatMessage_Release(&wireFormatMessage);
+
+    *bytes = length;
+    return tm;
+}
+
+/*
+ * A packet reached the producer
+ */
+static void
+_simLink_ReceiveAtProducer(SimLink *link, TransportMessage *tm)
+{
+    if (transportMessage_IsInterest(tm)) {
+        RtaConnection *conn = rtaConnection_GetFromTransport(tm);
+        const CCNxName *name = ccnxInterest_GetName(transportMessage_GetDictionary(tm));
+
+        size_t bytes;
+        TransportMessage *response = _simLink_CreateResponse(link, conn, name, &bytes);
+        _simDirection_Send(&link->up, response, bytes);
+    }
+    transportMessage_Destroy(&tm);
+}
+
+/*
+ * A packet came back up the link to the stack
+ */
+static void
+_simLink_ReceiveAtStack(SimLink *link, TransportMessage *tm)
+{
+    RtaConnection *conn = rtaConnection_GetFromTransport(tm);
+    RtaComponentStats *stats = rtaConnection_GetStats(conn, FWD_SIMULATED);
+
+    if (rtaConnection_GetState(conn) == CONN_CLOSED) {
+        rtaComponentStats_Increment(stats, STATS_DROP_CLOSED);
+        transportMessage_Destroy(&tm);
+    } else if (rtaConnection_BlockedUp(conn)) {
+        rtaComponentStats_Increment(stats, STATS_DROP_BLOCKED_UP);
+        rtaConnection_Trace(conn, FWD_SIMULATED, RtaTraceEvent_Drop, STATS_DROP_BLOCKED_UP);
+        transportMessage_Destroy(&tm);
+    } else {
+        rtaComponentStats_Increment(stats, STATS_UPCALL_IN);
+        PARCEventQueue *out = rtaProtocolStack_GetPutQueue(link->stack, FWD_SIMULATED, RTA_UP);
+        if (rtaComponent_PutMessage(out, tm)) {
+            rtaComponentStats_Increment(stats, STATS_UPCALL_OUT);
+        }
+    }
+}
+
+static void
+_simDirection_TimerCallback(RtaTimer *timer, void *arg)
+{
+    SimDirection *direction = arg;
+    SimLink *link = direction->link;
+
+    uint64_t usecPerTick = rtaFramework_TicksToUsec(1);
+    uint64_t nowUsec = _simLink_NowUsec(link);
+
+    SimPacket *packet;
+    while ((packet = TAILQ_FIRST(&direction->inFlight)) != NULL && packet->arrivalUsec < nowUsec + usecPerTick) {
+        TAILQ_REMOVE(&direction->inFlight, packet, list);
+        TransportMessage *tm = packet->tm;
+
+        direction->stats.delivered++;
+        direction->stats.deliveredBytes += packet->bytes;
+        parcMemory_Deallocate((void **) &packet);
+
+        if (direction->towardsProducer) {
+            _simLink_ReceiveAtProducer(link, tm);
+        } else {
+            _simLink_ReceiveAtStack(link, tm);
+        }
+    }
+
+    _simDirection_Schedule(direction);
+}
+
+static void
+_simDirection_Init(SimDirection *direction, SimLink *link, bool towardsProducer)
+{
+    direction->link = link;
+    direction->towardsProducer = towardsProducer;
+    TAILQ_INIT(&direction->inFlight);
+    direction->timer = rtaFramework_CreateTimer(link->framework, _simDirection_TimerCallback, direction);
+}
+
+static void
+_simDirection_Fini(SimDirection *direction)
+{
+    rtaTimer_Destroy(&direction->timer);
+
+    SimPacket *packet;
+    while ((packet = TAILQ_FIRST(&direction->inFlight)) != NULL) {
+        TAILQ_REMOVE(&direction->inFlight, packet, list);
+        transportMessage_Destroy(&packet->tm);
+        parcMemory_Deallocate((void **) &packet);
+    }
+}
+
+// ================================
+// Component operations
+
+static int
+connector_Fwd_Simulated_Init(RtaProtocolStack *stack)
+{
+    SimLink *link = parcMemory_AllocateAndClear(sizeof(SimLink));
+    assertNotNull(link, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(SimLink));
+
+    link->stack = stack;
+    link->framework = rtaProtocolStack_GetFramework(stack);
+    simulatedForwarder_GetParamsFromConfig(rtaProtocolStack_GetParameters(stack), &link->params);
+
+    link->randomState[0] = 0x330E;
+    link->randomState[1] = (unsigned short) (link->params.seed & 0xFFFF);
+    link->randomState[2] = (unsigned short) (link->params.seed >> 16);
+
+    link->payload = parcBuffer_Allocate(link->params.payloadSize);
+
+    _simDirection_Init(&link->down, link, true);
+    _simDirection_Init(&link->up, link, false);
+
+    rtaProtocolStack_SetPrivateData(stack, FWD_SIMULATED, link);
+
+    if (DEBUG_OUTPUT) {
+        printf("%9" PRIu64 " %s stack %d delay %" PRIu64 " usec rate %" PRIu64 " Bps buffer %" PRIu64 " loss %u ppm\n",
+               rtaFramework_GetTicks(link->framework),
+               __func__,
+               rtaProtocolStack_GetStackId(stack),
+               link->params.delayUsec,
+               link->params.bytesPerSecond,
+               link->params.bufferBytes,
+               link->params.lossPpm);
+    }
+    return 0;
+}
+
+static int
+connector_Fwd_Simulated_Opener(RtaConnection *conn)
+{
+    rtaComponentStats_Increment(rtaConnection_GetStats(conn, FWD_SIMULATED), STATS_OPENS);
+
+    // there is no connection to wait for, the link is always up
+    rtaConnection_SendStatus(conn, FWD_SIMULATED, RTA_UP, notifyStatusCode_CONNECTION_OPEN, NULL, NULL);
+    return 0;
+}
+
+static void
+_ackRequest(RtaConnection *conn, PARCJSON *request)
+{
+    PARCJSON *response = cpiAcks_CreateAck(request);
+    CCNxTlvDictionary *ackDict = ccnxControlFacade_CreateCPI(response);
+
+    TransportMessage *tm_ack = transportMessage_CreateFromDictionary(ackDict);
+    ccnxTlvDictionary_Release(&ackDict);
+    parcJSON_Release(&response);
+
+    transportMessage_SetInfo(tm_ack, rtaConnection_Copy(conn), rtaConnection_FreeFunc);
+
+    RtaProtocolStack *stack = rtaConnection_GetStack(conn);
+    PARCEventQueue  *out = rtaProtocolStack_GetPutQueue(stack, FWD_SIMULATED, RTA_UP);
+    if (rtaComponent_PutMessage(out, tm_ack)) {
+        RtaComponentStats *stats = rtaConnection_GetStats(conn, FWD_SIMULATED);
+        rtaComponentStats_Increment(stats, STATS_UPCALL_OUT);
+    }
+}
+
+static void
+connector_Fwd_Simulated_ProcessControl(RtaConnection *conn, TransportMessage *tm)
+{
+    CCNxTlvDictionary *controlDictionary = transportMessage_GetDictionary(tm);
+
+    if (ccnxControlFacade_IsCPI(controlDictionary)) {
+        PARCJSON *json = ccnxControlFacade_GetJson(controlDictionary);
+        if (controlPlaneInterface_GetCPIMessageType(json) == CPI_REQUEST) {
+            _ackRequest(conn, json);
+        }
+    }
+}
+
+/* Send packets from the codec over the link */
+static void
+connector_Fwd_Simulated_Downcall_Read(PARCEventQueue *in, PARCEventType event, void *ptr)
+{
+    RtaProtocolStack *stack = (RtaProtocolStack *) ptr;
+    SimLink *link = rtaProtocolStack_GetPrivateData(stack, FWD_SIMULATED);
+    TransportMessage *tm;
+
+    while ((tm = rtaComponent_GetMessage(in)) != NULL) {
+        RtaConnection *conn = rtaConnection_GetFromTransport(tm);
+        RtaComponentStats *stats = rtaConnection_GetStats(conn, FWD_SIMULATED);
+        rtaComponentStats_Increment(stats, STATS_DOWNCALL_IN);
+
+        CCNxTlvDictionary *messageDictionary = transportMessage_GetDictionary(tm);
+
+        if (ccnxTlvDictionary_IsControl(messageDictionary)) {
+            connector_Fwd_Simulated_ProcessControl(conn, tm);
+            transportMessage_Destroy(&tm);
+        } else {
+            size_t bytes = _simLink_WireFormatLength(messageDictionary);
+            _simDirection_Send(&link->down, tm, bytes);
+            rtaComponentStats_Increment(stats, STATS_DOWNCALL_OUT);
+        }
+    }
+}
+
+static int
+connector_Fwd_Simulated_Closer(RtaConnection *conn)
+{
+    // packets in flight hold a reference to the connection and are dropped when they arrive
+    rtaComponentStats_Increment(rtaConnection_GetStats(conn, FWD_SIMULATED), STATS_CLOSES);
+    return 0;
+}
+
+static int
+connector_Fwd_Simulated_Release(RtaProtocolStack *stack)
+{
+    SimLink *link = rtaProtocolStack_GetPrivateData(stack, FWD_SIMULATED);
+    rtaProtocolStack_SetPrivateData(stack, FWD_SIMULATED, NULL);
+
+    _simDirection_Fini(&link->down);
+    _simDirection_Fini(&link->up);
+    parcBuffer_Release(&link->payload);
+    parcMemory_Deallocate((void **) &link);
+    return 0;
+}
+
+static void
+connector_Fwd_Simulated_StateChange(RtaConnection *conn)
+{
+    // a blocked connection drops what arrives for it, see _simLink_ReceiveAtStack
+}
+
+// ================================
+// Public API
+
+bool
+connector_Fwd_Simulated_GetStats(RtaProtocolStack *stack, SimulatedForwarderStats *output)
+{
+    assertNotNull(stack, "Parameter stack must be non-null");
+    assertNotNull(output, "Parameter output must be non-null");
+
+    SimLink *link = rtaProtocolStack_GetPrivateData(stack, FWD_SIMULATED);
+    if (link == NULL) {
+        return false;
+    }
+
+    output->down = link->down.stats;
+    output->up = link->up.stats;
+    return true;
+}
@@ -71,6 +71,7 @@
 #include <config.h>
 #include <stdio.h>
 #include <fcntl.h>
+#include <sys/socket.h>
 #define __STDC_FORMAT_MACROS
 #include <inttypes.h>
 
@@ -85,11 +86,15 @@
 #include <ccnx/transport/transport_rta/core/rta_Framework_Services.h>
 #include <ccnx/transport/transport_rta/core/rta_ProtocolStack.h>
 #include <ccnx/transport/transport_rta/core/rta_Connection.h>
+#include <ccnx/transport/transport_rta/core/rta_InlineQueue.h>
+#include <ccnx/transport/transport_rta/core/rta_SendQueue.h>
+#include <ccnx/transport/transport_rta/core/rta_ConnectionCounters.h>
 #include <ccnx/transport/transport_rta/core/rta_Component.h>
 #include <ccnx/api/control/controlPlaneInterface.h>
 #include <ccnx/api/control/cpi_ControlFacade.h>
 
 #include <ccnx/transport/transport_rta/config/config_Codec_Tlv.h>
+#include <ccnx/transport/transport_rta/config/config_ApiConnector.h>
 
 #include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_TlvDictionary.h>
 
@@ -101,10 +106,6 @@
 #define PAIR_TRANSPORT 0
 #define PAIR_OTHER     1
 
-// we are only putting an 8-byte pointer on the queue, so
-// this should be 50 messages
-#define MAX_API_QUEUE_BYTES     400
-
 
 unsigned api_upcall_writes = 0;
 unsigned api_downcall_reads = 0;
@@ -121,6 +122,17 @@ struct rta_api_connection {
     // these are assingned to us by the Transport
     int api_fd;
     int transport_fd;
+
+    // An inline transport has no socket pair, bev_api is NULL and messages
+    // going up are put on this queue
+    RtaInlineQueue *inlineQueue;
+
+    // Set by a threaded transport: application threads put messages going down on this
+    // queue and a NULL pointer on the socket pair wakes us to take them off
+    RtaSendQueue *sendQueue;
+
+    // Blocked in the DOWN direction.  With a socket pair, Read on bev_api is disabled too.
+    bool downBlocked;
 };
 
 // ==========================================================================================
@@ -129,8 +141,9 @@ struct rta_api_connection {
 /**
  * PARCEvent calls this when the API queue falls below the watermark
  *
- * We watermark the write queue at MAX_API_QUEUE_BYTES bytes.  When a write takes
- * the queue backlog below that amount, PARCEvent calls this.
+ * We watermark the write queue at the connection's writeWatermarkBytes (see
+ * ApiConnectorQueueConfig).  When a write takes the queue backlog below that
+ * amount, PARCEvent calls this.
  *
  * @param [in] connVoid Void pointer to the RtaConnection
  *
@@ -210,6 +223,22 @@ static void rtaApiConnection_DrainApiConnection(RtaApiConnection *apiConnection)
  */
 static void rtaApiConnection_WriteMessageToApi(RtaApiConnection *apiConnection, CCNxMetaMessage *msg);
 
+/**
+ * Sends down the messages on the connection's send queue
+ *
+ * Clears the queue's notify mark, then takes messages off until the queue is empty
+ * or the connection is blocked in the DOWN direction.  rtaApiConnection_UnblockDown()
+ * calls it again for the messages left behind.
+ *
+ * @param [in] apiConnection An allocated RtaApiConnection with a send queue
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+static void rtaApiConnection_Downcall_DrainSendQueue(RtaApiConnection *apiConnection);
+
 // ==========================================================================================
 // Public API
 
@@ -229,13 +258,25 @@ rtaApiConnection_SetupSocket(RtaApiConnection *apiConnection, RtaConnection *con
     apiConnection->bev_api = parcEventQueue_Create(base, apiConnection->transport_fd, 0);
     assertNotNull(apiConnection->bev_api, "Got null result from parcEventQueue_Create");
 
+    // rtaTransport_Open() rejected the connection if these were out of range
+    ApiConnectorQueueConfig queueConfig;
+    bool valid = apiConnector_GetQueueConfigFromConfig(rtaConnection_GetParameters(connection), &queueConfig);
+    assertTrue(valid, "Connection %u has invalid API queue sizes", rtaConnection_GetConnectionId(connection));
+
     // Set buffer size
-    int sendbuff = 1000 * 8;
+    int sendbuff = (int) queueConfig.sendBufferBytes;
 
     error = setsockopt(rtaConnection_GetTransportFd(connection), SOL_SOCKET, SO_SNDBUF, &sendbuff, sizeof(sendbuff));
     assertTrue(error == 0, "Got error setting SO_SNDBUF: %s", strerror(errno));
 
-    parcEventQueue_SetWatermark(apiConnection->bev_api, PARCEventType_Write, MAX_API_QUEUE_BYTES, 0);
+    // the kernel may round or double what we asked for, report what it uses
+    socklen_t length = sizeof(sendbuff);
+    if (getsockopt(rtaConnection_GetTransportFd(connection), SOL_SOCKET, SO_SNDBUF, &sendbuff, &length) == 0) {
+        rtaConnectionCounters_SetLimit(rtaConnection_GetCounters(connection), RTA_LIMIT_SEND_BUFFER, (uint64_t) sendbuff);
+    }
+
+    parcEventQueue_SetWatermark(apiConnection->bev_api, PARCEventType_Write, queueConfig.writeWatermarkBytes, 0);
+    rtaConnectionCounters_SetLimit(rtaConnection_GetCounters(connection), RTA_LIMIT_WRITE_WATERMARK, queueConfig.writeWatermarkBytes);
     parcEventQueue_SetCallbacks(apiConnection->bev_api,
                                 rtaApiConnection_Downcall_Read,
                                 rtaApiConnection_WriteCallback,
@@ -254,7 +295,11 @@ rtaApiConnection_Create(RtaConnection *connection)
     apiConnection->connection = rtaConnection_Copy(connection);
     apiConnection->api_fd = rtaConnection_GetApiFd(connection);
     apiConnection->transport_fd = rtaConnection_GetTransportFd(connection);
-    rtaApiConnection_SetupSocket(apiConnection, connection);
+    apiConnection->inlineQueue = rtaConnection_GetInlineQueue(connection);
+    apiConnection->sendQueue = rtaConnection_GetSendQueue(connection);
+    if (apiConnection->inlineQueue == NULL) {
+        rtaApiConnection_SetupSocket(apiConnection, connection);
+    }
 
     return apiConnection;
 }
@@ -267,12 +312,14 @@ rtaApiConnection_Destroy(RtaApiConnection **apiConnectionPtr)
     RtaApiConnection *apiConnection = *apiConnectionPtr;
 
 
-    // Send all the outbound messages up to the API.  This at least gets them out
-    // of our output queue on to the API's socket.
-    parcEventQueue_Finished(apiConnection->bev_api, PARCEventType_Write);
-    rtaApiConnection_DrainApiConnection(apiConnection);
+    if (apiConnection->bev_api != NULL) {
+        // Send all the outbound messages up to the API.  This at least gets them out
+        // of our output queue on to the API's socket.
+        parcEventQueue_Finished(apiConnection->bev_api, PARCEventType_Write);
+        rtaApiConnection_DrainApiConnection(apiConnection);
 
-    parcEventQueue_Destroy(&(apiConnection->bev_api));
+        parcEventQueue_Destroy(&(apiConnection->bev_api));
+    }
 
     rtaConnection_Destroy(&apiConnection->connection);
 
@@ -359,6 +406,16 @@ void
 rtaApiConnection_BlockDown(RtaApiConnection *apiConnection)
 {
     assertNotNull(apiConnection, "Parameter apiConnection must be non-null");
+    apiConnection->downBlocked = true;
+    if (apiConnection->inlineQueue != NULL) {
+        return;
+    }
+
+    // So rtaTransport_TrySend() reports flow control instead of filling the queue
+    if (apiConnection->sendQueue != NULL) {
+        rtaSendQueue_SetBlocked(apiConnection->sendQueue, true);
+    }
+
     PARCEventType enabled_events = parcEventQueue_GetEnabled(apiConnection->bev_api);
 
     // we only disable it and log it if it was active
@@ -378,6 +435,19 @@ void
 rtaApiConnection_UnblockDown(RtaApiConnection *apiConnection)
 {
     assertNotNull(apiConnection, "Parameter apiConnection must be non-null");
+    apiConnection->downBlocked = false;
+    if (apiConnection->inlineQueue != NULL) {
+        return;
+    }
+
+    // Wake-ups that came while we were blocked were not acted on, and the producers
+    // will not send another until the drain clears the notify mark.  Unblocking the
+    // queue first lets a sender refused by rtaTransport_TrySend() know it may send again.
+    if (apiConnection->sendQueue != NULL) {
+        rtaSendQueue_SetBlocked(apiConnection->sendQueue, false);
+        rtaApiConnection_Downcall_DrainSendQueue(apiConnection);
+    }
+
     PARCEventType enabled_events = parcEventQueue_GetEnabled(apiConnection->bev_api);
 
     if (!(enabled_events & PARCEventType_Read)) {
@@ -399,6 +469,24 @@ rtaApiConnection_WriteMessageToApi(RtaApiConnection *apiConnection, CCNxMetaMess
 {
     assertNotNull(msg, "Parameter msg must be non-null");
 
+    if (apiConnection->inlineQueue != NULL) {
+        // the queue takes our reference
+        rtaInlineQueue_Put(apiConnection->inlineQueue, msg);
+        api_upcall_writes++;
+
+        // the application is not keeping up, rtaTransport_Recv() unblocks us below the low water mark
+        if (rtaInlineQueue_IsFull(apiConnection->inlineQueue) && !rtaConnection_BlockedUp(apiConnection->connection)) {
+            if (DEBUG_OUTPUT) {
+                printf("%9" PRIu64 " %s connection %u inline queue full, blocking UP\n",
+                       rtaFramework_GetTicks(rtaProtocolStack_GetFramework(rtaConnection_GetStack(apiConnection->connection))),
+                       __func__,
+                       rtaConnection_GetConnectionId(apiConnection->connection));
+            }
+            rtaConnection_SetBlockedUp(apiConnection->connection);
+        }
+        return;
+    }
+
     int error = parcEventQueue_Write(apiConnection->bev_api, &msg, sizeof(&msg));
     assertTrue(error == 0,
                "write to transport_fd %d write error: (%d) %s",
@@ -514,7 +602,6 @@ static void
 rtaApiConnection_Downcall_ProcessMessage(RtaApiConnection *apiConnection, RtaProtocolStack *stack, PARCEventBuffer *eb_in,
                                          PARCEventQueue *queue_out, RtaComponentStats *stats)
 {
-    api_downcall_reads++;
     CCNxMetaMessage *msg;
 
     int bytesRemoved = parcEventBuffer_Read(eb_in, &msg, sizeof(CCNxMetaMessage *));
@@ -523,6 +610,15 @@ rtaApiConnection_Downcall_ProcessMessage(RtaApiConnection *apiConnection, RtaPro
                sizeof(CCNxMetaMessage *),
                bytesRemoved);
 
+    if (msg == NULL) {
+        // A wake-up from rtaTransport_Send(), the messages are on the send queue
+        if (apiConnection->sendQueue != NULL && !apiConnection->downBlocked) {
+            rtaApiConnection_Downcall_DrainSendQueue(apiConnection);
+        }
+        return;
+    }
+
+    api_downcall_reads++;
     rtaComponentStats_Increment(stats, STATS_DOWNCALL_IN);
 
     // This will save its own reference to the messageDictionary
@@ -544,6 +640,83 @@ rtaApiConnection_Downcall_ProcessMessage(RtaApiConnection *apiConnection, RtaPro
 }
 
 
+/*
+ * Writes the NULL wake-up to our own socket pair, as _rtaTransport_WakeSendQueue() does.
+ * The connector only ever has one wake-up outstanding, so the socket has room for it.
+ * If the write fails anyway, clearing the mark lets the next sender wake us.
+ */
+static void
+rtaApiConnection_Downcall_RearmSendQueue(RtaApiConnection *apiConnection)
+{
+    if (rtaSendQueue_Notify(apiConnection->sendQueue)) {
+        const CCNxMetaMessage *wakeUp = NULL;
+        ssize_t count = send(apiConnection->api_fd, &wakeUp, sizeof(wakeUp), MSG_DONTWAIT);
+        if (count != sizeof(wakeUp)) {
+            rtaSendQueue_ClearNotify(apiConnection->sendQueue);
+        }
+    }
+}
+
+static void
+rtaApiConnection_Downcall_DrainSendQueue(RtaApiConnection *apiConnection)
+{
+    RtaConnection *conn = apiConnection->connection;
+    RtaProtocolStack *stack = rtaConnection_GetStack(conn);
+    RtaComponentStats *stats = rtaConnection_GetStats(conn, API_CONNECTOR);
+
+    PARCEventQueue *queue_out = rtaComponent_GetOutputQueue(conn, API_CONNECTOR, RTA_DOWN);
+    assertNotNull(queue_out, "component_GetOutputQueue returned null");
+
+    // Clear the mark before looking at the queue, so a put we miss wakes us again
+    rtaSendQueue_ClearNotify(apiConnection->sendQueue);
+
+    // Take at most one queue's worth per wake-up, so a busy sender cannot starve the
+    // other connections and timers on the event loop
+    size_t budget = rtaSendQueue_Capacity(apiConnection->sendQueue);
+
+    CCNxMetaMessage *msg;
+    while (budget > 0 && !apiConnection->downBlocked && (msg = rtaSendQueue_Get(apiConnection->sendQueue)) != NULL) {
+        api_downcall_reads++;
+        rtaComponentStats_Increment(stats, STATS_DOWNCALL_IN);
+
+        // This will save its own reference, release the one taken in rtaTransport_Send()
+        rtaApiConnection_Downcall_ProcessDictionary(apiConnection, stack, queue_out, stats, msg);
+        ccnxMetaMessage_Release(&msg);
+        budget--;
+    }
+
+    // Messages are left, so wake ourselves the way a sender would and come back after
+    // the event loop has run.  A blocked connection is drained by rtaApiConnection_UnblockDown().
+    if (budget == 0 && !apiConnection->downBlocked && rtaSendQueue_Count(apiConnection->sendQueue) > 0) {
+        rtaApiConnection_Downcall_RearmSendQueue(apiConnection);
+    }
+}
+
+bool
+rtaApiConnection_SendDown(RtaApiConnection *apiConnection, CCNxMetaMessage *message)
+{
+    assertNotNull(apiConnection, "Parameter apiConnection must be non-null");
+    assertNotNull(message, "Parameter message must be non-null");
+
+    if (apiConnection->downBlocked) {
+        return false;
+    }
+
+    RtaConnection *conn = apiConnection->connection;
+    RtaProtocolStack *stack = rtaConnection_GetStack(conn);
+    RtaComponentStats *stats = rtaConnection_GetStats(conn, API_CONNECTOR);
+
+    PARCEventQueue *queue_out = rtaComponent_GetOutputQueue(conn, API_CONNECTOR, RTA_DOWN);
+    assertNotNull(queue_out, "component_GetOutputQueue returned null");
+
+    api_downcall_reads++;
+    rtaComponentStats_Increment(stats, STATS_DOWNCALL_IN);
+
+    // This will save its own reference to the message
+    rtaApiConnection_Downcall_ProcessDictionary(apiConnection, stack, queue_out, stats, message);
+    return true;
+}
+
 /*
  * Called by PARCEvent when there's a message to read from the API
  * Read a message from the API.
@@ -622,7 +795,11 @@ drainBuffer(PARCEventBuffer *buffer, RtaConnection *conn)
                    (void *) conn,
                    (void *) msg);
         }
-        ccnxMetaMessage_Release(&msg);
+
+        // NULL is a wake-up for the send queue, not a message
+        if (msg != NULL) {
+            ccnxMetaMessage_Release(&msg);
+        }
     }
 }
 
@@ -640,6 +817,13 @@ rtaApiConnection_DrainApiConnection(RtaApiConnection *apiConnection)
     drainBuffer(in, apiConnection->connection);
     parcEventBuffer_Destroy(&in);
 
+    if (apiConnection->sendQueue != NULL) {
+        CCNxMetaMessage *msg;
+        while ((msg = rtaSendQueue_Get(apiConnection->sendQueue)) != NULL) {
+            ccnxMetaMessage_Release(&msg);
+        }
+    }
+
     // There may be some messages in the output buffer that
     // have not actually been written to the kernel socket.
     // Drain those too, as the API will never see them
@@ -121,4 +121,24 @@ void rtaApiConnection_BlockDown(RtaApiConnection *apiConnection);
  * @endcode
  */
 void rtaApiConnection_UnblockDown(RtaApiConnection *apiConnection);
+
+/**
+ * Sends a message from the API down the stack without going through the socket pair
+ *
+ * Used by an inline transport, where the API runs on the framework's thread.  It does
+ * what reading the pointer from the API's socket would do.  The caller keeps its reference
+ * to the message.
+ *
+ * @param [in] apiConnection The API Connector's connection state
+ * @param [in] message The message from the API
+ *
+ * @return true The message was processed
+ * @return false The connection is blocked in the DOWN direction, try again later
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+bool rtaApiConnection_SendDown(RtaApiConnection *apiConnection, CCNxMetaMessage *message);
 #endif
@@ -74,7 +74,7 @@
 #include <ccnx/transport/test_tools/bent_pipe.h>
 
 typedef struct test_data {
-    PARCRingBuffer1x1 *commandRingBuffer;
+    RtaCommandQueue *commandQueue;
     PARCNotifier *commandNotifier;
     RtaFramework *framework;
 
@@ -138,9 +138,9 @@ _commonSetup(void)
     bool success = parcPkcs12KeyStore_CreateFile(data->keystoreName, data->keystorePassword, "user", 1024, 30);
     assertTrue(success, "parcPkcs12KeyStore_CreateFile() failed.");
 
-    data->commandRingBuffer = parcRingBuffer1x1_Create(128, NULL);
+    data->commandQueue = rtaCommandQueue_Create(128);
     data->commandNotifier = parcNotifier_Create();
-    data->framework = rtaFramework_Create(data->commandRingBuffer, data->commandNotifier);
+    data->framework = rtaFramework_Create(data->commandQueue, data->commandNotifier);
 
     // Create a protocol stack and a connection to use
     CCNxTransportConfig *params = _createParams(data->bentpipe_LocalName, data->keystoreName, data->keystorePassword);
@@ -172,7 +172,7 @@ _commonTeardown(TestData *data)
 {
     rtaFramework_Teardown(data->framework);
 
-    parcRingBuffer1x1_Release(&data->commandRingBuffer);
+    rtaCommandQueue_Release(&data->commandQueue);
     parcNotifier_Release(&data->commandNotifier);
     rtaFramework_Destroy(&data->framework);
 
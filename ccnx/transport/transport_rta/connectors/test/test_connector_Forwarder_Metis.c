@@ -100,7 +100,7 @@ static const char keystorepass[] = "2398472983479234";
 #endif
 
 typedef struct test_data {
-    PARCRingBuffer1x1 *commandRingBuffer;
+    RtaCommandQueue *commandQueue;
     PARCNotifier *commandNotifier;
 
     // we will bind to a random port, this is what we end up binding to
@@ -246,9 +246,9 @@ _commonSetup(void)
     sprintf(data->keystoreName, "%s", keystorename);
     sprintf(data->keystorePassword, keystorepass);
 
-    data->commandRingBuffer = parcRingBuffer1x1_Create(128, NULL);
+    data->commandQueue = rtaCommandQueue_Create(128);
     data->commandNotifier = parcNotifier_Create();
-    data->framework = rtaFramework_Create(data->commandRingBuffer, data->commandNotifier);
+    data->framework = rtaFramework_Create(data->commandQueue, data->commandNotifier);
 
     data->params = _createParams(data->metis_port, data->keystoreName, keystorepass);
     // we will always create stack #1 as the default stack
@@ -271,7 +271,7 @@ _commonTeardown(TestData *data)
         ccnxTransportConfig_Destroy(&data->params);
         rtaFramework_Teardown(data->framework);
 
-        parcRingBuffer1x1_Release(&data->commandRingBuffer);
+        rtaCommandQueue_Release(&data->commandQueue);
         parcNotifier_Release(&data->commandNotifier);
         rtaFramework_Destroy(&data->framework);
         parcMemory_Deallocate((void **) &data);
@@ -373,7 +373,8 @@ _testReadPacketV1(size_t extraBytes)
     socketpair(PF_LOCAL, SOCK_STREAM, 0, fds);
 
     PARCEventScheduler *scheduler = parcEventScheduler_Create();
-    FwdMetisState *fwd_state = connector_Fwd_Metis_CreateConnectionState(scheduler);
+    RtaTimerWheel *timerWheel = rtaTimerWheel_Create(scheduler, 0);
+    FwdMetisState *fwd_state = connector_Fwd_Metis_CreateConnectionState(timerWheel);
 
     // this replaces "_openSocket"
     fwd_state->fd = fds[STACK];
@@ -412,6 +413,7 @@ _testReadPacketV1(size_t extraBytes)
 
     // cleanup
     _fwdMetisState_Release(&fwd_state);
+    rtaTimerWheel_Destroy(&timerWheel);
     parcEventScheduler_Destroy(&scheduler);
     close(fds[REMOTE]);
 }
@@ -560,7 +562,8 @@ LONGBOW_TEST_CASE(Local, _fwdMetisState_Release)
     socketpair(PF_LOCAL, SOCK_STREAM, 0, fds);
 
     PARCEventScheduler *scheduler = parcEventScheduler_Create();
-    FwdMetisState *fwd_state = connector_Fwd_Metis_CreateConnectionState(scheduler);
+    RtaTimerWheel *timerWheel = rtaTimerWheel_Create(scheduler, 0);
+    FwdMetisState *fwd_state = connector_Fwd_Metis_CreateConnectionState(timerWheel);
 
     // this replaces "_openSocket"
     fwd_state->fd = fds[STACK];
@@ -569,6 +572,7 @@ LONGBOW_TEST_CASE(Local, _fwdMetisState_Release)
 
 
     _fwdMetisState_Release(&fwd_state);
+    rtaTimerWheel_Destroy(&timerWheel);
     parcEventScheduler_Destroy(&scheduler);
 
     // ensure that fds[STACK] is closed by _fwdMetisState_Release
@@ -655,7 +659,8 @@ LONGBOW_TEST_CASE(UpDirectionV1, _readPacketHeader_ExactFit)
     socketpair(PF_LOCAL, SOCK_STREAM, 0, fds);
 
     PARCEventScheduler *scheduler = parcEventScheduler_Create();
-    FwdMetisState *fwd_state = connector_Fwd_Metis_CreateConnectionState(scheduler);
+    RtaTimerWheel *timerWheel = rtaTimerWheel_Create(scheduler, 0);
+    FwdMetisState *fwd_state = connector_Fwd_Metis_CreateConnectionState(timerWheel);
 
     // this replaces "_openSocket"
     fwd_state->fd = fds[STACK];
@@ -688,6 +693,7 @@ LONGBOW_TEST_CASE(UpDirectionV1, _readPacketHeader_ExactFit)
 
     // cleanup
     _fwdMetisState_Release(&fwd_state);
+    rtaTimerWheel_Destroy(&timerWheel);
     parcEventScheduler_Destroy(&scheduler);
     close(fds[REMOTE]);
 }
@@ -703,7 +709,8 @@ LONGBOW_TEST_CASE(UpDirectionV1, _readPacketHeader_TwoReads)
     socketpair(PF_LOCAL, SOCK_STREAM, 0, fds);
 
     PARCEventScheduler *scheduler = parcEventScheduler_Create();
-    FwdMetisState *fwd_state = connector_Fwd_Metis_CreateConnectionState(scheduler);
+    RtaTimerWheel *timerWheel = rtaTimerWheel_Create(scheduler, 0);
+    FwdMetisState *fwd_state = connector_Fwd_Metis_CreateConnectionState(timerWheel);
 
     // this replaces "_openSocket"
     fwd_state->fd = fds[STACK];
@@ -749,6 +756,7 @@ LONGBOW_TEST_CASE(UpDirectionV1, _readPacketHeader_TwoReads)
 
     // cleanup
     _fwdMetisState_Release(&fwd_state);
+    rtaTimerWheel_Destroy(&timerWheel);
     parcEventScheduler_Destroy(&scheduler);
     close(fds[REMOTE]);
 }
@@ -763,7 +771,8 @@ LONGBOW_TEST_CASE(UpDirectionV1, _setupNextPacket)
 
     // setup fwd_state->nextMessage like we just read a header
     PARCEventScheduler *scheduler = parcEventScheduler_Create();
-    FwdMetisState *fwd_state = connector_Fwd_Metis_CreateConnectionState(scheduler);
+    RtaTimerWheel *timerWheel = rtaTimerWheel_Create(scheduler, 0);
+    FwdMetisState *fwd_state = connector_Fwd_Metis_CreateConnectionState(timerWheel);
     fwd_state->nextMessage.remainingReadLength = 0;
     memcpy(&fwd_state->nextMessage.fixedHeader, &hdr, sizeof(hdr));
 
@@ -788,6 +797,7 @@ LONGBOW_TEST_CASE(UpDirectionV1, _setupNextPacket)
 
     // TODO: Finish me
     _fwdMetisState_Release(&fwd_state);
+    rtaTimerWheel_Destroy(&timerWheel);
     parcEventScheduler_Destroy(&scheduler);
 }
 
@@ -802,7 +812,8 @@ LONGBOW_TEST_CASE(UpDirectionV1, _readPacket_PartialMessage)
     socketpair(PF_LOCAL, SOCK_STREAM, 0, fds);
 
     PARCEventScheduler *scheduler = parcEventScheduler_Create();
-    FwdMetisState *fwd_state = connector_Fwd_Metis_CreateConnectionState(scheduler);
+    RtaTimerWheel *timerWheel = rtaTimerWheel_Create(scheduler, 0);
+    FwdMetisState *fwd_state = connector_Fwd_Metis_CreateConnectionState(timerWheel);
 
     // this replaces "_openSocket"
     fwd_state->fd = fds[STACK];
@@ -840,6 +851,7 @@ LONGBOW_TEST_CASE(UpDirectionV1, _readPacket_PartialMessage)
 
     // cleanup
     _fwdMetisState_Release(&fwd_state);
+    rtaTimerWheel_Destroy(&timerWheel);
     parcEventScheduler_Destroy(&scheduler);
     close(fds[REMOTE]);
 }
@@ -953,7 +965,8 @@ LONGBOW_TEST_CASE(UpDirectionV1, _readPacketHeader_Closed)
     socketpair(PF_LOCAL, SOCK_STREAM, 0, fds);
 
     PARCEventScheduler *scheduler = parcEventScheduler_Create();
-    FwdMetisState *fwd_state = connector_Fwd_Metis_CreateConnectionState(scheduler);
+    RtaTimerWheel *timerWheel = rtaTimerWheel_Create(scheduler, 0);
+    FwdMetisState *fwd_state = connector_Fwd_Metis_CreateConnectionState(timerWheel);
     fwd_state->fd = fds[STACK];
     _setupSocket(fwd_state);
 
@@ -963,6 +976,7 @@ LONGBOW_TEST_CASE(UpDirectionV1, _readPacketHeader_Closed)
     ReadReturnCode readCode = _readPacketHeader(fwd_state);
 
     _fwdMetisState_Release(&fwd_state);
+    rtaTimerWheel_Destroy(&timerWheel);
     parcEventScheduler_Destroy(&scheduler);
 
     assertTrue(readCode == ReadReturnCode_Closed, "Wrong return code, expected %d got %d", ReadReturnCode_Closed, readCode);
@@ -976,7 +990,8 @@ LONGBOW_TEST_CASE(UpDirectionV1, _readPacketBody_Closed)
     socketpair(PF_LOCAL, SOCK_STREAM, 0, fds);
 
     PARCEventScheduler *scheduler = parcEventScheduler_Create();
-    FwdMetisState *fwd_state = connector_Fwd_Metis_CreateConnectionState(scheduler);
+    RtaTimerWheel *timerWheel = rtaTimerWheel_Create(scheduler, 0);
+    FwdMetisState *fwd_state = connector_Fwd_Metis_CreateConnectionState(timerWheel);
     fwd_state->fd = fds[STACK];
     _setupSocket(fwd_state);
 
@@ -996,6 +1011,7 @@ LONGBOW_TEST_CASE(UpDirectionV1, _readPacketBody_Closed)
     readCode = _readPacketBody(fwd_state);
 
     _fwdMetisState_Release(&fwd_state);
+    rtaTimerWheel_Destroy(&timerWheel);
     parcEventScheduler_Destroy(&scheduler);
 
     assertTrue(readCode == ReadReturnCode_Closed, "Wrong return code, expected %d got %d", ReadReturnCode_Closed, readCode);
@@ -1012,7 +1028,8 @@ LONGBOW_TEST_CASE(UpDirectionV1, _readPacketHeader_Error)
     socketpair(PF_LOCAL, SOCK_STREAM, 0, fds);
 
     PARCEventScheduler *scheduler = parcEventScheduler_Create();
-    FwdMetisState *fwd_state = connector_Fwd_Metis_CreateConnectionState(scheduler);
+    RtaTimerWheel *timerWheel = rtaTimerWheel_Create(scheduler, 0);
+    FwdMetisState *fwd_state = connector_Fwd_Metis_CreateConnectionState(timerWheel);
     fwd_state->fd = fds[STACK];
     _setupSocket(fwd_state);
 
@@ -1023,6 +1040,7 @@ LONGBOW_TEST_CASE(UpDirectionV1, _readPacketHeader_Error)
     ReadReturnCode readCode = _readPacketHeader(fwd_state);
 
     _fwdMetisState_Release(&fwd_state);
+    rtaTimerWheel_Destroy(&timerWheel);
     parcEventScheduler_Destroy(&scheduler);
     close(fds[STACK]);
     close(fds[REMOTE]);
@@ -1041,7 +1059,8 @@ LONGBOW_TEST_CASE(UpDirectionV1, _readPacketBody_Error)
     socketpair(PF_LOCAL, SOCK_STREAM, 0, fds);
 
     PARCEventScheduler *scheduler = parcEventScheduler_Create();
-    FwdMetisState *fwd_state = connector_Fwd_Metis_CreateConnectionState(scheduler);
+    RtaTimerWheel *timerWheel = rtaTimerWheel_Create(scheduler, 0);
+    FwdMetisState *fwd_state = connector_Fwd_Metis_CreateConnectionState(timerWheel);
     fwd_state->fd = fds[STACK];
     _setupSocket(fwd_state);
 
@@ -1061,6 +1080,7 @@ LONGBOW_TEST_CASE(UpDirectionV1, _readPacketBody_Error)
     readCode = _readPacketBody(fwd_state);
 
     _fwdMetisState_Release(&fwd_state);
+    rtaTimerWheel_Destroy(&timerWheel);
     parcEventScheduler_Destroy(&scheduler);
     close(fds[STACK]);
     close(fds[REMOTE]);
@@ -1168,7 +1188,8 @@ LONGBOW_TEST_FIXTURE_TEARDOWN(DownDirectionV1)
 LONGBOW_TEST_CASE(DownDirectionV1, _queueMessageToMetis)
 {
     PARCEventScheduler *scheduler = parcEventScheduler_Create();
-    FwdMetisState *fwd_state = connector_Fwd_Metis_CreateConnectionState(scheduler);
+    RtaTimerWheel *timerWheel = rtaTimerWheel_Create(scheduler, 0);
+    FwdMetisState *fwd_state = connector_Fwd_Metis_CreateConnectionState(timerWheel);
     PARCBuffer *wireFormat = parcBuffer_Wrap(v1_interest_nameA, sizeof(v1_interest_nameA), 0, sizeof(v1_interest_nameA));
     size_t expectedRefCount = parcObject_GetReferenceCount(wireFormat);
 
@@ -1182,6 +1203,7 @@ LONGBOW_TEST_CASE(DownDirectionV1, _queueMessageToMetis)
     parcBuffer_Release(&wireFormat);
     parcEventBuffer_Destroy(&fwd_state->metisOutputQueue);
     _fwdMetisState_Release(&fwd_state);
+    rtaTimerWheel_Destroy(&timerWheel);
     parcEventScheduler_Destroy(&scheduler);
 }
 
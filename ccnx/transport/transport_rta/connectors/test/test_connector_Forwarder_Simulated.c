@@ -0,0 +1,479 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+#include "../connector_Forwarder_Simulated.c"
+#include <LongBow/unit-test.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/security/parc_Security.h>
+#include <parc/security/parc_Pkcs12KeyStore.h>
+
+#include <ccnx/api/control/cpi_ControlMessage.h>
+#include <ccnx/api/control/controlPlaneInterface.h>
+
+#include <ccnx/transport/transport_rta/core/rta_Framework_Commands.c>
+#include <ccnx/transport/transport_rta/core/rta_Framework_private.h>
+#include <ccnx/transport/transport_rta/config/config_All.h>
+
+typedef struct test_data {
+    RtaCommandQueue *commandQueue;
+    PARCNotifier *commandNotifier;
+    RtaFramework *framework;
+
+    // one pair per stack opened with _openStack()
+    int api_fds[2][2];
+    int stackCount;
+
+    char keystoreName[1024];
+    char keystorePassword[1024];
+} TestData;
+
+static CCNxTransportConfig *
+_createParams(const SimulatedForwarderParams *params, const char *keystore_name, const char *keystore_passwd)
+{
+    CCNxStackConfig *stackConfig =
+        simulatedForwarder_ProtocolStackConfig(
+            tlvCodec_ProtocolStackConfig(
+                testingUpper_ProtocolStackConfig(
+                    protocolStack_ComponentsConfigArgs(ccnxStackConfig_Create(),
+                                                       testingUpper_GetName(),
+                                                       tlvCodec_GetName(),
+                                                       simulatedForwarder_GetName(), NULL))), params);
+
+    CCNxConnectionConfig *connConfig =
+        testingUpper_ConnectionConfig(
+            tlvCodec_ConnectionConfig(
+                simulatedForwarder_ConnectionConfig(
+                    ccnxConnectionConfig_Create())));
+
+    publicKeySigner_ConnectionConfig(connConfig, keystore_name, keystore_passwd);
+
+    CCNxTransportConfig *result = ccnxTransportConfig_Create(stackConfig, connConfig);
+    ccnxStackConfig_Release(&stackConfig);
+    return result;
+}
+
+/*
+ * Creates a stack of {TestingUpper, TlvCodec, FWD_SIMULATED} and opens one connection on it
+ */
+static RtaConnection *
+_openStack(TestData *data, const SimulatedForwarderParams *params)
+{
+    assertTrue(data->stackCount < 2, "Too many stacks");
+    int stackId = data->stackCount + 1;
+    int *fds = data->api_fds[data->stackCount];
+    data->stackCount++;
+
+    CCNxTransportConfig *config = _createParams(params, data->keystoreName, data->keystorePassword);
+
+    RtaCommandCreateProtocolStack *createStack =
+        rtaCommandCreateProtocolStack_Create(stackId, ccnxTransportConfig_GetStackConfig(config));
+    _rtaFramework_ExecuteCreateStack(data->framework, createStack);
+    rtaCommandCreateProtocolStack_Release(&createStack);
+
+    socketpair(PF_LOCAL, SOCK_STREAM, 0, fds);
+    RtaCommandOpenConnection *openConnection = rtaCommandOpenConnection_Create(stackId, fds[0], fds[1],
+                                                                               ccnxConnectionConfig_GetJson(ccnxTransportConfig_GetConnectionConfig(config)));
+    _rtaFramework_ExecuteOpenConnection(data->framework, openConnection);
+    rtaCommandOpenConnection_Release(&openConnection);
+
+    ccnxTransportConfig_Destroy(&config);
+
+    RtaConnection *conn = rtaConnectionTable_GetByApiFd(data->framework->connectionTable, fds[0]);
+
+    // Let the CONNECTION_OPEN reach TESTING_UPPER and throw it away
+    rtaFramework_NonThreadedAdvance(data->framework, 0);
+    PARCEventQueue *out = rtaProtocolStack_GetPutQueue(rtaConnection_GetStack(conn), TESTING_UPPER, RTA_DOWN);
+    TransportMessage *tm;
+    while ((tm = rtaComponent_GetMessage(out)) != NULL) {
+        transportMessage_Destroy(&tm);
+    }
+    return conn;
+}
+
+static void
+_sendInterest(RtaConnection *conn, const char *uri)
+{
+    CCNxName *name = ccnxName_CreateFromCString(uri);
+    CCNxInterest *interest = ccnxInterest_CreateSimple(name);
+    TransportMessage *tm = transportMessage_CreateFromDictionary(interest);
+    ccnxInterest_Release(&interest);
+    ccnxName_Release(&name);
+
+    transportMessage_SetInfo(tm, rtaConnection_Copy(conn), rtaConnection_FreeFunc);
+
+    PARCEventQueue *in = rtaProtocolStack_GetPutQueue(rtaConnection_GetStack(conn), TESTING_UPPER, RTA_DOWN);
+    rtaComponent_PutMessage(in, tm);
+}
+
+/*
+ * Returns the number of Content Objects that reached TESTING_UPPER and destroys them
+ */
+static unsigned
+_receiveContentObjects(RtaConnection *conn)
+{
+    PARCEventQueue *out = rtaProtocolStack_GetPutQueue(rtaConnection_GetStack(conn), TESTING_UPPER, RTA_DOWN);
+    unsigned count = 0;
+    TransportMessage *tm;
+    while ((tm = rtaComponent_GetMessage(out)) != NULL) {
+        if (transportMessage_IsContentObject(tm)) {
+            count++;
+        }
+        transportMessage_Destroy(&tm);
+    }
+    return count;
+}
+
+static SimulatedForwarderParams
+_unlimitedParams(void)
+{
+    SimulatedForwarderParams params;
+    simulatedForwarder_DefaultParams(&params);
+    params.bytesPerSecond = 0;
+    params.bufferBytes = 0;
+    return params;
+}
+
+static TestData *
+_commonSetup(void)
+{
+    parcSecurity_Init();
+    TestData *data = parcMemory_AllocateAndClear(sizeof(TestData));
+    assertNotNull(data, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(TestData));
+
+    sprintf(data->keystoreName, "/tmp/keystore_%d.p12", getpid());
+    sprintf(data->keystorePassword, "23439429");
+
+    unlink(data->keystoreName);
+
+    bool success = parcPkcs12KeyStore_CreateFile(data->keystoreName, data->keystorePassword, "user", 1024, 30);
+    assertTrue(success, "parcPkcs12KeyStore_CreateFile() failed.");
+
+    data->commandQueue = rtaCommandQueue_Create(128);
+    data->commandNotifier = parcNotifier_Create();
+    data->framework = rtaFramework_Create(data->commandQueue, data->commandNotifier);
+    rtaFramework_NonThreadedEnableVirtualTime(data->framework);
+
+    return data;
+}
+
+static void
+_commonTeardown(TestData *data)
+{
+    rtaFramework_Teardown(data->framework);
+
+    rtaCommandQueue_Release(&data->commandQueue);
+    parcNotifier_Release(&data->commandNotifier);
+    rtaFramework_Destroy(&data->framework);
+
+    unlink(data->keystoreName);
+    parcMemory_Deallocate((void **) &data);
+    parcSecurity_Fini();
+}
+
+// =============================================================
+
+LONGBOW_TEST_RUNNER(connector_Forwarder_Simulated)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Local);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(connector_Forwarder_Simulated)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(connector_Forwarder_Simulated)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// ======================================================
+LONGBOW_TEST_FIXTURE(Local)
+{
+    LONGBOW_RUN_TEST_CASE(Local, connector_Fwd_Simulated_Init_Release);
+    LONGBOW_RUN_TEST_CASE(Local, connector_Fwd_Simulated_RoundTrip);
+    LONGBOW_RUN_TEST_CASE(Local, connector_Fwd_Simulated_Serialization);
+    LONGBOW_RUN_TEST_CASE(Local, connector_Fwd_Simulated_TotalLoss);
+    LONGBOW_RUN_TEST_CASE(Local, connector_Fwd_Simulated_BufferDrop);
+    LONGBOW_RUN_TEST_CASE(Local, connector_Fwd_Simulated_Deterministic);
+    LONGBOW_RUN_TEST_CASE(Local, connector_Fwd_Simulated_Cpi_Ack);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Local)
+{
+    longBowTestCase_SetClipBoardData(testCase, _commonSetup());
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Local)
+{
+    _commonTeardown(longBowTestCase_GetClipBoardData(testCase));
+
+    if (parcSafeMemory_ReportAllocation(STDOUT_FILENO) != 0) {
+        printf("('%s' leaks memory by %d (allocs - frees)) ", longBowTestCase_GetName(testCase), parcMemory_Outstanding());
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// ====================================================================
+
+LONGBOW_TEST_CASE(Local, connector_Fwd_Simulated_Init_Release)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    SimulatedForwarderParams params = _unlimitedParams();
+    RtaConnection *conn = _openStack(data, &params);
+
+    // Leave a packet in flight, teardown must free it
+    _sendInterest(conn, "lci:/sim/in/flight");
+    rtaFramework_NonThreadedAdvance(data->framework, 1);
+}
+
+/**
+ * With no rate limit, the Content Object comes back exactly two one-way delays later
+ */
+LONGBOW_TEST_CASE(Local, connector_Fwd_Simulated_RoundTrip)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    SimulatedForwarderParams params = _unlimitedParams();
+    params.delayUsec = 10000;
+    RtaConnection *conn = _openStack(data, &params);
+
+    ticks roundTrip = rtaFramework_UsecToTicks(2 * params.delayUsec);
+
+    _sendInterest(conn, "lci:/sim/round/trip");
+    rtaFramework_NonThreadedAdvance(data->framework, roundTrip - 1);
+    unsigned early = _receiveContentObjects(conn);
+    assertTrue(early == 0, "Got %u Content Objects before the round trip time", early);
+
+    rtaFramework_NonThreadedAdvance(data->framework, 1);
+    unsigned received = _receiveContentObjects(conn);
+    assertTrue(received == 1, "Expected 1 Content Object after %" PRIu64 " ticks, got %u", roundTrip, received);
+
+    SimulatedForwarderStats stats;
+    connector_Fwd_Simulated_GetStats(rtaConnection_GetStack(conn), &stats);
+    assertTrue(stats.down.delivered == 1 && stats.up.delivered == 1,
+               "Expected one packet each way, got down %" PRIu64 " up %" PRIu64, stats.down.delivered, stats.up.delivered);
+}
+
+/**
+ * The producer's Content Objects serialize one after the other on the up direction
+ */
+LONGBOW_TEST_CASE(Local, connector_Fwd_Simulated_Serialization)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    SimulatedForwarderParams params = _unlimitedParams();
+    params.delayUsec = 0;
+    params.bytesPerSecond = 1000000;
+    params.payloadSize = 9000;
+    RtaConnection *conn = _openStack(data, &params);
+
+    // Each Content Object takes a little more than 9 msec on the link
+    for (int i = 0; i < 4; i++) {
+        char uri[64];
+        sprintf(uri, "lci:/sim/serial/%d", i);
+        _sendInterest(conn, uri);
+    }
+
+    rtaFramework_NonThreadedAdvance(data->framework, 9);
+    unsigned received = _receiveContentObjects(conn);
+    assertTrue(received == 0, "Expected none yet, got %u", received);
+
+    rtaFramework_NonThreadedAdvance(data->framework, 21);
+    received = _receiveContentObjects(conn);
+    assertTrue(received == 3, "Expected 3 Content Objects after 30 msec, got %u", received);
+
+    rtaFramework_NonThreadedAdvance(data->framework, 10);
+    received = _receiveContentObjects(conn);
+    assertTrue(received == 1, "Expected the last Content Object, got %u", received);
+}
+
+LONGBOW_TEST_CASE(Local, connector_Fwd_Simulated_TotalLoss)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    SimulatedForwarderParams params = _unlimitedParams();
+    params.lossPpm = 1000000;
+    RtaConnection *conn = _openStack(data, &params);
+
+    for (int i = 0; i < 10; i++) {
+        _sendInterest(conn, "lci:/sim/lost");
+    }
+    rtaFramework_NonThreadedAdvance(data->framework, 100);
+
+    unsigned received = _receiveContentObjects(conn);
+    assertTrue(received == 0, "Expected no Content Objects, got %u", received);
+
+    SimulatedForwarderStats stats;
+    connector_Fwd_Simulated_GetStats(rtaConnection_GetStack(conn), &stats);
+    assertTrue(stats.down.packets == 10, "Expected 10 packets, got %" PRIu64, stats.down.packets);
+    assertTrue(stats.down.lost == 10, "Expected 10 lost, got %" PRIu64, stats.down.lost);
+    assertTrue(stats.up.packets == 0, "Expected nothing sent up, got %" PRIu64, stats.up.packets);
+}
+
+LONGBOW_TEST_CASE(Local, connector_Fwd_Simulated_BufferDrop)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    SimulatedForwarderParams params = _unlimitedParams();
+    params.bytesPerSecond = 1000;
+    params.bufferBytes = 1500;
+    RtaConnection *conn = _openStack(data, &params);
+
+    // The Interests are short, but at 1000 bytes per second the buffer fills up quickly
+    for (int i = 0; i < 100; i++) {
+        _sendInterest(conn, "lci:/sim/buffer");
+    }
+    rtaFramework_NonThreadedAdvance(data->framework, 1);
+
+    SimulatedForwarderStats stats;
+    connector_Fwd_Simulated_GetStats(rtaConnection_GetStack(conn), &stats);
+    assertTrue(stats.down.queueDrops > 0, "Expected tail drops");
+    assertTrue(stats.down.queueDrops < 100, "Expected some packets to fit in the buffer");
+
+    uint64_t accepted = stats.down.packets - stats.down.queueDrops;
+    assertTrue((accepted - 1) * stats.down.bytes / stats.down.packets <= params.bufferBytes,
+               "Accepted %" PRIu64 " packets, more than the buffer holds", accepted);
+}
+
+/**
+ * Two stacks with the same seed make the same loss decisions
+ */
+LONGBOW_TEST_CASE(Local, connector_Fwd_Simulated_Deterministic)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    SimulatedForwarderParams params = _unlimitedParams();
+    params.lossPpm = 300000;
+    params.reorderPpm = 200000;
+    params.reorderUsec = 5000;
+    params.seed = 42;
+
+    RtaConnection *connA = _openStack(data, &params);
+    RtaConnection *connB = _openStack(data, &params);
+
+    unsigned receivedA[50];
+    unsigned receivedB[50];
+    for (int i = 0; i < 50; i++) {
+        _sendInterest(connA, "lci:/sim/same");
+        _sendInterest(connB, "lci:/sim/same");
+        rtaFramework_NonThreadedAdvance(data->framework, 1);
+        receivedA[i] = _receiveContentObjects(connA);
+        receivedB[i] = _receiveContentObjects(connB);
+    }
+
+    assertTrue(memcmp(receivedA, receivedB, sizeof(receivedA)) == 0, "Stacks with the same seed delivered differently");
+
+    SimulatedForwarderStats statsA;
+    SimulatedForwarderStats statsB;
+    connector_Fwd_Simulated_GetStats(rtaConnection_GetStack(connA), &statsA);
+    connector_Fwd_Simulated_GetStats(rtaConnection_GetStack(connB), &statsB);
+    assertTrue(memcmp(&statsA, &statsB, sizeof(statsA)) == 0, "Stacks with the same seed have different link stats");
+    assertTrue(statsA.down.lost > 0, "Expected some loss at 30%%");
+}
+
+/**
+ * Send a PAUSE CPI message to the forwarder.  It should reflect
+ * back a CPI ACK
+ */
+LONGBOW_TEST_CASE(Local, connector_Fwd_Simulated_Cpi_Ack)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    SimulatedForwarderParams params = _unlimitedParams();
+    RtaConnection *conn = _openStack(data, &params);
+
+    PARCJSON *controlPause = cpi_CreatePauseInputRequest();
+    CCNxTlvDictionary *controlDictionary = ccnxControlFacade_CreateCPI(controlPause);
+    TransportMessage *tm_in = transportMessage_CreateFromDictionary(controlDictionary);
+
+    uint64_t pause_seqnum = controlPlaneInterface_GetSequenceNumber(controlPause);
+    parcJSON_Release(&controlPause);
+    ccnxTlvDictionary_Release(&controlDictionary);
+
+    transportMessage_SetInfo(tm_in, rtaConnection_Copy(conn), rtaConnection_FreeFunc);
+
+    PARCEventQueue *in = rtaProtocolStack_GetPutQueue(rtaConnection_GetStack(conn), TESTING_UPPER, RTA_DOWN);
+    rtaComponent_PutMessage(in, tm_in);
+
+    // acks do not cross the link, so they come back in the same tick
+    rtaFramework_NonThreadedAdvance(data->framework, 0);
+
+    TransportMessage *tm_out = rtaComponent_GetMessage(in);
+    assertNotNull(tm_out, "Expected an ACK");
+    assertTrue(transportMessage_IsControl(tm_out), "got wrong type, not a control message");
+
+    CCNxControl *control = ccnxMetaMessage_GetControl(transportMessage_GetDictionary(tm_out));
+    assertTrue(ccnxControl_IsACK(control), "Expected ccnxControl_IsACK to be true.");
+
+    uint64_t _ack_original_seqnum = ccnxControl_GetAckOriginalSequenceNumber(control);
+    assertTrue(_ack_original_seqnum == pause_seqnum,
+               "Got wrong original message seqnum, expected %" PRIu64 " got %" PRIu64, pause_seqnum, _ack_original_seqnum);
+
+    transportMessage_Destroy(&tm_out);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(connector_Forwarder_Simulated);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
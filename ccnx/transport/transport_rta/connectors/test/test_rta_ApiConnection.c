@@ -70,7 +70,7 @@
 #include <ccnx/transport/test_tools/traffic_tools.h>
 
 typedef struct test_data {
-    PARCRingBuffer1x1 *commandRingBuffer;
+    RtaCommandQueue *commandQueue;
     PARCNotifier *commandNotifier;
     RtaFramework *framework;
 
@@ -87,9 +87,9 @@ _commonSetup(void)
     TestData *data = parcMemory_AllocateAndClear(sizeof(TestData));
     assertNotNull(data, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(TestData));
 
-    data->commandRingBuffer = parcRingBuffer1x1_Create(128, NULL);
+    data->commandQueue = rtaCommandQueue_Create(128);
     data->commandNotifier = parcNotifier_Create();
-    data->framework = rtaFramework_Create(data->commandRingBuffer, data->commandNotifier);
+    data->framework = rtaFramework_Create(data->commandQueue, data->commandNotifier);
     assertNotNull(data->framework, "rtaFramework_Create returned null");
 
     CCNxStackConfig *stackConfig = ccnxStackConfig_Create();
@@ -144,7 +144,7 @@ _commonTeardown(TestData *data)
 
     rtaFramework_Teardown(data->framework);
 
-    parcRingBuffer1x1_Release(&data->commandRingBuffer);
+    rtaCommandQueue_Release(&data->commandQueue);
     parcNotifier_Release(&data->commandNotifier);
     rtaFramework_Destroy(&data->framework);
 
@@ -69,8 +69,8 @@ typedef enum {
     FC_NONE = 1,
     FC_VEGAS = 2,
     FC_PIPELINE = 3,
-    // vacant          = 4,
-    // vacant          = 5,
+    CACHE = 4,
+    PIT = 5,
     // vacant          = 6,
     CODEC_NONE = 7,
     CODEC_UNSPEC = 8,
@@ -79,7 +79,7 @@ typedef enum {
     // vacant          = 11,
     FWD_NONE = 12,
     FWD_LOCAL = 13,
-    // vacant          = 14,
+    FWD_SIMULATED = 14,
     // vacant          = 15,
     TESTING_UPPER = 16,
     TESTING_LOWER = 17,
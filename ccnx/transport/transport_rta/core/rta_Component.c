@@ -91,6 +91,63 @@ rtaComponent_GetOutputQueue(RtaConnection *conn,
     return rtaProtocolStack_GetPutQueue(stack, component, direction);
 }
 
+/*
+ * Called when a message is put on a queue.  The time since the component took the message
+ * off its input queue (or created it) is processing time.  The message also counts
+ * against the writer's output queue depth in the stack-wide stats.
+ *
+ * A component writes its `up` queue to send up, so the queue side is the message direction.
+ */
+static void
+_rtaComponent_AccountPut(RtaConnection *conn, PARCEventQueue *queue, TransportMessage *tm)
+{
+    uint64_t elapsed = transportMessage_MarkBoundary(tm);
+
+    RtaProtocolStack *stack = rtaConnection_GetStack(conn);
+    RtaComponents component;
+    RtaDirection side;
+    if (rtaProtocolStack_GetQueueOwner(stack, queue, &component, &side)) {
+        rtaComponentStats_RecordLatency(rtaConnection_GetStats(conn, component), RtaLatencyStage_Processing, side, elapsed);
+        rtaComponentStats_QueuePut(rtaProtocolStack_GetStats(stack, component), side);
+        rtaConnection_TraceAt(conn, transportMessage_GetBoundaryTime(tm), component, RtaTraceEvent_Put, (uint64_t) (uintptr_t) tm);
+    }
+}
+
+/*
+ * Called when a message is taken off a queue.  The time since the previous component's
+ * put is queue wait for the reader, and the message no longer counts against the
+ * writer's output queue.  If the connection is closed, the reader drops the message.
+ *
+ * A component reads its `up` queue for messages coming down, so the message direction
+ * is the opposite of the queue side.
+ */
+static void
+_rtaComponent_AccountGet(RtaConnection *conn, PARCEventQueue *queue, TransportMessage *tm, bool dropped)
+{
+    uint64_t elapsed = transportMessage_MarkBoundary(tm);
+    uint64_t now = transportMessage_GetBoundaryTime(tm);
+
+    RtaProtocolStack *stack = rtaConnection_GetStack(conn);
+    RtaQueueEnds ends;
+    if (!rtaProtocolStack_GetQueueEnds(stack, queue, &ends)) {
+        return;
+    }
+
+    RtaComponentStats *stats = rtaConnection_GetStats(conn, ends.owner);
+    if (dropped) {
+        rtaComponentStats_Increment(stats, STATS_DROP_CLOSED);
+        rtaConnection_TraceAt(conn, now, ends.owner, RtaTraceEvent_Drop, STATS_DROP_CLOSED);
+    } else {
+        RtaDirection direction = (ends.side == RTA_UP) ? RTA_DOWN : RTA_UP;
+        rtaComponentStats_RecordLatency(stats, RtaLatencyStage_QueueWait, direction, elapsed);
+        rtaConnection_TraceAt(conn, now, ends.owner, RtaTraceEvent_Get, (uint64_t) (uintptr_t) tm);
+    }
+
+    if (ends.hasWriter) {
+        rtaComponentStats_QueueGet(rtaProtocolStack_GetStats(stack, ends.writer), ends.direction);
+    }
+}
+
 int
 rtaComponent_PutMessage(PARCEventQueue *queue, TransportMessage *tm)
 {
@@ -103,6 +160,8 @@ rtaComponent_PutMessage(PARCEventQueue *queue, TransportMessage *tm)
 
         rtaConnection_IncrementMessagesInQueue(conn);
 
+        _rtaComponent_AccountPut(conn, queue, tm);
+
         if (DEBUG_OUTPUT) {
             printf("%s  queue %-12s tm %p\n",
                    __func__,
@@ -115,7 +174,12 @@ rtaComponent_PutMessage(PARCEventQueue *queue, TransportMessage *tm)
         parcEventBuffer_Destroy(&out);
         return 1;
     } else {
-        // should increment a drop counter (case 908)
+        RtaComponents component;
+        RtaDirection side;
+        if (rtaProtocolStack_GetQueueOwner(rtaConnection_GetStack(conn), queue, &component, &side)) {
+            rtaComponentStats_Increment(rtaConnection_GetStats(conn, component), STATS_DROP_CLOSED);
+            rtaConnection_Trace(conn, component, RtaTraceEvent_Drop, STATS_DROP_CLOSED);
+        }
         transportMessage_Destroy(&tm);
 
         return 0;
@@ -150,7 +214,10 @@ rtaComponent_GetMessage(PARCEventQueue *queue)
 
         (void) rtaConnection_DecrementMessagesInQueue(conn);
 
-        if (rtaConnection_GetState(conn) != CONN_CLOSED) {
+        bool closed = (rtaConnection_GetState(conn) == CONN_CLOSED);
+        _rtaComponent_AccountGet(conn, queue, tm, closed);
+
+        if (!closed) {
             parcEventBuffer_Destroy(&in);
             return tm;
         }
@@ -162,7 +229,6 @@ rtaComponent_GetMessage(PARCEventQueue *queue)
                    __func__, (void *) conn);
         }
 
-        // should increment a drop counter (case 908)
         transportMessage_Destroy(&tm);
     }
 
@@ -64,12 +64,42 @@
 #include <LongBow/runtime.h>
 #include <parc/algol/parc_Memory.h>
 #include <ccnx/transport/transport_rta/core/rta_ComponentStats.h>
+#include <ccnx/transport/transport_rta/core/rta_ConnectionCounters.h>
 #include <ccnx/transport/transport_rta/core/rta_ProtocolStack.h>
 
 struct rta_component_stats {
     RtaProtocolStack *stack;
     RtaComponents type;
+
+    // The live counters: either `stats` or a row of a shared RtaConnectionCounters.
+    // Only the Transport thread writes them.
+    uint64_t *counters;
+    RtaConnectionCounters *shared;
+
+    // Private counter storage.  For stack-wide stats it also holds the totals
+    // of connections that have been destroyed.
     uint64_t stats[STATS_LAST];
+
+    // Stack-wide stats sum their children (the per-connection stats) on read,
+    // so an increment only touches one counter.
+    struct rta_component_stats *parent;
+    struct rta_component_stats *firstChild;
+    struct rta_component_stats *prevSibling;
+    struct rta_component_stats *nextSibling;
+
+    // output queue gauges, indexed by direction.  Only used in stack-wide stats.
+    uint64_t queueDepth[2];
+    uint64_t queueHighWater[2];
+
+    // indexed by [stage][direction], allocated on first use.  Like `stats`, for stack-wide
+    // stats it holds the samples of connections that have been destroyed.
+    RtaLatencyHistogram *latency[RtaLatencyStage_Last][2];
+
+    // Stack-wide stats merge their children into these on read, see rtaComponentStats_GetLatency()
+    RtaLatencyHistogram *latencySnapshot[RtaLatencyStage_Last][2];
+
+    // Without it, a child records its samples in the parent's histograms
+    bool connectionLatency;
 };
 
 char *
@@ -94,14 +124,29 @@ rtaComponentStatType_ToString(RtaComponentStatType statsType)
         case STATS_DOWNCALL_OUT:
             return "downcall_out";
 
+        case STATS_DROP_CLOSED:
+            return "drop_closed";
+
+        case STATS_DROP_BLOCKED_UP:
+            return "drop_blocked_up";
+
+        case STATS_DROP_QUEUE_FULL:
+            return "drop_queue_full";
+
+        case STATS_DROP_DECODE_ERROR:
+            return "drop_decode_error";
+
+        case STATS_DROP_NO_SESSION:
+            return "drop_no_session";
+
         default:
             trapIllegalValue(statsType, "Unknown RtaComponentStatType %d", statsType);
     }
 }
 
 /**
- * Its ok to call with null stack.  that just means when we increment, we won't
- * also increment stack-wide stats
+ * Its ok to call with null stack.  that just means the stats are not counted
+ * in any stack-wide stats
  *
  * Example:
  * @code
@@ -110,6 +155,12 @@ rtaComponentStatType_ToString(RtaComponentStatType statsType)
  */
 RtaComponentStats *
 rtaComponentStats_Create(RtaProtocolStack *stack, RtaComponents componentType)
+{
+    return rtaComponentStats_CreateShared(stack, componentType, NULL);
+}
+
+RtaComponentStats *
+rtaComponentStats_CreateShared(RtaProtocolStack *stack, RtaComponents componentType, RtaConnectionCounters *counters)
 {
     RtaComponentStats *stats = parcMemory_AllocateAndClear(sizeof(RtaComponentStats));
     assertNotNull(stats, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(RtaComponentStats));
@@ -117,34 +168,178 @@ rtaComponentStats_Create(RtaProtocolStack *stack, RtaComponents componentType)
 
     stats->stack = stack;
     stats->type = componentType;
+    stats->connectionLatency = true;
+
+    if (counters != NULL) {
+        stats->shared = rtaConnectionCounters_Acquire(counters);
+        stats->counters = rtaConnectionCounters_GetRow(stats->shared, componentType);
+    } else {
+        stats->counters = stats->stats;
+    }
+
+    if (stack != NULL) {
+        RtaComponentStats *parent = rtaProtocolStack_GetStats(stack, componentType);
+        // if stack is not null, then we must get stats from it
+        assertNotNull(parent, "%s got null stack stats\n", __func__);
+
+        stats->parent = parent;
+        stats->nextSibling = parent->firstChild;
+        if (parent->firstChild != NULL) {
+            parent->firstChild->prevSibling = stats;
+        }
+        parent->firstChild = stats;
+    }
     return stats;
 }
 
+const char *
+rtaLatencyStage_ToString(RtaLatencyStage stage)
+{
+    switch (stage) {
+        case RtaLatencyStage_QueueWait:
+            return "queue_wait";
+
+        case RtaLatencyStage_Processing:
+            return "processing";
+
+        default:
+            trapIllegalValue(stage, "Unknown RtaLatencyStage %d", stage);
+    }
+}
+
 /* Increment and return incremented value */
 uint64_t
 rtaComponentStats_Increment(RtaComponentStats *stats, RtaComponentStatType statsType)
 {
     assertNotNull(stats, "%s dereferenced a null stats pointer\n", __func__);
     assertFalse(statsType >= STATS_LAST, "%s incorrect stat type %d\n", __func__, statsType);
-    stats->stats[statsType]++;
 
-    if (stats->stack != NULL) {
-        RtaComponentStats *stack_stats = rtaProtocolStack_GetStats(stats->stack, stats->type);
-        // if stack is not null, then we must get stats from it
-        assertNotNull(stack_stats, "%s got null stack stats\n", __func__);
-        stack_stats->stats[statsType]++;
+    // We are the only writer, so no read-modify-write is needed
+    uint64_t value = stats->counters[statsType] + 1;
+    rtaConnectionCounters_Store(&stats->counters[statsType], value);
+    return value;
+}
+
+static void
+_rtaComponentStats_Record(RtaComponentStats *stats, RtaLatencyStage stage, RtaDirection direction, uint64_t nanos)
+{
+    if (stats->latency[stage][direction] == NULL) {
+        stats->latency[stage][direction] = rtaLatencyHistogram_Create();
     }
+    rtaLatencyHistogram_Record(stats->latency[stage][direction], nanos);
+}
+
+void
+rtaComponentStats_RecordLatency(RtaComponentStats *stats, RtaLatencyStage stage, RtaDirection direction, uint64_t nanos)
+{
+    assertNotNull(stats, "%s dereferenced a null stats pointer\n", __func__);
+    assertTrue(stage < RtaLatencyStage_Last, "%s incorrect stage %d\n", __func__, stage);
+    assertTrue(direction == RTA_UP || direction == RTA_DOWN, "%s incorrect direction %d\n", __func__, direction);
 
-    return stats->stats[statsType];
+    // Only one histogram per sample, the stack-wide stats merge on read
+    if (stats->parent != NULL && !stats->connectionLatency) {
+        _rtaComponentStats_Record(stats->parent, stage, direction, nanos);
+    } else {
+        _rtaComponentStats_Record(stats, stage, direction, nanos);
+    }
 }
 
-/* Return value */
+void
+rtaComponentStats_SetConnectionLatency(RtaComponentStats *stats, bool enabled)
+{
+    assertNotNull(stats, "%s dereferenced a null stats pointer\n", __func__);
+    stats->connectionLatency = enabled;
+}
+
+const RtaLatencyHistogram *
+rtaComponentStats_GetLatency(RtaComponentStats *stats, RtaLatencyStage stage, RtaDirection direction)
+{
+    assertNotNull(stats, "dereferenced a null stats pointer\n");
+    assertTrue(stage < RtaLatencyStage_Last, "incorrect stage %d\n", stage);
+    assertTrue(direction == RTA_UP || direction == RTA_DOWN, "incorrect direction %d\n", direction);
+
+    if (stats->firstChild == NULL) {
+        return stats->latency[stage][direction];
+    }
+
+    RtaLatencyHistogram *snapshot = stats->latencySnapshot[stage][direction];
+    if (snapshot != NULL) {
+        rtaLatencyHistogram_Reset(snapshot);
+    }
+
+    bool empty = true;
+    if (stats->latency[stage][direction] != NULL) {
+        if (snapshot == NULL) {
+            snapshot = rtaLatencyHistogram_Create();
+        }
+        rtaLatencyHistogram_Add(snapshot, stats->latency[stage][direction]);
+        empty = false;
+    }
+    for (RtaComponentStats *child = stats->firstChild; child != NULL; child = child->nextSibling) {
+        const RtaLatencyHistogram *histogram = rtaComponentStats_GetLatency(child, stage, direction);
+        if (histogram != NULL) {
+            if (snapshot == NULL) {
+                snapshot = rtaLatencyHistogram_Create();
+            }
+            rtaLatencyHistogram_Add(snapshot, histogram);
+            empty = false;
+        }
+    }
+
+    stats->latencySnapshot[stage][direction] = snapshot;
+    return empty ? NULL : snapshot;
+}
+
+/* Return value, including the children of stack-wide stats */
 uint64_t
 rtaComponentStats_Get(RtaComponentStats *stats, RtaComponentStatType statsType)
 {
     assertNotNull(stats, "dereferenced a null stats pointer\n");
     assertFalse(statsType >= STATS_LAST, "incorrect stat statsType %d\n", statsType);
-    return stats->stats[statsType];
+
+    uint64_t total = rtaConnectionCounters_Load(&stats->counters[statsType]);
+    for (RtaComponentStats *child = stats->firstChild; child != NULL; child = child->nextSibling) {
+        total += rtaComponentStats_Get(child, statsType);
+    }
+    return total;
+}
+
+uint64_t
+rtaComponentStats_QueuePut(RtaComponentStats *stats, RtaDirection direction)
+{
+    assertNotNull(stats, "%s dereferenced a null stats pointer\n", __func__);
+
+    uint64_t depth = ++stats->queueDepth[direction];
+    if (depth > stats->queueHighWater[direction]) {
+        stats->queueHighWater[direction] = depth;
+    }
+    return depth;
+}
+
+uint64_t
+rtaComponentStats_QueueGet(RtaComponentStats *stats, RtaDirection direction)
+{
+    assertNotNull(stats, "%s dereferenced a null stats pointer\n", __func__);
+
+    // Do not wrap if a message reached the queue without going through rtaComponent_PutMessage()
+    if (stats->queueDepth[direction] > 0) {
+        stats->queueDepth[direction]--;
+    }
+    return stats->queueDepth[direction];
+}
+
+uint64_t
+rtaComponentStats_GetQueueDepth(const RtaComponentStats *stats, RtaDirection direction)
+{
+    assertNotNull(stats, "%s dereferenced a null stats pointer\n", __func__);
+    return stats->queueDepth[direction];
+}
+
+uint64_t
+rtaComponentStats_GetQueueHighWater(const RtaComponentStats *stats, RtaDirection direction)
+{
+    assertNotNull(stats, "%s dereferenced a null stats pointer\n", __func__);
+    return stats->queueHighWater[direction];
 }
 
 /* dump the stats to the given output */
@@ -153,6 +348,63 @@ rtaComponentStats_Dump(RtaComponentStats *stats, FILE *output)
 {
 }
 
+PARCJSON *
+rtaComponentStats_ToJSON(RtaComponentStats *stats)
+{
+    assertNotNull(stats, "dereferenced a null stats pointer\n");
+
+    PARCJSON *json = parcJSON_Create();
+    for (RtaComponentStatType statType = 0; statType < STATS_LAST; statType++) {
+        parcJSON_AddInteger(json, rtaComponentStatType_ToString(statType), (int64_t) rtaComponentStats_Get(stats, statType));
+    }
+
+    PARCJSON *latency = NULL;
+    for (RtaLatencyStage stage = 0; stage < RtaLatencyStage_Last; stage++) {
+        for (RtaDirection direction = RTA_UP; direction <= RTA_DOWN; direction++) {
+            const RtaLatencyHistogram *samples = rtaComponentStats_GetLatency(stats, stage, direction);
+            if (samples != NULL) {
+                if (latency == NULL) {
+                    latency = parcJSON_Create();
+                }
+
+                char name[64];
+                snprintf(name, sizeof(name), "%s_%s", rtaLatencyStage_ToString(stage), direction == RTA_UP ? "up" : "down");
+
+                PARCJSON *histogram = rtaLatencyHistogram_ToJSON(samples);
+                parcJSON_AddObject(latency, name, histogram);
+                parcJSON_Release(&histogram);
+            }
+        }
+    }
+
+    if (latency != NULL) {
+        parcJSON_AddObject(json, "latency", latency);
+        parcJSON_Release(&latency);
+    }
+
+    PARCJSON *queue = NULL;
+    for (RtaDirection direction = RTA_UP; direction <= RTA_DOWN; direction++) {
+        if (stats->queueHighWater[direction] > 0) {
+            if (queue == NULL) {
+                queue = parcJSON_Create();
+            }
+
+            PARCJSON *gauge = parcJSON_Create();
+            parcJSON_AddInteger(gauge, "depth", (int64_t) stats->queueDepth[direction]);
+            parcJSON_AddInteger(gauge, "highWater", (int64_t) stats->queueHighWater[direction]);
+            parcJSON_AddObject(queue, direction == RTA_UP ? "up" : "down", gauge);
+            parcJSON_Release(&gauge);
+        }
+    }
+
+    if (queue != NULL) {
+        parcJSON_AddObject(json, "queue", queue);
+        parcJSON_Release(&queue);
+    }
+
+    return json;
+}
+
 void
 rtaComponentStats_Destroy(RtaComponentStats **statsPtr)
 {
@@ -162,6 +414,54 @@ rtaComponentStats_Destroy(RtaComponentStats **statsPtr)
     stats = *statsPtr;
     assertNotNull(stats, "%s dereferenced a null stats pointer\n", __func__);
 
+    if (stats->parent != NULL) {
+        // keep the stack-wide totals after the connection goes away
+        uint64_t *totals = stats->parent->counters;
+        for (int statType = 0; statType < STATS_LAST; statType++) {
+            rtaConnectionCounters_Store(&totals[statType], totals[statType] + rtaComponentStats_Get(stats, statType));
+        }
+        for (int stage = 0; stage < RtaLatencyStage_Last; stage++) {
+            for (int direction = 0; direction < 2; direction++) {
+                if (stats->latency[stage][direction] != NULL) {
+                    if (stats->parent->latency[stage][direction] == NULL) {
+                        stats->parent->latency[stage][direction] = rtaLatencyHistogram_Create();
+                    }
+                    rtaLatencyHistogram_Add(stats->parent->latency[stage][direction], stats->latency[stage][direction]);
+                }
+            }
+        }
+
+        if (stats->prevSibling != NULL) {
+            stats->prevSibling->nextSibling = stats->nextSibling;
+        } else {
+            stats->parent->firstChild = stats->nextSibling;
+        }
+        if (stats->nextSibling != NULL) {
+            stats->nextSibling->prevSibling = stats->prevSibling;
+        }
+    }
+
+    // orphan any children still alive
+    for (RtaComponentStats *child = stats->firstChild; child != NULL; child = child->nextSibling) {
+        child->parent = NULL;
+        child->prevSibling = NULL;
+    }
+
+    if (stats->shared != NULL) {
+        rtaConnectionCounters_Release(&stats->shared);
+    }
+
+    for (int stage = 0; stage < RtaLatencyStage_Last; stage++) {
+        for (int direction = 0; direction < 2; direction++) {
+            if (stats->latency[stage][direction] != NULL) {
+                rtaLatencyHistogram_Destroy(&stats->latency[stage][direction]);
+            }
+            if (stats->latencySnapshot[stage][direction] != NULL) {
+                rtaLatencyHistogram_Destroy(&stats->latencySnapshot[stage][direction]);
+            }
+        }
+    }
+
     memset(stats, 0, sizeof(RtaComponentStats));
     parcMemory_Deallocate((void **) &stats);
 }
@@ -62,8 +62,12 @@
  *
  * Each ProtocolStack has a PER STACK PER COMPONENT set of statistics too.  When a
  * component creates its stats in _Open, it passes a pointer to its stack, so when
- * _Increment is called, it will increment both the component's stats and the stack's
- * stats.
+ * _Increment is called, it only increments the component's stats.  The stack's stats
+ * are the sum of its connections' stats, computed when the stack stats are read.
+ *
+ * Increments come only from the framework thread, so counters are single-writer and
+ * stored with relaxed atomics.  A connection's counters may live in a shared
+ * RtaConnectionCounters block that an application thread reads without locks.
  *
  * For example:
  *
@@ -84,7 +88,11 @@
 #ifndef Libccnx_rta_ComponentStats
 #define Libccnx_rta_ComponentStats
 
+#include <stdbool.h>
+
 #include <ccnx/transport/transport_rta/core/components.h>
+#include <ccnx/transport/transport_rta/core/rta_ComponentQueue.h>
+#include <ccnx/transport/transport_rta/core/rta_LatencyHistogram.h>
 
 struct protocol_stack;
 
@@ -102,14 +110,28 @@ typedef enum {
     STATS_UPCALL_OUT,
     STATS_DOWNCALL_IN,
     STATS_DOWNCALL_OUT,
+    STATS_DROP_CLOSED,          // the connection was closed while the message was queued
+    STATS_DROP_BLOCKED_UP,      // the connection was blocked in the up direction
+    STATS_DROP_QUEUE_FULL,      // a component's private input queue was full
+    STATS_DROP_DECODE_ERROR,    // the wire format did not decode
+    STATS_DROP_NO_SESSION,      // a content object did not match a flow control session
     STATS_LAST              // must be last
 } RtaComponentStatType;
 
+/**
+ * The two parts of a component's latency, measured at queue boundaries
+ */
+typedef enum {
+    RtaLatencyStage_QueueWait,      // From the previous component's put until this component's get
+    RtaLatencyStage_Processing,     // From this component's get until its put to the next queue
+    RtaLatencyStage_Last            // must be last
+} RtaLatencyStage;
+
 /**
  * Create a stats component
  *
- * If the optional stack is specified, its statistics will be incremented whenever this
- * stats object is incremented.  Otherwise, it may be NULL.
+ * If the optional stack is specified, this stats object is counted in the stack's
+ * statistics (see rtaComponentStats_Get()).  Otherwise, it may be NULL.
  *
  * @param [in] stack Optional protocol stack
  *
@@ -124,6 +146,29 @@ typedef enum {
  */
 RtaComponentStats *rtaComponentStats_Create(struct protocol_stack *stack, RtaComponents componentType);
 
+struct rta_connection_counters;
+
+/**
+ * Create a stats component whose counters live in a shared counter block
+ *
+ * Like rtaComponentStats_Create(), but the counters are the `componentType` row of
+ * `counters`, so other threads can read them (see rtaConnectionCounters_Snapshot()).
+ * The stats object acquires its own reference to `counters`.  If `counters` is NULL,
+ * this is the same as rtaComponentStats_Create().
+ *
+ * @param [in] stack Optional protocol stack
+ * @param [in] componentType The component
+ * @param [in] counters Optional shared counter block
+ *
+ * @return non-null An allocated stats object
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+RtaComponentStats *rtaComponentStats_CreateShared(struct protocol_stack *stack, RtaComponents componentType, struct rta_connection_counters *counters);
+
 /**
  * <#OneLineDescription#>
  *
@@ -142,7 +187,8 @@ char *rtaComponentStatType_ToString(RtaComponentStatType statType);
 /**
  * Increment and return incremented value
  *
- * <#Paragraphs Of Explanation#>
+ * Only the framework thread may increment a stats object.  The stack-wide stats are
+ * not touched; they are aggregated on read by rtaComponentStats_Get().
  *
  * @param [<#in out in,out#>] <#name#> <#description#>
  *
@@ -160,7 +206,9 @@ uint64_t rtaComponentStats_Increment(RtaComponentStats *stats, RtaComponentStatT
 /**
  * Return value
  *
- * <#Paragraphs Of Explanation#>
+ * For stack-wide stats this is the sum over the stack's connections, live and closed.
+ * Stack totals are aggregated here, on read, so that rtaComponentStats_Increment()
+ * only touches a single counter.
  *
  * @param [<#in out in,out#>] <#name#> <#description#>
  *
@@ -175,6 +223,155 @@ uint64_t rtaComponentStats_Increment(RtaComponentStats *stats, RtaComponentStatT
  */
 uint64_t rtaComponentStats_Get(RtaComponentStats *stats, RtaComponentStatType statType);
 
+/**
+ * Record one latency sample for the component
+ *
+ * The sample goes in one histogram only.  Normally that is this object's, and like the
+ * counters, the stack-wide stats for the component merge the histograms of their connections
+ * when they are read.  If rtaComponentStats_SetConnectionLatency() turned this object's
+ * histograms off, the sample goes in the stack-wide stats directly.
+ *
+ * @param [in] stats The component stats
+ * @param [in] stage Queue wait or processing
+ * @param [in] direction RTA_UP if the message is going up the stack, RTA_DOWN if down
+ * @param [in] nanos The latency in nanoseconds
+ *
+ * Example:
+ * @code
+ * {
+ *     rtaComponentStats_RecordLatency(rtaConnection_GetStats(conn, FC_VEGAS), RtaLatencyStage_QueueWait, RTA_DOWN, 1200);
+ * }
+ * @endcode
+ */
+void rtaComponentStats_RecordLatency(RtaComponentStats *stats, RtaLatencyStage stage, RtaDirection direction, uint64_t nanos);
+
+/**
+ * Whether stats created with a stack keep their own latency histograms
+ *
+ * On by default.  rtaConnection_Create() turns it off unless rtaFramework_GetConnectionLatency(),
+ * so that a connection does not allocate a histogram per component, stage and direction.
+ * Without a stack there is nowhere else to record, so the setting has no effect.
+ *
+ * @param [in] stats The component stats
+ * @param [in] enabled true to keep histograms in `stats`, false to record in the stack-wide stats
+ *
+ * Example:
+ * @code
+ * {
+ *     rtaComponentStats_SetConnectionLatency(rtaConnection_GetStats(conn, FC_VEGAS), false);
+ * }
+ * @endcode
+ */
+void rtaComponentStats_SetConnectionLatency(RtaComponentStats *stats, bool enabled);
+
+/**
+ * Return the latency histogram of a stage and direction
+ *
+ * Histograms are allocated on the first sample, so a stage that never ran has none.
+ * For stack-wide stats this merges the histograms of the stack's connections, live and
+ * closed, into a snapshot the stats object owns, valid until the next call.  Like the
+ * recording, it must be called on the Transport thread.
+ *
+ * @param [in] stats The component stats
+ * @param [in] stage Queue wait or processing
+ * @param [in] direction RTA_UP or RTA_DOWN
+ *
+ * @return NULL No samples have been recorded
+ * @return non-null The histogram, owned by the stats object
+ *
+ * Example:
+ * @code
+ * {
+ *     const RtaLatencyHistogram *wait = rtaComponentStats_GetLatency(rtaProtocolStack_GetStats(stack, FC_VEGAS), RtaLatencyStage_QueueWait, RTA_DOWN);
+ *     if (wait) {
+ *         printf("p99 %" PRIu64 " nsec\n", rtaLatencyHistogram_GetValueAtPercentile(wait, 99.0));
+ *     }
+ * }
+ * @endcode
+ */
+const RtaLatencyHistogram *rtaComponentStats_GetLatency(RtaComponentStats *stats, RtaLatencyStage stage, RtaDirection direction);
+
+/**
+ * Return the name of a latency stage, e.g. "queue_wait"
+ *
+ * @param [in] stage The stage
+ *
+ * @return non-null A static string, do not free
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+const char *rtaLatencyStage_ToString(RtaLatencyStage stage);
+
+/**
+ * Account for a message put on the component's output queue
+ *
+ * Queue depth gauges are kept in the stack-wide stats, because the inter-component
+ * queues belong to the stack.  The depth is the number of messages the component has
+ * written in `direction` that the next component has not read yet.  The high-water mark
+ * is the largest depth seen since the stats were created.
+ *
+ * @param [in] stats The stack-wide stats of the writing component
+ * @param [in] direction RTA_UP or RTA_DOWN
+ *
+ * @return The queue depth after the put
+ *
+ * Example:
+ * @code
+ * {
+ *     rtaComponentStats_QueuePut(rtaProtocolStack_GetStats(stack, CODEC_TLV), RTA_UP);
+ * }
+ * @endcode
+ */
+uint64_t rtaComponentStats_QueuePut(RtaComponentStats *stats, RtaDirection direction);
+
+/**
+ * Account for a message taken off the component's output queue by the next component
+ *
+ * @param [in] stats The stack-wide stats of the component that wrote the message
+ * @param [in] direction RTA_UP or RTA_DOWN
+ *
+ * @return The queue depth after the get
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+uint64_t rtaComponentStats_QueueGet(RtaComponentStats *stats, RtaDirection direction);
+
+/**
+ * The number of messages in the component's output queue
+ *
+ * @param [in] stats The stack-wide stats of the component
+ * @param [in] direction RTA_UP or RTA_DOWN
+ *
+ * @return The current depth
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+uint64_t rtaComponentStats_GetQueueDepth(const RtaComponentStats *stats, RtaDirection direction);
+
+/**
+ * The largest number of messages ever in the component's output queue
+ *
+ * @param [in] stats The stack-wide stats of the component
+ * @param [in] direction RTA_UP or RTA_DOWN
+ *
+ * @return The high-water mark
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+uint64_t rtaComponentStats_GetQueueHighWater(const RtaComponentStats *stats, RtaDirection direction);
+
 /**
  * dump the stats to the given output
  *
@@ -193,6 +390,28 @@ uint64_t rtaComponentStats_Get(RtaComponentStats *stats, RtaComponentStatType st
  */
 void rtaComponentStats_Dump(RtaComponentStats *stats, FILE *output);
 
+/**
+ * The counters and latency histograms as a JSON object
+ *
+ * Each counter is a key named by rtaComponentStatType_ToString().  Latency histograms
+ * that have been allocated appear under "latency", keyed "<stage>_up" or "<stage>_down"
+ * (see rtaLatencyHistogram_ToJSON()).  Output queues that have carried a message appear
+ * under "queue", keyed "up" or "down", each with "depth" and "highWater".
+ *
+ * @param [in] stats The stats
+ *
+ * @return non-null A PARCJSON object the caller must release
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCJSON *json = rtaComponentStats_ToJSON(rtaProtocolStack_GetStats(stack, FC_VEGAS));
+ *     parcJSON_Release(&json);
+ * }
+ * @endcode
+ */
+PARCJSON *rtaComponentStats_ToJSON(RtaComponentStats *stats);
+
 /**
  * <#One Line Description#>
  *
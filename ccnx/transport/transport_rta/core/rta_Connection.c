@@ -70,6 +70,9 @@
 #include <ccnx/transport/transport_rta/core/rta_ProtocolStack.h>
 #include <ccnx/transport/transport_rta/core/rta_Connection.h>
 #include <ccnx/transport/transport_rta/core/rta_Component.h>
+#include <ccnx/transport/transport_rta/core/rta_ConnectionCounters.h>
+#include <ccnx/transport/transport_rta/core/rta_InlineQueue.h>
+#include <ccnx/transport/transport_rta/core/rta_SendQueue.h>
 
 #include <ccnx/api/notify/notify_Status.h>
 #include <ccnx/api/control/cpi_ControlFacade.h>
@@ -97,9 +100,13 @@ struct rta_connection {
     void                   *component_data[LAST_COMPONENT];
     RtaComponentStats         *component_stats[LAST_COMPONENT];
 
+    // backing store for component_stats, shared with the API thread
+    RtaConnectionCounters     *counters;
+
     RtaConnectionStateType connState;
 
     unsigned messages_in_queue;
+    unsigned messages_in_queue_high_water;
     unsigned refcount;
 
     PARCJSON                *params;
@@ -109,6 +116,12 @@ struct rta_connection {
     int api_fd;
     int transport_fd;
 
+    // Set by an inline transport instead of the socket pair, otherwise NULL
+    RtaInlineQueue *inlineQueue;
+
+    // Set by a threaded transport, application threads put outbound messages on it
+    RtaSendQueue *sendQueue;
+
     // is the connection blocked in the given direction?
     bool blocked_down;
     bool blocked_up;
@@ -121,6 +134,27 @@ rtaConnection_GetStats(RtaConnection *conn, RtaComponents component)
     return conn->component_stats[component];
 }
 
+RtaConnectionCounters *
+rtaConnection_GetCounters(RtaConnection *conn)
+{
+    assertNotNull(conn, "called with null connection\n");
+    return conn->counters;
+}
+
+RtaInlineQueue *
+rtaConnection_GetInlineQueue(const RtaConnection *conn)
+{
+    assertNotNull(conn, "called with null connection\n");
+    return conn->inlineQueue;
+}
+
+RtaSendQueue *
+rtaConnection_GetSendQueue(const RtaConnection *conn)
+{
+    assertNotNull(conn, "called with null connection\n");
+    return conn->sendQueue;
+}
+
 RtaConnection *
 rtaConnection_Create(RtaProtocolStack *stack, const RtaCommandOpenConnection *cmdOpen)
 {
@@ -141,10 +175,33 @@ rtaConnection_Create(RtaProtocolStack *stack, const RtaCommandOpenConnection *cm
     conn->blocked_down = false;
     conn->blocked_up = false;
 
+    // The transport normally creates the counters so the application can read them.
+    // If it did not, e.g. in unit tests, the connection keeps a private block.
+    RtaConnectionCounters *counters = rtaCommandOpenConnection_GetCounters(cmdOpen);
+    if (counters != NULL) {
+        conn->counters = rtaConnectionCounters_Acquire(counters);
+    } else {
+        conn->counters = rtaConnectionCounters_Create();
+    }
+
+    RtaInlineQueue *inlineQueue = rtaCommandOpenConnection_GetInlineQueue(cmdOpen);
+    if (inlineQueue != NULL) {
+        conn->inlineQueue = rtaInlineQueue_Acquire(inlineQueue);
+    }
+
+    RtaSendQueue *sendQueue = rtaCommandOpenConnection_GetSendQueue(cmdOpen);
+    if (sendQueue != NULL) {
+        conn->sendQueue = rtaSendQueue_Acquire(sendQueue);
+    }
+
+    bool connectionLatency = rtaFramework_GetConnectionLatency(conn->framework);
     for (i = 0; i < LAST_COMPONENT; i++) {
-        conn->component_stats[i] = rtaComponentStats_Create(stack, i);
+        conn->component_stats[i] = rtaComponentStats_CreateShared(stack, i, conn->counters);
+        rtaComponentStats_SetConnectionLatency(conn->component_stats[i], connectionLatency);
     }
 
+    rtaConnection_Trace(conn, API_CONNECTOR, RtaTraceEvent_ConnectionOpen, (uint64_t) conn->api_fd);
+
     if (DEBUG_OUTPUT) {
         fprintf(stderr, "%9" PRIu64 " %s connection %p refcount %d\n",
                 rtaFramework_GetTicks(conn->framework), __func__, (void *) conn, conn->refcount);
@@ -219,8 +276,15 @@ rtaConnection_Destroy(RtaConnection **connPtr)
     for (i = 0; i < LAST_COMPONENT; i++) {
         rtaComponentStats_Destroy(&conn->component_stats[i]);
     }
+    rtaConnectionCounters_Release(&conn->counters);
 
     rtaFramework_RemoveConnection(conn->framework, conn);
+    if (conn->inlineQueue != NULL) {
+        rtaInlineQueue_Release(&conn->inlineQueue);
+    }
+    if (conn->sendQueue != NULL) {
+        rtaSendQueue_Release(&conn->sendQueue);
+    }
     parcJSON_Release(&conn->params);
     parcMemory_Deallocate((void **) &conn);
     *connPtr = NULL;
@@ -268,10 +332,29 @@ void
 rtaConnection_SetState(RtaConnection *conn, RtaConnectionStateType connState)
 {
     assertNotNull(conn, "called with null connection\n");
+    if (connState == CONN_CLOSED && conn->connState != CONN_CLOSED) {
+        rtaConnection_Trace(conn, API_CONNECTOR, RtaTraceEvent_ConnectionClose, (uint64_t) conn->api_fd);
+    }
     conn->connState = connState;
     rtaProtocolStack_ConnectionStateChange(conn->stack, conn);
 }
 
+void
+rtaConnection_Trace(RtaConnection *conn, RtaComponents component, RtaTraceEvent event, uint64_t value)
+{
+    if (conn->framework != NULL) {
+        rtaTraceRing_Record(rtaFramework_GetTraceRing(conn->framework), conn->connid, component, event, value);
+    }
+}
+
+void
+rtaConnection_TraceAt(RtaConnection *conn, uint64_t timestamp, RtaComponents component, RtaTraceEvent event, uint64_t value)
+{
+    if (conn->framework != NULL) {
+        rtaTraceRing_RecordAt(rtaFramework_GetTraceRing(conn->framework), timestamp, conn->connid, component, event, value);
+    }
+}
+
 /*
  * returns number in queue, including this one
  */
@@ -281,6 +364,9 @@ rtaConnection_IncrementMessagesInQueue(RtaConnection *conn)
     assertNotNull(conn, "called with null connection\n");
     assertTrue(conn->connState != CONN_CLOSED, "%s called when connection closed\n", __func__);
     conn->messages_in_queue++;
+    if (conn->messages_in_queue > conn->messages_in_queue_high_water) {
+        conn->messages_in_queue_high_water = conn->messages_in_queue;
+    }
     return conn->messages_in_queue;
 }
 
@@ -322,6 +408,13 @@ rtaConnection_MessagesInQueue(RtaConnection *conn)
     return conn->messages_in_queue;
 }
 
+unsigned
+rtaConnection_MessagesInQueueHighWater(RtaConnection *conn)
+{
+    assertNotNull(conn, "called with null connection\n");
+    return conn->messages_in_queue_high_water;
+}
+
 unsigned
 rtaConnection_GetConnectionId(const RtaConnection *conn)
 {
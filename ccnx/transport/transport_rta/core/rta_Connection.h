@@ -93,6 +93,7 @@
 #include <ccnx/transport/transport_rta/core/components.h>
 #include <ccnx/transport/transport_rta/core/rta_ProtocolStack.h>
 #include <ccnx/transport/transport_rta/core/rta_ComponentStats.h>
+#include <ccnx/transport/transport_rta/core/rta_TraceRing.h>
 #include <ccnx/transport/transport_rta/commands/rta_CommandOpenConnection.h>
 
 #include <ccnx/api/notify/notify_Status.h>
@@ -278,6 +279,65 @@ void rtaConnection_SetState(RtaConnection *connection, RtaConnectionStateType st
  */
 RtaComponentStats *rtaConnection_GetStats(RtaConnection *connection, RtaComponents component);
 
+struct rta_connection_counters;
+
+/**
+ * Returns the counter block behind the connection's component stats
+ *
+ * The framework thread is the only writer.  Other threads may read it with
+ * rtaConnectionCounters_Snapshot().
+ *
+ * @param [in] connection An allocated connection
+ *
+ * @return non-null The connection's counters
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+struct rta_connection_counters *rtaConnection_GetCounters(RtaConnection *connection);
+
+struct rta_inline_queue;
+
+/**
+ * Returns the queue an inline transport reads this connection's messages from
+ *
+ * When it is non-NULL, the connection has no socket pair: the API connector puts
+ * messages on the queue and the transport descriptor is -1.
+ *
+ * @param [in] connection An allocated connection
+ *
+ * @return non-null The queue from the RtaCommandOpenConnection
+ * @return null The connection uses its socket pair
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+struct rta_inline_queue *rtaConnection_GetInlineQueue(const RtaConnection *connection);
+
+struct rta_send_queue;
+
+/**
+ * Returns the queue application threads put this connection's outbound messages on
+ *
+ * When it is non-NULL, the transport descriptor carries only wake-ups, the API connector
+ * takes the messages off the queue (see rtaSendQueue_Notify()).
+ *
+ * @param [in] connection An allocated connection
+ *
+ * @return non-null The queue from the RtaCommandOpenConnection
+ * @return null Messages arrive as pointers on the socket pair
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+struct rta_send_queue *rtaConnection_GetSendQueue(const RtaConnection *connection);
+
 /**
  * <#One Line Description#>
  *
@@ -332,6 +392,57 @@ unsigned rtaConnection_DecrementMessagesInQueue(RtaConnection *connection);
  */
 unsigned rtaConnection_MessagesInQueue(RtaConnection *connection);
 
+/**
+ * The largest number of the connection's messages ever in the stack's queues at once
+ *
+ * @param [in] connection An allocated connection
+ *
+ * @return The high-water mark of rtaConnection_MessagesInQueue()
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+unsigned rtaConnection_MessagesInQueueHighWater(RtaConnection *connection);
+
+/**
+ * Record an event of the connection in the framework's flight recorder
+ *
+ * Cheap enough to call for every message.  Must be called from the Transport thread.
+ *
+ * @param [in] connection An allocated connection
+ * @param [in] component The component reporting the event
+ * @param [in] event The event
+ * @param [in] value Event specific, see RtaTraceEvent
+ *
+ * Example:
+ * @code
+ * {
+ *     rtaConnection_Trace(conn, FC_VEGAS, RtaTraceEvent_InterestSent, segnum);
+ * }
+ * @endcode
+ */
+void rtaConnection_Trace(RtaConnection *connection, RtaComponents component, RtaTraceEvent event, uint64_t value);
+
+/**
+ * Record an event with a timestamp the caller already read, see rtaTraceRing_RecordAt()
+ *
+ * @param [in] connection An allocated connection
+ * @param [in] timestamp Nanoseconds on CLOCK_MONOTONIC
+ * @param [in] component The component reporting the event
+ * @param [in] event The event
+ * @param [in] value Event specific, see RtaTraceEvent
+ *
+ * Example:
+ * @code
+ * {
+ *     rtaConnection_TraceAt(conn, transportMessage_GetBoundaryTime(tm), FC_VEGAS, RtaTraceEvent_Put, (uint64_t) (uintptr_t) tm);
+ * }
+ * @endcode
+ */
+void rtaConnection_TraceAt(RtaConnection *connection, uint64_t timestamp, RtaComponents component, RtaTraceEvent event, uint64_t value);
+
 /**
  * <#One Line Description#>
  *
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <LongBow/runtime.h>
+#include <parc/algol/parc_Memory.h>
+
+#include <ccnx/transport/transport_rta/core/rta_ConnectionCounters.h>
+
+#define RTA_CACHE_LINE_SIZE 64
+
+struct rta_connection_counters {
+    // Written only by the Transport thread
+    uint64_t rows[LAST_COMPONENT][STATS_LAST];
+
+    // Written once each as the connection opens
+    uint64_t limits[RTA_LIMIT_LAST];
+
+    // Touched by both threads, but only on acquire and release, so keep it off the counter lines
+    unsigned refcount __attribute__ ((aligned(RTA_CACHE_LINE_SIZE)));
+} __attribute__ ((aligned(RTA_CACHE_LINE_SIZE)));
+
+RtaConnectionCounters *
+rtaConnectionCounters_Create(void)
+{
+    void *memory = NULL;
+    int failure = parcMemory_MemAlign(&memory, RTA_CACHE_LINE_SIZE, sizeof(RtaConnectionCounters));
+    assertFalse(failure, "parcMemory_MemAlign(%d, %zu) failed", RTA_CACHE_LINE_SIZE, sizeof(RtaConnectionCounters));
+
+    RtaConnectionCounters *counters = memory;
+    memset(counters, 0, sizeof(RtaConnectionCounters));
+    counters->refcount = 1;
+    return counters;
+}
+
+RtaConnectionCounters *
+rtaConnectionCounters_Acquire(const RtaConnectionCounters *counters)
+{
+    assertNotNull(counters, "Parameter counters must be non-null");
+    RtaConnectionCounters *result = (RtaConnectionCounters *) counters;
+    __atomic_add_fetch(&result->refcount, 1, __ATOMIC_RELAXED);
+    return result;
+}
+
+void
+rtaConnectionCounters_Release(RtaConnectionCounters **countersPtr)
+{
+    assertNotNull(countersPtr, "Parameter countersPtr must be non-null");
+    RtaConnectionCounters *counters = *countersPtr;
+    assertNotNull(counters, "Parameter countersPtr must dereference to non-null");
+
+    if (__atomic_sub_fetch(&counters->refcount, 1, __ATOMIC_ACQ_REL) == 0) {
+        parcMemory_Deallocate((void **) &counters);
+    }
+    *countersPtr = NULL;
+}
+
+uint64_t *
+rtaConnectionCounters_GetRow(RtaConnectionCounters *counters, RtaComponents component)
+{
+    assertNotNull(counters, "Parameter counters must be non-null");
+    assertTrue(component < LAST_COMPONENT, "invalid component %d", component);
+    return counters->rows[component];
+}
+
+void
+rtaConnectionCounters_SetLimit(RtaConnectionCounters *counters, RtaConnectionLimit limit, uint64_t value)
+{
+    assertNotNull(counters, "Parameter counters must be non-null");
+    assertTrue(limit < RTA_LIMIT_LAST, "invalid limit %d", limit);
+    rtaConnectionCounters_Store(&counters->limits[limit], value);
+}
+
+void
+rtaConnectionCounters_Snapshot(const RtaConnectionCounters *counters, RtaConnectionStats *output)
+{
+    assertNotNull(counters, "Parameter counters must be non-null");
+    assertNotNull(output, "Parameter output must be non-null");
+
+    for (int component = 0; component < LAST_COMPONENT; component++) {
+        for (int statType = 0; statType < STATS_LAST; statType++) {
+            output->counters[component][statType] = rtaConnectionCounters_Load(&counters->rows[component][statType]);
+        }
+    }
+
+    for (int limit = 0; limit < RTA_LIMIT_LAST; limit++) {
+        output->limits[limit] = rtaConnectionCounters_Load(&counters->limits[limit]);
+    }
+}
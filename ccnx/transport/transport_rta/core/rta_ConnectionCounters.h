@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file rta_ConnectionCounters.h
+ * @brief The per-connection counter block shared between the Transport and API threads
+ *
+ * Each connection's RtaComponentStats counters live in one cache-line aligned block,
+ * a row of STATS_LAST counters per component.  The Transport thread is the only writer,
+ * so an increment is a plain add followed by a relaxed atomic store, with no locked
+ * instruction.  Any other thread may read the block with relaxed atomic loads, for
+ * example through rtaTransport_GetConnectionStats().  Each counter is individually
+ * consistent, but a snapshot of the block is not a single point in time.
+ *
+ * The block also records the connection's queue limits (RtaConnectionLimit), the sizes
+ * that actually took effect at the API boundary.  Each is written once when the connection
+ * opens, by the thread that calls rtaTransport_Open() or by the Transport thread,
+ * whichever applies that limit.
+ *
+ * The block is reference counted, so the API side can hold it after the Transport
+ * has destroyed the connection.
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef Libccnx_rta_ConnectionCounters_h
+#define Libccnx_rta_ConnectionCounters_h
+
+#include <stdint.h>
+
+#include <ccnx/transport/transport_rta/core/components.h>
+#include <ccnx/transport/transport_rta/core/rta_ComponentStats.h>
+
+struct rta_connection_counters;
+typedef struct rta_connection_counters RtaConnectionCounters;
+
+/**
+ * @typedef RtaConnectionLimit
+ * @abstract The queue limits recorded for a connection, 0 where the connection has no such queue
+ * @constant RTA_LIMIT_SEND_QUEUE_DEPTH Messages the send queue holds
+ * @constant RTA_LIMIT_RECEIVE_BUFFER SO_RCVBUF of the socket pair, in bytes, as the kernel reports it
+ * @constant RTA_LIMIT_SEND_BUFFER SO_SNDBUF of the Transport's end of the socket pair, as the kernel reports it
+ * @constant RTA_LIMIT_WRITE_WATERMARK Bytes of the API connector's write queue below which it unblocks the UP direction
+ */
+typedef enum rta_connection_limit {
+    RTA_LIMIT_SEND_QUEUE_DEPTH = 0,
+    RTA_LIMIT_RECEIVE_BUFFER = 1,
+    RTA_LIMIT_SEND_BUFFER = 2,
+    RTA_LIMIT_WRITE_WATERMARK = 3,
+    RTA_LIMIT_LAST = 4
+} RtaConnectionLimit;
+
+/**
+ * A copy of a connection's counters, indexed by [component][statType], and its limits
+ */
+typedef struct rta_connection_stats {
+    uint64_t counters[LAST_COMPONENT][STATS_LAST];
+    uint64_t limits[RTA_LIMIT_LAST];
+} RtaConnectionStats;
+
+/**
+ * Create a zeroed, cache-line aligned counter block with a reference count of 1
+ *
+ * @return non-null An allocated counter block
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaConnectionCounters *counters = rtaConnectionCounters_Create();
+ *     rtaConnectionCounters_Release(&counters);
+ * }
+ * @endcode
+ */
+RtaConnectionCounters *rtaConnectionCounters_Create(void);
+
+/**
+ * Increase the number of references to the counter block.  Safe from any thread.
+ *
+ * @param [in] counters The counter block
+ *
+ * @return non-null A reference to `counters`
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+RtaConnectionCounters *rtaConnectionCounters_Acquire(const RtaConnectionCounters *counters);
+
+/**
+ * Release a reference to the counter block, freeing it on the last release.  Safe from any thread.
+ *
+ * @param [in,out] countersPtr The reference to release, will be NULL'd
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaConnectionCounters_Release(RtaConnectionCounters **countersPtr);
+
+/**
+ * The STATS_LAST counters of one component
+ *
+ * Only the Transport thread may write through the pointer, and it must use
+ * rtaConnectionCounters_Store() so readers never see a torn value.
+ *
+ * @param [in] counters The counter block
+ * @param [in] component The component
+ *
+ * @return non-null The row of counters for the component
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+uint64_t *rtaConnectionCounters_GetRow(RtaConnectionCounters *counters, RtaComponents component);
+
+/**
+ * Single-writer store of one counter
+ *
+ * @param [in] counter A counter in a row from rtaConnectionCounters_GetRow()
+ * @param [in] value The new value
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+static inline void
+rtaConnectionCounters_Store(uint64_t *counter, uint64_t value)
+{
+    __atomic_store_n(counter, value, __ATOMIC_RELAXED);
+}
+
+/**
+ * Read one counter from any thread
+ *
+ * @param [in] counter A counter in a row from rtaConnectionCounters_GetRow()
+ *
+ * @return The counter value
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+static inline uint64_t
+rtaConnectionCounters_Load(const uint64_t *counter)
+{
+    return __atomic_load_n(counter, __ATOMIC_RELAXED);
+}
+
+/**
+ * Record one of the connection's queue limits
+ *
+ * @param [in] counters The counter block
+ * @param [in] limit Which limit
+ * @param [in] value The size that took effect
+ *
+ * Example:
+ * @code
+ * {
+ *     rtaConnectionCounters_SetLimit(counters, RTA_LIMIT_SEND_QUEUE_DEPTH, rtaSendQueue_Capacity(queue));
+ * }
+ * @endcode
+ */
+void rtaConnectionCounters_SetLimit(RtaConnectionCounters *counters, RtaConnectionLimit limit, uint64_t value);
+
+/**
+ * Copy all counters and limits of the block from any thread
+ *
+ * @param [in] counters The counter block
+ * @param [out] output Filled in with the counters
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaConnectionStats stats;
+ *     rtaConnectionCounters_Snapshot(counters, &stats);
+ *     printf("codec upcalls %" PRIu64 "\n", stats.counters[CODEC_TLV][STATS_UPCALL_IN]);
+ * }
+ * @endcode
+ */
+void rtaConnectionCounters_Snapshot(const RtaConnectionCounters *counters, RtaConnectionStats *output);
+#endif // Libccnx_rta_ConnectionCounters_h
@@ -57,10 +57,16 @@
  * @copyright (c) 2013-2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
  */
 /*
- * Uses a linked list right now, but should be hash tables on the keys we use.
+ * Uses a linked list, plus an array indexed by api_fd so the lookups on every open and
+ * close do not walk the whole table.  Descriptors are small dense integers, so the index
+ * is at most a pointer per descriptor the process has open.
+ *
+ * If two connections share an api_fd (the framework never does this), the index points
+ * at the first one added, which is what the linear search used to find.
  */
 #include <config.h>
 #include <stdio.h>
+#include <string.h>
 #include <sys/queue.h>
 
 #define __STDC_FORMAT_MACROS
@@ -85,8 +91,85 @@ struct rta_connection_table {
     size_t count_elements;
     TableFreeFunc *freefunc;
     TAILQ_HEAD(, rta_connection_entry) head;
+
+    // byApiFd[api_fd] is the first entry added with that api_fd, or NULL
+    RtaConnectionEntry **byApiFd;
+    size_t byApiFdLength;
+
+    // entries whose api_fd was already in the index when they were added
+    size_t duplicateApiFds;
 };
 
+static void
+_rtaConnectionTable_IndexAdd(RtaConnectionTable *table, RtaConnectionEntry *entry)
+{
+    int api_fd = rtaConnection_GetApiFd(entry->connection);
+    if (api_fd < 0) {
+        table->duplicateApiFds++;
+        return;
+    }
+
+    if ((size_t) api_fd >= table->byApiFdLength) {
+        size_t length = table->byApiFdLength == 0 ? 64 : table->byApiFdLength;
+        while (length <= (size_t) api_fd) {
+            length *= 2;
+        }
+
+        RtaConnectionEntry **byApiFd = parcMemory_AllocateAndClear(length * sizeof(RtaConnectionEntry *));
+        assertNotNull(byApiFd, "parcMemory_AllocateAndClear(%zu) returned NULL", length * sizeof(RtaConnectionEntry *));
+        if (table->byApiFd != NULL) {
+            memcpy(byApiFd, table->byApiFd, table->byApiFdLength * sizeof(RtaConnectionEntry *));
+            parcMemory_Deallocate((void **) &table->byApiFd);
+        }
+        table->byApiFd = byApiFd;
+        table->byApiFdLength = length;
+    }
+
+    if (table->byApiFd[api_fd] == NULL) {
+        table->byApiFd[api_fd] = entry;
+    } else {
+        table->duplicateApiFds++;
+    }
+}
+
+/*
+ * Called before `entry` is taken off the list
+ */
+static void
+_rtaConnectionTable_IndexRemove(RtaConnectionTable *table, RtaConnectionEntry *entry)
+{
+    int api_fd = rtaConnection_GetApiFd(entry->connection);
+    if (api_fd < 0 || (size_t) api_fd >= table->byApiFdLength || table->byApiFd[api_fd] != entry) {
+        assertTrue(table->duplicateApiFds > 0, "Invalid state, entry is not indexed and there are no duplicates");
+        table->duplicateApiFds--;
+        return;
+    }
+
+    table->byApiFd[api_fd] = NULL;
+
+    // promote the next entry with the same api_fd, if any
+    if (table->duplicateApiFds > 0) {
+        for (RtaConnectionEntry *next = TAILQ_NEXT(entry, list); next != NULL; next = TAILQ_NEXT(next, list)) {
+            if (rtaConnection_GetApiFd(next->connection) == api_fd) {
+                table->byApiFd[api_fd] = next;
+                table->duplicateApiFds--;
+                break;
+            }
+        }
+    }
+}
+
+static void
+_rtaConnectionTable_RemoveEntry(RtaConnectionTable *table, RtaConnectionEntry *entry)
+{
+    _rtaConnectionTable_IndexRemove(table, entry);
+    TAILQ_REMOVE(&table->head, entry, list);
+    if (table->freefunc) {
+        table->freefunc(&entry->connection);
+    }
+    parcMemory_Deallocate((void **) &entry);
+}
+
 
 /**
  * Create a connection table of the given size
@@ -127,14 +210,12 @@ rtaConnectionTable_Destroy(RtaConnectionTable **tablePtr)
     assertNotNull(table, "Called with parameter that dereferences to null");
 
     while (!TAILQ_EMPTY(&table->head)) {
-        RtaConnectionEntry *entry = TAILQ_FIRST(&table->head);
-        TAILQ_REMOVE(&table->head, entry, list);
-        if (table->freefunc) {
-            table->freefunc(&entry->connection);
-        }
-        parcMemory_Deallocate((void **) &entry);
+        _rtaConnectionTable_RemoveEntry(table, TAILQ_FIRST(&table->head));
     }
 
+    if (table->byApiFd != NULL) {
+        parcMemory_Deallocate((void **) &table->byApiFd);
+    }
     parcMemory_Deallocate((void **) &table);
     *tablePtr = NULL;
 }
@@ -160,11 +241,19 @@ rtaConnectionTable_AddConnection(RtaConnectionTable *table, RtaConnection *conne
         assertNotNull(entry, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(RtaConnectionEntry));
         entry->connection = connection;
         TAILQ_INSERT_TAIL(&table->head, entry, list);
+        _rtaConnectionTable_IndexAdd(table, entry);
         return 0;
     }
     return -1;
 }
 
+size_t
+rtaConnectionTable_Available(const RtaConnectionTable *table)
+{
+    assertNotNull(table, "Called with null parameter RtaConnectionTable");
+    return table->max_elements - table->count_elements;
+}
+
 /**
  * Lookup a connection.
  * Returns NULL if not found
@@ -179,12 +268,8 @@ rtaConnectionTable_GetByApiFd(RtaConnectionTable *table, int api_fd)
 {
     assertNotNull(table, "Called with null parameter RtaConnectionTable");
 
-    RtaConnectionEntry *entry;
-    TAILQ_FOREACH(entry, &table->head, list)
-    {
-        if (rtaConnection_GetApiFd(entry->connection) == api_fd) {
-            return entry->connection;
-        }
+    if (api_fd >= 0 && (size_t) api_fd < table->byApiFdLength && table->byApiFd[api_fd] != NULL) {
+        return table->byApiFd[api_fd]->connection;
     }
     return NULL;
 }
@@ -229,20 +314,29 @@ rtaConnectionTable_Remove(RtaConnectionTable *table, RtaConnection *connection)
     assertNotNull(table, "Called with null parameter RtaConnectionTable");
     assertNotNull(connection, "Called with null parameter RtaConnection");
 
-    RtaConnectionEntry *entry;
-    TAILQ_FOREACH(entry, &table->head, list)
-    {
-        if (entry->connection == connection) {
-            assertTrue(table->count_elements > 0, "Invalid state, found an entry, but count_elements is zero");
-            table->count_elements--;
-            TAILQ_REMOVE(&table->head, entry, list);
-            if (table->freefunc) {
-                table->freefunc(&entry->connection);
+    // the common case is the indexed entry, so try that before walking the list
+    RtaConnectionEntry *entry = NULL;
+    int api_fd = rtaConnection_GetApiFd(connection);
+    if (api_fd >= 0 && (size_t) api_fd < table->byApiFdLength && table->byApiFd[api_fd] != NULL
+        && table->byApiFd[api_fd]->connection == connection) {
+        entry = table->byApiFd[api_fd];
+    } else {
+        RtaConnectionEntry *candidate;
+        TAILQ_FOREACH(candidate, &table->head, list)
+        {
+            if (candidate->connection == connection) {
+                entry = candidate;
+                break;
             }
-            parcMemory_Deallocate((void **) &entry);
-            return 0;
         }
     }
+
+    if (entry != NULL) {
+        assertTrue(table->count_elements > 0, "Invalid state, found an entry, but count_elements is zero");
+        table->count_elements--;
+        _rtaConnectionTable_RemoveEntry(table, entry);
+        return 0;
+    }
     return -1;
 }
 
@@ -275,19 +369,29 @@ rtaConnectionTable_RemoveByStack(RtaConnectionTable *table, int stack_id)
                        (void *) entry->connection);
             }
 
-            TAILQ_REMOVE(&table->head, entry, list);
-            if (table->freefunc) {
-                table->freefunc(&entry->connection);
-            }
+            _rtaConnectionTable_RemoveEntry(table, entry);
 
             if (DEBUG_OUTPUT) {
                 printf("%9s %s FREEFUNC RETURNS\n",
                        " ", __func__);
             }
-
-            parcMemory_Deallocate((void **) &entry);
         }
         entry = temp;
     }
     return 0;
 }
+
+void
+rtaConnectionTable_ForEachInStack(RtaConnectionTable *table, int stack_id, TableVisitFunc *visitor, void *context)
+{
+    assertNotNull(table, "Called with null parameter RtaConnectionTable");
+    assertNotNull(visitor, "Called with null visitor");
+
+    RtaConnectionEntry *entry;
+    TAILQ_FOREACH(entry, &table->head, list)
+    {
+        if (rtaConnection_GetStackId(entry->connection) == stack_id) {
+            visitor(entry->connection, context);
+        }
+    }
+}
@@ -70,6 +70,8 @@ typedef struct rta_connection_table RtaConnectionTable;
 
 typedef void (TableFreeFunc)(RtaConnection **connection);
 
+typedef void (TableVisitFunc)(RtaConnection *connection, void *context);
+
 /**
  * Create a connection table of the given size.  Whenever a
  * connection is removed, the freefunc is called.  Be sure that
@@ -104,6 +106,17 @@ void rtaConnectionTable_Destroy(RtaConnectionTable **tablePtr);
  */
 int rtaConnectionTable_AddConnection(RtaConnectionTable *table, RtaConnection *connection);
 
+/**
+ * Returns how many more connections the table will take before
+ * rtaConnectionTable_AddConnection() fails
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+size_t rtaConnectionTable_Available(const RtaConnectionTable *table);
+
 /**
  * Lookup a connection.
  * Returns NULL if not found
@@ -147,4 +160,15 @@ int rtaConnectionTable_Remove(RtaConnectionTable *table, RtaConnection *connecti
  * @endcode
  */
 int rtaConnectionTable_RemoveByStack(RtaConnectionTable *table, int stack_id);
+
+/**
+ * Call visitor() on each connection in a given stack_id, in the order they were added.
+ * The visitor must not add or remove connections.
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaConnectionTable_ForEachInStack(RtaConnectionTable *table, int stack_id, TableVisitFunc *visitor, void *context);
 #endif
@@ -85,6 +85,7 @@
 
 #include <parc/algol/parc_Memory.h>
 #include <parc/algol/parc_ArrayList.h>
+#include <parc/algol/parc_JSON.h>
 #include <parc/logging/parc_LogReporterTextStdout.h>
 
 #include <ccnx/transport/transport_rta/core/rta_Framework.h>
@@ -109,12 +110,19 @@
 #define DEBUG_OUTPUT 0
 #endif
 
+// 64K records of 24 bytes, override with the environment variable RTA_TRACE_RECORDS
+#define RTA_TRACE_DEFAULT_RECORDS 65536
+
+// Queue size of the asynchronous logger when RTA_LOG_ASYNC does not give one
+#define RTA_LOG_ASYNC_DEFAULT_RECORDS 4096
+
 #include "rta_Framework_Commands.h"
 
 // ===================================================
 
 // event callbacks
 static void _signal_cb(int signalNumber, PARCEventType event, void *arg);
+static void _traceSignal_cb(int signalNumber, PARCEventType event, void *arg);
 static void _tick_cb(int, PARCEventType, void *);
 static void transmitStatisticsCallback(int fd, PARCEventType what, void *user_data);
 
@@ -184,6 +192,41 @@ _signal_cb(int signalNumber, PARCEventType event, void *arg)
 {
 }
 
+static void
+_traceSignal_cb(int signalNumber, PARCEventType event, void *arg)
+{
+    RtaFramework *framework = (RtaFramework *) arg;
+    if (!rtaFramework_DumpTrace(framework, framework->traceFilename)) {
+        rtaLogger_Log(framework->logger, RtaLoggerFacility_Framework, PARCLogLevel_Error, __func__,
+                      "could not write trace to %s: %s", framework->traceFilename, strerror(errno));
+    }
+}
+
+/*
+ * The trace ring is always on.  If the environment variable RTA_TRACE_FILE is set,
+ * SIGUSR2 dumps the ring to that file.
+ */
+static void
+rtaFramework_SetupTrace(RtaFramework *framework)
+{
+    size_t records = RTA_TRACE_DEFAULT_RECORDS;
+    char *recordsString = getenv("RTA_TRACE_RECORDS");
+    if (recordsString) {
+        unsigned long value = strtoul(recordsString, NULL, 10);
+        if (value > 0) {
+            records = value;
+        }
+    }
+    framework->traceRing = rtaTraceRing_Create(records);
+
+    char *filename = getenv("RTA_TRACE_FILE");
+    if (filename) {
+        framework->traceFilename = parcMemory_StringDuplicate(filename, strlen(filename));
+        framework->signal_usr2 = parcEventSignal_Create(framework->base, SIGUSR2, PARCEventType_Signal | PARCEventType_Persist, _traceSignal_cb, framework);
+        parcEventSignal_Start(framework->signal_usr2);
+    }
+}
+
 static void
 rtaFramework_InitializeEventScheduler(RtaFramework *framework)
 {
@@ -286,6 +329,66 @@ _setLogLevels(RtaFramework *framework)
     }
 }
 
+/*
+ * "RTA_LOG_ASYNC=records" moves log formatting and I/O off the Transport thread to a
+ * writer thread with a queue of that many records (4096 if the value is not a number).
+ * "RTA_LOG_RATE=n" limits every facility to n messages per second.
+ */
+static void
+_setLogMode(RtaFramework *framework)
+{
+    char *rateString = getenv("RTA_LOG_RATE");
+    if (rateString) {
+        unsigned long rate = strtoul(rateString, NULL, 10);
+        for (int i = 0; i < RtaLoggerFacility_END; i++) {
+            rtaLogger_SetRateLimit(framework->logger, i, (unsigned) rate);
+        }
+    }
+
+    char *asyncString = getenv("RTA_LOG_ASYNC");
+    if (asyncString) {
+        unsigned long records = strtoul(asyncString, NULL, 10);
+        if (records == 0) {
+            records = RTA_LOG_ASYNC_DEFAULT_RECORDS;
+        }
+        rtaLogger_StartAsync(framework->logger, records);
+    }
+}
+
+/*
+ * Default placement of the framework thread, which rtaFramework_SetThreadConfig() overrides:
+ * "RTA_FRAMEWORK_CPUS=0,2-3" pins it, "RTA_FRAMEWORK_SCHED=fifo|rr|other" with
+ * "RTA_FRAMEWORK_PRIORITY=n" sets its scheduling, and "RTA_FRAMEWORK_NUMA=node" sets its
+ * memory node.  Bad values are logged and ignored.
+ */
+static void
+_setThreadConfig(RtaFramework *framework)
+{
+    rtaThreadConfig_Init(&framework->threadConfig);
+
+    char *cpuString = getenv("RTA_FRAMEWORK_CPUS");
+    if (cpuString && !rtaThreadConfig_ParseCpuList(&framework->threadConfig, cpuString)) {
+        rtaLogger_Log(framework->logger, RtaLoggerFacility_Framework, PARCLogLevel_Warning, __func__,
+                      "Ignoring RTA_FRAMEWORK_CPUS '%s'", cpuString);
+    }
+
+    char *schedString = getenv("RTA_FRAMEWORK_SCHED");
+    if (schedString && !rtaThreadConfig_ParsePolicy(schedString, &framework->threadConfig.policy)) {
+        rtaLogger_Log(framework->logger, RtaLoggerFacility_Framework, PARCLogLevel_Warning, __func__,
+                      "Ignoring RTA_FRAMEWORK_SCHED '%s'", schedString);
+    }
+
+    char *priorityString = getenv("RTA_FRAMEWORK_PRIORITY");
+    if (priorityString) {
+        framework->threadConfig.priority = (int) strtol(priorityString, NULL, 10);
+    }
+
+    char *numaString = getenv("RTA_FRAMEWORK_NUMA");
+    if (numaString) {
+        framework->threadConfig.numaNode = (int) strtol(numaString, NULL, 10);
+    }
+}
+
 /**
  * Create a framework. This is a thread-safe function.
  *
@@ -295,7 +398,7 @@ _setLogLevels(RtaFramework *framework)
  * @endcode
  */
 RtaFramework *
-rtaFramework_Create(PARCRingBuffer1x1 *commandRingBuffer, PARCNotifier *commandNotifier)
+rtaFramework_Create(RtaCommandQueue *commandQueue, PARCNotifier *commandNotifier)
 {
     RtaFramework *framework = parcMemory_AllocateAndClear(sizeof(RtaFramework));
     assertNotNull(framework, "RtaFramework parcMemory_AllocateAndClear returned null");
@@ -305,6 +408,8 @@ rtaFramework_Create(PARCRingBuffer1x1 *commandRingBuffer, PARCNotifier *commandN
     parcLogReporter_Release(&reporter);
 
     _setLogLevels(framework);
+    _setLogMode(framework);
+    _setThreadConfig(framework);
 
     // setup the event scheduler
 
@@ -314,20 +419,28 @@ rtaFramework_Create(PARCRingBuffer1x1 *commandRingBuffer, PARCNotifier *commandN
     pthread_cond_init(&framework->status_cv, NULL);
     framework->status = FRAMEWORK_INIT;
 
-    framework->commandRingBuffer = parcRingBuffer1x1_Acquire(commandRingBuffer);
+    framework->commandQueue = rtaCommandQueue_Acquire(commandQueue);
     framework->commandNotifier = parcNotifier_Acquire(commandNotifier);
 
     framework->connid_next = 1;
     TAILQ_INIT(&framework->protocols_head);
 
-    // make 16384 configurable (see case 911).
-    framework->connectionTable = rtaConnectionTable_Create(16384, rtaFramework_ConnectionTableFreeFunc);
+    // rtaFramework_SetMaxConnections() may replace the table before any connection opens
+    framework->connectionTable = rtaConnectionTable_Create(RTA_FRAMEWORK_MAX_CONNECTIONS_DEFAULT, rtaFramework_ConnectionTableFreeFunc);
     assertNotNull(framework->connectionTable, "Could not allocate conneciton table");
 
     rtaFramework_InitializeEventScheduler(framework);
 
     rtaFramework_SetupMillisecondTimer(framework);
 
+    rtaFramework_SetupTrace(framework);
+
+    // Latency histograms are kept per stack unless RTA_CONNECTION_LATENCY is set
+    char *latencyString = getenv("RTA_CONNECTION_LATENCY");
+    framework->connectionLatency = (latencyString != NULL && strtol(latencyString, NULL, 10) > 0);
+
+    framework->timerWheel = rtaTimerWheel_Create(framework->base, framework->clock_ticks);
+
     framework->transmit_statistics_event = parcEventTimer_Create(framework->base,
                                                      PARCEventType_Persist,
                                                      transmitStatisticsCallback,
@@ -344,11 +457,24 @@ rtaFramework_Create(PARCRingBuffer1x1 *commandRingBuffer, PARCNotifier *commandN
     return framework;
 }
 
+void
+rtaFramework_SetMaxConnections(RtaFramework *framework, size_t maxConnections)
+{
+    assertNotNull(framework, "Parameter framework must be non-null");
+    assertTrue(maxConnections > 0, "Parameter maxConnections must be positive");
+    assertTrue(framework->status == FRAMEWORK_INIT, "Framework must be in the INIT state, got %d", framework->status);
+
+    // No connection can be open yet, so the table is empty
+    rtaConnectionTable_Destroy(&framework->connectionTable);
+    framework->connectionTable = rtaConnectionTable_Create(maxConnections, rtaFramework_ConnectionTableFreeFunc);
+}
+
 static void
 rtaFramework_DestroyEventScheduler(RtaFramework *framework)
 {
     parcEventTimer_Destroy(&(framework->tick_event));
     parcEventTimer_Destroy(&(framework->transmit_statistics_event));
+    rtaTimerWheel_Destroy(&(framework->timerWheel));
 
     if (framework->signal_int != NULL) {
         parcEventSignal_Destroy(&(framework->signal_int));
@@ -356,10 +482,13 @@ rtaFramework_DestroyEventScheduler(RtaFramework *framework)
     if (framework->signal_usr1 != NULL) {
         parcEventSignal_Destroy(&(framework->signal_usr1));
     }
+    if (framework->signal_usr2 != NULL) {
+        parcEventSignal_Destroy(&(framework->signal_usr2));
+    }
 
     parcEvent_Destroy(&(framework->commandEvent));
     parcNotifier_Release(&framework->commandNotifier);
-    parcRingBuffer1x1_Release(&framework->commandRingBuffer);
+    rtaCommandQueue_Release(&framework->commandQueue);
 
     parcEventSignal_Destroy(&(framework->signal_pipe));
     parcEventScheduler_Destroy(&(framework->base));
@@ -391,10 +520,19 @@ rtaFramework_Destroy(RtaFramework **frameworkPtr)
 
     rtaConnectionTable_Destroy(&framework->connectionTable);
 
+    if (framework->holdersByStackId != NULL) {
+        parcMemory_Deallocate((void **) &framework->holdersByStackId);
+    }
+
     rtaFramework_DestroyEventScheduler(framework);
 
     rtaLogger_Release(&framework->logger);
 
+    rtaTraceRing_Destroy(&framework->traceRing);
+    if (framework->traceFilename != NULL) {
+        parcMemory_Deallocate((void **) &framework->traceFilename);
+    }
+
     parcMemory_Deallocate((void **) &framework);
 
     *frameworkPtr = NULL;
@@ -406,6 +544,35 @@ rtaFramework_GetLogger(RtaFramework *framework)
     return framework->logger;
 }
 
+RtaTraceRing *
+rtaFramework_GetTraceRing(RtaFramework *framework)
+{
+    assertNotNull(framework, "Parameter framework must be non-null");
+    return framework->traceRing;
+}
+
+bool
+rtaFramework_GetConnectionLatency(const RtaFramework *framework)
+{
+    assertNotNull(framework, "Parameter framework must be non-null");
+    return framework->connectionLatency;
+}
+
+bool
+rtaFramework_DumpTrace(RtaFramework *framework, const char *filename)
+{
+    assertNotNull(framework, "Parameter framework must be non-null");
+    assertNotNull(filename, "Parameter filename must be non-null");
+
+    bool success = rtaTraceRing_WriteFile(framework->traceRing, filename);
+    if (success && rtaLogger_IsLoggable(framework->logger, RtaLoggerFacility_Framework, PARCLogLevel_Info)) {
+        rtaLogger_Log(framework->logger, RtaLoggerFacility_Framework, PARCLogLevel_Info, __func__,
+                      "framework %p wrote %zu trace records to %s",
+                      (void *) framework, rtaTraceRing_GetCount(framework->traceRing), filename);
+    }
+    return success;
+}
+
 /**
  * May block briefly, returns the current status of the framework.
  *
@@ -482,6 +649,8 @@ _tick_cb(int fd, PARCEventType what, void *user_data)
     assertTrue(what & PARCEventType_Timeout, "%s got unknown signal %d", __func__, what);
     framework->clock_ticks++;
 
+    rtaTimerWheel_Advance(framework->timerWheel, framework->clock_ticks);
+
     if (framework->killme) {
         int res;
 
@@ -497,17 +666,72 @@ _tick_cb(int fd, PARCEventType what, void *user_data)
 
 FILE *GlobalStatisticsFile = NULL;
 
+typedef struct snapshot_connections {
+    RtaProtocolStack *stack;
+    PARCJSONArray *array;
+} _SnapshotConnections;
+
 static void
-transmitStatisticsCallback(int fd, PARCEventType what, void *user_data)
+_rtaFramework_SnapshotConnection(RtaConnection *connection, void *context)
 {
-    RtaFramework *framework = (RtaFramework *) user_data;
-    assertTrue(what & PARCEventType_Timeout, "unknown signal %d", what);
+    _SnapshotConnections *connections = context;
+    PARCJSON *json = rtaProtocolStack_GetConnectionStatisticsSnapshot(connections->stack, connection);
+    PARCJSONValue *value = parcJSONValue_CreateFromJSON(json);
+    parcJSON_Release(&json);
+    parcJSONArray_AddValue(connections->array, value);
+    parcJSONValue_Release(&value);
+}
+
+PARCJSON *
+rtaFramework_GetStatisticsSnapshot(RtaFramework *framework)
+{
+    assertNotNull(framework, "Parameter framework must be non-null");
+
+    struct timeval timeval;
+    gettimeofday(&timeval, NULL);
+
+    PARCJSONArray *stacks = parcJSONArray_Create();
 
     FrameworkProtocolHolder *holder;
     TAILQ_FOREACH(holder, &framework->protocols_head, list)
     {
-        RtaProtocolStack *stack = holder->stack;
-        PARCArrayList *list = rtaProtocolStack_GetStatistics(stack, GlobalStatisticsFile);
-        parcArrayList_Destroy(&list);
+        PARCJSON *stackJson = rtaProtocolStack_GetStatisticsSnapshot(holder->stack);
+
+        _SnapshotConnections connections = { .stack = holder->stack, .array = parcJSONArray_Create() };
+        rtaConnectionTable_ForEachInStack(framework->connectionTable, holder->stack_id, _rtaFramework_SnapshotConnection, &connections);
+        parcJSON_AddArray(stackJson, "connections", connections.array);
+        parcJSONArray_Release(&connections.array);
+
+        PARCJSONValue *value = parcJSONValue_CreateFromJSON(stackJson);
+        parcJSON_Release(&stackJson);
+        parcJSONArray_AddValue(stacks, value);
+        parcJSONValue_Release(&value);
     }
+
+    char timestring[64];
+    snprintf(timestring, sizeof(timestring), "%ld.%06u", (long) timeval.tv_sec, (unsigned) timeval.tv_usec);
+
+    PARCJSON *json = parcJSON_Create();
+    parcJSON_AddString(json, "timeval", timestring);
+    parcJSON_AddArray(json, "stacks", stacks);
+    parcJSONArray_Release(&stacks);
+    return json;
+}
+
+/*
+ * Appends one snapshot per period to the file from RtaCommandTransmitStatistics,
+ * one compact JSON object per line.
+ */
+static void
+transmitStatisticsCallback(int fd, PARCEventType what, void *user_data)
+{
+    RtaFramework *framework = (RtaFramework *) user_data;
+    assertTrue(what & PARCEventType_Timeout, "unknown signal %d", what);
+
+    PARCJSON *json = rtaFramework_GetStatisticsSnapshot(framework);
+    char *string = parcJSON_ToCompactString(json);
+    fprintf(GlobalStatisticsFile, "%s\n", string);
+    fflush(GlobalStatisticsFile);
+    parcMemory_Deallocate((void **) &string);
+    parcJSON_Release(&json);
 }
@@ -92,9 +92,10 @@
 #ifndef Libccnx_rta_Framework_h
 #define Libccnx_rta_Framework_h
 
-#include <parc/concurrent/parc_RingBuffer_1x1.h>
+#include <ccnx/transport/transport_rta/commands/rta_CommandQueue.h>
 #include <parc/concurrent/parc_Notifier.h>
 #include <ccnx/transport/transport_rta/core/rta_Logger.h>
+#include <ccnx/transport/transport_rta/core/rta_TraceRing.h>
 
 // ===================================
 // External API, used by rtaTransport
@@ -106,6 +107,12 @@ typedef struct rta_framework RtaFramework;
 #define RTA_NORMAL_PRIORITY 1
 #define RTA_MIN_PRIORITY    2
 
+/**
+ * @def RTA_FRAMEWORK_MAX_CONNECTIONS_DEFAULT
+ * The number of open connections a framework allows unless rtaFramework_SetMaxConnections() says otherwise
+ */
+#define RTA_FRAMEWORK_MAX_CONNECTIONS_DEFAULT 262144
+
 /**
  * Transient states: STARTING, STOPPING.  You don't want to block waiting for those
  * as you could easily miss them
@@ -164,16 +171,34 @@ typedef enum {
 
 /**
  * Creates the framework context, but does not start the worker thread.
- * <code>command_fd</code> is the socketpair or pipe (one-way is ok) over which
- * RTATransport will send commands.
+ * <code>commandQueue</code> is the queue over which RTATransport sends commands, from
+ * any number of threads, and <code>commandNotifier</code> wakes the framework after a write.
  *
  * Example:
  * @code
  * <#example#>
  * @endcode
  */
-RtaFramework *rtaFramework_Create(PARCRingBuffer1x1 *commandRingBuffer, PARCNotifier *commandNotifier);
+RtaFramework *rtaFramework_Create(RtaCommandQueue *commandQueue, PARCNotifier *commandNotifier);
 
+/**
+ * Sets how many connections may be open at once
+ *
+ * Must be called in the INIT state, before the first connection opens.  Once the limit
+ * is reached, an open command fails with EMFILE instead of creating the connection.
+ *
+ * @param [in] framework A framework in the INIT state
+ * @param [in] maxConnections The limit, greater than 0
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaFramework *framework = rtaFramework_Create(commandQueue, commandNotifier);
+ *     rtaFramework_SetMaxConnections(framework, 1024);
+ * }
+ * @endcode
+ */
+void rtaFramework_SetMaxConnections(RtaFramework *framework, size_t maxConnections);
 
 void rtaFramework_Destroy(RtaFramework **frameworkPtr);
 
@@ -193,6 +218,66 @@ void rtaFramework_Destroy(RtaFramework **frameworkPtr);
  */
 RtaLogger *rtaFramework_GetLogger(RtaFramework *framework);
 
+/**
+ * Returns the flight recorder of the framework
+ *
+ * Components record per-message events here, usually through rtaConnection_Trace().
+ * Only the Transport thread may use the ring.
+ *
+ * @param [in] framework An allocated RtaFramework
+ *
+ * @retval non-null The trace ring
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+RtaTraceRing *rtaFramework_GetTraceRing(RtaFramework *framework);
+
+/**
+ * Whether connections keep their own latency histograms
+ *
+ * A histogram is about 2 KB, and a connection could have one per component, stage and
+ * direction.  So by default latency is only kept per stack, and a connection's samples
+ * go straight into its stack's histograms.  Setting the environment variable
+ * RTA_CONNECTION_LATENCY=1 gives each connection its own histograms, which the stack
+ * merges when its statistics are read.
+ *
+ * @param [in] framework An allocated RtaFramework
+ *
+ * @return true Connections keep their own histograms
+ * @return false Only stacks keep histograms
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+bool rtaFramework_GetConnectionLatency(const RtaFramework *framework);
+
+/**
+ * Write the flight recorder to a file
+ *
+ * Must be called from the Transport thread.  If the environment variable RTA_TRACE_FILE
+ * is set when the framework is created, SIGUSR2 calls this with that file name.  Decode
+ * the file with test_tools/rta_tracedump.
+ *
+ * @param [in] framework An allocated RtaFramework
+ * @param [in] filename The file to write, it is replaced
+ *
+ * @return true The trace was written
+ * @return false An I/O error, errno is set
+ *
+ * Example:
+ * @code
+ * {
+ *     rtaFramework_DumpTrace(framework, "/tmp/rta.trace");
+ * }
+ * @endcode
+ */
+bool rtaFramework_DumpTrace(RtaFramework *framework, const char *filename);
+
 /**
  * May block briefly, returns the current status of the framework.
  *
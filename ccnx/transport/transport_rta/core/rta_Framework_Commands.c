@@ -73,6 +73,7 @@
 #include <ccnx/transport/transport_rta/core/rta_Framework_private.h>
 
 #include <ccnx/transport/transport_rta/core/rta_Connection.h>
+#include <ccnx/transport/transport_rta/core/rta_InlineQueue.h>
 #include <ccnx/transport/transport_rta/commands/rta_Command.h>
 
 #include <parc/algol/parc_Event.h>
@@ -87,12 +88,15 @@ extern FILE *GlobalStatisticsFile;
 
 static bool _rtaFramework_ExecuteCreateStack(RtaFramework *framework, const RtaCommandCreateProtocolStack *createStack);
 static bool _rtaFramework_ExecuteDestroyStack(RtaFramework *framework, const RtaCommandDestroyProtocolStack *destroyStack);
-static bool _rtaFramework_ExecuteOpenConnection(RtaFramework *framework, const RtaCommandOpenConnection *openConnection);
+static int _rtaFramework_ExecuteOpenConnection(RtaFramework *framework, const RtaCommandOpenConnection *openConnection);
+static int _rtaFramework_ExecuteOpenManyConnections(RtaFramework *framework, const RtaCommandOpenManyConnections *openMany);
 static bool _rtaFramework_ExecuteCloseConnection(RtaFramework *framework, const RtaCommandCloseConnection *closeConnection);
 static bool _rtaFramework_ExecuteTransmitStatistics(RtaFramework *framework, const RtaCommandTransmitStatistics *transmitStats);
+static bool _rtaFramework_ExecuteSnapshotStatistics(RtaFramework *framework, RtaCommandSnapshotStatistics *snapshotStats);
 static bool _rtaFramework_ExecuteShutdownFramework(RtaFramework *framework);
 
 static void rtaFramework_DrainApiDescriptor(int fd);
+static void rtaFramework_DrainApi(RtaConnection *connection);
 
 void
 rtaFramework_CommandCallback(int fd, PARCEventType what, void *user_framework)
@@ -103,16 +107,24 @@ rtaFramework_CommandCallback(int fd, PARCEventType what, void *user_framework)
     parcNotifier_PauseEvents(framework->commandNotifier);
 
     RtaCommand *command = NULL;
-    while ((command = rtaCommand_Read(framework->commandRingBuffer)) != NULL) {
+    while ((command = rtaCommand_Read(framework->commandQueue)) != NULL) {
         // The shutdown command can broadcast a change of state before the function
         // returns, so we need to free the RtaCommand before executing the shutdown.
         // Therefore, we include the rtaCommand_Destroy() as part of the switch.
+        //
+        // Open and Close report their result, the sender may be waiting in rtaCommand_WaitComplete().
 
         if (rtaCommand_IsOpenConnection(command)) {
-            _rtaFramework_ExecuteOpenConnection(framework, rtaCommand_GetOpenConnection(command));
+            int error = _rtaFramework_ExecuteOpenConnection(framework, rtaCommand_GetOpenConnection(command));
+            rtaCommand_SetComplete(command, error);
+            rtaCommand_Release(&command);
+        } else if (rtaCommand_IsOpenManyConnections(command)) {
+            int error = _rtaFramework_ExecuteOpenManyConnections(framework, rtaCommand_GetOpenManyConnections(command));
+            rtaCommand_SetComplete(command, error);
             rtaCommand_Release(&command);
         } else if (rtaCommand_IsCloseConnection(command)) {
-            _rtaFramework_ExecuteCloseConnection(framework, rtaCommand_GetCloseConnection(command));
+            bool closed = _rtaFramework_ExecuteCloseConnection(framework, rtaCommand_GetCloseConnection(command));
+            rtaCommand_SetComplete(command, closed ? 0 : EBADF);
             rtaCommand_Release(&command);
         } else if (rtaCommand_IsCreateProtocolStack(command)) {
             _rtaFramework_ExecuteCreateStack(framework, rtaCommand_GetCreateProtocolStack(command));
@@ -123,6 +135,9 @@ rtaFramework_CommandCallback(int fd, PARCEventType what, void *user_framework)
         } else if (rtaCommand_IsTransmitStatistics(command)) {
             _rtaFramework_ExecuteTransmitStatistics(framework, rtaCommand_GetTransmitStatistics(command));
             rtaCommand_Release(&command);
+        } else if (rtaCommand_IsSnapshotStatistics(command)) {
+            _rtaFramework_ExecuteSnapshotStatistics(framework, rtaCommand_GetSnapshotStatistics(command));
+            rtaCommand_Release(&command);
         } else if (rtaCommand_IsShutdownFramework(command)) {
             // release the command before executing shutdown
             rtaCommand_Release(&command);
@@ -143,7 +158,7 @@ rtaFramework_CommandCallback(int fd, PARCEventType what, void *user_framework)
 
 /**
  * Create a protocol holder and insert it in the framework's
- * protocols_head list.
+ * protocols_head list and holdersByStackId index.
  *
  * Example:
  * @code
@@ -153,12 +168,31 @@ rtaFramework_CommandCallback(int fd, PARCEventType what, void *user_framework)
 static FrameworkProtocolHolder *
 rtaFramework_CreateProtocolHolder(RtaFramework *framework, PARCJSON *params, uint64_t kv_hash, int stack_id)
 {
+    assertTrue(stack_id >= 0, "Invalid stack_id %d", stack_id);
+
     // request for a new protocol stack, create it
     FrameworkProtocolHolder *holder = parcMemory_AllocateAndClear(sizeof(FrameworkProtocolHolder));
     assertNotNull(holder, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(FrameworkProtocolHolder));
 
     TAILQ_INSERT_TAIL(&framework->protocols_head, holder, list);
 
+    if ((size_t) stack_id >= framework->holdersByStackIdLength) {
+        size_t length = framework->holdersByStackIdLength == 0 ? 16 : framework->holdersByStackIdLength;
+        while (length <= (size_t) stack_id) {
+            length *= 2;
+        }
+
+        FrameworkProtocolHolder **index = parcMemory_AllocateAndClear(length * sizeof(FrameworkProtocolHolder *));
+        assertNotNull(index, "parcMemory_AllocateAndClear(%zu) returned NULL", length * sizeof(FrameworkProtocolHolder *));
+        if (framework->holdersByStackId != NULL) {
+            memcpy(index, framework->holdersByStackId, framework->holdersByStackIdLength * sizeof(FrameworkProtocolHolder *));
+            parcMemory_Deallocate((void **) &framework->holdersByStackId);
+        }
+        framework->holdersByStackId = index;
+        framework->holdersByStackIdLength = length;
+    }
+    framework->holdersByStackId[stack_id] = holder;
+
     holder->kv_hash = kv_hash;
     holder->stack_id = stack_id;
 
@@ -184,12 +218,8 @@ rtaFramework_CreateProtocolHolder(RtaFramework *framework, PARCJSON *params, uin
 static FrameworkProtocolHolder *
 rtaFramework_GetProtocolStackByStackId(RtaFramework *framework, int stack_id)
 {
-    FrameworkProtocolHolder *holder;
-    TAILQ_FOREACH(holder, &framework->protocols_head, list)
-    {
-        if (holder->stack_id == stack_id) {
-            return holder;
-        }
+    if (stack_id >= 0 && (size_t) stack_id < framework->holdersByStackIdLength) {
+        return framework->holdersByStackId[stack_id];
     }
     return NULL;
 }
@@ -213,13 +243,23 @@ _rtaFramework_ExecuteCreateStack(RtaFramework *framework, const RtaCommandCreate
     assertNull(holder, "Found a holder with stack_id %d, but we're asked to create it!",
                rtaCommandCreateProtocolStack_GetStackId(createStack));
 
-    uint64_t kv_hash = ccnxStackConfig_HashCode(rtaCommandCreateProtocolStack_GetStackConfig(createStack));
+    // The Transport compiles the configuration once, when it first opens the stack.  A command
+    // made from a bare configuration is compiled here.
+    RtaStackDescriptor *descriptor = rtaCommandCreateProtocolStack_GetDescriptor(createStack);
+    if (descriptor != NULL) {
+        descriptor = rtaStackDescriptor_Acquire(descriptor);
+    } else {
+        descriptor = rtaStackDescriptor_Create(rtaCommandCreateProtocolStack_GetStackConfig(createStack));
+    }
+
+    uint64_t kv_hash = rtaStackDescriptor_GetHash(descriptor);
 
     // this creates it and inserts in framework->protocols_head
     holder = rtaFramework_CreateProtocolHolder(framework, NULL, kv_hash, rtaCommandCreateProtocolStack_GetStackId(createStack));
 
     holder->stack =
-        rtaProtocolStack_Create(framework, rtaCommandCreateProtocolStack_GetConfig(createStack), rtaCommandCreateProtocolStack_GetStackId(createStack));
+        rtaProtocolStack_CreateFromDescriptor(framework, descriptor, rtaCommandCreateProtocolStack_GetStackId(createStack));
+    rtaStackDescriptor_Release(&descriptor);
     rtaProtocolStack_Configure(holder->stack);
 
     if (DEBUG_OUTPUT) {
@@ -229,20 +269,29 @@ _rtaFramework_ExecuteCreateStack(RtaFramework *framework, const RtaCommandCreate
     return 0;
 }
 
-static bool
-_rtaFramework_ExecuteOpenConnection(RtaFramework *framework, const RtaCommandOpenConnection *openConnection)
+/**
+ * Logs an open that does not fit in the connection table and returns its error
+ */
+static int
+_rtaFramework_RefuseOpen(RtaFramework *framework, size_t count)
 {
-    int res;
-    FrameworkProtocolHolder *holder;
-    RtaConnection *rtaConnection;
-
-    if (DEBUG_OUTPUT) {
-        printf("%9" PRIu64 " %s framework %p\n",
-               rtaFramework_GetTicks(framework), __func__, (void *) framework);
+    if (rtaLogger_IsLoggable(framework->logger, RtaLoggerFacility_Framework, PARCLogLevel_Warning)) {
+        rtaLogger_Log(framework->logger, RtaLoggerFacility_Framework, PARCLogLevel_Warning, __func__,
+                      "framework %p refused to open %zu connections, only %zu more allowed",
+                      (void *) framework, count, rtaConnectionTable_Available(framework->connectionTable));
     }
+    return EMFILE;
+}
 
-    holder = rtaFramework_GetProtocolStackByStackId(framework, rtaCommandOpenConnection_GetStackId(openConnection));
-    assertNotNull(holder, "Could not find stack_id %d", rtaCommandOpenConnection_GetStackId(openConnection));
+/**
+ * Opens one connection in a stack the caller already looked up.  The caller made sure
+ * the connection table has room.
+ */
+static void
+_rtaFramework_OpenConnectionInStack(RtaFramework *framework, FrameworkProtocolHolder *holder, const RtaCommandOpenConnection *openConnection)
+{
+    int res;
+    RtaConnection *rtaConnection;
 
     rtaConnection = rtaConnectionTable_GetByApiFd(framework->connectionTable, rtaCommandOpenConnection_GetApiNotifierFd(openConnection));
     assertNull(rtaConnection, "Found api_fd %d, but it should not exist!", rtaCommandOpenConnection_GetApiNotifierFd(openConnection));
@@ -265,8 +314,62 @@ _rtaFramework_ExecuteOpenConnection(RtaFramework *framework, const RtaCommandOpe
                rtaCommandOpenConnection_GetApiNotifierFd(openConnection),
                rtaCommandOpenConnection_GetTransportNotifierFd(openConnection));
     }
+}
 
-    return true;
+/**
+ * Returns 0, or EMFILE without opening the connection if the connection table is full
+ */
+static int
+_rtaFramework_ExecuteOpenConnection(RtaFramework *framework, const RtaCommandOpenConnection *openConnection)
+{
+    if (DEBUG_OUTPUT) {
+        printf("%9" PRIu64 " %s framework %p\n",
+               rtaFramework_GetTicks(framework), __func__, (void *) framework);
+    }
+
+    FrameworkProtocolHolder *holder = rtaFramework_GetProtocolStackByStackId(framework, rtaCommandOpenConnection_GetStackId(openConnection));
+    assertNotNull(holder, "Could not find stack_id %d", rtaCommandOpenConnection_GetStackId(openConnection));
+
+    if (rtaConnectionTable_Available(framework->connectionTable) == 0) {
+        return _rtaFramework_RefuseOpen(framework, 1);
+    }
+
+    _rtaFramework_OpenConnectionInStack(framework, holder, openConnection);
+    return 0;
+}
+
+/**
+ * Opens every connection of the batch, in order.  The stack lookup is done once for each
+ * run of connections on the same stack, which for rtaTransport_OpenMany() is all of them.
+ *
+ * Returns 0, or EMFILE without opening any connection if the whole batch does not fit
+ * in the connection table.
+ */
+static int
+_rtaFramework_ExecuteOpenManyConnections(RtaFramework *framework, const RtaCommandOpenManyConnections *openMany)
+{
+    if (DEBUG_OUTPUT) {
+        printf("%9" PRIu64 " %s framework %p count %zu\n",
+               rtaFramework_GetTicks(framework), __func__, (void *) framework, rtaCommandOpenManyConnections_Count(openMany));
+    }
+
+    if (rtaConnectionTable_Available(framework->connectionTable) < rtaCommandOpenManyConnections_Count(openMany)) {
+        return _rtaFramework_RefuseOpen(framework, rtaCommandOpenManyConnections_Count(openMany));
+    }
+
+    FrameworkProtocolHolder *holder = NULL;
+    for (size_t i = 0; i < rtaCommandOpenManyConnections_Count(openMany); i++) {
+        const RtaCommandOpenConnection *openConnection = rtaCommandOpenManyConnections_Get(openMany, i);
+        int stackId = rtaCommandOpenConnection_GetStackId(openConnection);
+
+        if (holder == NULL || holder->stack_id != stackId) {
+            holder = rtaFramework_GetProtocolStackByStackId(framework, stackId);
+            assertNotNull(holder, "Could not find stack_id %d", stackId);
+        }
+
+        _rtaFramework_OpenConnectionInStack(framework, holder, openConnection);
+    }
+    return 0;
 }
 
 
@@ -295,7 +398,7 @@ rtaFramework_CloseConnection(RtaFramework *framework, RtaConnection *connection)
     rtaConnection_SetState(connection, CONN_CLOSED);
     rtaProtocolStack_Close(rtaConnection_GetStack(connection), connection);
 
-    rtaFramework_DrainApiDescriptor(rtaConnection_GetApiFd(connection));
+    rtaFramework_DrainApi(connection);
 
 
     // Remove it from the connection table, which will free our reference to it.
@@ -316,7 +419,11 @@ static bool
 _rtaFramework_ExecuteCloseConnection(RtaFramework *framework, const RtaCommandCloseConnection *closeConnection)
 {
     RtaConnection *connection = rtaConnectionTable_GetByApiFd(framework->connectionTable, rtaCommandCloseConnection_GetApiNotifierFd(closeConnection));
-    assertNotNull(connection, "Could not find api_fd %d", rtaCommandCloseConnection_GetApiNotifierFd(closeConnection));
+    if (connection == NULL) {
+        rtaLogger_Log(framework->logger, RtaLoggerFacility_Framework, PARCLogLevel_Warning, __func__,
+                      "Could not find api_fd %d to close", rtaCommandCloseConnection_GetApiNotifierFd(closeConnection));
+        return false;
+    }
 
     return (rtaFramework_CloseConnection(framework, connection) == 0);
 }
@@ -358,6 +465,21 @@ rtaFramework_DrainApiDescriptor(int fd)
     }
 }
 
+/**
+ * Drains the messages the API has not read.  An inline connection has no socket
+ * pair, its messages are on the inline queue.
+ */
+static void
+rtaFramework_DrainApi(RtaConnection *connection)
+{
+    RtaInlineQueue *inlineQueue = rtaConnection_GetInlineQueue(connection);
+    if (inlineQueue != NULL) {
+        rtaInlineQueue_Drain(inlineQueue);
+    } else {
+        rtaFramework_DrainApiDescriptor(rtaConnection_GetApiFd(connection));
+    }
+}
+
 /**
  * This is a deferred callback from the RtaConnection when its last TransportMessage
  * has been purged from the queues.
@@ -372,7 +494,12 @@ rtaFramework_DrainApiDescriptor(int fd)
 void
 rtaFramework_RemoveConnection(RtaFramework *framework, RtaConnection *rtaConnection)
 {
-    rtaFramework_DrainApiDescriptor(rtaConnection_GetApiFd(rtaConnection));
+    rtaFramework_DrainApi(rtaConnection);
+
+    if (rtaConnection_GetInlineQueue(rtaConnection) != NULL) {
+        // no descriptors to close
+        return;
+    }
 
     if (DEBUG_OUTPUT) {
         printf("%9" PRIu64 " %s connection %p closing api_fd %d\n",
@@ -402,6 +529,7 @@ rtaFramework_DestroyProtocolHolder(RtaFramework *framework, FrameworkProtocolHol
     rtaProtocolStack_Destroy(&holder->stack);
 
     TAILQ_REMOVE(&framework->protocols_head, holder, list);
+    framework->holdersByStackId[holder->stack_id] = NULL;
 
     parcMemory_Deallocate((void **) &holder);
 }
@@ -491,3 +619,12 @@ _rtaFramework_ExecuteTransmitStatistics(RtaFramework *framework, const RtaComman
 
     return 0;
 }
+
+static bool
+_rtaFramework_ExecuteSnapshotStatistics(RtaFramework *framework, RtaCommandSnapshotStatistics *snapshotStats)
+{
+    PARCJSON *snapshot = rtaFramework_GetStatisticsSnapshot(framework);
+    rtaCommandSnapshotStatistics_SetSnapshot(snapshotStats, snapshot);
+    parcJSON_Release(&snapshot);
+    return true;
+}
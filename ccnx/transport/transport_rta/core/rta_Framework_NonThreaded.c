@@ -84,11 +84,19 @@
 #include "rta_Framework.h"
 #include "rta_ConnectionTable.h"
 #include "rta_Framework_Commands.h"
+#include "rta_Connection.h"
+#include "rta_ProtocolStack.h"
+
+#include <ccnx/transport/transport_rta/connectors/rta_ApiConnection.h>
 
 #ifndef DEBUG_OUTPUT
 #define DEBUG_OUTPUT 0
 #endif
 
+// Non-blocking passes of the event loop per virtual tick.  Each component hop is one pass,
+// so this lets a message cross a full stack down and back up within the tick it was sent.
+#define RTA_VIRTUAL_TIME_PASSES 20
+
 // This is implemented in rta_Framework_Commands
 void
 rtaFramework_DestroyProtocolHolder(RtaFramework *framework, FrameworkProtocolHolder *holder);
@@ -197,6 +205,199 @@ rtaFramework_NonThreadedStepTimed(RtaFramework *framework, struct timeval *durat
     return 0;
 }
 
+int
+rtaFramework_NonThreadedEnableVirtualTime(RtaFramework *framework)
+{
+    assertNotNull(framework, "Parameter framework must be non-null");
+
+    if (framework->status == FRAMEWORK_INIT) {
+        framework->status = FRAMEWORK_SETUP;
+    }
+
+    assertTrue(framework->status == FRAMEWORK_SETUP,
+               "Framework invalid state for non-threaded, expected %d got %d",
+               FRAMEWORK_SETUP,
+               framework->status
+               );
+
+    if (framework->status != FRAMEWORK_SETUP) {
+        return -1;
+    }
+
+    parcEventTimer_Stop(framework->tick_event);
+    framework->virtualTime = true;
+    return 0;
+}
+
+/*
+ * Run the event loop without blocking until the work of the current tick is done
+ */
+static int
+_rtaFramework_RunVirtualTick(RtaFramework *framework)
+{
+    for (int i = 0; i < RTA_VIRTUAL_TIME_PASSES; i++) {
+        if (parcEventScheduler_Start(framework->base, PARCEventSchedulerDispatchType_NonBlocking) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int
+rtaFramework_NonThreadedAdvance(RtaFramework *framework, uint64_t count)
+{
+    assertNotNull(framework, "Parameter framework must be non-null");
+    assertTrue(framework->virtualTime, "Framework is not in virtual time, call rtaFramework_NonThreadedEnableVirtualTime");
+
+    if (_rtaFramework_RunVirtualTick(framework) < 0) {
+        return -1;
+    }
+
+    for (uint64_t i = 0; i < count; i++) {
+        framework->clock_ticks++;
+        rtaTimerWheel_Advance(framework->timerWheel, framework->clock_ticks);
+
+        if (_rtaFramework_RunVirtualTick(framework) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * The microseconds since the framework was created, by the wall clock
+ */
+static uint64_t
+_rtaFramework_WallClockUsec(const RtaFramework *framework)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+
+    struct timeval elapsed;
+    timersub(&now, &framework->starttime, &elapsed);
+    return (uint64_t) elapsed.tv_sec * 1000000 + elapsed.tv_usec;
+}
+
+/*
+ * The tick timer only moves the clock one tick each time it fires, and an inline
+ * transport may not dispatch for a long while.  Move the clock to the wall clock
+ * so the timers that expired meanwhile run now.
+ */
+static void
+_rtaFramework_CatchUpClock(RtaFramework *framework)
+{
+    ticks now = _rtaFramework_WallClockUsec(framework) / FC_USEC_PER_TICK;
+    if (now > framework->clock_ticks) {
+        framework->clock_ticks = now;
+        rtaTimerWheel_Advance(framework->timerWheel, framework->clock_ticks);
+    }
+}
+
+int
+rtaFramework_NonThreadedDispatch(RtaFramework *framework, unsigned passes)
+{
+    assertNotNull(framework, "Parameter framework must be non-null");
+
+    if (framework->status == FRAMEWORK_INIT) {
+        framework->status = FRAMEWORK_SETUP;
+    }
+
+    assertTrue(framework->status == FRAMEWORK_SETUP,
+               "Framework invalid state for non-threaded, expected %d got %d",
+               FRAMEWORK_SETUP,
+               framework->status
+               );
+
+    if (framework->status != FRAMEWORK_SETUP) {
+        return -1;
+    }
+
+    if (!framework->virtualTime) {
+        _rtaFramework_CatchUpClock(framework);
+    }
+
+    for (unsigned i = 0; i < passes; i++) {
+        if (parcEventScheduler_Start(framework->base, PARCEventSchedulerDispatchType_NonBlocking) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void
+rtaFramework_NonThreadedSetDescriptorWatcher(RtaFramework *framework, RtaFrameworkDescriptorWatcher *watcher, void *arg)
+{
+    assertNotNull(framework, "Parameter framework must be non-null");
+    framework->descriptorWatcher = watcher;
+    framework->descriptorWatcherArg = arg;
+}
+
+uint64_t
+rtaFramework_NonThreadedNextDeadline(RtaFramework *framework)
+{
+    assertNotNull(framework, "Parameter framework must be non-null");
+
+    uint64_t expiry = rtaTimerWheel_NextExpiry(framework->timerWheel);
+    if (framework->virtualTime || expiry == UINT64_MAX) {
+        return UINT64_MAX;
+    }
+
+    // The clock may be up to a tick ahead of the wall clock, the wheel runs on the clock
+    uint64_t now = _rtaFramework_WallClockUsec(framework);
+    if (now < rtaFramework_TicksToUsec(framework->clock_ticks)) {
+        now = rtaFramework_TicksToUsec(framework->clock_ticks);
+    }
+    uint64_t due = rtaFramework_TicksToUsec(expiry);
+    return (due > now) ? due - now : 0;
+}
+
+bool
+rtaFramework_NonThreadedHasPendingWork(RtaFramework *framework)
+{
+    assertNotNull(framework, "Parameter framework must be non-null");
+
+    FrameworkProtocolHolder *holder;
+    TAILQ_FOREACH(holder, &framework->protocols_head, list)
+    {
+        if (rtaProtocolStack_HasQueuedMessages(holder->stack)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+rtaFramework_NonThreadedSend(RtaFramework *framework, int apiFd, CCNxMetaMessage *message)
+{
+    assertNotNull(framework, "Parameter framework must be non-null");
+    assertNotNull(message, "Parameter message must be non-null");
+
+    RtaConnection *connection = rtaConnectionTable_GetByApiFd(framework->connectionTable, apiFd);
+    if (connection == NULL || rtaConnection_GetState(connection) == CONN_CLOSED) {
+        errno = EBADF;
+        return false;
+    }
+
+    RtaApiConnection *apiConnection = rtaConnection_GetPrivateData(connection, API_CONNECTOR);
+    assertNotNull(apiConnection, "Connection api_fd %d has no API connector", apiFd);
+
+    if (!rtaApiConnection_SendDown(apiConnection, message)) {
+        errno = EWOULDBLOCK;
+        return false;
+    }
+    return true;
+}
+
+void
+rtaFramework_NonThreadedUnblockUp(RtaFramework *framework, int apiFd)
+{
+    assertNotNull(framework, "Parameter framework must be non-null");
+
+    RtaConnection *connection = rtaConnectionTable_GetByApiFd(framework->connectionTable, apiFd);
+    if (connection != NULL && rtaConnection_GetState(connection) != CONN_CLOSED && rtaConnection_BlockedUp(connection)) {
+        rtaConnection_ClearBlockedUp(connection);
+    }
+}
 
 /**
  * After a protocol stack is created, you need to Teardown.  If you
@@ -64,8 +64,13 @@
 #ifndef Libccnx_rta_Framework_NonThreaded_h
 #define Libccnx_rta_Framework_NonThreaded_h
 
+#include <stdint.h>
+#include <stdbool.h>
 #include <sys/time.h>
 
+#include <parc/algol/parc_Event.h>
+#include <ccnx/transport/common/transport_MetaMessage.h>
+
 // ==============================
 // NON-THREADED API
 
@@ -105,6 +110,204 @@ int rtaFramework_NonThreadedStepCount(RtaFramework *framework, unsigned count);
  */
 int rtaFramework_NonThreadedStepTimed(RtaFramework *framework, struct timeval *duration);
 
+/**
+ * Replace the wall clock of a non-threaded framework with a virtual clock
+ *
+ * The millisecond timer that advances rtaFramework_GetTicks() is stopped.  From now on
+ * the clock only moves in rtaFramework_NonThreadedAdvance(), so timers on the framework's
+ * timer wheel (e.g. Vegas RTO and pacing, the FWD_SIMULATED link) fire on virtual time
+ * and a run does not depend on how fast the host is.  Together with FWD_SIMULATED this
+ * runs many seconds of flow control in a fraction of the time, and the same inputs
+ * always give the same result.
+ *
+ * Call it before creating protocol stacks.  It cannot be undone.  Do not use
+ * rtaFramework_NonThreadedStepTimed() afterwards, and note that
+ * rtaFramework_NonThreadedStep() blocks if the only pending work is a timer.
+ *
+ * @param [in] framework A framework that has not been started
+ *
+ * @return 0 Success
+ * @return -1 The framework is running in threaded mode
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaFramework *framework = rtaFramework_Create(commandQueue, commandNotifier);
+ *     rtaFramework_NonThreadedEnableVirtualTime(framework);
+ *     ... create a stack with FWD_SIMULATED and open a connection ...
+ *     rtaFramework_NonThreadedAdvance(framework, rtaFramework_UsecToTicks(10000000));
+ * }
+ * @endcode
+ */
+int rtaFramework_NonThreadedEnableVirtualTime(RtaFramework *framework);
+
+/**
+ * Advance the virtual clock by `count` ticks, running all the work due in each tick
+ *
+ * Work already pending is run first.  Then, for each tick, the clock is incremented,
+ * the expired timers run, and the event loop runs without blocking until messages
+ * written in that tick have moved through the stack.  Messages an application writes
+ * to a connection's socket between calls are picked up at the start of the next call.
+ *
+ * @param [in] framework A framework in virtual time
+ * @param [in] count The number of ticks to advance, may be 0 to only run pending work
+ *
+ * @return 0 Success
+ * @return -1 An error from the event scheduler
+ *
+ * Example:
+ * @code
+ * {
+ *     // one simulated second, a tick at a time so the caller can watch the stack
+ *     for (int i = 0; i < 1000; i++) {
+ *         rtaFramework_NonThreadedAdvance(framework, 1);
+ *     }
+ * }
+ * @endcode
+ */
+int rtaFramework_NonThreadedAdvance(RtaFramework *framework, uint64_t count);
+
+/**
+ * Run up to `passes` passes of the event loop without blocking
+ *
+ * This is how an inline transport (see rtaTransport_CreateInline()) runs the framework on
+ * the application's thread.  The clock first catches up with the time that went by since
+ * the last dispatch, running the timers that expired.  Each pass then runs the events that
+ * are ready and moves a message at least one component along the stack.  A framework that has not been stepped yet goes to the SETUP state, so
+ * `passes` may be 0 to only do that.
+ *
+ * @param [in] framework A framework that has not been started
+ * @param [in] passes The most passes of the event loop to run
+ *
+ * @return 0 Success
+ * @return -1 An error from the event scheduler
+ *
+ * Example:
+ * @code
+ * {
+ *     rtaFramework_NonThreadedDispatch(framework, 16);
+ * }
+ * @endcode
+ */
+int rtaFramework_NonThreadedDispatch(RtaFramework *framework, unsigned passes);
+
+/**
+ * Hand a message from the API straight to a connection's API connector
+ *
+ * Used by an inline transport instead of writing the pointer to the connection's socket.
+ * The API connector puts the message in the queue of the next component down, so it
+ * moves on the next dispatch.  The caller keeps its reference to the message.
+ *
+ * @param [in] framework A framework that has not been started
+ * @param [in] apiFd The api_fd (queueId) of an open connection
+ * @param [in] message The message to send down the stack
+ *
+ * @return true The message was accepted
+ * @return false errno is EWOULDBLOCK if the connection is blocked in the DOWN direction,
+ *               or EBADF if there is no open connection with that api_fd
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+bool rtaFramework_NonThreadedSend(RtaFramework *framework, int apiFd, CCNxMetaMessage *message);
+
+/**
+ * Unblock a connection in the UP direction after the application caught up
+ *
+ * Used by an inline transport when rtaTransport_Recv() takes the connection's RtaInlineQueue
+ * below its low water mark, as the write watermark of the socket pair does for a threaded
+ * connection.  Does nothing if the connection is not blocked or is closed.
+ *
+ * @param [in] framework A framework that has not been started
+ * @param [in] apiFd The api_fd (queueId) of the connection
+ *
+ * Example:
+ * @code
+ * {
+ *     bool full = rtaInlineQueue_IsFull(queue);
+ *     CCNxMetaMessage *message = rtaInlineQueue_Get(queue);
+ *     if (full && !rtaInlineQueue_IsFull(queue)) {
+ *         rtaFramework_NonThreadedUnblockUp(framework, apiFd);
+ *     }
+ * }
+ * @endcode
+ */
+void rtaFramework_NonThreadedUnblockUp(RtaFramework *framework, int apiFd);
+
+/**
+ * Told when a connector starts or stops watching a socket on the event scheduler
+ *
+ * `events` is what the connector waits for, PARCEventType_Read and or PARCEventType_Write.
+ * It is 0 when the connector stops watching `fd`, which it does before closing it.
+ */
+typedef void (RtaFrameworkDescriptorWatcher)(void *arg, int fd, PARCEventType events);
+
+/**
+ * Follow the sockets the connectors put on the event scheduler
+ *
+ * An inline transport uses this to put the forwarder sockets in its dispatch descriptor,
+ * so the application wakes up when the forwarder sends something.  Only one watcher may be
+ * set.  Call it before creating protocol stacks.
+ *
+ * @param [in] framework A framework that has not been started
+ * @param [in] watcher Called from rtaFramework_WatchDescriptor() and rtaFramework_UnwatchDescriptor()
+ * @param [in] arg Passed to the watcher
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaFramework_NonThreadedSetDescriptorWatcher(RtaFramework *framework, RtaFrameworkDescriptorWatcher *watcher, void *arg);
+
+/**
+ * The microseconds until a timer on the framework's timer wheel may be due
+ *
+ * After sleeping this long, rtaFramework_NonThreadedDispatch() runs the timers that
+ * expired.  It may be early (see rtaTimerWheel_NextExpiry()), but never late.
+ *
+ * @param [in] framework A framework that has not been started
+ *
+ * @return number Microseconds from now, 0 if a timer is due already
+ * @return UINT64_MAX No timer is pending, or the framework is in virtual time
+ *
+ * Example:
+ * @code
+ * {
+ *     uint64_t usec = rtaFramework_NonThreadedNextDeadline(framework);
+ *     int timeout = (usec == UINT64_MAX) ? -1 : (int) ((usec + 999) / 1000);
+ *     poll(fds, count, timeout);
+ *     rtaFramework_NonThreadedDispatch(framework, 16);
+ * }
+ * @endcode
+ */
+uint64_t rtaFramework_NonThreadedNextDeadline(RtaFramework *framework);
+
+/**
+ * Whether rtaFramework_NonThreadedDispatch() ran out of passes with work left
+ *
+ * The descriptors given to the RtaFrameworkDescriptorWatcher only cover what arrives from
+ * outside.  A message a component has queued for the next component does not make any
+ * of them ready, so a caller that polls must dispatch again while this is true.
+ *
+ * @param [in] framework A framework that has not been started
+ *
+ * @return true A message waits in the queues of a protocol stack
+ * @return false The framework waits for a descriptor or a timer
+ *
+ * Example:
+ * @code
+ * {
+ *     rtaFramework_NonThreadedDispatch(framework, 1);
+ *     int timeout = rtaFramework_NonThreadedHasPendingWork(framework) ? 0 : -1;
+ *     poll(fds, count, timeout);
+ * }
+ * @endcode
+ */
+bool rtaFramework_NonThreadedHasPendingWork(RtaFramework *framework);
+
 
 /**
  * After a protocol stack is created, you need to Teardown.  If you
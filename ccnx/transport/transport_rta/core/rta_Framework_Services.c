@@ -85,3 +85,35 @@ rtaFramework_UsecToTicks(unsigned usec)
 {
     return MSEC_TO_TICKS(usec / 1000);
 }
+
+RtaTimerWheel *
+rtaFramework_GetTimerWheel(RtaFramework *framework)
+{
+    assertNotNull(framework, "Parameter framework cannot be null");
+    return framework->timerWheel;
+}
+
+RtaTimer *
+rtaFramework_CreateTimer(RtaFramework *framework, RtaTimerCallback *callback, void *arg)
+{
+    assertNotNull(framework, "Parameter framework cannot be null");
+    return rtaTimer_Create(framework->timerWheel, callback, arg);
+}
+
+void
+rtaFramework_WatchDescriptor(RtaFramework *framework, int fd, PARCEventType events)
+{
+    assertNotNull(framework, "Parameter framework cannot be null");
+    if (framework->descriptorWatcher != NULL) {
+        framework->descriptorWatcher(framework->descriptorWatcherArg, fd, events);
+    }
+}
+
+void
+rtaFramework_UnwatchDescriptor(RtaFramework *framework, int fd)
+{
+    assertNotNull(framework, "Parameter framework cannot be null");
+    if (framework->descriptorWatcher != NULL) {
+        framework->descriptorWatcher(framework->descriptorWatcherArg, fd, 0);
+    }
+}
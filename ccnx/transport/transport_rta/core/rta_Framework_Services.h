@@ -65,7 +65,9 @@
 #define Libccnx_rta_Framework_Services_h
 
 #include "rta_Framework.h"
+#include "rta_TimerWheel.h"
 
+#include <parc/algol/parc_Event.h>
 #include <parc/algol/parc_EventScheduler.h>
 
 // ===================================
@@ -163,4 +165,87 @@ extern uint64_t rtaFramework_TicksToUsec(ticks tick);
  * @see <#references#>
  */
 extern ticks rtaFramework_UsecToTicks(unsigned usec);
+
+/**
+ * The timer wheel of the framework
+ *
+ * All component and connector timers should live on this wheel rather than
+ * creating their own PARCEventTimer.  The wheel is advanced once per tick.
+ *
+ * @param [in] framework An allocated framework
+ *
+ * @return non-null The timer wheel, owned by the framework
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ *
+ * @see rtaFramework_CreateTimer
+ */
+RtaTimerWheel *rtaFramework_GetTimerWheel(RtaFramework *framework);
+
+/**
+ * Create a timer on the framework's timer wheel
+ *
+ * The timer is idle until scheduled with rtaTimer_Schedule(), whose delay is
+ * in ticks.  The caller owns the timer and must call rtaTimer_Destroy().
+ *
+ * @param [in] framework An allocated framework
+ * @param [in] callback Called from the event loop when the timer expires
+ * @param [in] arg Passed to the callback
+ *
+ * @return non-null An allocated timer
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaTimer *timer = rtaFramework_CreateTimer(framework, _expiryCallback, state);
+ *     rtaTimer_Schedule(timer, rtaFramework_UsecToTicks(500000));
+ *     ...
+ *     rtaTimer_Destroy(&timer);
+ * }
+ * @endcode
+ */
+RtaTimer *rtaFramework_CreateTimer(RtaFramework *framework, RtaTimerCallback *callback, void *arg);
+
+/**
+ * Tell the framework a connector is waiting for events on a socket
+ *
+ * Connectors that put a socket on the event scheduler call this after creating its event,
+ * with the same events.  An inline transport then wakes the application while the socket
+ * is ready (see rtaTransport_GetDispatchFd()).  Otherwise it does nothing.
+ *
+ * The watch is level triggered, so call it again whenever the events change: stop asking
+ * for Read while the connector does not read, and only ask for Write while output waits.
+ *
+ * @param [in] framework An allocated framework
+ * @param [in] fd The socket
+ * @param [in] events The events the connector waits for, e.g. PARCEventType_Read
+ *
+ * Example:
+ * @code
+ * {
+ *     state->readEvent = parcEvent_Create(scheduler, state->fd, PARCEventType_Read | PARCEventType_Persist, _readCallback, conn);
+ *     rtaFramework_WatchDescriptor(framework, state->fd, PARCEventType_Read);
+ * }
+ * @endcode
+ */
+void rtaFramework_WatchDescriptor(RtaFramework *framework, int fd, PARCEventType events);
+
+/**
+ * Tell the framework a connector no longer waits on a socket.  Call it before closing the socket.
+ *
+ * @param [in] framework An allocated framework
+ * @param [in] fd A socket given to rtaFramework_WatchDescriptor()
+ *
+ * Example:
+ * @code
+ * {
+ *     rtaFramework_UnwatchDescriptor(framework, state->fd);
+ *     close(state->fd);
+ * }
+ * @endcode
+ */
+void rtaFramework_UnwatchDescriptor(RtaFramework *framework, int fd);
 #endif // Libccnx_rta_Framework_Services_h
@@ -56,10 +56,15 @@
  * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
  * @copyright (c) 2013-2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
  */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include <config.h>
 #include <stdio.h>
 #include <unistd.h>
 #include <pthread.h>
+#include <sched.h>
 
 #include <errno.h>
 
@@ -85,6 +90,56 @@
 // the thread function
 static void *_rtaFramework_Run(void *ctx);
 
+void
+rtaFramework_SetCpu(RtaFramework *framework, int cpu)
+{
+    assertNotNull(framework, "Parameter framework must be non-null");
+    assertTrue(cpu >= -1, "Parameter cpu must be -1 or a CPU number, got %d", cpu);
+    assertTrue(framework->status == FRAMEWORK_INIT, "Framework must be in the INIT state, got %d", framework->status);
+
+    memset(framework->threadConfig.cpus, 0, sizeof(framework->threadConfig.cpus));
+    if (cpu >= 0) {
+        rtaThreadConfig_AddCpu(&framework->threadConfig, cpu);
+    }
+}
+
+void
+rtaFramework_SetThreadConfig(RtaFramework *framework, const RtaThreadConfig *config)
+{
+    assertNotNull(framework, "Parameter framework must be non-null");
+    assertNotNull(config, "Parameter config must be non-null");
+    assertTrue(framework->status == FRAMEWORK_INIT, "Framework must be in the INIT state, got %d", framework->status);
+    framework->threadConfig = *config;
+}
+
+/*
+ * Applies framework->threadConfig to the calling thread.  A failure, e.g. SCHED_FIFO without
+ * privileges, is logged and the thread keeps running with whatever did apply.
+ *
+ * With a NUMA node, the timer wheel that rtaFramework_Create() allocated on the caller's node
+ * is re-created here.  It has no timers yet, they belong to stacks and connections, which are
+ * only created by commands this thread has not run.  The connection table allocates its
+ * index on the first connection, so that already comes from this thread.
+ */
+static void
+_rtaFramework_ApplyThreadConfig(RtaFramework *framework)
+{
+    const RtaThreadConfig *config = &framework->threadConfig;
+
+    int failure = rtaThreadConfig_Apply(config);
+    if (failure) {
+        rtaLogger_Log(framework->logger, RtaLoggerFacility_Framework, PARCLogLevel_Warning, __func__,
+                      "Could not fully apply thread config (cpus %u policy %s priority %d numa %d): %s",
+                      rtaThreadConfig_CpuCount(config), rtaThreadConfig_PolicyString(config->policy),
+                      config->priority, config->numaNode, strerror(failure));
+    }
+
+    if (config->numaNode >= 0) {
+        rtaTimerWheel_Destroy(&framework->timerWheel);
+        framework->timerWheel = rtaTimerWheel_Create(framework->base, framework->clock_ticks);
+    }
+}
+
 /**
  * Starts the worker thread.  Blocks until started
  *
@@ -144,6 +199,9 @@ _rtaFramework_Run(void *ctx)
 {
     RtaFramework *framework = (RtaFramework *) ctx;
 
+    // Place the thread before reporting RUNNING, so nothing the framework does runs elsewhere
+    _rtaFramework_ApplyThreadConfig(framework);
+
     // %%% LOCK
     rta_Framework_LockStatus(framework);
     if (framework->status != FRAMEWORK_STARTING) {
@@ -204,7 +262,8 @@ void
 rtaFramework_Shutdown(RtaFramework *framework)
 {
     RtaCommand *shutdown = rtaCommand_CreateShutdownFramework();
-    rtaCommand_Write(shutdown, framework->commandRingBuffer);
+    // wait as long as it takes for room, the shutdown cannot be dropped
+    rtaCommand_Write(shutdown, framework->commandQueue, NULL);
     parcNotifier_Notify(framework->commandNotifier);
     rtaCommand_Release(&shutdown);
 
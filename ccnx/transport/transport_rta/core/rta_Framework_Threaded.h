@@ -64,6 +64,8 @@
 #ifndef Libccnx_rta_Framework_Threaded_h
 #define Libccnx_rta_Framework_Threaded_h
 
+#include <ccnx/transport/transport_rta/core/rta_ThreadConfig.h>
+
 // =============================
 // THREADED
 
@@ -79,6 +81,60 @@
  */
 void rtaFramework_Start(RtaFramework *framework);
 
+/**
+ * Pin the worker thread to one CPU
+ *
+ * Must be called before rtaFramework_Start().  The thread pins itself when it starts, so
+ * everything the framework does runs on that CPU.  Running one framework per CPU keeps
+ * independent transports (see rtaTransport_CreateWithOptions()) from contending for a core.
+ * Pinning is only supported on Linux, elsewhere the value is stored and ignored.
+ * This replaces the CPU set of the thread config, see rtaFramework_SetThreadConfig().
+ *
+ * @param [in] framework A framework in the INIT state
+ * @param [in] cpu The CPU number, or -1 to not pin the thread
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaFramework *framework = rtaFramework_Create(commandQueue, commandNotifier);
+ *     rtaFramework_SetCpu(framework, 2);
+ *     rtaFramework_Start(framework);
+ * }
+ * @endcode
+ */
+void rtaFramework_SetCpu(RtaFramework *framework, int cpu);
+
+/**
+ * Set the CPUs, scheduling policy and NUMA node of the worker thread
+ *
+ * Must be called before rtaFramework_Start().  It replaces the defaults read from the
+ * RTA_FRAMEWORK_CPUS, RTA_FRAMEWORK_SCHED, RTA_FRAMEWORK_PRIORITY and RTA_FRAMEWORK_NUMA
+ * environment variables.  The thread applies the config to itself when it starts, before it
+ * runs any command, so the stacks, connections and messages it allocates come from the
+ * NUMA node.  What cannot be applied (e.g. SCHED_FIFO without privileges) is logged on
+ * the Framework facility and the thread runs anyway.
+ *
+ * @param [in] framework A framework in the INIT state
+ * @param [in] config The config to copy
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaThreadConfig config;
+ *     rtaThreadConfig_Init(&config);
+ *     rtaThreadConfig_ParseCpuList(&config, "4-5");
+ *     config.policy = RtaThreadPolicy_Fifo;
+ *     config.priority = 10;
+ *     config.numaNode = 1;
+ *
+ *     RtaFramework *framework = rtaFramework_Create(commandQueue, commandNotifier);
+ *     rtaFramework_SetThreadConfig(framework, &config);
+ *     rtaFramework_Start(framework);
+ * }
+ * @endcode
+ */
+void rtaFramework_SetThreadConfig(RtaFramework *framework, const RtaThreadConfig *config);
+
 /**
  * Stops the worker thread by sending a CommandShutdown.
  * Blocks until shutdown complete.
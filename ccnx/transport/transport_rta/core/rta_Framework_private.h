@@ -73,6 +73,9 @@
 #include "rta_Framework_Services.h"
 
 #include "rta_ConnectionTable.h"
+#include "rta_TimerWheel.h"
+#include "rta_TraceRing.h"
+#include "rta_ThreadConfig.h"
 
 #include <parc/algol/parc_EventScheduler.h>
 #include <parc/algol/parc_Event.h>
@@ -97,7 +100,7 @@ typedef struct framework_protocol_holder {
 
 
 struct rta_framework {
-    PARCRingBuffer1x1           *commandRingBuffer;
+    RtaCommandQueue             *commandQueue;
     PARCNotifier                *commandNotifier;
     PARCEvent                   *commandEvent;
 
@@ -112,15 +115,25 @@ struct rta_framework {
     PARCEvent               *udp_event;
     PARCEventTimer          *transmit_statistics_event;
     PARCEventSignal         *signal_pipe;
+    PARCEventSignal         *signal_usr2;
 
     struct timeval starttime;
     ticks clock_ticks;                       // at WTHZ
 
+    // Component and connector timers, advanced by tick_event
+    RtaTimerWheel *timerWheel;
+
+    // clock_ticks only moves in rtaFramework_NonThreadedAdvance(), tick_event is stopped
+    bool virtualTime;
+
     // used by seed48 and nrand48
     unsigned short seed[3];
 
     pthread_t thread;
 
+    // CPUs, scheduling and NUMA node of the framework thread, applied by the thread when it starts
+    RtaThreadConfig threadConfig;
+
     unsigned connid_next;
 
     // operations that modify global state need
@@ -139,13 +152,49 @@ struct rta_framework {
     // A list of all our in-use protocol stacks
     TAILQ_HEAD(, framework_protocol_holder)    protocols_head;
 
+    // holdersByStackId[stack_id] is the holder of that stack, or NULL.  The Transport
+    // numbers its stacks from 1, so the index stays short.
+    FrameworkProtocolHolder **holdersByStackId;
+    size_t holdersByStackIdLength;
+
     RtaConnectionTable *connectionTable;
 
     RtaLogger *logger;
+
+    // Flight recorder, dumped to traceFilename on SIGUSR2 if RTA_TRACE_FILE is set
+    RtaTraceRing *traceRing;
+    char *traceFilename;
+
+    // Set by RTA_CONNECTION_LATENCY, see rtaFramework_GetConnectionLatency()
+    bool connectionLatency;
+
+    // Told about connector sockets, see rtaFramework_NonThreadedSetDescriptorWatcher()
+    RtaFrameworkDescriptorWatcher *descriptorWatcher;
+    void *descriptorWatcherArg;
 };
 
 int rtaFramework_CloseConnection(RtaFramework *framework, RtaConnection *connection);
 
+/**
+ * A structured snapshot of the statistics of every protocol stack and connection
+ *
+ * The object has "timeval" (seconds since the epoch, with microseconds) and "stacks",
+ * an array with one rtaProtocolStack_GetStatisticsSnapshot() object per stack.  Each of
+ * those has a "connections" array of rtaProtocolStack_GetConnectionStatisticsSnapshot().
+ *
+ * Must be called from the Transport thread.
+ *
+ * @param [in] framework An allocated framework
+ *
+ * @return non-null A PARCJSON object the caller must release
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+PARCJSON *rtaFramework_GetStatisticsSnapshot(RtaFramework *framework);
+
 /**
  * Lock the frameworks state machine status
  *
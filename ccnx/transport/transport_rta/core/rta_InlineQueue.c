@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <LongBow/runtime.h>
+#include <parc/algol/parc_Memory.h>
+
+#include <ccnx/transport/transport_rta/core/rta_InlineQueue.h>
+
+#define RTA_INLINE_QUEUE_INITIAL_CAPACITY 16
+
+struct rta_inline_queue {
+    // a circular array, count messages starting at head
+    CCNxMetaMessage **messages;
+    size_t capacity;
+    size_t head;
+    size_t count;
+
+    size_t highWater;
+    size_t lowWater;
+    bool full;
+
+    RtaInlineQueueSignal *signal;
+    void *signalArg;
+
+    unsigned refcount;
+};
+
+RtaInlineQueue *
+rtaInlineQueue_Create(size_t highWater, size_t lowWater, RtaInlineQueueSignal *signal, void *signalArg)
+{
+    assertTrue(lowWater > 0, "Parameter lowWater must be positive");
+    assertTrue(lowWater < highWater, "Parameter lowWater %zu must be less than highWater %zu", lowWater, highWater);
+
+    RtaInlineQueue *queue = parcMemory_AllocateAndClear(sizeof(RtaInlineQueue));
+    assertNotNull(queue, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(RtaInlineQueue));
+
+    queue->capacity = RTA_INLINE_QUEUE_INITIAL_CAPACITY;
+    queue->messages = parcMemory_AllocateAndClear(queue->capacity * sizeof(CCNxMetaMessage *));
+    assertNotNull(queue->messages, "parcMemory_AllocateAndClear(%zu) returned NULL", queue->capacity * sizeof(CCNxMetaMessage *));
+
+    queue->highWater = highWater;
+    queue->lowWater = lowWater;
+    queue->signal = signal;
+    queue->signalArg = signalArg;
+    queue->refcount = 1;
+    return queue;
+}
+
+RtaInlineQueue *
+rtaInlineQueue_Acquire(const RtaInlineQueue *queue)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+    RtaInlineQueue *result = (RtaInlineQueue *) queue;
+    result->refcount++;
+    return result;
+}
+
+void
+rtaInlineQueue_Release(RtaInlineQueue **queuePtr)
+{
+    assertNotNull(queuePtr, "Parameter queuePtr must be non-null");
+    RtaInlineQueue *queue = *queuePtr;
+    assertNotNull(queue, "Parameter queuePtr must dereference to non-null");
+
+    if (--queue->refcount == 0) {
+        rtaInlineQueue_Drain(queue);
+        parcMemory_Deallocate((void **) &queue->messages);
+        parcMemory_Deallocate((void **) &queue);
+    }
+    *queuePtr = NULL;
+}
+
+/*
+ * Doubles the array, moving the messages to the start of the new one
+ */
+static void
+_rtaInlineQueue_Grow(RtaInlineQueue *queue)
+{
+    size_t capacity = queue->capacity * 2;
+    CCNxMetaMessage **messages = parcMemory_Allocate(capacity * sizeof(CCNxMetaMessage *));
+    assertNotNull(messages, "parcMemory_Allocate(%zu) returned NULL", capacity * sizeof(CCNxMetaMessage *));
+
+    for (size_t i = 0; i < queue->count; i++) {
+        messages[i] = queue->messages[(queue->head + i) % queue->capacity];
+    }
+
+    parcMemory_Deallocate((void **) &queue->messages);
+    queue->messages = messages;
+    queue->capacity = capacity;
+    queue->head = 0;
+}
+
+void
+rtaInlineQueue_Put(RtaInlineQueue *queue, CCNxMetaMessage *message)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+    assertNotNull(message, "Parameter message must be non-null");
+
+    if (queue->count == queue->capacity) {
+        _rtaInlineQueue_Grow(queue);
+    }
+
+    queue->messages[(queue->head + queue->count) % queue->capacity] = message;
+    queue->count++;
+    if (queue->count >= queue->highWater) {
+        queue->full = true;
+    }
+
+    if (queue->signal != NULL) {
+        queue->signal(queue->signalArg);
+    }
+}
+
+CCNxMetaMessage *
+rtaInlineQueue_Get(RtaInlineQueue *queue)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+
+    if (queue->count == 0) {
+        return NULL;
+    }
+
+    CCNxMetaMessage *message = queue->messages[queue->head];
+    queue->head = (queue->head + 1) % queue->capacity;
+    queue->count--;
+    if (queue->count < queue->lowWater) {
+        queue->full = false;
+    }
+    return message;
+}
+
+size_t
+rtaInlineQueue_Count(const RtaInlineQueue *queue)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+    return queue->count;
+}
+
+bool
+rtaInlineQueue_IsFull(const RtaInlineQueue *queue)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+    return queue->full;
+}
+
+size_t
+rtaInlineQueue_Drain(RtaInlineQueue *queue)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+
+    size_t drained = 0;
+    CCNxMetaMessage *message;
+    while ((message = rtaInlineQueue_Get(queue)) != NULL) {
+        ccnxMetaMessage_Release(&message);
+        drained++;
+    }
+    return drained;
+}
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file rta_InlineQueue.h
+ * @brief The queue of messages from an inline Transport up to the application
+ *
+ * In inline mode (see rtaTransport_CreateInline()) the framework runs on the application's
+ * thread, so the API connector does not need a socket pair to cross threads.  Instead it
+ * puts each CCNxMetaMessage for the application on the connection's RtaInlineQueue, and
+ * rtaTransport_Recv() takes it off.
+ *
+ * The queue has a high and a low water mark in messages, which stand in for the buffers of
+ * the socket pair.  When a put brings it to the high water mark the queue is full, and the
+ * API connector blocks the connection in the UP direction.  It stays full until gets bring it
+ * below the low water mark, then rtaTransport_Recv() unblocks the connection.  A put to a full
+ * queue still succeeds, as control messages pass a blocked connection, so the array grows
+ * past the high water mark if it must.
+ *
+ * Each put calls the signal function given to rtaInlineQueue_Create(), which the Transport
+ * uses to make its dispatch descriptor readable.
+ *
+ * The queue is reference counted, so the Transport and the connection in the framework
+ * can each hold it.  It is not thread safe; everything happens on the application's thread.
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef Libccnx_rta_InlineQueue_h
+#define Libccnx_rta_InlineQueue_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <ccnx/transport/common/transport_MetaMessage.h>
+
+struct rta_inline_queue;
+typedef struct rta_inline_queue RtaInlineQueue;
+
+/**
+ * Called after each message is put on a queue
+ */
+typedef void (RtaInlineQueueSignal)(void *arg);
+
+/**
+ * Create an empty queue with a reference count of 1
+ *
+ * @param [in] highWater The queue is full once it holds this many messages
+ * @param [in] lowWater A full queue stops being full below this many messages, from 1 to `highWater` - 1
+ * @param [in] signal Called after each put, may be NULL
+ * @param [in] signalArg Passed to `signal`
+ *
+ * @return non-null An allocated queue
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaInlineQueue *queue = rtaInlineQueue_Create(128, 50, NULL, NULL);
+ *     rtaInlineQueue_Release(&queue);
+ * }
+ * @endcode
+ */
+RtaInlineQueue *rtaInlineQueue_Create(size_t highWater, size_t lowWater, RtaInlineQueueSignal *signal, void *signalArg);
+
+/**
+ * Increase the number of references to the queue
+ *
+ * @param [in] queue The queue
+ *
+ * @return non-null A reference to `queue`
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+RtaInlineQueue *rtaInlineQueue_Acquire(const RtaInlineQueue *queue);
+
+/**
+ * Release a reference to the queue.  The last release releases the messages still on it.
+ *
+ * @param [in,out] queuePtr The reference to release, will be NULL'd
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaInlineQueue_Release(RtaInlineQueue **queuePtr);
+
+/**
+ * Append a message to the queue, taking ownership of the caller's reference
+ *
+ * @param [in] queue The queue
+ * @param [in] message The message for the application
+ *
+ * Example:
+ * @code
+ * {
+ *     rtaInlineQueue_Put(queue, ccnxMetaMessage_Acquire(message));
+ * }
+ * @endcode
+ */
+void rtaInlineQueue_Put(RtaInlineQueue *queue, CCNxMetaMessage *message);
+
+/**
+ * Remove the oldest message from the queue
+ *
+ * @param [in] queue The queue
+ *
+ * @return non-null The message, the caller owns the reference
+ * @return null The queue is empty
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxMetaMessage *message = rtaInlineQueue_Get(queue);
+ *     if (message != NULL) {
+ *         ccnxMetaMessage_Release(&message);
+ *     }
+ * }
+ * @endcode
+ */
+CCNxMetaMessage *rtaInlineQueue_Get(RtaInlineQueue *queue);
+
+/**
+ * The number of messages on the queue
+ *
+ * @param [in] queue The queue
+ *
+ * @return number The messages waiting for the application
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+size_t rtaInlineQueue_Count(const RtaInlineQueue *queue);
+
+/**
+ * Whether the queue is full
+ *
+ * The queue becomes full when a put brings it to the high water mark, and stops being full
+ * when a get takes it below the low water mark.
+ *
+ * @param [in] queue The queue
+ *
+ * @return true The application is not keeping up, block the connection in the UP direction
+ * @return false There is room on the queue
+ *
+ * Example:
+ * @code
+ * {
+ *     rtaInlineQueue_Put(queue, message);
+ *     if (rtaInlineQueue_IsFull(queue) && !rtaConnection_BlockedUp(connection)) {
+ *         rtaConnection_SetBlockedUp(connection);
+ *     }
+ * }
+ * @endcode
+ */
+bool rtaInlineQueue_IsFull(const RtaInlineQueue *queue);
+
+/**
+ * Release every message on the queue
+ *
+ * The framework calls this when it closes the connection, as it drains the API side
+ * of the socket pair of a threaded connection.
+ *
+ * @param [in] queue The queue
+ *
+ * @return number The messages released
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+size_t rtaInlineQueue_Drain(RtaInlineQueue *queue);
+#endif // Libccnx_rta_InlineQueue_h
@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * Bucket index for a value v:
+ *
+ *   v < 32:   index = v
+ *   v >= 32:  msb = floor(log2(v)), index = 32 + (msb - 5) * 16 + ((v >> (msb - 4)) - 16)
+ *
+ * Bucket `index` covers [_lowestEquivalent(index), _lowestEquivalent(index + 1)).
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+
+#include <ccnx/transport/transport_rta/core/rta_LatencyHistogram.h>
+
+#define RTA_HISTOGRAM_SUB_BITS  4
+#define RTA_HISTOGRAM_SUB_COUNT (1 << RTA_HISTOGRAM_SUB_BITS)
+
+// Values below this have their own bucket
+#define RTA_HISTOGRAM_LINEAR    (2 * RTA_HISTOGRAM_SUB_COUNT)
+
+// Largest bucketed power of two, larger values go in the last bucket
+#define RTA_HISTOGRAM_MAX_MSB   35
+
+#define RTA_HISTOGRAM_BUCKETS   (RTA_HISTOGRAM_LINEAR + (RTA_HISTOGRAM_MAX_MSB - RTA_HISTOGRAM_SUB_BITS) * RTA_HISTOGRAM_SUB_COUNT)
+
+struct rta_latency_histogram {
+    uint64_t count;
+    uint64_t sum;
+    uint64_t min;
+    uint64_t max;
+    uint32_t buckets[RTA_HISTOGRAM_BUCKETS];
+};
+
+static unsigned
+_msb(uint64_t value)
+{
+    return 63 - __builtin_clzll(value);
+}
+
+static unsigned
+_bucketIndex(uint64_t value)
+{
+    if (value < RTA_HISTOGRAM_LINEAR) {
+        return (unsigned) value;
+    }
+
+    unsigned msb = _msb(value);
+    if (msb > RTA_HISTOGRAM_MAX_MSB) {
+        return RTA_HISTOGRAM_BUCKETS - 1;
+    }
+
+    unsigned shift = msb - RTA_HISTOGRAM_SUB_BITS;
+    unsigned sub = (unsigned) (value >> shift) - RTA_HISTOGRAM_SUB_COUNT;
+    return RTA_HISTOGRAM_LINEAR + (msb - RTA_HISTOGRAM_SUB_BITS - 1) * RTA_HISTOGRAM_SUB_COUNT + sub;
+}
+
+static uint64_t
+_lowestEquivalent(unsigned index)
+{
+    if (index < RTA_HISTOGRAM_LINEAR) {
+        return index;
+    }
+
+    unsigned octave = (index - RTA_HISTOGRAM_LINEAR) / RTA_HISTOGRAM_SUB_COUNT;
+    unsigned sub = (index - RTA_HISTOGRAM_LINEAR) % RTA_HISTOGRAM_SUB_COUNT;
+    unsigned shift = octave + 1;
+    return ((uint64_t) (RTA_HISTOGRAM_SUB_COUNT + sub)) << shift;
+}
+
+RtaLatencyHistogram *
+rtaLatencyHistogram_Create(void)
+{
+    RtaLatencyHistogram *histogram = parcMemory_AllocateAndClear(sizeof(RtaLatencyHistogram));
+    assertNotNull(histogram, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(RtaLatencyHistogram));
+    return histogram;
+}
+
+void
+rtaLatencyHistogram_Destroy(RtaLatencyHistogram **histogramPtr)
+{
+    assertNotNull(histogramPtr, "Parameter histogramPtr must be non-null");
+    assertNotNull(*histogramPtr, "Parameter histogramPtr must dereference to non-null");
+    parcMemory_Deallocate((void **) histogramPtr);
+}
+
+void
+rtaLatencyHistogram_Record(RtaLatencyHistogram *histogram, uint64_t nanos)
+{
+    if (histogram->count == 0 || nanos < histogram->min) {
+        histogram->min = nanos;
+    }
+    if (nanos > histogram->max) {
+        histogram->max = nanos;
+    }
+    histogram->count++;
+    histogram->sum += nanos;
+    histogram->buckets[_bucketIndex(nanos)]++;
+}
+
+void
+rtaLatencyHistogram_Add(RtaLatencyHistogram *histogram, const RtaLatencyHistogram *other)
+{
+    assertNotNull(histogram, "Parameter histogram must be non-null");
+    assertNotNull(other, "Parameter other must be non-null");
+
+    if (other->count == 0) {
+        return;
+    }
+
+    if (histogram->count == 0 || other->min < histogram->min) {
+        histogram->min = other->min;
+    }
+    if (other->max > histogram->max) {
+        histogram->max = other->max;
+    }
+    histogram->count += other->count;
+    histogram->sum += other->sum;
+    for (int i = 0; i < RTA_HISTOGRAM_BUCKETS; i++) {
+        histogram->buckets[i] += other->buckets[i];
+    }
+}
+
+void
+rtaLatencyHistogram_Reset(RtaLatencyHistogram *histogram)
+{
+    assertNotNull(histogram, "Parameter histogram must be non-null");
+    memset(histogram, 0, sizeof(RtaLatencyHistogram));
+}
+
+uint64_t
+rtaLatencyHistogram_GetCount(const RtaLatencyHistogram *histogram)
+{
+    assertNotNull(histogram, "Parameter histogram must be non-null");
+    return histogram->count;
+}
+
+uint64_t
+rtaLatencyHistogram_GetMin(const RtaLatencyHistogram *histogram)
+{
+    assertNotNull(histogram, "Parameter histogram must be non-null");
+    return histogram->min;
+}
+
+uint64_t
+rtaLatencyHistogram_GetMax(const RtaLatencyHistogram *histogram)
+{
+    assertNotNull(histogram, "Parameter histogram must be non-null");
+    return histogram->max;
+}
+
+uint64_t
+rtaLatencyHistogram_GetMean(const RtaLatencyHistogram *histogram)
+{
+    assertNotNull(histogram, "Parameter histogram must be non-null");
+    if (histogram->count == 0) {
+        return 0;
+    }
+    return histogram->sum / histogram->count;
+}
+
+uint64_t
+rtaLatencyHistogram_GetValueAtPercentile(const RtaLatencyHistogram *histogram, double percentile)
+{
+    assertNotNull(histogram, "Parameter histogram must be non-null");
+    assertTrue(percentile >= 0.0 && percentile <= 100.0, "Percentile must be in [0, 100], got %f", percentile);
+
+    if (histogram->count == 0) {
+        return 0;
+    }
+
+    // The rank of the sample we want, 1-based, at least 1
+    uint64_t rank = (uint64_t) (percentile / 100.0 * (double) histogram->count + 0.5);
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    uint64_t seen = 0;
+    for (unsigned i = 0; i < RTA_HISTOGRAM_BUCKETS; i++) {
+        seen += histogram->buckets[i];
+        if (seen >= rank) {
+            uint64_t upper = (i + 1 < RTA_HISTOGRAM_BUCKETS) ? _lowestEquivalent(i + 1) - 1 : histogram->max;
+            return upper < histogram->max ? upper : histogram->max;
+        }
+    }
+
+    return histogram->max;
+}
+
+void
+rtaLatencyHistogram_Display(const RtaLatencyHistogram *histogram, FILE *file)
+{
+    assertNotNull(histogram, "Parameter histogram must be non-null");
+    fprintf(file, "{ \"count\" : %" PRIu64 ", \"min\" : %" PRIu64 ", \"mean\" : %" PRIu64
+            ", \"p50\" : %" PRIu64 ", \"p90\" : %" PRIu64 ", \"p99\" : %" PRIu64 ", \"p999\" : %" PRIu64 ", \"max\" : %" PRIu64 " }",
+            histogram->count,
+            histogram->min,
+            rtaLatencyHistogram_GetMean(histogram),
+            rtaLatencyHistogram_GetValueAtPercentile(histogram, 50.0),
+            rtaLatencyHistogram_GetValueAtPercentile(histogram, 90.0),
+            rtaLatencyHistogram_GetValueAtPercentile(histogram, 99.0),
+            rtaLatencyHistogram_GetValueAtPercentile(histogram, 99.9),
+            histogram->max);
+}
+
+PARCJSON *
+rtaLatencyHistogram_ToJSON(const RtaLatencyHistogram *histogram)
+{
+    assertNotNull(histogram, "Parameter histogram must be non-null");
+
+    PARCJSON *json = parcJSON_Create();
+    parcJSON_AddInteger(json, "count", (int64_t) histogram->count);
+    parcJSON_AddInteger(json, "min", (int64_t) histogram->min);
+    parcJSON_AddInteger(json, "mean", (int64_t) rtaLatencyHistogram_GetMean(histogram));
+    parcJSON_AddInteger(json, "p50", (int64_t) rtaLatencyHistogram_GetValueAtPercentile(histogram, 50.0));
+    parcJSON_AddInteger(json, "p90", (int64_t) rtaLatencyHistogram_GetValueAtPercentile(histogram, 90.0));
+    parcJSON_AddInteger(json, "p99", (int64_t) rtaLatencyHistogram_GetValueAtPercentile(histogram, 99.0));
+    parcJSON_AddInteger(json, "p999", (int64_t) rtaLatencyHistogram_GetValueAtPercentile(histogram, 99.9));
+    parcJSON_AddInteger(json, "max", (int64_t) histogram->max);
+    return json;
+}
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file rta_LatencyHistogram.h
+ * @brief A fixed-size log-linear histogram of latencies in nanoseconds.
+ *
+ * The layout is the one used by HdrHistogram.  Values below 32 have their own bucket.
+ * Above that, each power of two is split into 16 linear sub-buckets, so every recorded
+ * value is within 1/16 (6.25%) of its true value.  Values of 2^36 nsec (about 68 seconds)
+ * or more go in the last bucket.  Recording is a count-leading-zeros, a shift, and an
+ * increment, with no allocation.
+ *
+ * The framework keeps one histogram per component, direction, and stage (queue wait
+ * or processing) in each RtaComponentStats.  See rtaComponentStats_GetLatency().
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef Libccnx_rta_LatencyHistogram_h
+#define Libccnx_rta_LatencyHistogram_h
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <parc/algol/parc_JSON.h>
+
+struct rta_latency_histogram;
+typedef struct rta_latency_histogram RtaLatencyHistogram;
+
+/**
+ * Create an empty histogram
+ *
+ * @return non-null An allocated histogram
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaLatencyHistogram *histogram = rtaLatencyHistogram_Create();
+ *     rtaLatencyHistogram_Record(histogram, 1500);
+ *     rtaLatencyHistogram_Destroy(&histogram);
+ * }
+ * @endcode
+ */
+RtaLatencyHistogram *rtaLatencyHistogram_Create(void);
+
+/**
+ * Destroy the histogram
+ *
+ * @param [in,out] histogramPtr The histogram to destroy, will be NULL'd
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaLatencyHistogram_Destroy(RtaLatencyHistogram **histogramPtr);
+
+/**
+ * Add one sample
+ *
+ * @param [in] histogram The histogram
+ * @param [in] nanos The latency in nanoseconds
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaLatencyHistogram_Record(RtaLatencyHistogram *histogram, uint64_t nanos);
+
+/**
+ * Add every sample of `other` to `histogram`
+ *
+ * @param [in] histogram The histogram to add to
+ * @param [in] other The histogram to add from, unchanged
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaLatencyHistogram_Add(RtaLatencyHistogram *histogram, const RtaLatencyHistogram *other);
+
+/**
+ * Remove all samples
+ *
+ * @param [in] histogram The histogram
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaLatencyHistogram_Reset(RtaLatencyHistogram *histogram);
+
+/**
+ * The number of samples recorded
+ *
+ * @param [in] histogram The histogram
+ *
+ * @return The number of samples
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+uint64_t rtaLatencyHistogram_GetCount(const RtaLatencyHistogram *histogram);
+
+/**
+ * The smallest and largest samples, exact (not bucketed)
+ *
+ * @param [in] histogram The histogram
+ *
+ * @return The value in nanoseconds, 0 if there are no samples
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+uint64_t rtaLatencyHistogram_GetMin(const RtaLatencyHistogram *histogram);
+uint64_t rtaLatencyHistogram_GetMax(const RtaLatencyHistogram *histogram);
+
+/**
+ * The mean of the samples, exact (not bucketed)
+ *
+ * @param [in] histogram The histogram
+ *
+ * @return The mean in nanoseconds, 0 if there are no samples
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+uint64_t rtaLatencyHistogram_GetMean(const RtaLatencyHistogram *histogram);
+
+/**
+ * The value at or below which `percentile` percent of the samples fall
+ *
+ * The result is the upper edge of the bucket holding that sample, capped at the
+ * maximum sample, so it is never below the true percentile.
+ *
+ * @param [in] histogram The histogram
+ * @param [in] percentile From 0.0 to 100.0
+ *
+ * @return The value in nanoseconds, 0 if there are no samples
+ *
+ * Example:
+ * @code
+ * {
+ *     uint64_t p99 = rtaLatencyHistogram_GetValueAtPercentile(histogram, 99.0);
+ * }
+ * @endcode
+ */
+uint64_t rtaLatencyHistogram_GetValueAtPercentile(const RtaLatencyHistogram *histogram, double percentile);
+
+/**
+ * Write a one-line JSON summary: count, min, mean, p50, p90, p99, p99.9, max
+ *
+ * @param [in] histogram The histogram
+ * @param [in] file The output
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaLatencyHistogram_Display(const RtaLatencyHistogram *histogram, FILE *file);
+
+/**
+ * The same summary as rtaLatencyHistogram_Display(), as a JSON object
+ *
+ * The keys are "count", "min", "mean", "p50", "p90", "p99", "p999", and "max", all in nanoseconds.
+ *
+ * @param [in] histogram The histogram
+ *
+ * @return non-null A PARCJSON object the caller must release
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCJSON *json = rtaLatencyHistogram_ToJSON(histogram);
+ *     char *string = parcJSON_ToCompactString(json);
+ *     parcMemory_Deallocate((void **) &string);
+ *     parcJSON_Release(&json);
+ * }
+ * @endcode
+ */
+PARCJSON *rtaLatencyHistogram_ToJSON(const RtaLatencyHistogram *histogram);
+#endif // Libccnx_rta_LatencyHistogram_h
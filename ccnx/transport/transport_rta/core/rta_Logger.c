@@ -63,6 +63,9 @@
 #include <stdio.h>
 #include <unistd.h>
 #include <errno.h>
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
 
 #include <LongBow/runtime.h>
 
@@ -72,11 +75,66 @@
 #include <parc/logging/parc_Log.h>
 #include <ccnx/transport/transport_rta/core/rta_Logger.h>
 
+// Longer messages are truncated in asynchronous mode, sized so a record is 256 bytes
+#define RTA_LOGGER_ASYNC_TEXT 232
+
+/*
+ * One queued log message.  The sequence number is the bounded MPMC queue protocol:
+ * a slot is free for the producer claiming position p when sequence == p, and holds
+ * a message for the consumer at position p when sequence == p + 1.
+ */
+typedef struct rta_logger_record {
+    uint64_t sequence;
+    uint64_t logtime;
+    RtaLoggerFacility facility;
+    PARCLogLevel level;
+    char text[RTA_LOGGER_ASYNC_TEXT];
+} _RtaLoggerRecord;
+
+typedef struct rta_logger_async {
+    _RtaLoggerRecord *records;
+    uint64_t mask;
+
+    uint64_t head;          // next position a producer claims
+    uint64_t tail;          // next position the writer thread reads
+
+    bool running;
+    pthread_t thread;
+
+    // The writer sets parked before it waits on work_cv with an empty queue.  The producer
+    // that clears it signals, so only the empty to non-empty transition costs a wakeup.
+    bool parked;
+
+    // Threads in rtaLogger_Flush() waiting on drained_cv
+    unsigned flushWaiters;
+
+    pthread_mutex_t lock;
+    pthread_cond_t work_cv;
+    pthread_cond_t drained_cv;
+} _RtaLoggerAsync;
+
+/*
+ * A fixed one second window.  The races between threads at a window boundary can let a
+ * few extra messages through, which is fine for a rate limit.
+ */
+typedef struct rta_logger_rate {
+    unsigned limit;         // messages per second, 0 is unlimited
+    uint64_t window;        // the monotonic second of the current window
+    unsigned count;         // messages in the current window
+} _RtaLoggerRate;
+
 struct rta_logger {
     PARCClock *clock;
 
     PARCLogReporter *reporter;
     PARCLog *loggerArray[RtaLoggerFacility_END];
+
+    // NULL when logging synchronously
+    _RtaLoggerAsync *async;
+
+    _RtaLoggerRate rate[RtaLoggerFacility_END];
+    uint64_t dropped[RtaLoggerFacility_END];
+    uint64_t rateLimited[RtaLoggerFacility_END];
 };
 
 static const struct facility_to_string {
@@ -133,6 +191,9 @@ static void
 _destroyer(RtaLogger **loggerPtr)
 {
     RtaLogger *logger = *loggerPtr;
+    if (logger->async != NULL) {
+        rtaLogger_StopAsync(logger);
+    }
     _releaseLoggers(logger);
     parcClock_Release(&(*loggerPtr)->clock);
 }
@@ -163,6 +224,13 @@ rtaLogger_SetReporter(RtaLogger *logger, PARCLogReporter *reporter)
 {
     assertNotNull(logger, "Parameter logger must be non-null");
 
+    // the writer thread uses the loggers, so stop it while they change
+    size_t asyncCapacity = 0;
+    if (logger->async != NULL) {
+        asyncCapacity = (size_t) logger->async->mask + 1;
+        rtaLogger_StopAsync(logger);
+    }
+
     // save the log level state
     PARCLogLevel savedLevels[RtaLoggerFacility_END];
     for (int i = 0; i < RtaLoggerFacility_END; i++) {
@@ -177,6 +245,10 @@ rtaLogger_SetReporter(RtaLogger *logger, PARCLogReporter *reporter)
     for (int i = 0; i < RtaLoggerFacility_END; i++) {
         parcLog_SetLevel(logger->loggerArray[i], savedLevels[i]);
     }
+
+    if (asyncCapacity > 0) {
+        rtaLogger_StartAsync(logger, asyncCapacity);
+    }
 }
 
 void
@@ -210,22 +282,288 @@ rtaLogger_IsLoggable(const RtaLogger *logger, RtaLoggerFacility facility, PARCLo
     return parcLog_IsLoggable(log, level);
 }
 
+static bool
+_rtaLogger_RateAllows(RtaLogger *logger, RtaLoggerFacility facility)
+{
+    _RtaLoggerRate *rate = &logger->rate[facility];
+    unsigned limit = __atomic_load_n(&rate->limit, __ATOMIC_RELAXED);
+    if (limit == 0) {
+        return true;
+    }
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    uint64_t second = (uint64_t) now.tv_sec;
+
+    uint64_t window = __atomic_load_n(&rate->window, __ATOMIC_RELAXED);
+    if (window != second) {
+        if (__atomic_compare_exchange_n(&rate->window, &window, second, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            __atomic_store_n(&rate->count, 0, __ATOMIC_RELAXED);
+        }
+    }
+
+    return __atomic_add_fetch(&rate->count, 1, __ATOMIC_RELAXED) <= limit;
+}
+
+/*
+ * Claim a slot and format the message into it.  Returns false if the queue is full.
+ */
+static bool
+_rtaLoggerAsync_Put(_RtaLoggerAsync *async, RtaLoggerFacility facility, PARCLogLevel level, uint64_t logtime, const char *format, va_list va)
+{
+    _RtaLoggerRecord *record;
+    uint64_t position = __atomic_load_n(&async->head, __ATOMIC_RELAXED);
+    for (;;) {
+        record = &async->records[position & async->mask];
+        uint64_t sequence = __atomic_load_n(&record->sequence, __ATOMIC_ACQUIRE);
+        int64_t difference = (int64_t) (sequence - position);
+        if (difference == 0) {
+            if (__atomic_compare_exchange_n(&async->head, &position, position + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (difference < 0) {
+            return false;
+        } else {
+            position = __atomic_load_n(&async->head, __ATOMIC_RELAXED);
+        }
+    }
+
+    record->logtime = logtime;
+    record->facility = facility;
+    record->level = level;
+    vsnprintf(record->text, RTA_LOGGER_ASYNC_TEXT, format, va);
+
+    __atomic_store_n(&record->sequence, position + 1, __ATOMIC_RELEASE);
+
+    // Pairs with the fence in _rtaLoggerAsync_Park: either the writer sees this message
+    // before it waits, or we see it parked and wake it
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&async->parked, __ATOMIC_RELAXED) && __atomic_exchange_n(&async->parked, false, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&async->lock);
+        pthread_cond_signal(&async->work_cv);
+        pthread_mutex_unlock(&async->lock);
+    }
+    return true;
+}
+
+/*
+ * Report every queued message.  Only the writer thread (or the thread that stopped it)
+ * calls this.  Returns the number of messages reported.
+ */
+static size_t
+_rtaLoggerAsync_Drain(RtaLogger *logger)
+{
+    _RtaLoggerAsync *async = logger->async;
+    size_t count = 0;
+    for (;;) {
+        uint64_t position = async->tail;
+        _RtaLoggerRecord *record = &async->records[position & async->mask];
+        if (__atomic_load_n(&record->sequence, __ATOMIC_ACQUIRE) != position + 1) {
+            return count;
+        }
+
+        parcLog_Message(logger->loggerArray[record->facility], record->level, record->logtime, "%s", record->text);
+
+        __atomic_store_n(&record->sequence, position + async->mask + 1, __ATOMIC_RELEASE);
+        __atomic_store_n(&async->tail, position + 1, __ATOMIC_RELEASE);
+        count++;
+    }
+}
+
+static bool
+_rtaLoggerAsync_IsEmpty(const _RtaLoggerAsync *async)
+{
+    const _RtaLoggerRecord *record = &async->records[async->tail & async->mask];
+    return __atomic_load_n(&record->sequence, __ATOMIC_ACQUIRE) != async->tail + 1;
+}
+
+/*
+ * Wait until a producer puts a message or the logger stops
+ */
+static void
+_rtaLoggerAsync_Park(_RtaLoggerAsync *async)
+{
+    pthread_mutex_lock(&async->lock);
+
+    // Announce ourselves before looking again, see _rtaLoggerAsync_Put
+    __atomic_store_n(&async->parked, true, __ATOMIC_SEQ_CST);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (_rtaLoggerAsync_IsEmpty(async)) {
+        while (__atomic_load_n(&async->parked, __ATOMIC_ACQUIRE) && async->running) {
+            pthread_cond_wait(&async->work_cv, &async->lock);
+        }
+    }
+    __atomic_store_n(&async->parked, false, __ATOMIC_RELAXED);
+
+    pthread_mutex_unlock(&async->lock);
+}
+
+/*
+ * Wake the threads in rtaLogger_Flush() after the tail moved
+ */
+static void
+_rtaLoggerAsync_SignalDrained(_RtaLoggerAsync *async)
+{
+    // Pairs with the increment in rtaLogger_Flush
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&async->flushWaiters, __ATOMIC_RELAXED) > 0) {
+        pthread_mutex_lock(&async->lock);
+        pthread_cond_broadcast(&async->drained_cv);
+        pthread_mutex_unlock(&async->lock);
+    }
+}
+
+static void *
+_rtaLoggerAsync_Run(void *arg)
+{
+    RtaLogger *logger = (RtaLogger *) arg;
+    _RtaLoggerAsync *async = logger->async;
+
+    while (__atomic_load_n(&async->running, __ATOMIC_ACQUIRE)) {
+        if (_rtaLoggerAsync_Drain(logger) > 0) {
+            _rtaLoggerAsync_SignalDrained(async);
+        } else {
+            _rtaLoggerAsync_Park(async);
+        }
+    }
+
+    // report whatever was queued before the stop
+    _rtaLoggerAsync_Drain(logger);
+    _rtaLoggerAsync_SignalDrained(async);
+    return NULL;
+}
+
+void
+rtaLogger_StartAsync(RtaLogger *logger, size_t capacity)
+{
+    assertNotNull(logger, "Parameter logger must be non-null");
+    assertNull(logger->async, "Logger is already asynchronous");
+    assertTrue(capacity > 0, "Parameter capacity must be positive");
+
+    size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    _RtaLoggerAsync *async = parcMemory_AllocateAndClear(sizeof(_RtaLoggerAsync));
+    assertNotNull(async, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(_RtaLoggerAsync));
+
+    async->records = parcMemory_AllocateAndClear(size * sizeof(_RtaLoggerRecord));
+    assertNotNull(async->records, "parcMemory_AllocateAndClear(%zu) returned NULL", size * sizeof(_RtaLoggerRecord));
+
+    for (size_t i = 0; i < size; i++) {
+        async->records[i].sequence = i;
+    }
+    async->mask = size - 1;
+    async->running = true;
+
+    pthread_mutex_init(&async->lock, NULL);
+    pthread_cond_init(&async->work_cv, NULL);
+    pthread_cond_init(&async->drained_cv, NULL);
+
+    logger->async = async;
+
+    int failure = pthread_create(&async->thread, NULL, _rtaLoggerAsync_Run, logger);
+    assertFalse(failure, "pthread_create failed: (%d) %s", failure, strerror(failure));
+}
+
+void
+rtaLogger_StopAsync(RtaLogger *logger)
+{
+    assertNotNull(logger, "Parameter logger must be non-null");
+    assertNotNull(logger->async, "Logger is not asynchronous");
+
+    _RtaLoggerAsync *async = logger->async;
+    pthread_mutex_lock(&async->lock);
+    __atomic_store_n(&async->running, false, __ATOMIC_RELEASE);
+    pthread_cond_signal(&async->work_cv);
+    pthread_mutex_unlock(&async->lock);
+    pthread_join(async->thread, NULL);
+
+    pthread_cond_destroy(&async->drained_cv);
+    pthread_cond_destroy(&async->work_cv);
+    pthread_mutex_destroy(&async->lock);
+
+    logger->async = NULL;
+    parcMemory_Deallocate((void **) &async->records);
+    parcMemory_Deallocate((void **) &async);
+}
+
+bool
+rtaLogger_IsAsync(const RtaLogger *logger)
+{
+    assertNotNull(logger, "Parameter logger must be non-null");
+    return logger->async != NULL;
+}
+
+void
+rtaLogger_Flush(RtaLogger *logger)
+{
+    assertNotNull(logger, "Parameter logger must be non-null");
+    _RtaLoggerAsync *async = logger->async;
+    if (async != NULL) {
+        uint64_t head = __atomic_load_n(&async->head, __ATOMIC_ACQUIRE);
+        if ((int64_t) (head - __atomic_load_n(&async->tail, __ATOMIC_ACQUIRE)) > 0) {
+            pthread_mutex_lock(&async->lock);
+
+            // Announce ourselves before looking again, see _rtaLoggerAsync_SignalDrained
+            __atomic_add_fetch(&async->flushWaiters, 1, __ATOMIC_SEQ_CST);
+            while ((int64_t) (head - __atomic_load_n(&async->tail, __ATOMIC_SEQ_CST)) > 0) {
+                pthread_cond_wait(&async->drained_cv, &async->lock);
+            }
+            __atomic_sub_fetch(&async->flushWaiters, 1, __ATOMIC_SEQ_CST);
+
+            pthread_mutex_unlock(&async->lock);
+        }
+    }
+}
+
+void
+rtaLogger_SetRateLimit(RtaLogger *logger, RtaLoggerFacility facility, unsigned messagesPerSecond)
+{
+    _assertInvariants(logger, facility);
+    __atomic_store_n(&logger->rate[facility].limit, messagesPerSecond, __ATOMIC_RELAXED);
+}
+
+uint64_t
+rtaLogger_GetDroppedCount(const RtaLogger *logger, RtaLoggerFacility facility)
+{
+    _assertInvariants(logger, facility);
+    return __atomic_load_n(&logger->dropped[facility], __ATOMIC_RELAXED);
+}
+
+uint64_t
+rtaLogger_GetRateLimitedCount(const RtaLogger *logger, RtaLoggerFacility facility)
+{
+    _assertInvariants(logger, facility);
+    return __atomic_load_n(&logger->rateLimited[facility], __ATOMIC_RELAXED);
+}
+
 void
 rtaLogger_Log(RtaLogger *logger, RtaLoggerFacility facility, PARCLogLevel level, const char *module, const char *format, ...)
 {
     if (rtaLogger_IsLoggable(logger, facility, level)) {
+        if (!_rtaLogger_RateAllows(logger, facility)) {
+            __atomic_add_fetch(&logger->rateLimited[facility], 1, __ATOMIC_RELAXED);
+            return;
+        }
+
         // this is logged as the messageid
         uint64_t logtime = parcClock_GetTime(logger->clock);
 
-        // rtaLogger_IsLoggable asserted invariants so we know facility is in bounds
-        PARCLog *log = logger->loggerArray[facility];
-
         va_list va;
         va_start(va, format);
 
-        parcLog_MessageVaList(log, level, logtime, format, va);
+        if (logger->async != NULL) {
+            if (!_rtaLoggerAsync_Put(logger->async, facility, level, logtime, format, va)) {
+                __atomic_add_fetch(&logger->dropped[facility], 1, __ATOMIC_RELAXED);
+            }
+        } else {
+            // rtaLogger_IsLoggable asserted invariants so we know facility is in bounds
+            PARCLog *log = logger->loggerArray[facility];
+            parcLog_MessageVaList(log, level, logtime, format, va);
+        }
 
         va_end(va);
     }
 }
-
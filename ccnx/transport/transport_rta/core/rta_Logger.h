@@ -58,6 +58,12 @@
  *
  * A facility based logger to allow selective logging from different parts of Rta
  *
+ * By default a message is formatted and written by the reporter on the calling thread.
+ * In asynchronous mode (rtaLogger_StartAsync) the caller only formats the message into a
+ * slot of a lock-free queue, and a writer thread hands it to the reporter, so a slow
+ * reporter does not stall the Transport thread.  When the queue is full the message is
+ * dropped and counted.  Each facility may also have a rate limit, in either mode.
+ *
  * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
  * @copyright (c) 2013-2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
  */
@@ -220,7 +226,9 @@ bool rtaLogger_IsLoggable(const RtaLogger *logger, RtaLoggerFacility facility, P
 /**
  * Log a message
  *
- * The message will only be logged if it is loggable (rtaLogger_IsLoggable returns true).
+ * The message will only be logged if it is loggable (rtaLogger_IsLoggable returns true)
+ * and the facility is within its rate limit.  In asynchronous mode the message is truncated
+ * to about 230 bytes and is dropped if the queue is full.
  *
  * @param [in] logger An allocated RtaLogger
  * @param [in] facility The facility to log under
@@ -265,4 +273,117 @@ void rtaLogger_SetReporter(RtaLogger *logger, PARCLogReporter *reporter);
  * @endcode
  */
 void rtaLogger_SetClock(RtaLogger *logger, PARCClock *clock);
+
+/**
+ * Switch the logger to asynchronous mode
+ *
+ * Starts a writer thread that reports queued messages.  Call this before other threads
+ * are logging, e.g. before the framework starts.  rtaLogger_Release() stops the thread.
+ * The writer sleeps while the queue is empty, and the message that ends that wakes it.
+ *
+ * @param [in] logger An allocated RtaLogger, not already asynchronous
+ * @param [in] capacity The number of queued messages, rounded up to a power of 2
+ *
+ * Example:
+ * @code
+ * {
+ *    PARCLogReporter *reporter = parcLogReporterTextStdout_Create();
+ *    RtaLogger *logger = rtaLogger_Create(reporter, parcClock_Monotonic());
+ *    parcLogReporter_Release(&reporter);
+ *    rtaLogger_StartAsync(logger, 4096);
+ * }
+ * @endcode
+ */
+void rtaLogger_StartAsync(RtaLogger *logger, size_t capacity);
+
+/**
+ * Return the logger to synchronous mode
+ *
+ * Reports every queued message, then stops the writer thread.
+ *
+ * @param [in] logger An asynchronous RtaLogger
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaLogger_StopAsync(RtaLogger *logger);
+
+/**
+ * Determine if the logger is in asynchronous mode
+ *
+ * @param [in] logger An allocated RtaLogger
+ *
+ * @retval true The logger has a writer thread
+ * @retval false Messages are reported on the calling thread
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+bool rtaLogger_IsAsync(const RtaLogger *logger);
+
+/**
+ * Wait until the messages queued so far have been reported
+ *
+ * Does nothing for a synchronous logger.
+ *
+ * @param [in] logger An allocated RtaLogger
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaLogger_Flush(RtaLogger *logger);
+
+/**
+ * Limit the number of messages a facility logs per second
+ *
+ * Messages over the limit are discarded and counted by rtaLogger_GetRateLimitedCount().
+ *
+ * @param [in] logger An allocated RtaLogger
+ * @param [in] facility The facility to limit
+ * @param [in] messagesPerSecond The limit, 0 for no limit (the default)
+ *
+ * Example:
+ * @code
+ * {
+ *    rtaLogger_SetRateLimit(logger, RtaLoggerFacility_Flowcontrol, 100);
+ * }
+ * @endcode
+ */
+void rtaLogger_SetRateLimit(RtaLogger *logger, RtaLoggerFacility facility, unsigned messagesPerSecond);
+
+/**
+ * The number of messages a facility dropped because the asynchronous queue was full
+ *
+ * @param [in] logger An allocated RtaLogger
+ * @param [in] facility The facility
+ *
+ * @return The count since the logger was created
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+uint64_t rtaLogger_GetDroppedCount(const RtaLogger *logger, RtaLoggerFacility facility);
+
+/**
+ * The number of messages a facility discarded because of its rate limit
+ *
+ * @param [in] logger An allocated RtaLogger
+ * @param [in] facility The facility
+ *
+ * @return The count since the logger was created
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+uint64_t rtaLogger_GetRateLimitedCount(const RtaLogger *logger, RtaLoggerFacility facility);
 #endif // Rta_rta_Logger_h
@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include <LongBow/runtime.h>
+#include <parc/algol/parc_Memory.h>
+
+#include <ccnx/transport/transport_rta/core/rta_MpscRing.h>
+
+/*
+ * The absolute deadline for pthread_cond_timedwait, on the clock room_cv was created with
+ */
+static struct timespec
+_rtaMpscRing_Deadline(uint64_t microSeconds)
+{
+    struct timespec now;
+#if defined(__APPLE__)
+    // no pthread_condattr_setclock, the condition variable waits on the wall clock
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    now.tv_sec = tv.tv_sec;
+    now.tv_nsec = (long) tv.tv_usec * 1000;
+#else
+    clock_gettime(CLOCK_MONOTONIC, &now);
+#endif
+
+    uint64_t nsec = (uint64_t) now.tv_nsec + (microSeconds % 1000000) * 1000;
+    struct timespec deadline = {
+        .tv_sec  = now.tv_sec + (time_t) (microSeconds / 1000000) + (time_t) (nsec / 1000000000),
+        .tv_nsec = (long) (nsec % 1000000000)
+    };
+    return deadline;
+}
+
+void
+rtaMpscRing_Init(RtaMpscRing *ring, size_t capacity)
+{
+    assertNotNull(ring, "Parameter ring must be non-null");
+    assertTrue(capacity > 0, "Parameter capacity must be positive");
+
+    size_t length = 2;
+    while (length < capacity) {
+        length *= 2;
+    }
+
+    memset(ring, 0, sizeof(RtaMpscRing));
+    ring->slots = parcMemory_AllocateAndClear(length * sizeof(RtaMpscRingSlot));
+    assertNotNull(ring->slots, "parcMemory_AllocateAndClear(%zu) returned NULL", length * sizeof(RtaMpscRingSlot));
+    for (size_t i = 0; i < length; i++) {
+        ring->slots[i].sequence = i;
+    }
+    ring->mask = length - 1;
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+#if !defined(__APPLE__)
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+#endif
+    pthread_cond_init(&ring->room_cv, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_mutex_init(&ring->lock, NULL);
+}
+
+void
+rtaMpscRing_Fini(RtaMpscRing *ring)
+{
+    assertNotNull(ring, "Parameter ring must be non-null");
+    assertTrue(rtaMpscRing_Count(ring) == 0, "The ring still holds %zu items", rtaMpscRing_Count(ring));
+
+    parcMemory_Deallocate((void **) &ring->slots);
+    pthread_cond_destroy(&ring->room_cv);
+    pthread_mutex_destroy(&ring->lock);
+}
+
+size_t
+rtaMpscRing_Capacity(const RtaMpscRing *ring)
+{
+    assertNotNull(ring, "Parameter ring must be non-null");
+    return (size_t) ring->mask + 1;
+}
+
+size_t
+rtaMpscRing_Count(const RtaMpscRing *ring)
+{
+    assertNotNull(ring, "Parameter ring must be non-null");
+
+    uint64_t get = __atomic_load_n(&ring->getPosition, __ATOMIC_RELAXED);
+    uint64_t put = __atomic_load_n(&ring->putPosition, __ATOMIC_RELAXED);
+
+    // claimed slots count before they are filled, so the two can cross by a few
+    if (put <= get) {
+        return 0;
+    }
+    size_t count = (size_t) (put - get);
+    return (count > ring->mask + 1) ? (size_t) ring->mask + 1 : count;
+}
+
+bool
+rtaMpscRing_TryPut(RtaMpscRing *ring, void *item)
+{
+    uint64_t position = __atomic_load_n(&ring->putPosition, __ATOMIC_RELAXED);
+    for (;;) {
+        RtaMpscRingSlot *slot = &ring->slots[position & ring->mask];
+        uint64_t sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+        int64_t difference = (int64_t) sequence - (int64_t) position;
+
+        if (difference == 0) {
+            // the slot is free for this position, claim it
+            if (__atomic_compare_exchange_n(&ring->putPosition, &position, position + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                slot->item = item;
+                __atomic_store_n(&slot->sequence, position + 1, __ATOMIC_RELEASE);
+                return true;
+            }
+            // another producer claimed it, position was reloaded by the compare-and-swap
+        } else if (difference < 0) {
+            // the slot still holds the item from one lap ago, the ring is full
+            return false;
+        } else {
+            position = __atomic_load_n(&ring->putPosition, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+bool
+rtaMpscRing_Put(RtaMpscRing *ring, void *item, const uint64_t *microSeconds)
+{
+    assertNotNull(ring, "Parameter ring must be non-null");
+    assertNotNull(item, "Parameter item must be non-null");
+
+    if (__atomic_load_n(&ring->closed, __ATOMIC_ACQUIRE)) {
+        errno = EPIPE;
+        return false;
+    }
+
+    if (rtaMpscRing_TryPut(ring, item)) {
+        return true;
+    }
+
+    if (microSeconds != NULL && *microSeconds == 0) {
+        errno = EWOULDBLOCK;
+        return false;
+    }
+
+    struct timespec deadline;
+    if (microSeconds != NULL) {
+        deadline = _rtaMpscRing_Deadline(*microSeconds);
+    }
+
+    bool success = false;
+    pthread_mutex_lock(&ring->lock);
+
+    // Announce ourselves before trying again, so a slot freed after our last try
+    // is followed by a signal (see rtaMpscRing_Get)
+    __atomic_add_fetch(&ring->waiters, 1, __ATOMIC_SEQ_CST);
+    while (!ring->closed && !(success = rtaMpscRing_TryPut(ring, item))) {
+        if (microSeconds == NULL) {
+            pthread_cond_wait(&ring->room_cv, &ring->lock);
+        } else if (pthread_cond_timedwait(&ring->room_cv, &ring->lock, &deadline) == ETIMEDOUT) {
+            success = !ring->closed && rtaMpscRing_TryPut(ring, item);
+            break;
+        }
+    }
+    __atomic_sub_fetch(&ring->waiters, 1, __ATOMIC_SEQ_CST);
+
+    bool closed = ring->closed;
+    pthread_mutex_unlock(&ring->lock);
+
+    if (!success) {
+        errno = closed ? EPIPE : EWOULDBLOCK;
+    }
+    return success;
+}
+
+void *
+rtaMpscRing_Get(RtaMpscRing *ring)
+{
+    assertNotNull(ring, "Parameter ring must be non-null");
+
+    uint64_t position = ring->getPosition;
+    RtaMpscRingSlot *slot = &ring->slots[position & ring->mask];
+    if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != position + 1) {
+        return NULL;
+    }
+
+    void *item = slot->item;
+    slot->item = NULL;
+    __atomic_store_n(&slot->sequence, position + ring->mask + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&ring->getPosition, position + 1, __ATOMIC_RELAXED);
+
+    // Pairs with the increment in rtaMpscRing_Put: either the producer sees the free
+    // slot on its next try, or we see it waiting and wake it
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&ring->waiters, __ATOMIC_RELAXED) > 0) {
+        pthread_mutex_lock(&ring->lock);
+        pthread_cond_broadcast(&ring->room_cv);
+        pthread_mutex_unlock(&ring->lock);
+    }
+
+    return item;
+}
+
+void
+rtaMpscRing_Close(RtaMpscRing *ring)
+{
+    assertNotNull(ring, "Parameter ring must be non-null");
+
+    pthread_mutex_lock(&ring->lock);
+    __atomic_store_n(&ring->closed, true, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&ring->room_cv);
+    pthread_mutex_unlock(&ring->lock);
+}
+
+bool
+rtaMpscRing_IsClosed(const RtaMpscRing *ring)
+{
+    assertNotNull(ring, "Parameter ring must be non-null");
+    return __atomic_load_n(&ring->closed, __ATOMIC_ACQUIRE);
+}
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file rta_MpscRing.h
+ * @brief The bounded multi-producer, single-consumer ring under RtaCommandQueue and RtaSendQueue
+ *
+ * A ring in the style of Vyukov's bounded MPMC queue.  Slot i is free for the producer at
+ * position p when its sequence is p, and holds an item for the consumer at position p when
+ * its sequence is p + 1.  The consumer frees it for position p + capacity.  Producers only
+ * contend on one compare-and-swap.
+ *
+ * A producer that finds the ring full may wait for room.  The consumer signals the waiters
+ * only while there are some, so an uncontended get takes no lock.  Timed waits are measured
+ * on CLOCK_MONOTONIC, so setting the wall clock does not stretch or cut them short.
+ *
+ * The ring is embedded in the queue that uses it, so the queue keeps one allocation and
+ * controls the cache-line layout of its own fields.
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef Libccnx_rta_MpscRing_h
+#define Libccnx_rta_MpscRing_h
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define RTA_CACHE_LINE_SIZE 64
+
+typedef struct rta_mpsc_ring_slot {
+    uint64_t sequence;
+    void *item;
+} RtaMpscRingSlot;
+
+/**
+ * @typedef RtaMpscRing
+ * @abstract The ring.  Only rta_MpscRing.c touches the fields, except that the owning queue
+ *   may take `lock` to order its own state with the waiters.
+ */
+typedef struct rta_mpsc_ring {
+    RtaMpscRingSlot *slots;
+    uint64_t mask;
+
+    // Claimed by producers with compare-and-swap, on its own cache line
+    uint64_t putPosition __attribute__ ((aligned(RTA_CACHE_LINE_SIZE)));
+
+    // Only the consumer writes it
+    uint64_t getPosition __attribute__ ((aligned(RTA_CACHE_LINE_SIZE)));
+
+    // Producers waiting for room.  The consumer signals room_cv only while waiters is not 0.
+    unsigned waiters __attribute__ ((aligned(RTA_CACHE_LINE_SIZE)));
+    bool closed;
+    pthread_mutex_t lock;
+    pthread_cond_t room_cv;
+} RtaMpscRing;
+
+/**
+ * Initialize an empty ring
+ *
+ * @param [in] ring The memory to initialize
+ * @param [in] capacity The number of items the ring holds, rounded up to a power of 2
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaMpscRing ring;
+ *     rtaMpscRing_Init(&ring, 64);
+ *     rtaMpscRing_Fini(&ring);
+ * }
+ * @endcode
+ */
+void rtaMpscRing_Init(RtaMpscRing *ring, size_t capacity);
+
+/**
+ * Release the ring's memory.  The caller must have taken the items off first.
+ *
+ * @param [in] ring An initialized ring
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaMpscRing_Fini(RtaMpscRing *ring);
+
+/**
+ * The number of items the ring holds
+ *
+ * @param [in] ring An initialized ring
+ *
+ * @return number The capacity, a power of 2
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+size_t rtaMpscRing_Capacity(const RtaMpscRing *ring);
+
+/**
+ * The number of items on the ring.  Only a snapshot while producers are putting.
+ *
+ * @param [in] ring An initialized ring
+ *
+ * @return number Between 0 and the capacity
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+size_t rtaMpscRing_Count(const RtaMpscRing *ring);
+
+/**
+ * Put an item on the ring if there is room.  Never blocks, and ignores whether the ring is closed.
+ *
+ * @param [in] ring An initialized ring
+ * @param [in] item A non-null item
+ *
+ * @return true The item is on the ring
+ * @return false The ring is full
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+bool rtaMpscRing_TryPut(RtaMpscRing *ring, void *item);
+
+/**
+ * Put an item on the ring, waiting for room up to the timeout
+ *
+ * @param [in] ring An initialized ring
+ * @param [in] item A non-null item
+ * @param [in] microSeconds NULL waits forever, 0 does not wait
+ *
+ * @return true The item is on the ring
+ * @return false Not put, errno is EWOULDBLOCK if the ring stayed full or EPIPE if it is closed
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+bool rtaMpscRing_Put(RtaMpscRing *ring, void *item, const uint64_t *microSeconds);
+
+/**
+ * Take the oldest item off the ring, and wake the producers waiting for room.  Only the consumer may call it.
+ *
+ * @param [in] ring An initialized ring
+ *
+ * @return non-null The oldest item
+ * @return null The ring is empty
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void *rtaMpscRing_Get(RtaMpscRing *ring);
+
+/**
+ * Refuse further puts and wake the producers waiting for room
+ *
+ * @param [in] ring An initialized ring
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaMpscRing_Close(RtaMpscRing *ring);
+
+/**
+ * Whether rtaMpscRing_Close() was called
+ *
+ * @param [in] ring An initialized ring
+ *
+ * @return true The ring refuses puts
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+bool rtaMpscRing_IsClosed(const RtaMpscRing *ring);
+#endif // Libccnx_rta_MpscRing_h
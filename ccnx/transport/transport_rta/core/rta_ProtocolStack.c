@@ -65,11 +65,11 @@
 #include <unistd.h>
 #include <sys/queue.h>
 #include <string.h>
-#include <strings.h>
 #include <sys/time.h>
 
 #include <parc/algol/parc_Memory.h>
 #include <parc/algol/parc_EventQueue.h>
+#include <parc/algol/parc_EventBuffer.h>
 
 #include <ccnx/transport/transport_rta/core/rta_Framework.h>
 #include <ccnx/transport/transport_rta/core/rta_Framework_Services.h>
@@ -84,8 +84,10 @@
 
 #include <ccnx/transport/transport_rta/connectors/connector_Api.h>
 #include <ccnx/transport/transport_rta/connectors/connector_Forwarder.h>
+#include <ccnx/transport/transport_rta/components/component_Cache.h>
 #include <ccnx/transport/transport_rta/components/component_Codec.h>
 #include <ccnx/transport/transport_rta/components/component_Flowcontrol.h>
+#include <ccnx/transport/transport_rta/components/component_PendingInterestTable.h>
 #include <ccnx/transport/transport_rta/components/component_Testing.h>
 
 #include <ccnx/transport/transport_rta/config/config_ProtocolStack.h>
@@ -105,8 +107,8 @@ const char *RtaComponentNames[LAST_COMPONENT] =
     "FC_NONE",
     "FC_VEGAS",
     "FC_PIPELINE",
-    "VERIFY_NONE",      // 4
-    "VERIFY_ENUMERATED",
+    "CACHE",            // 4
+    "PIT",
     "VERIFY_LOCATOR",
     "CODEC_NONE",
     NULL,               // 8
@@ -115,7 +117,7 @@ const char *RtaComponentNames[LAST_COMPONENT] =
     "CODE_FLAN",
     NULL,               // 12
     "FWD_LOCAL",
-    "FWD_FLAN",
+    "FWD_SIMULATED",
     "FWD_CCND",         // 15
     "TESTING_UPPER",
     "TESTING_LOWER",    // 17
@@ -135,6 +137,9 @@ struct protocol_stack {
     // keep this memory valid for as long as the connection is open
     PARCJSON *params;
 
+    // The compiled configuration, NULL if the stack was created from bare JSON
+    RtaStackDescriptor *descriptor;
+
     // the inter-component queues
     unsigned component_count;
     PARCEventQueuePair *queue_pairs[MAX_STACK_DEPTH];
@@ -232,6 +237,19 @@ rtaProtocolStack_Create(RtaFramework *framework, PARCJSON *params, int stack_id)
     return stack;
 }
 
+RtaProtocolStack *
+rtaProtocolStack_CreateFromDescriptor(RtaFramework *framework, const RtaStackDescriptor *descriptor, int stack_id)
+{
+    assertNotNull(descriptor, "Parameter descriptor must be non-null");
+
+    RtaProtocolStack *stack =
+        rtaProtocolStack_Create(framework, ccnxStackConfig_GetJson(rtaStackDescriptor_GetStackConfig(descriptor)), stack_id);
+    if (stack != NULL) {
+        stack->descriptor = rtaStackDescriptor_Acquire(descriptor);
+    }
+    return stack;
+}
+
 /**
  * Opens a connection inside the protocol stack: it calls open() on each component.
  *
@@ -419,6 +437,9 @@ rtaProtocolStack_Destroy(RtaProtocolStack **stackPtr)
 
 
     parcJSON_Release(&stack->params);
+    if (stack->descriptor != NULL) {
+        rtaStackDescriptor_Release(&stack->descriptor);
+    }
     memset(stack, 0, sizeof(RtaProtocolStack));
 
     parcMemory_Deallocate((void **) &stack);
@@ -438,6 +459,35 @@ rtaProtocolStack_GetPutQueue(RtaProtocolStack *stack, RtaComponents component, R
     }
 }
 
+/*
+ * A message put on one end of a queue pair moves from its output to the other end's input
+ */
+static bool
+_rtaProtocolStack_QueueIsEmpty(PARCEventQueue *queue)
+{
+    PARCEventBuffer *in = parcEventBuffer_GetQueueBufferInput(queue);
+    PARCEventBuffer *out = parcEventBuffer_GetQueueBufferOutput(queue);
+    bool empty = (parcEventBuffer_GetLength(in) == 0) && (parcEventBuffer_GetLength(out) == 0);
+    parcEventBuffer_Destroy(&out);
+    parcEventBuffer_Destroy(&in);
+    return empty;
+}
+
+bool
+rtaProtocolStack_HasQueuedMessages(const RtaProtocolStack *stack)
+{
+    assertNotNull(stack, "%s called with null stack\n", __func__);
+
+    // only the pairs between configured components carry messages
+    for (unsigned i = 0; i < stack->component_count && i < MAX_STACK_DEPTH; i++) {
+        if (!_rtaProtocolStack_QueueIsEmpty(parcEventQueue_GetConnectedUpQueue(stack->queue_pairs[i]))
+            || !_rtaProtocolStack_QueueIsEmpty(parcEventQueue_GetConnectedDownQueue(stack->queue_pairs[i]))) {
+            return true;
+        }
+    }
+    return false;
+}
+
 
 /**
  * Look up the symbolic name of the queue.  Do not free the return.
@@ -464,34 +514,156 @@ rtaProtocolStack_GetQueueName(RtaProtocolStack *stack, PARCEventQueue *queue)
     trapUnexpectedState("Could not find queue %p in stack %p", (void *) queue, (void *) stack);
 }
 
-// =================================================
-// =================================================
+static bool
+_rtaProtocolStack_FindQueue(const RtaProtocolStack *stack, PARCEventQueue *queue, unsigned *index, RtaDirection *side)
+{
+    for (unsigned i = 0; i < stack->component_count; i++) {
+        const struct component_queues *queues = stack->component_queues[stack->components[i]];
+        if (queues != NULL) {
+            if (queues->up == queue) {
+                *index = i;
+                *side = RTA_UP;
+                return true;
+            }
+            if (queues->down == queue) {
+                *index = i;
+                *side = RTA_DOWN;
+                return true;
+            }
+        }
+    }
+    return false;
+}
 
-static RtaComponents
-getComponentTypeFromName(const char *name)
+bool
+rtaProtocolStack_GetQueueOwner(const RtaProtocolStack *stack, PARCEventQueue *queue, RtaComponents *component, RtaDirection *side)
 {
-    int i;
+    unsigned index;
+    if (_rtaProtocolStack_FindQueue(stack, queue, &index, side)) {
+        *component = stack->components[index];
+        return true;
+    }
+    return false;
+}
+
+/*
+ * The component writing into the queue at `index` and `side`.  components[0] is the top of
+ * the stack.  Reading the `up` queue gets what the component above wrote going down, reading
+ * the `down` queue gets what the component below wrote going up.
+ */
+static bool
+_rtaProtocolStack_QueueWriter(const RtaProtocolStack *stack, unsigned index, RtaDirection side, RtaComponents *component, RtaDirection *direction)
+{
+    if (side == RTA_UP && index > 0) {
+        *component = stack->components[index - 1];
+        *direction = RTA_DOWN;
+        return true;
+    }
+    if (side == RTA_DOWN && index + 1 < stack->component_count) {
+        *component = stack->components[index + 1];
+        *direction = RTA_UP;
+        return true;
+    }
+    return false;
+}
 
-    if (name == NULL) {
-        return UNKNOWN_COMPONENT;
+bool
+rtaProtocolStack_GetQueueWriter(const RtaProtocolStack *stack, PARCEventQueue *queue, RtaComponents *component, RtaDirection *direction)
+{
+    unsigned index;
+    RtaDirection side;
+    if (_rtaProtocolStack_FindQueue(stack, queue, &index, &side)) {
+        return _rtaProtocolStack_QueueWriter(stack, index, side, component, direction);
     }
+    return false;
+}
 
-    for (i = 0; i < LAST_COMPONENT; i++) {
-        if (RtaComponentNames[i] != NULL) {
-            if (strncasecmp(RtaComponentNames[i], name, 16) == 0) {
-                return (RtaComponents) i;
-            }
-        }
+bool
+rtaProtocolStack_GetQueueEnds(const RtaProtocolStack *stack, PARCEventQueue *queue, RtaQueueEnds *ends)
+{
+    unsigned index;
+    if (_rtaProtocolStack_FindQueue(stack, queue, &index, &ends->side)) {
+        ends->owner = stack->components[index];
+        ends->hasWriter = _rtaProtocolStack_QueueWriter(stack, index, ends->side, &ends->writer, &ends->direction);
+        return true;
     }
-    return UNKNOWN_COMPONENT;
+    return false;
 }
 
+// =================================================
+// =================================================
+
+/**
+ * Calls the configuration routine of one component
+ */
+static void
+_rtaProtocolStack_ConfigureComponent(RtaProtocolStack *stack, RtaComponents comp_type)
+{
+    switch (comp_type) {
+        case API_CONNECTOR:
+            configure_ApiConnector(stack, comp_type, api_ops);
+            break;
+
+        case FC_NONE:
+            trapIllegalValue(comp_type, "Null flowcontroller no longer supported");
+            break;
+        case FC_VEGAS:
+            configure_Component(stack, comp_type, flow_vegas_ops);
+            break;
+        case FC_PIPELINE:
+            configure_Component(stack, comp_type, flow_pipeline_ops);
+            break;
+
+        case CACHE:
+            configure_Component(stack, comp_type, cache_ops);
+            break;
+
+        case PIT:
+            configure_Component(stack, comp_type, pit_ops);
+            break;
+
+        case CODEC_NONE:
+            trapIllegalValue(comp_type, "Null codec no longer supported");
+            break;
+        case CODEC_TLV:
+            configure_Component(stack, comp_type, codec_tlv_ops);
+            break;
+
+        case FWD_NONE:
+            abort();
+            break;
+        case FWD_LOCAL:
+            configure_FwdConnector(stack, comp_type, fwd_local_ops);
+            break;
+
+        case FWD_METIS:
+            configure_FwdConnector(stack, comp_type, fwd_metis_ops);
+            break;
+
+        case FWD_SIMULATED:
+            configure_FwdConnector(stack, comp_type, fwd_simulated_ops);
+            break;
+
+        case TESTING_UPPER:
+        // fallthrough
+        case TESTING_LOWER:
+            configure_Component(stack, comp_type, testing_null_ops);
+            break;
+
+
+        default:
+            fprintf(stderr, "%s unsupported component type %d\n", __func__, comp_type);
+            abort();
+    }
+}
 
 /**
  * Calls the confguration routine for each component in the stack
  *
- * Builds an array list of everything in the JSON configuration, then
- * calls its configuation routine.
+ * Uses the component list of the stack's RtaStackDescriptor, compiled when the
+ * Transport first opened the stack.  A stack created from bare JSON, or whose
+ * descriptor has no components, parses the component names here instead, which
+ * asserts on a configuration without a component list.
  *
  * The connecting event queues are disabled at this point.
  *
@@ -505,66 +677,30 @@ getComponentTypeFromName(const char *name)
 static void
 rtaProtocolStack_ConfigureComponents(RtaProtocolStack *stack)
 {
-    PARCArrayList *componentNameList;
-    componentNameList = protocolStack_GetComponentNameArray(stack->params);
-    assertTrue(parcArrayList_Size(componentNameList) < MAX_STACK_DEPTH,
-               "Too many components in a stack size %zu\n",
-               parcArrayList_Size(componentNameList));
-
-
-    for (int i = 0; i < parcArrayList_Size(componentNameList); i++) {
-        // match it to a component type
-        const char *comp_name = parcArrayList_Get(componentNameList, i);
-        RtaComponents comp_type = getComponentTypeFromName(comp_name);
-
-        // this could be sped up slightly by putting the ops structures
-        // in an array
-        switch (comp_type) {
-            case API_CONNECTOR:
-                configure_ApiConnector(stack, comp_type, api_ops);
-                break;
-
-            case FC_NONE:
-                trapIllegalValue(comp_type, "Null flowcontroller no longer supported");
-                break;
-            case FC_VEGAS:
-                configure_Component(stack, comp_type, flow_vegas_ops);
-                break;
-            case FC_PIPELINE:
-                abort();
-                break;
+    RtaComponents componentTypes[MAX_STACK_DEPTH];
+    size_t count;
 
-            case CODEC_NONE:
-                trapIllegalValue(comp_type, "Null codec no longer supported");
-                break;
-            case CODEC_TLV:
-                configure_Component(stack, comp_type, codec_tlv_ops);
-                break;
-
-            case FWD_NONE:
-                abort();
-                break;
-            case FWD_LOCAL:
-                configure_FwdConnector(stack, comp_type, fwd_local_ops);
-                break;
-
-            case FWD_METIS:
-                configure_FwdConnector(stack, comp_type, fwd_metis_ops);
-                break;
-
-            case TESTING_UPPER:
-            // fallthrough
-            case TESTING_LOWER:
-                configure_Component(stack, comp_type, testing_null_ops);
-                break;
+    if (stack->descriptor != NULL && rtaStackDescriptor_GetComponentCount(stack->descriptor) > 0) {
+        count = rtaStackDescriptor_GetComponentCount(stack->descriptor);
+        assertTrue(count < MAX_STACK_DEPTH, "Too many components in a stack size %zu\n", count);
 
+        for (size_t i = 0; i < count; i++) {
+            componentTypes[i] = rtaStackDescriptor_GetComponent(stack->descriptor, i);
+        }
+    } else {
+        PARCArrayList *componentNameList = protocolStack_GetComponentNameArray(stack->params);
+        count = parcArrayList_Size(componentNameList);
+        assertTrue(count < MAX_STACK_DEPTH, "Too many components in a stack size %zu\n", count);
 
-            default:
-                fprintf(stderr, "%s unsupported component type %s\n", __func__, comp_name);
-                abort();
+        for (size_t i = 0; i < count; i++) {
+            componentTypes[i] = rtaStackDescriptor_ComponentFromName(parcArrayList_Get(componentNameList, i));
         }
+        parcArrayList_Destroy(&componentNameList);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        _rtaProtocolStack_ConfigureComponent(stack, componentTypes[i]);
     }
-    parcArrayList_Destroy(&componentNameList);
 }
 
 static bool
@@ -660,6 +796,29 @@ rtaProtocolStack_GetParam(RtaProtocolStack *stack, const char *domain, const cha
     return parcJSONValue_GetJSON(value);
 }
 
+PARCJSON *
+rtaProtocolStack_GetParameters(const RtaProtocolStack *stack)
+{
+    assertNotNull(stack, "Parameter stack must be a non-null RtaProtocolStack pointer.");
+    return stack->params;
+}
+
+void *
+rtaProtocolStack_GetPrivateData(RtaProtocolStack *stack, RtaComponents component)
+{
+    assertNotNull(stack, "Parameter stack must be a non-null RtaProtocolStack pointer.");
+    assertTrue(component < LAST_COMPONENT, "invalid component %d\n", component);
+    return stack->component_state[component];
+}
+
+void
+rtaProtocolStack_SetPrivateData(RtaProtocolStack *stack, RtaComponents component, void *private)
+{
+    assertNotNull(stack, "Parameter stack must be a non-null RtaProtocolStack pointer.");
+    assertTrue(component < LAST_COMPONENT, "invalid component %d\n", component);
+    stack->component_state[component] = private;
+}
+
 unsigned
 rtaProtocolStack_GetNextConnectionId(RtaProtocolStack *stack)
 {
@@ -675,40 +834,162 @@ rtaProtocolStack_GetStats(const RtaProtocolStack *stack, RtaComponents type)
 }
 
 static void
-printSingleTuple(FILE *file, const struct timeval *timeval, const RtaProtocolStack *stack, RtaComponents componentType, RtaComponentStatType stat)
+_rtaProtocolStack_AddObject(PARCJSON *json, const char *name, PARCJSON *value)
+{
+    parcJSON_AddObject(json, name, value);
+    parcJSON_Release(&value);
+}
+
+static PARCJSON *
+_rtaProtocolStack_CacheStatsToJSON(const ComponentCacheStats *stats)
+{
+    PARCJSON *json = parcJSON_Create();
+    parcJSON_AddInteger(json, "hits", (int64_t) stats->hits);
+    parcJSON_AddInteger(json, "misses", (int64_t) stats->misses);
+    parcJSON_AddInteger(json, "evictions", (int64_t) stats->evictions);
+    parcJSON_AddInteger(json, "inserts", (int64_t) stats->inserts);
+    parcJSON_AddInteger(json, "objectCount", (int64_t) stats->objectCount);
+    parcJSON_AddInteger(json, "bytesUsed", (int64_t) stats->bytesUsed);
+    parcJSON_AddInteger(json, "maxBytes", (int64_t) stats->maxBytes);
+    return json;
+}
+
+static PARCJSON *
+_rtaProtocolStack_PitStatsToJSON(const ComponentPitStats *stats)
+{
+    PARCJSON *json = parcJSON_Create();
+    parcJSON_AddInteger(json, "forwarded", (int64_t) stats->forwarded);
+    parcJSON_AddInteger(json, "aggregated", (int64_t) stats->aggregated);
+    parcJSON_AddInteger(json, "satisfied", (int64_t) stats->satisfied);
+    parcJSON_AddInteger(json, "fanout", (int64_t) stats->fanout);
+    parcJSON_AddInteger(json, "expired", (int64_t) stats->expired);
+    parcJSON_AddInteger(json, "entryCount", (int64_t) stats->entryCount);
+    return json;
+}
+
+static PARCJSON *
+_rtaProtocolStack_PacingStatsToJSON(const FlowControlPacingStats *stats)
 {
-    RtaComponentStats *stats = rtaProtocolStack_GetStats(stack, componentType);
+    PARCJSON *json = parcJSON_Create();
+    parcJSON_AddInteger(json, "delayedSends", (int64_t) stats->delayedSends);
+    parcJSON_AddInteger(json, "pacedSends", (int64_t) stats->pacedSends);
+    parcJSON_AddInteger(json, "timerFires", (int64_t) stats->timerFires);
+    return json;
+}
 
-    fprintf(file, "{ \"stackId\" : %d, \"component\" : \"%s\", \"name\" : \"%s\", \"value\" : %" PRIu64 ", \"timeval\" : %ld.%06u }\n",
-            stack->stack_id,
-            RtaComponentNames[componentType],
-            rtaComponentStatType_ToString(stat),
-            rtaComponentStats_Get(stats, stat),
-            timeval->tv_sec,
-            (unsigned) timeval->tv_usec
-            );
+static PARCJSON *
+_rtaProtocolStack_WindowStatsToJSON(const FlowControlWindowStats *stats)
+{
+    PARCJSON *json = parcJSON_Create();
+    parcJSON_AddInteger(json, "sessions", stats->sessions);
+    parcJSON_AddInteger(json, "cwnd", (int64_t) stats->cwnd);
+    parcJSON_AddInteger(json, "maxSrttUsec", (int64_t) stats->maxSrttUsec);
+    parcJSON_AddInteger(json, "maxRtoUsec", (int64_t) stats->maxRtoUsec);
+    return json;
 }
 
-PARCArrayList *
-rtaProtocolStack_GetStatistics(const RtaProtocolStack *stack, FILE *file)
+static PARCJSON *
+_rtaProtocolStack_MetisStatsToJSON(const MetisConnectorStats *stats)
 {
-    PARCArrayList *list = parcArrayList_Create(NULL);
+    PARCJSON *json = parcJSON_Create();
+    parcJSON_AddInteger(json, "upcallReads", stats->countUpcallReads);
+    parcJSON_AddInteger(json, "upcallWriteDataOk", stats->countUpcallWriteDataOk);
+    parcJSON_AddInteger(json, "upcallWriteDataError", stats->countUpcallWriteDataError);
+    parcJSON_AddInteger(json, "upcallWriteDataBlocked", stats->countUpcallWriteDataBlocked);
+    parcJSON_AddInteger(json, "upcallWriteDataQueueFull", stats->countUpcallWriteDataQueueFull);
+    parcJSON_AddInteger(json, "upcallWriteControlOk", stats->countUpcallWriteControlOk);
+    parcJSON_AddInteger(json, "upcallWriteControlError", stats->countUpcallWriteControlError);
+    parcJSON_AddInteger(json, "downcallReads", stats->countDowncallReads);
+    parcJSON_AddInteger(json, "downcallWrites", stats->countDowncallWrites);
+    parcJSON_AddInteger(json, "downcallControl", stats->countDowncallControl);
+    return json;
+}
+
+PARCJSON *
+rtaProtocolStack_GetStatisticsSnapshot(RtaProtocolStack *stack)
+{
+    assertNotNull(stack, "Parameter stack must be a non-null RtaProtocolStack pointer.");
+
+    PARCJSON *components = parcJSON_Create();
+    for (int componentIndex = 0; componentIndex < stack->component_count; componentIndex++) {
+        RtaComponents componentType = stack->components[componentIndex];
+        PARCJSON *component = rtaComponentStats_ToJSON(rtaProtocolStack_GetStats(stack, componentType));
+
+        // Counters a component keeps for the whole stack
+        ComponentCacheStats cacheStats;
+        ComponentPitStats pitStats;
+        switch (componentType) {
+            case CACHE:
+                if (component_Cache_GetStats(stack, &cacheStats)) {
+                    _rtaProtocolStack_AddObject(component, "cache", _rtaProtocolStack_CacheStatsToJSON(&cacheStats));
+                }
+                break;
+
+            case PIT:
+                if (component_PendingInterestTable_GetStats(stack, &pitStats)) {
+                    _rtaProtocolStack_AddObject(component, "pit", _rtaProtocolStack_PitStatsToJSON(&pitStats));
+                }
+                break;
+
+            default:
+                break;
+        }
 
-    struct timeval timeval;
-    gettimeofday(&timeval, NULL);
+        _rtaProtocolStack_AddObject(components, RtaComponentNames[componentType], component);
+    }
 
-    // This does not fill in the array list (case 939)
+    PARCJSON *json = parcJSON_Create();
+    parcJSON_AddInteger(json, "stackId", stack->stack_id);
+    _rtaProtocolStack_AddObject(json, "components", components);
+    return json;
+}
+
+PARCJSON *
+rtaProtocolStack_GetConnectionStatisticsSnapshot(RtaProtocolStack *stack, RtaConnection *connection)
+{
+    assertNotNull(stack, "Parameter stack must be a non-null RtaProtocolStack pointer.");
+    assertNotNull(connection, "Parameter connection must be non-null");
+
+    PARCJSON *components = parcJSON_Create();
     for (int componentIndex = 0; componentIndex < stack->component_count; componentIndex++) {
         RtaComponents componentType = stack->components[componentIndex];
-        printSingleTuple(file, &timeval, stack, componentType, STATS_OPENS);
-        printSingleTuple(file, &timeval, stack, componentType, STATS_CLOSES);
-        printSingleTuple(file, &timeval, stack, componentType, STATS_UPCALL_IN);
-        printSingleTuple(file, &timeval, stack, componentType, STATS_UPCALL_OUT);
-        printSingleTuple(file, &timeval, stack, componentType, STATS_DOWNCALL_IN);
-        printSingleTuple(file, &timeval, stack, componentType, STATS_DOWNCALL_OUT);
+        PARCJSON *component = rtaComponentStats_ToJSON(rtaConnection_GetStats(connection, componentType));
+
+        // Counters a component keeps in its per-connection state
+        FlowControlPacingStats pacingStats;
+        FlowControlWindowStats windowStats;
+        MetisConnectorStats metisStats;
+        switch (componentType) {
+            case FC_VEGAS:  // fallthrough
+            case FC_PIPELINE:
+                if (component_Flowcontrol_GetWindowStats(connection, componentType, &windowStats)) {
+                    _rtaProtocolStack_AddObject(component, "window", _rtaProtocolStack_WindowStatsToJSON(&windowStats));
+                }
+                if (component_Flowcontrol_GetPacingStats(connection, componentType, &pacingStats)) {
+                    _rtaProtocolStack_AddObject(component, "pacing", _rtaProtocolStack_PacingStatsToJSON(&pacingStats));
+                }
+                break;
+
+            case FWD_METIS:
+                if (connector_Fwd_Metis_GetStats(connection, &metisStats)) {
+                    _rtaProtocolStack_AddObject(component, "metis", _rtaProtocolStack_MetisStatsToJSON(&metisStats));
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        _rtaProtocolStack_AddObject(components, RtaComponentNames[componentType], component);
     }
 
-    return list;
+    PARCJSON *json = parcJSON_Create();
+    parcJSON_AddInteger(json, "connectionId", rtaConnection_GetConnectionId(connection));
+    parcJSON_AddInteger(json, "apiFd", rtaConnection_GetApiFd(connection));
+    parcJSON_AddInteger(json, "messagesInQueue", rtaConnection_MessagesInQueue(connection));
+    parcJSON_AddInteger(json, "messagesInQueueHighWater", rtaConnection_MessagesInQueueHighWater(connection));
+    _rtaProtocolStack_AddObject(json, "components", components);
+    return json;
 }
 
 
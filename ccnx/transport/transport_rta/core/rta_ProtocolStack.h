@@ -131,6 +131,7 @@
 #define Libccnx_rta_ProtocolStack_h
 
 #include <parc/algol/parc_ArrayList.h>
+#include <parc/algol/parc_JSON.h>
 
 #include <parc/algol/parc_EventQueue.h>
 
@@ -138,6 +139,7 @@
 #include <ccnx/transport/transport_rta/core/rta_Framework.h>
 #include <ccnx/transport/transport_rta/core/components.h>
 #include <ccnx/transport/transport_rta/core/rta_ComponentQueue.h>
+#include <ccnx/transport/transport_rta/core/rta_StackDescriptor.h>
 #include <ccnx/transport/transport_rta/commands/rta_Command.h>
 
 struct rta_connection;
@@ -185,6 +187,34 @@ unsigned rtaProtocolStack_GetNextConnectionId(RtaProtocolStack *stack);
  */
 RtaProtocolStack *rtaProtocolStack_Create(RtaFramework *framework, PARCJSON *params, int stack_id);
 
+/**
+ * Creates a protocol stack from a compiled configuration
+ *
+ * Like rtaProtocolStack_Create(), but rtaProtocolStack_Configure() takes the components
+ * from the descriptor instead of parsing their names from the JSON.  The stack holds a
+ * reference to the descriptor.
+ *
+ * @param [in] framework The framework the stack runs in
+ * @param [in] descriptor The stack's compiled configuration
+ * @param [in] stack_id The identifier of the stack
+ *
+ * @return non-null An allocated protocol stack
+ * @return null An error
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaStackDescriptor *descriptor = rtaStackDescriptor_Create(stackConfig);
+ *     RtaProtocolStack *stack = rtaProtocolStack_CreateFromDescriptor(framework, descriptor, 1);
+ *     rtaStackDescriptor_Release(&descriptor);
+ *
+ *     rtaProtocolStack_Configure(stack);
+ *     rtaProtocolStack_Destroy(&stack);
+ * }
+ * @endcode
+ */
+RtaProtocolStack *rtaProtocolStack_CreateFromDescriptor(RtaFramework *framework, const RtaStackDescriptor *descriptor, int stack_id);
+
 /**
  * <#One Line Description#>
  *
@@ -204,43 +234,61 @@ RtaProtocolStack *rtaProtocolStack_Create(RtaFramework *framework, PARCJSON *par
 int rtaProtocolStack_Configure(RtaProtocolStack *stack);
 
 /**
- * <#One Line Description#>
+ * Returns the stack-wide private data of a component
  *
- * <#Paragraphs Of Explanation#>
+ * A component may keep state shared by all connections of a protocol stack (e.g. a
+ * content store).  It is usually set in the component's init() and cleared in its release().
  *
- * @param [in] stack <#description#>
- * @param [in] component <#description#>
+ * @param [in] stack An allocated protocol stack
+ * @param [in] component The component that owns the state
  *
- * @return <#value#> <#explanation#>
+ * @return NULL No private data set
+ * @return non-null The value from rtaProtocolStack_SetPrivateData()
  *
  * Example:
  * @code
  * <#example#>
  * @endcode
  *
- * @see <#references#>
+ * @see rtaProtocolStack_SetPrivateData
  */
 void *rtaProtocolStack_GetPrivateData(RtaProtocolStack *stack, RtaComponents component);
 /**
- * <#One Line Description#>
+ * Stores the stack-wide private data of a component
  *
- * <#Paragraphs Of Explanation#>
+ * The protocol stack does not take ownership of the memory.  The component
+ * must free it in its release() function.
  *
- * @param [in] stack <#description#>
- * @param [in] component <#description#>
- * @param [in] private <#description#>
- *
- * @return <#value#> <#explanation#>
+ * @param [in] stack An allocated protocol stack
+ * @param [in] component The component that owns the state
+ * @param [in] private The state to store (may be NULL to clear it)
  *
  * Example:
  * @code
  * <#example#>
  * @endcode
  *
- * @see <#references#>
+ * @see rtaProtocolStack_GetPrivateData
  */
 void rtaProtocolStack_SetPrivateData(RtaProtocolStack *stack, RtaComponents component, void *private);
 
+/**
+ * Returns the JSON configuration the protocol stack was created with
+ *
+ * This is the `CCNxStackConfig` json, with one key per component name plus the "STACK" key.
+ * The caller must not release the returned value.
+ *
+ * @param [in] stack An allocated protocol stack
+ *
+ * @return non-null The stack configuration
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+PARCJSON *rtaProtocolStack_GetParameters(const RtaProtocolStack *stack);
+
 /**
  * <#One Line Description#>
  *
@@ -338,6 +386,24 @@ PARCEventQueue *rtaProtocolStack_GetPutQueue(RtaProtocolStack *stack,
                                              RtaComponents component,
                                              RtaDirection direction);
 
+/**
+ * Whether a message waits in one of the stack's inter-component queues
+ *
+ * A component reads everything in its queue when the event scheduler runs its callback,
+ * so a message waits only until the next pass of the scheduler.
+ *
+ * @param [in] stack An allocated protocol stack
+ *
+ * @return true At least one message has not been read by its component
+ * @return false Every queue is empty
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+bool rtaProtocolStack_HasQueuedMessages(const RtaProtocolStack *stack);
+
 /**
  * <#One Line Description#>
  *
@@ -375,20 +441,49 @@ PARCJSON *rtaProtocolStack_GetParam(RtaProtocolStack *stack, const char *domain,
 RtaComponentStats *rtaProtocolStack_GetStats(const RtaProtocolStack *stack, RtaComponents type);
 
 /**
- * <#OneLineDescription#>
+ * A structured snapshot of the stack-wide statistics
+ *
+ * The object has "stackId" and "components", which maps each component name in the stack
+ * to its counters (see rtaComponentStats_ToJSON()).  Components with their own stack-wide
+ * counters add an object: "cache" for CACHE and "pit" for PIT.
+ *
+ * Must be called from the Transport thread.
+ *
+ * @param [in] stack The protocol stack
+ *
+ * @return non-null A PARCJSON object the caller must release
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCJSON *json = rtaProtocolStack_GetStatisticsSnapshot(stack);
+ *     parcJSON_Release(&json);
+ * }
+ * @endcode
+ */
+PARCJSON *rtaProtocolStack_GetStatisticsSnapshot(RtaProtocolStack *stack);
+
+/**
+ * A structured snapshot of one connection's statistics
+ *
+ * The object has "connectionId", "apiFd", "messagesInQueue", "messagesInQueueHighWater",
+ * and "components", laid out as in rtaProtocolStack_GetStatisticsSnapshot() but with the
+ * connection's counters.
+ * Flow controllers add "window" and "pacing" objects, and FWD_METIS adds "metis".
  *
- *   <#Discussion#>
+ * Must be called from the Transport thread.
  *
- * @param stack
- * @param file
- * @return <#return#>
+ * @param [in] stack The protocol stack of the connection
+ * @param [in] connection The connection
+ *
+ * @return non-null A PARCJSON object the caller must release
  *
  * Example:
  * @code
  * <#example#>
  * @endcode
  */
-PARCArrayList *rtaProtocolStack_GetStatistics(const RtaProtocolStack *stack, FILE *file);
+PARCJSON *rtaProtocolStack_GetConnectionStatisticsSnapshot(RtaProtocolStack *stack, struct rta_connection *connection);
 
 /**
  * Look up the symbolic name of the queue.  Do not free the return.
@@ -400,6 +495,88 @@ PARCArrayList *rtaProtocolStack_GetStatistics(const RtaProtocolStack *stack, FIL
  */
 const char *rtaProtocolStack_GetQueueName(RtaProtocolStack *stack, PARCEventQueue *queue);
 
+/**
+ * Look up which component owns a queue and which side of the component it is on
+ *
+ * Each component holds an `up` queue, which it writes to send messages up and reads
+ * for downcalls, and a `down` queue, which it writes to send messages down and reads
+ * for upcalls.  Only the components configured in the stack are searched.
+ *
+ * @param [in] stack The protocol stack
+ * @param [in] queue The queue as used by a component
+ * @param [out] component The owning component
+ * @param [out] side RTA_UP for the component's `up` queue, RTA_DOWN for its `down` queue
+ *
+ * @return true The queue was found and the outputs are set
+ * @return false The queue is not a component queue of this stack
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+bool rtaProtocolStack_GetQueueOwner(const RtaProtocolStack *stack, PARCEventQueue *queue, RtaComponents *component, RtaDirection *side);
+
+/**
+ * Look up which component wrote the messages read from a queue, and in which direction
+ *
+ * A component reads its `up` queue for messages the component above it sent down, and
+ * its `down` queue for messages the component below it sent up.  This returns that
+ * neighbour, so a read can be charged to the same output queue as the matching write
+ * (see rtaComponentStats_QueueGet()).
+ *
+ * @param [in] stack The protocol stack
+ * @param [in] queue The queue as read by a component
+ * @param [out] component The component that wrote into the queue
+ * @param [out] direction The direction it was writing, RTA_UP or RTA_DOWN
+ *
+ * @return true The queue was found and the outputs are set
+ * @return false The queue is not a component queue of this stack, or no component writes into it
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+bool rtaProtocolStack_GetQueueWriter(const RtaProtocolStack *stack, PARCEventQueue *queue, RtaComponents *component, RtaDirection *direction);
+
+/**
+ * @typedef RtaQueueEnds
+ * @abstract Both ends of a queue, see rtaProtocolStack_GetQueueEnds()
+ * @constant owner The owning component, as rtaProtocolStack_GetQueueOwner()
+ * @constant side The side of the owner, as rtaProtocolStack_GetQueueOwner()
+ * @constant hasWriter false if no component writes into the queue, then writer and direction are not set
+ * @constant writer The component writing into the queue, as rtaProtocolStack_GetQueueWriter()
+ * @constant direction The direction the writer writes, as rtaProtocolStack_GetQueueWriter()
+ */
+typedef struct rta_queue_ends {
+    RtaComponents owner;
+    RtaDirection side;
+    bool hasWriter;
+    RtaComponents writer;
+    RtaDirection direction;
+} RtaQueueEnds;
+
+/**
+ * Look up the owner and the writer of a queue with one search of the stack
+ *
+ * The same as rtaProtocolStack_GetQueueOwner() and rtaProtocolStack_GetQueueWriter()
+ * together, for the framework's per-message accounting.
+ *
+ * @param [in] stack The protocol stack
+ * @param [in] queue The queue as read by a component
+ * @param [out] ends The owner, and the writer if there is one
+ *
+ * @return true The queue was found and `ends` is set
+ * @return false The queue is not a component queue of this stack
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+bool rtaProtocolStack_GetQueueEnds(const RtaProtocolStack *stack, PARCEventQueue *queue, RtaQueueEnds *ends);
+
 /**
  * A state event occured on the given connection, let all the components know.
  *
@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ *
+ * The messages go on an RtaMpscRing, this adds the wake-up, flow-control and writable state.
+ *
+ * The writable signal is edge triggered: a refused rtaSendQueue_TryPut() arms it, and the
+ * consumer disarms and calls it the next time it finds the queue unblocked with room.
+ */
+#include <config.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <string.h>
+
+#include <LongBow/runtime.h>
+#include <parc/algol/parc_Memory.h>
+
+#include <ccnx/transport/transport_rta/core/rta_MpscRing.h>
+#include <ccnx/transport/transport_rta/core/rta_SendQueue.h>
+
+struct rta_send_queue {
+    RtaMpscRing ring;
+
+    // Set by the first producer after the consumer clears it, see rtaSendQueue_Notify()
+    bool notified __attribute__ ((aligned(RTA_CACHE_LINE_SIZE)));
+
+    // Set by a refused rtaSendQueue_TryPut(), cleared when the consumer calls the writable signal
+    bool wantWritable;
+
+    // Only the consumer writes it
+    bool blocked __attribute__ ((aligned(RTA_CACHE_LINE_SIZE)));
+
+    // Protected by ring.lock
+    RtaSendQueueSignal *writableSignal;
+    void *writableArg;
+
+    unsigned refcount;
+} __attribute__ ((aligned(RTA_CACHE_LINE_SIZE)));
+
+/*
+ * On the consumer's thread, after it made room or unblocked the queue.  Calls the writable
+ * signal if a refused producer armed it.
+ */
+static void
+_rtaSendQueue_SignalWritable(RtaSendQueue *queue)
+{
+    if (!__atomic_load_n(&queue->wantWritable, __ATOMIC_RELAXED) || queue->blocked) {
+        return;
+    }
+    if (rtaMpscRing_Count(&queue->ring) >= rtaMpscRing_Capacity(&queue->ring)) {
+        return;
+    }
+
+    pthread_mutex_lock(&queue->ring.lock);
+    if (__atomic_exchange_n(&queue->wantWritable, false, __ATOMIC_SEQ_CST) && queue->writableSignal != NULL) {
+        queue->writableSignal(queue->writableArg);
+    }
+    pthread_mutex_unlock(&queue->ring.lock);
+}
+
+RtaSendQueue *
+rtaSendQueue_Create(size_t capacity)
+{
+    assertTrue(capacity > 0, "Parameter capacity must be positive");
+
+    void *memory = NULL;
+    int failure = parcMemory_MemAlign(&memory, RTA_CACHE_LINE_SIZE, sizeof(RtaSendQueue));
+    assertFalse(failure, "parcMemory_MemAlign(%d, %zu) failed", RTA_CACHE_LINE_SIZE, sizeof(RtaSendQueue));
+
+    RtaSendQueue *queue = memory;
+    memset(queue, 0, sizeof(RtaSendQueue));
+
+    rtaMpscRing_Init(&queue->ring, capacity);
+    queue->refcount = 1;
+
+    return queue;
+}
+
+RtaSendQueue *
+rtaSendQueue_Acquire(const RtaSendQueue *queue)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+    RtaSendQueue *result = (RtaSendQueue *) queue;
+    __atomic_add_fetch(&result->refcount, 1, __ATOMIC_RELAXED);
+    return result;
+}
+
+void
+rtaSendQueue_Release(RtaSendQueue **queuePtr)
+{
+    assertNotNull(queuePtr, "Parameter queuePtr must be non-null");
+    RtaSendQueue *queue = *queuePtr;
+    assertNotNull(queue, "Parameter queuePtr must dereference to non-null");
+
+    if (__atomic_sub_fetch(&queue->refcount, 1, __ATOMIC_ACQ_REL) == 0) {
+        CCNxMetaMessage *message;
+        while ((message = rtaSendQueue_Get(queue)) != NULL) {
+            ccnxMetaMessage_Release(&message);
+        }
+
+        rtaMpscRing_Fini(&queue->ring);
+        parcMemory_Deallocate((void **) &queue);
+    }
+    *queuePtr = NULL;
+}
+
+size_t
+rtaSendQueue_Capacity(const RtaSendQueue *queue)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+    return rtaMpscRing_Capacity(&queue->ring);
+}
+
+size_t
+rtaSendQueue_Count(const RtaSendQueue *queue)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+    return rtaMpscRing_Count(&queue->ring);
+}
+
+bool
+rtaSendQueue_Put(RtaSendQueue *queue, CCNxMetaMessage *message, const uint64_t *microSeconds)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+    assertNotNull(message, "Parameter message must be non-null");
+    return rtaMpscRing_Put(&queue->ring, message, microSeconds);
+}
+
+bool
+rtaSendQueue_TryPut(RtaSendQueue *queue, CCNxMetaMessage *message)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+    assertNotNull(message, "Parameter message must be non-null");
+
+    if (rtaMpscRing_IsClosed(&queue->ring)) {
+        errno = EPIPE;
+        return false;
+    }
+
+    if (!__atomic_load_n(&queue->blocked, __ATOMIC_ACQUIRE) && rtaMpscRing_TryPut(&queue->ring, message)) {
+        return true;
+    }
+
+    // Arm the signal, then look again: either we see the consumer's unblock or free slot,
+    // or the consumer sees the armed signal, see _rtaSendQueue_SignalWritable()
+    __atomic_store_n(&queue->wantWritable, true, __ATOMIC_SEQ_CST);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (!__atomic_load_n(&queue->blocked, __ATOMIC_SEQ_CST) && rtaMpscRing_TryPut(&queue->ring, message)) {
+        return true;
+    }
+
+    errno = EWOULDBLOCK;
+    return false;
+}
+
+CCNxMetaMessage *
+rtaSendQueue_Get(RtaSendQueue *queue)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+
+    CCNxMetaMessage *message = rtaMpscRing_Get(&queue->ring);
+    if (message != NULL) {
+        _rtaSendQueue_SignalWritable(queue);
+    }
+    return message;
+}
+
+bool
+rtaSendQueue_Notify(RtaSendQueue *queue)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+
+    // Ordered after the put, so the consumer either sees the message after it clears the
+    // mark, or clears it before we set it and we wake it again
+    return !__atomic_exchange_n(&queue->notified, true, __ATOMIC_SEQ_CST);
+}
+
+void
+rtaSendQueue_ClearNotify(RtaSendQueue *queue)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+    __atomic_store_n(&queue->notified, false, __ATOMIC_SEQ_CST);
+}
+
+void
+rtaSendQueue_SetBlocked(RtaSendQueue *queue, bool blocked)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+
+    // Pairs with the arming in rtaSendQueue_TryPut
+    __atomic_store_n(&queue->blocked, blocked, __ATOMIC_SEQ_CST);
+    if (!blocked) {
+        _rtaSendQueue_SignalWritable(queue);
+    }
+}
+
+bool
+rtaSendQueue_IsBlocked(const RtaSendQueue *queue)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+    return __atomic_load_n(&queue->blocked, __ATOMIC_ACQUIRE);
+}
+
+void
+rtaSendQueue_SetWritableSignal(RtaSendQueue *queue, RtaSendQueueSignal *signal, void *arg)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+
+    pthread_mutex_lock(&queue->ring.lock);
+    if (!queue->ring.closed) {
+        queue->writableSignal = signal;
+        queue->writableArg = arg;
+    }
+    pthread_mutex_unlock(&queue->ring.lock);
+}
+
+void
+rtaSendQueue_Close(RtaSendQueue *queue)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+
+    // Closed first, so rtaSendQueue_SetWritableSignal() cannot set a signal after we clear it
+    rtaMpscRing_Close(&queue->ring);
+
+    pthread_mutex_lock(&queue->ring.lock);
+    queue->writableSignal = NULL;
+    queue->writableArg = NULL;
+    pthread_mutex_unlock(&queue->ring.lock);
+}
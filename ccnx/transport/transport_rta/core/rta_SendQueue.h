@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file rta_SendQueue.h
+ * @brief The queue of messages from application threads down to a connection
+ *
+ * Any number of application threads may call rtaTransport_Send() on the same connection.
+ * Each puts its CCNxMetaMessage on the connection's RtaSendQueue, a bounded multi-producer,
+ * single-consumer queue, and the API connector takes them off on the framework thread.
+ * Messages from one thread come off in the order that thread put them.  Producers only
+ * contend on one compare-and-swap, not on a socket write.
+ *
+ * The consumer is woken through the connection's socket pair, but only once per batch:
+ * after a put, the producer calls rtaSendQueue_Notify(), and only the first producer since
+ * the consumer's last rtaSendQueue_ClearNotify() writes the wake-up to the socket.
+ *
+ * The consumer also publishes whether the stack is holding the connection back (flow
+ * control, see rtaSendQueue_SetBlocked()).  rtaSendQueue_TryPut() refuses a message while
+ * it is, and a producer it refused gets one call of the writable signal once the
+ * connection takes messages again.
+ *
+ * The queue is reference counted, so the Transport and the connection in the framework
+ * can each hold it.
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef Libccnx_rta_SendQueue_h
+#define Libccnx_rta_SendQueue_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ccnx/transport/common/transport_MetaMessage.h>
+
+struct rta_send_queue;
+typedef struct rta_send_queue RtaSendQueue;
+
+/**
+ * Called on the consumer's thread when the queue becomes writable, see rtaSendQueue_SetWritableSignal()
+ */
+typedef void (RtaSendQueueSignal)(void *arg);
+
+/**
+ * @def RTA_SEND_QUEUE_DEFAULT_CAPACITY
+ * The capacity of a connection's send queue, about what the socket pair used to buffer.
+ * A connection may set its own with the API connector's "sendQueueDepth" (see config_ApiConnector.h).
+ */
+#define RTA_SEND_QUEUE_DEFAULT_CAPACITY 128
+
+/**
+ * Create an empty queue with a reference count of 1
+ *
+ * @param [in] capacity The number of messages the queue holds, rounded up to a power of 2
+ *
+ * @return non-null An allocated queue
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaSendQueue *queue = rtaSendQueue_Create(RTA_SEND_QUEUE_DEFAULT_CAPACITY);
+ *     rtaSendQueue_Release(&queue);
+ * }
+ * @endcode
+ */
+RtaSendQueue *rtaSendQueue_Create(size_t capacity);
+
+/**
+ * Increase the number of references to the queue
+ *
+ * @param [in] queue The queue
+ *
+ * @return non-null A reference to `queue`
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+RtaSendQueue *rtaSendQueue_Acquire(const RtaSendQueue *queue);
+
+/**
+ * Release a reference to the queue.  The last release releases the messages still on it.
+ *
+ * @param [in,out] queuePtr The reference to release, will be NULL'd
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaSendQueue_Release(RtaSendQueue **queuePtr);
+
+/**
+ * The number of messages the queue holds
+ *
+ * @param [in] queue The queue
+ *
+ * @return number A power of 2
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+size_t rtaSendQueue_Capacity(const RtaSendQueue *queue);
+
+/**
+ * The number of messages on the queue
+ *
+ * Only a snapshot while producers are putting.
+ *
+ * @param [in] queue The queue
+ *
+ * @return number The messages waiting for the consumer
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+size_t rtaSendQueue_Count(const RtaSendQueue *queue);
+
+/**
+ * Append a message to the queue, taking ownership of the caller's reference on success
+ *
+ * May be called from any number of threads.  If the queue is full, waits up to `microSeconds`
+ * for the consumer to make room.
+ *
+ * @param [in] queue The queue
+ * @param [in] message The message for the connection
+ * @param [in] microSeconds NULL to wait as long as it takes, otherwise the longest wait (0 does not wait)
+ *
+ * @return true The message is on the queue
+ * @return false The queue stayed full (errno EWOULDBLOCK) or was closed (errno EPIPE), the caller keeps its reference
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxMetaMessage *reference = ccnxMetaMessage_Acquire(message);
+ *     if (rtaSendQueue_Put(queue, reference, CCNxStackTimeout_Immediate)) {
+ *         if (rtaSendQueue_Notify(queue)) {
+ *             // wake the consumer
+ *         }
+ *     } else {
+ *         ccnxMetaMessage_Release(&reference);
+ *     }
+ * }
+ * @endcode
+ */
+bool rtaSendQueue_Put(RtaSendQueue *queue, CCNxMetaMessage *message, const uint64_t *microSeconds);
+
+/**
+ * Append a message to the queue if the connection is writable, without waiting
+ *
+ * Unlike rtaSendQueue_Put(), this also refuses the message while the consumer has the
+ * queue blocked.  A refusal arms the writable signal: it is called once the queue is
+ * unblocked and has room.  The signal may also follow a TryPut that raced with the
+ * consumer and succeeded after all, so treat it as a hint to try again.
+ *
+ * @param [in] queue The queue
+ * @param [in] message The message for the connection
+ *
+ * @return true The message is on the queue, the queue owns the caller's reference
+ * @return false The queue is blocked or full (errno EWOULDBLOCK) or closed (errno EPIPE), the caller keeps its reference
+ *
+ * Example:
+ * @code
+ * {
+ *     if (!rtaSendQueue_TryPut(queue, reference) && errno == EWOULDBLOCK) {
+ *         // wait for the writable signal
+ *     }
+ * }
+ * @endcode
+ */
+bool rtaSendQueue_TryPut(RtaSendQueue *queue, CCNxMetaMessage *message);
+
+/**
+ * Remove the oldest message from the queue
+ *
+ * Only the consumer may call this.
+ *
+ * @param [in] queue The queue
+ *
+ * @return non-null The message, the caller owns the reference
+ * @return null The queue is empty
+ *
+ * Example:
+ * @code
+ * {
+ *     rtaSendQueue_ClearNotify(queue);
+ *     CCNxMetaMessage *message;
+ *     while ((message = rtaSendQueue_Get(queue)) != NULL) {
+ *         ccnxMetaMessage_Release(&message);
+ *     }
+ * }
+ * @endcode
+ */
+CCNxMetaMessage *rtaSendQueue_Get(RtaSendQueue *queue);
+
+/**
+ * Mark the queue as having messages for the consumer
+ *
+ * A producer calls this after a successful put.
+ *
+ * @param [in] queue The queue
+ *
+ * @return true The queue was not marked, the caller must wake the consumer
+ * @return false A wake-up is already on its way
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+bool rtaSendQueue_Notify(RtaSendQueue *queue);
+
+/**
+ * Clear the mark set by rtaSendQueue_Notify()
+ *
+ * The consumer calls this before it takes messages off the queue, so a put that it
+ * does not see is followed by a new wake-up.
+ *
+ * @param [in] queue The queue
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaSendQueue_ClearNotify(RtaSendQueue *queue);
+
+/**
+ * Publish whether the consumer is taking messages off the queue
+ *
+ * The consumer sets it while the stack below has the connection blocked, and clears it
+ * when the stack unblocks.  Clearing it calls the writable signal if a producer is waiting
+ * for it and the queue has room.
+ *
+ * @param [in] queue The queue
+ * @param [in] blocked true if the consumer stops taking messages
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaSendQueue_SetBlocked(RtaSendQueue *queue, bool blocked);
+
+/**
+ * Whether the consumer has the queue blocked
+ *
+ * @param [in] queue The queue
+ *
+ * @return true The stack is holding the connection back
+ * @return false The consumer takes messages as they come
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+bool rtaSendQueue_IsBlocked(const RtaSendQueue *queue);
+
+/**
+ * Set the function called when a refused rtaSendQueue_TryPut() may succeed
+ *
+ * The signal runs on the consumer's thread with the queue's lock held, so it must be quick
+ * and must not put on or close this queue.  Writing to an eventfd or signalling a condition
+ * variable is the intended use.  rtaSendQueue_Close() removes it, and it cannot be set
+ * on a closed queue.
+ *
+ * @param [in] queue The queue
+ * @param [in] signal The function to call, or NULL for none
+ * @param [in] arg Passed to `signal`
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaSendQueue_SetWritableSignal(RtaSendQueue *queue, RtaSendQueueSignal *signal, void *arg);
+
+/**
+ * Refuse further puts and wake the producers waiting for room
+ *
+ * The Transport calls this when the application closes the connection.  Messages
+ * already on the queue stay there until the last release.  The writable signal is removed,
+ * and is not running once this returns.
+ *
+ * @param [in] queue The queue
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaSendQueue_Close(RtaSendQueue *queue);
+#endif // Libccnx_rta_SendQueue_h
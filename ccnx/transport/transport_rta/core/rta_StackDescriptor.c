@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include <stdio.h>
+#include <strings.h>
+
+#include <LongBow/runtime.h>
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Object.h>
+#include <parc/algol/parc_ArrayList.h>
+
+#include <ccnx/transport/transport_rta/core/rta_StackDescriptor.h>
+#include <ccnx/transport/transport_rta/config/config_ProtocolStack.h>
+
+struct rta_stack_descriptor {
+    CCNxStackConfig *config;
+    PARCHashCode hash;
+
+    size_t componentCount;
+    RtaComponents *components;
+};
+
+static void
+_rtaStackDescriptor_Destroy(RtaStackDescriptor **descriptorPtr)
+{
+    RtaStackDescriptor *descriptor = *descriptorPtr;
+
+    ccnxStackConfig_Release(&descriptor->config);
+    if (descriptor->components != NULL) {
+        parcMemory_Deallocate((void **) &descriptor->components);
+    }
+}
+
+parcObject_ExtendPARCObject(RtaStackDescriptor, _rtaStackDescriptor_Destroy, NULL, NULL, NULL, NULL, NULL, NULL);
+
+parcObject_ImplementAcquire(rtaStackDescriptor, RtaStackDescriptor);
+
+parcObject_ImplementRelease(rtaStackDescriptor, RtaStackDescriptor);
+
+RtaComponents
+rtaStackDescriptor_ComponentFromName(const char *name)
+{
+    if (name == NULL) {
+        return UNKNOWN_COMPONENT;
+    }
+
+    for (int i = 0; i < LAST_COMPONENT; i++) {
+        if (RtaComponentNames[i] != NULL) {
+            if (strncasecmp(RtaComponentNames[i], name, 16) == 0) {
+                return (RtaComponents) i;
+            }
+        }
+    }
+    return UNKNOWN_COMPONENT;
+}
+
+RtaStackDescriptor *
+rtaStackDescriptor_Create(const CCNxStackConfig *config)
+{
+    assertNotNull(config, "Parameter config must be non-null");
+
+    RtaStackDescriptor *descriptor = parcObject_CreateInstance(RtaStackDescriptor);
+    assertNotNull(descriptor, "parcObject_CreateInstance returned NULL");
+
+    descriptor->config = ccnxStackConfig_Copy(config);
+    descriptor->hash = ccnxStackConfig_HashCode(descriptor->config);
+
+    descriptor->componentCount = 0;
+    descriptor->components = NULL;
+
+    // A configuration without a PROTOCOL_STACK entry compiles to no components
+    PARCJSON *json = ccnxStackConfig_GetJson(descriptor->config);
+    if (parcJSON_GetValueByName(json, protocolStack_GetName()) != NULL) {
+        PARCArrayList *componentNameList = protocolStack_GetComponentNameArray(json);
+        descriptor->componentCount = parcArrayList_Size(componentNameList);
+
+        if (descriptor->componentCount > 0) {
+            descriptor->components = parcMemory_Allocate(descriptor->componentCount * sizeof(RtaComponents));
+            assertNotNull(descriptor->components, "parcMemory_Allocate(%zu) returned NULL",
+                          descriptor->componentCount * sizeof(RtaComponents));
+
+            for (size_t i = 0; i < descriptor->componentCount; i++) {
+                descriptor->components[i] = rtaStackDescriptor_ComponentFromName(parcArrayList_Get(componentNameList, i));
+            }
+        }
+        parcArrayList_Destroy(&componentNameList);
+    }
+
+    return descriptor;
+}
+
+PARCHashCode
+rtaStackDescriptor_GetHash(const RtaStackDescriptor *descriptor)
+{
+    assertNotNull(descriptor, "Parameter descriptor must be non-null");
+    return descriptor->hash;
+}
+
+CCNxStackConfig *
+rtaStackDescriptor_GetStackConfig(const RtaStackDescriptor *descriptor)
+{
+    assertNotNull(descriptor, "Parameter descriptor must be non-null");
+    return descriptor->config;
+}
+
+size_t
+rtaStackDescriptor_GetComponentCount(const RtaStackDescriptor *descriptor)
+{
+    assertNotNull(descriptor, "Parameter descriptor must be non-null");
+    return descriptor->componentCount;
+}
+
+RtaComponents
+rtaStackDescriptor_GetComponent(const RtaStackDescriptor *descriptor, size_t index)
+{
+    assertNotNull(descriptor, "Parameter descriptor must be non-null");
+    assertTrue(index < descriptor->componentCount, "Parameter index %zu out of range, count %zu", index, descriptor->componentCount);
+    return descriptor->components[index];
+}
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file rta_StackDescriptor.h
+ * @brief A protocol stack configuration compiled once into an immutable form
+ *
+ * The descriptor holds a private copy of a CCNxStackConfig, its hash, and the stack's
+ * components parsed from the PROTOCOL_STACK names into RtaComponents.  It never changes
+ * after rtaStackDescriptor_Create(), so the Transport and Framework threads share one
+ * instance without locks: the Transport keys its stack table on the hash, and the
+ * Framework configures the stack from the component list without reading the JSON.
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef Libccnx_rta_StackDescriptor_h
+#define Libccnx_rta_StackDescriptor_h
+
+#include <stddef.h>
+
+#include <parc/algol/parc_HashCode.h>
+
+#include <ccnx/transport/common/ccnx_StackConfig.h>
+#include <ccnx/transport/transport_rta/core/components.h>
+
+struct rta_stack_descriptor;
+typedef struct rta_stack_descriptor RtaStackDescriptor;
+
+/**
+ * Compile a stack configuration
+ *
+ * The configuration is copied, so later changes to `config` do not affect the descriptor.
+ * A name that is not in RtaComponentNames compiles to UNKNOWN_COMPONENT, and a configuration
+ * without a PROTOCOL_STACK entry compiles to no components.
+ *
+ * @param [in] config A stack configuration
+ *
+ * @return non-null An allocated descriptor with a reference count of 1
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxStackConfig *config = ccnxStackConfig_Create();
+ *     protocolStack_ComponentsConfigArgs(config, apiConnector_GetName(), testingLower_GetName(), NULL);
+ *
+ *     RtaStackDescriptor *descriptor = rtaStackDescriptor_Create(config);
+ *     ccnxStackConfig_Release(&config);
+ *
+ *     rtaStackDescriptor_Release(&descriptor);
+ * }
+ * @endcode
+ */
+RtaStackDescriptor *rtaStackDescriptor_Create(const CCNxStackConfig *config);
+
+/**
+ * Increase the number of references to the descriptor.  Safe from any thread.
+ *
+ * @param [in] descriptor The descriptor
+ *
+ * @return non-null A reference to `descriptor`
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+RtaStackDescriptor *rtaStackDescriptor_Acquire(const RtaStackDescriptor *descriptor);
+
+/**
+ * Release a reference to the descriptor, destroying it with the last reference
+ *
+ * @param [in,out] descriptorPtr The descriptor, set to NULL
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaStackDescriptor_Release(RtaStackDescriptor **descriptorPtr);
+
+/**
+ * The hash of the configuration, the same as ccnxStackConfig_HashCode() of the original
+ *
+ * @param [in] descriptor The descriptor
+ *
+ * @return The hash computed when the descriptor was created
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+PARCHashCode rtaStackDescriptor_GetHash(const RtaStackDescriptor *descriptor);
+
+/**
+ * The descriptor's copy of the configuration
+ *
+ * The caller must not modify it.  Acquire it to keep it after the descriptor is released.
+ *
+ * @param [in] descriptor The descriptor
+ *
+ * @return non-null The configuration
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+CCNxStackConfig *rtaStackDescriptor_GetStackConfig(const RtaStackDescriptor *descriptor);
+
+/**
+ * The number of components in the stack
+ *
+ * @param [in] descriptor The descriptor
+ *
+ * @return The length of the PROTOCOL_STACK component list
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+size_t rtaStackDescriptor_GetComponentCount(const RtaStackDescriptor *descriptor);
+
+/**
+ * A component of the stack, in the order of the PROTOCOL_STACK list, from the API down
+ *
+ * @param [in] descriptor The descriptor
+ * @param [in] index Less than rtaStackDescriptor_GetComponentCount()
+ *
+ * @return The component type, UNKNOWN_COMPONENT if the name was not recognized
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+RtaComponents rtaStackDescriptor_GetComponent(const RtaStackDescriptor *descriptor, size_t index);
+
+/**
+ * Looks up a component name in RtaComponentNames, ignoring case
+ *
+ * @param [in] name A component name, may be NULL
+ *
+ * @return The component type, UNKNOWN_COMPONENT if `name` is NULL or not recognized
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaComponents type = rtaStackDescriptor_ComponentFromName("FC_VEGAS");
+ * }
+ * @endcode
+ */
+RtaComponents rtaStackDescriptor_ComponentFromName(const char *name);
+#endif // Libccnx_rta_StackDescriptor_h
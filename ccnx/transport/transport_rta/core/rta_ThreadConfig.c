@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <config.h>
+#include <ctype.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+#include <LongBow/runtime.h>
+
+#include <ccnx/transport/transport_rta/core/rta_ThreadConfig.h>
+
+// from <numaif.h>, which is only installed with libnuma
+#ifndef MPOL_PREFERRED
+#define MPOL_PREFERRED 1
+#endif
+
+void
+rtaThreadConfig_Init(RtaThreadConfig *config)
+{
+    assertNotNull(config, "Parameter config must be non-null");
+    memset(config, 0, sizeof(RtaThreadConfig));
+    config->policy = RtaThreadPolicy_Default;
+    config->numaNode = -1;
+}
+
+void
+rtaThreadConfig_AddCpu(RtaThreadConfig *config, int cpu)
+{
+    assertNotNull(config, "Parameter config must be non-null");
+    assertTrue(cpu >= 0 && cpu < RTA_THREAD_CONFIG_MAX_CPUS, "Parameter cpu out of range, got %d", cpu);
+    config->cpus[cpu / 64] |= UINT64_C(1) << (cpu % 64);
+}
+
+bool
+rtaThreadConfig_HasCpu(const RtaThreadConfig *config, int cpu)
+{
+    assertNotNull(config, "Parameter config must be non-null");
+    if (cpu < 0 || cpu >= RTA_THREAD_CONFIG_MAX_CPUS) {
+        return false;
+    }
+    return (config->cpus[cpu / 64] & (UINT64_C(1) << (cpu % 64))) != 0;
+}
+
+unsigned
+rtaThreadConfig_CpuCount(const RtaThreadConfig *config)
+{
+    assertNotNull(config, "Parameter config must be non-null");
+    unsigned count = 0;
+    for (size_t i = 0; i < sizeof(config->cpus) / sizeof(config->cpus[0]); i++) {
+        count += (unsigned) __builtin_popcountll(config->cpus[i]);
+    }
+    return count;
+}
+
+/*
+ * Parses a CPU number at *cursor, advancing it.  Returns -1 if there is no number or it is out of range.
+ */
+static int
+_rtaThreadConfig_ParseCpu(const char **cursor)
+{
+    if (!isdigit((unsigned char) **cursor)) {
+        return -1;
+    }
+
+    char *end;
+    unsigned long value = strtoul(*cursor, &end, 10);
+    *cursor = end;
+    if (value >= RTA_THREAD_CONFIG_MAX_CPUS) {
+        return -1;
+    }
+    return (int) value;
+}
+
+bool
+rtaThreadConfig_ParseCpuList(RtaThreadConfig *config, const char *list)
+{
+    assertNotNull(config, "Parameter config must be non-null");
+    assertNotNull(list, "Parameter list must be non-null");
+
+    // parse into a copy, so a bad list leaves config alone
+    RtaThreadConfig parsed = *config;
+
+    const char *cursor = list;
+    do {
+        int first = _rtaThreadConfig_ParseCpu(&cursor);
+        if (first < 0) {
+            return false;
+        }
+
+        int last = first;
+        if (*cursor == '-') {
+            cursor++;
+            last = _rtaThreadConfig_ParseCpu(&cursor);
+            if (last < first) {
+                return false;
+            }
+        }
+
+        for (int cpu = first; cpu <= last; cpu++) {
+            rtaThreadConfig_AddCpu(&parsed, cpu);
+        }
+    } while (*cursor++ == ',');
+
+    // the loop stops on the first character that is not a comma, which must be the end
+    // (the files in /sys end with a newline)
+    cursor--;
+    if (*cursor != '\0' && !(cursor[0] == '\n' && cursor[1] == '\0')) {
+        return false;
+    }
+
+    *config = parsed;
+    return true;
+}
+
+static const struct {
+    RtaThreadPolicy policy;
+    const char *name;
+} _rtaThreadPolicyNames[] = {
+    { RtaThreadPolicy_Default,    "other" },
+    { RtaThreadPolicy_Fifo,       "fifo"  },
+    { RtaThreadPolicy_RoundRobin, "rr"    },
+};
+
+bool
+rtaThreadConfig_ParsePolicy(const char *string, RtaThreadPolicy *output)
+{
+    assertNotNull(string, "Parameter string must be non-null");
+    assertNotNull(output, "Parameter output must be non-null");
+
+    for (size_t i = 0; i < sizeof(_rtaThreadPolicyNames) / sizeof(_rtaThreadPolicyNames[0]); i++) {
+        if (strcasecmp(string, _rtaThreadPolicyNames[i].name) == 0) {
+            *output = _rtaThreadPolicyNames[i].policy;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char *
+rtaThreadConfig_PolicyString(RtaThreadPolicy policy)
+{
+    for (size_t i = 0; i < sizeof(_rtaThreadPolicyNames) / sizeof(_rtaThreadPolicyNames[0]); i++) {
+        if (_rtaThreadPolicyNames[i].policy == policy) {
+            return _rtaThreadPolicyNames[i].name;
+        }
+    }
+    return "unknown";
+}
+
+#if defined(__linux__)
+/*
+ * Reads the CPUs of a NUMA node from /sys
+ */
+static bool
+_rtaThreadConfig_AddNodeCpus(RtaThreadConfig *config, int node)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        return false;
+    }
+
+    char list[1024];
+    bool success = (fgets(list, sizeof(list), file) != NULL) && rtaThreadConfig_ParseCpuList(config, list);
+    fclose(file);
+    return success;
+}
+
+static int
+_rtaThreadConfig_ApplyNumaNode(int node)
+{
+#if defined(SYS_set_mempolicy)
+    const size_t bitsPerWord = 8 * sizeof(unsigned long);
+    unsigned long mask[RTA_THREAD_CONFIG_MAX_CPUS / (8 * sizeof(unsigned long))];
+    if ((size_t) node >= sizeof(mask) * 8) {
+        return EINVAL;
+    }
+    memset(mask, 0, sizeof(mask));
+    mask[node / bitsPerWord] |= 1UL << (node % bitsPerWord);
+
+    if (syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask, sizeof(mask) * 8 + 1) != 0) {
+        return errno;
+    }
+    return 0;
+#else
+    return ENOSYS;
+#endif
+}
+
+static int
+_rtaThreadConfig_ApplyCpus(const RtaThreadConfig *config)
+{
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    for (int cpu = 0; cpu < RTA_THREAD_CONFIG_MAX_CPUS && cpu < CPU_SETSIZE; cpu++) {
+        if (rtaThreadConfig_HasCpu(config, cpu)) {
+            CPU_SET(cpu, &cpuset);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+}
+#endif
+
+static int
+_rtaThreadConfig_ApplyPolicy(const RtaThreadConfig *config)
+{
+    int policy = (config->policy == RtaThreadPolicy_Fifo) ? SCHED_FIFO : SCHED_RR;
+    if (config->priority < sched_get_priority_min(policy) || config->priority > sched_get_priority_max(policy)) {
+        return EINVAL;
+    }
+
+    struct sched_param param = { .sched_priority = config->priority };
+    return pthread_setschedparam(pthread_self(), policy, &param);
+}
+
+int
+rtaThreadConfig_Apply(const RtaThreadConfig *config)
+{
+    assertNotNull(config, "Parameter config must be non-null");
+
+    int firstError = 0;
+
+#if defined(__linux__)
+    RtaThreadConfig placement = *config;
+
+    if (config->numaNode >= 0) {
+        int error = _rtaThreadConfig_ApplyNumaNode(config->numaNode);
+        if (error && !firstError) {
+            firstError = error;
+        }
+
+        // Without explicit CPUs, run where the memory is
+        if (rtaThreadConfig_CpuCount(&placement) == 0 && !_rtaThreadConfig_AddNodeCpus(&placement, config->numaNode)) {
+            if (!firstError) {
+                firstError = ENOENT;
+            }
+        }
+    }
+
+    if (rtaThreadConfig_CpuCount(&placement) > 0) {
+        int error = _rtaThreadConfig_ApplyCpus(&placement);
+        if (error && !firstError) {
+            firstError = error;
+        }
+    }
+#endif
+
+    if (config->policy != RtaThreadPolicy_Default) {
+        int error = _rtaThreadConfig_ApplyPolicy(config);
+        if (error && !firstError) {
+            firstError = error;
+        }
+    }
+
+    return firstError;
+}
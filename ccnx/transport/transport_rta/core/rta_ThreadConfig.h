@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file rta_ThreadConfig.h
+ * @brief CPU set, scheduling policy and NUMA node of the framework thread
+ *
+ * An RtaThreadConfig says where the framework's event thread runs.  The framework applies
+ * it from the thread itself when the thread starts (see rtaFramework_SetThreadConfig()),
+ * before it creates any protocol stacks.
+ *
+ * A NUMA node sets the thread's preferred memory node, so the stacks, connections and
+ * messages the framework allocates come from that node.  If no CPUs are given, the thread
+ * is also pinned to the CPUs of the node.  NUMA placement and CPU pinning are only
+ * supported on Linux.  Elsewhere they are ignored, and only the scheduling policy applies.
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef Libccnx_rta_ThreadConfig_h
+#define Libccnx_rta_ThreadConfig_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// The highest CPU number that can be in an RtaThreadConfig, plus one
+#define RTA_THREAD_CONFIG_MAX_CPUS 1024
+
+typedef enum {
+    RtaThreadPolicy_Default = 0,    // do not change the policy (SCHED_OTHER)
+    RtaThreadPolicy_Fifo = 1,       // SCHED_FIFO, needs a priority and usually privileges
+    RtaThreadPolicy_RoundRobin = 2  // SCHED_RR
+} RtaThreadPolicy;
+
+/**
+ * @typedef RtaThreadConfig
+ * @abstract Placement and scheduling of a thread
+ * @constant cpus A bit per CPU the thread may run on.  No bits set means the thread is not pinned.
+ * @constant policy The scheduling policy
+ * @constant priority The static priority for RtaThreadPolicy_Fifo and RtaThreadPolicy_RoundRobin
+ * @constant numaNode The preferred memory node, or -1 for none
+ */
+typedef struct rta_thread_config {
+    uint64_t cpus[RTA_THREAD_CONFIG_MAX_CPUS / 64];
+    RtaThreadPolicy policy;
+    int priority;
+    int numaNode;
+} RtaThreadConfig;
+
+/**
+ * Initialize a config that changes nothing: no CPUs, the default policy and no NUMA node
+ *
+ * @param [out] config The config to initialize
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaThreadConfig config;
+ *     rtaThreadConfig_Init(&config);
+ *     rtaThreadConfig_AddCpu(&config, 3);
+ *     config.policy = RtaThreadPolicy_Fifo;
+ *     config.priority = 10;
+ * }
+ * @endcode
+ */
+void rtaThreadConfig_Init(RtaThreadConfig *config);
+
+/**
+ * Add a CPU to the set the thread may run on
+ *
+ * @param [in,out] config An initialized config
+ * @param [in] cpu The CPU number, less than RTA_THREAD_CONFIG_MAX_CPUS
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaThreadConfig_AddCpu(RtaThreadConfig *config, int cpu);
+
+/**
+ * Tests if a CPU is in the set
+ *
+ * @param [in] config An initialized config
+ * @param [in] cpu The CPU number
+ *
+ * @return true The CPU is in the set
+ * @return false The CPU is not in the set, or out of range
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+bool rtaThreadConfig_HasCpu(const RtaThreadConfig *config, int cpu);
+
+/**
+ * The number of CPUs in the set
+ *
+ * @param [in] config An initialized config
+ *
+ * @return 0 The thread is not pinned
+ * @return positive The number of CPUs the thread may run on
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+unsigned rtaThreadConfig_CpuCount(const RtaThreadConfig *config);
+
+/**
+ * Add the CPUs of a list in the format of taskset(1) and /sys, e.g. "0,2-5"
+ *
+ * @param [in,out] config An initialized config
+ * @param [in] list Comma separated CPU numbers and inclusive ranges
+ *
+ * @return true The list was valid and its CPUs were added
+ * @return false The list is malformed or has a CPU out of range, `config` is unchanged
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaThreadConfig config;
+ *     rtaThreadConfig_Init(&config);
+ *     bool success = rtaThreadConfig_ParseCpuList(&config, "2-3,6");
+ * }
+ * @endcode
+ */
+bool rtaThreadConfig_ParseCpuList(RtaThreadConfig *config, const char *list);
+
+/**
+ * Parse a policy name: "other", "fifo" or "rr", ignoring case
+ *
+ * @param [in] string The name
+ * @param [out] output The policy
+ *
+ * @return true `output` was set
+ * @return false Unknown name
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+bool rtaThreadConfig_ParsePolicy(const char *string, RtaThreadPolicy *output);
+
+/**
+ * The name of a policy, as accepted by rtaThreadConfig_ParsePolicy()
+ *
+ * @param [in] policy A policy
+ *
+ * @return non-null A static string
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+const char *rtaThreadConfig_PolicyString(RtaThreadPolicy policy);
+
+/**
+ * Apply the config to the calling thread
+ *
+ * The NUMA node is applied first, then the CPU set, then the scheduling policy.  A step
+ * that fails does not stop the others, so a thread without the privilege for SCHED_FIFO
+ * is still pinned.
+ *
+ * @param [in] config An initialized config
+ *
+ * @return 0 Every step succeeded
+ * @return positive The errno of the first step that failed, e.g. EPERM for SCHED_FIFO
+ *         without privileges or EINVAL for a priority outside the policy's range
+ *
+ * Example:
+ * @code
+ * {
+ *     int error = rtaThreadConfig_Apply(&config);
+ *     if (error) {
+ *         fprintf(stderr, "thread config: %s\n", strerror(error));
+ *     }
+ * }
+ * @endcode
+ */
+int rtaThreadConfig_Apply(const RtaThreadConfig *config);
+#endif // Libccnx_rta_ThreadConfig_h
@@ -0,0 +1,443 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * The wheel follows the classic hashed and hierarchical timing wheel design.  A timer
+ * whose expiry is less than 256 ticks past `nextTick` goes in level 0 at slot (expiry & 0xFF).
+ * Otherwise it goes in the lowest level L where it is less than 256^(L+1) ticks out, at
+ * slot ((expiry >> 8L) & 0xFF).  When the low 8L bits of `nextTick` wrap to 0, the current
+ * slot of level L is cascaded, which re-inserts each of its timers at a lower level.
+ *
+ * Every pending timer is on exactly one list: a wheel slot, the ready list, or the running
+ * list.  The `bucket` pointer of the timer says which one, so cancel is a TAILQ_REMOVE.
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include <stdio.h>
+#include <sys/queue.h>
+#include <sys/time.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_EventTimer.h>
+
+#include <ccnx/transport/transport_rta/core/rta_TimerWheel.h>
+
+#define RTA_WHEEL_BITS   8
+#define RTA_WHEEL_SLOTS  (1 << RTA_WHEEL_BITS)
+#define RTA_WHEEL_MASK   (RTA_WHEEL_SLOTS - 1)
+#define RTA_WHEEL_LEVELS 4
+
+// The furthest out a timer may be scheduled.  Longer delays are clamped.
+#define RTA_WHEEL_MAX_DELAY ((UINT64_C(1) << (RTA_WHEEL_BITS * RTA_WHEEL_LEVELS)) - 1)
+
+TAILQ_HEAD(rta_timer_list, rta_timer);
+
+struct rta_timer {
+    RtaTimerWheel *wheel;
+    RtaTimerCallback *callback;
+    void *arg;
+    uint64_t expiry;
+
+    // The list the timer is on, or NULL if the timer is idle
+    struct rta_timer_list *bucket;
+    TAILQ_ENTRY(rta_timer) list;
+};
+
+struct rta_timer_wheel {
+    // The next tick to process.  The current time of the wheel is nextTick - 1.
+    uint64_t nextTick;
+
+    // The number of timers in the slots, and on the ready and running lists
+    size_t slotCount;
+    size_t readyCount;
+
+    // Runs the ready list when a timer is scheduled with zero delay
+    PARCEventTimer *readyEvent;
+    bool readyEventArmed;
+
+    // Expired timers waiting for their callback
+    struct rta_timer_list ready;
+
+    // Timers taken off the ready list for the current pass
+    struct rta_timer_list running;
+
+    struct rta_timer_list slots[RTA_WHEEL_LEVELS][RTA_WHEEL_SLOTS];
+};
+
+static void _rtaTimerWheel_ReadyCallback(int fd, PARCEventType which_event, void *user_data);
+
+// ==========================================================
+
+static bool
+_rtaTimerWheel_IsSlot(const RtaTimerWheel *wheel, const struct rta_timer_list *bucket)
+{
+    return (bucket != &wheel->ready && bucket != &wheel->running);
+}
+
+static void
+_rtaTimerWheel_Link(RtaTimerWheel *wheel, RtaTimer *timer, struct rta_timer_list *bucket)
+{
+    assertNull(timer->bucket, "Timer %p is already on a list", (void *) timer);
+
+    TAILQ_INSERT_TAIL(bucket, timer, list);
+    timer->bucket = bucket;
+
+    if (_rtaTimerWheel_IsSlot(wheel, bucket)) {
+        wheel->slotCount++;
+    } else {
+        wheel->readyCount++;
+    }
+}
+
+static void
+_rtaTimerWheel_Unlink(RtaTimerWheel *wheel, RtaTimer *timer)
+{
+    assertNotNull(timer->bucket, "Timer %p is not on a list", (void *) timer);
+
+    TAILQ_REMOVE(timer->bucket, timer, list);
+
+    if (_rtaTimerWheel_IsSlot(wheel, timer->bucket)) {
+        wheel->slotCount--;
+    } else {
+        wheel->readyCount--;
+    }
+
+    timer->bucket = NULL;
+}
+
+static void
+_rtaTimerWheel_ArmReadyEvent(RtaTimerWheel *wheel)
+{
+    if (!wheel->readyEventArmed) {
+        struct timeval immediateTimeout = { 0, 0 };
+        parcEventTimer_Start(wheel->readyEvent, &immediateTimeout);
+        wheel->readyEventArmed = true;
+    }
+}
+
+/**
+ * Put the timer in the slot for its expiry, or on the ready list if it has already expired.
+ */
+static void
+_rtaTimerWheel_Insert(RtaTimerWheel *wheel, RtaTimer *timer)
+{
+    if (timer->expiry < wheel->nextTick) {
+        _rtaTimerWheel_Link(wheel, timer, &wheel->ready);
+        _rtaTimerWheel_ArmReadyEvent(wheel);
+        return;
+    }
+
+    uint64_t delta = timer->expiry - wheel->nextTick;
+    unsigned level = 0;
+    while (level < RTA_WHEEL_LEVELS - 1 && delta >= (UINT64_C(1) << (RTA_WHEEL_BITS * (level + 1)))) {
+        level++;
+    }
+
+    unsigned index = (unsigned) ((timer->expiry >> (RTA_WHEEL_BITS * level)) & RTA_WHEEL_MASK);
+    _rtaTimerWheel_Link(wheel, timer, &wheel->slots[level][index]);
+}
+
+/**
+ * Called when the lower levels have wrapped.  Re-insert the timers of the current
+ * slot of `level`, which all land in lower levels.  If this level wrapped too, cascade
+ * the next level up.
+ */
+static void
+_rtaTimerWheel_Cascade(RtaTimerWheel *wheel, unsigned level)
+{
+    unsigned index = (unsigned) ((wheel->nextTick >> (RTA_WHEEL_BITS * level)) & RTA_WHEEL_MASK);
+    struct rta_timer_list *slot = &wheel->slots[level][index];
+
+    RtaTimer *timer;
+    while ((timer = TAILQ_FIRST(slot)) != NULL) {
+        _rtaTimerWheel_Unlink(wheel, timer);
+        _rtaTimerWheel_Insert(wheel, timer);
+    }
+
+    if (index == 0 && level + 1 < RTA_WHEEL_LEVELS) {
+        _rtaTimerWheel_Cascade(wheel, level + 1);
+    }
+}
+
+/**
+ * Run the callback of every ready timer.  The ready list is moved to the running list
+ * first, so a timer that reschedules itself with zero delay runs on the next pass
+ * rather than spinning here.
+ */
+static void
+_rtaTimerWheel_RunReady(RtaTimerWheel *wheel)
+{
+    assertTrue(TAILQ_EMPTY(&wheel->running), "Timer wheel %p re-entered its ready list", (void *) wheel);
+
+    RtaTimer *timer;
+    while ((timer = TAILQ_FIRST(&wheel->ready)) != NULL) {
+        _rtaTimerWheel_Unlink(wheel, timer);
+        _rtaTimerWheel_Link(wheel, timer, &wheel->running);
+    }
+
+    // The callback may cancel or destroy other timers on the running list, so always
+    // take the head rather than walking the list.
+    while ((timer = TAILQ_FIRST(&wheel->running)) != NULL) {
+        _rtaTimerWheel_Unlink(wheel, timer);
+        timer->callback(timer, timer->arg);
+    }
+}
+
+static void
+_rtaTimerWheel_ReadyCallback(int fd, PARCEventType which_event, void *user_data)
+{
+    RtaTimerWheel *wheel = (RtaTimerWheel *) user_data;
+    assertTrue(which_event & PARCEventType_Timeout, "%s got unknown event %d", __func__, which_event);
+
+    wheel->readyEventArmed = false;
+    _rtaTimerWheel_RunReady(wheel);
+}
+
+static void
+_rtaTimerWheel_DetachList(RtaTimerWheel *wheel, struct rta_timer_list *list)
+{
+    RtaTimer *timer;
+    while ((timer = TAILQ_FIRST(list)) != NULL) {
+        _rtaTimerWheel_Unlink(wheel, timer);
+    }
+}
+
+// ==========================================================
+
+RtaTimerWheel *
+rtaTimerWheel_Create(PARCEventScheduler *scheduler, uint64_t now)
+{
+    assertNotNull(scheduler, "Parameter scheduler must be non-null");
+
+    RtaTimerWheel *wheel = parcMemory_AllocateAndClear(sizeof(RtaTimerWheel));
+    assertNotNull(wheel, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(RtaTimerWheel));
+
+    wheel->nextTick = now + 1;
+    TAILQ_INIT(&wheel->ready);
+    TAILQ_INIT(&wheel->running);
+    for (int level = 0; level < RTA_WHEEL_LEVELS; level++) {
+        for (int index = 0; index < RTA_WHEEL_SLOTS; index++) {
+            TAILQ_INIT(&wheel->slots[level][index]);
+        }
+    }
+
+    wheel->readyEvent = parcEventTimer_Create(scheduler, 0, _rtaTimerWheel_ReadyCallback, wheel);
+    return wheel;
+}
+
+void
+rtaTimerWheel_Destroy(RtaTimerWheel **wheelPtr)
+{
+    assertNotNull(wheelPtr, "Parameter must be non-null double pointer");
+    assertNotNull(*wheelPtr, "Parameter must dereference to non-null pointer");
+    RtaTimerWheel *wheel = *wheelPtr;
+
+    _rtaTimerWheel_DetachList(wheel, &wheel->ready);
+    _rtaTimerWheel_DetachList(wheel, &wheel->running);
+    for (int level = 0; level < RTA_WHEEL_LEVELS; level++) {
+        for (int index = 0; index < RTA_WHEEL_SLOTS; index++) {
+            _rtaTimerWheel_DetachList(wheel, &wheel->slots[level][index]);
+        }
+    }
+
+    parcEventTimer_Destroy(&wheel->readyEvent);
+    parcMemory_Deallocate((void **) &wheel);
+    *wheelPtr = NULL;
+}
+
+void
+rtaTimerWheel_Advance(RtaTimerWheel *wheel, uint64_t now)
+{
+    assertNotNull(wheel, "Parameter wheel must be non-null");
+
+    while (wheel->nextTick <= now) {
+        if (wheel->slotCount == 0) {
+            // nothing in the slots, so skip straight to now
+            wheel->nextTick = now + 1;
+            break;
+        }
+
+        unsigned index = (unsigned) (wheel->nextTick & RTA_WHEEL_MASK);
+        if (index == 0) {
+            _rtaTimerWheel_Cascade(wheel, 1);
+        }
+
+        struct rta_timer_list *slot = &wheel->slots[0][index];
+        RtaTimer *timer;
+        while ((timer = TAILQ_FIRST(slot)) != NULL) {
+            _rtaTimerWheel_Unlink(wheel, timer);
+            _rtaTimerWheel_Link(wheel, timer, &wheel->ready);
+        }
+
+        wheel->nextTick++;
+    }
+
+    if (!TAILQ_EMPTY(&wheel->ready)) {
+        _rtaTimerWheel_RunReady(wheel);
+    }
+}
+
+uint64_t
+rtaTimerWheel_GetTime(const RtaTimerWheel *wheel)
+{
+    assertNotNull(wheel, "Parameter wheel must be non-null");
+    return wheel->nextTick - 1;
+}
+
+size_t
+rtaTimerWheel_PendingCount(const RtaTimerWheel *wheel)
+{
+    assertNotNull(wheel, "Parameter wheel must be non-null");
+    return wheel->slotCount + wheel->readyCount;
+}
+
+uint64_t
+rtaTimerWheel_NextExpiry(const RtaTimerWheel *wheel)
+{
+    assertNotNull(wheel, "Parameter wheel must be non-null");
+
+    if (wheel->readyCount > 0) {
+        return wheel->nextTick - 1;
+    }
+    if (wheel->slotCount == 0) {
+        return UINT64_MAX;
+    }
+
+    // The next level cascades on this tick
+    uint64_t tick = wheel->nextTick;
+    if ((tick & RTA_WHEEL_MASK) == 0) {
+        return tick;
+    }
+
+    // Walk the lowest level up to where it wraps, which is the next cascade
+    while ((tick & RTA_WHEEL_MASK) != 0 && TAILQ_EMPTY(&wheel->slots[0][tick & RTA_WHEEL_MASK])) {
+        tick++;
+    }
+    return tick;
+}
+
+// ==========================================================
+
+RtaTimer *
+rtaTimer_Create(RtaTimerWheel *wheel, RtaTimerCallback *callback, void *arg)
+{
+    assertNotNull(wheel, "Parameter wheel must be non-null");
+    assertNotNull(callback, "Parameter callback must be non-null");
+
+    RtaTimer *timer = parcMemory_AllocateAndClear(sizeof(RtaTimer));
+    assertNotNull(timer, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(RtaTimer));
+
+    timer->wheel = wheel;
+    timer->callback = callback;
+    timer->arg = arg;
+    timer->bucket = NULL;
+    return timer;
+}
+
+void
+rtaTimer_Destroy(RtaTimer **timerPtr)
+{
+    assertNotNull(timerPtr, "Parameter must be non-null double pointer");
+    assertNotNull(*timerPtr, "Parameter must dereference to non-null pointer");
+    RtaTimer *timer = *timerPtr;
+
+    rtaTimer_Cancel(timer);
+    parcMemory_Deallocate((void **) &timer);
+    *timerPtr = NULL;
+}
+
+void
+rtaTimer_Schedule(RtaTimer *timer, uint64_t delay)
+{
+    assertNotNull(timer, "Parameter timer must be non-null");
+    RtaTimerWheel *wheel = timer->wheel;
+
+    if (timer->bucket != NULL) {
+        _rtaTimerWheel_Unlink(wheel, timer);
+    }
+
+    if (delay > RTA_WHEEL_MAX_DELAY) {
+        delay = RTA_WHEEL_MAX_DELAY;
+    }
+
+    timer->expiry = rtaTimerWheel_GetTime(wheel) + delay;
+    _rtaTimerWheel_Insert(wheel, timer);
+}
+
+void
+rtaTimer_Cancel(RtaTimer *timer)
+{
+    assertNotNull(timer, "Parameter timer must be non-null");
+    if (timer->bucket != NULL) {
+        _rtaTimerWheel_Unlink(timer->wheel, timer);
+    }
+}
+
+bool
+rtaTimer_IsPending(const RtaTimer *timer)
+{
+    assertNotNull(timer, "Parameter timer must be non-null");
+    return (timer->bucket != NULL);
+}
+
+uint64_t
+rtaTimer_GetExpiry(const RtaTimer *timer)
+{
+    assertNotNull(timer, "Parameter timer must be non-null");
+    return timer->expiry;
+}
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file rta_TimerWheel.h
+ * @brief A hierarchical timer wheel shared by all components and connectors of a framework.
+ *
+ * The wheel has 4 levels of 256 slots.  Level 0 has a resolution of one tick, level 1 of
+ * 256 ticks, and so on, so a timer may be up to 2^32 ticks in the future.  Scheduling,
+ * cancelling, and rescheduling a timer are O(1) list operations.  When the wheel advances,
+ * timers in a higher level slot are cascaded down to a lower level as that slot comes due.
+ *
+ * The wheel does not own a clock.  The framework calls rtaTimerWheel_Advance() from its
+ * existing millisecond tick, so every timer in the framework rides on that one libevent
+ * timer instead of each component arming its own PARCEventTimer.  A timer scheduled with
+ * a delay of 0 goes on a ready list that is run from a single deferred event at the end
+ * of the current dispatch, which is what the connectors use to break up their work.
+ *
+ * Timer callbacks may schedule, cancel, or destroy any timer, including their own.
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef Libccnx_rta_TimerWheel_h
+#define Libccnx_rta_TimerWheel_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <parc/algol/parc_EventScheduler.h>
+
+struct rta_timer_wheel;
+typedef struct rta_timer_wheel RtaTimerWheel;
+
+struct rta_timer;
+typedef struct rta_timer RtaTimer;
+
+/**
+ * Called from the event loop when a timer expires.  The timer is no longer
+ * pending when the callback runs.
+ */
+typedef void (RtaTimerCallback)(RtaTimer *timer, void *arg);
+
+/**
+ * Create a timer wheel whose current time is `now`
+ *
+ * The scheduler is used for the deferred event that runs zero-delay timers.
+ *
+ * @param [in] scheduler The event scheduler of the framework
+ * @param [in] now The current time in ticks
+ *
+ * @return non-null An allocated timer wheel
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCEventScheduler *scheduler = parcEventScheduler_Create();
+ *     RtaTimerWheel *wheel = rtaTimerWheel_Create(scheduler, 0);
+ *     rtaTimerWheel_Destroy(&wheel);
+ *     parcEventScheduler_Destroy(&scheduler);
+ * }
+ * @endcode
+ */
+RtaTimerWheel *rtaTimerWheel_Create(PARCEventScheduler *scheduler, uint64_t now);
+
+/**
+ * Destroy the timer wheel
+ *
+ * Any timers still pending are taken off the wheel without being called.  The timers
+ * themselves belong to their creators and must still be destroyed with rtaTimer_Destroy().
+ *
+ * @param [in,out] wheelPtr The wheel to destroy, will be NULL'd
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaTimerWheel_Destroy(RtaTimerWheel **wheelPtr);
+
+/**
+ * Advance the wheel to time `now` and run every timer that expired
+ *
+ * Each tick between the previous time and `now` is visited in order, so timers
+ * fire in expiry order even if the event loop was stalled for several ticks.
+ * Moving backwards in time does nothing.
+ *
+ * @param [in] wheel The timer wheel
+ * @param [in] now The current time in ticks
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaTimerWheel_Advance(RtaTimerWheel *wheel, uint64_t now);
+
+/**
+ * The time the wheel was last advanced to
+ *
+ * @param [in] wheel The timer wheel
+ *
+ * @return number The current time of the wheel in ticks
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+uint64_t rtaTimerWheel_GetTime(const RtaTimerWheel *wheel);
+
+/**
+ * The number of timers scheduled on the wheel, including those ready to run
+ *
+ * @param [in] wheel The timer wheel
+ *
+ * @return number The count of pending timers
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+size_t rtaTimerWheel_PendingCount(const RtaTimerWheel *wheel);
+
+/**
+ * The earliest time at which rtaTimerWheel_Advance() may have work to do
+ *
+ * This is a lower bound.  It is the expiry of the next timer if that timer is in the
+ * lowest level of the wheel, otherwise the next time a higher level cascades down, which
+ * may be before anything expires.  A caller that sleeps until then and advances the wheel
+ * never runs a timer late.
+ *
+ * @param [in] wheel The timer wheel
+ *
+ * @return number A time in ticks, the current time of the wheel if timers are ready to run
+ * @return UINT64_MAX No timer is pending
+ *
+ * Example:
+ * @code
+ * {
+ *     uint64_t next = rtaTimerWheel_NextExpiry(wheel);
+ *     if (next != UINT64_MAX) {
+ *         // sleep for (next - rtaTimerWheel_GetTime(wheel)) ticks
+ *     }
+ * }
+ * @endcode
+ */
+uint64_t rtaTimerWheel_NextExpiry(const RtaTimerWheel *wheel);
+
+/**
+ * Create a timer on the wheel.  The timer is not scheduled.
+ *
+ * @param [in] wheel The timer wheel
+ * @param [in] callback Called when the timer expires
+ * @param [in] arg Passed to the callback
+ *
+ * @return non-null An allocated timer
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaTimer *timer = rtaTimer_Create(wheel, _myCallback, myState);
+ *     rtaTimer_Schedule(timer, 100);
+ *     ...
+ *     rtaTimer_Destroy(&timer);
+ * }
+ * @endcode
+ */
+RtaTimer *rtaTimer_Create(RtaTimerWheel *wheel, RtaTimerCallback *callback, void *arg);
+
+/**
+ * Cancel the timer, if pending, and release its memory
+ *
+ * @param [in,out] timerPtr The timer to destroy, will be NULL'd
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaTimer_Destroy(RtaTimer **timerPtr);
+
+/**
+ * Schedule the timer to expire `delay` ticks from the current time of the wheel
+ *
+ * If the timer is already pending, it is rescheduled.  A delay of 0 runs the timer
+ * from the event loop after the current callback returns.
+ *
+ * @param [in] timer The timer to schedule
+ * @param [in] delay The number of ticks from now
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaTimer_Schedule(RtaTimer *timer, uint64_t delay);
+
+/**
+ * Take the timer off the wheel.  Does nothing if the timer is not pending.
+ *
+ * @param [in] timer The timer to cancel
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaTimer_Cancel(RtaTimer *timer);
+
+/**
+ * Determines if the timer is scheduled
+ *
+ * @param [in] timer The timer
+ *
+ * @return true The timer is on the wheel and will fire
+ * @return false The timer is idle
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+bool rtaTimer_IsPending(const RtaTimer *timer);
+
+/**
+ * The absolute time, in ticks, when a pending timer will fire
+ *
+ * @param [in] timer A pending timer
+ *
+ * @return number The expiry time of the timer
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+uint64_t rtaTimer_GetExpiry(const RtaTimer *timer);
+#endif // Libccnx_rta_TimerWheel_h
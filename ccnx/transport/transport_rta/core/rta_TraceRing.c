@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * The ring is an array of 2^n records and a count of records ever written.  The next
+ * record goes at (written & mask).  Only the Transport thread touches the ring, so there
+ * is no synchronization.
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+
+#include <ccnx/transport/transport_rta/core/rta_TraceRing.h>
+
+struct rta_trace_ring {
+    RtaTraceRecord *records;
+    uint64_t mask;
+    uint64_t written;
+};
+
+static const char *_rtaTraceEventNames[RtaTraceEvent_Last] = {
+    [RtaTraceEvent_ConnectionOpen]     = "connection_open",
+    [RtaTraceEvent_ConnectionClose]    = "connection_close",
+    [RtaTraceEvent_Put]                = "put",
+    [RtaTraceEvent_Get]                = "get",
+    [RtaTraceEvent_Drop]               = "drop",
+    [RtaTraceEvent_InterestSent]       = "interest_sent",
+    [RtaTraceEvent_InterestSuppressed] = "interest_suppressed",
+    [RtaTraceEvent_Retransmit]         = "retransmit",
+    [RtaTraceEvent_ContentReceived]    = "content_received",
+};
+
+RtaTraceRing *
+rtaTraceRing_Create(size_t capacity)
+{
+    assertTrue(capacity > 0, "Parameter capacity must be positive");
+
+    size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    RtaTraceRing *ring = parcMemory_AllocateAndClear(sizeof(RtaTraceRing));
+    assertNotNull(ring, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(RtaTraceRing));
+
+    ring->records = parcMemory_AllocateAndClear(size * sizeof(RtaTraceRecord));
+    assertNotNull(ring->records, "parcMemory_AllocateAndClear(%zu) returned NULL", size * sizeof(RtaTraceRecord));
+
+    ring->mask = size - 1;
+    ring->written = 0;
+    return ring;
+}
+
+void
+rtaTraceRing_Destroy(RtaTraceRing **ringPtr)
+{
+    assertNotNull(ringPtr, "Parameter ringPtr must be non-null");
+    RtaTraceRing *ring = *ringPtr;
+    assertNotNull(ring, "Parameter ringPtr must dereference to non-null");
+
+    parcMemory_Deallocate((void **) &ring->records);
+    parcMemory_Deallocate((void **) &ring);
+    *ringPtr = NULL;
+}
+
+void
+rtaTraceRing_Record(RtaTraceRing *ring, uint32_t connectionId, RtaComponents component, RtaTraceEvent event, uint64_t value)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    rtaTraceRing_RecordAt(ring, (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec, connectionId, component, event, value);
+}
+
+void
+rtaTraceRing_RecordAt(RtaTraceRing *ring, uint64_t timestamp, uint32_t connectionId, RtaComponents component, RtaTraceEvent event, uint64_t value)
+{
+    RtaTraceRecord *record = &ring->records[ring->written & ring->mask];
+    record->timestamp = timestamp;
+    record->connectionId = connectionId;
+    record->component = (uint16_t) component;
+    record->event = (uint16_t) event;
+    record->value = value;
+
+    ring->written++;
+}
+
+size_t
+rtaTraceRing_GetCapacity(const RtaTraceRing *ring)
+{
+    assertNotNull(ring, "Parameter ring must be non-null");
+    return (size_t) ring->mask + 1;
+}
+
+size_t
+rtaTraceRing_GetCount(const RtaTraceRing *ring)
+{
+    assertNotNull(ring, "Parameter ring must be non-null");
+    if (ring->written > ring->mask) {
+        return (size_t) ring->mask + 1;
+    }
+    return (size_t) ring->written;
+}
+
+const RtaTraceRecord *
+rtaTraceRing_GetRecord(const RtaTraceRing *ring, size_t index)
+{
+    size_t count = rtaTraceRing_GetCount(ring);
+    assertTrue(index < count, "Index %zu out of range, ring has %zu records", index, count);
+
+    uint64_t oldest = ring->written - count;
+    return &ring->records[(oldest + index) & ring->mask];
+}
+
+bool
+rtaTraceRing_WriteFile(const RtaTraceRing *ring, const char *filename)
+{
+    assertNotNull(ring, "Parameter ring must be non-null");
+    assertNotNull(filename, "Parameter filename must be non-null");
+
+    FILE *file = fopen(filename, "w");
+    if (file == NULL) {
+        return false;
+    }
+
+    RtaTraceFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, RTA_TRACE_FILE_MAGIC, sizeof(header.magic));
+    header.version = RTA_TRACE_FILE_VERSION;
+    header.recordSize = sizeof(RtaTraceRecord);
+    header.capacity = ring->mask + 1;
+    header.written = ring->written;
+
+    bool success = (fwrite(&header, sizeof(header), 1, file) == 1);
+
+    // The records are in two runs: from the oldest to the end of the array, then from the start
+    size_t count = rtaTraceRing_GetCount(ring);
+    size_t first = (size_t) ((ring->written - count) & ring->mask);
+    size_t firstRun = (first + count > ring->mask + 1) ? (size_t) (ring->mask + 1 - first) : count;
+
+    if (success && firstRun > 0) {
+        success = (fwrite(&ring->records[first], sizeof(RtaTraceRecord), firstRun, file) == firstRun);
+    }
+    if (success && count > firstRun) {
+        success = (fwrite(&ring->records[0], sizeof(RtaTraceRecord), count - firstRun, file) == count - firstRun);
+    }
+
+    if (fclose(file) != 0) {
+        success = false;
+    }
+    return success;
+}
+
+const char *
+rtaTraceEvent_ToString(RtaTraceEvent event)
+{
+    if ((unsigned) event < RtaTraceEvent_Last) {
+        return _rtaTraceEventNames[event];
+    }
+    return "unknown";
+}
@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file rta_TraceRing.h
+ * @brief A fixed-size flight recorder of per-message events
+ *
+ * Each framework keeps one ring of compact binary trace records.  The ring is always on:
+ * recording a record is a clock read and a 24-byte store, with no locks, no allocation, and
+ * no formatting.  When the ring is full the oldest records are overwritten, so the ring
+ * always holds the most recent history of the transport.
+ *
+ * The ring is written and dumped only from the Transport thread.  A dump is a small header
+ * (RtaTraceFileHeader) followed by the records, oldest first, in host byte order.  The
+ * test_tools/rta_tracedump program prints a dump as text.
+ *
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef Libccnx_rta_TraceRing_h
+#define Libccnx_rta_TraceRing_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <ccnx/transport/transport_rta/core/components.h>
+
+struct rta_trace_ring;
+typedef struct rta_trace_ring RtaTraceRing;
+
+/**
+ * The event of a trace record.  The meaning of the record's value depends on the event.
+ */
+typedef enum {
+    RtaTraceEvent_ConnectionOpen,       // value is the API file descriptor
+    RtaTraceEvent_ConnectionClose,      // value is the API file descriptor
+    RtaTraceEvent_Put,                  // value identifies the TransportMessage
+    RtaTraceEvent_Get,                  // value identifies the TransportMessage
+    RtaTraceEvent_Drop,                 // value is the RtaComponentStatType of the drop reason
+    RtaTraceEvent_InterestSent,         // value is the segment number
+    RtaTraceEvent_InterestSuppressed,   // value is the segment number
+    RtaTraceEvent_Retransmit,           // value is the segment number
+    RtaTraceEvent_ContentReceived,      // value is the segment number
+    RtaTraceEvent_Last                  // must be last
+} RtaTraceEvent;
+
+/**
+ * One trace record, 24 bytes
+ */
+typedef struct rta_trace_record {
+    uint64_t timestamp;         // nanoseconds on the monotonic clock
+    uint32_t connectionId;      // rtaConnection_GetConnectionId(), 0 if none
+    uint16_t component;         // RtaComponents
+    uint16_t event;             // RtaTraceEvent
+    uint64_t value;
+} RtaTraceRecord;
+
+#define RTA_TRACE_FILE_MAGIC "RTATRACE"
+#define RTA_TRACE_FILE_VERSION 1
+
+/**
+ * The header of a dump written by rtaTraceRing_WriteFile()
+ */
+typedef struct rta_trace_file_header {
+    char magic[8];              // RTA_TRACE_FILE_MAGIC, not NUL terminated
+    uint32_t version;           // RTA_TRACE_FILE_VERSION
+    uint32_t recordSize;        // sizeof(RtaTraceRecord)
+    uint64_t capacity;          // records the ring can hold
+    uint64_t written;           // records ever written; min(written, capacity) records follow
+} RtaTraceFileHeader;
+
+/**
+ * Create a trace ring
+ *
+ * @param [in] capacity The number of records, rounded up to a power of 2
+ *
+ * @return non-null An allocated, empty ring
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaTraceRing *ring = rtaTraceRing_Create(65536);
+ *     rtaTraceRing_Destroy(&ring);
+ * }
+ * @endcode
+ */
+RtaTraceRing *rtaTraceRing_Create(size_t capacity);
+
+/**
+ * Destroy the ring and its records
+ *
+ * @param [in,out] ringPtr The ring to destroy, will be NULL'd
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaTraceRing_Destroy(RtaTraceRing **ringPtr);
+
+/**
+ * Append a record, overwriting the oldest if the ring is full
+ *
+ * @param [in] ring The trace ring
+ * @param [in] connectionId The connection, or 0
+ * @param [in] component The component reporting the event
+ * @param [in] event The event
+ * @param [in] value Event specific, see RtaTraceEvent
+ *
+ * Example:
+ * @code
+ * {
+ *     rtaTraceRing_Record(ring, rtaConnection_GetConnectionId(conn), FC_VEGAS, RtaTraceEvent_Retransmit, segnum);
+ * }
+ * @endcode
+ */
+void rtaTraceRing_Record(RtaTraceRing *ring, uint32_t connectionId, RtaComponents component, RtaTraceEvent event, uint64_t value);
+
+/**
+ * Append a record with a timestamp the caller already has
+ *
+ * Like rtaTraceRing_Record(), but does not read the clock.  The timestamp must be in
+ * nanoseconds on CLOCK_MONOTONIC, e.g. transportMessage_GetBoundaryTime().
+ *
+ * @param [in] ring The trace ring
+ * @param [in] timestamp Nanoseconds on CLOCK_MONOTONIC
+ * @param [in] connectionId The connection, or 0
+ * @param [in] component The component reporting the event
+ * @param [in] event The event
+ * @param [in] value Event specific, see RtaTraceEvent
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+void rtaTraceRing_RecordAt(RtaTraceRing *ring, uint64_t timestamp, uint32_t connectionId, RtaComponents component, RtaTraceEvent event, uint64_t value);
+
+/**
+ * The number of records the ring can hold
+ *
+ * @param [in] ring The trace ring
+ *
+ * @return The capacity, a power of 2
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+size_t rtaTraceRing_GetCapacity(const RtaTraceRing *ring);
+
+/**
+ * The number of records in the ring, at most the capacity
+ *
+ * @param [in] ring The trace ring
+ *
+ * @return The number of records rtaTraceRing_GetRecord() can return
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+size_t rtaTraceRing_GetCount(const RtaTraceRing *ring);
+
+/**
+ * Return a record in the ring, 0 being the oldest
+ *
+ * @param [in] ring The trace ring
+ * @param [in] index Less than rtaTraceRing_GetCount()
+ *
+ * @return non-null The record, owned by the ring and overwritten by later records
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+const RtaTraceRecord *rtaTraceRing_GetRecord(const RtaTraceRing *ring, size_t index);
+
+/**
+ * Write the ring to a file
+ *
+ * The file is replaced.  It holds an RtaTraceFileHeader followed by rtaTraceRing_GetCount()
+ * records, oldest first.  The ring is not changed.
+ *
+ * @param [in] ring The trace ring
+ * @param [in] filename The file to write
+ *
+ * @return true The file was written
+ * @return false An I/O error, errno is set
+ *
+ * Example:
+ * @code
+ * {
+ *     rtaTraceRing_WriteFile(rtaFramework_GetTraceRing(framework), "/tmp/rta.trace");
+ * }
+ * @endcode
+ */
+bool rtaTraceRing_WriteFile(const RtaTraceRing *ring, const char *filename);
+
+/**
+ * The name of a trace event, e.g. "retransmit"
+ *
+ * @param [in] event The event
+ *
+ * @return non-null A static string, "unknown" for an out of range value
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+const char *rtaTraceEvent_ToString(RtaTraceEvent event);
+#endif // Libccnx_rta_TraceRing_h
@@ -70,13 +70,14 @@
 #include <ccnx/transport/test_tools/traffic_tools.h>
 
 #include <sys/socket.h>
+#include <inttypes.h>
 #include <errno.h>
 
 #define PAIR_OTHER 0
 #define PAIR_TRANSPORT 1
 
 typedef struct test_data {
-    PARCRingBuffer1x1 *commandRingBuffer;
+    RtaCommandQueue *commandQueue;
     PARCNotifier *commandNotifier;
 
     int api_fds[2];
@@ -94,9 +95,9 @@ _commonSetup(void)
     int error = socketpair(AF_UNIX, SOCK_STREAM, 0, data->api_fds);
     assertFalse(error, "Error creating socket pair: (%d) %s", errno, strerror(errno));
 
-    data->commandRingBuffer = parcRingBuffer1x1_Create(128, NULL);
+    data->commandQueue = rtaCommandQueue_Create(128);
     data->commandNotifier = parcNotifier_Create();
-    data->framework = rtaFramework_Create(data->commandRingBuffer, data->commandNotifier);
+    data->framework = rtaFramework_Create(data->commandQueue, data->commandNotifier);
 
     assertNotNull(data->framework, "rtaFramework_Create returned null");
 
@@ -146,7 +147,7 @@ _commonTeardown(TestData *data)
 
     rtaFramework_Teardown(data->framework);
 
-    parcRingBuffer1x1_Release(&data->commandRingBuffer);
+    rtaCommandQueue_Release(&data->commandQueue);
     parcNotifier_Release(&data->commandNotifier);
     rtaFramework_Destroy(&data->framework);
 
@@ -225,6 +226,9 @@ LONGBOW_TEST_CASE(Global, rtaComponent_PutMessage_ClosedConnection)
     int success = rtaComponent_PutMessage(outputQueue, tm);
     assertFalse(success, "Error putting message on API Connector's down queue");
 
+    uint64_t drops = rtaComponentStats_Get(rtaConnection_GetStats(data->connection, API_CONNECTOR), STATS_DROP_CLOSED);
+    assertTrue(drops == 1, "Wrong closed drop count, got %" PRIu64 " expected 1", drops);
+
     // check that we got it
     PARCEventQueue *inputQueue = rtaComponent_GetOutputQueue(data->connection, TESTING_LOWER, RTA_UP);
 
@@ -251,12 +255,24 @@ LONGBOW_TEST_CASE(Global, rtaComponent_PutMessage_OpenConnection)
     int success = rtaComponent_PutMessage(outputQueue, tm);
     assertTrue(success, "Error putting message on API Connector's down queue");
 
+    RtaComponentStats *stackStats = rtaProtocolStack_GetStats(data->stack, API_CONNECTOR);
+    assertTrue(rtaComponentStats_GetQueueDepth(stackStats, RTA_DOWN) == 1,
+               "Wrong queue depth after put, got %" PRIu64, rtaComponentStats_GetQueueDepth(stackStats, RTA_DOWN));
+
     // check that we got it
     PARCEventQueue *inputQueue = rtaComponent_GetOutputQueue(data->connection, TESTING_LOWER, RTA_UP);
 
     TransportMessage *test_tm = rtaComponent_GetMessage(inputQueue);
     assertTrue(test_tm == tm, "Got wrong message, got %p expected %p", (void *) test_tm, (void *) tm);
 
+    // the get is charged to the writer's queue, and the high-water mark stays
+    assertTrue(rtaComponentStats_GetQueueDepth(stackStats, RTA_DOWN) == 0,
+               "Wrong queue depth after get, got %" PRIu64, rtaComponentStats_GetQueueDepth(stackStats, RTA_DOWN));
+    assertTrue(rtaComponentStats_GetQueueHighWater(stackStats, RTA_DOWN) == 1,
+               "Wrong high-water mark, got %" PRIu64, rtaComponentStats_GetQueueHighWater(stackStats, RTA_DOWN));
+    assertTrue(rtaConnection_MessagesInQueueHighWater(data->connection) == 1,
+               "Wrong connection high-water mark, got %u", rtaConnection_MessagesInQueueHighWater(data->connection));
+
     transportMessage_Destroy(&tm);
 }
 
@@ -73,7 +73,7 @@
 #include <LongBow/unit-test.h>
 
 typedef struct test_data {
-    PARCRingBuffer1x1 *commandRingBuffer;
+    RtaCommandQueue *commandQueue;
     PARCNotifier *commandNotifier;
 
     int api_fds[2];
@@ -90,9 +90,9 @@ _commonSetup(void)
     int error = socketpair(AF_UNIX, SOCK_STREAM, 0, data->api_fds);
     assertTrue(error == 0, "Error creating socket pair: (%d) %s", errno, strerror(errno));
 
-    data->commandRingBuffer = parcRingBuffer1x1_Create(128, NULL);
+    data->commandQueue = rtaCommandQueue_Create(128);
     data->commandNotifier = parcNotifier_Create();
-    data->framework = rtaFramework_Create(data->commandRingBuffer, data->commandNotifier);
+    data->framework = rtaFramework_Create(data->commandQueue, data->commandNotifier);
     assertNotNull(data->framework, "rtaFramework_Create returned null");
 
     rtaFramework_Start(data->framework);
@@ -115,7 +115,7 @@ _commonTeardown(TestData *data)
     // blocks until done
     rtaFramework_Shutdown(data->framework);
 
-    parcRingBuffer1x1_Release(&data->commandRingBuffer);
+    rtaCommandQueue_Release(&data->commandQueue);
     parcNotifier_Release(&data->commandNotifier);
     rtaFramework_Destroy(&data->framework);
 
@@ -147,6 +147,17 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, stats_Dump);
     LONGBOW_RUN_TEST_CASE(Global, stats_Get);
     LONGBOW_RUN_TEST_CASE(Global, stats_Increment);
+    LONGBOW_RUN_TEST_CASE(Global, stats_Increment_StackAggregatesOnRead);
+    LONGBOW_RUN_TEST_CASE(Global, stats_Destroy_StackKeepsTotals);
+    LONGBOW_RUN_TEST_CASE(Global, stats_CreateShared);
+    LONGBOW_RUN_TEST_CASE(Global, stats_RecordLatency);
+    LONGBOW_RUN_TEST_CASE(Global, stats_GetLatency_None);
+    LONGBOW_RUN_TEST_CASE(Global, stats_Destroy_StackKeepsLatency);
+    LONGBOW_RUN_TEST_CASE(Global, stats_SetConnectionLatency_Off);
+    LONGBOW_RUN_TEST_CASE(Global, stats_ToJSON);
+    LONGBOW_RUN_TEST_CASE(Global, stats_ToJSON_Queue);
+    LONGBOW_RUN_TEST_CASE(Global, stats_QueuePut_QueueGet);
+    LONGBOW_RUN_TEST_CASE(Global, stats_StatType_ToString);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -222,6 +233,225 @@ LONGBOW_TEST_CASE(Global, stats_Increment)
     rtaComponentStats_Destroy(&stats);
 }
 
+LONGBOW_TEST_CASE(Global, stats_Increment_StackAggregatesOnRead)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    RtaComponentStats *stackStats = rtaProtocolStack_GetStats(data->stack, API_CONNECTOR);
+    uint64_t before = rtaComponentStats_Get(stackStats, STATS_UPCALL_IN);
+
+    RtaComponentStats *first = rtaComponentStats_Create(data->stack, API_CONNECTOR);
+    RtaComponentStats *second = rtaComponentStats_Create(data->stack, API_CONNECTOR);
+
+    rtaComponentStats_Increment(first, STATS_UPCALL_IN);
+    rtaComponentStats_Increment(second, STATS_UPCALL_IN);
+    rtaComponentStats_Increment(second, STATS_UPCALL_IN);
+
+    // the increment only touches the connection's own counter
+    assertTrue(stackStats->stats[STATS_UPCALL_IN] == before, "Stack counter was written on the hot path");
+
+    uint64_t total = rtaComponentStats_Get(stackStats, STATS_UPCALL_IN);
+    assertTrue(total == before + 3, "Wrong stack total, got %" PRIu64 " expected %" PRIu64, total, before + 3);
+
+    rtaComponentStats_Destroy(&first);
+    rtaComponentStats_Destroy(&second);
+}
+
+LONGBOW_TEST_CASE(Global, stats_Destroy_StackKeepsTotals)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    RtaComponentStats *stackStats = rtaProtocolStack_GetStats(data->stack, API_CONNECTOR);
+    uint64_t before = rtaComponentStats_Get(stackStats, STATS_DOWNCALL_OUT);
+
+    RtaComponentStats *stats = rtaComponentStats_Create(data->stack, API_CONNECTOR);
+    rtaComponentStats_Increment(stats, STATS_DOWNCALL_OUT);
+    rtaComponentStats_Increment(stats, STATS_DOWNCALL_OUT);
+    rtaComponentStats_Destroy(&stats);
+
+    assertNull(stackStats->firstChild, "Destroyed stats still linked to the stack");
+    uint64_t total = rtaComponentStats_Get(stackStats, STATS_DOWNCALL_OUT);
+    assertTrue(total == before + 2, "Wrong stack total, got %" PRIu64 " expected %" PRIu64, total, before + 2);
+}
+
+LONGBOW_TEST_CASE(Global, stats_CreateShared)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    RtaConnectionCounters *counters = rtaConnectionCounters_Create();
+
+    RtaComponentStats *stats = rtaComponentStats_CreateShared(data->stack, CODEC_TLV, counters);
+    rtaComponentStats_Increment(stats, STATS_UPCALL_OUT);
+
+    // visible through the shared block, as the API thread would read it
+    RtaConnectionStats snapshot;
+    rtaConnectionCounters_Snapshot(counters, &snapshot);
+    assertTrue(snapshot.counters[CODEC_TLV][STATS_UPCALL_OUT] == 1,
+               "Wrong shared counter, got %" PRIu64, snapshot.counters[CODEC_TLV][STATS_UPCALL_OUT]);
+    assertTrue(snapshot.counters[CODEC_TLV][STATS_UPCALL_IN] == 0, "Unexpected increment of STATS_UPCALL_IN");
+
+    // the stats hold their own reference, so the block outlives them
+    rtaComponentStats_Destroy(&stats);
+    rtaConnectionCounters_Snapshot(counters, &snapshot);
+    assertTrue(snapshot.counters[CODEC_TLV][STATS_UPCALL_OUT] == 1, "Shared counter lost after destroy");
+
+    rtaConnectionCounters_Release(&counters);
+}
+
+LONGBOW_TEST_CASE(Global, stats_RecordLatency)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    RtaComponentStats *stats = rtaComponentStats_Create(data->stack, API_CONNECTOR);
+
+    rtaComponentStats_RecordLatency(stats, RtaLatencyStage_QueueWait, RTA_DOWN, 1000);
+    rtaComponentStats_RecordLatency(stats, RtaLatencyStage_QueueWait, RTA_DOWN, 3000);
+
+    const RtaLatencyHistogram *histogram = rtaComponentStats_GetLatency(stats, RtaLatencyStage_QueueWait, RTA_DOWN);
+    assertNotNull(histogram, "Expected a histogram after recording");
+    assertTrue(rtaLatencyHistogram_GetCount(histogram) == 2, "Wrong count, got %" PRIu64, rtaLatencyHistogram_GetCount(histogram));
+    assertTrue(rtaLatencyHistogram_GetMean(histogram) == 2000, "Wrong mean, got %" PRIu64, rtaLatencyHistogram_GetMean(histogram));
+
+    // the stack-wide stats merge the samples when read
+    const RtaLatencyHistogram *stackHistogram =
+        rtaComponentStats_GetLatency(rtaProtocolStack_GetStats(data->stack, API_CONNECTOR), RtaLatencyStage_QueueWait, RTA_DOWN);
+    assertNotNull(stackHistogram, "Expected a stack histogram after recording");
+    assertTrue(rtaLatencyHistogram_GetCount(stackHistogram) == 2, "Wrong stack count, got %" PRIu64, rtaLatencyHistogram_GetCount(stackHistogram));
+
+    assertNull(rtaComponentStats_GetLatency(stats, RtaLatencyStage_Processing, RTA_DOWN), "Other stages should not be allocated");
+
+    rtaComponentStats_Destroy(&stats);
+}
+
+LONGBOW_TEST_CASE(Global, stats_GetLatency_None)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    RtaComponentStats *stats = rtaComponentStats_Create(data->stack, API_CONNECTOR);
+
+    for (int stage = 0; stage < RtaLatencyStage_Last; stage++) {
+        assertNotNull(rtaLatencyStage_ToString(stage), "Got null string for stage %d", stage);
+        assertNull(rtaComponentStats_GetLatency(stats, stage, RTA_UP), "Expected no histogram for stage %d", stage);
+        assertNull(rtaComponentStats_GetLatency(stats, stage, RTA_DOWN), "Expected no histogram for stage %d", stage);
+    }
+
+    rtaComponentStats_Destroy(&stats);
+}
+
+LONGBOW_TEST_CASE(Global, stats_Destroy_StackKeepsLatency)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    RtaComponentStats *stackStats = rtaProtocolStack_GetStats(data->stack, API_CONNECTOR);
+    RtaComponentStats *a = rtaComponentStats_Create(data->stack, API_CONNECTOR);
+    RtaComponentStats *b = rtaComponentStats_Create(data->stack, API_CONNECTOR);
+
+    rtaComponentStats_RecordLatency(a, RtaLatencyStage_Processing, RTA_UP, 1000);
+    rtaComponentStats_RecordLatency(b, RtaLatencyStage_Processing, RTA_UP, 5000);
+
+    const RtaLatencyHistogram *merged = rtaComponentStats_GetLatency(stackStats, RtaLatencyStage_Processing, RTA_UP);
+    assertTrue(rtaLatencyHistogram_GetCount(merged) == 2, "Wrong merged count, got %" PRIu64, rtaLatencyHistogram_GetCount(merged));
+    assertTrue(rtaLatencyHistogram_GetMax(merged) == 5000, "Wrong merged max, got %" PRIu64, rtaLatencyHistogram_GetMax(merged));
+
+    // a destroyed connection's samples stay in the stack-wide histogram
+    rtaComponentStats_Destroy(&a);
+    rtaComponentStats_RecordLatency(b, RtaLatencyStage_Processing, RTA_UP, 3000);
+    merged = rtaComponentStats_GetLatency(stackStats, RtaLatencyStage_Processing, RTA_UP);
+    assertTrue(rtaLatencyHistogram_GetCount(merged) == 3, "Wrong merged count after destroy, got %" PRIu64, rtaLatencyHistogram_GetCount(merged));
+    assertTrue(rtaLatencyHistogram_GetMin(merged) == 1000, "Wrong merged min after destroy, got %" PRIu64, rtaLatencyHistogram_GetMin(merged));
+
+    rtaComponentStats_Destroy(&b);
+}
+
+LONGBOW_TEST_CASE(Global, stats_SetConnectionLatency_Off)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    RtaComponentStats *stats = rtaComponentStats_Create(data->stack, API_CONNECTOR);
+    rtaComponentStats_SetConnectionLatency(stats, false);
+
+    rtaComponentStats_RecordLatency(stats, RtaLatencyStage_QueueWait, RTA_UP, 2000);
+    assertNull(rtaComponentStats_GetLatency(stats, RtaLatencyStage_QueueWait, RTA_UP), "The connection should not allocate a histogram");
+
+    const RtaLatencyHistogram *stackHistogram =
+        rtaComponentStats_GetLatency(rtaProtocolStack_GetStats(data->stack, API_CONNECTOR), RtaLatencyStage_QueueWait, RTA_UP);
+    assertNotNull(stackHistogram, "The sample should be in the stack histogram");
+    assertTrue(rtaLatencyHistogram_GetCount(stackHistogram) == 1, "Wrong stack count, got %" PRIu64, rtaLatencyHistogram_GetCount(stackHistogram));
+
+    rtaComponentStats_Destroy(&stats);
+}
+
+LONGBOW_TEST_CASE(Global, stats_ToJSON)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    RtaComponentStats *stats = rtaComponentStats_Create(data->stack, API_CONNECTOR);
+
+    rtaComponentStats_Increment(stats, STATS_UPCALL_IN);
+    rtaComponentStats_Increment(stats, STATS_UPCALL_IN);
+
+    PARCJSON *json = rtaComponentStats_ToJSON(stats);
+    PARCJSONValue *value = parcJSON_GetValueByName(json, rtaComponentStatType_ToString(STATS_UPCALL_IN));
+    assertNotNull(value, "Missing upcall_in");
+    assertTrue(parcJSONValue_GetInteger(value) == 2, "Wrong upcall_in, got %" PRId64, parcJSONValue_GetInteger(value));
+    assertNull(parcJSON_GetValueByName(json, "latency"), "No latency object expected before any sample");
+    parcJSON_Release(&json);
+
+    rtaComponentStats_RecordLatency(stats, RtaLatencyStage_Processing, RTA_UP, 500);
+    json = rtaComponentStats_ToJSON(stats);
+    value = parcJSON_GetValueByName(json, "latency");
+    assertNotNull(value, "Missing latency object");
+    assertNotNull(parcJSON_GetValueByName(parcJSONValue_GetJSON(value), "processing_up"), "Missing processing_up histogram");
+    parcJSON_Release(&json);
+
+    rtaComponentStats_Destroy(&stats);
+}
+
+LONGBOW_TEST_CASE(Global, stats_ToJSON_Queue)
+{
+    RtaComponentStats *stats = rtaComponentStats_Create(NULL, API_CONNECTOR);
+
+    PARCJSON *json = rtaComponentStats_ToJSON(stats);
+    assertNull(parcJSON_GetValueByName(json, "queue"), "No queue object expected before any put");
+    parcJSON_Release(&json);
+
+    rtaComponentStats_QueuePut(stats, RTA_DOWN);
+    json = rtaComponentStats_ToJSON(stats);
+    PARCJSONValue *value = parcJSON_GetValueByName(json, "queue");
+    assertNotNull(value, "Missing queue object");
+    PARCJSON *queue = parcJSONValue_GetJSON(value);
+    assertNotNull(parcJSON_GetValueByName(queue, "down"), "Missing down gauge");
+    assertNull(parcJSON_GetValueByName(queue, "up"), "Unexpected up gauge");
+    parcJSON_Release(&json);
+
+    rtaComponentStats_Destroy(&stats);
+}
+
+LONGBOW_TEST_CASE(Global, stats_QueuePut_QueueGet)
+{
+    RtaComponentStats *stats = rtaComponentStats_Create(NULL, CODEC_TLV);
+
+    rtaComponentStats_QueuePut(stats, RTA_UP);
+    rtaComponentStats_QueuePut(stats, RTA_UP);
+    rtaComponentStats_QueuePut(stats, RTA_UP);
+    rtaComponentStats_QueueGet(stats, RTA_UP);
+    rtaComponentStats_QueueGet(stats, RTA_UP);
+    rtaComponentStats_QueuePut(stats, RTA_UP);
+
+    assertTrue(rtaComponentStats_GetQueueDepth(stats, RTA_UP) == 2,
+               "Wrong depth, got %" PRIu64, rtaComponentStats_GetQueueDepth(stats, RTA_UP));
+    assertTrue(rtaComponentStats_GetQueueHighWater(stats, RTA_UP) == 3,
+               "Wrong high-water mark, got %" PRIu64, rtaComponentStats_GetQueueHighWater(stats, RTA_UP));
+    assertTrue(rtaComponentStats_GetQueueHighWater(stats, RTA_DOWN) == 0, "Down queue should be untouched");
+
+    // never wraps below zero
+    rtaComponentStats_QueueGet(stats, RTA_DOWN);
+    assertTrue(rtaComponentStats_GetQueueDepth(stats, RTA_DOWN) == 0, "Depth wrapped below zero");
+
+    rtaComponentStats_Destroy(&stats);
+}
+
+LONGBOW_TEST_CASE(Global, stats_StatType_ToString)
+{
+    for (RtaComponentStatType statType = 0; statType < STATS_LAST; statType++) {
+        assertNotNull(rtaComponentStatType_ToString(statType), "No name for stat type %d", statType);
+    }
+    assertTrue(strcmp(rtaComponentStatType_ToString(STATS_DROP_NO_SESSION), "drop_no_session") == 0,
+               "Wrong name, got %s", rtaComponentStatType_ToString(STATS_DROP_NO_SESSION));
+}
+
 int
 main(int argc, char *argv[])
 {
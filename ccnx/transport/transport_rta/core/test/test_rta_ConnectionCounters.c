@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include "../rta_ConnectionCounters.c"
+
+#include <inttypes.h>
+
+#include <LongBow/unit-test.h>
+#include <parc/algol/parc_SafeMemory.h>
+
+LONGBOW_TEST_RUNNER(rta_ConnectionCounters)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+LONGBOW_TEST_RUNNER_SETUP(rta_ConnectionCounters)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_RUNNER_TEARDOWN(rta_ConnectionCounters)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, rtaConnectionCounters_Create_Release);
+    LONGBOW_RUN_TEST_CASE(Global, rtaConnectionCounters_Acquire);
+    LONGBOW_RUN_TEST_CASE(Global, rtaConnectionCounters_GetRow);
+    LONGBOW_RUN_TEST_CASE(Global, rtaConnectionCounters_Snapshot);
+    LONGBOW_RUN_TEST_CASE(Global, rtaConnectionCounters_SetLimit);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, rtaConnectionCounters_Create_Release)
+{
+    RtaConnectionCounters *counters = rtaConnectionCounters_Create();
+    assertNotNull(counters, "Got null counters");
+    assertTrue(((uintptr_t) counters % RTA_CACHE_LINE_SIZE) == 0, "Counters not cache-line aligned: %p", (void *) counters);
+    assertTrue(counters->refcount == 1, "Wrong refcount, got %u", counters->refcount);
+
+    for (int component = 0; component < LAST_COMPONENT; component++) {
+        for (int statType = 0; statType < STATS_LAST; statType++) {
+            assertTrue(counters->rows[component][statType] == 0, "Counter [%d][%d] not zero", component, statType);
+        }
+    }
+
+    rtaConnectionCounters_Release(&counters);
+    assertNull(counters, "Release did not null the pointer");
+}
+
+LONGBOW_TEST_CASE(Global, rtaConnectionCounters_Acquire)
+{
+    RtaConnectionCounters *counters = rtaConnectionCounters_Create();
+    RtaConnectionCounters *second = rtaConnectionCounters_Acquire(counters);
+    assertTrue(second == counters, "Acquire returned a different pointer");
+    assertTrue(counters->refcount == 2, "Wrong refcount, got %u", counters->refcount);
+
+    rtaConnectionCounters_Release(&second);
+    assertTrue(counters->refcount == 1, "Wrong refcount, got %u", counters->refcount);
+    rtaConnectionCounters_Release(&counters);
+}
+
+LONGBOW_TEST_CASE(Global, rtaConnectionCounters_GetRow)
+{
+    RtaConnectionCounters *counters = rtaConnectionCounters_Create();
+
+    uint64_t *row = rtaConnectionCounters_GetRow(counters, CODEC_TLV);
+    assertTrue(row == counters->rows[CODEC_TLV], "Wrong row for CODEC_TLV");
+
+    rtaConnectionCounters_Store(&row[STATS_UPCALL_IN], 42);
+    assertTrue(rtaConnectionCounters_Load(&row[STATS_UPCALL_IN]) == 42,
+               "Wrong value, got %" PRIu64, rtaConnectionCounters_Load(&row[STATS_UPCALL_IN]));
+
+    rtaConnectionCounters_Release(&counters);
+}
+
+LONGBOW_TEST_CASE(Global, rtaConnectionCounters_Snapshot)
+{
+    RtaConnectionCounters *counters = rtaConnectionCounters_Create();
+
+    rtaConnectionCounters_Store(&rtaConnectionCounters_GetRow(counters, API_CONNECTOR)[STATS_UPCALL_OUT], 7);
+    rtaConnectionCounters_Store(&rtaConnectionCounters_GetRow(counters, FC_VEGAS)[STATS_DOWNCALL_IN], 11);
+
+    RtaConnectionStats stats;
+    rtaConnectionCounters_Snapshot(counters, &stats);
+
+    for (int component = 0; component < LAST_COMPONENT; component++) {
+        for (int statType = 0; statType < STATS_LAST; statType++) {
+            uint64_t expected = 0;
+            if (component == API_CONNECTOR && statType == STATS_UPCALL_OUT) {
+                expected = 7;
+            } else if (component == FC_VEGAS && statType == STATS_DOWNCALL_IN) {
+                expected = 11;
+            }
+            assertTrue(stats.counters[component][statType] == expected,
+                       "Counter [%d][%d] wrong, got %" PRIu64 " expected %" PRIu64,
+                       component, statType, stats.counters[component][statType], expected);
+        }
+    }
+
+    rtaConnectionCounters_Release(&counters);
+}
+
+LONGBOW_TEST_CASE(Global, rtaConnectionCounters_SetLimit)
+{
+    RtaConnectionCounters *counters = rtaConnectionCounters_Create();
+
+    RtaConnectionStats stats;
+    rtaConnectionCounters_Snapshot(counters, &stats);
+    for (int limit = 0; limit < RTA_LIMIT_LAST; limit++) {
+        assertTrue(stats.limits[limit] == 0, "Limit %d not zero in a new block, got %" PRIu64, limit, stats.limits[limit]);
+    }
+
+    rtaConnectionCounters_SetLimit(counters, RTA_LIMIT_SEND_QUEUE_DEPTH, 256);
+    rtaConnectionCounters_SetLimit(counters, RTA_LIMIT_WRITE_WATERMARK, 400);
+    rtaConnectionCounters_Snapshot(counters, &stats);
+
+    assertTrue(stats.limits[RTA_LIMIT_SEND_QUEUE_DEPTH] == 256, "Wrong send queue depth, got %" PRIu64, stats.limits[RTA_LIMIT_SEND_QUEUE_DEPTH]);
+    assertTrue(stats.limits[RTA_LIMIT_WRITE_WATERMARK] == 400, "Wrong write watermark, got %" PRIu64, stats.limits[RTA_LIMIT_WRITE_WATERMARK]);
+    assertTrue(stats.limits[RTA_LIMIT_RECEIVE_BUFFER] == 0, "Receive buffer should be unset, got %" PRIu64, stats.limits[RTA_LIMIT_RECEIVE_BUFFER]);
+
+    rtaConnectionCounters_Release(&counters);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(rta_ConnectionCounters);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -89,15 +89,19 @@ LONGBOW_TEST_FIXTURE(Global)
 {
     LONGBOW_RUN_TEST_CASE(Global, rtaConnectionTable_AddConnection);
     LONGBOW_RUN_TEST_CASE(Global, rtaConnectionTable_AddConnection_TooMany);
+    LONGBOW_RUN_TEST_CASE(Global, rtaConnectionTable_Available);
     LONGBOW_RUN_TEST_CASE(Global, rtaConnectionTable_Create_Destroy);
     LONGBOW_RUN_TEST_CASE(Global, rtaConnectionTable_GetByApiFd);
+    LONGBOW_RUN_TEST_CASE(Global, rtaConnectionTable_GetByApiFd_Many);
+    LONGBOW_RUN_TEST_CASE(Global, rtaConnectionTable_GetByApiFd_Duplicate);
     LONGBOW_RUN_TEST_CASE(Global, rtaConnectionTable_GetByTransportFd);
     LONGBOW_RUN_TEST_CASE(Global, rtaConnectionTable_Remove);
     LONGBOW_RUN_TEST_CASE(Global, rtaConnectionTable_RemoveByStack);
+    LONGBOW_RUN_TEST_CASE(Global, rtaConnectionTable_ForEachInStack);
 }
 
 typedef struct test_data {
-    PARCRingBuffer1x1 *commandRingBuffer;
+    RtaCommandQueue *commandQueue;
     PARCNotifier *commandNotifier;
 
     RtaFramework *framework;
@@ -132,10 +136,10 @@ LONGBOW_TEST_FIXTURE_SETUP(Global)
     // ---------------------------
     // To test a connection table, we need to create a Framework and a Protocol stack
 
-    data->commandRingBuffer = parcRingBuffer1x1_Create(128, NULL);
+    data->commandQueue = rtaCommandQueue_Create(128);
     data->commandNotifier = parcNotifier_Create();
 
-    data->framework = rtaFramework_Create(data->commandRingBuffer, data->commandNotifier);
+    data->framework = rtaFramework_Create(data->commandQueue, data->commandNotifier);
 
     // fake out a protocol stack
     data->stack_a = parcMemory_AllocateAndClear(sizeof(RtaProtocolStack));
@@ -159,7 +163,7 @@ LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
     // now cleanup everything
     rtaFramework_Destroy(&data->framework);
     parcNotifier_Release(&data->commandNotifier);
-    parcRingBuffer1x1_Release(&data->commandRingBuffer);
+    rtaCommandQueue_Release(&data->commandQueue);
 
     parcMemory_Deallocate((void **) &(data->stack_a));
     parcMemory_Deallocate((void **) &(data->stack_b));
@@ -214,6 +218,23 @@ LONGBOW_TEST_CASE(Global, rtaConnectionTable_AddConnection_TooMany)
     rtaConnectionTable_Destroy(&table);
 }
 
+LONGBOW_TEST_CASE(Global, rtaConnectionTable_Available)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    RtaConnection *conn = createConnection(data->stack_a, 2, 3);
+
+    RtaConnectionTable *table = rtaConnectionTable_Create(2, rtaConnection_Destroy);
+    assertTrue(rtaConnectionTable_Available(table) == 2, "Wrong room, expected 2 got %zu", rtaConnectionTable_Available(table));
+
+    rtaConnectionTable_AddConnection(table, conn);
+    assertTrue(rtaConnectionTable_Available(table) == 1, "Wrong room, expected 1 got %zu", rtaConnectionTable_Available(table));
+
+    rtaConnectionTable_Remove(table, conn);
+    assertTrue(rtaConnectionTable_Available(table) == 2, "Wrong room, expected 2 got %zu", rtaConnectionTable_Available(table));
+
+    rtaConnectionTable_Destroy(&table);
+}
+
 
 LONGBOW_TEST_CASE(Global, rtaConnectionTable_Create_Destroy)
 {
@@ -246,6 +267,76 @@ LONGBOW_TEST_CASE(Global, rtaConnectionTable_GetByApiFd)
     rtaConnectionTable_Destroy(&table);
 }
 
+/**
+ * Add enough connections to grow the api_fd index, remove every other one, and make
+ * sure each lookup finds the right connection or none
+ */
+LONGBOW_TEST_CASE(Global, rtaConnectionTable_GetByApiFd_Many)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    const int count = 200;
+    int pairs[count][2];
+    RtaConnection *connections[count];
+
+    RtaConnectionTable *table = rtaConnectionTable_Create(1000, rtaConnection_Destroy);
+    for (int i = 0; i < count; i++) {
+        socketpair(PF_LOCAL, SOCK_STREAM, 0, pairs[i]);
+        connections[i] = createConnection(data->stack_a, pairs[i][0], pairs[i][1]);
+        rtaConnectionTable_AddConnection(table, connections[i]);
+    }
+
+    for (int i = 0; i < count; i += 2) {
+        int res = rtaConnectionTable_Remove(table, connections[i]);
+        assertTrue(res == 0, "Got error from rtaConnectionTable_Remove: %d", res);
+    }
+
+    for (int i = 0; i < count; i++) {
+        RtaConnection *test = rtaConnectionTable_GetByApiFd(table, pairs[i][0]);
+        if (i % 2 == 0) {
+            assertNull(test, "Connection %d should have been removed", i);
+        } else {
+            assertTrue(test == connections[i], "Got wrong connection %d, expecting %p got %p", i, (void *) connections[i], (void *) test);
+        }
+    }
+
+    assertTrue(table->count_elements == (size_t) count / 2, "Wrong element count, got %zu", table->count_elements);
+    rtaConnectionTable_Destroy(&table);
+}
+
+/**
+ * The index holds the first connection added for an api_fd, and the second one takes
+ * its place when it is removed
+ */
+LONGBOW_TEST_CASE(Global, rtaConnectionTable_GetByApiFd_Duplicate)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    int a_pair[2];
+    int b_pair[2];
+    socketpair(PF_LOCAL, SOCK_STREAM, 0, a_pair);
+    socketpair(PF_LOCAL, SOCK_STREAM, 0, b_pair);
+
+    RtaConnectionTable *table = rtaConnectionTable_Create(1000, rtaConnection_Destroy);
+
+    RtaConnection *first = createConnection(data->stack_a, a_pair[0], a_pair[1]);
+    rtaConnectionTable_AddConnection(table, first);
+
+    RtaConnection *second = createConnection(data->stack_a, a_pair[0], b_pair[1]);
+    rtaConnectionTable_AddConnection(table, second);
+
+    RtaConnection *test = rtaConnectionTable_GetByApiFd(table, a_pair[0]);
+    assertTrue(test == first, "Got wrong connection, expecting %p got %p", (void *) first, (void *) test);
+
+    rtaConnectionTable_Remove(table, first);
+
+    test = rtaConnectionTable_GetByApiFd(table, a_pair[0]);
+    assertTrue(test == second, "Got wrong connection, expecting %p got %p", (void *) second, (void *) test);
+
+    rtaConnectionTable_Destroy(&table);
+    close(b_pair[0]);
+}
+
 LONGBOW_TEST_CASE(Global, rtaConnectionTable_GetByTransportFd)
 {
     TestData *data = longBowTestCase_GetClipBoardData(testCase);
@@ -342,6 +433,33 @@ LONGBOW_TEST_CASE(Global, rtaConnectionTable_RemoveByStack)
     rtaConnectionTable_Destroy(&table);
 }
 
+static void
+_countVisits(RtaConnection *connection, void *context)
+{
+    unsigned *count = context;
+    (*count)++;
+}
+
+LONGBOW_TEST_CASE(Global, rtaConnectionTable_ForEachInStack)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    int a_pair[2];
+    int b_pair[2];
+    socketpair(PF_LOCAL, SOCK_STREAM, 0, a_pair);
+    socketpair(PF_LOCAL, SOCK_STREAM, 0, b_pair);
+
+    RtaConnectionTable *table = rtaConnectionTable_Create(1000, rtaConnection_Destroy);
+    rtaConnectionTable_AddConnection(table, createConnection(data->stack_a, a_pair[0], a_pair[1]));
+    rtaConnectionTable_AddConnection(table, createConnection(data->stack_b, b_pair[0], b_pair[1]));
+
+    unsigned count = 0;
+    rtaConnectionTable_ForEachInStack(table, data->stack_a->stack_id, _countVisits, &count);
+    assertTrue(count == 1, "Wrong visit count for stack a, got %u expected 1", count);
+
+    rtaConnectionTable_Destroy(&table);
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -65,9 +65,10 @@
 #include <parc/algol/parc_SafeMemory.h>
 #include <LongBow/unit-test.h>
 #include <math.h>
+#include <sys/stat.h>
 
 typedef struct test_data {
-    PARCRingBuffer1x1 *commandRingBuffer;
+    RtaCommandQueue *commandQueue;
     PARCNotifier *commandNotifier;
     RtaFramework *framework;
 } TestData;
@@ -78,9 +79,9 @@ _createTestData(void)
 {
     TestData *data = parcMemory_AllocateAndClear(sizeof(TestData));
     assertNotNull(data, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(TestData));
-    data->commandRingBuffer = parcRingBuffer1x1_Create(128, NULL);
+    data->commandQueue = rtaCommandQueue_Create(128);
     data->commandNotifier = parcNotifier_Create();
-    data->framework = rtaFramework_Create(data->commandRingBuffer, data->commandNotifier);
+    data->framework = rtaFramework_Create(data->commandQueue, data->commandNotifier);
     rtaLogger_SetLogLevel(data->framework->logger, RtaLoggerFacility_Framework, PARCLogLevel_Debug);
     return data;
 }
@@ -88,7 +89,7 @@ _createTestData(void)
 static void
 _destroyTestData(TestData *data)
 {
-    parcRingBuffer1x1_Release(&data->commandRingBuffer);
+    rtaCommandQueue_Release(&data->commandQueue);
     parcNotifier_Release(&data->commandNotifier);
     rtaFramework_Destroy(&data->framework);
     parcMemory_Deallocate((void **) &data);
@@ -122,6 +123,7 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, rtaFramework_GetNextConnectionId);
     LONGBOW_RUN_TEST_CASE(Global, rtaFramework_GetStatus);
     LONGBOW_RUN_TEST_CASE(Global, rtaFramework_Start_Shutdown);
+    LONGBOW_RUN_TEST_CASE(Global, rtaFramework_DumpTrace);
     LONGBOW_RUN_TEST_CASE(Global, tick_cb);
 }
 
@@ -147,7 +149,7 @@ LONGBOW_TEST_CASE(Global, rtaFramework_Create_Destroy)
 {
     TestData *data = longBowTestCase_GetClipBoardData(testCase);
     assertNotNull(data->framework, "rtaFramework_Create returned null");
-    assertTrue(data->framework->commandRingBuffer == data->commandRingBuffer, "framework commandRingBuffer incorrect");
+    assertTrue(data->framework->commandQueue == data->commandQueue, "framework commandQueue incorrect");
     assertTrue(data->framework->commandNotifier == data->commandNotifier, "framework commandNotifier incorrect");
     assertNotNull(data->framework->commandEvent, "framework commandEvent is null");
 }
@@ -181,6 +183,29 @@ LONGBOW_TEST_CASE(Global, rtaFramework_Start_Shutdown)
     rtaFramework_Shutdown(data->framework);
 }
 
+LONGBOW_TEST_CASE(Global, rtaFramework_DumpTrace)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    RtaTraceRing *ring = rtaFramework_GetTraceRing(data->framework);
+    assertNotNull(ring, "Framework should always have a trace ring");
+
+    rtaTraceRing_Record(ring, 1, FC_VEGAS, RtaTraceEvent_InterestSent, 0);
+
+    char filename[] = "/tmp/test_rta_Framework.XXXXXX";
+    int fd = mkstemp(filename);
+    assertTrue(fd >= 0, "mkstemp failed: (%d) %s", errno, strerror(errno));
+    close(fd);
+
+    bool success = rtaFramework_DumpTrace(data->framework, filename);
+    assertTrue(success, "DumpTrace failed: (%d) %s", errno, strerror(errno));
+
+    struct stat statbuf;
+    assertTrue(stat(filename, &statbuf) == 0, "Could not stat %s", filename);
+    assertTrue(statbuf.st_size == sizeof(RtaTraceFileHeader) + sizeof(RtaTraceRecord),
+               "Wrong file size %lld", (long long) statbuf.st_size);
+    unlink(filename);
+}
+
 LONGBOW_TEST_CASE(Global, tick_cb)
 {
     ticks tic0, tic1;
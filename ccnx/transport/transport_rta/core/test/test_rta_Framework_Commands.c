@@ -81,7 +81,7 @@
 
 // ==============================================
 typedef struct test_data {
-    PARCRingBuffer1x1 *commandRingBuffer;
+    RtaCommandQueue *commandQueue;
     PARCNotifier *commandNotifier;
     RtaFramework *framework;
 
@@ -172,9 +172,9 @@ _commonSetup(void)
     assertTrue(success, "parcPublicKeySignerPkcs12Store_CreateFile() failed.");
 	close(fd);
 
-    data->commandRingBuffer = parcRingBuffer1x1_Create(128, NULL);
+    data->commandQueue = rtaCommandQueue_Create(128);
     data->commandNotifier = parcNotifier_Create();
-    data->framework = rtaFramework_Create(data->commandRingBuffer, data->commandNotifier);
+    data->framework = rtaFramework_Create(data->commandQueue, data->commandNotifier);
     return data;
 }
 
@@ -187,7 +187,7 @@ _commonTeardown(TestData *data)
         _stopNonThreaded(data);
     }
 
-    parcRingBuffer1x1_Release(&data->commandRingBuffer);
+    rtaCommandQueue_Release(&data->commandQueue);
     parcNotifier_Release(&data->commandNotifier);
 
     printf ("Destroying framework pid %d\n", getpid());
@@ -313,7 +313,10 @@ LONGBOW_TEST_FIXTURE(Local)
 {
     LONGBOW_RUN_TEST_CASE(Local, _rtaFramework_ExecuteCloseConnection);
     LONGBOW_RUN_TEST_CASE(Local, _rtaFramework_ExecuteCreateStack);
+    LONGBOW_RUN_TEST_CASE(Local, _rtaFramework_ExecuteCreateStack_FromDescriptor);
     LONGBOW_RUN_TEST_CASE(Local, _rtaFramework_ExecuteOpenConnection);
+    LONGBOW_RUN_TEST_CASE(Local, _rtaFramework_ExecuteOpenManyConnections);
+    LONGBOW_RUN_TEST_CASE(Local, _rtaFramework_ExecuteSnapshotStatistics);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Local)
@@ -433,6 +436,32 @@ LONGBOW_TEST_CASE(Local, _rtaFramework_ExecuteCreateStack)
     rtaCommandCreateProtocolStack_Release(&createStack);
 }
 
+LONGBOW_TEST_CASE(Local, _rtaFramework_ExecuteCreateStack_FromDescriptor)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    // past the initial size of holdersByStackId
+    int stack_id = 40;
+    CCNxTransportConfig *params = _createParams(data->bentpipe_LocalName, data->keystoreName, data->keystorePassword);
+    RtaStackDescriptor *descriptor = rtaStackDescriptor_Create(ccnxTransportConfig_GetStackConfig(params));
+    RtaCommandCreateProtocolStack *createStack = rtaCommandCreateProtocolStack_CreateFromDescriptor(stack_id, descriptor);
+
+    _rtaFramework_ExecuteCreateStack(data->framework, createStack);
+    rtaCommandCreateProtocolStack_Release(&createStack);
+
+    FrameworkProtocolHolder *holder = rtaFramework_GetProtocolStackByStackId(data->framework, stack_id);
+    assertNotNull(holder, "There is no protocol holder for this stack, not created?");
+    assertTrue(holder->kv_hash == rtaStackDescriptor_GetHash(descriptor), "The holder should have the descriptor hash");
+    assertNull(rtaFramework_GetProtocolStackByStackId(data->framework, stack_id - 1), "Found a holder for a stack never created");
+    assertNull(rtaFramework_GetProtocolStackByStackId(data->framework, 1000), "Found a holder past the end of the index");
+
+    rtaFramework_DestroyProtocolHolder(data->framework, holder);
+    assertNull(rtaFramework_GetProtocolStackByStackId(data->framework, stack_id), "The holder should be gone after destroy");
+
+    rtaStackDescriptor_Release(&descriptor);
+    ccnxTransportConfig_Destroy(&params);
+}
+
 LONGBOW_TEST_CASE(Local, _rtaFramework_ExecuteOpenConnection)
 {
     TestData *data = longBowTestCase_GetClipBoardData(testCase);
@@ -481,6 +510,101 @@ LONGBOW_TEST_CASE(Local, _rtaFramework_ExecuteOpenConnection)
     ccnxTransportConfig_Destroy(&params);
 }
 
+LONGBOW_TEST_CASE(Local, _rtaFramework_ExecuteOpenManyConnections)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    int stack_id = 7;
+    CCNxTransportConfig *params = _createParams(data->bentpipe_LocalName, data->keystoreName, data->keystorePassword);
+
+    RtaCommandCreateProtocolStack *createStack =
+        rtaCommandCreateProtocolStack_Create(stack_id, ccnxTransportConfig_GetStackConfig(params));
+    _rtaFramework_ExecuteCreateStack(data->framework, createStack);
+    rtaCommandCreateProtocolStack_Release(&createStack);
+
+    const size_t count = 3;
+    int pairs[count][2];
+    RtaCommandOpenManyConnections *openMany = rtaCommandOpenManyConnections_Create(count);
+    for (size_t i = 0; i < count; i++) {
+        socketpair(PF_LOCAL, SOCK_STREAM, 0, pairs[i]);
+
+        struct timeval timeout = { .tv_sec = 10, .tv_usec = 0 };
+        setsockopt(pairs[i][1], SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+        RtaCommandOpenConnection *openConnection = rtaCommandOpenConnection_Create(stack_id, pairs[i][1], pairs[i][0],
+                                                                                   ccnxConnectionConfig_GetJson(ccnxTransportConfig_GetConnectionConfig(params)));
+        rtaCommandOpenManyConnections_Add(openMany, openConnection);
+        rtaCommandOpenConnection_Release(&openConnection);
+    }
+
+    _rtaFramework_ExecuteOpenManyConnections(data->framework, openMany);
+    rtaCommandOpenManyConnections_Release(&openMany);
+
+    rtaFramework_NonThreadedStepCount(data->framework, 10);
+    for (size_t i = 0; i < count; i++) {
+        assertNotNull(rtaConnectionTable_GetByApiFd(data->framework->connectionTable, pairs[i][1]), "Connection %zu not in the table", i);
+        _assertConnectionOpen(pairs[i][1]);
+    }
+
+    // the bent pipe sends the first connection's Interest to the others
+    CCNxInterest *interest = trafficTools_CreateInterest();
+    CCNxName *truth_name = ccnxName_Copy(ccnxInterest_GetName(interest));
+
+    CCNxMetaMessage *message = ccnxMetaMessage_CreateFromInterest(interest);
+    bool success = rtaTransport_Send(NULL, pairs[0][1], message, CCNxStackTimeout_Never);
+    assertTrue(success, "Got error sending on the first socket: %s (%d)", strerror(errno), errno);
+    ccnxMetaMessage_Release(&message);
+
+    rtaFramework_NonThreadedStepCount(data->framework, 10);
+    _readAndCompareName(pairs[count - 1][1], truth_name);
+
+    ccnxName_Release(&truth_name);
+    ccnxInterest_Release(&interest);
+    ccnxTransportConfig_Destroy(&params);
+}
+
+LONGBOW_TEST_CASE(Local, _rtaFramework_ExecuteSnapshotStatistics)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    int stack_id = 6;
+    CCNxTransportConfig *params = _createParams(data->bentpipe_LocalName, data->keystoreName, data->keystorePassword);
+
+    RtaCommandCreateProtocolStack *createStack =
+        rtaCommandCreateProtocolStack_Create(stack_id, ccnxTransportConfig_GetStackConfig(params));
+    _rtaFramework_ExecuteCreateStack(data->framework, createStack);
+    rtaCommandCreateProtocolStack_Release(&createStack);
+
+    int alice_pair[2];
+    _openConnection(data->framework, params, stack_id, alice_pair);
+
+    RtaCommandSnapshotStatistics *snapshotStats = rtaCommandSnapshotStatistics_Create();
+    _rtaFramework_ExecuteSnapshotStatistics(data->framework, snapshotStats);
+    assertTrue(rtaCommandSnapshotStatistics_IsComplete(snapshotStats), "Executing the command should answer it");
+
+    uint64_t timeout = 0;
+    PARCJSON *snapshot = rtaCommandSnapshotStatistics_WaitSnapshot(snapshotStats, &timeout);
+    assertNotNull(snapshot, "Got null snapshot");
+
+    PARCJSONValue *value = parcJSON_GetValueByName(snapshot, "stacks");
+    assertTrue(value != NULL && parcJSONValue_IsArray(value), "Snapshot missing stacks array");
+    PARCJSONArray *stacks = parcJSONValue_GetArray(value);
+    assertTrue(parcJSONArray_GetLength(stacks) == 1, "Wrong stack count, got %zu", parcJSONArray_GetLength(stacks));
+
+    PARCJSON *stack = parcJSONValue_GetJSON(parcJSONArray_GetValue(stacks, 0));
+    value = parcJSON_GetValueByName(stack, "stackId");
+    assertTrue(parcJSONValue_GetInteger(value) == stack_id, "Wrong stackId, got %" PRId64, parcJSONValue_GetInteger(value));
+    assertNotNull(parcJSON_GetValueByName(stack, "components"), "Stack missing components");
+
+    value = parcJSON_GetValueByName(stack, "connections");
+    assertTrue(value != NULL && parcJSONValue_IsArray(value), "Stack missing connections array");
+    assertTrue(parcJSONArray_GetLength(parcJSONValue_GetArray(value)) == 1, "Wrong connection count");
+
+    parcJSON_Release(&snapshot);
+    rtaCommandSnapshotStatistics_Release(&snapshotStats);
+    ccnxTransportConfig_Destroy(&params);
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -60,10 +60,52 @@
  */
 
 #include "../rta_Framework_NonThreaded.c"
+#include "../rta_Framework_private.h"
+#include "../rta_Framework_Services.h"
 #include <parc/algol/parc_SafeMemory.h>
 
 #include <LongBow/unit-test.h>
 
+typedef struct test_data {
+    RtaCommandQueue *commandQueue;
+    PARCNotifier *commandNotifier;
+    RtaFramework *framework;
+
+    unsigned timerCount;
+    ticks timerFiredAt;
+} TestData;
+
+static TestData *
+_createTestData(void)
+{
+    TestData *data = parcMemory_AllocateAndClear(sizeof(TestData));
+    assertNotNull(data, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(TestData));
+    data->commandQueue = rtaCommandQueue_Create(128);
+    data->commandNotifier = parcNotifier_Create();
+    data->framework = rtaFramework_Create(data->commandQueue, data->commandNotifier);
+    return data;
+}
+
+static void
+_destroyTestData(TestData *data)
+{
+    if (data->framework->status == FRAMEWORK_SETUP) {
+        rtaFramework_Teardown(data->framework);
+    }
+    rtaCommandQueue_Release(&data->commandQueue);
+    parcNotifier_Release(&data->commandNotifier);
+    rtaFramework_Destroy(&data->framework);
+    parcMemory_Deallocate((void **) &data);
+}
+
+static void
+_timerCallback(RtaTimer *timer, void *arg)
+{
+    TestData *data = arg;
+    data->timerCount++;
+    data->timerFiredAt = rtaFramework_GetTicks(data->framework);
+}
+
 LONGBOW_TEST_RUNNER(rta_Framework_NonThreaded)
 {
     // The following Test Fixtures will run their corresponding Test Cases.
@@ -87,15 +129,22 @@ LONGBOW_TEST_RUNNER_TEARDOWN(rta_Framework_NonThreaded)
 
 LONGBOW_TEST_FIXTURE(Global)
 {
+    LONGBOW_RUN_TEST_CASE(Global, rtaFramework_NonThreadedEnableVirtualTime);
+    LONGBOW_RUN_TEST_CASE(Global, rtaFramework_NonThreadedAdvance_Ticks);
+    LONGBOW_RUN_TEST_CASE(Global, rtaFramework_NonThreadedAdvance_Timer);
+    LONGBOW_RUN_TEST_CASE(Global, rtaFramework_NonThreadedAdvance_Zero);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
 {
+    longBowTestCase_SetClipBoardData(testCase, _createTestData());
     return LONGBOW_STATUS_SUCCEEDED;
 }
 
 LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
 {
+    _destroyTestData(longBowTestCase_GetClipBoardData(testCase));
+
     uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
     if (outstandingAllocations != 0) {
         printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
@@ -104,6 +153,71 @@ LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
     return LONGBOW_STATUS_SUCCEEDED;
 }
 
+LONGBOW_TEST_CASE(Global, rtaFramework_NonThreadedEnableVirtualTime)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    int result = rtaFramework_NonThreadedEnableVirtualTime(data->framework);
+    assertTrue(result == 0, "Expected 0, got %d", result);
+    assertTrue(data->framework->virtualTime, "virtualTime not set");
+    assertTrue(data->framework->status == FRAMEWORK_SETUP, "Expected FRAMEWORK_SETUP, got %d", data->framework->status);
+}
+
+LONGBOW_TEST_CASE(Global, rtaFramework_NonThreadedAdvance_Ticks)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    rtaFramework_NonThreadedEnableVirtualTime(data->framework);
+
+    ticks start = rtaFramework_GetTicks(data->framework);
+
+    // real time passing must not move a virtual clock
+    usleep(5000);
+    rtaFramework_NonThreadedAdvance(data->framework, 0);
+    assertTrue(rtaFramework_GetTicks(data->framework) == start,
+               "Clock moved without Advance, expected %" PRIu64 " got %" PRIu64, start, rtaFramework_GetTicks(data->framework));
+
+    rtaFramework_NonThreadedAdvance(data->framework, 1000);
+    assertTrue(rtaFramework_GetTicks(data->framework) == start + 1000,
+               "Wrong clock, expected %" PRIu64 " got %" PRIu64, start + 1000, rtaFramework_GetTicks(data->framework));
+}
+
+LONGBOW_TEST_CASE(Global, rtaFramework_NonThreadedAdvance_Timer)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    rtaFramework_NonThreadedEnableVirtualTime(data->framework);
+
+    ticks start = rtaFramework_GetTicks(data->framework);
+    RtaTimer *timer = rtaFramework_CreateTimer(data->framework, _timerCallback, data);
+    rtaTimer_Schedule(timer, 250);
+
+    rtaFramework_NonThreadedAdvance(data->framework, 249);
+    assertTrue(data->timerCount == 0, "Timer fired early at %" PRIu64, data->timerFiredAt);
+
+    rtaFramework_NonThreadedAdvance(data->framework, 1);
+    assertTrue(data->timerCount == 1, "Timer should have fired once, got %u", data->timerCount);
+    assertTrue(data->timerFiredAt == start + 250,
+               "Timer fired at wrong tick, expected %" PRIu64 " got %" PRIu64, start + 250, data->timerFiredAt);
+
+    rtaTimer_Destroy(&timer);
+}
+
+LONGBOW_TEST_CASE(Global, rtaFramework_NonThreadedAdvance_Zero)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    rtaFramework_NonThreadedEnableVirtualTime(data->framework);
+
+    // a zero delay runs as a deferred event in the current tick
+    RtaTimer *timer = rtaFramework_CreateTimer(data->framework, _timerCallback, data);
+    rtaTimer_Schedule(timer, 0);
+
+    ticks start = rtaFramework_GetTicks(data->framework);
+    rtaFramework_NonThreadedAdvance(data->framework, 0);
+    assertTrue(data->timerCount == 1, "Timer should have fired once, got %u", data->timerCount);
+    assertTrue(data->timerFiredAt == start, "Timer fired at wrong tick, expected %" PRIu64 " got %" PRIu64, start, data->timerFiredAt);
+
+    rtaTimer_Destroy(&timer);
+}
+
 LONGBOW_TEST_FIXTURE(Local)
 {
 }
@@ -76,6 +76,7 @@ LONGBOW_TEST_RUNNER(rta_Framework_Threaded)
 // The Test Runner calls this function once before any Test Fixtures are run.
 LONGBOW_TEST_RUNNER_SETUP(rta_Framework_Threaded)
 {
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
     return LONGBOW_STATUS_SUCCEEDED;
 }
 
@@ -87,6 +88,8 @@ LONGBOW_TEST_RUNNER_TEARDOWN(rta_Framework_Threaded)
 
 LONGBOW_TEST_FIXTURE(Global)
 {
+    LONGBOW_RUN_TEST_CASE(Global, rtaFramework_SetCpu);
+    LONGBOW_RUN_TEST_CASE(Global, rtaFramework_SetThreadConfig);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -104,6 +107,59 @@ LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
     return LONGBOW_STATUS_SUCCEEDED;
 }
 
+LONGBOW_TEST_CASE(Global, rtaFramework_SetCpu)
+{
+    RtaCommandQueue *commandQueue = rtaCommandQueue_Create(128);
+    PARCNotifier *commandNotifier = parcNotifier_Create();
+    RtaFramework *framework = rtaFramework_Create(commandQueue, commandNotifier);
+    assertTrue(rtaThreadConfig_CpuCount(&framework->threadConfig) == 0, "New framework should not be pinned");
+
+    rtaFramework_SetCpu(framework, 0);
+    assertTrue(rtaThreadConfig_CpuCount(&framework->threadConfig) == 1 && rtaThreadConfig_HasCpu(&framework->threadConfig, 0),
+               "Wrong cpu, expected only cpu 0");
+
+    rtaFramework_Start(framework);
+
+#if defined(__linux__)
+    // the thread pins itself before it reports RUNNING
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    int failure = pthread_getaffinity_np(framework->thread, sizeof(cpuset), &cpuset);
+    assertFalse(failure, "pthread_getaffinity_np failed: %s", strerror(failure));
+    assertTrue(CPU_COUNT(&cpuset) == 1 && CPU_ISSET(0, &cpuset), "Framework thread not pinned to cpu 0");
+#endif
+
+    rtaFramework_Shutdown(framework);
+    rtaFramework_Destroy(&framework);
+    parcNotifier_Release(&commandNotifier);
+    rtaCommandQueue_Release(&commandQueue);
+}
+
+LONGBOW_TEST_CASE(Global, rtaFramework_SetThreadConfig)
+{
+    RtaCommandQueue *commandQueue = rtaCommandQueue_Create(128);
+    PARCNotifier *commandNotifier = parcNotifier_Create();
+    RtaFramework *framework = rtaFramework_Create(commandQueue, commandNotifier);
+
+    // An unprivileged test cannot get SCHED_FIFO, the failure is logged and the thread still runs on node 0
+    RtaThreadConfig config;
+    rtaThreadConfig_Init(&config);
+    config.policy = RtaThreadPolicy_Fifo;
+    config.priority = 1;
+    config.numaNode = 0;
+    rtaFramework_SetThreadConfig(framework, &config);
+    assertTrue(framework->threadConfig.numaNode == 0, "Wrong numa node, expected 0 got %d", framework->threadConfig.numaNode);
+
+    rtaFramework_Start(framework);
+    assertTrue(rtaFramework_GetStatus(framework) == FRAMEWORK_RUNNING, "Framework not running");
+    assertNotNull(framework->timerWheel, "Timer wheel not re-created on the framework thread");
+
+    rtaFramework_Shutdown(framework);
+    rtaFramework_Destroy(&framework);
+    parcNotifier_Release(&commandNotifier);
+    rtaCommandQueue_Release(&commandQueue);
+}
+
 LONGBOW_TEST_FIXTURE(Local)
 {
 }
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include "../rta_InlineQueue.c"
+
+#include <LongBow/unit-test.h>
+#include <parc/algol/parc_SafeMemory.h>
+
+#include <ccnx/common/ccnx_Interest.h>
+
+static CCNxMetaMessage *
+_createMessage(void)
+{
+    CCNxName *name = ccnxName_CreateFromCString("lci:/inline/queue");
+    CCNxInterest *interest = ccnxInterest_CreateSimple(name);
+    CCNxMetaMessage *message = ccnxMetaMessage_CreateFromInterest(interest);
+    ccnxInterest_Release(&interest);
+    ccnxName_Release(&name);
+    return message;
+}
+
+static void
+_countSignal(void *arg)
+{
+    unsigned *count = arg;
+    (*count)++;
+}
+
+LONGBOW_TEST_RUNNER(rta_InlineQueue)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+LONGBOW_TEST_RUNNER_SETUP(rta_InlineQueue)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_RUNNER_TEARDOWN(rta_InlineQueue)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, rtaInlineQueue_Create_Release);
+    LONGBOW_RUN_TEST_CASE(Global, rtaInlineQueue_Acquire);
+    LONGBOW_RUN_TEST_CASE(Global, rtaInlineQueue_Put_Get);
+    LONGBOW_RUN_TEST_CASE(Global, rtaInlineQueue_Grow);
+    LONGBOW_RUN_TEST_CASE(Global, rtaInlineQueue_IsFull);
+    LONGBOW_RUN_TEST_CASE(Global, rtaInlineQueue_Signal);
+    LONGBOW_RUN_TEST_CASE(Global, rtaInlineQueue_Release_NotEmpty);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, rtaInlineQueue_Create_Release)
+{
+    RtaInlineQueue *queue = rtaInlineQueue_Create(128, 50, NULL, NULL);
+    assertNotNull(queue, "Got null queue");
+    assertTrue(rtaInlineQueue_Count(queue) == 0, "New queue not empty");
+    assertNull(rtaInlineQueue_Get(queue), "Get on an empty queue should return NULL");
+
+    rtaInlineQueue_Release(&queue);
+    assertNull(queue, "Release did not null the pointer");
+}
+
+LONGBOW_TEST_CASE(Global, rtaInlineQueue_Acquire)
+{
+    RtaInlineQueue *queue = rtaInlineQueue_Create(128, 50, NULL, NULL);
+    RtaInlineQueue *reference = rtaInlineQueue_Acquire(queue);
+    assertTrue(reference == queue, "Acquire returned a different pointer");
+    assertTrue(queue->refcount == 2, "Wrong refcount, got %u", queue->refcount);
+
+    rtaInlineQueue_Release(&reference);
+    assertTrue(queue->refcount == 1, "Wrong refcount, got %u", queue->refcount);
+    rtaInlineQueue_Release(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, rtaInlineQueue_Put_Get)
+{
+    RtaInlineQueue *queue = rtaInlineQueue_Create(128, 50, NULL, NULL);
+
+    CCNxMetaMessage *first = _createMessage();
+    CCNxMetaMessage *second = _createMessage();
+    rtaInlineQueue_Put(queue, ccnxMetaMessage_Acquire(first));
+    rtaInlineQueue_Put(queue, ccnxMetaMessage_Acquire(second));
+    assertTrue(rtaInlineQueue_Count(queue) == 2, "Wrong count, got %zu", rtaInlineQueue_Count(queue));
+
+    CCNxMetaMessage *test = rtaInlineQueue_Get(queue);
+    assertTrue(test == first, "Expected the first message first");
+    ccnxMetaMessage_Release(&test);
+
+    test = rtaInlineQueue_Get(queue);
+    assertTrue(test == second, "Expected the second message second");
+    ccnxMetaMessage_Release(&test);
+
+    assertTrue(rtaInlineQueue_Count(queue) == 0, "Wrong count, got %zu", rtaInlineQueue_Count(queue));
+
+    ccnxMetaMessage_Release(&first);
+    ccnxMetaMessage_Release(&second);
+    rtaInlineQueue_Release(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, rtaInlineQueue_Grow)
+{
+    RtaInlineQueue *queue = rtaInlineQueue_Create(128, 50, NULL, NULL);
+    CCNxMetaMessage *message = _createMessage();
+
+    // move the head off 0 so the growth has to unwrap the array
+    rtaInlineQueue_Put(queue, ccnxMetaMessage_Acquire(message));
+    CCNxMetaMessage *test = rtaInlineQueue_Get(queue);
+    ccnxMetaMessage_Release(&test);
+
+    size_t count = 5 * RTA_INLINE_QUEUE_INITIAL_CAPACITY;
+    for (size_t i = 0; i < count; i++) {
+        rtaInlineQueue_Put(queue, ccnxMetaMessage_Acquire(message));
+    }
+    assertTrue(rtaInlineQueue_Count(queue) == count, "Wrong count, expected %zu got %zu", count, rtaInlineQueue_Count(queue));
+    assertTrue(queue->capacity >= count, "Queue did not grow, capacity %zu", queue->capacity);
+
+    size_t drained = rtaInlineQueue_Drain(queue);
+    assertTrue(drained == count, "Wrong drain count, expected %zu got %zu", count, drained);
+
+    ccnxMetaMessage_Release(&message);
+    rtaInlineQueue_Release(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, rtaInlineQueue_IsFull)
+{
+    RtaInlineQueue *queue = rtaInlineQueue_Create(4, 2, NULL, NULL);
+
+    for (int i = 0; i < 3; i++) {
+        rtaInlineQueue_Put(queue, _createMessage());
+    }
+    assertFalse(rtaInlineQueue_IsFull(queue), "Queue full below the high water mark");
+
+    rtaInlineQueue_Put(queue, _createMessage());
+    assertTrue(rtaInlineQueue_IsFull(queue), "Queue not full at the high water mark");
+
+    // a full queue still takes messages
+    rtaInlineQueue_Put(queue, _createMessage());
+    assertTrue(rtaInlineQueue_Count(queue) == 5, "Wrong count, got %zu", rtaInlineQueue_Count(queue));
+
+    // stays full down to the low water mark
+    for (int i = 0; i < 3; i++) {
+        CCNxMetaMessage *test = rtaInlineQueue_Get(queue);
+        ccnxMetaMessage_Release(&test);
+    }
+    assertTrue(rtaInlineQueue_IsFull(queue), "Queue not full at the low water mark");
+
+    CCNxMetaMessage *test = rtaInlineQueue_Get(queue);
+    ccnxMetaMessage_Release(&test);
+    assertFalse(rtaInlineQueue_IsFull(queue), "Queue still full below the low water mark");
+
+    rtaInlineQueue_Release(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, rtaInlineQueue_Signal)
+{
+    unsigned signals = 0;
+    RtaInlineQueue *queue = rtaInlineQueue_Create(128, 50, _countSignal, &signals);
+
+    for (int i = 0; i < 3; i++) {
+        rtaInlineQueue_Put(queue, _createMessage());
+    }
+    assertTrue(signals == 3, "Expected a signal per put, got %u", signals);
+
+    rtaInlineQueue_Release(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, rtaInlineQueue_Release_NotEmpty)
+{
+    // The teardown checks that the messages are released with the queue
+    RtaInlineQueue *queue = rtaInlineQueue_Create(128, 50, NULL, NULL);
+    rtaInlineQueue_Put(queue, _createMessage());
+    rtaInlineQueue_Put(queue, _createMessage());
+    rtaInlineQueue_Release(&queue);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(rta_InlineQueue);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
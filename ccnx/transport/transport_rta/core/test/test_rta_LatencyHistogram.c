@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include "../rta_LatencyHistogram.c"
+
+#include <inttypes.h>
+
+#include <LongBow/unit-test.h>
+#include <parc/algol/parc_SafeMemory.h>
+
+LONGBOW_TEST_RUNNER(rta_LatencyHistogram)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Local);
+}
+
+LONGBOW_TEST_RUNNER_SETUP(rta_LatencyHistogram)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_RUNNER_TEARDOWN(rta_LatencyHistogram)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, rtaLatencyHistogram_Create_Destroy);
+    LONGBOW_RUN_TEST_CASE(Global, rtaLatencyHistogram_Record);
+    LONGBOW_RUN_TEST_CASE(Global, rtaLatencyHistogram_Record_Huge);
+    LONGBOW_RUN_TEST_CASE(Global, rtaLatencyHistogram_Add);
+    LONGBOW_RUN_TEST_CASE(Global, rtaLatencyHistogram_Reset);
+    LONGBOW_RUN_TEST_CASE(Global, rtaLatencyHistogram_GetValueAtPercentile);
+    LONGBOW_RUN_TEST_CASE(Global, rtaLatencyHistogram_GetValueAtPercentile_Empty);
+    LONGBOW_RUN_TEST_CASE(Global, rtaLatencyHistogram_ToJSON);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    longBowTestCase_SetClipBoardData(testCase, rtaLatencyHistogram_Create());
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    RtaLatencyHistogram *histogram = longBowTestCase_GetClipBoardData(testCase);
+    rtaLatencyHistogram_Destroy(&histogram);
+
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, rtaLatencyHistogram_Create_Destroy)
+{
+    RtaLatencyHistogram *histogram = rtaLatencyHistogram_Create();
+    assertNotNull(histogram, "Got null histogram");
+    assertTrue(rtaLatencyHistogram_GetCount(histogram) == 0, "New histogram should be empty");
+    rtaLatencyHistogram_Destroy(&histogram);
+    assertNull(histogram, "Destroy did not null the pointer");
+}
+
+LONGBOW_TEST_CASE(Global, rtaLatencyHistogram_Record)
+{
+    RtaLatencyHistogram *histogram = longBowTestCase_GetClipBoardData(testCase);
+
+    rtaLatencyHistogram_Record(histogram, 500);
+    rtaLatencyHistogram_Record(histogram, 100);
+    rtaLatencyHistogram_Record(histogram, 900);
+
+    assertTrue(rtaLatencyHistogram_GetCount(histogram) == 3, "Wrong count, got %" PRIu64, rtaLatencyHistogram_GetCount(histogram));
+    assertTrue(rtaLatencyHistogram_GetMin(histogram) == 100, "Wrong min, got %" PRIu64, rtaLatencyHistogram_GetMin(histogram));
+    assertTrue(rtaLatencyHistogram_GetMax(histogram) == 900, "Wrong max, got %" PRIu64, rtaLatencyHistogram_GetMax(histogram));
+    assertTrue(rtaLatencyHistogram_GetMean(histogram) == 500, "Wrong mean, got %" PRIu64, rtaLatencyHistogram_GetMean(histogram));
+}
+
+LONGBOW_TEST_CASE(Global, rtaLatencyHistogram_Record_Huge)
+{
+    RtaLatencyHistogram *histogram = longBowTestCase_GetClipBoardData(testCase);
+
+    rtaLatencyHistogram_Record(histogram, UINT64_MAX / 2);
+    assertTrue(histogram->buckets[RTA_HISTOGRAM_BUCKETS - 1] == 1, "Huge value should be in the last bucket");
+    assertTrue(rtaLatencyHistogram_GetValueAtPercentile(histogram, 100.0) == UINT64_MAX / 2, "Percentile should be capped at max");
+}
+
+LONGBOW_TEST_CASE(Global, rtaLatencyHistogram_Add)
+{
+    RtaLatencyHistogram *histogram = longBowTestCase_GetClipBoardData(testCase);
+    RtaLatencyHistogram *other = rtaLatencyHistogram_Create();
+
+    rtaLatencyHistogram_Record(histogram, 200);
+    rtaLatencyHistogram_Record(other, 50);
+    rtaLatencyHistogram_Record(other, 5000);
+
+    rtaLatencyHistogram_Add(histogram, other);
+
+    assertTrue(rtaLatencyHistogram_GetCount(histogram) == 3, "Wrong count, got %" PRIu64, rtaLatencyHistogram_GetCount(histogram));
+    assertTrue(rtaLatencyHistogram_GetMin(histogram) == 50, "Wrong min, got %" PRIu64, rtaLatencyHistogram_GetMin(histogram));
+    assertTrue(rtaLatencyHistogram_GetMax(histogram) == 5000, "Wrong max, got %" PRIu64, rtaLatencyHistogram_GetMax(histogram));
+    rtaLatencyHistogram_Destroy(&other);
+}
+
+LONGBOW_TEST_CASE(Global, rtaLatencyHistogram_Reset)
+{
+    RtaLatencyHistogram *histogram = longBowTestCase_GetClipBoardData(testCase);
+
+    rtaLatencyHistogram_Record(histogram, 200);
+    rtaLatencyHistogram_Reset(histogram);
+
+    assertTrue(rtaLatencyHistogram_GetCount(histogram) == 0, "Reset should clear the count");
+    assertTrue(rtaLatencyHistogram_GetMax(histogram) == 0, "Reset should clear the max");
+}
+
+/**
+ * 1000 samples of 1..1000 usec.  Each percentile must be at or above the true value and within one sub-bucket (1/16).
+ */
+LONGBOW_TEST_CASE(Global, rtaLatencyHistogram_GetValueAtPercentile)
+{
+    RtaLatencyHistogram *histogram = longBowTestCase_GetClipBoardData(testCase);
+
+    for (uint64_t i = 1; i <= 1000; i++) {
+        rtaLatencyHistogram_Record(histogram, i * 1000);
+    }
+
+    double percentiles[] = { 50.0, 90.0, 99.0 };
+    for (int i = 0; i < sizeof(percentiles) / sizeof(percentiles[0]); i++) {
+        uint64_t truth = (uint64_t) (percentiles[i] * 10.0) * 1000;
+        uint64_t test = rtaLatencyHistogram_GetValueAtPercentile(histogram, percentiles[i]);
+        assertTrue(test >= truth && test <= truth + truth / 16,
+                   "p%.1f wrong, got %" PRIu64 " expected about %" PRIu64, percentiles[i], test, truth);
+    }
+
+    assertTrue(rtaLatencyHistogram_GetValueAtPercentile(histogram, 100.0) == 1000000, "p100 should be the max");
+}
+
+LONGBOW_TEST_CASE(Global, rtaLatencyHistogram_GetValueAtPercentile_Empty)
+{
+    RtaLatencyHistogram *histogram = longBowTestCase_GetClipBoardData(testCase);
+    assertTrue(rtaLatencyHistogram_GetValueAtPercentile(histogram, 99.0) == 0, "Empty histogram should return 0");
+}
+
+LONGBOW_TEST_CASE(Global, rtaLatencyHistogram_ToJSON)
+{
+    RtaLatencyHistogram *histogram = longBowTestCase_GetClipBoardData(testCase);
+    rtaLatencyHistogram_Record(histogram, 100);
+    rtaLatencyHistogram_Record(histogram, 300);
+
+    PARCJSON *json = rtaLatencyHistogram_ToJSON(histogram);
+
+    PARCJSONValue *value = parcJSON_GetValueByName(json, "count");
+    assertTrue(parcJSONValue_GetInteger(value) == 2, "Wrong count, got %" PRId64, parcJSONValue_GetInteger(value));
+    value = parcJSON_GetValueByName(json, "max");
+    assertTrue(parcJSONValue_GetInteger(value) == 300, "Wrong max, got %" PRId64, parcJSONValue_GetInteger(value));
+    assertNotNull(parcJSON_GetValueByName(json, "p999"), "Missing p999");
+
+    parcJSON_Release(&json);
+}
+
+// ======================================================================
+
+LONGBOW_TEST_FIXTURE(Local)
+{
+    LONGBOW_RUN_TEST_CASE(Local, _bucketIndex_RoundTrip);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Local)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Local)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/**
+ * Every value must fall within [lowest(index), lowest(index + 1))
+ */
+LONGBOW_TEST_CASE(Local, _bucketIndex_RoundTrip)
+{
+    for (uint64_t value = 0; value < (1ULL << 36); value = (value < 64) ? value + 1 : value + value / 7) {
+        unsigned index = _bucketIndex(value);
+        assertTrue(index < RTA_HISTOGRAM_BUCKETS, "Index %u out of range for %" PRIu64, index, value);
+        assertTrue(_lowestEquivalent(index) <= value, "Bucket %u starts above %" PRIu64, index, value);
+        if (index + 1 < RTA_HISTOGRAM_BUCKETS) {
+            assertTrue(value < _lowestEquivalent(index + 1), "Bucket %u ends below %" PRIu64, index, value);
+        }
+    }
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(rta_LatencyHistogram);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -59,6 +59,7 @@
 // Include the file(s) containing the functions to be tested.
 // This permits internal static functions to be visible to this Test Framework.
 #include "../rta_Logger.c"
+#include <inttypes.h>
 #include <stdio.h>
 #include <LongBow/unit-test.h>
 #include <parc/algol/parc_SafeMemory.h>
@@ -135,6 +136,11 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, rtaLogger_IsLoggable_False);
     LONGBOW_RUN_TEST_CASE(Global, rtaLogger_Log_IsLoggable);
     LONGBOW_RUN_TEST_CASE(Global, rtaLogger_Log_IsNotLoggable);
+    LONGBOW_RUN_TEST_CASE(Global, rtaLogger_StartAsync_StopAsync);
+    LONGBOW_RUN_TEST_CASE(Global, rtaLogger_Log_Async);
+    LONGBOW_RUN_TEST_CASE(Global, rtaLogger_Log_Async_Full);
+    LONGBOW_RUN_TEST_CASE(Global, rtaLogger_SetReporter_Async);
+    LONGBOW_RUN_TEST_CASE(Global, rtaLogger_SetRateLimit);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -251,6 +257,112 @@ LONGBOW_TEST_CASE(Global, rtaLogger_Log_IsNotLoggable)
     rtaLogger_Release(&logger);
 }
 
+LONGBOW_TEST_CASE(Global, rtaLogger_StartAsync_StopAsync)
+{
+    PARCLogReporter *reporter = _testWriter_Create();
+    RtaLogger *logger = rtaLogger_Create(reporter, parcClock_Wallclock());
+    parcLogReporter_Release(&reporter);
+
+    assertFalse(rtaLogger_IsAsync(logger), "New logger should be synchronous");
+    rtaLogger_StartAsync(logger, 100);
+    assertTrue(rtaLogger_IsAsync(logger), "Logger should be asynchronous");
+    assertTrue(logger->async->mask == 127, "Capacity should round up to 128, got mask %" PRIu64, logger->async->mask);
+
+    rtaLogger_StopAsync(logger);
+    assertFalse(rtaLogger_IsAsync(logger), "Logger should be synchronous after stop");
+    rtaLogger_Release(&logger);
+}
+
+LONGBOW_TEST_CASE(Global, rtaLogger_Log_Async)
+{
+    PARCLogReporter *reporter = _testWriter_Create();
+    RtaLogger *logger = rtaLogger_Create(reporter, parcClock_Wallclock());
+    parcLogReporter_Release(&reporter);
+
+    rtaLogger_SetLogLevel(logger, RtaLoggerFacility_Framework, PARCLogLevel_Warning);
+    rtaLogger_StartAsync(logger, 16);
+    memset(_lastLogMessage, 0, _logLength);
+
+    rtaLogger_Log(logger, RtaLoggerFacility_Framework, PARCLogLevel_Warning, __func__, "hello %d", 42);
+    rtaLogger_Flush(logger);
+
+    assertNotNull(strstr(_lastLogMessage, "hello 42"), "Did not write the formatted message, got '%s'", _lastLogMessage);
+    assertTrue(rtaLogger_GetDroppedCount(logger, RtaLoggerFacility_Framework) == 0, "Should not have dropped");
+    rtaLogger_Release(&logger);
+}
+
+LONGBOW_TEST_CASE(Global, rtaLogger_Log_Async_Full)
+{
+    PARCLogReporter *reporter = _testWriter_Create();
+    RtaLogger *logger = rtaLogger_Create(reporter, parcClock_Wallclock());
+    parcLogReporter_Release(&reporter);
+
+    rtaLogger_SetLogLevel(logger, RtaLoggerFacility_Codec, PARCLogLevel_Warning);
+
+    // fill the queue without a writer thread, then hand it to one
+    _RtaLoggerAsync *async = parcMemory_AllocateAndClear(sizeof(_RtaLoggerAsync));
+    async->records = parcMemory_AllocateAndClear(4 * sizeof(_RtaLoggerRecord));
+    for (int i = 0; i < 4; i++) {
+        async->records[i].sequence = i;
+    }
+    async->mask = 3;
+    logger->async = async;
+
+    for (int i = 0; i < 6; i++) {
+        rtaLogger_Log(logger, RtaLoggerFacility_Codec, PARCLogLevel_Warning, __func__, "message %d", i);
+    }
+    assertTrue(rtaLogger_GetDroppedCount(logger, RtaLoggerFacility_Codec) == 2,
+               "Expected 2 drops, got %" PRIu64, rtaLogger_GetDroppedCount(logger, RtaLoggerFacility_Codec));
+
+    memset(_lastLogMessage, 0, _logLength);
+    size_t drained = _rtaLoggerAsync_Drain(logger);
+    assertTrue(drained == 4, "Expected 4 messages, got %zu", drained);
+    assertNotNull(strstr(_lastLogMessage, "message 3"), "Wrong last message '%s'", _lastLogMessage);
+
+    // slots are reusable after the drain
+    rtaLogger_Log(logger, RtaLoggerFacility_Codec, PARCLogLevel_Warning, __func__, "again");
+    assertTrue(rtaLogger_GetDroppedCount(logger, RtaLoggerFacility_Codec) == 2, "Should have queued after drain");
+    _rtaLoggerAsync_Drain(logger);
+
+    logger->async = NULL;
+    parcMemory_Deallocate((void **) &async->records);
+    parcMemory_Deallocate((void **) &async);
+    rtaLogger_Release(&logger);
+}
+
+LONGBOW_TEST_CASE(Global, rtaLogger_SetReporter_Async)
+{
+    PARCLogReporter *reporter = _testWriter_Create();
+    RtaLogger *logger = rtaLogger_Create(reporter, parcClock_Wallclock());
+
+    rtaLogger_StartAsync(logger, 32);
+    rtaLogger_SetReporter(logger, reporter);
+    parcLogReporter_Release(&reporter);
+
+    assertTrue(rtaLogger_IsAsync(logger), "Logger should stay asynchronous");
+    assertTrue(logger->async->mask == 31, "Capacity should be kept, got mask %" PRIu64, logger->async->mask);
+    rtaLogger_Release(&logger);
+}
+
+LONGBOW_TEST_CASE(Global, rtaLogger_SetRateLimit)
+{
+    PARCLogReporter *reporter = _testWriter_Create();
+    RtaLogger *logger = rtaLogger_Create(reporter, parcClock_Wallclock());
+    parcLogReporter_Release(&reporter);
+
+    rtaLogger_SetLogLevel(logger, RtaLoggerFacility_Flowcontrol, PARCLogLevel_Info);
+    rtaLogger_SetRateLimit(logger, RtaLoggerFacility_Flowcontrol, 5);
+
+    // the window may roll over once during the loop, which lets through at most another 5
+    for (int i = 0; i < 100; i++) {
+        rtaLogger_Log(logger, RtaLoggerFacility_Flowcontrol, PARCLogLevel_Info, __func__, "message %d", i);
+    }
+
+    uint64_t limited = rtaLogger_GetRateLimitedCount(logger, RtaLoggerFacility_Flowcontrol);
+    assertTrue(limited >= 90 && limited <= 95, "Expected 90 to 95 limited, got %" PRIu64, limited);
+    assertTrue(rtaLogger_GetRateLimitedCount(logger, RtaLoggerFacility_Codec) == 0, "Other facilities should not be limited");
+    rtaLogger_Release(&logger);
+}
 
 // ==========================================================
 
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include "../rta_MpscRing.c"
+
+#include <unistd.h>
+#include <LongBow/unit-test.h>
+#include <parc/algol/parc_SafeMemory.h>
+
+#include <ccnx/transport/common/transport.h>
+
+static void *
+_getLater(void *ring)
+{
+    usleep(10000);
+    rtaMpscRing_Get(ring);
+    return NULL;
+}
+
+static void *
+_closeLater(void *ring)
+{
+    usleep(10000);
+    rtaMpscRing_Close(ring);
+    return NULL;
+}
+
+static uint64_t
+_nowUsec(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000 + (uint64_t) now.tv_nsec / 1000;
+}
+
+LONGBOW_TEST_RUNNER(rta_MpscRing)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+LONGBOW_TEST_RUNNER_SETUP(rta_MpscRing)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_RUNNER_TEARDOWN(rta_MpscRing)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, rtaMpscRing_Init_Fini);
+    LONGBOW_RUN_TEST_CASE(Global, rtaMpscRing_Put_Get);
+    LONGBOW_RUN_TEST_CASE(Global, rtaMpscRing_Put_Timeout);
+    LONGBOW_RUN_TEST_CASE(Global, rtaMpscRing_Put_WaitsForRoom);
+    LONGBOW_RUN_TEST_CASE(Global, rtaMpscRing_Close_WakesWaiter);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, rtaMpscRing_Init_Fini)
+{
+    RtaMpscRing ring;
+    rtaMpscRing_Init(&ring, 5);
+    assertTrue(rtaMpscRing_Capacity(&ring) == 8, "Capacity 5 should round up to 8, got %zu", rtaMpscRing_Capacity(&ring));
+    assertTrue(rtaMpscRing_Count(&ring) == 0, "New ring not empty");
+    assertNull(rtaMpscRing_Get(&ring), "Get on an empty ring should return NULL");
+    assertFalse(rtaMpscRing_IsClosed(&ring), "New ring should not be closed");
+    rtaMpscRing_Fini(&ring);
+}
+
+LONGBOW_TEST_CASE(Global, rtaMpscRing_Put_Get)
+{
+    int items[4];
+    RtaMpscRing ring;
+    rtaMpscRing_Init(&ring, 4);
+
+    for (int i = 0; i < 4; i++) {
+        assertTrue(rtaMpscRing_TryPut(&ring, &items[i]), "TryPut %d with room failed", i);
+    }
+    assertFalse(rtaMpscRing_TryPut(&ring, &items[0]), "TryPut on a full ring should fail");
+    assertTrue(rtaMpscRing_Count(&ring) == 4, "Expected 4 items, got %zu", rtaMpscRing_Count(&ring));
+
+    for (int i = 0; i < 4; i++) {
+        void *item = rtaMpscRing_Get(&ring);
+        assertTrue(item == &items[i], "Item %d out of order", i);
+    }
+    assertNull(rtaMpscRing_Get(&ring), "Ring should be empty");
+
+    rtaMpscRing_Fini(&ring);
+}
+
+LONGBOW_TEST_CASE(Global, rtaMpscRing_Put_Timeout)
+{
+    int items[3];
+    RtaMpscRing ring;
+    rtaMpscRing_Init(&ring, 2);
+    rtaMpscRing_TryPut(&ring, &items[0]);
+    rtaMpscRing_TryPut(&ring, &items[1]);
+
+    assertFalse(rtaMpscRing_Put(&ring, &items[2], CCNxStackTimeout_Immediate), "Immediate put on a full ring should fail");
+    assertTrue(errno == EWOULDBLOCK, "Expected EWOULDBLOCK, got (%d) %s", errno, strerror(errno));
+
+    uint64_t timeout = 20000;
+    uint64_t start = _nowUsec();
+    assertFalse(rtaMpscRing_Put(&ring, &items[2], &timeout), "Timed put on a full ring should fail");
+    assertTrue(errno == EWOULDBLOCK, "Expected EWOULDBLOCK, got (%d) %s", errno, strerror(errno));
+    assertTrue(_nowUsec() - start >= timeout, "Timed put returned before its timeout");
+
+    rtaMpscRing_Get(&ring);
+    rtaMpscRing_Get(&ring);
+    rtaMpscRing_Fini(&ring);
+}
+
+LONGBOW_TEST_CASE(Global, rtaMpscRing_Put_WaitsForRoom)
+{
+    int items[3];
+    RtaMpscRing ring;
+    rtaMpscRing_Init(&ring, 2);
+    rtaMpscRing_TryPut(&ring, &items[0]);
+    rtaMpscRing_TryPut(&ring, &items[1]);
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, _getLater, &ring);
+    assertTrue(rtaMpscRing_Put(&ring, &items[2], CCNxStackTimeout_Never), "Put should succeed once the consumer makes room");
+    pthread_join(thread, NULL);
+
+    assertTrue(rtaMpscRing_Get(&ring) == &items[1], "Wrong item after the wait");
+    assertTrue(rtaMpscRing_Get(&ring) == &items[2], "Wrong item after the wait");
+    rtaMpscRing_Fini(&ring);
+}
+
+LONGBOW_TEST_CASE(Global, rtaMpscRing_Close_WakesWaiter)
+{
+    int items[3];
+    RtaMpscRing ring;
+    rtaMpscRing_Init(&ring, 2);
+    rtaMpscRing_TryPut(&ring, &items[0]);
+    rtaMpscRing_TryPut(&ring, &items[1]);
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, _closeLater, &ring);
+    assertFalse(rtaMpscRing_Put(&ring, &items[2], CCNxStackTimeout_Never), "Put on a closed ring should fail");
+    assertTrue(errno == EPIPE, "Expected EPIPE, got (%d) %s", errno, strerror(errno));
+    pthread_join(thread, NULL);
+
+    assertTrue(rtaMpscRing_IsClosed(&ring), "Ring should be closed");
+    rtaMpscRing_Get(&ring);
+    rtaMpscRing_Get(&ring);
+    rtaMpscRing_Fini(&ring);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(rta_MpscRing);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -0,0 +1,493 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include "../rta_SendQueue.c"
+
+#include <unistd.h>
+#include <LongBow/unit-test.h>
+#include <parc/algol/parc_SafeMemory.h>
+
+#include <ccnx/common/ccnx_Interest.h>
+#include <ccnx/transport/common/transport.h>
+
+#define _producers 4
+#define _perProducer 500
+
+static CCNxMetaMessage *
+_createMessage(void)
+{
+    CCNxName *name = ccnxName_CreateFromCString("lci:/send/queue");
+    CCNxInterest *interest = ccnxInterest_CreateSimple(name);
+    CCNxMetaMessage *message = ccnxMetaMessage_CreateFromInterest(interest);
+    ccnxInterest_Release(&interest);
+    ccnxName_Release(&name);
+    return message;
+}
+
+typedef struct producer_args {
+    RtaSendQueue *queue;
+    CCNxMetaMessage **messages;
+} _ProducerArgs;
+
+static void *
+_producer(void *argVoid)
+{
+    _ProducerArgs *args = argVoid;
+    for (int i = 0; i < _perProducer; i++) {
+        bool success = rtaSendQueue_Put(args->queue, ccnxMetaMessage_Acquire(args->messages[i]), CCNxStackTimeout_Never);
+        assertTrue(success, "A put without a timeout failed");
+    }
+    return NULL;
+}
+
+static void *
+_getLater(void *queue)
+{
+    usleep(10000);
+    CCNxMetaMessage *message = rtaSendQueue_Get(queue);
+    ccnxMetaMessage_Release(&message);
+    return NULL;
+}
+
+static void
+_countWritable(void *arg)
+{
+    unsigned *count = arg;
+    (*count)++;
+}
+
+static void *
+_closeLater(void *queue)
+{
+    usleep(10000);
+    rtaSendQueue_Close(queue);
+    return NULL;
+}
+
+LONGBOW_TEST_RUNNER(rta_SendQueue)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+LONGBOW_TEST_RUNNER_SETUP(rta_SendQueue)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_RUNNER_TEARDOWN(rta_SendQueue)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, rtaSendQueue_Create_Release);
+    LONGBOW_RUN_TEST_CASE(Global, rtaSendQueue_Capacity);
+    LONGBOW_RUN_TEST_CASE(Global, rtaSendQueue_Put_Get);
+    LONGBOW_RUN_TEST_CASE(Global, rtaSendQueue_Put_Full);
+    LONGBOW_RUN_TEST_CASE(Global, rtaSendQueue_Put_WaitsForRoom);
+    LONGBOW_RUN_TEST_CASE(Global, rtaSendQueue_Notify);
+    LONGBOW_RUN_TEST_CASE(Global, rtaSendQueue_TryPut);
+    LONGBOW_RUN_TEST_CASE(Global, rtaSendQueue_TryPut_Blocked);
+    LONGBOW_RUN_TEST_CASE(Global, rtaSendQueue_Writable_AfterUnblock);
+    LONGBOW_RUN_TEST_CASE(Global, rtaSendQueue_Writable_AfterRoom);
+    LONGBOW_RUN_TEST_CASE(Global, rtaSendQueue_Close);
+    LONGBOW_RUN_TEST_CASE(Global, rtaSendQueue_Close_WakesWaiter);
+    LONGBOW_RUN_TEST_CASE(Global, rtaSendQueue_Close_RemovesWritableSignal);
+    LONGBOW_RUN_TEST_CASE(Global, rtaSendQueue_Release_NotEmpty);
+    LONGBOW_RUN_TEST_CASE(Global, rtaSendQueue_ManyProducers);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, rtaSendQueue_Create_Release)
+{
+    RtaSendQueue *queue = rtaSendQueue_Create(8);
+    assertNotNull(queue, "Got null queue");
+    assertTrue(rtaSendQueue_Count(queue) == 0, "New queue not empty");
+    assertNull(rtaSendQueue_Get(queue), "Get on an empty queue should return NULL");
+
+    RtaSendQueue *reference = rtaSendQueue_Acquire(queue);
+    assertTrue(reference == queue, "Acquire returned a different pointer");
+    rtaSendQueue_Release(&reference);
+
+    rtaSendQueue_Release(&queue);
+    assertNull(queue, "Release did not null the pointer");
+}
+
+LONGBOW_TEST_CASE(Global, rtaSendQueue_Capacity)
+{
+    size_t capacities[][2] = { { 1, 2 }, { 4, 4 }, { 5, 8 }, { RTA_SEND_QUEUE_DEFAULT_CAPACITY, RTA_SEND_QUEUE_DEFAULT_CAPACITY } };
+
+    for (size_t i = 0; i < sizeof(capacities) / sizeof(capacities[0]); i++) {
+        RtaSendQueue *queue = rtaSendQueue_Create(capacities[i][0]);
+        assertTrue(rtaSendQueue_Capacity(queue) == capacities[i][1], "Capacity %zu should be %zu, got %zu",
+                   capacities[i][0], capacities[i][1], rtaSendQueue_Capacity(queue));
+        rtaSendQueue_Release(&queue);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, rtaSendQueue_Put_Get)
+{
+    RtaSendQueue *queue = rtaSendQueue_Create(4);
+    CCNxMetaMessage *messages[3];
+    for (int i = 0; i < 3; i++) {
+        messages[i] = _createMessage();
+    }
+
+    // go around the array a few times
+    for (int lap = 0; lap < 3; lap++) {
+        for (int i = 0; i < 3; i++) {
+            bool success = rtaSendQueue_Put(queue, ccnxMetaMessage_Acquire(messages[i]), CCNxStackTimeout_Immediate);
+            assertTrue(success, "Put failed on lap %d", lap);
+        }
+        assertTrue(rtaSendQueue_Count(queue) == 3, "Expected 3 messages, got %zu", rtaSendQueue_Count(queue));
+
+        for (int i = 0; i < 3; i++) {
+            CCNxMetaMessage *message = rtaSendQueue_Get(queue);
+            assertTrue(message == messages[i], "Out of order on lap %d, expected message %d", lap, i);
+            ccnxMetaMessage_Release(&message);
+        }
+        assertNull(rtaSendQueue_Get(queue), "Queue should be empty");
+    }
+
+    for (int i = 0; i < 3; i++) {
+        ccnxMetaMessage_Release(&messages[i]);
+    }
+    rtaSendQueue_Release(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, rtaSendQueue_Put_Full)
+{
+    RtaSendQueue *queue = rtaSendQueue_Create(2);
+    rtaSendQueue_Put(queue, _createMessage(), CCNxStackTimeout_Immediate);
+    rtaSendQueue_Put(queue, _createMessage(), CCNxStackTimeout_Immediate);
+
+    CCNxMetaMessage *message = _createMessage();
+    bool success = rtaSendQueue_Put(queue, message, CCNxStackTimeout_Immediate);
+    assertFalse(success, "Put on a full queue should fail");
+    assertTrue(errno == EWOULDBLOCK, "Expected EWOULDBLOCK, got %d", errno);
+
+    success = rtaSendQueue_Put(queue, message, CCNxStackTimeout_MicroSeconds(1000));
+    assertFalse(success, "Put on a full queue should time out");
+    assertTrue(errno == EWOULDBLOCK, "Expected EWOULDBLOCK, got %d", errno);
+
+    ccnxMetaMessage_Release(&message);
+    rtaSendQueue_Release(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, rtaSendQueue_Put_WaitsForRoom)
+{
+    RtaSendQueue *queue = rtaSendQueue_Create(2);
+    rtaSendQueue_Put(queue, _createMessage(), CCNxStackTimeout_Immediate);
+    rtaSendQueue_Put(queue, _createMessage(), CCNxStackTimeout_Immediate);
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, _getLater, queue);
+
+    bool success = rtaSendQueue_Put(queue, _createMessage(), CCNxStackTimeout_MicroSeconds(5000000));
+    assertTrue(success, "Put should have found the room the consumer made");
+    pthread_join(thread, NULL);
+
+    assertTrue(rtaSendQueue_Count(queue) == 2, "Expected 2 messages, got %zu", rtaSendQueue_Count(queue));
+    rtaSendQueue_Release(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, rtaSendQueue_Notify)
+{
+    RtaSendQueue *queue = rtaSendQueue_Create(4);
+
+    assertTrue(rtaSendQueue_Notify(queue), "The first notify should wake the consumer");
+    assertFalse(rtaSendQueue_Notify(queue), "A second notify should not wake the consumer again");
+
+    rtaSendQueue_ClearNotify(queue);
+    assertTrue(rtaSendQueue_Notify(queue), "The first notify after a clear should wake the consumer");
+
+    rtaSendQueue_Release(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, rtaSendQueue_TryPut)
+{
+    RtaSendQueue *queue = rtaSendQueue_Create(2);
+    assertTrue(rtaSendQueue_TryPut(queue, _createMessage()), "TryPut on an empty queue failed");
+    assertTrue(rtaSendQueue_TryPut(queue, _createMessage()), "TryPut with room failed");
+
+    CCNxMetaMessage *message = _createMessage();
+    assertFalse(rtaSendQueue_TryPut(queue, message), "TryPut on a full queue should fail");
+    assertTrue(errno == EWOULDBLOCK, "Expected EWOULDBLOCK, got %d", errno);
+    assertFalse(rtaSendQueue_IsBlocked(queue), "A full queue is not a blocked queue");
+
+    ccnxMetaMessage_Release(&message);
+    rtaSendQueue_Release(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, rtaSendQueue_TryPut_Blocked)
+{
+    RtaSendQueue *queue = rtaSendQueue_Create(4);
+    rtaSendQueue_SetBlocked(queue, true);
+    assertTrue(rtaSendQueue_IsBlocked(queue), "SetBlocked(true) did not block the queue");
+
+    CCNxMetaMessage *message = _createMessage();
+    assertFalse(rtaSendQueue_TryPut(queue, message), "TryPut on a blocked queue should fail");
+    assertTrue(errno == EWOULDBLOCK, "Expected EWOULDBLOCK, got %d", errno);
+    assertTrue(rtaSendQueue_Count(queue) == 0, "Expected an empty queue, got %zu", rtaSendQueue_Count(queue));
+
+    // Put still queues, the consumer takes it after the unblock
+    assertTrue(rtaSendQueue_Put(queue, message, CCNxStackTimeout_Immediate), "Put on a blocked queue with room failed");
+
+    rtaSendQueue_SetBlocked(queue, false);
+    assertFalse(rtaSendQueue_IsBlocked(queue), "SetBlocked(false) did not unblock the queue");
+    rtaSendQueue_Release(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, rtaSendQueue_Writable_AfterUnblock)
+{
+    unsigned count = 0;
+    RtaSendQueue *queue = rtaSendQueue_Create(4);
+    rtaSendQueue_SetWritableSignal(queue, _countWritable, &count);
+
+    // an unblock nobody waited for is not signalled
+    rtaSendQueue_SetBlocked(queue, true);
+    rtaSendQueue_SetBlocked(queue, false);
+    assertTrue(count == 0, "Signalled without a refused TryPut, got %u", count);
+
+    rtaSendQueue_SetBlocked(queue, true);
+    CCNxMetaMessage *message = _createMessage();
+    rtaSendQueue_TryPut(queue, message);
+    rtaSendQueue_TryPut(queue, message);
+    assertTrue(count == 0, "Signalled while blocked, got %u", count);
+
+    rtaSendQueue_SetBlocked(queue, false);
+    assertTrue(count == 1, "Expected one signal after the unblock, got %u", count);
+
+    // edge triggered, nothing more until the next refusal
+    rtaSendQueue_SetBlocked(queue, true);
+    rtaSendQueue_SetBlocked(queue, false);
+    assertTrue(count == 1, "Expected still one signal, got %u", count);
+
+    ccnxMetaMessage_Release(&message);
+    rtaSendQueue_Release(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, rtaSendQueue_Writable_AfterRoom)
+{
+    unsigned count = 0;
+    RtaSendQueue *queue = rtaSendQueue_Create(2);
+    rtaSendQueue_SetWritableSignal(queue, _countWritable, &count);
+    rtaSendQueue_TryPut(queue, _createMessage());
+    rtaSendQueue_TryPut(queue, _createMessage());
+
+    CCNxMetaMessage *message = _createMessage();
+    assertFalse(rtaSendQueue_TryPut(queue, message), "TryPut on a full queue should fail");
+
+    CCNxMetaMessage *first = rtaSendQueue_Get(queue);
+    ccnxMetaMessage_Release(&first);
+    assertTrue(count == 1, "Expected one signal after a get made room, got %u", count);
+
+    CCNxMetaMessage *second = rtaSendQueue_Get(queue);
+    ccnxMetaMessage_Release(&second);
+    assertTrue(count == 1, "Expected still one signal, got %u", count);
+
+    assertTrue(rtaSendQueue_TryPut(queue, message), "TryPut after the signal failed");
+    rtaSendQueue_Release(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, rtaSendQueue_Close)
+{
+    RtaSendQueue *queue = rtaSendQueue_Create(4);
+    rtaSendQueue_Put(queue, _createMessage(), CCNxStackTimeout_Immediate);
+    rtaSendQueue_Close(queue);
+
+    CCNxMetaMessage *message = _createMessage();
+    bool success = rtaSendQueue_Put(queue, message, CCNxStackTimeout_Immediate);
+    assertFalse(success, "Put on a closed queue should fail");
+    assertTrue(errno == EPIPE, "Expected EPIPE, got %d", errno);
+    ccnxMetaMessage_Release(&message);
+
+    // the message put before the close is still there
+    assertTrue(rtaSendQueue_Count(queue) == 1, "Expected 1 message, got %zu", rtaSendQueue_Count(queue));
+    rtaSendQueue_Release(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, rtaSendQueue_Close_WakesWaiter)
+{
+    RtaSendQueue *queue = rtaSendQueue_Create(2);
+    rtaSendQueue_Put(queue, _createMessage(), CCNxStackTimeout_Immediate);
+    rtaSendQueue_Put(queue, _createMessage(), CCNxStackTimeout_Immediate);
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, _closeLater, queue);
+
+    CCNxMetaMessage *message = _createMessage();
+    bool success = rtaSendQueue_Put(queue, message, CCNxStackTimeout_Never);
+    assertFalse(success, "Put should fail when the queue is closed");
+    assertTrue(errno == EPIPE, "Expected EPIPE, got %d", errno);
+    pthread_join(thread, NULL);
+
+    ccnxMetaMessage_Release(&message);
+    rtaSendQueue_Release(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, rtaSendQueue_Close_RemovesWritableSignal)
+{
+    unsigned count = 0;
+    RtaSendQueue *queue = rtaSendQueue_Create(4);
+    rtaSendQueue_SetWritableSignal(queue, _countWritable, &count);
+    rtaSendQueue_SetBlocked(queue, true);
+
+    CCNxMetaMessage *message = _createMessage();
+    rtaSendQueue_TryPut(queue, message);
+    rtaSendQueue_Close(queue);
+
+    rtaSendQueue_SetBlocked(queue, false);
+    assertTrue(count == 0, "Signalled after the close, got %u", count);
+
+    rtaSendQueue_SetWritableSignal(queue, _countWritable, &count);
+    assertNull(queue->writableSignal, "A closed queue should not take a writable signal");
+
+    ccnxMetaMessage_Release(&message);
+    rtaSendQueue_Release(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, rtaSendQueue_Release_NotEmpty)
+{
+    // The teardown checks that the messages are released with the queue
+    RtaSendQueue *queue = rtaSendQueue_Create(4);
+    rtaSendQueue_Put(queue, _createMessage(), CCNxStackTimeout_Immediate);
+    rtaSendQueue_Put(queue, _createMessage(), CCNxStackTimeout_Immediate);
+    rtaSendQueue_Release(&queue);
+}
+
+/*
+ * Producers on several threads fill a small queue while we drain it.  Every message
+ * arrives once, and each producer's messages arrive in the order it put them.
+ */
+LONGBOW_TEST_CASE(Global, rtaSendQueue_ManyProducers)
+{
+    RtaSendQueue *queue = rtaSendQueue_Create(16);
+
+    CCNxMetaMessage *messages[_producers][_perProducer];
+    for (int p = 0; p < _producers; p++) {
+        for (int i = 0; i < _perProducer; i++) {
+            messages[p][i] = _createMessage();
+        }
+    }
+
+    pthread_t threads[_producers];
+    _ProducerArgs args[_producers];
+    for (int p = 0; p < _producers; p++) {
+        args[p].queue = queue;
+        args[p].messages = messages[p];
+        pthread_create(&threads[p], NULL, _producer, &args[p]);
+    }
+
+    // The next message of each producer must be one of the heads
+    int next[_producers] = { 0 };
+    int received = 0;
+    while (received < _producers * _perProducer) {
+        CCNxMetaMessage *message = rtaSendQueue_Get(queue);
+        if (message == NULL) {
+            sched_yield();
+            continue;
+        }
+
+        bool found = false;
+        for (int p = 0; p < _producers && !found; p++) {
+            if (next[p] < _perProducer && messages[p][next[p]] == message) {
+                next[p]++;
+                found = true;
+            }
+        }
+        assertTrue(found, "Message %d is not the next message of any producer", received);
+        received++;
+        ccnxMetaMessage_Release(&message);
+    }
+
+    for (int p = 0; p < _producers; p++) {
+        pthread_join(threads[p], NULL);
+        for (int i = 0; i < _perProducer; i++) {
+            ccnxMetaMessage_Release(&messages[p][i]);
+        }
+    }
+    assertNull(rtaSendQueue_Get(queue), "Queue should be empty");
+
+    rtaSendQueue_Release(&queue);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(rta_SendQueue);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include "../rta_StackDescriptor.c"
+
+#include <LongBow/unit-test.h>
+#include <parc/algol/parc_SafeMemory.h>
+
+#include <ccnx/transport/transport_rta/config/config_All.h>
+
+LONGBOW_TEST_RUNNER(rta_StackDescriptor)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+LONGBOW_TEST_RUNNER_SETUP(rta_StackDescriptor)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_RUNNER_TEARDOWN(rta_StackDescriptor)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, rtaStackDescriptor_Create_Release);
+    LONGBOW_RUN_TEST_CASE(Global, rtaStackDescriptor_Acquire);
+    LONGBOW_RUN_TEST_CASE(Global, rtaStackDescriptor_GetComponent);
+    LONGBOW_RUN_TEST_CASE(Global, rtaStackDescriptor_GetHash);
+    LONGBOW_RUN_TEST_CASE(Global, rtaStackDescriptor_GetStackConfig_IsCopy);
+    LONGBOW_RUN_TEST_CASE(Global, rtaStackDescriptor_ComponentFromName);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static CCNxStackConfig *
+createStackConfig(void)
+{
+    CCNxStackConfig *stackConfig = ccnxStackConfig_Create();
+    protocolStack_ComponentsConfigArgs(stackConfig, apiConnector_GetName(), testingUpper_GetName(), testingLower_GetName(), NULL);
+    return stackConfig;
+}
+
+LONGBOW_TEST_CASE(Global, rtaStackDescriptor_Create_Release)
+{
+    CCNxStackConfig *stackConfig = createStackConfig();
+    RtaStackDescriptor *descriptor = rtaStackDescriptor_Create(stackConfig);
+    ccnxStackConfig_Release(&stackConfig);
+
+    assertNotNull(descriptor, "Got null descriptor");
+    rtaStackDescriptor_Release(&descriptor);
+    assertNull(descriptor, "Release did not null the pointer");
+}
+
+LONGBOW_TEST_CASE(Global, rtaStackDescriptor_Acquire)
+{
+    CCNxStackConfig *stackConfig = createStackConfig();
+    RtaStackDescriptor *descriptor = rtaStackDescriptor_Create(stackConfig);
+    ccnxStackConfig_Release(&stackConfig);
+
+    RtaStackDescriptor *second = rtaStackDescriptor_Acquire(descriptor);
+    assertTrue(second == descriptor, "Acquire returned a different pointer");
+
+    rtaStackDescriptor_Release(&descriptor);
+    assertTrue(rtaStackDescriptor_GetComponentCount(second) == 3, "The second reference should still be valid");
+    rtaStackDescriptor_Release(&second);
+}
+
+LONGBOW_TEST_CASE(Global, rtaStackDescriptor_GetComponent)
+{
+    CCNxStackConfig *stackConfig = createStackConfig();
+    RtaStackDescriptor *descriptor = rtaStackDescriptor_Create(stackConfig);
+    ccnxStackConfig_Release(&stackConfig);
+
+    RtaComponents expected[] = { API_CONNECTOR, TESTING_UPPER, TESTING_LOWER };
+    size_t count = rtaStackDescriptor_GetComponentCount(descriptor);
+    assertTrue(count == sizeof(expected) / sizeof(expected[0]), "Wrong component count, got %zu", count);
+
+    for (size_t i = 0; i < count; i++) {
+        RtaComponents actual = rtaStackDescriptor_GetComponent(descriptor, i);
+        assertTrue(actual == expected[i], "Wrong component %zu, got %d expected %d", i, actual, expected[i]);
+    }
+
+    rtaStackDescriptor_Release(&descriptor);
+}
+
+LONGBOW_TEST_CASE(Global, rtaStackDescriptor_GetHash)
+{
+    CCNxStackConfig *stackConfig = createStackConfig();
+    RtaStackDescriptor *descriptor = rtaStackDescriptor_Create(stackConfig);
+
+    assertTrue(rtaStackDescriptor_GetHash(descriptor) == ccnxStackConfig_HashCode(stackConfig),
+               "The descriptor hash should be the hash of the configuration");
+
+    ccnxStackConfig_Release(&stackConfig);
+    rtaStackDescriptor_Release(&descriptor);
+}
+
+LONGBOW_TEST_CASE(Global, rtaStackDescriptor_GetStackConfig_IsCopy)
+{
+    CCNxStackConfig *stackConfig = createStackConfig();
+    RtaStackDescriptor *descriptor = rtaStackDescriptor_Create(stackConfig);
+    PARCHashCode hash = rtaStackDescriptor_GetHash(descriptor);
+
+    CCNxStackConfig *frozen = rtaStackDescriptor_GetStackConfig(descriptor);
+    assertTrue(frozen != stackConfig, "The descriptor should hold a copy of the configuration");
+    assertTrue(ccnxStackConfig_Equals(frozen, stackConfig), "The copy should equal the configuration");
+
+    // changing the original does not change the descriptor
+    PARCJSONValue *value = parcJSONValue_CreateFromNULL();
+    ccnxStackConfig_Add(stackConfig, "key", value);
+    parcJSONValue_Release(&value);
+
+    assertFalse(ccnxStackConfig_Equals(frozen, stackConfig), "The copy should not see the change");
+    assertTrue(rtaStackDescriptor_GetHash(descriptor) == hash, "The descriptor hash should not change");
+
+    ccnxStackConfig_Release(&stackConfig);
+    rtaStackDescriptor_Release(&descriptor);
+}
+
+LONGBOW_TEST_CASE(Global, rtaStackDescriptor_ComponentFromName)
+{
+    assertTrue(rtaStackDescriptor_ComponentFromName(RtaComponentNames[FC_VEGAS]) == FC_VEGAS, "Wrong component for FC_VEGAS");
+    assertTrue(rtaStackDescriptor_ComponentFromName("fc_vegas") == FC_VEGAS, "The name should be matched ignoring case");
+    assertTrue(rtaStackDescriptor_ComponentFromName("NO_SUCH_COMPONENT") == UNKNOWN_COMPONENT, "Expected UNKNOWN_COMPONENT");
+    assertTrue(rtaStackDescriptor_ComponentFromName(NULL) == UNKNOWN_COMPONENT, "Expected UNKNOWN_COMPONENT for NULL");
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(rta_StackDescriptor);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include "../rta_ThreadConfig.c"
+
+#include <LongBow/unit-test.h>
+
+LONGBOW_TEST_RUNNER(rta_ThreadConfig)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+LONGBOW_TEST_RUNNER_SETUP(rta_ThreadConfig)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_RUNNER_TEARDOWN(rta_ThreadConfig)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, rtaThreadConfig_Init);
+    LONGBOW_RUN_TEST_CASE(Global, rtaThreadConfig_AddCpu);
+    LONGBOW_RUN_TEST_CASE(Global, rtaThreadConfig_ParseCpuList);
+    LONGBOW_RUN_TEST_CASE(Global, rtaThreadConfig_ParseCpuList_Invalid);
+    LONGBOW_RUN_TEST_CASE(Global, rtaThreadConfig_ParsePolicy);
+    LONGBOW_RUN_TEST_CASE(Global, rtaThreadConfig_Apply_Default);
+    LONGBOW_RUN_TEST_CASE(Global, rtaThreadConfig_Apply_BadPriority);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, rtaThreadConfig_Init)
+{
+    RtaThreadConfig config;
+    memset(&config, 0xFF, sizeof(config));
+    rtaThreadConfig_Init(&config);
+
+    assertTrue(rtaThreadConfig_CpuCount(&config) == 0, "New config should have no cpus, got %u", rtaThreadConfig_CpuCount(&config));
+    assertTrue(config.policy == RtaThreadPolicy_Default, "Wrong policy, got %d", config.policy);
+    assertTrue(config.numaNode == -1, "Wrong numa node, expected -1 got %d", config.numaNode);
+}
+
+LONGBOW_TEST_CASE(Global, rtaThreadConfig_AddCpu)
+{
+    RtaThreadConfig config;
+    rtaThreadConfig_Init(&config);
+
+    rtaThreadConfig_AddCpu(&config, 0);
+    rtaThreadConfig_AddCpu(&config, 65);
+    rtaThreadConfig_AddCpu(&config, 65);
+    rtaThreadConfig_AddCpu(&config, RTA_THREAD_CONFIG_MAX_CPUS - 1);
+
+    assertTrue(rtaThreadConfig_CpuCount(&config) == 3, "Expected 3 cpus, got %u", rtaThreadConfig_CpuCount(&config));
+    assertTrue(rtaThreadConfig_HasCpu(&config, 0), "Missing cpu 0");
+    assertTrue(rtaThreadConfig_HasCpu(&config, 65), "Missing cpu 65");
+    assertTrue(rtaThreadConfig_HasCpu(&config, RTA_THREAD_CONFIG_MAX_CPUS - 1), "Missing last cpu");
+    assertFalse(rtaThreadConfig_HasCpu(&config, 1), "Unexpected cpu 1");
+    assertFalse(rtaThreadConfig_HasCpu(&config, -1), "Out of range cpu should not be set");
+    assertFalse(rtaThreadConfig_HasCpu(&config, RTA_THREAD_CONFIG_MAX_CPUS), "Out of range cpu should not be set");
+}
+
+LONGBOW_TEST_CASE(Global, rtaThreadConfig_ParseCpuList)
+{
+    RtaThreadConfig config;
+    rtaThreadConfig_Init(&config);
+
+    bool success = rtaThreadConfig_ParseCpuList(&config, "0,2-5");
+    assertTrue(success, "Failed to parse a valid list");
+    assertTrue(rtaThreadConfig_CpuCount(&config) == 5, "Expected 5 cpus, got %u", rtaThreadConfig_CpuCount(&config));
+    assertFalse(rtaThreadConfig_HasCpu(&config, 1), "Unexpected cpu 1");
+    assertTrue(rtaThreadConfig_HasCpu(&config, 5), "Missing cpu 5");
+
+    // the format of /sys/devices/system/node/node*/cpulist, which ends with a newline
+    success = rtaThreadConfig_ParseCpuList(&config, "8\n");
+    assertTrue(success, "Failed to parse a list ending in a newline");
+    assertTrue(rtaThreadConfig_CpuCount(&config) == 6, "Expected 6 cpus, got %u", rtaThreadConfig_CpuCount(&config));
+}
+
+LONGBOW_TEST_CASE(Global, rtaThreadConfig_ParseCpuList_Invalid)
+{
+    const char *invalid[] = { "", "a", "1,", "1,,2", "3-1", "2-", "1 2", "4096", NULL };
+
+    for (int i = 0; invalid[i] != NULL; i++) {
+        RtaThreadConfig config;
+        rtaThreadConfig_Init(&config);
+        rtaThreadConfig_AddCpu(&config, 7);
+
+        bool success = rtaThreadConfig_ParseCpuList(&config, invalid[i]);
+        assertFalse(success, "Parsed invalid list '%s'", invalid[i]);
+        assertTrue(rtaThreadConfig_CpuCount(&config) == 1 && rtaThreadConfig_HasCpu(&config, 7),
+                   "Invalid list '%s' changed the config", invalid[i]);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, rtaThreadConfig_ParsePolicy)
+{
+    RtaThreadPolicy policies[] = { RtaThreadPolicy_Default, RtaThreadPolicy_Fifo, RtaThreadPolicy_RoundRobin };
+
+    for (size_t i = 0; i < sizeof(policies) / sizeof(policies[0]); i++) {
+        RtaThreadPolicy policy;
+        bool success = rtaThreadConfig_ParsePolicy(rtaThreadConfig_PolicyString(policies[i]), &policy);
+        assertTrue(success, "Failed to parse '%s'", rtaThreadConfig_PolicyString(policies[i]));
+        assertTrue(policy == policies[i], "Wrong policy, expected %d got %d", policies[i], policy);
+    }
+
+    RtaThreadPolicy policy = RtaThreadPolicy_Default;
+    assertTrue(rtaThreadConfig_ParsePolicy("FIFO", &policy) && policy == RtaThreadPolicy_Fifo, "Names should ignore case");
+    assertFalse(rtaThreadConfig_ParsePolicy("deadline", &policy), "Parsed an unknown policy");
+}
+
+LONGBOW_TEST_CASE(Global, rtaThreadConfig_Apply_Default)
+{
+    RtaThreadConfig config;
+    rtaThreadConfig_Init(&config);
+
+    int failure = rtaThreadConfig_Apply(&config);
+    assertTrue(failure == 0, "Applying the default config should do nothing, got %s", strerror(failure));
+}
+
+LONGBOW_TEST_CASE(Global, rtaThreadConfig_Apply_BadPriority)
+{
+    RtaThreadConfig config;
+    rtaThreadConfig_Init(&config);
+    config.policy = RtaThreadPolicy_Fifo;
+    config.priority = -5;
+
+    int failure = rtaThreadConfig_Apply(&config);
+    assertTrue(failure == EINVAL, "Expected EINVAL for a priority out of range, got %d", failure);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(rta_ThreadConfig);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -0,0 +1,421 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../rta_TimerWheel.c"
+#include <LongBow/unit-test.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+
+typedef struct test_data {
+    PARCEventScheduler *scheduler;
+    RtaTimerWheel *wheel;
+
+    unsigned fireCount;
+    uint64_t lastFireTime;
+
+    // used by the callbacks that manipulate timers
+    RtaTimer *other;
+    unsigned rescheduleCount;
+} TestData;
+
+static void
+_countCallback(RtaTimer *timer, void *arg)
+{
+    TestData *data = (TestData *) arg;
+    data->fireCount++;
+    data->lastFireTime = rtaTimerWheel_GetTime(data->wheel);
+}
+
+static void
+_cancelOtherCallback(RtaTimer *timer, void *arg)
+{
+    TestData *data = (TestData *) arg;
+    data->fireCount++;
+    rtaTimer_Cancel(data->other);
+}
+
+static void
+_rescheduleZeroCallback(RtaTimer *timer, void *arg)
+{
+    TestData *data = (TestData *) arg;
+    data->fireCount++;
+    if (data->rescheduleCount > 0) {
+        data->rescheduleCount--;
+        rtaTimer_Schedule(timer, 0);
+    }
+}
+
+LONGBOW_TEST_RUNNER(rta_TimerWheel)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Local);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(rta_TimerWheel)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(rta_TimerWheel)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// =========================================================
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, rtaTimerWheel_Create_Destroy);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTimerWheel_Advance_SkipsIdle);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTimerWheel_Destroy_WithPending);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTimerWheel_NextExpiry);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTimer_Schedule_FiresAtExpiry);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTimer_Schedule_Cascade);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTimer_Schedule_Reschedule);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTimer_Schedule_ZeroDelay);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTimer_Schedule_ZeroDelayFromCallback);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTimer_Cancel);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTimer_Cancel_FromCallback);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    TestData *data = parcMemory_AllocateAndClear(sizeof(TestData));
+    assertNotNull(data, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(TestData));
+    data->scheduler = parcEventScheduler_Create();
+    data->wheel = rtaTimerWheel_Create(data->scheduler, 0);
+    longBowTestCase_SetClipBoardData(testCase, data);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    rtaTimerWheel_Destroy(&data->wheel);
+    parcEventScheduler_Destroy(&data->scheduler);
+    parcMemory_Deallocate((void **) &data);
+
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, rtaTimerWheel_Create_Destroy)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    assertTrue(rtaTimerWheel_GetTime(data->wheel) == 0, "Wrong initial time, got %" PRIu64, rtaTimerWheel_GetTime(data->wheel));
+    assertTrue(rtaTimerWheel_PendingCount(data->wheel) == 0, "New wheel should be empty");
+}
+
+LONGBOW_TEST_CASE(Global, rtaTimerWheel_Advance_SkipsIdle)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    rtaTimerWheel_Advance(data->wheel, 1000000);
+    assertTrue(rtaTimerWheel_GetTime(data->wheel) == 1000000, "Wrong time, got %" PRIu64, rtaTimerWheel_GetTime(data->wheel));
+
+    // moving backwards does nothing
+    rtaTimerWheel_Advance(data->wheel, 10);
+    assertTrue(rtaTimerWheel_GetTime(data->wheel) == 1000000, "Wrong time, got %" PRIu64, rtaTimerWheel_GetTime(data->wheel));
+}
+
+LONGBOW_TEST_CASE(Global, rtaTimerWheel_Destroy_WithPending)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    RtaTimer *timer = rtaTimer_Create(data->wheel, _countCallback, data);
+    rtaTimer_Schedule(timer, 5000);
+
+    rtaTimerWheel_Destroy(&data->wheel);
+    assertFalse(rtaTimer_IsPending(timer), "Timer should be detached from a destroyed wheel");
+    rtaTimer_Destroy(&timer);
+
+    // so the teardown has something to destroy
+    data->wheel = rtaTimerWheel_Create(data->scheduler, 0);
+}
+
+LONGBOW_TEST_CASE(Global, rtaTimerWheel_NextExpiry)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    rtaTimerWheel_Advance(data->wheel, 123);
+    assertTrue(rtaTimerWheel_NextExpiry(data->wheel) == UINT64_MAX, "Empty wheel should have no expiry");
+
+    // in level 1, so the bound is where level 0 wraps
+    RtaTimer *far = rtaTimer_Create(data->wheel, _countCallback, data);
+    rtaTimer_Schedule(far, 1000);
+    uint64_t next = rtaTimerWheel_NextExpiry(data->wheel);
+    assertTrue(next == 256, "Expected the cascade at 256, got %" PRIu64, next);
+
+    RtaTimer *near = rtaTimer_Create(data->wheel, _countCallback, data);
+    rtaTimer_Schedule(near, 10);
+    next = rtaTimerWheel_NextExpiry(data->wheel);
+    assertTrue(next == 133, "Expected 133, got %" PRIu64, next);
+
+    // the bound never passes a timer
+    rtaTimerWheel_Advance(data->wheel, 256);
+    next = rtaTimerWheel_NextExpiry(data->wheel);
+    assertTrue(next == 512, "Expected the cascade at 512, got %" PRIu64, next);
+
+    rtaTimer_Schedule(near, 0);
+    next = rtaTimerWheel_NextExpiry(data->wheel);
+    assertTrue(next == 256, "A ready timer is due now, got %" PRIu64, next);
+
+    rtaTimer_Destroy(&near);
+    rtaTimer_Destroy(&far);
+}
+
+LONGBOW_TEST_CASE(Global, rtaTimer_Schedule_FiresAtExpiry)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    RtaTimer *timer = rtaTimer_Create(data->wheel, _countCallback, data);
+    rtaTimer_Schedule(timer, 10);
+
+    assertTrue(rtaTimer_IsPending(timer), "Timer should be pending");
+    assertTrue(rtaTimer_GetExpiry(timer) == 10, "Wrong expiry, got %" PRIu64, rtaTimer_GetExpiry(timer));
+
+    rtaTimerWheel_Advance(data->wheel, 9);
+    assertTrue(data->fireCount == 0, "Timer fired early at %" PRIu64, data->lastFireTime);
+
+    rtaTimerWheel_Advance(data->wheel, 10);
+    assertTrue(data->fireCount == 1, "Timer should have fired once, got %u", data->fireCount);
+    assertTrue(data->lastFireTime == 10, "Timer fired at wrong time %" PRIu64, data->lastFireTime);
+    assertFalse(rtaTimer_IsPending(timer), "Timer should not be pending after firing");
+
+    rtaTimer_Destroy(&timer);
+}
+
+LONGBOW_TEST_CASE(Global, rtaTimer_Schedule_Cascade)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    // one delay in each level, plus the edges of level 0 and level 1
+    uint64_t delays[] = { 1, 255, 256, 257, 1000, 65535, 65536, 70001, 16777300 };
+    const size_t count = sizeof(delays) / sizeof(delays[0]);
+
+    rtaTimerWheel_Advance(data->wheel, 123);
+
+    for (size_t i = 0; i < count; i++) {
+        RtaTimer *timer = rtaTimer_Create(data->wheel, _countCallback, data);
+        rtaTimer_Schedule(timer, delays[i]);
+
+        uint64_t expiry = 123 + delays[i];
+        rtaTimerWheel_Advance(data->wheel, expiry - 1);
+        assertTrue(data->fireCount == i, "Delay %" PRIu64 " fired early", delays[i]);
+
+        rtaTimerWheel_Advance(data->wheel, expiry);
+        assertTrue(data->fireCount == i + 1, "Delay %" PRIu64 " did not fire", delays[i]);
+        assertTrue(data->lastFireTime == expiry, "Delay %" PRIu64 " fired at %" PRIu64 " expected %" PRIu64,
+                   delays[i], data->lastFireTime, expiry);
+
+        rtaTimer_Destroy(&timer);
+        rtaTimerWheel_Destroy(&data->wheel);
+        data->wheel = rtaTimerWheel_Create(data->scheduler, 123);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, rtaTimer_Schedule_Reschedule)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    RtaTimer *timer = rtaTimer_Create(data->wheel, _countCallback, data);
+    rtaTimer_Schedule(timer, 10);
+    rtaTimer_Schedule(timer, 300);
+
+    assertTrue(rtaTimerWheel_PendingCount(data->wheel) == 1, "Reschedule should not add a second entry");
+
+    rtaTimerWheel_Advance(data->wheel, 299);
+    assertTrue(data->fireCount == 0, "Timer fired at its old expiry");
+
+    rtaTimerWheel_Advance(data->wheel, 300);
+    assertTrue(data->fireCount == 1, "Timer did not fire at its new expiry");
+
+    rtaTimer_Destroy(&timer);
+}
+
+LONGBOW_TEST_CASE(Global, rtaTimer_Schedule_ZeroDelay)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    RtaTimer *timer = rtaTimer_Create(data->wheel, _countCallback, data);
+    rtaTimer_Schedule(timer, 0);
+
+    assertTrue(rtaTimer_IsPending(timer), "Timer should be pending");
+    assertTrue(data->fireCount == 0, "Zero delay must not run inside the schedule call");
+
+    parcEventScheduler_Start(data->scheduler, PARCEventSchedulerDispatchType_NonBlocking);
+    assertTrue(data->fireCount == 1, "Zero delay timer should run from the event loop, got %u", data->fireCount);
+
+    rtaTimer_Destroy(&timer);
+}
+
+LONGBOW_TEST_CASE(Global, rtaTimer_Schedule_ZeroDelayFromCallback)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    RtaTimer *timer = rtaTimer_Create(data->wheel, _rescheduleZeroCallback, data);
+    data->rescheduleCount = 3;
+    rtaTimer_Schedule(timer, 0);
+
+    // each pass of the ready list runs the timer once, it does not spin
+    parcEventScheduler_Start(data->scheduler, PARCEventSchedulerDispatchType_NonBlocking);
+    assertTrue(data->fireCount == 1, "Timer should have run once per pass, got %u", data->fireCount);
+
+    while (rtaTimer_IsPending(timer)) {
+        parcEventScheduler_Start(data->scheduler, PARCEventSchedulerDispatchType_NonBlocking);
+    }
+    assertTrue(data->fireCount == 4, "Timer should have run 4 times, got %u", data->fireCount);
+
+    rtaTimer_Destroy(&timer);
+}
+
+LONGBOW_TEST_CASE(Global, rtaTimer_Cancel)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    RtaTimer *timer = rtaTimer_Create(data->wheel, _countCallback, data);
+    rtaTimer_Schedule(timer, 1000);
+    rtaTimer_Cancel(timer);
+
+    assertFalse(rtaTimer_IsPending(timer), "Timer should not be pending");
+    assertTrue(rtaTimerWheel_PendingCount(data->wheel) == 0, "Wheel should be empty");
+
+    rtaTimerWheel_Advance(data->wheel, 2000);
+    assertTrue(data->fireCount == 0, "Cancelled timer fired");
+
+    // cancel of an idle timer is a no-op
+    rtaTimer_Cancel(timer);
+    rtaTimer_Destroy(&timer);
+}
+
+LONGBOW_TEST_CASE(Global, rtaTimer_Cancel_FromCallback)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    RtaTimer *first = rtaTimer_Create(data->wheel, _cancelOtherCallback, data);
+    data->other = rtaTimer_Create(data->wheel, _countCallback, data);
+
+    // both expire on the same tick, the first one cancels the other
+    rtaTimer_Schedule(first, 5);
+    rtaTimer_Schedule(data->other, 5);
+
+    rtaTimerWheel_Advance(data->wheel, 5);
+    assertTrue(data->fireCount == 1, "Only the first timer should have fired, got %u", data->fireCount);
+    assertFalse(rtaTimer_IsPending(data->other), "Other timer should have been cancelled");
+
+    rtaTimer_Destroy(&first);
+    rtaTimer_Destroy(&data->other);
+}
+
+// =========================================================
+
+LONGBOW_TEST_FIXTURE(Local)
+{
+    LONGBOW_RUN_TEST_CASE(Local, _rtaTimerWheel_Insert_Level);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Local)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Local)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Local, _rtaTimerWheel_Insert_Level)
+{
+    PARCEventScheduler *scheduler = parcEventScheduler_Create();
+    RtaTimerWheel *wheel = rtaTimerWheel_Create(scheduler, 0);
+    RtaTimer *timer = rtaTimer_Create(wheel, _countCallback, NULL);
+
+    // nextTick is 1, so a delay of 256 is 255 ticks out and stays in level 0
+    rtaTimer_Schedule(timer, 256);
+    assertTrue(timer->bucket == &wheel->slots[0][0], "Delay 256 should be in level 0 slot 0");
+
+    rtaTimer_Schedule(timer, 257);
+    assertTrue(timer->bucket == &wheel->slots[1][1], "Delay 257 should be in level 1 slot 1");
+
+    rtaTimer_Schedule(timer, 1 << 24);
+    assertTrue(timer->bucket == &wheel->slots[2][0], "Delay 2^24 should be in level 2 slot 0");
+
+    rtaTimer_Schedule(timer, UINT64_MAX);
+    assertTrue(rtaTimer_GetExpiry(timer) == RTA_WHEEL_MAX_DELAY, "Long delay should be clamped, got %" PRIu64, rtaTimer_GetExpiry(timer));
+
+    rtaTimer_Destroy(&timer);
+    rtaTimerWheel_Destroy(&wheel);
+    parcEventScheduler_Destroy(&scheduler);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(rta_TimerWheel);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../rta_TraceRing.c"
+#include <LongBow/unit-test.h>
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+
+LONGBOW_TEST_RUNNER(rta_TraceRing)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(rta_TraceRing)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(rta_TraceRing)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// =========================================================
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, rtaTraceRing_Create_Destroy);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTraceRing_Create_RoundsUp);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTraceRing_Record);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTraceRing_RecordAt);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTraceRing_Record_Wraps);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTraceRing_WriteFile);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTraceEvent_ToString);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, rtaTraceRing_Create_Destroy)
+{
+    RtaTraceRing *ring = rtaTraceRing_Create(16);
+    assertNotNull(ring, "Got null ring");
+    assertTrue(rtaTraceRing_GetCapacity(ring) == 16, "Wrong capacity, got %zu", rtaTraceRing_GetCapacity(ring));
+    assertTrue(rtaTraceRing_GetCount(ring) == 0, "New ring should be empty");
+    rtaTraceRing_Destroy(&ring);
+    assertNull(ring, "Destroy did not null the pointer");
+}
+
+LONGBOW_TEST_CASE(Global, rtaTraceRing_Create_RoundsUp)
+{
+    RtaTraceRing *ring = rtaTraceRing_Create(100);
+    assertTrue(rtaTraceRing_GetCapacity(ring) == 128, "Wrong capacity, got %zu", rtaTraceRing_GetCapacity(ring));
+    rtaTraceRing_Destroy(&ring);
+}
+
+LONGBOW_TEST_CASE(Global, rtaTraceRing_Record)
+{
+    RtaTraceRing *ring = rtaTraceRing_Create(8);
+
+    rtaTraceRing_Record(ring, 3, FC_VEGAS, RtaTraceEvent_InterestSent, 10);
+    rtaTraceRing_Record(ring, 3, FC_VEGAS, RtaTraceEvent_Retransmit, 11);
+
+    assertTrue(rtaTraceRing_GetCount(ring) == 2, "Wrong count, got %zu", rtaTraceRing_GetCount(ring));
+
+    const RtaTraceRecord *first = rtaTraceRing_GetRecord(ring, 0);
+    const RtaTraceRecord *second = rtaTraceRing_GetRecord(ring, 1);
+
+    assertTrue(first->connectionId == 3, "Wrong connection id %u", first->connectionId);
+    assertTrue(first->component == FC_VEGAS, "Wrong component %u", first->component);
+    assertTrue(first->event == RtaTraceEvent_InterestSent, "Wrong event %u", first->event);
+    assertTrue(first->value == 10, "Wrong value %" PRIu64, first->value);
+    assertTrue(second->event == RtaTraceEvent_Retransmit, "Wrong event %u", second->event);
+    assertTrue(second->timestamp >= first->timestamp, "Timestamps went backwards");
+
+    rtaTraceRing_Destroy(&ring);
+}
+
+LONGBOW_TEST_CASE(Global, rtaTraceRing_RecordAt)
+{
+    RtaTraceRing *ring = rtaTraceRing_Create(8);
+
+    rtaTraceRing_RecordAt(ring, 123456789, 4, CODEC_TLV, RtaTraceEvent_Get, 7);
+
+    const RtaTraceRecord *record = rtaTraceRing_GetRecord(ring, 0);
+    assertTrue(record->timestamp == 123456789, "Wrong timestamp %" PRIu64, record->timestamp);
+    assertTrue(record->connectionId == 4, "Wrong connection id %u", record->connectionId);
+    assertTrue(record->event == RtaTraceEvent_Get, "Wrong event %u", record->event);
+    assertTrue(record->value == 7, "Wrong value %" PRIu64, record->value);
+
+    rtaTraceRing_Destroy(&ring);
+}
+
+LONGBOW_TEST_CASE(Global, rtaTraceRing_Record_Wraps)
+{
+    RtaTraceRing *ring = rtaTraceRing_Create(4);
+
+    for (uint64_t i = 0; i < 10; i++) {
+        rtaTraceRing_Record(ring, 1, API_CONNECTOR, RtaTraceEvent_Put, i);
+    }
+
+    assertTrue(rtaTraceRing_GetCount(ring) == 4, "Full ring should hold its capacity, got %zu", rtaTraceRing_GetCount(ring));
+
+    // the oldest surviving record is number 6
+    for (size_t i = 0; i < 4; i++) {
+        const RtaTraceRecord *record = rtaTraceRing_GetRecord(ring, i);
+        assertTrue(record->value == 6 + i, "Record %zu wrong value, expected %zu got %" PRIu64, i, 6 + i, record->value);
+    }
+
+    rtaTraceRing_Destroy(&ring);
+}
+
+LONGBOW_TEST_CASE(Global, rtaTraceRing_WriteFile)
+{
+    RtaTraceRing *ring = rtaTraceRing_Create(4);
+    for (uint64_t i = 0; i < 6; i++) {
+        rtaTraceRing_Record(ring, 2, CODEC_TLV, RtaTraceEvent_Get, i);
+    }
+
+    char filename[] = "/tmp/test_rta_TraceRing.XXXXXX";
+    int fd = mkstemp(filename);
+    assertTrue(fd >= 0, "mkstemp failed: (%d) %s", errno, strerror(errno));
+    close(fd);
+
+    bool success = rtaTraceRing_WriteFile(ring, filename);
+    assertTrue(success, "WriteFile failed: (%d) %s", errno, strerror(errno));
+
+    FILE *file = fopen(filename, "r");
+    assertNotNull(file, "Could not open %s", filename);
+
+    RtaTraceFileHeader header;
+    assertTrue(fread(&header, sizeof(header), 1, file) == 1, "Could not read header");
+    assertTrue(memcmp(header.magic, RTA_TRACE_FILE_MAGIC, sizeof(header.magic)) == 0, "Wrong magic");
+    assertTrue(header.version == RTA_TRACE_FILE_VERSION, "Wrong version %u", header.version);
+    assertTrue(header.recordSize == sizeof(RtaTraceRecord), "Wrong record size %u", header.recordSize);
+    assertTrue(header.capacity == 4, "Wrong capacity %" PRIu64, header.capacity);
+    assertTrue(header.written == 6, "Wrong written %" PRIu64, header.written);
+
+    RtaTraceRecord records[4];
+    assertTrue(fread(records, sizeof(RtaTraceRecord), 4, file) == 4, "Could not read records");
+    for (size_t i = 0; i < 4; i++) {
+        assertTrue(records[i].value == 2 + i, "Record %zu wrong value, expected %zu got %" PRIu64, i, 2 + i, records[i].value);
+    }
+
+    RtaTraceRecord extra;
+    assertTrue(fread(&extra, sizeof(RtaTraceRecord), 1, file) == 0, "File has trailing data");
+
+    fclose(file);
+    unlink(filename);
+    rtaTraceRing_Destroy(&ring);
+}
+
+LONGBOW_TEST_CASE(Global, rtaTraceEvent_ToString)
+{
+    assertTrue(strcmp(rtaTraceEvent_ToString(RtaTraceEvent_Retransmit), "retransmit") == 0,
+               "Wrong name %s", rtaTraceEvent_ToString(RtaTraceEvent_Retransmit));
+    assertTrue(strcmp(rtaTraceEvent_ToString(RtaTraceEvent_Last), "unknown") == 0,
+               "Wrong name %s", rtaTraceEvent_ToString(RtaTraceEvent_Last));
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(rta_TraceRing);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
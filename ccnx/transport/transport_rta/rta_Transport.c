@@ -80,13 +80,20 @@
 #include <inttypes.h>
 
 #include <string.h>
+#include <time.h>
 #include <fcntl.h>
 #include <sys/socket.h>
+#include <sys/queue.h>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#endif
 
 #include <parc/algol/parc_Memory.h>
 //#include <parc/logging/parc_Log.h>
 //#include <parc/logging/parc_LogReporterTextStdout.h>
-#include <parc/concurrent/parc_RingBuffer_1x1.h>
+#include <ccnx/transport/transport_rta/commands/rta_CommandQueue.h>
 #include <parc/concurrent/parc_Notifier.h>
 #include <parc/algol/parc_Deque.h>
 #include <parc/concurrent/parc_Synchronizer.h>
@@ -98,6 +105,13 @@
 #include <ccnx/transport/transport_rta/commands/rta_Command.h>
 #include <ccnx/transport/transport_rta/core/components.h>
 #include <ccnx/transport/transport_rta/core/rta_ConnectionTable.h>
+#include <ccnx/transport/transport_rta/core/rta_ConnectionCounters.h>
+#include <ccnx/transport/transport_rta/core/rta_Framework_Commands.h>
+#include <ccnx/transport/transport_rta/core/rta_InlineQueue.h>
+#include <ccnx/transport/transport_rta/core/rta_SendQueue.h>
+#include <ccnx/transport/transport_rta/core/rta_StackDescriptor.h>
+#include <ccnx/transport/transport_rta/core/rta_ThreadConfig.h>
+#include <ccnx/transport/transport_rta/config/config_ApiConnector.h>
 
 // These are some internal diagnostic counters used in the debugger
 // for when things are going really bad.  They are incremented on each
@@ -106,11 +120,15 @@ unsigned rta_transport_reads = 0;
 unsigned rta_transport_read_spin = 0;
 unsigned rta_transport_writes = 0;
 
+// How long Open and Close wait for room in a full command queue unless the options give a time
+#define RTA_TRANSPORT_COMMAND_TIMEOUT_USEC 1000000
+
 // ===================================================
 // The external interface
 
 const struct transport_operations rta_ops = {
     .Create       = (void * (*)(void)) rtaTransport_Create,
+    .CreateWithOptions = (void * (*)(const struct transport_instance_options *)) rtaTransport_CreateWithOptions,
     .Open         = (int (*)(void *, CCNxTransportConfig *)) rtaTransport_Open,
     .Send         = (int (*)(void *, int, CCNxMetaMessage *, const struct timeval *restrict timeout)) rtaTransport_Send,
     .Recv         = (TransportIOStatus (*)(void *, int, CCNxMetaMessage **, const struct timeval *restrict timeout)) rtaTransport_Recv,
@@ -124,14 +142,66 @@ const struct transport_operations rta_ops = {
  * @abstract Tracks the JSON descriptions of protocol stacks
  * @constant hash The hash of the JSON description
  * @constant stack_id the id of the stack associated with that hash
- * @constant list The linked-list member
+ * @constant descriptor The compiled description, shared with the Framework's stack
  * @discussion <#Discussion#>
  */
 typedef struct json_hash_table {
     PARCHashCode hash;
     int stack_id;
+    RtaStackDescriptor *descriptor;
 } _StackEntry;
 
+/**
+ * @typedef _BusyPoll
+ * @abstract Busy-poll state of a connection, see rtaTransport_SetBusyPoll()
+ * @discussion Only the thread in rtaTransport_Recv() writes the fields, with relaxed atomic
+ *   stores, so rtaTransport_GetBusyPollStats() can read them from any thread.
+ */
+typedef struct busy_poll {
+    uint64_t budgetUsec;
+    uint64_t windowUsec;
+    uint64_t spinHits;
+    uint64_t spinMisses;
+    uint64_t spinSkips;
+    uint64_t spinUsec;
+} _BusyPoll;
+
+/**
+ * @typedef _ConnectionEntry
+ * @abstract The counter block of an open connection, so the API can read it without the Framework
+ * @constant queueId The API side of the connection's socket pair
+ * @constant closed Set by rtaTransport_Close(), after which lookups do not find the entry
+ * @constant counters The counter block shared with the connection in the Framework
+ * @constant inlineQueue In inline mode, the queue the API connector puts messages on, otherwise NULL
+ * @constant sendQueue In threaded mode, the queue rtaTransport_Send() puts messages on, otherwise NULL
+ * @constant busyPoll The receive spin budget and its statistics
+ * @discussion A closed entry keeps its references until its queueId is opened again or the
+ *   transport is destroyed, so a thread that looked it up without the lock, just before the
+ *   close, still finds a valid (closed) send queue.
+ */
+typedef struct connection_entry {
+    int queueId;
+    bool closed;
+    RtaConnectionCounters *counters;
+    RtaInlineQueue *inlineQueue;
+    RtaSendQueue *sendQueue;
+    _BusyPoll busyPoll;
+    TAILQ_ENTRY(connection_entry) list;
+} _ConnectionEntry;
+
+/**
+ * @typedef _ConnectionIndex
+ * @abstract entries[queueId] is the connection on that queueId, or NULL
+ * @discussion Readers load the index and its slots with acquire loads and take no lock.  Writers
+ *   hold the lock on list.  A larger index replaces a smaller one, which stays allocated on the
+ *   retired chain until the transport is destroyed, because a reader may still be using it.
+ */
+typedef struct connection_index {
+    size_t length;
+    struct connection_index *retired;
+    _ConnectionEntry *entries[];
+} _ConnectionIndex;
+
 typedef struct socket_pair {
     int up;
     int down;
@@ -140,85 +210,519 @@ typedef struct socket_pair {
 struct rta_transport {
     RtaFramework  *framework;    /**< The RTA Framework holding the transport */
 
-    PARCRingBuffer1x1 *commandRingBuffer; /**< Written from Transport down to Framework */
+    RtaCommandQueue *commandQueue; /**< Written from Transport down to Framework */
+
+    PARCNotifier *commandNotifier; /**< Shared with the Framework to indicates writes to the command queue */
 
-    PARCNotifier *commandNotifier; /**< Shared with the Framework to indicates writes to the ring buffer */
+    uint64_t commandTimeoutUsec; /**< How long Open and Close wait for room in the command queue */
 
     unsigned int nextStackId;
 
     PARCDeque *list;
+
+    // The entries of list in an open-addressed table keyed on their hash, guarded by the
+    // lock on list.  stacksByHashLength is a power of 2 at least twice the number of stacks.
+    _StackEntry **stacksByHash;
+    size_t stacksByHashLength;
+
+    // open and closed connection entries, guarded by the lock on list
+    TAILQ_HEAD(, connection_entry) connections;
+
+    // The entry of each queueId.  Lookups are lock free, see _ConnectionIndex.
+    _ConnectionIndex *connectionsByQueueId;
+
+    // The number of connections with a busy-poll budget.  While 0, rtaTransport_Recv()
+    // does not look up the connection and never takes the lock.
+    unsigned busyPollConnections;
+
+    // In inline mode (rtaTransport_CreateInline) the framework runs on the caller's thread.
+    // queueIds are not descriptors, they count up from 1 and closed ones go on
+    // freeInlineQueueIds to be reused, as the kernel reuses closed descriptors.  wakeFds is
+    // a pipe whose read end is readable while the caller should run rtaTransport_Dispatch().
+    bool inlineMode;
+    int nextInlineQueueId;
+    int *freeInlineQueueIds;
+    size_t freeInlineQueueIdCount;
+    size_t freeInlineQueueIdCapacity;
+    int wakeFds[2];
+    bool wakeArmed;
+    unsigned inlineDelivered;
+
+    // The descriptor from rtaTransport_GetDispatchFd().  On Linux it is an epoll descriptor
+    // over the wake pipe, the forwarder sockets, and timerFd, which is armed to the next
+    // timer of the framework.  Elsewhere it is the read end of the wake pipe.
+    int dispatchFd;
+    int timerFd;
 };
 
-static _StackEntry *
-_rtaTransport_GetStack(const RTATransport *transport, PARCHashCode hash)
+/**
+ * The slot of stacksByHash holding `hash`, or the empty slot where it would go
+ */
+static size_t
+_rtaTransport_StackSlot(const RTATransport *transport, PARCHashCode hash)
 {
-    _StackEntry *result = NULL;
+    size_t mask = transport->stacksByHashLength - 1;
+    size_t slot = (size_t) hash & mask;
+    while (transport->stacksByHash[slot] != NULL && transport->stacksByHash[slot]->hash != hash) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
 
-    PARCIterator *iterator = parcDeque_Iterator(transport->list);
-    while (parcIterator_HasNext(iterator)) {
-        _StackEntry *entry = parcIterator_Next(iterator);
-        if (entry->hash == hash) {
-            result = entry;
-            break;
+/**
+ * Rebuild stacksByHash from the entries in list, sized for one more entry
+ */
+static void
+_rtaTransport_IndexStacks(RTATransport *transport)
+{
+    size_t count = parcDeque_Size(transport->list);
+    size_t length = 16;
+    while (length < 2 * (count + 1)) {
+        length *= 2;
+    }
+
+    if (length != transport->stacksByHashLength) {
+        if (transport->stacksByHash != NULL) {
+            parcMemory_Deallocate((void **) &transport->stacksByHash);
         }
+        transport->stacksByHash = parcMemory_Allocate(length * sizeof(_StackEntry *));
+        assertNotNull(transport->stacksByHash, "parcMemory_Allocate(%zu) returned NULL", length * sizeof(_StackEntry *));
+        transport->stacksByHashLength = length;
     }
-    parcIterator_Release(&iterator);
+    memset(transport->stacksByHash, 0, length * sizeof(_StackEntry *));
 
-    return result;
+    for (size_t index = 0; index < count; index++) {
+        _StackEntry *entry = parcDeque_GetAtIndex(transport->list, index);
+        transport->stacksByHash[_rtaTransport_StackSlot(transport, entry->hash)] = entry;
+    }
 }
 
 static _StackEntry *
-_rtaTransport_AddStack(RTATransport *transport, CCNxStackConfig *stackConfig)
+_rtaTransport_GetStack(const RTATransport *transport, PARCHashCode hash)
 {
-    PARCHashCode hash = ccnxStackConfig_HashCode(stackConfig);
+    if (transport->stacksByHashLength == 0) {
+        return NULL;
+    }
+    return transport->stacksByHash[_rtaTransport_StackSlot(transport, hash)];
+}
 
+/**
+ * Compile the configuration and add it to the stack table under a new stack_id
+ */
+static _StackEntry *
+_rtaTransport_AddStack(RTATransport *transport, CCNxStackConfig *stackConfig)
+{
     _StackEntry *entry = parcMemory_AllocateAndClear(sizeof(_StackEntry));
     assertNotNull(entry, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(_StackEntry));
-    entry->hash = hash;
+    entry->descriptor = rtaStackDescriptor_Create(stackConfig);
+    entry->hash = rtaStackDescriptor_GetHash(entry->descriptor);
     entry->stack_id = transport->nextStackId++;
 
+    // keep the table at most half full
+    if (2 * (parcDeque_Size(transport->list) + 1) > transport->stacksByHashLength) {
+        _rtaTransport_IndexStacks(transport);
+    }
+
     parcDeque_Append(transport->list, entry);
+    transport->stacksByHash[_rtaTransport_StackSlot(transport, entry->hash)] = entry;
 
     return entry;
 }
 
 static void
-_rtaTransport_CommandBufferEntryDestroyer(void **entryPtr)
+_rtaTransport_DestroyStackEntry(_StackEntry **entryPtr)
+{
+    _StackEntry *entry = *entryPtr;
+    rtaStackDescriptor_Release(&entry->descriptor);
+    parcMemory_Deallocate((void **) entryPtr);
+}
+
+/*
+ * Returns the open connection on queueId, or NULL.  Takes no lock, so any thread may call
+ * it at any time.  Like the descriptor itself, the entry is only valid until the application
+ * closes the queueId and opens it again.
+ */
+static _ConnectionEntry *
+_rtaTransport_GetConnectionEntry(const RTATransport *transport, int queueId)
+{
+    _ConnectionIndex *index = __atomic_load_n(&transport->connectionsByQueueId, __ATOMIC_ACQUIRE);
+    if (index != NULL && queueId >= 0 && (size_t) queueId < index->length) {
+        _ConnectionEntry *entry = __atomic_load_n(&index->entries[queueId], __ATOMIC_ACQUIRE);
+        if (entry != NULL && !__atomic_load_n(&entry->closed, __ATOMIC_ACQUIRE)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Makes the dispatch descriptor readable, if it is not already
+ */
+static void
+_rtaTransport_ArmWake(RTATransport *transport)
 {
+    if (!transport->wakeArmed) {
+        const uint8_t byte = 1;
+        ssize_t written = write(transport->wakeFds[1], &byte, sizeof(byte));
+        assertTrue(written == sizeof(byte), "write to the dispatch descriptor failed: (%d) %s", errno, strerror(errno));
+        transport->wakeArmed = true;
+    }
+}
+
+static void
+_rtaTransport_DisarmWake(RTATransport *transport)
+{
+    uint8_t buffer[16];
+    while (read(transport->wakeFds[0], buffer, sizeof(buffer)) > 0) {
+        // empty the pipe
+    }
+    transport->wakeArmed = false;
+}
+
+#if defined(__linux__)
+/*
+ * The framework's RtaFrameworkDescriptorWatcher.  Sockets are level triggered, so a socket
+ * a dispatch did not drain keeps waking the caller.  The connectors only watch the events
+ * they wait for, so a socket a blocked connector stopped reading does not.
+ */
+static void
+_rtaTransport_WatchDescriptor(void *transportVoid, int fd, PARCEventType events)
+{
+    RTATransport *transport = transportVoid;
+
+    if (events == 0) {
+        epoll_ctl(transport->dispatchFd, EPOLL_CTL_DEL, fd, NULL);
+        return;
+    }
+
+    struct epoll_event event = { .events = 0, .data.fd = fd };
+    if (events & PARCEventType_Read) {
+        event.events |= EPOLLIN | EPOLLRDHUP;
+    }
+    if (events & PARCEventType_Write) {
+        event.events |= EPOLLOUT;
+    }
+
+    int failure = epoll_ctl(transport->dispatchFd, EPOLL_CTL_ADD, fd, &event);
+    if (failure && errno == EEXIST) {
+        failure = epoll_ctl(transport->dispatchFd, EPOLL_CTL_MOD, fd, &event);
+    }
+    assertFalse(failure, "epoll_ctl failed on descriptor %d: (%d) %s", fd, errno, strerror(errno));
+}
+
+static void
+_rtaTransport_CreateDispatchFd(RTATransport *transport)
+{
+    transport->dispatchFd = epoll_create1(EPOLL_CLOEXEC);
+    assertFalse(transport->dispatchFd < 0, "epoll_create1 failed: (%d) %s", errno, strerror(errno));
+
+    transport->timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    assertFalse(transport->timerFd < 0, "timerfd_create failed: (%d) %s", errno, strerror(errno));
+
+    int fds[] = { transport->wakeFds[0], transport->timerFd };
+    for (int i = 0; i < 2; i++) {
+        struct epoll_event event = { .events = EPOLLIN, .data.fd = fds[i] };
+        int failure = epoll_ctl(transport->dispatchFd, EPOLL_CTL_ADD, fds[i], &event);
+        assertFalse(failure, "epoll_ctl failed on descriptor %d: (%d) %s", fds[i], errno, strerror(errno));
+    }
+
+    rtaFramework_NonThreadedSetDescriptorWatcher(transport->framework, _rtaTransport_WatchDescriptor, transport);
+}
+#endif
+
+/*
+ * Arms the timer of the dispatch descriptor to the next timer of the framework
+ */
+static void
+_rtaTransport_ArmDeadline(RTATransport *transport)
+{
+#if defined(__linux__)
+    uint64_t usec = rtaFramework_NonThreadedNextDeadline(transport->framework);
+
+    // an all zero it_value disarms the timer, so a deadline already due is 1 nanosecond
+    struct itimerspec spec = { { 0, 0 }, { 0, 0 } };
+    if (usec != UINT64_MAX) {
+        spec.it_value.tv_sec = usec / 1000000;
+        spec.it_value.tv_nsec = (usec % 1000000) * 1000;
+        if (usec == 0) {
+            spec.it_value.tv_nsec = 1;
+        }
+    }
+
+    int failure = timerfd_settime(transport->timerFd, 0, &spec, NULL);
+    assertFalse(failure, "timerfd_settime failed: (%d) %s", errno, strerror(errno));
+#endif
+}
+
+/*
+ * Clears the timer expirations the dispatch descriptor holds.  Everything else in it is
+ * level triggered and stays ready until the framework does the work.
+ */
+static void
+_rtaTransport_ClearDispatchFd(RTATransport *transport)
+{
+#if defined(__linux__)
+    uint64_t expirations;
+    while (read(transport->timerFd, &expirations, sizeof(expirations)) > 0) {
+        // the timer is re-armed after the dispatch
+    }
+#endif
+}
+
+/*
+ * Called by the inline queue of a connection when the API connector delivers a message
+ */
+static void
+_rtaTransport_InlineSignal(void *transportVoid)
+{
+    RTATransport *transport = transportVoid;
+    transport->inlineDelivered++;
+    _rtaTransport_ArmWake(transport);
+}
+
+/*
+ * Makes the index long enough for queueId.  Called with the lock held.
+ */
+static _ConnectionIndex *
+_rtaTransport_GrowConnectionIndex(RTATransport *transport, int queueId)
+{
+    _ConnectionIndex *index = transport->connectionsByQueueId;
+    if (index != NULL && (size_t) queueId < index->length) {
+        return index;
+    }
+
+    size_t length = index == NULL ? 64 : index->length;
+    while (length <= (size_t) queueId) {
+        length *= 2;
+    }
+
+    size_t bytes = sizeof(_ConnectionIndex) + length * sizeof(_ConnectionEntry *);
+    _ConnectionIndex *larger = parcMemory_AllocateAndClear(bytes);
+    assertNotNull(larger, "parcMemory_AllocateAndClear(%zu) returned NULL", bytes);
+    larger->length = length;
+    if (index != NULL) {
+        for (size_t i = 0; i < index->length; i++) {
+            larger->entries[i] = index->entries[i];
+        }
+    }
+
+    // readers may still be looking at the smaller index
+    larger->retired = index;
+    __atomic_store_n(&transport->connectionsByQueueId, larger, __ATOMIC_RELEASE);
+    return larger;
+}
+
+/*
+ * Releases everything the entry holds.  Called with the lock held, once no thread can be
+ * using the entry: its queueId is being reused, or the transport is destroyed.
+ */
+static void
+_rtaTransport_DestroyConnectionEntry(RTATransport *transport, _ConnectionEntry **entryPtr)
+{
+    _ConnectionEntry *entry = *entryPtr;
+    TAILQ_REMOVE(&transport->connections, entry, list);
+    rtaConnectionCounters_Release(&entry->counters);
+    if (entry->inlineQueue != NULL) {
+        rtaInlineQueue_Release(&entry->inlineQueue);
+    }
+    if (entry->sendQueue != NULL) {
+        rtaSendQueue_Release(&entry->sendQueue);
+    }
+    parcMemory_Deallocate((void **) entryPtr);
 }
 
+/*
+ * An inline queue holds as many messages as the API's end of a socket pair would, and
+ * unblocks at the write watermark, in pointers rather than bytes.
+ */
+static RtaInlineQueue *
+_rtaTransport_CreateInlineQueue(RTATransport *transport, const ApiConnectorQueueConfig *queueConfig)
+{
+    size_t highWater = queueConfig->receiveBufferBytes / sizeof(CCNxMetaMessage *);
+    size_t lowWater = queueConfig->writeWatermarkBytes / sizeof(CCNxMetaMessage *);
+    if (lowWater >= highWater) {
+        lowWater = highWater / 2;
+    }
+    if (lowWater == 0) {
+        lowWater = 1;
+    }
+    return rtaInlineQueue_Create(highWater, lowWater, _rtaTransport_InlineSignal, transport);
+}
+
+/*
+ * Creates the entry for a new connection.  Descriptors are small dense integers, so the
+ * index is an array that grows to the largest queueId.  Called with the lock held.
+ */
+static _ConnectionEntry *
+_rtaTransport_AddConnectionEntry(RTATransport *transport, int queueId, const ApiConnectorQueueConfig *queueConfig)
+{
+    _ConnectionIndex *index = _rtaTransport_GrowConnectionIndex(transport, queueId);
+
+    // the closed entry of an earlier connection on this queueId
+    _ConnectionEntry *previous = index->entries[queueId];
+    if (previous != NULL) {
+        assertTrue(previous->closed, "queueId %d is already open", queueId);
+        __atomic_store_n(&index->entries[queueId], NULL, __ATOMIC_RELEASE);
+        _rtaTransport_DestroyConnectionEntry(transport, &previous);
+    }
+
+    _ConnectionEntry *entry = parcMemory_AllocateAndClear(sizeof(_ConnectionEntry));
+    assertNotNull(entry, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(_ConnectionEntry));
+    entry->queueId = queueId;
+    entry->counters = rtaConnectionCounters_Create();
+    if (transport->inlineMode) {
+        entry->inlineQueue = _rtaTransport_CreateInlineQueue(transport, queueConfig);
+    } else {
+        entry->sendQueue = rtaSendQueue_Create(queueConfig->sendQueueDepth);
+        rtaConnectionCounters_SetLimit(entry->counters, RTA_LIMIT_SEND_QUEUE_DEPTH, rtaSendQueue_Capacity(entry->sendQueue));
+
+        // the kernel may round or double what we asked for, report what it uses
+        int receiveBuffer = 0;
+        socklen_t length = sizeof(receiveBuffer);
+        if (getsockopt(queueId, SOL_SOCKET, SO_RCVBUF, &receiveBuffer, &length) == 0) {
+            rtaConnectionCounters_SetLimit(entry->counters, RTA_LIMIT_RECEIVE_BUFFER, (uint64_t) receiveBuffer);
+        }
+    }
+    TAILQ_INSERT_TAIL(&transport->connections, entry, list);
+    __atomic_store_n(&index->entries[queueId], entry, __ATOMIC_RELEASE);
+    return entry;
+}
+
+/*
+ * Hides the entry from lookups and wakes any thread still waiting to send on it.  The
+ * entry keeps its references until _rtaTransport_DestroyConnectionEntry().  Called with
+ * the lock held.
+ */
+static void
+_rtaTransport_CloseConnectionEntry(RTATransport *transport, _ConnectionEntry *entry)
+{
+    __atomic_store_n(&entry->closed, true, __ATOMIC_RELEASE);
+    if (entry->busyPoll.budgetUsec > 0) {
+        __atomic_sub_fetch(&transport->busyPollConnections, 1, __ATOMIC_RELAXED);
+        __atomic_store_n(&entry->busyPoll.budgetUsec, 0, __ATOMIC_RELAXED);
+    }
+    if (entry->sendQueue != NULL) {
+        rtaSendQueue_Close(entry->sendQueue);
+    }
+}
+
+/*
+ * Puts the command on the command queue and wakes the Framework.  If the queue is full, waits up
+ * to `microSeconds` for the Framework to make room (NULL waits forever, 0 does not wait).
+ * Any number of threads may send at once.
+ *
+ * Returns false with errno EWOULDBLOCK if the queue stayed full.  The command was not sent.
+ */
 static bool
-_rtaTransport_SendCommandToFramework(RTATransport *transport, const RtaCommand *command)
+_rtaTransport_SendCommandToFramework(RTATransport *transport, const RtaCommand *command, const uint64_t *microSeconds)
 {
-    bool success = rtaCommand_Write(command, transport->commandRingBuffer);
-    if (success) {
+    bool success = rtaCommand_Write(command, transport->commandQueue, CCNxStackTimeout_Immediate);
+    if (!success && !transport->inlineMode) {
+        // make sure the Framework is draining the queue before we wait on it
         parcNotifier_Notify(transport->commandNotifier);
-        return true;
+        success = rtaCommand_Write(command, transport->commandQueue, microSeconds);
     }
-    return false;
+
+    if (success) {
+        if (transport->inlineMode) {
+            // We are on the Framework's thread, so execute the command now.  It may
+            // have scheduled timers, e.g. when a connection opened.
+            rtaFramework_CommandCallback(-1, PARCEventType_Read, transport->framework);
+            _rtaTransport_ArmDeadline(transport);
+        } else {
+            parcNotifier_Notify(transport->commandNotifier);
+        }
+    }
+    return success;
 }
 
-RTATransport *
-rtaTransport_Create(void)
+static RTATransport *
+_rtaTransport_Create(bool inlineMode, const TransportInstanceOptions *options)
 {
     RTATransport *transport = parcMemory_AllocateAndClear(sizeof(RTATransport));
 
     if (transport != NULL) {
         transport->nextStackId = 1;
 
-        transport->commandRingBuffer = parcRingBuffer1x1_Create(128, _rtaTransport_CommandBufferEntryDestroyer);
+        size_t capacity = options->commandQueueSize > 0 ? options->commandQueueSize : RTA_COMMAND_QUEUE_DEFAULT_CAPACITY;
+        transport->commandTimeoutUsec = options->commandTimeoutUsec > 0 ? options->commandTimeoutUsec : RTA_TRANSPORT_COMMAND_TIMEOUT_USEC;
+
+        transport->commandQueue = rtaCommandQueue_Create(capacity);
         transport->commandNotifier = parcNotifier_Create();
 
-        transport->framework = rtaFramework_Create(transport->commandRingBuffer, transport->commandNotifier);
+        transport->framework = rtaFramework_Create(transport->commandQueue, transport->commandNotifier);
         assertNotNull(transport->framework, "rtaFramework_Create returned null");
+        if (options->maxConnections > 0) {
+            rtaFramework_SetMaxConnections(transport->framework, options->maxConnections);
+        }
 
-        rtaFramework_Start(transport->framework);
+        transport->inlineMode = inlineMode;
+        transport->wakeFds[0] = -1;
+        transport->wakeFds[1] = -1;
+        transport->dispatchFd = -1;
+        transport->timerFd = -1;
+
+        if (inlineMode) {
+            transport->nextInlineQueueId = 1;
+
+            int failure = pipe(transport->wakeFds);
+            assertFalse(failure, "pipe failed: (%d) %s", errno, strerror(errno));
+            for (int i = 0; i < 2; i++) {
+                int flags = fcntl(transport->wakeFds[i], F_GETFL, NULL);
+                assertTrue(flags != -1, "fcntl failed to obtain file descriptor flags (%d)\n", errno);
+                failure = fcntl(transport->wakeFds[i], F_SETFL, flags | O_NONBLOCK);
+                assertFalse(failure, "fcntl failed to set file descriptor flags (%d)\n", errno);
+            }
+
+#if defined(__linux__)
+            _rtaTransport_CreateDispatchFd(transport);
+#else
+            transport->dispatchFd = transport->wakeFds[0];
+#endif
+
+            // moves the framework to the SETUP state without starting its thread
+            rtaFramework_NonThreadedDispatch(transport->framework, 0);
+        } else {
+            // Without options the framework keeps what the RTA_FRAMEWORK_* variables said
+            if (options->threadConfig != NULL) {
+                rtaFramework_SetThreadConfig(transport->framework, options->threadConfig);
+            }
+            if (options->cpu >= 0) {
+                rtaFramework_SetCpu(transport->framework, options->cpu);
+            }
+            rtaFramework_Start(transport->framework);
+        }
         transport->list = parcDeque_Create();
+        TAILQ_INIT(&transport->connections);
     }
 
     return transport;
 }
 
+RTATransport *
+rtaTransport_Create(void)
+{
+    const TransportInstanceOptions defaults = TransportInstanceOptions_Default;
+    return _rtaTransport_Create(false, &defaults);
+}
+
+RTATransport *
+rtaTransport_CreateWithOptions(const TransportInstanceOptions *options)
+{
+    const TransportInstanceOptions defaults = TransportInstanceOptions_Default;
+    if (options == NULL) {
+        options = &defaults;
+    }
+    return _rtaTransport_Create(false, options);
+}
+
+RTATransport *
+rtaTransport_CreateInline(void)
+{
+    const TransportInstanceOptions defaults = TransportInstanceOptions_Default;
+    return _rtaTransport_Create(true, &defaults);
+}
+
 int
 rtaTransport_Destroy(RTATransport **ctxPtr)
 {
@@ -228,38 +732,76 @@ rtaTransport_Destroy(RTATransport **ctxPtr)
     // %%%%% LOCK (notice this lock never gets unlocked, it just gets deleted)
     parcDeque_Lock(transport->list);
 
-    // This blocks until shutdown (state FRAMEWORK_SHUTDOWN)
-    rtaFramework_Shutdown(transport->framework);
+    if (transport->inlineMode) {
+        // There is no Framework thread to stop
+        rtaFramework_Teardown(transport->framework);
+    } else {
+        // This blocks until shutdown (state FRAMEWORK_SHUTDOWN)
+        rtaFramework_Shutdown(transport->framework);
+    }
 
     // This will close and drain all the API fds
     rtaFramework_Destroy(&transport->framework);
 
     parcNotifier_Release(&transport->commandNotifier);
-    parcRingBuffer1x1_Release(&transport->commandRingBuffer);
+    rtaCommandQueue_Release(&transport->commandQueue);
 
     // Destroy the state we have stored locally to map JSON protocol stack descriptions
     // to stack_id identifiers.
 
     for (size_t index = 0; index < parcDeque_Size(transport->list); index++) {
         _StackEntry *entry = parcDeque_GetAtIndex(transport->list, index);
-        parcMemory_Deallocate((void **) &entry);
+        _rtaTransport_DestroyStackEntry(&entry);
+    }
+    if (transport->stacksByHash != NULL) {
+        parcMemory_Deallocate((void **) &transport->stacksByHash);
+    }
+
+    while (!TAILQ_EMPTY(&transport->connections)) {
+        _ConnectionEntry *entry = TAILQ_FIRST(&transport->connections);
+        if (!entry->closed) {
+            _rtaTransport_CloseConnectionEntry(transport, entry);
+        }
+        _rtaTransport_DestroyConnectionEntry(transport, &entry);
+    }
+    while (transport->connectionsByQueueId != NULL) {
+        _ConnectionIndex *retired = transport->connectionsByQueueId->retired;
+        parcMemory_Deallocate((void **) &transport->connectionsByQueueId);
+        transport->connectionsByQueueId = retired;
     }
 
     parcDeque_Release(&transport->list);
 
+    if (transport->inlineMode) {
+#if defined(__linux__)
+        close(transport->dispatchFd);
+        close(transport->timerFd);
+#endif
+        close(transport->wakeFds[0]);
+        close(transport->wakeFds[1]);
+        if (transport->freeInlineQueueIds != NULL) {
+            parcMemory_Deallocate((void **) &transport->freeInlineQueueIds);
+        }
+    }
+
     parcMemory_Deallocate((void **) ctxPtr);
 
 //    printf("rta_transport writes=%9u reads=%9u spins=%9u\n", rta_transport_writes, rta_transport_reads, rta_transport_read_spin);
     return 0;
 }
 
-static _RTASocketPair
-_rtaTransport_CreateSocketPair(const RTATransport *transport, int bufferSize)
+/*
+ * Returns false if the process is out of descriptors
+ */
+static bool
+_rtaTransport_TryCreateSocketPair(const RTATransport *transport, int bufferSize, _RTASocketPair *output)
 {
     int fds[2];
 
     bool success = (socketpair(PF_LOCAL, SOCK_STREAM, 0, fds) == 0);
-    assertTrue(success, "socketpair(PF_LOCAL, SOCK_STREAM, ...) failed.");
+    if (!success) {
+        return false;
+    }
 
     _RTASocketPair result = { .up = fds[0], .down = fds[1] };
 
@@ -272,14 +814,62 @@ _rtaTransport_CreateSocketPair(const RTATransport *transport, int bufferSize)
     success = (setsockopt(result.down, SOL_SOCKET, SO_RCVBUF, &sendbuff, sizeof(sendbuff)) == 0);
     assertTrue(success, "Expected success for setsockopt SO_RCVBUF");
 
+    *output = result;
+    return true;
+}
+
+static _RTASocketPair
+_rtaTransport_CreateSocketPair(const RTATransport *transport, int bufferSize)
+{
+    _RTASocketPair result;
+    bool success = _rtaTransport_TryCreateSocketPair(transport, bufferSize, &result);
+    assertTrue(success, "socketpair(PF_LOCAL, SOCK_STREAM, ...) failed.");
+    return result;
+}
+
+/*
+ * An inline connection has no socket pair.  The queueId is the most recently closed
+ * inline id, or the next new one, and the transport side is -1.  An inline transport
+ * is used from one thread, so the free list takes no lock.
+ */
+static _RTASocketPair
+_rtaTransport_CreateInlinePair(RTATransport *transport)
+{
+    _RTASocketPair result = { .up = -1, .down = -1 };
+    if (transport->freeInlineQueueIdCount > 0) {
+        result.up = transport->freeInlineQueueIds[--transport->freeInlineQueueIdCount];
+    } else {
+        result.up = transport->nextInlineQueueId++;
+    }
     return result;
 }
 
+/*
+ * Puts a queueId the Framework no longer uses on the free list
+ */
+static void
+_rtaTransport_FreeInlineQueueId(RTATransport *transport, int queueId)
+{
+    if (transport->freeInlineQueueIdCount == transport->freeInlineQueueIdCapacity) {
+        size_t capacity = transport->freeInlineQueueIdCapacity == 0 ? 16 : transport->freeInlineQueueIdCapacity * 2;
+        int *freeIds = parcMemory_Allocate(capacity * sizeof(int));
+        assertNotNull(freeIds, "parcMemory_Allocate(%zu) returned NULL", capacity * sizeof(int));
+        if (transport->freeInlineQueueIds != NULL) {
+            memcpy(freeIds, transport->freeInlineQueueIds, transport->freeInlineQueueIdCount * sizeof(int));
+            parcMemory_Deallocate((void **) &transport->freeInlineQueueIds);
+        }
+        transport->freeInlineQueueIds = freeIds;
+        transport->freeInlineQueueIdCapacity = capacity;
+    }
+    transport->freeInlineQueueIds[transport->freeInlineQueueIdCount++] = queueId;
+}
+
 /**
  * Returns the protocol stack entry from our table
  *
  * Determine if we already have a protocol stack with the same structure as the user asks for.
- * If so, return that entry, otherwise return NULL
+ * If so, return that entry, otherwise return NULL.  The stack configuration remembers its
+ * hash, so reopening with the same configuration does not touch the JSON.
  *
  * @param [in] transport The RTA transport
  * @param [in] transportConfig the configuration the user is asking for
@@ -299,14 +889,16 @@ _rtaTransport_GetProtocolStackEntry(RTATransport *transport, CCNxTransportConfig
 /**
  * Add a protocol stack
  *
- * Adds an entry to our local table of Config -> stack_id mapping and sends a
- * command over the command socket to create the protocol stack.
+ * Compiles the configuration into an RtaStackDescriptor, adds an entry to our local
+ * table of Config -> stack_id mapping and sends the descriptor in a command over the
+ * command queue to create the protocol stack.  Called with the lock held, so the
+ * create is queued before any open that uses the stack.
  *
  * @param [in] transport The RTA transport
  * @param [in] transportConfig the user specified configuration
  *
  * @return non-NULL The holder of the protocol stack mapping
- * @return NULL An error
+ * @return NULL The command queue stayed full, errno is EWOULDBLOCK
  */
 static _StackEntry *
 _rtaTransport_AddProtocolStackEntry(RTATransport *transport, const CCNxTransportConfig *transportConfig)
@@ -315,71 +907,234 @@ _rtaTransport_AddProtocolStackEntry(RTATransport *transport, const CCNxTransport
 
     _StackEntry *stack = _rtaTransport_AddStack(transport, stackConfig);
 
-    RtaCommandCreateProtocolStack *createStack = rtaCommandCreateProtocolStack_Create(stack->stack_id, stackConfig);
+    RtaCommandCreateProtocolStack *createStack = rtaCommandCreateProtocolStack_CreateFromDescriptor(stack->stack_id, stack->descriptor);
 
     // request for a new protocol stack, create it
 
     // now actually create the protocol stack by writing a command over the thread boundary
     // using the Command socket.
     RtaCommand *command = rtaCommand_CreateCreateProtocolStack(createStack);
-    _rtaTransport_SendCommandToFramework(transport, command);
+    bool success = _rtaTransport_SendCommandToFramework(transport, command, &transport->commandTimeoutUsec);
 
     rtaCommand_Release(&command);
     rtaCommandCreateProtocolStack_Release(&createStack);
 
+    if (!success) {
+        // the entry was appended last, forget it so the next open tries again
+        _StackEntry *removed = parcDeque_RemoveLast(transport->list);
+        assertTrue(removed == stack, "The stack entry is not the last entry");
+        _rtaTransport_DestroyStackEntry(&removed);
+        _rtaTransport_IndexStacks(transport);
+        transport->nextStackId--;
+        return NULL;
+    }
+
     return stack;
 }
 
 /**
- * Create a new connection
+ * Create the command to open one connection
  *
- * We have resolved that a matching protocol stack exists, and is represented by
- * protocolStackHashEntry.  We now want to send a command over the command socket to
- * create a connection in that stack.
- *
- * @param [in] transport The RTA transport
  * @param [in] transportConfig The user requested configuration
- * @param [in] protocolStackHashEntry The protocol stack holder
+ * @param [in] stack The protocol stack holder
  * @param [in] pair A _RTASocketPair representing the queue of data between the API and the transport stack.
+ * @param [in] entry Our entry for the connection, with the counter block and inline queue to share
+ *
+ * @return non-null An RtaCommandOpenConnection the caller must release
  */
-static void
-_rtaTransport_CreateConnection(RTATransport *transport, CCNxTransportConfig *transportConfig, _StackEntry *stack, _RTASocketPair pair)
+static RtaCommandOpenConnection *
+_rtaTransport_CreateOpenConnection(CCNxTransportConfig *transportConfig, _StackEntry *stack, _RTASocketPair pair,
+                                   _ConnectionEntry *entry)
 {
     RtaCommandOpenConnection *openConnection =
         rtaCommandOpenConnection_Create(stack->stack_id,
                                         pair.up,
                                         pair.down,
                                         ccnxConnectionConfig_GetJson(ccnxTransportConfig_GetConnectionConfig(transportConfig)));
+    rtaCommandOpenConnection_SetCounters(openConnection, entry->counters);
+    rtaCommandOpenConnection_SetInlineQueue(openConnection, entry->inlineQueue);
+    rtaCommandOpenConnection_SetSendQueue(openConnection, entry->sendQueue);
+    return openConnection;
+}
+
+/*
+ * Sends the command and waits for the Framework to execute it
+ *
+ * Returns 0 on success.  Returns -1 with errno EWOULDBLOCK if the command queue stayed full
+ * for the transport's command timeout, or with the error the Framework reported.
+ */
+static int
+_rtaTransport_SendCommandAndWait(RTATransport *transport, RtaCommand *command)
+{
+    if (!_rtaTransport_SendCommandToFramework(transport, command, &transport->commandTimeoutUsec)) {
+        return -1;
+    }
+
+    int error = 0;
+    rtaCommand_WaitComplete(command, CCNxStackTimeout_Never, &error);
+    if (error != 0) {
+        errno = error;
+        return -1;
+    }
+    return 0;
+}
 
+static void
+_rtaTransport_ClosePair(RTATransport *transport, _RTASocketPair pair)
+{
+    if (transport->inlineMode) {
+        _rtaTransport_FreeInlineQueueId(transport, pair.up);
+    } else {
+        close(pair.up);
+        close(pair.down);
+    }
+}
+
+/*
+ * Forgets the connection entries of queueIds the Framework did not open
+ */
+static void
+_rtaTransport_AbandonConnections(RTATransport *transport, int count, const int queueIds[], const int transportIds[])
+{
+    parcDeque_Lock(transport->list);
+    for (int i = 0; i < count; i++) {
+        _ConnectionEntry *entry = _rtaTransport_GetConnectionEntry(transport, queueIds[i]);
+        if (entry != NULL) {
+            _rtaTransport_CloseConnectionEntry(transport, entry);
+        }
+        _rtaTransport_ClosePair(transport, (_RTASocketPair) { .up = queueIds[i], .down = transportIds[i] });
+    }
+    parcDeque_Unlock(transport->list);
+}
+
+/*
+ * Reads the connection's API queue sizes.  Returns false with errno EINVAL if one is out of range.
+ */
+static bool
+_rtaTransport_GetQueueConfig(CCNxTransportConfig *transportConfig, ApiConnectorQueueConfig *output)
+{
+    PARCJSON *json = ccnxConnectionConfig_GetJson(ccnxTransportConfig_GetConnectionConfig(transportConfig));
+    if (!apiConnector_GetQueueConfigFromConfig(json, output)) {
+        errno = EINVAL;
+        return false;
+    }
+    return true;
+}
+
+int
+rtaTransport_Open(RTATransport *transport, CCNxTransportConfig *transportConfig)
+{
+    ccnxTransportConfig_OptionalAssertValid(transportConfig);
+
+    assertNotNull(transport, "Parameter transport must be a valid RTATransport");
+
+    ApiConnectorQueueConfig queueConfig;
+    if (!_rtaTransport_GetQueueConfig(transportConfig, &queueConfig)) {
+        return -1;
+    }
+
+    _RTASocketPair pair;
+    if (transport->inlineMode) {
+        pair = _rtaTransport_CreateInlinePair(transport);
+    } else {
+        pair = _rtaTransport_CreateSocketPair(transport, (int) queueConfig.receiveBufferBytes);
+    }
+
+    RtaCommandOpenConnection *openConnection = NULL;
+    parcDeque_Lock(transport->list);
+    {
+        _StackEntry *stack = _rtaTransport_GetProtocolStackEntry(transport, transportConfig);
+        if (stack == NULL) {
+            stack = _rtaTransport_AddProtocolStackEntry(transport, transportConfig);
+        }
+
+        if (stack != NULL) {
+            _ConnectionEntry *entry = _rtaTransport_AddConnectionEntry(transport, pair.up, &queueConfig);
+            openConnection = _rtaTransport_CreateOpenConnection(transportConfig, stack, pair, entry);
+        }
+    }
+    parcDeque_Unlock(transport->list);
+
+    if (openConnection == NULL) {
+        _rtaTransport_ClosePair(transport, pair);
+        return -1;
+    }
+
+    // The lock is not held while the command waits, so other threads may open and close
     RtaCommand *command = rtaCommand_CreateOpenConnection(openConnection);
-    _rtaTransport_SendCommandToFramework(transport, command);
+    rtaCommandOpenConnection_Release(&openConnection);
 
+    int result = _rtaTransport_SendCommandAndWait(transport, command);
+    if (result < 0) {
+        int error = errno;
+        _rtaTransport_AbandonConnections(transport, 1, &pair.up, &pair.down);
+        errno = error;
+    }
     rtaCommand_Release(&command);
-    rtaCommandOpenConnection_Release(&openConnection);
+
+    return result < 0 ? -1 : pair.up;
 }
 
 int
-rtaTransport_Open(RTATransport *transport, CCNxTransportConfig *transportConfig)
+rtaTransport_OpenMany(RTATransport *transport, CCNxTransportConfig *transportConfig, int count, int queueIds[])
 {
     ccnxTransportConfig_OptionalAssertValid(transportConfig);
 
     assertNotNull(transport, "Parameter transport must be a valid RTATransport");
+    assertNotNull(queueIds, "Parameter queueIds must be non-null");
+    assertTrue(count > 0, "Parameter count must be positive");
 
-    _RTASocketPair pair = _rtaTransport_CreateSocketPair(transport, sizeof(void *) * 128);
+    ApiConnectorQueueConfig queueConfig;
+    if (!_rtaTransport_GetQueueConfig(transportConfig, &queueConfig)) {
+        return 0;
+    }
+
+    RtaCommandOpenManyConnections *openMany = rtaCommandOpenManyConnections_Create((size_t) count);
+    int *transportIds = parcMemory_Allocate(sizeof(int) * (size_t) count);
+    assertNotNull(transportIds, "parcMemory_Allocate(%zu) returned NULL", sizeof(int) * (size_t) count);
 
+    int opened = 0;
     parcDeque_Lock(transport->list);
     {
         _StackEntry *stack = _rtaTransport_GetProtocolStackEntry(transport, transportConfig);
         if (stack == NULL) {
             stack = _rtaTransport_AddProtocolStackEntry(transport, transportConfig);
         }
-        assertNotNull(stack, "Got NULL hash entry from _rtaTransport_AddProtocolStackEntry");
 
-        _rtaTransport_CreateConnection(transport, transportConfig, stack, pair);
+        _RTASocketPair pair;
+        while (stack != NULL && opened < count) {
+            if (transport->inlineMode) {
+                pair = _rtaTransport_CreateInlinePair(transport);
+            } else if (!_rtaTransport_TryCreateSocketPair(transport, (int) queueConfig.receiveBufferBytes, &pair)) {
+                break;
+            }
+
+            _ConnectionEntry *entry = _rtaTransport_AddConnectionEntry(transport, pair.up, &queueConfig);
+
+            RtaCommandOpenConnection *openConnection = _rtaTransport_CreateOpenConnection(transportConfig, stack, pair, entry);
+            rtaCommandOpenManyConnections_Add(openMany, openConnection);
+            rtaCommandOpenConnection_Release(&openConnection);
+
+            transportIds[opened] = pair.down;
+            queueIds[opened++] = pair.up;
+        }
     }
     parcDeque_Unlock(transport->list);
 
-    return pair.up;
+    if (opened > 0) {
+        RtaCommand *command = rtaCommand_CreateOpenManyConnections(openMany);
+        if (_rtaTransport_SendCommandAndWait(transport, command) < 0) {
+            int error = errno;
+            _rtaTransport_AbandonConnections(transport, opened, queueIds, transportIds);
+            errno = error;
+            opened = 0;
+        }
+        rtaCommand_Release(&command);
+    }
+
+    parcMemory_Deallocate((void **) &transportIds);
+    rtaCommandOpenManyConnections_Release(&openMany);
+    return opened;
 }
 
 /**
@@ -411,14 +1166,147 @@ _rtaTransport_SendSelect(const int fd, const uint64_t *microSeconds)
     return selectResult;
 }
 
+static uint64_t
+_rtaTransport_NowUsec(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000 + (uint64_t) now.tv_nsec / 1000;
+}
+
+/*
+ * Runs the Framework on our thread for up to one tick.  Returns false once `deadline`
+ * has passed, or right away if `microSeconds` is 0.  A NULL `microSeconds` never expires.
+ */
+static bool
+_rtaTransport_InlineWait(RTATransport *transport, const uint64_t *microSeconds, uint64_t deadline)
+{
+    if (microSeconds != NULL && _rtaTransport_NowUsec() >= deadline) {
+        return false;
+    }
+
+    // LoopOnce returns by the next tick of the Framework's clock
+    rtaFramework_NonThreadedStep(transport->framework);
+    _rtaTransport_ArmDeadline(transport);
+    return true;
+}
+
+static bool
+_rtaTransport_InlineSend(RTATransport *transport, int queueId, const CCNxMetaMessage *message, const uint64_t *microSeconds)
+{
+    uint64_t deadline = (microSeconds != NULL) ? _rtaTransport_NowUsec() + *microSeconds : 0;
+
+    // The API connector takes its own reference, there is no pointer to pass through a socket
+    while (!rtaFramework_NonThreadedSend(transport->framework, queueId, (CCNxMetaMessage *) message)) {
+        if (errno != EWOULDBLOCK || !_rtaTransport_InlineWait(transport, microSeconds, deadline)) {
+            return false;
+        }
+    }
+
+    rta_transport_writes++;
+    _rtaTransport_ArmWake(transport);
+    return true;
+}
+
+static TransportIOStatus
+_rtaTransport_InlineRecv(RTATransport *transport, const int queueId, CCNxMetaMessage **msgPtr, const uint64_t *microSeconds)
+{
+    uint64_t deadline = (microSeconds != NULL) ? _rtaTransport_NowUsec() + *microSeconds : 0;
+
+    _ConnectionEntry *entry = _rtaTransport_GetConnectionEntry(transport, queueId);
+    if (entry == NULL) {
+        errno = EBADF;
+        return TransportIOStatus_Error;
+    }
+
+    // The queue hands over the API connector's reference
+    bool full;
+    do {
+        full = rtaInlineQueue_IsFull(entry->inlineQueue);
+        *msgPtr = rtaInlineQueue_Get(entry->inlineQueue);
+        if (*msgPtr == NULL && !_rtaTransport_InlineWait(transport, microSeconds, deadline)) {
+            errno = ENOMSG;
+            return TransportIOStatus_Timeout;
+        }
+    } while (*msgPtr == NULL);
+
+    // the API connector blocked the connection UP when the queue filled
+    if (full && !rtaInlineQueue_IsFull(entry->inlineQueue)) {
+        rtaFramework_NonThreadedUnblockUp(transport->framework, queueId);
+    }
+
+    rta_transport_reads++;
+
+    errno = 0;
+    return TransportIOStatus_Success;
+}
+
+/*
+ * Returns the send queue of the connection, or NULL if we did not open it, e.g. a socket
+ * pair made by a unit test.  Takes no lock and no reference: the entry holds the queue until
+ * the queueId is reused, and a queue closed under a waiting sender fails its put.
+ */
+static RtaSendQueue *
+_rtaTransport_GetSendQueue(const RTATransport *transport, int queueId)
+{
+    if (transport != NULL) {
+        _ConnectionEntry *entry = _rtaTransport_GetConnectionEntry(transport, queueId);
+        if (entry != NULL) {
+            return entry->sendQueue;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Called after a message went on the connection's send queue.  Only the first sender since
+ * the API connector last looked at the queue writes to the socket pair, and it writes a
+ * NULL pointer to wake the connector, not the message.
+ */
+static bool
+_rtaTransport_WakeSendQueue(RtaSendQueue *sendQueue, int queueId)
+{
+    __atomic_add_fetch(&rta_transport_writes, 1, __ATOMIC_RELAXED);
+
+    if (rtaSendQueue_Notify(sendQueue)) {
+        const CCNxMetaMessage *wakeUp = NULL;
+        ssize_t count = write(queueId, &wakeUp, sizeof(wakeUp));
+        if (count != sizeof(wakeUp)) {
+            // the connection is gone, the queue releases the message
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool
+_rtaTransport_QueueSend(RtaSendQueue *sendQueue, int queueId, CCNxMetaMessage *metaMessage, const uint64_t *microSeconds)
+{
+    if (!rtaSendQueue_Put(sendQueue, metaMessage, microSeconds)) {
+        ccnxMetaMessage_Release(&metaMessage);
+        return false;
+    }
+    return _rtaTransport_WakeSendQueue(sendQueue, queueId);
+}
+
 bool
 rtaTransport_Send(RTATransport *transport, int queueId, const CCNxMetaMessage *message, const uint64_t *microSeconds)
 {
+    if (transport != NULL && transport->inlineMode) {
+        return _rtaTransport_InlineSend(transport, queueId, message, microSeconds);
+    }
+
     // Acquire a reference to the incoming CCNxMetaMessage so if the caller releases it immediately,
     // a reference still exists for the transport. This reference is released once the
     // message is processed lower in the stack.
     CCNxMetaMessage *metaMessage = ccnxMetaMessage_Acquire(message);
 
+    RtaSendQueue *sendQueue = _rtaTransport_GetSendQueue(transport, queueId);
+    if (sendQueue != NULL) {
+        return _rtaTransport_QueueSend(sendQueue, queueId, metaMessage, microSeconds);
+    }
+
+    // Without a send queue, the message pointer itself goes over the socket pair
     rta_transport_writes++;
 
     int selectResult = _rtaTransport_SendSelect(queueId, microSeconds);
@@ -443,6 +1331,37 @@ rtaTransport_Send(RTATransport *transport, int queueId, const CCNxMetaMessage *m
     return false;
 }
 
+TransportIOStatus
+rtaTransport_TrySend(RTATransport *transport, int queueId, const CCNxMetaMessage *message)
+{
+    assertNotNull(message, "Parameter message must be non-null");
+
+    // Without a send queue there is no flow-control state, only whether the message fits now
+    if (transport == NULL || transport->inlineMode) {
+        if (rtaTransport_Send(transport, queueId, message, CCNxStackTimeout_Immediate)) {
+            return TransportIOStatus_Success;
+        }
+        return (errno == EWOULDBLOCK) ? TransportIOStatus_WouldBlock : TransportIOStatus_Error;
+    }
+
+    RtaSendQueue *sendQueue = _rtaTransport_GetSendQueue(transport, queueId);
+    if (sendQueue == NULL) {
+        errno = EBADF;
+        return TransportIOStatus_Error;
+    }
+
+    TransportIOStatus status = TransportIOStatus_Success;
+    CCNxMetaMessage *metaMessage = ccnxMetaMessage_Acquire(message);
+    if (!rtaSendQueue_TryPut(sendQueue, metaMessage)) {
+        status = (errno == EWOULDBLOCK) ? TransportIOStatus_WouldBlock : TransportIOStatus_Error;
+        ccnxMetaMessage_Release(&metaMessage);
+    } else if (!_rtaTransport_WakeSendQueue(sendQueue, queueId)) {
+        status = TransportIOStatus_Error;
+    }
+
+    return status;
+}
+
 //#if 1
 /**
  * @return -1  An error occured
@@ -470,13 +1389,111 @@ _rtaTransport_ReceiveSelect(const int fd, const uint64_t *microSeconds)
     return selectResult;
 }
 
+/*
+ * Single-writer add to a busy-poll statistic, see _BusyPoll
+ */
+static inline void
+_rtaTransport_BusyPollAdd(uint64_t *counter, uint64_t delta)
+{
+    __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + delta, __ATOMIC_RELAXED);
+}
+
+/*
+ * Adapts the spin window to how long the last receive waited for its message.  A wait
+ * within the budget means a spin of that length would have caught the message, so the
+ * window doubles up to the budget.  A longer wait means messages arrive too slowly to
+ * spin for, so the window halves and reaches 0 after a run of slow arrivals.
+ */
+static void
+_rtaTransport_BusyPollAdapt(_BusyPoll *busyPoll, uint64_t waitUsec)
+{
+    uint64_t window = busyPoll->windowUsec;
+    if (waitUsec <= busyPoll->budgetUsec) {
+        window = (window == 0) ? (busyPoll->budgetUsec + 3) / 4 : window * 2;
+        if (window > busyPoll->budgetUsec) {
+            window = busyPoll->budgetUsec;
+        }
+    } else {
+        window /= 2;
+    }
+    __atomic_store_n(&busyPoll->windowUsec, window, __ATOMIC_RELAXED);
+}
+
+/*
+ * _rtaTransport_ReceiveSelect() for a connection with a busy-poll budget: polls the
+ * descriptor without sleeping for up to the spin window, then blocks for the rest of
+ * the timeout.  Same return values as _rtaTransport_ReceiveSelect().
+ */
+static int
+_rtaTransport_BusyPollSelect(_BusyPoll *busyPoll, const int fd, const uint64_t *microSeconds)
+{
+    const uint64_t start = _rtaTransport_NowUsec();
+    const uint64_t noWait = 0;
+
+    uint64_t window = busyPoll->windowUsec;
+    if (microSeconds != NULL && *microSeconds < window) {
+        window = *microSeconds;
+    }
+
+    uint64_t elapsed = 0;
+    int selectResult = 0;
+    if (window > 0) {
+        do {
+            selectResult = _rtaTransport_ReceiveSelect(fd, &noWait);
+            elapsed = _rtaTransport_NowUsec() - start;
+        } while (selectResult == 0 && elapsed < window);
+
+        _rtaTransport_BusyPollAdd(&busyPoll->spinUsec, elapsed);
+        if (selectResult != 0) {
+            if (selectResult > 0) {
+                _rtaTransport_BusyPollAdd(&busyPoll->spinHits, 1);
+                _rtaTransport_BusyPollAdapt(busyPoll, elapsed);
+            }
+            return selectResult;
+        }
+        _rtaTransport_BusyPollAdd(&busyPoll->spinMisses, 1);
+    } else {
+        _rtaTransport_BusyPollAdd(&busyPoll->spinSkips, 1);
+    }
+
+    uint64_t remaining;
+    const uint64_t *timeout = NULL;
+    if (microSeconds != NULL) {
+        remaining = (*microSeconds > elapsed) ? *microSeconds - elapsed : 0;
+        timeout = &remaining;
+    }
+
+    selectResult = _rtaTransport_ReceiveSelect(fd, timeout);
+    if (selectResult > 0) {
+        _rtaTransport_BusyPollAdapt(busyPoll, _rtaTransport_NowUsec() - start);
+    }
+    return selectResult;
+}
+
 TransportIOStatus
 rtaTransport_Recv(RTATransport *transport, const int queueId, CCNxMetaMessage **msgPtr, const uint64_t *microSeconds)
 {
     // The effect here is to transfer the reference to the CCNxMetaMessage to the application-side thread.
     // Thus, no acquire or release here as the caller is responsible for releasing the CCNxMetaMessage
 
-    int selectResult = _rtaTransport_ReceiveSelect(queueId, microSeconds);
+    if (transport->inlineMode) {
+        return _rtaTransport_InlineRecv(transport, queueId, msgPtr, microSeconds);
+    }
+
+    _BusyPoll *busyPoll = NULL;
+    if (__atomic_load_n(&transport->busyPollConnections, __ATOMIC_RELAXED) > 0) {
+        _ConnectionEntry *entry = _rtaTransport_GetConnectionEntry(transport, queueId);
+        if (entry != NULL && __atomic_load_n(&entry->busyPoll.budgetUsec, __ATOMIC_RELAXED) > 0) {
+            busyPoll = &entry->busyPoll;
+        }
+    }
+
+    int selectResult;
+    if (busyPoll != NULL) {
+        selectResult = _rtaTransport_BusyPollSelect(busyPoll, queueId, microSeconds);
+    } else {
+        selectResult = _rtaTransport_ReceiveSelect(queueId, microSeconds);
+    }
 
     if (selectResult == -1) {
         // errno should have been set by the select(2) system call.
@@ -570,17 +1587,187 @@ rtaTransport_Close(RTATransport *transport, int api_fd)
     RtaCommand *command = rtaCommand_CreateCloseConnection(commandClose);
     rtaCommandCloseConnection_Release(&commandClose);
 
-    _rtaTransport_SendCommandToFramework(transport, command);
+    // Queue the close before forgetting the connection, so a full queue leaves it open
+    if (!_rtaTransport_SendCommandToFramework(transport, command, &transport->commandTimeoutUsec)) {
+        rtaCommand_Release(&command);
+        return -1;
+    }
+
+    bool closed = false;
+    parcDeque_Lock(transport->list);
+    {
+        _ConnectionEntry *entry = _rtaTransport_GetConnectionEntry(transport, api_fd);
+        if (entry != NULL) {
+            _rtaTransport_CloseConnectionEntry(transport, entry);
+            closed = true;
+        }
+    }
+    parcDeque_Unlock(transport->list);
 
+    int error = 0;
+    rtaCommand_WaitComplete(command, CCNxStackTimeout_Never, &error);
     rtaCommand_Release(&command);
 
+    // The close has executed, so the Framework's connection table no longer has the queueId
+    if (closed && transport->inlineMode) {
+        _rtaTransport_FreeInlineQueueId(transport, api_fd);
+    }
+
+    if (error != 0) {
+        errno = error;
+        return -1;
+    }
     return 0;
 }
 
 int
 rtaTransport_PassCommand(RTATransport *transport, const RtaCommand *rtacommand)
 {
-    _rtaTransport_SendCommandToFramework(transport, rtacommand);
+    if (!_rtaTransport_SendCommandToFramework(transport, rtacommand, CCNxStackTimeout_Immediate)) {
+        return -1;
+    }
 
     return 0;
 }
+
+PARCJSON *
+rtaTransport_GetStatistics(RTATransport *transport, const uint64_t *microSeconds)
+{
+    assertNotNull(transport, "Parameter transport must be non-null");
+
+    RtaCommandSnapshotStatistics *snapshotStats = rtaCommandSnapshotStatistics_Create();
+    RtaCommand *command = rtaCommand_CreateSnapshotStatistics(snapshotStats);
+
+    PARCJSON *result = NULL;
+    if (_rtaTransport_SendCommandToFramework(transport, command, CCNxStackTimeout_Immediate)) {
+        result = rtaCommandSnapshotStatistics_WaitSnapshot(snapshotStats, microSeconds);
+    }
+
+    rtaCommand_Release(&command);
+    rtaCommandSnapshotStatistics_Release(&snapshotStats);
+    return result;
+}
+
+bool
+rtaTransport_GetConnectionStats(RTATransport *transport, int queueId, RtaConnectionStats *output)
+{
+    assertNotNull(transport, "Parameter transport must be non-null");
+    assertNotNull(output, "Parameter output must be non-null");
+
+    // Lock free, a monitoring thread polling the counters does not hold up Open or Close
+    _ConnectionEntry *entry = _rtaTransport_GetConnectionEntry(transport, queueId);
+    if (entry == NULL) {
+        return false;
+    }
+
+    rtaConnectionCounters_Snapshot(entry->counters, output);
+    return true;
+}
+
+bool
+rtaTransport_GetSendQueueState(RTATransport *transport, int queueId, RtaSendQueueState *output)
+{
+    assertNotNull(transport, "Parameter transport must be non-null");
+    assertNotNull(output, "Parameter output must be non-null");
+    assertFalse(transport->inlineMode, "rtaTransport_GetSendQueueState does not apply to a transport from rtaTransport_CreateInline");
+
+    RtaSendQueue *sendQueue = _rtaTransport_GetSendQueue(transport, queueId);
+    if (sendQueue == NULL) {
+        return false;
+    }
+
+    output->count = rtaSendQueue_Count(sendQueue);
+    output->capacity = rtaSendQueue_Capacity(sendQueue);
+    output->blocked = rtaSendQueue_IsBlocked(sendQueue);
+    return true;
+}
+
+bool
+rtaTransport_SetWritableCallback(RTATransport *transport, int queueId, RtaTransportWritableCallback *callback, void *arg)
+{
+    assertNotNull(transport, "Parameter transport must be non-null");
+    assertFalse(transport->inlineMode, "rtaTransport_SetWritableCallback does not apply to a transport from rtaTransport_CreateInline");
+
+    RtaSendQueue *sendQueue = _rtaTransport_GetSendQueue(transport, queueId);
+    if (sendQueue == NULL) {
+        return false;
+    }
+
+    rtaSendQueue_SetWritableSignal(sendQueue, callback, arg);
+    return true;
+}
+
+bool
+rtaTransport_SetBusyPoll(RTATransport *transport, int queueId, uint64_t budgetUsec)
+{
+    assertNotNull(transport, "Parameter transport must be non-null");
+    assertFalse(transport->inlineMode, "rtaTransport_SetBusyPoll does not apply to a transport from rtaTransport_CreateInline");
+
+    bool found = false;
+    parcDeque_Lock(transport->list);
+    {
+        _ConnectionEntry *entry = _rtaTransport_GetConnectionEntry(transport, queueId);
+        if (entry != NULL) {
+            if (entry->busyPoll.budgetUsec == 0 && budgetUsec > 0) {
+                __atomic_add_fetch(&transport->busyPollConnections, 1, __ATOMIC_RELAXED);
+            } else if (entry->busyPoll.budgetUsec > 0 && budgetUsec == 0) {
+                __atomic_sub_fetch(&transport->busyPollConnections, 1, __ATOMIC_RELAXED);
+            }
+            __atomic_store_n(&entry->busyPoll.budgetUsec, budgetUsec, __ATOMIC_RELAXED);
+            __atomic_store_n(&entry->busyPoll.windowUsec, budgetUsec, __ATOMIC_RELAXED);
+            found = true;
+        }
+    }
+    parcDeque_Unlock(transport->list);
+
+    return found;
+}
+
+bool
+rtaTransport_GetBusyPollStats(RTATransport *transport, int queueId, RtaBusyPollStats *output)
+{
+    assertNotNull(transport, "Parameter transport must be non-null");
+    assertNotNull(output, "Parameter output must be non-null");
+
+    _ConnectionEntry *entry = _rtaTransport_GetConnectionEntry(transport, queueId);
+    if (entry == NULL) {
+        return false;
+    }
+
+    output->budgetUsec = __atomic_load_n(&entry->busyPoll.budgetUsec, __ATOMIC_RELAXED);
+    output->windowUsec = __atomic_load_n(&entry->busyPoll.windowUsec, __ATOMIC_RELAXED);
+    output->spinHits = __atomic_load_n(&entry->busyPoll.spinHits, __ATOMIC_RELAXED);
+    output->spinMisses = __atomic_load_n(&entry->busyPoll.spinMisses, __ATOMIC_RELAXED);
+    output->spinSkips = __atomic_load_n(&entry->busyPoll.spinSkips, __ATOMIC_RELAXED);
+    output->spinUsec = __atomic_load_n(&entry->busyPoll.spinUsec, __ATOMIC_RELAXED);
+    return true;
+}
+
+unsigned
+rtaTransport_Dispatch(RTATransport *transport, unsigned budget)
+{
+    assertNotNull(transport, "Parameter transport must be non-null");
+    assertTrue(transport->inlineMode, "rtaTransport_Dispatch requires a transport from rtaTransport_CreateInline");
+
+    // Deliveries during this dispatch arm the descriptor again
+    _rtaTransport_DisarmWake(transport);
+    _rtaTransport_ClearDispatchFd(transport);
+
+    unsigned before = transport->inlineDelivered;
+    rtaFramework_NonThreadedDispatch(transport->framework, budget);
+
+    // Messages between components make no descriptor ready, so the budget may leave some
+    if (rtaFramework_NonThreadedHasPendingWork(transport->framework)) {
+        _rtaTransport_ArmWake(transport);
+    }
+    _rtaTransport_ArmDeadline(transport);
+    return transport->inlineDelivered - before;
+}
+
+int
+rtaTransport_GetDispatchFd(const RTATransport *transport)
+{
+    assertNotNull(transport, "Parameter transport must be non-null");
+    assertTrue(transport->inlineMode, "rtaTransport_GetDispatchFd requires a transport from rtaTransport_CreateInline");
+    return transport->dispatchFd;
+}
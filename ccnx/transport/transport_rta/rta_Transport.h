@@ -95,12 +95,17 @@
  * { "RTA" : { "SHUTDOWN" }
  *
  * See rta_Commands.h for an implementation of this.
+ *
+ * rtaTransport_CreateInline() is the exception to all of the above: it creates no worker
+ * thread and no socket pairs, and the application runs the event scheduler itself with
+ * rtaTransport_Dispatch().
  */
 #ifndef Libccnx_rta_Transport_h
 #define Libccnx_rta_Transport_h
 
 #include <ccnx/transport/common/transport.h>
 #include <ccnx/transport/transport_rta/commands/rta_Command.h>
+#include <ccnx/transport/transport_rta/core/rta_ConnectionCounters.h>
 
 /**
  * Transport Ready To Assemble context
@@ -122,27 +127,503 @@ extern const struct transport_operations rta_ops;
  */
 RTATransport *rtaTransport_Create(void);
 
+/**
+ * Create the transport with options
+ *
+ * Each call creates an independent transport with its own framework thread, so a process
+ * may run several, e.g. one per core.  With `options->threadConfig`, the framework thread
+ * runs with that config instead of the one from the RTA_FRAMEWORK_* environment variables
+ * (see rtaFramework_SetThreadConfig()).  With `options->cpu` set, the thread is pinned to
+ * that one CPU (see rtaFramework_SetCpu()), otherwise it keeps the CPUs of either config.
+ *
+ * @param [in] options The options, or NULL for TransportInstanceOptions_Default
+ *
+ * @return non-null A transport to release with rtaTransport_Destroy()
+ * @return null Out of memory
+ *
+ * Example:
+ * @code
+ * {
+ *     TransportInstanceOptions options = { .cpu = 1 };
+ *     RTATransport *transport = rtaTransport_CreateWithOptions(&options);
+ *     rtaTransport_Destroy(&transport);
+ * }
+ * @endcode
+ */
+RTATransport *rtaTransport_CreateWithOptions(const TransportInstanceOptions *options);
+
+/**
+ * Create a transport that runs the Framework on the caller's thread
+ *
+ * No worker thread is started.  The application drives the Framework with
+ * rtaTransport_Dispatch(), typically when rtaTransport_GetDispatchFd() polls readable.
+ * There is no socket pair per connection: rtaTransport_Send() hands the message to the
+ * API connector directly and rtaTransport_Recv() takes it from a queue the API connector
+ * fills.  Open, Close and the other commands execute before the call returns.
+ *
+ * The queue holds `receiveBufferBytes` / sizeof(pointer) messages of the connection's
+ * ApiConnectorQueueConfig.  When it is full the connection is blocked in the UP direction,
+ * and rtaTransport_Recv() unblocks it below `writeWatermarkBytes` / sizeof(pointer).
+ *
+ * The queueIds returned by rtaTransport_Open() are not descriptors, so they cannot be
+ * polled.  An inline transport must only be used from one thread.
+ *
+ * @return non-null A transport to release with rtaTransport_Destroy()
+ * @return null Out of memory
+ *
+ * Example:
+ * @code
+ * {
+ *     RTATransport *transport = rtaTransport_CreateInline();
+ *     int queueId = rtaTransport_Open(transport, config);
+ *     struct pollfd pfd = { .fd = rtaTransport_GetDispatchFd(transport), .events = POLLIN };
+ *     while (running) {
+ *         poll(&pfd, 1, -1);    // 1 millisecond where timers are not reflected, see rtaTransport_GetDispatchFd()
+ *         if (rtaTransport_Dispatch(transport, 64) > 0) {
+ *             CCNxMetaMessage *msg;
+ *             while (rtaTransport_Recv(transport, queueId, &msg, CCNxStackTimeout_Immediate) == TransportIOStatus_Success) {
+ *                 ...
+ *                 ccnxMetaMessage_Release(&msg);
+ *             }
+ *         }
+ *     }
+ *     rtaTransport_Destroy(&transport);
+ * }
+ * @endcode
+ */
+RTATransport *rtaTransport_CreateInline(void);
+
 int rtaTransport_Destroy(RTATransport **ctxPtr);
 
+/**
+ * Open a connection
+ *
+ * Any number of threads may open and close connections at once.  The open command goes on
+ * the transport's multi-producer command queue and this returns once the Transport has
+ * opened the connection.  If the queue stays full for the transport's command timeout
+ * (TransportInstanceOptions `commandTimeoutUsec`), the open fails instead of blocking.
+ *
+ * The connection configuration may size the queues between the application and the stack,
+ * see apiConnector_QueueConnectionConfig().
+ *
+ * @param [in] ctx A pointer to a valid RTATransport instance.
+ * @param [in] transportConfig The configuration of the connection
+ *
+ * @return non-negative The queueId of the connection
+ * @return -1 The connection was not opened, errno is EWOULDBLOCK if the command queue was full,
+ *            EMFILE if the transport already has TransportInstanceOptions `maxConnections` open,
+ *            or EINVAL if a queue size in the connection configuration is out of range
+ *
+ * Example:
+ * @code
+ * {
+ *     int queueId = rtaTransport_Open(transport, config);
+ *     if (queueId < 0 && errno == EWOULDBLOCK) {
+ *         // the Transport is busy, try again later
+ *     }
+ * }
+ * @endcode
+ */
 int rtaTransport_Open(RTATransport *ctx, CCNxTransportConfig *transportConfig);
 
+/**
+ * Open many connections with the same configuration in one command
+ *
+ * Equivalent to calling rtaTransport_Open() `count` times, but the stack lookup is done
+ * once and the Transport receives a single RtaCommandOpenManyConnections instead of one
+ * command per connection.  Like rtaTransport_Open(), it returns once the Transport has
+ * opened the connections.
+ *
+ * Each connection uses two descriptors.  If the process runs out of descriptors, this
+ * opens as many as it can and returns that number.  If the command queue stays full for
+ * the transport's command timeout, none are opened and errno is EWOULDBLOCK.  If opening
+ * all of them would pass TransportInstanceOptions `maxConnections`, none are opened and
+ * errno is EMFILE.  If a queue size in the connection configuration is out of range,
+ * none are opened and errno is EINVAL.
+ *
+ * @param [in] transport A pointer to a valid RTATransport instance.
+ * @param [in] transportConfig The configuration of every connection
+ * @param [in] count The number of connections to open, must be positive
+ * @param [out] queueIds Must hold `count` elements, filled in with the queueId of each connection
+ *
+ * @return number The number of connections opened, the first entries of `queueIds`
+ *
+ * Example:
+ * @code
+ * {
+ *     int queueIds[1000];
+ *     int opened = rtaTransport_OpenMany(transport, config, 1000, queueIds);
+ *     for (int i = 0; i < opened; i++) {
+ *         rtaTransport_Close(transport, queueIds[i]);
+ *     }
+ * }
+ * @endcode
+ */
+int rtaTransport_OpenMany(RTATransport *transport, CCNxTransportConfig *transportConfig, int count, int queueIds[]);
+
 /**
  * Send a CCNxMetaMessage on the outbound direction of the stack.
  *
+ * Any number of threads may send on the same connection at once.  Each connection of a
+ * threaded transport has a bounded multi-producer queue (RtaSendQueue): the message goes
+ * on the queue and the Transport thread takes it off, so senders do not contend on the
+ * socket pair.  Messages sent by one thread reach the stack in the order that thread sent
+ * them; messages from different threads are interleaved in the order they were queued.
+ * To learn about flow control instead of waiting on it, use rtaTransport_TrySend().
+ *
  * @param [in] transport A pointer to a valid RTATransport instance.
  * @param [in] queueId The identifier of the asynchronous queue between the top and bottom halves of the stack.
  * @param [in] message A pointer to a valid CCNxMetaMessage instance.
+ * @param [in] microSeconds If the queue is full, NULL waits for room, otherwise the longest wait
  *
  * @return true The send was successful
- * @return false The send was not successful
+ * @return false The send was not successful, errno is EWOULDBLOCK if the queue stayed full
  */
 //bool rtaTransport_Send(RTATransport *transport, int queueId, const CCNxMetaMessage *message, const struct timeval *restrict timeout);
 bool rtaTransport_Send(RTATransport *transport, int queueId, const CCNxMetaMessage *message, const uint64_t *microSeconds);
 
+/**
+ * Send a CCNxMetaMessage if the connection is writable, without waiting
+ *
+ * When flow control in the stack holds a connection back, rtaTransport_Send() keeps
+ * queueing until the queue is full and then waits, so a sender cannot tell backpressure
+ * from a Transport thread that is merely slow.  This call never waits.  It returns
+ * TransportIOStatus_WouldBlock both while the stack has the connection blocked and while
+ * the queue is full; rtaTransport_GetSendQueueState() tells the two apart.
+ *
+ * A WouldBlock arms the connection's writable callback (rtaTransport_SetWritableCallback()),
+ * which is called once when the stack unblocks the connection and the queue has room.
+ *
+ * On an inline transport this tries the stack once, and WouldBlock means the API connector
+ * is blocked.  There is no writable callback; dispatch and try again.
+ *
+ * @param [in] transport A pointer to a valid RTATransport instance.
+ * @param [in] queueId The value returned by rtaTransport_Open()
+ * @param [in] message A pointer to a valid CCNxMetaMessage instance, the Transport takes its own reference
+ *
+ * @return TransportIOStatus_Success The message is on its way down the stack
+ * @return TransportIOStatus_WouldBlock The connection is not writable now (errno EWOULDBLOCK)
+ * @return TransportIOStatus_Error errno is EBADF for an unknown queueId, or EPIPE if the connection is closing
+ *
+ * Example:
+ * @code
+ * {
+ *     TransportIOStatus status = rtaTransport_TrySend(transport, queueId, message);
+ *     if (status == TransportIOStatus_WouldBlock) {
+ *         RtaSendQueueState state;
+ *         if (rtaTransport_GetSendQueueState(transport, queueId, &state) && state.blocked) {
+ *             // flow control, wait for the writable callback
+ *         }
+ *     }
+ * }
+ * @endcode
+ */
+TransportIOStatus rtaTransport_TrySend(RTATransport *transport, int queueId, const CCNxMetaMessage *message);
+
 TransportIOStatus rtaTransport_Recv(RTATransport *transport, const int queueId, CCNxMetaMessage **msgPtr, const uint64_t *microSeconds);
 
+/**
+ * Close a connection
+ *
+ * Returns once the Transport has closed the connection.  Safe to call from several threads
+ * at once, on different connections.
+ *
+ * @param [in] transport A pointer to a valid RTATransport instance.
+ * @param [in] desc The queueId returned by rtaTransport_Open()
+ *
+ * @return 0 The connection is closed
+ * @return -1 errno is EWOULDBLOCK if the command queue was full (the connection is still open),
+ *            or EBADF if the Transport has no such connection
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
 int rtaTransport_Close(RTATransport *transport, int desc);
 
 int rtaTransport_PassCommand(RTATransport *transport, const RtaCommand *rtacommand);
 
+/**
+ * Returns a snapshot of the statistics of every protocol stack and connection
+ *
+ * Sends an RtaCommandSnapshotStatistics to the Transport thread and waits for the answer.
+ * No file I/O is involved, so this is cheap enough to call every second.  The layout is
+ * described by rtaFramework_GetStatisticsSnapshot(): per-component counters and latency
+ * histograms for each stack and each connection, plus component-private counters such as
+ * the cache, PIT, flow controller windows and pacing, and the Metis connector.
+ *
+ * Must not be called from the Transport thread.
+ *
+ * @param [in] transport A pointer to a valid RTATransport instance.
+ * @param [in] microSeconds If NULL, wait forever, otherwise the longest time to wait
+ *
+ * @return non-null A PARCJSON object the caller must release
+ * @return null The command queue was full or the Transport did not answer in time
+ *
+ * Example:
+ * @code
+ * {
+ *     uint64_t timeout = 1000000;
+ *     PARCJSON *stats = rtaTransport_GetStatistics(transport, &timeout);
+ *     if (stats != NULL) {
+ *         char *string = parcJSON_ToString(stats);
+ *         printf("%s\n", string);
+ *         parcMemory_Deallocate((void **) &string);
+ *         parcJSON_Release(&stats);
+ *     }
+ * }
+ * @endcode
+ */
+PARCJSON *rtaTransport_GetStatistics(RTATransport *transport, const uint64_t *microSeconds);
+
+/**
+ * Copies the per-component counters of one connection without involving the Transport thread
+ *
+ * The counters live in a cache-line aligned block that only the Transport thread writes.
+ * This finds the connection without a lock and reads the counters with relaxed atomic loads,
+ * so it never waits on the Transport, or on Open and Close, and does not slow down the data
+ * path.  Each counter is exact, but the set is not one point in time.
+ * The counters stop when the connection is closed with rtaTransport_Close().
+ *
+ * Stack-wide totals are not included; use rtaTransport_GetStatistics() for those.
+ *
+ * `output->limits` has the connection's API queue sizes as they took effect, indexed by
+ * RtaConnectionLimit.  Socket buffer sizes are what the kernel reports, which on Linux is
+ * twice what was asked for.  A connection of an inline transport has neither a socket
+ * pair nor a send queue, so its limits are 0.
+ *
+ * @param [in] transport A pointer to a valid RTATransport instance.
+ * @param [in] queueId The value returned by rtaTransport_Open()
+ * @param [out] output Filled in with the counters, indexed by [component][statType], and the limits
+ *
+ * @return true The connection is open and `output` was filled in
+ * @return false No open connection has that queueId
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaConnectionStats stats;
+ *     if (rtaTransport_GetConnectionStats(transport, queueId, &stats)) {
+ *         printf("sent to api %" PRIu64 "\n", stats.counters[API_CONNECTOR][STATS_UPCALL_OUT]);
+ *     }
+ * }
+ * @endcode
+ */
+bool rtaTransport_GetConnectionStats(RTATransport *transport, int queueId, RtaConnectionStats *output);
+
+/**
+ * @typedef RtaBusyPollStats
+ * @abstract How a connection's busy-poll receive is doing, see rtaTransport_SetBusyPoll()
+ * @constant budgetUsec The configured spin budget, 0 if busy polling is off
+ * @constant windowUsec The current spin window, adapted between 0 and the budget
+ * @constant spinHits Receives whose message arrived while spinning
+ * @constant spinMisses Receives that spun the whole window and then blocked
+ * @constant spinSkips Receives that blocked without spinning because the window was 0
+ * @constant spinUsec Total time spent spinning
+ */
+typedef struct rta_busy_poll_stats {
+    uint64_t budgetUsec;
+    uint64_t windowUsec;
+    uint64_t spinHits;
+    uint64_t spinMisses;
+    uint64_t spinSkips;
+    uint64_t spinUsec;
+} RtaBusyPollStats;
+
+/**
+ * Spin-poll a connection in rtaTransport_Recv() before blocking
+ *
+ * A blocking receive sleeps in select(), and the wakeup costs a context switch and tens
+ * of microseconds.  With a budget, rtaTransport_Recv() first polls the connection without
+ * sleeping for up to a spin window, and only blocks if no message arrived in that time.
+ *
+ * The window adapts to recent arrivals.  It starts at the budget and halves after each
+ * receive that waited longer than the budget, so a connection with sparse traffic soon
+ * stops spinning and only costs a blocking select().  It doubles back towards the budget
+ * after each receive that waited less.  Tune the budget with rtaTransport_GetBusyPollStats().
+ *
+ * Spinning burns a CPU, so use it for latency sensitive consumers that have a core to spare.
+ * The statistics assume one thread receives on the connection at a time.
+ *
+ * @param [in] transport A transport from rtaTransport_Create()
+ * @param [in] queueId The value returned by rtaTransport_Open()
+ * @param [in] budgetUsec The longest spin in microseconds, e.g. 20, or 0 to turn busy polling off
+ *
+ * @return true The budget was set
+ * @return false No open connection has that queueId
+ *
+ * Example:
+ * @code
+ * {
+ *     int queueId = rtaTransport_Open(transport, config);
+ *     rtaTransport_SetBusyPoll(transport, queueId, 20);
+ * }
+ * @endcode
+ */
+bool rtaTransport_SetBusyPoll(RTATransport *transport, int queueId, uint64_t budgetUsec);
+
+/**
+ * Copies the busy-poll statistics of one connection
+ *
+ * A high ratio of spinHits to spinMisses means the budget catches most messages.  Many
+ * misses or skips mean messages arrive further apart than the budget and spinning wastes CPU.
+ *
+ * @param [in] transport A transport from rtaTransport_Create()
+ * @param [in] queueId The value returned by rtaTransport_Open()
+ * @param [out] output Filled in with the statistics
+ *
+ * @return true The connection is open and `output` was filled in
+ * @return false No open connection has that queueId
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaBusyPollStats stats;
+ *     if (rtaTransport_GetBusyPollStats(transport, queueId, &stats)) {
+ *         printf("spin hits %" PRIu64 " misses %" PRIu64 "\n", stats.spinHits, stats.spinMisses);
+ *     }
+ * }
+ * @endcode
+ */
+bool rtaTransport_GetBusyPollStats(RTATransport *transport, int queueId, RtaBusyPollStats *output);
+
+/**
+ * @typedef RtaSendQueueState
+ * @abstract The occupancy of a connection's send queue, see rtaTransport_GetSendQueueState()
+ * @constant count The messages waiting for the Transport thread
+ * @constant capacity The most messages the queue holds
+ * @constant blocked true while flow control in the stack holds the connection back
+ */
+typedef struct rta_send_queue_state {
+    size_t count;
+    size_t capacity;
+    bool blocked;
+} RtaSendQueueState;
+
+/**
+ * Copies the send queue occupancy of one connection
+ *
+ * After rtaTransport_TrySend() returns TransportIOStatus_WouldBlock, `blocked` says whether
+ * the stack is applying backpressure.  If it is not, the queue is full because the Transport
+ * thread has not caught up.  The values are a snapshot while other threads send.
+ *
+ * @param [in] transport A transport from rtaTransport_Create()
+ * @param [in] queueId The value returned by rtaTransport_Open()
+ * @param [out] output Filled in with the state
+ *
+ * @return true The connection is open and `output` was filled in
+ * @return false No open connection has that queueId
+ *
+ * Example:
+ * @code
+ * {
+ *     RtaSendQueueState state;
+ *     if (rtaTransport_GetSendQueueState(transport, queueId, &state)) {
+ *         printf("%zu of %zu queued%s\n", state.count, state.capacity, state.blocked ? ", blocked" : "");
+ *     }
+ * }
+ * @endcode
+ */
+bool rtaTransport_GetSendQueueState(RTATransport *transport, int queueId, RtaSendQueueState *output);
+
+/**
+ * Called on the Transport thread when a connection becomes writable, see rtaTransport_SetWritableCallback()
+ */
+typedef void (RtaTransportWritableCallback)(void *arg);
+
+/**
+ * Set the function called when a connection becomes writable again
+ *
+ * The callback is edge triggered.  A TransportIOStatus_WouldBlock from rtaTransport_TrySend()
+ * arms it, and it is called once, when the stack has unblocked the connection and its
+ * queue has room.  It is not called again until another TrySend is refused.  It may come
+ * after a TrySend that was refused but raced with the unblock, so a writable callback is a
+ * reason to try again, not a promise that the next send succeeds.
+ *
+ * The callback runs on the Transport thread and must not send, close, or block.  Write to
+ * an eventfd or signal a condition variable that the sending thread waits on.  It is not
+ * called after rtaTransport_Close() returns.
+ *
+ * @param [in] transport A transport from rtaTransport_Create()
+ * @param [in] queueId The value returned by rtaTransport_Open()
+ * @param [in] callback The function to call, or NULL for none
+ * @param [in] arg Passed to `callback`
+ *
+ * @return true The callback is set
+ * @return false No open connection has that queueId
+ *
+ * Example:
+ * @code
+ * static void
+ * writable(void *arg)
+ * {
+ *     uint64_t one = 1;
+ *     write(*(int *) arg, &one, sizeof(one));
+ * }
+ *
+ * {
+ *     int efd = eventfd(0, EFD_NONBLOCK);
+ *     rtaTransport_SetWritableCallback(transport, queueId, writable, &efd);
+ *     while (rtaTransport_TrySend(transport, queueId, message) == TransportIOStatus_WouldBlock) {
+ *         struct pollfd pfd = { .fd = efd, .events = POLLIN };
+ *         poll(&pfd, 1, -1);
+ *         uint64_t value;
+ *         read(efd, &value, sizeof(value));
+ *     }
+ * }
+ * @endcode
+ */
+bool rtaTransport_SetWritableCallback(RTATransport *transport, int queueId, RtaTransportWritableCallback *callback, void *arg);
+
+/**
+ * Run the Framework of an inline transport on the caller's thread
+ *
+ * Runs up to `budget` passes of the Framework's event loop without blocking.  Each pass
+ * moves a message at least one component along its stack, so a larger budget lets more
+ * work finish per call while a smaller one bounds the time spent in it.  Messages that
+ * reach the top of a stack are queued for rtaTransport_Recv().
+ *
+ * @param [in] transport A transport from rtaTransport_CreateInline()
+ * @param [in] budget The most event loop passes to run
+ *
+ * @return number The number of messages delivered to the application, on all connections
+ *
+ * Example:
+ * @code
+ * {
+ *     unsigned delivered = rtaTransport_Dispatch(transport, 64);
+ * }
+ * @endcode
+ */
+unsigned rtaTransport_Dispatch(RTATransport *transport, unsigned budget);
+
+/**
+ * Returns a descriptor that polls readable when an inline transport has work to dispatch
+ *
+ * It becomes readable when rtaTransport_Send() hands a message to a stack and when a
+ * dispatch delivers a message to the application, and rtaTransport_Dispatch() clears it.
+ * So after a dispatch that delivered messages it stays readable for one more dispatch,
+ * which finishes work that was still moving through the stack.  A dispatch whose budget
+ * ran out with messages still between components leaves it readable too.
+ *
+ * On Linux it also becomes readable when a timer of the framework is due (timeouts,
+ * retransmissions, pacing), and stays readable while a forwarder socket has data the
+ * connector has not read, so the application may poll it without a timeout.  On other systems timers and the forwarder's sockets are
+ * not reflected in this descriptor.  There, poll it with a timeout of at most one tick
+ * (1 millisecond, see rtaFramework_TicksToUsec()) and dispatch on every wakeup.
+ *
+ * The descriptor belongs to the transport, do not read it or close it.
+ *
+ * @param [in] transport A transport from rtaTransport_CreateInline()
+ *
+ * @return number A non-blocking descriptor to poll for POLLIN
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+int rtaTransport_GetDispatchFd(const RTATransport *transport);
+
 #endif // Libccnx_rta_Transport_h
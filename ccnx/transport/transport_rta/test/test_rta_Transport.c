@@ -68,6 +68,8 @@
 
 #include <LongBow/unit-test.h>
 
+#include <poll.h>
+
 typedef struct test_data {
     RTATransport *transport;
     CCNxMetaMessage *msg;
@@ -114,6 +116,28 @@ createSimpleConfig(TestData *data)
     return result;
 }
 
+/*
+ * Like createSimpleConfig, with the given API queue sizes
+ */
+static CCNxTransportConfig *
+createQueueConfig(const ApiConnectorQueueConfig *queueConfig)
+{
+    CCNxStackConfig *stackConfig =
+        testingLower_ProtocolStackConfig(apiConnector_ProtocolStackConfig(ccnxStackConfig_Create()));
+
+    CCNxConnectionConfig *connConfig =
+        testingLower_ConnectionConfig(
+            tlvCodec_ConnectionConfig(
+                apiConnector_QueueConnectionConfig(
+                    ccnxConnectionConfig_Create(), queueConfig)));
+
+    protocolStack_ComponentsConfigArgs(stackConfig, apiConnector_GetName(), testingLower_GetName(), NULL);
+
+    CCNxTransportConfig *result = ccnxTransportConfig_Create(stackConfig, connConfig);
+    ccnxStackConfig_Release(&stackConfig);
+    return result;
+}
+
 /**
  * Peek inside the RTA framework's connection table
  *
@@ -213,6 +237,7 @@ LONGBOW_TEST_RUNNER(rta_Transport)
     // Never rely on the execution order of tests or share state between them.
     LONGBOW_RUN_TEST_FIXTURE(Global);
     LONGBOW_RUN_TEST_FIXTURE(Local);
+    LONGBOW_RUN_TEST_FIXTURE(Inline);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -231,20 +256,39 @@ LONGBOW_TEST_RUNNER_TEARDOWN(rta_Transport)
 // ==================================================================================
 // Global
 
+static void
+_countWritable(void *arg)
+{
+    unsigned *count = arg;
+    (*count)++;
+}
+
 LONGBOW_TEST_FIXTURE(Global)
 {
     // These are still static functions, but they are the function pointers used
     // in the transport function structure.   They comprise the public API.
     LONGBOW_RUN_TEST_CASE(Global, rtaTransport_Close);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTransport_Close_NotOpen);
     LONGBOW_RUN_TEST_CASE(Global, rtaTransport_Create_Destroy);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTransport_GetConnectionStats);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTransport_GetConnectionStats_Limits);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTransport_GetStatistics);
     LONGBOW_RUN_TEST_CASE(Global, rtaTransport_Open);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTransport_OpenMany);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTransport_Open_ManyThreads);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTransport_Open_InvalidQueueConfig);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTransport_Open_MaxConnections);
     LONGBOW_RUN_TEST_CASE(Global, rtaTransport_PassCommand);
 
     LONGBOW_RUN_TEST_CASE(Global, rtaTransport_Recv_OK);
     LONGBOW_RUN_TEST_CASE(Global, rtaTransport_Recv_WouldBlock);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTransport_Recv_BusyPoll);
 
     LONGBOW_RUN_TEST_CASE(Global, rtaTransport_Send_OK);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTransport_Send_ManyThreads);
     LONGBOW_RUN_TEST_CASE(Global, rtaTransport_Send_WouldBlock);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTransport_TrySend_NotOpen);
+    LONGBOW_RUN_TEST_CASE(Global, rtaTransport_TrySend_FlowControl);
 
 //    LONGBOW_RUN_TEST_CASE(Global, unrecoverable);
 }
@@ -286,6 +330,15 @@ LONGBOW_TEST_CASE(Global, rtaTransport_Close)
     ccnxTransportConfig_Destroy(&config);
 }
 
+LONGBOW_TEST_CASE(Global, rtaTransport_Close_NotOpen)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    int result = rtaTransport_Close(data->transport, 9999);
+    assertTrue(result == -1, "Expected -1 closing a connection that is not open, got %d", result);
+    assertTrue(errno == EBADF, "Expected errno EBADF, got (%d) %s", errno, strerror(errno));
+}
+
 LONGBOW_TEST_CASE(Global, rtaTransport_Create_Destroy)
 {
     RTATransport *transport = rtaTransport_Create();
@@ -308,25 +361,227 @@ LONGBOW_TEST_CASE(Global, rtaTransport_Open)
     ccnxTransportConfig_Destroy(&config);
 }
 
+LONGBOW_TEST_CASE(Global, rtaTransport_OpenMany)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxTransportConfig *config = createSimpleConfig(data);
+
+    const int count = 5;
+    int queueIds[count];
+    int opened = rtaTransport_OpenMany(data->transport, config, count, queueIds);
+    assertTrue(opened == count, "Wrong number opened, got %d expected %d", opened, count);
+
+    for (int i = 0; i < count; i++) {
+        RtaConnection *conn = lookupRtaConnectionInsideFramework(data, queueIds[i], 1E+6);
+        assertNotNull(conn, "Could not find connection %d", i);
+        assertNotNull(_rtaTransport_GetConnectionEntry(data->transport, queueIds[i]), "Transport has no entry for connection %d", i);
+    }
+
+    for (int i = 0; i < count; i++) {
+        rtaTransport_Close(data->transport, queueIds[i]);
+        bool gone = lookupNullRtaConnectionInsideFramework(data, queueIds[i], 1E+6);
+        assertTrue(gone, "Did not remove connection %d after 1 second timeout", i);
+    }
+
+    ccnxTransportConfig_Destroy(&config);
+}
+
+typedef struct open_thread {
+    RTATransport *transport;
+    CCNxTransportConfig *config;
+    int failures;
+} _OpenThread;
+
+static void *
+_openCloseLoop(void *arg)
+{
+    _OpenThread *openThread = arg;
+    for (int i = 0; i < 50; i++) {
+        int queueId = rtaTransport_Open(openThread->transport, openThread->config);
+        if (queueId < 0 || rtaTransport_Close(openThread->transport, queueId) != 0) {
+            openThread->failures++;
+        }
+    }
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Global, rtaTransport_Open_ManyThreads)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxTransportConfig *config = createSimpleConfig(data);
+
+    const int threadCount = 4;
+    pthread_t threads[threadCount];
+    _OpenThread openThreads[threadCount];
+    for (int i = 0; i < threadCount; i++) {
+        openThreads[i] = (_OpenThread) { .transport = data->transport, .config = config, .failures = 0 };
+        pthread_create(&threads[i], NULL, _openCloseLoop, &openThreads[i]);
+    }
+
+    for (int i = 0; i < threadCount; i++) {
+        pthread_join(threads[i], NULL);
+        assertTrue(openThreads[i].failures == 0, "Thread %d had %d failed opens or closes", i, openThreads[i].failures);
+    }
+
+    // every close completed, so the Transport has no connections left
+    parcDeque_Lock(data->transport->list);
+    bool empty = TAILQ_EMPTY(&data->transport->connections);
+    parcDeque_Unlock(data->transport->list);
+    assertTrue(empty, "Expected no connection entries after closing them all");
+
+    ccnxTransportConfig_Destroy(&config);
+}
+
+LONGBOW_TEST_CASE(Global, rtaTransport_GetConnectionStats)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxTransportConfig *config = createSimpleConfig(data);
+
+    int api_fd = rtaTransport_Open(data->transport, config);
+    RtaConnection *conn = lookupRtaConnectionInsideFramework(data, api_fd, 1E+6);
+    assertNotNull(conn, "Could not find connection");
+
+    // the connection counts into the block the transport handed it
+    _ConnectionEntry *entry = _rtaTransport_GetConnectionEntry(data->transport, api_fd);
+    assertNotNull(entry, "Transport has no entry for the connection");
+    assertTrue(rtaConnection_GetCounters(conn) == entry->counters, "Connection does not share the transport's counters");
+
+    RtaConnectionStats stats;
+    bool success = rtaTransport_GetConnectionStats(data->transport, api_fd, &stats);
+    assertTrue(success, "Could not get stats of an open connection");
+
+    rtaTransport_Close(data->transport, api_fd);
+    success = rtaTransport_GetConnectionStats(data->transport, api_fd, &stats);
+    assertFalse(success, "Got stats of a closed connection");
+
+    ccnxTransportConfig_Destroy(&config);
+}
+
+LONGBOW_TEST_CASE(Global, rtaTransport_GetConnectionStats_Limits)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    ApiConnectorQueueConfig queueConfig = { .sendQueueDepth = 1000, .receiveBufferBytes = 65536, .sendBufferBytes = 32768, .writeWatermarkBytes = 2048 };
+    CCNxTransportConfig *config = createQueueConfig(&queueConfig);
+
+    int api_fd = rtaTransport_Open(data->transport, config);
+    assertTrue(api_fd >= 0, "Could not open a connection with valid queue sizes: (%d) %s", errno, strerror(errno));
+
+    RtaConnectionStats stats;
+    bool success = rtaTransport_GetConnectionStats(data->transport, api_fd, &stats);
+    assertTrue(success, "Could not get stats of an open connection");
+
+    // the depth is rounded up to a power of 2, the kernel may grow the buffers
+    assertTrue(stats.limits[RTA_LIMIT_SEND_QUEUE_DEPTH] == 1024, "Expected depth 1024, got %" PRIu64, stats.limits[RTA_LIMIT_SEND_QUEUE_DEPTH]);
+    assertTrue(stats.limits[RTA_LIMIT_RECEIVE_BUFFER] >= 65536, "Expected a receive buffer of at least 65536, got %" PRIu64, stats.limits[RTA_LIMIT_RECEIVE_BUFFER]);
+    assertTrue(stats.limits[RTA_LIMIT_SEND_BUFFER] >= 32768, "Expected a send buffer of at least 32768, got %" PRIu64, stats.limits[RTA_LIMIT_SEND_BUFFER]);
+    assertTrue(stats.limits[RTA_LIMIT_WRITE_WATERMARK] == 2048, "Expected watermark 2048, got %" PRIu64, stats.limits[RTA_LIMIT_WRITE_WATERMARK]);
+
+    RtaSendQueueState state;
+    rtaTransport_GetSendQueueState(data->transport, api_fd, &state);
+    assertTrue(state.capacity == 1024, "Expected a send queue of 1024, got %zu", state.capacity);
+
+    rtaTransport_Close(data->transport, api_fd);
+    ccnxTransportConfig_Destroy(&config);
+}
+
+LONGBOW_TEST_CASE(Global, rtaTransport_GetStatistics)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxTransportConfig *config = createSimpleConfig(data);
+
+    int api_fd = rtaTransport_Open(data->transport, config);
+    RtaConnection *conn = lookupRtaConnectionInsideFramework(data, api_fd, 1E+6);
+    assertNotNull(conn, "Could not find connection");
+
+    uint64_t timeout = 1000000;
+    PARCJSON *stats = rtaTransport_GetStatistics(data->transport, &timeout);
+    assertNotNull(stats, "Got null statistics snapshot");
+
+    PARCJSONValue *value = parcJSON_GetValueByName(stats, "stacks");
+    assertTrue(value != NULL && parcJSONValue_IsArray(value), "Snapshot missing stacks array");
+    assertTrue(parcJSONArray_GetLength(parcJSONValue_GetArray(value)) == 1, "Expected one protocol stack");
+
+    parcJSON_Release(&stats);
+    ccnxTransportConfig_Destroy(&config);
+}
+
 /**
  * PassCommand sends a user RTA Command over the command channel.
  * This test will intercept the transport side of the command channel so
  * we can easily verify the command went through.
  */
+LONGBOW_TEST_CASE(Global, rtaTransport_Open_InvalidQueueConfig)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    ApiConnectorQueueConfig queueConfig = *apiConnector_GetDefaultQueueConfig();
+    queueConfig.sendQueueDepth = 1;
+    CCNxTransportConfig *config = createQueueConfig(&queueConfig);
+
+    int api_fd = rtaTransport_Open(data->transport, config);
+    assertTrue(api_fd == -1, "Expected -1 opening with an invalid send queue depth, got %d", api_fd);
+    assertTrue(errno == EINVAL, "Expected errno EINVAL, got (%d) %s", errno, strerror(errno));
+
+    int queueIds[4];
+    int opened = rtaTransport_OpenMany(data->transport, config, 4, queueIds);
+    assertTrue(opened == 0, "Expected no connections opened with an invalid send queue depth, got %d", opened);
+    assertTrue(errno == EINVAL, "Expected errno EINVAL, got (%d) %s", errno, strerror(errno));
+
+    ccnxTransportConfig_Destroy(&config);
+}
+
+/**
+ * Past maxConnections an open fails with EMFILE and leaves nothing behind
+ */
+LONGBOW_TEST_CASE(Global, rtaTransport_Open_MaxConnections)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    rtaTransport_Destroy(&data->transport);
+
+    TransportInstanceOptions options = TransportInstanceOptions_Default;
+    options.maxConnections = 2;
+    data->transport = rtaTransport_CreateWithOptions(&options);
+    CCNxTransportConfig *config = createSimpleConfig(data);
+
+    int first = rtaTransport_Open(data->transport, config);
+    int second = rtaTransport_Open(data->transport, config);
+    assertTrue(first >= 0 && second >= 0, "Could not open up to the limit, got %d and %d", first, second);
+
+    int third = rtaTransport_Open(data->transport, config);
+    assertTrue(third == -1, "Expected -1 opening past the limit, got %d", third);
+    assertTrue(errno == EMFILE, "Expected errno EMFILE, got (%d) %s", errno, strerror(errno));
+
+    int queueIds[2];
+    int opened = rtaTransport_OpenMany(data->transport, config, 2, queueIds);
+    assertTrue(opened == 0, "Expected no connections opened past the limit, got %d", opened);
+    assertTrue(errno == EMFILE, "Expected errno EMFILE, got (%d) %s", errno, strerror(errno));
+
+    // Closing one makes room again
+    rtaTransport_Close(data->transport, first);
+    bool gone = lookupNullRtaConnectionInsideFramework(data, first, 1E+6);
+    assertTrue(gone, "Did not remove connection %d after 1 second timeout", first);
+
+    third = rtaTransport_Open(data->transport, config);
+    assertTrue(third >= 0, "Could not open after a close, got %d", third);
+
+    rtaTransport_Close(data->transport, second);
+    rtaTransport_Close(data->transport, third);
+    ccnxTransportConfig_Destroy(&config);
+}
+
 LONGBOW_TEST_CASE(Global, rtaTransport_PassCommand)
 {
     TestData *data = longBowTestCase_GetClipBoardData(testCase);
 
-    PARCRingBuffer1x1 *previousRingBuffer = data->transport->commandRingBuffer;
+    RtaCommandQueue *previousQueue = data->transport->commandQueue;
     PARCNotifier *previousNotifier = data->transport->commandNotifier;
 
-    PARCRingBuffer1x1 *testRingBuffer = parcRingBuffer1x1_Create(32, NULL);
+    RtaCommandQueue *testQueue = rtaCommandQueue_Create(32);
     PARCNotifier *testNotifier = parcNotifier_Create();
 
 
     // Insert our new socket pair so we can intercept the commands
     // No acquire here because we will be resetting them and destroying all in this scope
-    data->transport->commandRingBuffer = testRingBuffer;
+    data->transport->commandQueue = testQueue;
     data->transport->commandNotifier = testNotifier;
 
     // Create a simple command to send
@@ -334,7 +589,7 @@ LONGBOW_TEST_CASE(Global, rtaTransport_PassCommand)
     rtaTransport_PassCommand(data->transport, command);
     rtaCommand_Release(&command);
 
-    RtaCommand *testCommand = rtaCommand_Read(testRingBuffer);
+    RtaCommand *testCommand = rtaCommand_Read(testQueue);
     assertNotNull(testCommand, "Got null command from the ring buffer.");
     assertTrue(rtaCommand_IsShutdownFramework(testCommand), "Command not a shutdown framework");
 
@@ -343,10 +598,10 @@ LONGBOW_TEST_CASE(Global, rtaTransport_PassCommand)
     rtaCommand_Release(&testCommand);
 
     // now restore the sockets so things close up nicely
-    data->transport->commandRingBuffer = previousRingBuffer;
+    data->transport->commandQueue = previousQueue;
     data->transport->commandNotifier = previousNotifier;
 
-    parcRingBuffer1x1_Release(&testRingBuffer);
+    rtaCommandQueue_Release(&testQueue);
     parcNotifier_Release(&testNotifier);
 }
 
@@ -403,6 +658,54 @@ LONGBOW_TEST_CASE(Global, rtaTransport_Recv_WouldBlock)
     close(transport_fd);
 }
 
+LONGBOW_TEST_CASE(Global, rtaTransport_Recv_BusyPoll)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    _RTASocketPair pair = _rtaTransport_CreateSocketPair(data->transport, 128 * 1024);
+
+    // Register the pair as if rtaTransport_Open() had created it
+    _ConnectionEntry *entry = _rtaTransport_AddConnectionEntry(data->transport, pair.up, apiConnector_GetDefaultQueueConfig());
+    bool success = rtaTransport_SetBusyPoll(data->transport, pair.up, 1000);
+    assertTrue(success, "Could not set the busy-poll budget of an open connection");
+    assertTrue(data->transport->busyPollConnections == 1, "Expected 1 busy-poll connection, got %u", data->transport->busyPollConnections);
+
+    // A message that is already waiting is found on the first poll
+    char *buffer = "born free, as free as the wind blows";
+    ssize_t nwritten = write(pair.down, &buffer, sizeof(&buffer));
+    assertTrue(nwritten == sizeof(&buffer), "Wrong write size, expected %zu got %zd", sizeof(&buffer), nwritten);
+
+    CCNxMetaMessage *msg = NULL;
+    TransportIOStatus result = rtaTransport_Recv(data->transport, pair.up, &msg, CCNxStackTimeout_Never);
+    assertTrue(result == TransportIOStatus_Success, "Failed to read a good socket");
+    assertTrue((void *) msg == (void *) buffer, "Read wrong pointer, got %p expected %p", (void *) msg, (void *) buffer);
+
+    // Nothing to read spins the window, then blocks for the rest of the timeout
+    uint64_t timeout = 2000;
+    result = rtaTransport_Recv(data->transport, pair.up, &msg, &timeout);
+    assertTrue(result == TransportIOStatus_Timeout, "Should have timed out");
+
+    RtaBusyPollStats stats;
+    success = rtaTransport_GetBusyPollStats(data->transport, pair.up, &stats);
+    assertTrue(success, "Could not get the busy-poll stats of an open connection");
+    assertTrue(stats.budgetUsec == 1000, "Wrong budget, expected 1000 got %" PRIu64, stats.budgetUsec);
+    assertTrue(stats.spinHits == 1, "Expected 1 spin hit, got %" PRIu64, stats.spinHits);
+    assertTrue(stats.spinMisses == 1, "Expected 1 spin miss, got %" PRIu64, stats.spinMisses);
+    assertTrue(stats.spinUsec >= 1000, "Expected at least one full window of spinning, got %" PRIu64, stats.spinUsec);
+
+    rtaTransport_SetBusyPoll(data->transport, pair.up, 0);
+    assertTrue(data->transport->busyPollConnections == 0, "Expected 0 busy-poll connections, got %u", data->transport->busyPollConnections);
+
+    // A closed entry is hidden from lookups, and is freed when the transport is destroyed
+    rtaTransport_SetBusyPoll(data->transport, pair.up, 1000);
+    _rtaTransport_CloseConnectionEntry(data->transport, entry);
+    assertTrue(data->transport->busyPollConnections == 0, "Close should drop the busy-poll count, got %u", data->transport->busyPollConnections);
+    success = rtaTransport_GetBusyPollStats(data->transport, pair.up, &stats);
+    assertFalse(success, "Got busy-poll stats of a closed connection");
+
+    close(pair.up);
+    close(pair.down);
+}
 
 /**
  * This function will receive what the API Connector sends down the stack
@@ -469,6 +772,122 @@ LONGBOW_TEST_CASE(Global, rtaTransport_Send_OK)
     ccnxTransportConfig_Destroy(&config);
 }
 
+#define _senders 4
+#define _perSender 100
+
+typedef struct send_order {
+    unsigned next[_senders];
+    unsigned received;
+    unsigned outOfOrder;
+} _SendOrder;
+
+typedef struct send_tag {
+    unsigned sender;
+    unsigned sequence;
+    _SendOrder *order;
+} _SendTag;
+
+/**
+ * Checks that the messages of each sender reach the bottom of the stack in order
+ */
+static void
+mockDowncallReadOrder(PARCEventQueue *queue, PARCEventType type, void *stack)
+{
+    TransportMessage *tm;
+    while ((tm = rtaComponent_GetMessage(queue)) != NULL) {
+        CCNxTlvDictionary *dictionary = transportMessage_GetDictionary(tm);
+        CCNxCodecNetworkBufferIoVec *vec = ccnxWireFormatMessage_GetIoVec(dictionary);
+        const struct iovec *iov = ccnxCodecNetworkBufferIoVec_GetArray(vec);
+
+        _SendTag *tag = iov[0].iov_base;
+        if (tag->order->next[tag->sender] != tag->sequence) {
+            tag->order->outOfOrder++;
+        }
+        tag->order->next[tag->sender] = tag->sequence + 1;
+        tag->order->received++;
+
+        transportMessage_Destroy(&tm);
+    }
+}
+
+typedef struct sender_args {
+    RTATransport *transport;
+    int queueId;
+    CCNxMetaMessage **messages;
+    unsigned failures;
+} _SenderArgs;
+
+static void *
+_sendAll(void *argVoid)
+{
+    _SenderArgs *args = argVoid;
+    for (int i = 0; i < _perSender; i++) {
+        if (!rtaTransport_Send(args->transport, args->queueId, args->messages[i], CCNxStackTimeout_Never)) {
+            args->failures++;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Several threads send on one connection.  Every message arrives, and each thread's
+ * messages arrive in the order it sent them.
+ */
+LONGBOW_TEST_CASE(Global, rtaTransport_Send_ManyThreads)
+{
+    testing_null_ops.downcallRead = mockDowncallReadOrder;
+
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxTransportConfig *config = createSimpleConfig(data);
+    int api_fd = rtaTransport_Open(data->transport, config);
+
+    _SendOrder order;
+    memset(&order, 0, sizeof(order));
+
+    _SendTag tags[_senders][_perSender];
+    CCNxCodecNetworkBuffer *netbuffs[_senders][_perSender];
+    CCNxCodecNetworkBufferIoVec *vecs[_senders][_perSender];
+    CCNxMetaMessage *messages[_senders][_perSender];
+    for (int t = 0; t < _senders; t++) {
+        for (int i = 0; i < _perSender; i++) {
+            tags[t][i] = (_SendTag) { .sender = t, .sequence = i, .order = &order };
+            netbuffs[t][i] = ccnxCodecNetworkBuffer_CreateFromArray(&memfunc, NULL, sizeof(_SendTag), (uint8_t *) &tags[t][i]);
+            vecs[t][i] = ccnxCodecNetworkBuffer_CreateIoVec(netbuffs[t][i]);
+            messages[t][i] = ccnxWireFormatMessage_FromInterestPacketTypeIoVec(CCNxTlvDictionary_SchemaVersion_V1, vecs[t][i]);
+        }
+    }
+
+    pthread_t threads[_senders];
+    _SenderArgs args[_senders];
+    for (int t = 0; t < _senders; t++) {
+        args[t] = (_SenderArgs) { .transport = data->transport, .queueId = api_fd, .messages = messages[t], .failures = 0 };
+        pthread_create(&threads[t], NULL, _sendAll, &args[t]);
+    }
+    for (int t = 0; t < _senders; t++) {
+        pthread_join(threads[t], NULL);
+        assertTrue(args[t].failures == 0, "Sender %d had %u failed sends", t, args[t].failures);
+    }
+
+    unsigned maxTries = 4000;   // about 2 seconds
+    while (__atomic_load_n(&order.received, __ATOMIC_RELAXED) < _senders * _perSender && maxTries > 0) {
+        maxTries--;
+        usleep(500);
+    }
+
+    assertTrue(order.received == _senders * _perSender, "Expected %d messages, got %u", _senders * _perSender, order.received);
+    assertTrue(order.outOfOrder == 0, "Got %u messages out of their sender's order", order.outOfOrder);
+
+    rtaTransport_Close(data->transport, api_fd);
+    for (int t = 0; t < _senders; t++) {
+        for (int i = 0; i < _perSender; i++) {
+            ccnxTlvDictionary_Release(&messages[t][i]);
+            ccnxCodecNetworkBufferIoVec_Release(&vecs[t][i]);
+            ccnxCodecNetworkBuffer_Release(&netbuffs[t][i]);
+        }
+    }
+    ccnxTransportConfig_Destroy(&config);
+}
+
 /**
  * Fill up the socket with junk, then make sure it would blocks
  */
@@ -513,6 +932,76 @@ LONGBOW_TEST_CASE(Global, rtaTransport_Send_WouldBlock)
     close(transport_fd);
 }
 
+LONGBOW_TEST_CASE(Global, rtaTransport_TrySend_NotOpen)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxTlvDictionary *interest = trafficTools_CreateDictionaryInterest();
+
+    TransportIOStatus status = rtaTransport_TrySend(data->transport, 9999, interest);
+    assertTrue(status == TransportIOStatus_Error, "Expected TransportIOStatus_Error, got %d", status);
+    assertTrue(errno == EBADF, "Expected errno EBADF, got (%d) %s", errno, strerror(errno));
+
+    RtaSendQueueState state;
+    assertFalse(rtaTransport_GetSendQueueState(data->transport, 9999, &state), "Got a send queue state for a connection that is not open");
+    assertFalse(rtaTransport_SetWritableCallback(data->transport, 9999, _countWritable, NULL), "Set a callback for a connection that is not open");
+
+    ccnxTlvDictionary_Release(&interest);
+}
+
+/**
+ * Block the send queue the way the API connector does under flow control, and check that
+ * TrySend reports it, the state shows it, and the unblock calls the writable callback once
+ */
+LONGBOW_TEST_CASE(Global, rtaTransport_TrySend_FlowControl)
+{
+    testing_null_ops.downcallRead = mockDowncallRead;
+
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxTransportConfig *config = createSimpleConfig(data);
+    int api_fd = rtaTransport_Open(data->transport, config);
+
+    unsigned downcallReadCount = 0;
+    CCNxCodecNetworkBuffer *netbuff = ccnxCodecNetworkBuffer_CreateFromArray(&memfunc, NULL, sizeof(downcallReadCount), (uint8_t *) &downcallReadCount);
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecNetworkBuffer_CreateIoVec(netbuff);
+    CCNxTlvDictionary *wire = ccnxWireFormatMessage_FromInterestPacketTypeIoVec(CCNxTlvDictionary_SchemaVersion_V1, vec);
+
+    unsigned writable = 0;
+    assertTrue(rtaTransport_SetWritableCallback(data->transport, api_fd, _countWritable, &writable), "Could not set the writable callback");
+
+    RtaSendQueue *sendQueue = _rtaTransport_GetSendQueue(data->transport, api_fd);
+    rtaSendQueue_SetBlocked(sendQueue, true);
+
+    TransportIOStatus status = rtaTransport_TrySend(data->transport, api_fd, wire);
+    assertTrue(status == TransportIOStatus_WouldBlock, "Expected TransportIOStatus_WouldBlock, got %d", status);
+    assertTrue(errno == EWOULDBLOCK, "Expected errno EWOULDBLOCK, got (%d) %s", errno, strerror(errno));
+
+    RtaSendQueueState state;
+    assertTrue(rtaTransport_GetSendQueueState(data->transport, api_fd, &state), "No send queue state for an open connection");
+    assertTrue(state.blocked, "The state should show the connection blocked");
+    assertTrue(state.count == 0, "Expected an empty queue, got %zu", state.count);
+    assertTrue(state.capacity == RTA_SEND_QUEUE_DEFAULT_CAPACITY, "Expected capacity %d, got %zu", RTA_SEND_QUEUE_DEFAULT_CAPACITY, state.capacity);
+    assertTrue(writable == 0, "Writable callback called while blocked");
+
+    rtaSendQueue_SetBlocked(sendQueue, false);
+    assertTrue(writable == 1, "Expected one writable callback after the unblock, got %u", writable);
+
+    status = rtaTransport_TrySend(data->transport, api_fd, wire);
+    assertTrue(status == TransportIOStatus_Success, "Expected TransportIOStatus_Success after the unblock, got %d", status);
+
+    unsigned maxTries = 2000;   // about 1 second
+    while (__atomic_load_n(&downcallReadCount, __ATOMIC_RELAXED) == 0 && maxTries > 0) {
+        maxTries--;
+        usleep(500);
+    }
+    assertTrue(downcallReadCount == 1, "Expected the stack to read 1 message, got %u", downcallReadCount);
+
+    rtaTransport_Close(data->transport, api_fd);
+    ccnxTlvDictionary_Release(&wire);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+    ccnxCodecNetworkBuffer_Release(&netbuff);
+    ccnxTransportConfig_Destroy(&config);
+}
+
 /**
  * Pass it an invalid socket.  This will cause a trap in the send code.
  */
@@ -546,12 +1035,17 @@ LONGBOW_TEST_FIXTURE(Local)
     LONGBOW_RUN_TEST_CASE(Local, _rtaTransport_AddStack);
     LONGBOW_RUN_TEST_CASE(Local, _rtaTransport_GetStack);
     LONGBOW_RUN_TEST_CASE(Local, _rtaTransport_GetStack_Missing);
+    LONGBOW_RUN_TEST_CASE(Local, _rtaTransport_GetStack_Many);
 
     LONGBOW_RUN_TEST_CASE(Local, _rtaTransport_CreateSocketPair);
     LONGBOW_RUN_TEST_CASE(Local, _rtaTransport_GetProtocolStackEntry_Exists);
     LONGBOW_RUN_TEST_CASE(Local, _rtaTransport_GetProtocolStackEntry_NotExists);
     LONGBOW_RUN_TEST_CASE(Local, _rtaTransport_AddProtocolStackEntry);
-    LONGBOW_RUN_TEST_CASE(Local, _rtaTransport_CreateConnection);
+    LONGBOW_RUN_TEST_CASE(Local, _rtaTransport_Create_CommandQueueSize);
+    LONGBOW_RUN_TEST_CASE(Local, _rtaTransport_Create_EnvironmentCpus);
+    LONGBOW_RUN_TEST_CASE(Local, _rtaTransport_Create_ThreadConfig);
+    LONGBOW_RUN_TEST_CASE(Local, _rtaTransport_SendCommandAndWait);
+    LONGBOW_RUN_TEST_CASE(Local, _rtaTransport_BusyPollAdapt);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Local)
@@ -644,27 +1138,111 @@ LONGBOW_TEST_CASE(Local, _rtaTransport_AddProtocolStackEntry)
     _StackEntry *entry = _rtaTransport_AddProtocolStackEntry(data->transport, config);
     assertNotNull(entry, "Got null entry from _rtaTransport_AddProtocolStackEntry");
 
+    // The entry carries the compiled configuration sent to the Framework
+    CCNxStackConfig *stackConfig = ccnxTransportConfig_GetStackConfig(config);
+    assertNotNull(entry->descriptor, "The entry has no descriptor");
+    assertTrue(entry->hash == ccnxStackConfig_HashCode(stackConfig), "Wrong hash in the entry");
+    assertTrue(ccnxStackConfig_Equals(rtaStackDescriptor_GetStackConfig(entry->descriptor), stackConfig),
+               "The descriptor does not hold the stack configuration");
+    assertTrue(rtaStackDescriptor_GetComponentCount(entry->descriptor) > 0, "The descriptor has no components");
+
     ccnxTransportConfig_Destroy(&config);
 }
 
-LONGBOW_TEST_CASE(Local, _rtaTransport_CreateConnection)
+LONGBOW_TEST_CASE(Local, _rtaTransport_Create_CommandQueueSize)
+{
+    TransportInstanceOptions options = { .cpu = -1, .commandQueueSize = 16, .commandTimeoutUsec = 5000 };
+    RTATransport *transport = rtaTransport_CreateWithOptions(&options);
+
+    assertTrue(rtaCommandQueue_Capacity(transport->commandQueue) == 16,
+               "Wrong capacity, got %zu expected 16", rtaCommandQueue_Capacity(transport->commandQueue));
+    assertTrue(transport->commandTimeoutUsec == 5000, "Wrong timeout, got %" PRIu64 " expected 5000", transport->commandTimeoutUsec);
+
+    rtaTransport_Destroy(&transport);
+
+    transport = rtaTransport_Create();
+    assertTrue(rtaCommandQueue_Capacity(transport->commandQueue) == RTA_COMMAND_QUEUE_DEFAULT_CAPACITY,
+               "Wrong default capacity, got %zu", rtaCommandQueue_Capacity(transport->commandQueue));
+    assertTrue(transport->commandTimeoutUsec == RTA_TRANSPORT_COMMAND_TIMEOUT_USEC,
+               "Wrong default timeout, got %" PRIu64, transport->commandTimeoutUsec);
+    rtaTransport_Destroy(&transport);
+}
+
+LONGBOW_TEST_CASE(Local, _rtaTransport_Create_EnvironmentCpus)
+{
+    // The default options have no cpu, so they must not replace the CPUs from the environment
+    setenv("RTA_FRAMEWORK_CPUS", "0", 1);
+    RTATransport *transport = rtaTransport_Create();
+    unsetenv("RTA_FRAMEWORK_CPUS");
+
+    assertTrue(rtaThreadConfig_HasCpu(&transport->framework->threadConfig, 0), "Lost CPU 0 from RTA_FRAMEWORK_CPUS");
+    assertTrue(rtaThreadConfig_CpuCount(&transport->framework->threadConfig) == 1,
+               "Expected 1 CPU, got %u", rtaThreadConfig_CpuCount(&transport->framework->threadConfig));
+    rtaTransport_Destroy(&transport);
+}
+
+LONGBOW_TEST_CASE(Local, _rtaTransport_Create_ThreadConfig)
+{
+    RtaThreadConfig config;
+    rtaThreadConfig_Init(&config);
+    rtaThreadConfig_AddCpu(&config, 0);
+    config.priority = 7;
+
+    TransportInstanceOptions options = TransportInstanceOptions_Default;
+    options.threadConfig = &config;
+    RTATransport *transport = rtaTransport_CreateWithOptions(&options);
+
+    const RtaThreadConfig *applied = &transport->framework->threadConfig;
+    assertTrue(rtaThreadConfig_HasCpu(applied, 0), "The thread config CPU was not set");
+    assertTrue(applied->priority == 7, "Wrong priority, expected 7 got %d", applied->priority);
+    assertTrue(applied->numaNode == -1, "Wrong NUMA node, expected -1 got %d", applied->numaNode);
+    rtaTransport_Destroy(&transport);
+}
+
+LONGBOW_TEST_CASE(Local, _rtaTransport_SendCommandAndWait)
 {
     TestData *data = longBowTestCase_GetClipBoardData(testCase);
     CCNxTransportConfig *config = createSimpleConfig(data);
 
-    _StackEntry *entry = _rtaTransport_AddProtocolStackEntry(data->transport, config);
+    _StackEntry *stack = _rtaTransport_AddProtocolStackEntry(data->transport, config);
 
     _RTASocketPair pair = _rtaTransport_CreateSocketPair(data->transport, 128 * 1024);
+    _ConnectionEntry *entry = _rtaTransport_AddConnectionEntry(data->transport, pair.up, apiConnector_GetDefaultQueueConfig());
+
+    RtaCommandOpenConnection *openConnection = _rtaTransport_CreateOpenConnection(config, stack, pair, entry);
+    RtaCommand *command = rtaCommand_CreateOpenConnection(openConnection);
+    rtaCommandOpenConnection_Release(&openConnection);
 
-    _rtaTransport_CreateConnection(data->transport, config, entry, pair);
+    int result = _rtaTransport_SendCommandAndWait(data->transport, command);
+    assertTrue(result == 0, "Expected 0, got %d: (%d) %s", result, errno, strerror(errno));
+    rtaCommand_Release(&command);
 
-    // wait up to 1 second
-    RtaConnection *conn = lookupRtaConnectionInsideFramework(data, pair.up, 1E+6);
-    assertNotNull(conn, "Could not find connection in connection table, timeout at %.6f seconds", 1.0);
+    // The open is complete, so no need to wait for it
+    RtaConnection *conn = lookupRtaConnectionInsideFramework(data, pair.up, 0);
+    assertNotNull(conn, "Could not find connection in connection table after the open completed");
 
     ccnxTransportConfig_Destroy(&config);
 }
 
+LONGBOW_TEST_CASE(Local, _rtaTransport_BusyPollAdapt)
+{
+    _BusyPoll busyPoll = { .budgetUsec = 20, .windowUsec = 20 };
+
+    // Waits longer than the budget halve the window down to 0
+    uint64_t expected[] = { 10, 5, 2, 1, 0, 0 };
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        _rtaTransport_BusyPollAdapt(&busyPoll, 100);
+        assertTrue(busyPoll.windowUsec == expected[i], "Step %zu expected window %" PRIu64 " got %" PRIu64, i, expected[i], busyPoll.windowUsec);
+    }
+
+    // A wait within the budget restarts at a quarter of it and doubles up to the budget
+    uint64_t growing[] = { 5, 10, 20, 20 };
+    for (size_t i = 0; i < sizeof(growing) / sizeof(growing[0]); i++) {
+        _rtaTransport_BusyPollAdapt(&busyPoll, 15);
+        assertTrue(busyPoll.windowUsec == growing[i], "Step %zu expected window %" PRIu64 " got %" PRIu64, i, growing[i], busyPoll.windowUsec);
+    }
+}
+
 LONGBOW_TEST_CASE(Local, _rtaTransport_AddStack)
 {
     TestData *data = longBowTestCase_GetClipBoardData(testCase);
@@ -730,6 +1308,429 @@ LONGBOW_TEST_CASE(Local, _rtaTransport_GetStack_Missing)
     assertNull(test, "Wrong pointer, got %p expected %p", (void *) test, NULL);
 }
 
+LONGBOW_TEST_CASE(Local, _rtaTransport_GetStack_Many)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    // Enough stacks to grow stacksByHash several times
+    _StackEntry *entries[100];
+    PARCHashCode hashes[100];
+    const size_t count = sizeof(entries) / sizeof(entries[0]);
+
+    CCNxStackConfig *stackConfig = ccnxStackConfig_Create();
+    char key[16];
+    for (size_t i = 0; i < count; i++) {
+        sprintf(key, "key%zu", i);
+        PARCJSONValue *json = parcJSONValue_CreateFromNULL();
+        ccnxStackConfig_Add(stackConfig, key, json);
+        parcJSONValue_Release(&json);
+
+        hashes[i] = ccnxStackConfig_HashCode(stackConfig);
+        entries[i] = _rtaTransport_AddStack(data->transport, stackConfig);
+    }
+    ccnxStackConfig_Release(&stackConfig);
+
+    assertTrue(data->transport->stacksByHashLength >= 2 * count, "The table is more than half full, length %zu", data->transport->stacksByHashLength);
+
+    for (size_t i = 0; i < count; i++) {
+        _StackEntry *test = _rtaTransport_GetStack(data->transport, hashes[i]);
+        assertTrue(test == entries[i], "Entry %zu: wrong pointer, got %p expected %p", i, (void *) test, (void *) entries[i]);
+        assertTrue(test->stack_id == entries[0]->stack_id + (int) i, "Entry %zu: wrong stack_id %d", i, test->stack_id);
+    }
+}
+
+// ==================================================================================
+// Inline
+
+LONGBOW_TEST_FIXTURE(Inline)
+{
+    LONGBOW_RUN_TEST_CASE(Inline, rtaTransport_CreateInline_Destroy);
+    LONGBOW_RUN_TEST_CASE(Inline, rtaTransport_Open_Close);
+    LONGBOW_RUN_TEST_CASE(Inline, rtaTransport_Open_Close_ReusesQueueId);
+    LONGBOW_RUN_TEST_CASE(Inline, rtaTransport_Send);
+    LONGBOW_RUN_TEST_CASE(Inline, rtaTransport_Dispatch_Recv);
+#if defined(__linux__)
+    LONGBOW_RUN_TEST_CASE(Inline, rtaTransport_GetDispatchFd_Timer);
+    LONGBOW_RUN_TEST_CASE(Inline, rtaTransport_GetDispatchFd_Socket);
+    LONGBOW_RUN_TEST_CASE(Inline, rtaTransport_GetDispatchFd_SocketBudget);
+#endif
+    LONGBOW_RUN_TEST_CASE(Inline, rtaTransport_GetDispatchFd_QueuedBudget);
+    LONGBOW_RUN_TEST_CASE(Inline, rtaTransport_Recv_BlockedUp);
+    LONGBOW_RUN_TEST_CASE(Inline, rtaTransport_Recv_Timeout);
+    LONGBOW_RUN_TEST_CASE(Inline, rtaTransport_GetStatistics);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Inline)
+{
+    // rtaTransport_Send_OK leaves a reader on TestingLower, we want its messages to stay in the queue
+    testing_null_ops.downcallRead = NULL;
+
+    TestData *data = parcMemory_AllocateAndClear(sizeof(TestData));
+    assertNotNull(data, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(TestData));
+    data->transport = rtaTransport_CreateInline();
+    longBowTestCase_SetClipBoardData(testCase, data);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Inline)
+{
+    _commonTeardown(longBowTestCase_GetClipBoardData(testCase));
+
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static bool
+_dispatchFdReadable(RTATransport *transport)
+{
+    struct pollfd pfd = { .fd = rtaTransport_GetDispatchFd(transport), .events = POLLIN };
+    return poll(&pfd, 1, 0) == 1;
+}
+
+LONGBOW_TEST_CASE(Inline, rtaTransport_CreateInline_Destroy)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    assertTrue(data->transport->inlineMode, "Transport not in inline mode");
+    assertTrue(data->transport->framework->status == FRAMEWORK_SETUP,
+               "Wrong framework state, expected %d got %d", FRAMEWORK_SETUP, data->transport->framework->status);
+    assertTrue(rtaTransport_GetDispatchFd(data->transport) >= 0, "Invalid dispatch descriptor");
+    assertFalse(_dispatchFdReadable(data->transport), "Dispatch descriptor readable with no work");
+}
+
+/**
+ * The commands execute on our thread, so the connection exists as soon as Open returns
+ */
+LONGBOW_TEST_CASE(Inline, rtaTransport_Open_Close)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxTransportConfig *config = createSimpleConfig(data);
+
+    int queueId = rtaTransport_Open(data->transport, config);
+    assertTrue(queueId == 1, "Wrong queueId, expected 1 got %d", queueId);
+
+    RtaConnection *conn = rtaConnectionTable_GetByApiFd(data->transport->framework->connectionTable, queueId);
+    assertNotNull(conn, "Could not find connection");
+    assertTrue(rtaConnection_GetTransportFd(conn) == -1, "Inline connection has a transport descriptor");
+
+    _ConnectionEntry *entry = _rtaTransport_GetConnectionEntry(data->transport, queueId);
+    assertTrue(rtaConnection_GetInlineQueue(conn) == entry->inlineQueue, "Connection does not share the transport's queue");
+
+    rtaTransport_Close(data->transport, queueId);
+    conn = rtaConnectionTable_GetByApiFd(data->transport->framework->connectionTable, queueId);
+    assertNull(conn, "Connection still in the table after close");
+
+    ccnxTransportConfig_Destroy(&config);
+}
+
+LONGBOW_TEST_CASE(Inline, rtaTransport_Open_Close_ReusesQueueId)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxTransportConfig *config = createSimpleConfig(data);
+
+    int first = rtaTransport_Open(data->transport, config);
+    int second = rtaTransport_Open(data->transport, config);
+    size_t indexLength = data->transport->connectionsByQueueId->length;
+
+    // the closed id is the next one opened, so the index does not grow with the opens
+    for (int i = 0; i < 1000; i++) {
+        rtaTransport_Close(data->transport, second);
+        int queueId = rtaTransport_Open(data->transport, config);
+        assertTrue(queueId == second, "Open %d did not reuse queueId %d, got %d", i, second, queueId);
+    }
+    assertTrue(data->transport->connectionsByQueueId->length == indexLength,
+               "Index grew from %zu to %zu", indexLength, data->transport->connectionsByQueueId->length);
+    assertTrue(data->transport->nextInlineQueueId == second + 1, "Expected next new queueId %d, got %d", second + 1, data->transport->nextInlineQueueId);
+
+    rtaTransport_Close(data->transport, second);
+    rtaTransport_Close(data->transport, first);
+    ccnxTransportConfig_Destroy(&config);
+}
+
+LONGBOW_TEST_CASE(Inline, rtaTransport_Send)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxTransportConfig *config = createSimpleConfig(data);
+
+    int queueId = rtaTransport_Open(data->transport, config);
+    RtaConnection *conn = rtaConnectionTable_GetByApiFd(data->transport->framework->connectionTable, queueId);
+
+    CCNxTlvDictionary *interest = trafficTools_CreateDictionaryInterest();
+    data->msg = ccnxMetaMessage_CreateFromInterest(interest);
+    ccnxTlvDictionary_Release(&interest);
+
+    bool success = rtaTransport_Send(data->transport, queueId, data->msg, CCNxStackTimeout_Immediate);
+    assertTrue(success, "Inline send failed: (%d) %s", errno, strerror(errno));
+    assertTrue(_dispatchFdReadable(data->transport), "Send did not make the dispatch descriptor readable");
+
+    rtaTransport_Dispatch(data->transport, 4);
+    assertFalse(_dispatchFdReadable(data->transport), "Dispatch descriptor still readable after a dispatch");
+
+    PARCEventQueue *lower = rtaProtocolStack_GetPutQueue(rtaConnection_GetStack(conn), TESTING_LOWER, RTA_UP);
+    TransportMessage *tm = rtaComponent_GetMessage(lower);
+    assertNotNull(tm, "TestingLower did not get the message");
+    assertTrue(transportMessage_GetDictionary(tm) == data->msg, "Wrong message at the bottom of the stack");
+    transportMessage_Destroy(&tm);
+
+    ccnxTransportConfig_Destroy(&config);
+}
+
+LONGBOW_TEST_CASE(Inline, rtaTransport_Dispatch_Recv)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxTransportConfig *config = createSimpleConfig(data);
+
+    int queueId = rtaTransport_Open(data->transport, config);
+    RtaConnection *conn = rtaConnectionTable_GetByApiFd(data->transport->framework->connectionTable, queueId);
+
+    TransportMessage *tm = trafficTools_CreateTransportMessageWithSignedContentObject(conn);
+    CCNxTlvDictionary *expected = ccnxTlvDictionary_Acquire(transportMessage_GetDictionary(tm));
+
+    PARCEventQueue *lower = rtaProtocolStack_GetPutQueue(rtaConnection_GetStack(conn), TESTING_LOWER, RTA_UP);
+    rtaComponent_PutMessage(lower, tm);
+
+    unsigned delivered = rtaTransport_Dispatch(data->transport, 4);
+    assertTrue(delivered == 1, "Wrong delivered count, expected 1 got %u", delivered);
+    assertTrue(_dispatchFdReadable(data->transport), "Delivery did not make the dispatch descriptor readable");
+
+    CCNxMetaMessage *msg = NULL;
+    TransportIOStatus status = rtaTransport_Recv(data->transport, queueId, &msg, CCNxStackTimeout_Immediate);
+    assertTrue(status == TransportIOStatus_Success, "Wrong status, expected %d got %d", TransportIOStatus_Success, status);
+    assertTrue(msg == expected, "Got wrong message, expected %p got %p", (void *) expected, (void *) msg);
+
+    ccnxMetaMessage_Release(&msg);
+    ccnxTlvDictionary_Release(&expected);
+    ccnxTransportConfig_Destroy(&config);
+}
+
+#if defined(__linux__)
+static void
+_countTimer(RtaTimer *timer, void *arg)
+{
+    (*(unsigned *) arg)++;
+}
+
+LONGBOW_TEST_CASE(Inline, rtaTransport_GetDispatchFd_Timer)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    unsigned fired = 0;
+
+    RtaTimer *timer = rtaFramework_CreateTimer(data->transport->framework, _countTimer, &fired);
+    rtaTimer_Schedule(timer, 50);
+
+    // arms the descriptor to the timer
+    rtaTransport_Dispatch(data->transport, 0);
+    assertFalse(_dispatchFdReadable(data->transport), "Dispatch descriptor readable before the timer is due");
+
+    struct pollfd pfd = { .fd = rtaTransport_GetDispatchFd(data->transport), .events = POLLIN };
+    assertTrue(poll(&pfd, 1, 1000) == 1, "Dispatch descriptor did not become readable for the timer");
+
+    rtaTransport_Dispatch(data->transport, 1);
+    assertTrue(fired == 1, "Timer should have fired once, got %u", fired);
+    assertFalse(_dispatchFdReadable(data->transport), "Dispatch descriptor readable with no timer pending");
+
+    rtaTimer_Destroy(&timer);
+}
+
+LONGBOW_TEST_CASE(Inline, rtaTransport_GetDispatchFd_Socket)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    int fds[2];
+    int failure = socketpair(PF_LOCAL, SOCK_STREAM, 0, fds);
+    assertFalse(failure, "socketpair failed: (%d) %s", errno, strerror(errno));
+
+    rtaFramework_WatchDescriptor(data->transport->framework, fds[0], PARCEventType_Read);
+    assertFalse(_dispatchFdReadable(data->transport), "Dispatch descriptor readable before the socket is");
+
+    uint8_t byte = 1;
+    ssize_t written = write(fds[1], &byte, sizeof(byte));
+    assertTrue(written == sizeof(byte), "write failed: (%d) %s", errno, strerror(errno));
+    assertTrue(_dispatchFdReadable(data->transport), "Dispatch descriptor did not become readable for the socket");
+
+    // Nothing reads the socket, so a dispatch does not clear it
+    rtaTransport_Dispatch(data->transport, 0);
+    assertTrue(_dispatchFdReadable(data->transport), "Dispatch descriptor not readable for unread data");
+
+    // Once the connector has read it, the dispatch descriptor is quiet
+    ssize_t nread = read(fds[0], &byte, sizeof(byte));
+    assertTrue(nread == sizeof(byte), "read failed: (%d) %s", errno, strerror(errno));
+    rtaTransport_Dispatch(data->transport, 0);
+    assertFalse(_dispatchFdReadable(data->transport), "Dispatch descriptor still readable for data already read");
+
+    rtaFramework_UnwatchDescriptor(data->transport->framework, fds[0]);
+    written = write(fds[1], &byte, sizeof(byte));
+    assertFalse(_dispatchFdReadable(data->transport), "Dispatch descriptor readable for an unwatched socket");
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+/*
+ * A connector that reads one message per pass of the event scheduler
+ */
+static void
+_readOneByte(int fd, PARCEventType what, void *arg)
+{
+    uint8_t byte;
+    if (read(fd, &byte, sizeof(byte)) == sizeof(byte)) {
+        (*(unsigned *) arg)++;
+    }
+}
+
+/**
+ * A dispatch with a budget of 1 leaves forwarder messages in the socket, the dispatch
+ * descriptor must stay readable until all of them are read
+ */
+LONGBOW_TEST_CASE(Inline, rtaTransport_GetDispatchFd_SocketBudget)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    int fds[2];
+    int failure = socketpair(PF_LOCAL, SOCK_STREAM, 0, fds);
+    assertFalse(failure, "socketpair failed: (%d) %s", errno, strerror(errno));
+
+    unsigned received = 0;
+    PARCEvent *readEvent = parcEvent_Create(rtaFramework_GetEventScheduler(data->transport->framework), fds[0],
+                                            PARCEventType_Read | PARCEventType_Persist, _readOneByte, &received);
+    parcEvent_Start(readEvent);
+    rtaFramework_WatchDescriptor(data->transport->framework, fds[0], PARCEventType_Read);
+
+    const unsigned count = 4;
+    uint8_t messages[4] = { 1, 2, 3, 4 };
+    ssize_t written = write(fds[1], messages, count);
+    assertTrue(written == count, "write failed: (%d) %s", errno, strerror(errno));
+
+    unsigned dispatches = 0;
+    while (_dispatchFdReadable(data->transport) && dispatches < 2 * count) {
+        rtaTransport_Dispatch(data->transport, 1);
+        dispatches++;
+    }
+    assertTrue(received == count, "Dispatch descriptor went quiet after %u of %u messages", received, count);
+    assertFalse(_dispatchFdReadable(data->transport), "Dispatch descriptor readable after everything was read");
+
+    rtaFramework_UnwatchDescriptor(data->transport->framework, fds[0]);
+    parcEvent_Destroy(&readEvent);
+    close(fds[0]);
+    close(fds[1]);
+}
+#endif
+
+/**
+ * Messages between components make no descriptor ready, a dispatch that leaves some
+ * behind must leave the dispatch descriptor readable
+ */
+LONGBOW_TEST_CASE(Inline, rtaTransport_GetDispatchFd_QueuedBudget)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxTransportConfig *config = createSimpleConfig(data);
+
+    int queueId = rtaTransport_Open(data->transport, config);
+    RtaConnection *conn = rtaConnectionTable_GetByApiFd(data->transport->framework->connectionTable, queueId);
+
+    const unsigned count = 3;
+    PARCEventQueue *lower = rtaProtocolStack_GetPutQueue(rtaConnection_GetStack(conn), TESTING_LOWER, RTA_UP);
+    for (unsigned i = 0; i < count; i++) {
+        rtaComponent_PutMessage(lower, trafficTools_CreateTransportMessageWithSignedContentObject(conn));
+    }
+
+    unsigned delivered = rtaTransport_Dispatch(data->transport, 0);
+    assertTrue(delivered == 0, "A dispatch without a budget delivered %u messages", delivered);
+    assertTrue(_dispatchFdReadable(data->transport), "Dispatch descriptor not readable with messages queued in the stack");
+
+    unsigned dispatches = 0;
+    while (_dispatchFdReadable(data->transport) && dispatches < 4 * count) {
+        delivered += rtaTransport_Dispatch(data->transport, 1);
+        dispatches++;
+    }
+    assertTrue(delivered == count, "Dispatch descriptor went quiet after %u of %u messages", delivered, count);
+
+    for (unsigned i = 0; i < count; i++) {
+        CCNxMetaMessage *msg = NULL;
+        TransportIOStatus status = rtaTransport_Recv(data->transport, queueId, &msg, CCNxStackTimeout_Immediate);
+        assertTrue(status == TransportIOStatus_Success, "Wrong status for message %u, got %d", i, status);
+        ccnxMetaMessage_Release(&msg);
+    }
+    ccnxTransportConfig_Destroy(&config);
+}
+
+LONGBOW_TEST_CASE(Inline, rtaTransport_Recv_BlockedUp)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    // the inline queue holds 64 messages and unblocks below 16
+    const unsigned highWater = 64;
+    const unsigned lowWater = 16;
+    ApiConnectorQueueConfig queueConfig = *apiConnector_GetDefaultQueueConfig();
+    queueConfig.receiveBufferBytes = highWater * sizeof(CCNxMetaMessage *);
+    queueConfig.writeWatermarkBytes = lowWater * sizeof(CCNxMetaMessage *);
+    CCNxTransportConfig *config = createQueueConfig(&queueConfig);
+
+    int queueId = rtaTransport_Open(data->transport, config);
+    assertTrue(queueId >= 0, "Could not open a connection: (%d) %s", errno, strerror(errno));
+    RtaConnection *conn = rtaConnectionTable_GetByApiFd(data->transport->framework->connectionTable, queueId);
+    RtaInlineQueue *inlineQueue = _rtaTransport_GetConnectionEntry(data->transport, queueId)->inlineQueue;
+
+    const unsigned count = highWater + 8;
+    PARCEventQueue *lower = rtaProtocolStack_GetPutQueue(rtaConnection_GetStack(conn), TESTING_LOWER, RTA_UP);
+    for (unsigned i = 0; i < count; i++) {
+        rtaComponent_PutMessage(lower, trafficTools_CreateTransportMessageWithSignedContentObject(conn));
+    }
+
+    unsigned dispatches = 0;
+    while (_dispatchFdReadable(data->transport) && dispatches < 4 * count) {
+        rtaTransport_Dispatch(data->transport, 0);
+        dispatches++;
+    }
+
+    // the messages past the high water mark were dropped, not queued
+    assertTrue(rtaConnection_BlockedUp(conn), "Connection not blocked UP with a full inline queue");
+    assertTrue(rtaInlineQueue_Count(inlineQueue) == highWater, "Expected %u messages queued, got %zu", highWater, rtaInlineQueue_Count(inlineQueue));
+
+    for (unsigned i = highWater; i >= lowWater; i--) {
+        assertTrue(rtaConnection_BlockedUp(conn), "Connection unblocked with %u messages queued", i);
+        CCNxMetaMessage *msg = NULL;
+        TransportIOStatus status = rtaTransport_Recv(data->transport, queueId, &msg, CCNxStackTimeout_Immediate);
+        assertTrue(status == TransportIOStatus_Success, "Wrong status with %u messages queued, got %d", i, status);
+        ccnxMetaMessage_Release(&msg);
+    }
+    assertFalse(rtaConnection_BlockedUp(conn), "Connection still blocked UP below the low water mark");
+
+    rtaTransport_Close(data->transport, queueId);
+    ccnxTransportConfig_Destroy(&config);
+}
+
+LONGBOW_TEST_CASE(Inline, rtaTransport_Recv_Timeout)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxTransportConfig *config = createSimpleConfig(data);
+
+    int queueId = rtaTransport_Open(data->transport, config);
+
+    CCNxMetaMessage *msg = NULL;
+    TransportIOStatus status = rtaTransport_Recv(data->transport, queueId, &msg, CCNxStackTimeout_MicroSeconds(2000));
+    assertTrue(status == TransportIOStatus_Timeout, "Wrong status, expected %d got %d", TransportIOStatus_Timeout, status);
+    assertNull(msg, "Got a message from an idle connection");
+
+    ccnxTransportConfig_Destroy(&config);
+}
+
+LONGBOW_TEST_CASE(Inline, rtaTransport_GetStatistics)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxTransportConfig *config = createSimpleConfig(data);
+
+    rtaTransport_Open(data->transport, config);
+
+    // the snapshot is taken on our thread, so a zero timeout is enough
+    PARCJSON *stats = rtaTransport_GetStatistics(data->transport, CCNxStackTimeout_Immediate);
+    assertNotNull(stats, "Got null statistics snapshot");
+    parcJSON_Release(&stats);
+
+    ccnxTransportConfig_Destroy(&config);
+}
+
 int
 main(int argc, char *argv[])
 {